@@ -0,0 +1,99 @@
+/**
+ * @file BenchFixtures.hpp
+ * @brief Records and requests shared by the hft_bench benchmarks.
+ *
+ * @details Everything is built with fixed seeds, so two runs of a build
+ * measure the same work and a regression shows up as a change of time, not
+ * of input.
+ */
+
+#ifndef BENCHFIXTURES_HPP
+#define BENCHFIXTURES_HPP
+
+#include "models/Request.hpp"
+#include "pod/TradingPOD.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    /// Microseconds in a day, for trade timestamps.
+    constexpr int64_t kMicrosPerDay = 86'400'000'000LL;
+
+    /// "SYM<i>", the instrument name used by every fixture.
+    inline std::string symbolName(std::size_t i)
+    {
+        return "SYM" + std::to_string(i);
+    }
+
+    inline SymbolPOD makeSymbol(std::size_t i)
+    {
+        SymbolPOD s{};
+        std::snprintf(s.symbol, sizeof(s.symbol), "SYM%zu", i);
+        return s;
+    }
+
+    inline MarketDataPOD makeMarketData(std::size_t i, double last)
+    {
+        MarketDataPOD md{};
+        std::snprintf(md.symbol, sizeof(md.symbol), "SYM%zu", i);
+        md.bid    = last - 0.01;
+        md.ask    = last + 0.01;
+        md.last   = last;
+        md.volume = 1000 + i;
+        return md;
+    }
+
+    /// @p count positions over @p symbols instruments.
+    inline std::vector<PositionPOD> makePositions(std::size_t count, std::size_t symbols)
+    {
+        std::vector<PositionPOD> positions(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            PositionPOD& p = positions[i];
+            std::snprintf(p.symbol, sizeof(p.symbol), "SYM%zu", i % symbols);
+            p.quantity = static_cast<int64_t>(i % 7 == 0 ? -100 : 100) * static_cast<int64_t>(1 + i % 5);
+            p.avgPrice = 100.0 + static_cast<double>(i % 50);
+        }
+        return positions;
+    }
+
+    /// @p count fills spread evenly over one day and @p symbols instruments.
+    inline std::vector<TradePOD> makeTrades(std::size_t count, std::size_t symbols, int64_t dayStart = 0)
+    {
+        std::vector<TradePOD> trades(count);
+        uint64_t              state = 0x9E3779B97F4A7C15ull;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            TradePOD& t = trades[i];
+            t.tradeId   = i + 1;
+            t.orderId   = i / 4 + 1;
+            std::snprintf(t.symbol, sizeof(t.symbol), "SYM%zu", static_cast<std::size_t>(state % symbols));
+            t.price     = 100.0 + static_cast<double>(state % 1000) / 100.0;
+            t.quantity  = 1 + state % 500;
+            t.side      = static_cast<uint8_t>(state & 1);
+            t.timestamp = dayStart + static_cast<int64_t>(i) * (kMicrosPerDay / static_cast<int64_t>(count));
+        }
+        return trades;
+    }
+
+    template <typename T>
+    Request makeRequest(RequestType type, const std::vector<T>& records)
+    {
+        Request req;
+        req.type    = type;
+        req.payload = makePodPayload(records.data(), records.size());
+        return req;
+    }
+} // namespace bench
+
+#endif // BENCHFIXTURES_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file bench_Codec.cpp
+ * @brief Benchmarks of the wire framing and of POD payload decoding.
+ *
+ * Covers: BE32 length prefixes, request decode (the io thread's per-frame
+ * work), response frame encoding, and binding POD arrays in place.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchFixtures.hpp"
+#include "FrameCodec.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Length prefix
+// ---------------------------------------------------------------------------
+
+static void BM_EncodeDecodeBE32(benchmark::State& state)
+{
+    std::array<uint8_t, 4> bytes{};
+    uint32_t               value = 0x01020304;
+    for (auto _ : state)
+    {
+        framing::writeBE32(bytes.data(), value);
+        value = framing::decodeBE32(bytes.data()) + 1;
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_EncodeDecodeBE32);
+
+// ---------------------------------------------------------------------------
+// Requests and responses
+// ---------------------------------------------------------------------------
+
+static void BM_DecodeRequest(benchmark::State& state)
+{
+    std::vector<SymbolPOD> symbols;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        symbols.push_back(bench::makeSymbol(i));
+    const RawBuffer frame = framing::encodeRequest(bench::makeRequest(RequestType::GET_MARKET_DATA, symbols));
+
+    for (auto _ : state)
+    {
+        Request request;
+        benchmark::DoNotOptimize(framing::decodeRequest(frame, request));
+        benchmark::DoNotOptimize(request.payload.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+}
+BENCHMARK(BM_DecodeRequest)->Arg(1)->Arg(64);
+
+static void BM_EncodeResponseFrame(benchmark::State& state)
+{
+    std::vector<MarketDataPOD> records;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        records.push_back(bench::makeMarketData(i, 100.0));
+
+    Response response{true, "OK", PooledBuffer::uninitialized(pod::payloadSize<MarketDataPOD>(records.size()))};
+    pod::writeArray(response.data.data(), records.data(), records.size());
+
+    for (auto _ : state)
+    {
+        RawBuffer frame = framing::encodeResponseFrame(response);
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * response.data.size()));
+}
+BENCHMARK(BM_EncodeResponseFrame)->Arg(1)->Arg(64)->Arg(1024);
+
+static void BM_DecodeResponse(benchmark::State& state)
+{
+    std::vector<MarketDataPOD> records(static_cast<std::size_t>(state.range(0)), bench::makeMarketData(0, 100.0));
+    Response response{true, "OK", PooledBuffer::uninitialized(pod::payloadSize<MarketDataPOD>(records.size()))};
+    pod::writeArray(response.data.data(), records.data(), records.size());
+    const RawBuffer frame   = framing::encodeResponseFrame(response);
+    const RawBuffer payload = frame.slice(framing::kLengthPrefixSize, frame.size() - framing::kLengthPrefixSize);
+
+    for (auto _ : state)
+    {
+        Response decoded;
+        benchmark::DoNotOptimize(framing::decodeResponse(payload, decoded));
+        benchmark::DoNotOptimize(decoded.data.data());
+    }
+}
+BENCHMARK(BM_DecodeResponse)->Arg(64);
+
+// ---------------------------------------------------------------------------
+// POD payloads
+// ---------------------------------------------------------------------------
+
+static void BM_BindPositions(benchmark::State& state)
+{
+    const Request request =
+        bench::makeRequest(RequestType::CALCULATE, bench::makePositions(static_cast<std::size_t>(state.range(0)), 64));
+
+    for (auto _ : state)
+    {
+        PodArrayView<PositionPOD> positions;
+        benchmark::DoNotOptimize(bindRequest<RequestType::CALCULATE>(request, positions));
+        benchmark::DoNotOptimize(positions.data());
+    }
+}
+BENCHMARK(BM_BindPositions)->Arg(16)->Arg(4096);
+
+static void BM_MakePodPayload(benchmark::State& state)
+{
+    const std::vector<PositionPOD> positions = bench::makePositions(static_cast<std::size_t>(state.range(0)), 64);
+
+    for (auto _ : state)
+    {
+        PooledBuffer payload = makePodPayload(positions.data(), positions.size());
+        benchmark::DoNotOptimize(payload.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * positions.size() * sizeof(PositionPOD)));
+}
+BENCHMARK(BM_MakePodPayload)->Arg(16)->Arg(4096);
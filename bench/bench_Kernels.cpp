@@ -0,0 +1,172 @@
+/**
+ * @file bench_Kernels.cpp
+ * @brief Benchmarks of the calculation and manipulation kernels.
+ *
+ * Covers: the SIMD risk kernels against their scalar references, CALCULATE
+ * with and without scenario VaR and resident books, and MANIPULATE filters
+ * and daily pivots over the resident columnar trade store.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchFixtures.hpp"
+#include "CalculationEngine.hpp"
+#include "InMemoryMarketDataService.hpp"
+#include "ManipulationEngine.hpp"
+#include "RiskKernels.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kSymbols = 256;
+
+    /// Structure-of-arrays inputs of the P&L kernel.
+    struct PnlColumns
+    {
+        explicit PnlColumns(std::size_t n)
+            : quantity(n), avgPrice(n), mark(n), pnl(n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                quantity[i] = static_cast<double>(i % 11) - 5.0;
+                avgPrice[i] = 100.0 + static_cast<double>(i % 50);
+                mark[i]     = avgPrice[i] * 1.01;
+            }
+        }
+
+        std::vector<double> quantity, avgPrice, mark, pnl;
+    };
+
+    std::shared_ptr<InMemoryMarketDataService> makeMarketData()
+    {
+        auto service = std::make_shared<InMemoryMarketDataService>(kSymbols);
+        for (std::size_t i = 0; i < kSymbols; ++i)
+            service->update(bench::makeMarketData(i, 100.0 + static_cast<double>(i)));
+        return service;
+    }
+
+    /// An engine with @p scenarios rows of returns for every symbol.
+    std::shared_ptr<CalculationEngine> makeEngine(std::size_t scenarios, std::size_t residentBooks)
+    {
+        auto engine = std::make_shared<CalculationEngine>(makeMarketData(), CalculationConfig{0.99, 0, residentBooks});
+        if (scenarios == 0)
+            return engine;
+
+        std::vector<std::string> symbols;
+        for (std::size_t i = 0; i < kSymbols; ++i)
+            symbols.push_back(bench::symbolName(i));
+        std::vector<double> returns(scenarios * kSymbols);
+        uint64_t            state = 12345;
+        for (double& r : returns)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            r     = (static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5) * 0.04;
+        }
+        engine->setScenarios(symbols, std::move(returns));
+        return engine;
+    }
+
+    ManipulationEngine& tradeStore()
+    {
+        static ManipulationEngine* engine = []
+        {
+            auto*                       e      = new ManipulationEngine();
+            const std::vector<TradePOD> trades = bench::makeTrades(1'000'000, kSymbols);
+            e->recordTrades(trades.data(), trades.size());
+            return e;
+        }();
+        return *engine;
+    }
+
+    Request manipulateRequest(ManipulationOp op, const char* symbol)
+    {
+        ManipulationSpecPOD spec{};
+        spec.op = static_cast<uint8_t>(op);
+        std::strncpy(spec.symbol, symbol, sizeof(spec.symbol) - 1);
+        return bench::makeRequest(RequestType::MANIPULATE, std::vector<ManipulationSpecPOD>{spec});
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Risk kernels
+// ---------------------------------------------------------------------------
+
+static void BM_UnrealisedPnl(benchmark::State& state)
+{
+    PnlColumns c(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            risk::unrealisedPnl(c.quantity.data(), c.avgPrice.data(), c.mark.data(), c.pnl.data(), c.pnl.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(risk::activeIsa());
+}
+BENCHMARK(BM_UnrealisedPnl)->Arg(1024)->Arg(65536);
+
+static void BM_UnrealisedPnlScalar(benchmark::State& state)
+{
+    PnlColumns c(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(risk::scalar::unrealisedPnl(c.quantity.data(), c.avgPrice.data(), c.mark.data(),
+                                                             c.pnl.data(), c.pnl.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnrealisedPnlScalar)->Arg(1024)->Arg(65536);
+
+static void BM_Dot(benchmark::State& state)
+{
+    PnlColumns c(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(risk::dot(c.quantity.data(), c.mark.data(), c.mark.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(risk::activeIsa());
+}
+BENCHMARK(BM_Dot)->Arg(1024)->Arg(65536);
+
+// ---------------------------------------------------------------------------
+// CALCULATE
+// ---------------------------------------------------------------------------
+
+/// Args: positions, scenarios, resident books.
+static void BM_Calculate(benchmark::State& state)
+{
+    auto engine = makeEngine(static_cast<std::size_t>(state.range(1)), static_cast<std::size_t>(state.range(2)));
+    const Request request = bench::makeRequest(
+        RequestType::CALCULATE, bench::makePositions(static_cast<std::size_t>(state.range(0)), kSymbols));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(engine->calculate(request));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Calculate)
+    ->ArgNames({"positions", "scenarios", "resident"})
+    ->Args({64, 0, 0})
+    ->Args({64, 500, 0})
+    ->Args({64, 500, 8})
+    ->Args({4096, 500, 0})
+    ->Args({4096, 500, 8});
+
+// ---------------------------------------------------------------------------
+// MANIPULATE
+// ---------------------------------------------------------------------------
+
+static void BM_FilterOneSymbol(benchmark::State& state)
+{
+    ManipulationEngine& engine  = tradeStore();
+    const Request       request = manipulateRequest(ManipulationOp::FILTER, "SYM7");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(engine.manipulate(request));
+}
+BENCHMARK(BM_FilterOneSymbol)->Unit(benchmark::kMicrosecond);
+
+static void BM_DailyPivot(benchmark::State& state)
+{
+    ManipulationEngine& engine  = tradeStore();
+    const Request       request = manipulateRequest(ManipulationOp::DAILY_PIVOT, "");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(engine.transform(request));
+}
+BENCHMARK(BM_DailyPivot)->Unit(benchmark::kMicrosecond);
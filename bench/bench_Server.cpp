@@ -0,0 +1,165 @@
+/**
+ * @file bench_Server.cpp
+ * @brief Benchmarks of command dispatch through the registry and the facade.
+ *
+ * Covers: CommandRegistry::create() (one command object per request, the
+ * legacy path), handler dispatch through CommandRegistry::execute(), and
+ * TradingServerFacade::handleRequest() over the in-memory services, as
+ * main() wires them.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchFixtures.hpp"
+#include "CalculationEngine.hpp"
+#include "InMemoryMarketDataService.hpp"
+#include "ManipulationEngine.hpp"
+#include "StubServices.hpp"
+#include "TradingServerFacade.hpp"
+#include "commands/CalculationCommand.hpp"
+#include "commands/GetMarketDataCommand.hpp"
+#include "commands/ManipulationCommand.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kSymbols = 256;
+
+    std::shared_ptr<InMemoryMarketDataService> makeMarketData()
+    {
+        auto service = std::make_shared<InMemoryMarketDataService>(kSymbols);
+        for (std::size_t i = 0; i < kSymbols; ++i)
+            service->update(bench::makeMarketData(i, 100.0 + static_cast<double>(i)));
+        return service;
+    }
+
+    Request marketDataRequest(std::size_t symbols)
+    {
+        std::vector<SymbolPOD> records;
+        for (std::size_t i = 0; i < symbols; ++i)
+            records.push_back(bench::makeSymbol(i));
+        return bench::makeRequest(RequestType::GET_MARKET_DATA, records);
+    }
+
+    /// A facade over the in-memory services with main()'s handlers.
+    struct Server
+    {
+        Server()
+            : marketData(makeMarketData())
+            , calculation(std::make_shared<CalculationEngine>(marketData, CalculationConfig{0.99, 0, 8}))
+            , manipulation(std::make_shared<ManipulationEngine>())
+        {
+            const std::vector<TradePOD> trades = bench::makeTrades(100'000, kSymbols);
+            manipulation->recordTrades(trades.data(), trades.size());
+
+            auto            data  = marketData;
+            auto            calc  = calculation;
+            auto            manip = manipulation;
+            CommandRegistry registry;
+            registry.registerHandler(RequestType::GET_MARKET_DATA,
+                                     [data](const Request& r) { return GetMarketDataCommand::run(*data, r); });
+            registry.registerHandler(RequestType::CALCULATE,
+                                     [calc](const Request& r) { return CalculationCommand::run(*calc, r); });
+            registry.registerHandler(RequestType::MANIPULATE,
+                                     [manip](const Request& r) { return ManipulationCommand::run(*manip, r); });
+            facade = std::make_unique<TradingServerFacade>(marketData, calculation, manipulation,
+                                                           std::make_shared<StubReportService>(), std::move(registry));
+        }
+
+        std::shared_ptr<InMemoryMarketDataService> marketData;
+        std::shared_ptr<CalculationEngine>         calculation;
+        std::shared_ptr<ManipulationEngine>        manipulation;
+        std::unique_ptr<TradingServerFacade>       facade;
+    };
+
+    Server& server()
+    {
+        static Server instance;
+        return instance;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CommandRegistry
+// ---------------------------------------------------------------------------
+
+static void BM_RegistryCreate(benchmark::State& state)
+{
+    auto            service = makeMarketData();
+    CommandRegistry registry;
+    registry.registerCommand(RequestType::GET_MARKET_DATA, [service](const Request& r) {
+        return std::make_unique<GetMarketDataCommand>(service, r);
+    });
+    const Request request = marketDataRequest(1);
+
+    for (auto _ : state)
+    {
+        auto command = registry.create(request);
+        benchmark::DoNotOptimize(command.get());
+    }
+}
+BENCHMARK(BM_RegistryCreate);
+
+static void BM_RegistryExecuteCommand(benchmark::State& state)
+{
+    auto            service = makeMarketData();
+    CommandRegistry registry;
+    registry.registerCommand(RequestType::GET_MARKET_DATA, [service](const Request& r) {
+        return std::make_unique<GetMarketDataCommand>(service, r);
+    });
+    const Request request = marketDataRequest(1);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(registry.execute(request));
+}
+BENCHMARK(BM_RegistryExecuteCommand);
+
+static void BM_RegistryExecuteHandler(benchmark::State& state)
+{
+    auto            service = makeMarketData();
+    CommandRegistry registry;
+    registry.registerHandler(RequestType::GET_MARKET_DATA,
+                             [service](const Request& r) { return GetMarketDataCommand::run(*service, r); });
+    const Request request = marketDataRequest(1);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(registry.execute(request));
+}
+BENCHMARK(BM_RegistryExecuteHandler);
+
+// ---------------------------------------------------------------------------
+// TradingServerFacade
+// ---------------------------------------------------------------------------
+
+static void BM_FacadeGetMarketData(benchmark::State& state)
+{
+    const Request request = marketDataRequest(static_cast<std::size_t>(state.range(0)));
+    TradingServerFacade& facade = *server().facade;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(facade.handleRequest(request));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FacadeGetMarketData)->Arg(1)->Arg(64);
+
+static void BM_FacadeCalculate(benchmark::State& state)
+{
+    const Request request = bench::makeRequest(
+        RequestType::CALCULATE, bench::makePositions(static_cast<std::size_t>(state.range(0)), kSymbols));
+    TradingServerFacade& facade = *server().facade;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(facade.handleRequest(request));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FacadeCalculate)->Arg(16)->Arg(1024);
+
+static void BM_FacadeUnknownType(benchmark::State& state)
+{
+    Request request;
+    request.type = static_cast<RequestType>(0xFFFF);
+    TradingServerFacade& facade = *server().facade;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(facade.handleRequest(request));
+}
+BENCHMARK(BM_FacadeUnknownType);
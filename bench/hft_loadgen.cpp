@@ -0,0 +1,584 @@
+/**
+ * @file hft_loadgen.cpp
+ * @brief End-to-end load generator for hft_server_exe.
+ *
+ * @details Opens N sessions, each on its own thread, and drives a
+ * weighted mix of request types against a running server for a fixed
+ * time. Every session is closed-loop: it sends one request, reads the whole
+ * reply (including streamed parts), and then sends the next one. With
+ * --pipeline N a session instead keeps up to N requests in flight, tagged
+ * with request ids, and matches the replies — which the server may complete
+ * out of order — back to their requests by id. With --accept the requests
+ * list codecs the server may compress large replies with; the generator
+ * decompresses them, as a client would, and reports the bytes received.
+ * Sessions connect over TLS by default; --transport tcp, unix or shm
+ * matches a server started with the same --transport (shm sessions attach
+ * a shared-memory region each, see ShmClient.hpp). It then
+ * reports the throughput and the p50/p90/p99/p99.9 round-trip latency of
+ * each request type. Latencies are recorded into the server's own
+ * LatencyHistogram, so both sides report with the same resolution.
+ *
+ * Usage:
+ *   hft_loadgen --sessions 8 --duration-s 10 \
+ *               --mix GET_MARKET_DATA=70,CALCULATE=20,MANIPULATE=9,GET_STATS=1
+ *   hft_loadgen --sessions 2 --pipeline 16
+ *   hft_loadgen --transport unix --unix-path /tmp/hft_server.sock
+ *   hft_loadgen --transport shm --shm-wake spin
+ *
+ * Run with --help to see all available options.
+ */
+
+#include "FrameCodec.hpp"
+#include "PayloadCompression.hpp"
+#include "ShmClient.hpp"
+#include "metrics/LatencyHistogram.hpp"
+#include "server/RequestSchema.hpp"
+#include "server/RequestTypes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <cxxopts.hpp>
+
+namespace
+{
+    using Clock     = std::chrono::steady_clock;
+    using SslSocket = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
+
+    /// Weight and prebuilt request frames of one request type of the mix.
+    struct MixEntry
+    {
+        RequestType type{};
+        unsigned    weight{0};
+        RawBuffer   frame;       ///< Untagged, answered lock-step.
+        RawBuffer   taggedFrame; ///< Carries a request id, patched per send.
+    };
+
+    /// Offset of the request id inside a tagged request frame.
+    constexpr std::size_t kRequestIdOffset = framing::kLengthPrefixSize + framing::kRequestHeaderSize;
+
+    /// A pipelined request waiting for (the rest of) its reply.
+    struct InFlight
+    {
+        uint64_t          id{0};
+        const MixEntry*   entry{nullptr};
+        Clock::time_point sent;
+        bool              success{true};
+    };
+
+    /// What one session measured.
+    struct SessionResult
+    {
+        std::array<LatencyHistogram, kRequestTypeCount> latency{};
+        std::array<uint64_t, kRequestTypeCount>         failures{};
+        uint64_t                                        bytesIn{0};
+        uint64_t                                        compressedReplies{0};
+        std::string                                     error;
+    };
+
+    RequestType requestTypeNamed(const std::string& name)
+    {
+        RequestType type{};
+        if (!parseRequestType(name, type))
+            throw std::invalid_argument("unknown request type '" + name + "'");
+        return type;
+    }
+
+    /// The payload of every request of @p type, sized by the options.
+    Request buildRequest(RequestType type, std::size_t symbols, std::size_t positions)
+    {
+        Request request;
+        request.type = type;
+        switch (type)
+        {
+        case RequestType::GET_MARKET_DATA:
+        {
+            std::vector<SymbolPOD> records(symbols);
+            for (std::size_t i = 0; i < symbols; ++i)
+                std::snprintf(records[i].symbol, sizeof(records[i].symbol), "SYM%zu", i);
+            request.payload = makePodPayload(records.data(), records.size());
+            break;
+        }
+        case RequestType::CALCULATE:
+        {
+            std::vector<PositionPOD> records(positions);
+            for (std::size_t i = 0; i < positions; ++i)
+            {
+                std::snprintf(records[i].symbol, sizeof(records[i].symbol), "SYM%zu",
+                              i % std::max<std::size_t>(symbols, 1));
+                records[i].quantity = 100 * static_cast<int64_t>(1 + i % 5);
+                records[i].avgPrice = 100.0 + static_cast<double>(i % 50);
+            }
+            request.payload = makePodPayload(records.data(), records.size());
+            break;
+        }
+        case RequestType::MANIPULATE:
+        {
+            ManipulationSpecPOD spec{};
+            spec.op = static_cast<uint8_t>(ManipulationOp::FILTER);
+            std::strcpy(spec.symbol, "SYM0");
+            request.payload = makePodPayload(&spec, 1);
+            break;
+        }
+        case RequestType::GENERATE_REPORT:
+        {
+            const auto today = static_cast<int32_t>(
+                std::chrono::duration_cast<std::chrono::hours>(std::chrono::system_clock::now().time_since_epoch())
+                    .count()
+                / 24);
+            ReportRequestPOD report{};
+            std::strcpy(report.reportType, "EndOfDay");
+            report.dateFrom = today - 1;
+            report.dateTo   = today;
+            request.payload = makePodPayload(&report, 1);
+            break;
+        }
+        case RequestType::GET_STATS:
+            break;
+        case RequestType::RECOVER_MARKET_DATA:
+        {
+            // The first ticks of the run; the server clamps the range to what it retained.
+            const MarketDataRecoveryPOD range{1, 64, 0};
+            request.payload = makePodPayload(&range, 1);
+            break;
+        }
+        case RequestType::SUBMIT_ORDER:
+        {
+            // A market order never rests, so the one prebuilt frame can be sent again and again.
+            OrderPOD order{};
+            order.orderId  = 1;
+            order.quantity = 1;
+            std::strcpy(order.symbol, "SYM0");
+            request.payload = makePodPayload(&order, 1);
+            break;
+        }
+        case RequestType::BATCH:
+        {
+            // One GET_MARKET_DATA and one CALCULATE, as a screen refresh would send.
+            const Request quotes = buildRequest(RequestType::GET_MARKET_DATA, symbols, positions);
+            const Request risk   = buildRequest(RequestType::CALCULATE, symbols, positions);
+            const BatchItemPOD items[] = {
+                {static_cast<uint32_t>(quotes.type), static_cast<uint32_t>(quotes.payload.size())},
+                {static_cast<uint32_t>(risk.type), static_cast<uint32_t>(risk.payload.size())}};
+            request.payload = PooledBuffer::uninitialized(pod::payloadSize<BatchItemPOD>(2) + quotes.payload.size()
+                                                          + risk.payload.size());
+            uint8_t* out = request.payload.data();
+            out += pod::writeArray(out, items, 2);
+            std::memcpy(out, quotes.payload.data(), quotes.payload.size());
+            std::memcpy(out + quotes.payload.size(), risk.payload.data(), risk.payload.size());
+            break;
+        }
+        case RequestType::CANCEL_ORDER:
+            throw std::invalid_argument("CANCEL_ORDER needs a resting order per request and cannot be part of a mix");
+        default:
+            throw std::invalid_argument(std::string(requestTypeName(type))
+                                        + " pushes updates and cannot be part of a closed-loop mix");
+        }
+        return request;
+    }
+
+    /// "GET_MARKET_DATA=70,CALCULATE=30" → mix entries with their frames.
+    std::vector<MixEntry> parseMix(const std::string& spec, std::size_t symbols, std::size_t positions,
+                                   uint8_t acceptCodecs)
+    {
+        std::vector<MixEntry> mix;
+        std::stringstream     in(spec);
+        std::string           item;
+        while (std::getline(in, item, ','))
+        {
+            const auto equals = item.find('=');
+            MixEntry   entry;
+            entry.type   = requestTypeNamed(item.substr(0, equals));
+            entry.weight = equals == std::string::npos ? 1u
+                                                       : static_cast<unsigned>(std::stoul(item.substr(equals + 1)));
+
+            Request request      = buildRequest(entry.type, symbols, positions);
+            request.acceptCodecs = acceptCodecs;
+            entry.frame          = framing::makeFrame(framing::encodeRequest(request));
+            request.hasRequestId = true;
+            entry.taggedFrame    = framing::makeFrame(framing::encodeRequest(request));
+            if (entry.weight > 0)
+                mix.push_back(std::move(entry));
+        }
+        if (mix.empty())
+            throw std::invalid_argument("the request mix is empty");
+        return mix;
+    }
+
+    /// Read one response frame; false on a push, which is not a reply.
+    /// @p id is set when the reply is tagged with a request id. Compressed
+    /// data is decompressed; a stream that does not decode fails the part.
+    template <typename Socket>
+    bool readReply(Socket& socket, std::vector<uint8_t>& buffer, SessionResult& result, bool& success, bool& more,
+                   uint64_t& id)
+    {
+        uint8_t prefix[framing::kLengthPrefixSize];
+        boost::asio::read(socket, boost::asio::buffer(prefix));
+        const uint32_t length = framing::decodeBE32(prefix);
+        if (length < framing::kResponseHeaderSize || length > framing::kMaxFrameSize)
+            throw std::runtime_error("malformed response frame of " + std::to_string(length) + " bytes");
+
+        buffer.resize(length);
+        boost::asio::read(socket, boost::asio::buffer(buffer));
+        result.bytesIn += framing::kLengthPrefixSize + length;
+
+        const uint8_t status = buffer[0];
+        std::size_t   header = framing::kResponseHeaderSize;
+        success              = (status & framing::kResponseSuccess) != 0;
+        more                 = (status & framing::kResponseMore) != 0;
+        if (status & framing::kResponseRequestId)
+        {
+            header += framing::kRequestIdSize;
+            if (length < header)
+                throw std::runtime_error("response frame truncated inside its request id");
+            id = framing::decodeBE64(buffer.data() + 1);
+        }
+
+        const auto codec =
+            static_cast<compression::Codec>((status & framing::kResponseCodecMask) >> framing::kResponseCodecShift);
+        if (codec != compression::Codec::NONE)
+        {
+            const std::size_t dataAt = header + framing::decodeBE32(buffer.data() + header - 4);
+            PooledBuffer      data;
+            ++result.compressedReplies;
+            success = success && dataAt <= length
+                      && compression::decompress(codec, buffer.data() + dataAt, length - dataAt, data,
+                                                 framing::kMaxFrameSize);
+        }
+        return (status & framing::kResponsePush) == 0;
+    }
+
+    /// Weighted pick of the next request type to send.
+    class MixPicker
+    {
+    public:
+        MixPicker(const std::vector<MixEntry>& mix, unsigned seed)
+            : m_mix(mix), m_state(0x9E3779B97F4A7C15ull ^ seed)
+        {
+            for (const MixEntry& entry : mix)
+                m_totalWeight += entry.weight;
+        }
+
+        const MixEntry& next()
+        {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 7;
+            m_state ^= m_state << 17;
+            unsigned pick = static_cast<unsigned>(m_state % m_totalWeight);
+            for (const MixEntry& candidate : m_mix)
+            {
+                if (pick < candidate.weight)
+                    return candidate;
+                pick -= candidate.weight;
+            }
+            return m_mix.front();
+        }
+
+    private:
+        const std::vector<MixEntry>& m_mix;
+        uint64_t                     m_state;
+        unsigned                     m_totalWeight{0};
+    };
+
+    void record(SessionResult& result, RequestType type, Clock::time_point sent, bool success)
+    {
+        const auto index = static_cast<std::size_t>(type);
+        result.latency[index].record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count()));
+        if (!success)
+            ++result.failures[index];
+    }
+
+    /// One request at a time, without request ids.
+    template <typename Socket>
+    void runClosedLoop(Socket& socket, MixPicker& picker, Clock::time_point measureFrom, Clock::time_point until,
+                       SessionResult& result)
+    {
+        std::vector<uint8_t> buffer;
+        for (Clock::time_point now = Clock::now(); now < until; now = Clock::now())
+        {
+            const MixEntry&         entry = picker.next();
+            const Clock::time_point sent  = Clock::now();
+            boost::asio::write(socket, boost::asio::buffer(entry.frame.data(), entry.frame.size()));
+
+            bool     success = true;
+            bool     more    = true;
+            uint64_t id      = 0;
+            while (more)
+            {
+                bool partSucceeded = false;
+                if (readReply(socket, buffer, result, partSucceeded, more, id))
+                    success = success && partSucceeded;
+                else
+                    more = true; // a push interleaved with the reply
+            }
+
+            if (sent >= measureFrom)
+                record(result, entry.type, sent, success);
+        }
+    }
+
+    /// Up to @p depth tagged requests in flight; replies matched by id.
+    template <typename Socket>
+    void runPipelined(Socket& socket, MixPicker& picker, std::size_t depth, Clock::time_point measureFrom,
+                      Clock::time_point until, SessionResult& result)
+    {
+        std::vector<InFlight> inFlight;
+        std::vector<uint8_t>  frame;
+        std::vector<uint8_t>  buffer;
+        uint64_t              nextId = 1;
+        bool                  open   = true;
+        while (open || !inFlight.empty())
+        {
+            open = open && Clock::now() < until;
+            while (open && inFlight.size() < depth)
+            {
+                const MixEntry& entry = picker.next();
+                frame.assign(entry.taggedFrame.data(), entry.taggedFrame.data() + entry.taggedFrame.size());
+                framing::writeBE64(frame.data() + kRequestIdOffset, nextId);
+                inFlight.push_back(InFlight{nextId++, &entry, Clock::now(), true});
+                boost::asio::write(socket, boost::asio::buffer(frame));
+            }
+
+            bool     partSucceeded = false;
+            bool     more          = false;
+            uint64_t id            = 0;
+            if (!readReply(socket, buffer, result, partSucceeded, more, id))
+                continue; // a push, not a reply
+
+            const auto it = std::find_if(inFlight.begin(), inFlight.end(),
+                                         [id](const InFlight& request) { return request.id == id; });
+            if (it == inFlight.end())
+                throw std::runtime_error("reply for unknown request id " + std::to_string(id));
+            it->success = it->success && partSucceeded;
+            if (more)
+                continue;
+
+            if (it->sent >= measureFrom)
+                record(result, it->entry->type, it->sent, it->success);
+            inFlight.erase(it);
+        }
+    }
+
+    /// Where and how the sessions connect.
+    struct Target
+    {
+        std::string   transport; ///< "tls", "tcp", "unix" or "shm".
+        std::string   host;
+        uint16_t      port{0};
+        std::string   unixPath;
+        std::string   shmPath;
+        shm::WakeMode shmWake{shm::WakeMode::FUTEX};
+    };
+
+    template <typename Socket>
+    void drive(Socket& socket, const std::vector<MixEntry>& mix, unsigned seed, std::size_t depth,
+               Clock::time_point measureFrom, Clock::time_point until, SessionResult& result)
+    {
+        MixPicker picker(mix, seed);
+        if (depth > 1)
+            runPipelined(socket, picker, depth, measureFrom, until, result);
+        else
+            runClosedLoop(socket, picker, measureFrom, until, result);
+    }
+
+    void runSession(const Target& target, const std::vector<MixEntry>& mix, unsigned seed, std::size_t depth,
+                    Clock::time_point measureFrom, Clock::time_point until, SessionResult& result)
+    {
+        try
+        {
+            if (target.transport == "shm")
+            {
+                ShmClient client(target.shmPath, ShmClient::kDefaultRingBytes, target.shmWake);
+                drive(client, mix, seed, depth, measureFrom, until, result);
+                return;
+            }
+
+            boost::asio::io_context io;
+            if (target.transport == "unix")
+            {
+                boost::asio::local::stream_protocol::socket socket(io);
+                socket.connect(boost::asio::local::stream_protocol::endpoint(target.unixPath));
+                drive(socket, mix, seed, depth, measureFrom, until, result);
+                return;
+            }
+
+            boost::asio::ip::tcp::resolver resolver(io);
+            const auto endpoints = resolver.resolve(target.host, std::to_string(target.port));
+            if (target.transport == "tcp")
+            {
+                boost::asio::ip::tcp::socket socket(io);
+                boost::asio::connect(socket, endpoints);
+                socket.set_option(boost::asio::ip::tcp::no_delay(true));
+                drive(socket, mix, seed, depth, measureFrom, until, result);
+                return;
+            }
+
+            boost::asio::ssl::context tls(boost::asio::ssl::context::tls_client);
+            tls.set_verify_mode(boost::asio::ssl::verify_none);
+            SslSocket socket(io, tls);
+            boost::asio::connect(socket.lowest_layer(), endpoints);
+            socket.lowest_layer().set_option(boost::asio::ip::tcp::no_delay(true));
+            socket.handshake(boost::asio::ssl::stream_base::client);
+            drive(socket, mix, seed, depth, measureFrom, until, result);
+        }
+        catch (const std::exception& ex)
+        {
+            result.error = ex.what();
+        }
+    }
+
+    double micros(uint64_t nanos)
+    {
+        return static_cast<double>(nanos) / 1000.0;
+    }
+
+    void printRow(const char* name, const LatencyHistogram& h, uint64_t failures, double seconds)
+    {
+        std::printf("%-19s %10llu %10.0f %9llu %9.1f %9.1f %9.1f %9.1f %9.1f\n", name,
+                    static_cast<unsigned long long>(h.count()), static_cast<double>(h.count()) / seconds,
+                    static_cast<unsigned long long>(failures), micros(h.percentile(50.0)), micros(h.percentile(90.0)),
+                    micros(h.percentile(99.0)), micros(h.percentile(99.9)), micros(h.max()));
+    }
+} // namespace
+
+// ==========================================================================
+// main
+// ==========================================================================
+
+int main(int argc, char* argv[])
+{
+    cxxopts::Options options("hft_loadgen", "Closed-loop or pipelined load generator for hft_server_exe");
+
+    options.add_options()
+        ("transport", "How to connect: tls, tcp, unix or shm (as the server's --transport)",
+            cxxopts::value<std::string>()->default_value("tls"))
+        ("unix-path", "Socket file of --transport unix",
+            cxxopts::value<std::string>()->default_value("/tmp/hft_server.sock"))
+        ("shm-path", "Socket file that --transport shm attaches regions over",
+            cxxopts::value<std::string>()->default_value("/tmp/hft_server.shm"))
+        ("shm-wake", "How shm sessions wait for replies: futex or spin",
+            cxxopts::value<std::string>()->default_value("futex"))
+        ("H,host", "Server address",
+            cxxopts::value<std::string>()->default_value("127.0.0.1"))
+        ("p,port", "Server port",
+            cxxopts::value<uint16_t>()->default_value("8443"))
+        ("s,sessions", "Concurrent sessions, one thread each",
+            cxxopts::value<std::size_t>()->default_value("4"))
+        ("d,duration-s", "Seconds of measured load",
+            cxxopts::value<unsigned>()->default_value("10"))
+        ("warmup-s", "Seconds of load before measuring starts",
+            cxxopts::value<unsigned>()->default_value("1"))
+        ("mix", "Weighted request mix, TYPE=weight,...",
+            cxxopts::value<std::string>()->default_value("GET_MARKET_DATA=70,CALCULATE=20,MANIPULATE=9,GET_STATS=1"))
+        ("symbols", "Symbols per GET_MARKET_DATA request (and instruments of CALCULATE)",
+            cxxopts::value<std::size_t>()->default_value("8"))
+        ("positions", "Positions per CALCULATE request",
+            cxxopts::value<std::size_t>()->default_value("64"))
+        ("pipeline", "Tagged requests each session keeps in flight (1 = closed loop without ids)",
+            cxxopts::value<std::size_t>()->default_value("1"))
+        ("accept", "Codecs the server may compress replies with: lz4,zstd,deflate, all or none",
+            cxxopts::value<std::string>()->default_value("none"))
+        ("h,help", "Print this help message and exit");
+
+    std::vector<MixEntry> mix;
+    cxxopts::ParseResult  args;
+    try
+    {
+        args = options.parse(argc, argv);
+        if (args.count("help"))
+        {
+            std::cout << options.help() << "\n";
+            return EXIT_SUCCESS;
+        }
+        const std::string transport = args["transport"].as<std::string>();
+        if (transport != "tls" && transport != "tcp" && transport != "unix" && transport != "shm")
+            throw std::invalid_argument("unknown transport '" + transport + "'");
+        const std::string wake = args["shm-wake"].as<std::string>();
+        if (wake != "futex" && wake != "spin")
+            throw std::invalid_argument("unknown --shm-wake '" + wake + "'");
+        mix = parseMix(args["mix"].as<std::string>(), args["symbols"].as<std::size_t>(),
+                       args["positions"].as<std::size_t>(), compression::parseCodecs(args["accept"].as<std::string>()));
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Argument error: " << ex.what() << "\n" << options.help() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const Target target{args["transport"].as<std::string>(),
+                        args["host"].as<std::string>(),
+                        args["port"].as<uint16_t>(),
+                        args["unix-path"].as<std::string>(),
+                        args["shm-path"].as<std::string>(),
+                        args["shm-wake"].as<std::string>() == "spin" ? shm::WakeMode::SPIN : shm::WakeMode::FUTEX};
+    const std::size_t sessions = std::max<std::size_t>(args["sessions"].as<std::size_t>(), 1);
+    const std::size_t depth    = std::max<std::size_t>(args["pipeline"].as<std::size_t>(), 1);
+    const auto        warmup   = std::chrono::seconds(args["warmup-s"].as<unsigned>());
+    const auto        duration = std::chrono::seconds(std::max(args["duration-s"].as<unsigned>(), 1u));
+
+    const Clock::time_point    measureFrom = Clock::now() + warmup;
+    const Clock::time_point    until       = measureFrom + duration;
+    std::vector<SessionResult> results(sessions);
+    std::vector<std::thread>   threads;
+    for (std::size_t i = 0; i < sessions; ++i)
+        threads.emplace_back(runSession, std::cref(target), std::cref(mix), static_cast<unsigned>(i + 1), depth,
+                             measureFrom, until, std::ref(results[i]));
+    for (auto& thread : threads)
+        thread.join();
+
+    // ── Merge and report ───────────────────────────────────────────────────
+    std::array<LatencyHistogram, kRequestTypeCount> latency{};
+    std::array<uint64_t, kRequestTypeCount>         failures{};
+    LatencyHistogram                                all;
+    uint64_t                                        allFailures    = 0;
+    uint64_t                                        bytesIn        = 0;
+    uint64_t                                        compressed     = 0;
+    std::size_t                                     failedSessions = 0;
+    for (const SessionResult& result : results)
+    {
+        if (!result.error.empty())
+        {
+            ++failedSessions;
+            std::cerr << "session error: " << result.error << "\n";
+        }
+        bytesIn += result.bytesIn;
+        compressed += result.compressedReplies;
+        for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+        {
+            latency[t].merge(result.latency[t]);
+            all.merge(result.latency[t]);
+            failures[t] += result.failures[t];
+            allFailures += result.failures[t];
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(duration).count();
+    std::printf("%zu %s session(s) at pipeline depth %zu, %.0f s measured after %lld s warm-up\n", sessions,
+                target.transport.c_str(), depth, seconds, static_cast<long long>(warmup.count()));
+    std::printf("%-19s %10s %10s %9s %9s %9s %9s %9s %9s\n", "type", "requests", "req/s", "failed", "p50 us",
+                "p90 us", "p99 us", "p99.9 us", "max us");
+    for (const MixEntry& entry : mix)
+    {
+        const auto index = static_cast<std::size_t>(entry.type);
+        printRow(requestTypeName(entry.type), latency[index], failures[index], seconds);
+    }
+    printRow("all", all, allFailures, seconds);
+    std::printf("received %.1f MiB including warm-up, %llu compressed part(s)\n",
+                static_cast<double>(bytesIn) / (1024.0 * 1024.0), static_cast<unsigned long long>(compressed));
+
+    return failedSessions == sessions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
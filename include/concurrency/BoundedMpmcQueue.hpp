@@ -0,0 +1,176 @@
+/**
+ * @file BoundedMpmcQueue.hpp
+ * @brief Lock-free bounded multi-producer / multi-consumer ring buffer.
+ *
+ * @details Implementation of Dmitry Vyukov's bounded MPMC queue. Every slot
+ * carries a sequence number that tells producers and consumers whether the
+ * slot is free or filled for the current lap, so push and pop each cost one
+ * CAS on the shared position plus one release store on the slot. Capacity is
+ * rounded up to a power of two (minimum 2, since with a single slot the
+ * "filled" and "free on the next lap" sequence numbers coincide) and fixed
+ * at construction: the queue never
+ * allocates after that, and a full queue is reported to the caller instead
+ * of blocking.
+ */
+
+#ifndef BOUNDEDMPMCQUEUE_HPP
+#define BOUNDEDMPMCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// @brief Assumed destructive-interference size used to pad hot atomics.
+constexpr std::size_t kCacheLineSize = 64;
+
+/**
+ * @class BoundedMpmcQueue
+ * @brief Fixed-capacity lock-free queue safe for any number of threads.
+ * @tparam T Element type; must be default-constructible and move-assignable.
+ */
+template <typename T>
+class BoundedMpmcQueue
+{
+    static_assert(std::is_default_constructible<T>::value,
+                  "BoundedMpmcQueue elements must be default-constructible");
+
+public:
+    /**
+     * @brief Allocate the ring.
+     * @param capacity Minimum number of elements; rounded up to a power of two >= 2.
+     * @throws std::invalid_argument if @p capacity is 0.
+     */
+    explicit BoundedMpmcQueue(std::size_t capacity)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("[BoundedMpmcQueue] capacity must be at least 1");
+
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+            rounded <<= 1;
+
+        m_mask  = rounded - 1;
+        m_slots = std::make_unique<Slot[]>(rounded);
+        for (std::size_t i = 0; i < rounded; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&)            = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    /**
+     * @brief Enqueue @p value if there is room.
+     * @return false if the queue is full; @p value is left untouched.
+     */
+    bool tryPush(T&& value)
+    {
+        Slot*       slot = nullptr;
+        std::size_t pos  = m_enqueuePos.value.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            slot = &m_slots[pos & m_mask];
+            const std::size_t seq  = slot->sequence.load(std::memory_order_acquire);
+            const auto        diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = m_enqueuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Copying overload of tryPush().
+    bool tryPush(const T& value)
+    {
+        T copy(value);
+        return tryPush(std::move(copy));
+    }
+
+    /**
+     * @brief Dequeue the oldest element if there is one.
+     * @param out Receives the element on success.
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T& out)
+    {
+        Slot*       slot = nullptr;
+        std::size_t pos  = m_dequeuePos.value.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            slot = &m_slots[pos & m_mask];
+            const std::size_t seq  = slot->sequence.load(std::memory_order_acquire);
+            const auto        diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (m_dequeuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = m_dequeuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(slot->value);
+        slot->value = T{}; // drop resources held by the moved-from element
+        slot->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Approximate number of queued elements (exact when quiescent).
+    std::size_t sizeApprox() const
+    {
+        const std::size_t tail = m_enqueuePos.value.load(std::memory_order_acquire);
+        const std::size_t head = m_dequeuePos.value.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /// @brief True if the queue appeared empty at the time of the call.
+    bool emptyApprox() const { return sizeApprox() == 0; }
+
+    /// @brief Number of slots in the ring.
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct alignas(kCacheLineSize) Slot
+    {
+        std::atomic<std::size_t> sequence{0};
+        T                        value{};
+    };
+
+    /// Keeps producer and consumer positions on separate cache lines.
+    struct alignas(kCacheLineSize) PaddedPosition
+    {
+        std::atomic<std::size_t> value{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t             m_mask{0};
+    PaddedPosition          m_enqueuePos;
+    PaddedPosition          m_dequeuePos;
+};
+
+#endif // BOUNDEDMPMCQUEUE_HPP
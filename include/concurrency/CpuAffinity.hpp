@@ -0,0 +1,53 @@
+/**
+ * @file CpuAffinity.hpp
+ * @brief Bind a thread to one CPU.
+ */
+
+#ifndef CPUAFFINITY_HPP
+#define CPUAFFINITY_HPP
+
+#include <cstddef>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Pin the calling thread to @p cpu.
+ * @return 0 on success, otherwise the error code (-1 where pinning is not supported).
+ */
+inline int pinCurrentThreadToCpu(std::size_t cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Pin @p thread to @p cpu; unlike pinning from inside the thread, the
+ *        outcome is known when this returns.
+ * @return 0 on success, otherwise the error code (-1 where pinning is not supported).
+ */
+inline int pinThreadToCpu(std::thread& thread, std::size_t cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)cpu;
+    return -1;
+#endif
+}
+
+#endif // CPUAFFINITY_HPP
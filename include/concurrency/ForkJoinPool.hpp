@@ -0,0 +1,166 @@
+/**
+ * @file ForkJoinPool.hpp
+ * @brief Persistent worker threads for data-parallel loops.
+ *
+ * @details parallelFor() splits [0, count) into grain-sized chunks. The
+ * pool's workers and the calling thread claim chunks from a shared atomic
+ * cursor until none are left, so the caller never idles while work
+ * remains. Threads are created once, which keeps per-call overhead to one
+ * notify and one wait.
+ *
+ * The pool runs one loop at a time. A second caller that finds it busy
+ * runs its loop inline instead of queueing behind the first, so
+ * concurrent requests never block one another on the pool.
+ */
+
+#ifndef FORKJOINPOOL_HPP
+#define FORKJOINPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ForkJoinPool
+ * @brief Fixed set of threads that cooperate on one parallelFor() at a time.
+ */
+class ForkJoinPool
+{
+public:
+    /// Chunk body: processes indices [begin, end). Must not throw.
+    using Body = std::function<void(std::size_t begin, std::size_t end)>;
+
+    /**
+     * @param workers Extra threads besides the caller. The default uses one
+     *                worker per additional hardware thread; 0 runs every
+     *                loop inline.
+     */
+    explicit ForkJoinPool(std::size_t workers = defaultWorkers())
+    {
+        m_threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+            m_threads.emplace_back([this]() { workerLoop(); });
+    }
+
+    ~ForkJoinPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    ForkJoinPool(const ForkJoinPool&)            = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    /// @brief hardware_concurrency() - 1, or 0 when unknown.
+    static std::size_t defaultWorkers()
+    {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    /// @brief Threads that can work on one loop, including the caller.
+    std::size_t concurrency() const { return m_threads.size() + 1; }
+
+    /**
+     * @brief Run @p body over [0, @p count) in chunks of @p grain indices.
+     * @details Returns once every chunk has completed.
+     */
+    void parallelFor(std::size_t count, std::size_t grain, const Body& body)
+    {
+        if (count == 0)
+            return;
+        grain = std::max<std::size_t>(grain, 1);
+
+        std::unique_lock<std::mutex> busy(m_loopMutex, std::try_to_lock);
+        if (m_threads.empty() || count <= grain || !busy.owns_lock())
+        {
+            body(0, count);
+            return;
+        }
+
+        Loop loop{&body, count, grain};
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_loop = &loop;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        runChunks(loop);
+
+        // Workers that have not picked the loop up yet will find it gone;
+        // those already inside are waited for.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_loop = nullptr;
+        m_done.wait(lock, [this]() { return m_active == 0; });
+    }
+
+private:
+    struct Loop
+    {
+        const Body*              body;
+        std::size_t              count;
+        std::size_t              grain;
+        std::atomic<std::size_t> next{0};
+    };
+
+    static void runChunks(Loop& loop)
+    {
+        for (;;)
+        {
+            const std::size_t begin = loop.next.fetch_add(loop.grain, std::memory_order_relaxed);
+            if (begin >= loop.count)
+                return;
+            (*loop.body)(begin, std::min(begin + loop.grain, loop.count));
+        }
+    }
+
+    void workerLoop()
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+            if (m_stop)
+                return;
+            seen = m_generation;
+            Loop* loop = m_loop;
+            if (loop == nullptr)
+                continue;
+
+            ++m_active;
+            lock.unlock();
+            runChunks(*loop);
+            lock.lock();
+            if (--m_active == 0)
+                m_done.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+
+    /// Held by the caller of the running loop for its whole duration.
+    std::mutex m_loopMutex;
+
+    std::mutex              m_mutex; ///< Guards the fields below.
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    Loop*                   m_loop{nullptr};
+    uint64_t                m_generation{0};
+    std::size_t             m_active{0};
+    bool                    m_stop{false};
+};
+
+#endif // FORKJOINPOOL_HPP
@@ -0,0 +1,240 @@
+/**
+ * @file ShardedExecutor.hpp
+ * @brief Thread-per-shard executor: each job runs on the one thread that
+ *        owns its key.
+ *
+ * @details A shard is an owner thread and a lock-free inbound
+ * BoundedMpmcQueue. Producers pick the shard with shardOf(key) and post();
+ * the owner pops jobs in order and hands them to the handler with its
+ * shard index. State kept per shard by the handler's owner is therefore
+ * only ever touched by one thread and needs no lock, and shards never share
+ * a cache line: each one's queue positions, parking state and in-flight
+ * count are padded apart. Shard i can be pinned to CPU (firstCpu + i), so
+ * adding shards adds cores rather than contention.
+ *
+ * An idle owner spins briefly and then parks on its own condition
+ * variable; producers only notify a shard that is parked. A full queue is
+ * reported to the producer instead of blocking it.
+ */
+
+#ifndef SHARDEDEXECUTOR_HPP
+#define SHARDEDEXECUTOR_HPP
+
+#include "concurrency/BoundedMpmcQueue.hpp"
+#include "concurrency/CpuAffinity.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct ShardedExecutorConfig
+ * @brief Shard count, queue capacity and CPU placement of a ShardedExecutor.
+ */
+struct ShardedExecutorConfig
+{
+    /// @brief Owner threads; key k belongs to shard (k % shards).
+    std::size_t shards{1};
+
+    /// @brief Jobs waiting for one shard; a full queue refuses post().
+    std::size_t queueCapacity{4096};
+
+    /// @brief Pin shard i to CPU (firstCpu + i) % cores; -1 leaves the threads unpinned.
+    int firstCpu{-1};
+};
+
+/**
+ * @class ShardedExecutor
+ * @brief Fixed set of owner threads, each draining its own job queue.
+ * @tparam Job Queued unit of work; default-constructible and move-assignable.
+ */
+template <typename Job>
+class ShardedExecutor
+{
+public:
+    /// Runs @p job on the owner thread of @p shard. Must not throw.
+    using Handler = std::function<void(std::size_t shard, Job& job)>;
+
+    /**
+     * @brief Allocate the queues and start (and optionally pin) the owner threads.
+     * @throws std::invalid_argument if shards or queueCapacity is 0 or @p handler is empty.
+     */
+    ShardedExecutor(ShardedExecutorConfig config, Handler handler)
+        : m_handler(std::move(handler))
+    {
+        if (config.shards == 0 || config.queueCapacity == 0)
+            throw std::invalid_argument("[ShardedExecutor] shards and queueCapacity must be at least 1");
+        if (!m_handler)
+            throw std::invalid_argument("[ShardedExecutor] handler must not be empty");
+
+        m_shards.reserve(config.shards);
+        for (std::size_t i = 0; i < config.shards; ++i)
+            m_shards.push_back(std::make_unique<Shard>(config.queueCapacity));
+
+        const std::size_t cpuCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < m_shards.size(); ++i)
+        {
+            Shard& shard = *m_shards[i];
+            shard.thread = std::thread([this, i]() { shardLoop(i); });
+            if (config.firstCpu >= 0
+                && pinThreadToCpu(shard.thread, (static_cast<std::size_t>(config.firstCpu) + i) % cpuCount) != 0)
+                ++m_pinFailures;
+        }
+    }
+
+    /// Stops as stop() does; jobs still queued are destroyed unrun.
+    ~ShardedExecutor()
+    {
+        stop([](Job&) {});
+    }
+
+    ShardedExecutor(const ShardedExecutor&)            = delete;
+    ShardedExecutor& operator=(const ShardedExecutor&) = delete;
+
+    /// @brief Number of shards.
+    std::size_t shards() const { return m_shards.size(); }
+
+    /// @brief Shard that owns @p key.
+    std::size_t shardOf(uint64_t key) const { return static_cast<std::size_t>(key % m_shards.size()); }
+
+    /**
+     * @brief Queue @p job for the owner of @p shard.
+     * @return false if the queue is full or the executor is stopping;
+     *         @p job is left untouched.
+     */
+    bool post(std::size_t shard, Job&& job)
+    {
+        Shard& owner = *m_shards[shard];
+
+        // Counted on the shard's own line, so stop() can wait for posts
+        // that passed the check below without producers sharing a counter.
+        owner.posting.fetch_add(1, std::memory_order_seq_cst);
+        const bool accepted = !m_stopping.load(std::memory_order_seq_cst) && owner.inbound.tryPush(std::move(job));
+        owner.posting.fetch_sub(1, std::memory_order_release);
+        if (!accepted)
+            return false;
+
+        // Pairs with the seq_cst increment in shardLoop(): either the owner
+        // sees the job, or we see it parked and wake it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (owner.sleepers.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> lock(owner.idleMutex);
+            owner.idleCv.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Refuse new jobs, join the owners, then pass every job they left
+     *        queued to @p drain on the calling thread. Later calls do nothing.
+     */
+    template <typename Drain>
+    void stop(Drain&& drain)
+    {
+        if (m_stopping.exchange(true, std::memory_order_seq_cst))
+            return;
+
+        for (auto& shard : m_shards)
+        {
+            {
+                std::lock_guard<std::mutex> lock(shard->idleMutex);
+                shard->idleCv.notify_all();
+            }
+            if (shard->thread.joinable())
+                shard->thread.join();
+        }
+
+        Job job;
+        for (auto& shard : m_shards)
+        {
+            while (shard->posting.load(std::memory_order_acquire) > 0)
+                std::this_thread::yield();
+            while (shard->inbound.tryPop(job))
+            {
+                drain(job);
+                job = Job{};
+            }
+        }
+    }
+
+    /// @brief True once stop() has been called; post() refuses from then on.
+    bool stopping() const { return m_stopping.load(std::memory_order_relaxed); }
+
+    /// @brief Approximate number of jobs waiting for @p shard.
+    std::size_t queueDepth(std::size_t shard) const { return m_shards[shard]->inbound.sizeApprox(); }
+
+    /// @brief Shards that asked for a CPU and could not be pinned to it.
+    std::size_t pinFailures() const { return m_pinFailures; }
+
+private:
+    /// Busy-poll iterations before an idle owner parks on its condition variable.
+    static constexpr int kSpinIterations = 256;
+
+    struct alignas(kCacheLineSize) Shard
+    {
+        explicit Shard(std::size_t capacity)
+            : inbound(capacity)
+        {}
+
+        BoundedMpmcQueue<Job> inbound;
+
+        alignas(kCacheLineSize) std::atomic<int> posting{0}; ///< post() calls past the stopping check.
+        std::atomic<int>        sleepers{0};                 ///< The idle owner parks here.
+        std::mutex              idleMutex;
+        std::condition_variable idleCv;
+
+        std::thread thread;
+    };
+
+    void shardLoop(std::size_t index)
+    {
+        Shard& shard     = *m_shards[index];
+        Job    job;
+        int    idleSpins = 0;
+
+        while (!m_stopping.load(std::memory_order_relaxed))
+        {
+            if (shard.inbound.tryPop(job))
+            {
+                idleSpins = 0;
+                m_handler(index, job);
+                job = Job{};
+                continue;
+            }
+
+            if (++idleSpins < kSpinIterations)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            shard.sleepers.fetch_add(1, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(shard.idleMutex);
+                shard.idleCv.wait_for(lock, std::chrono::milliseconds(10), [this, &shard]() {
+                    return m_stopping.load(std::memory_order_relaxed) || !shard.inbound.emptyApprox();
+                });
+            }
+            shard.sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+    }
+
+    Handler                             m_handler;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<bool>                   m_stopping{false};
+    std::size_t                         m_pinFailures{0};
+};
+
+#endif // SHARDEDEXECUTOR_HPP
@@ -0,0 +1,60 @@
+/**
+ * @file Log.hpp
+ * @brief Logging macros for code on the request path.
+ *
+ * @details `spdlog::info("...", remote.address().to_string())` builds its
+ * arguments before spdlog checks the level, so a disabled log line still
+ * allocates and formats on the io thread. These macros check the default
+ * logger's level first, and evaluate their arguments only when the line
+ * will be written.
+ *
+ * Levels below SPDLOG_ACTIVE_LEVEL (set by the HFT_LOG_LEVEL CMake option)
+ * are removed at compile time, together with their arguments.
+ *
+ * The server's default logger is asynchronous (see main.cpp). Enabled lines
+ * are formatted into a preallocated ring slot and written by a background
+ * thread, so a burst of connection logs never waits on stdout.
+ */
+
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <spdlog/spdlog.h>
+
+/// Log through the default logger if @p level is enabled; arguments are not evaluated otherwise.
+#define HFT_LOG_AT(level, ...)                                                        \
+    do                                                                                \
+    {                                                                                 \
+        spdlog::logger* hftLogger_ = spdlog::default_logger_raw();                    \
+        if (hftLogger_->should_log(level))                                            \
+            hftLogger_->log(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, \
+                            level, __VA_ARGS__);                                      \
+    } while (false)
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define HFT_LOG_TRACE(...) HFT_LOG_AT(spdlog::level::trace, __VA_ARGS__)
+#else
+#define HFT_LOG_TRACE(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define HFT_LOG_DEBUG(...) HFT_LOG_AT(spdlog::level::debug, __VA_ARGS__)
+#else
+#define HFT_LOG_DEBUG(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define HFT_LOG_INFO(...) HFT_LOG_AT(spdlog::level::info, __VA_ARGS__)
+#else
+#define HFT_LOG_INFO(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define HFT_LOG_WARN(...) HFT_LOG_AT(spdlog::level::warn, __VA_ARGS__)
+#else
+#define HFT_LOG_WARN(...) (void)0
+#endif
+
+#define HFT_LOG_ERROR(...) HFT_LOG_AT(spdlog::level::err, __VA_ARGS__)
+
+#endif // LOG_HPP
@@ -0,0 +1,273 @@
+/**
+ * @file BufferPool.hpp
+ * @brief Size-class slab pool backing every frame buffer on the hot path.
+ *
+ * @details Blocks are grouped into power-of-four size classes from 256 B to
+ * 1 MiB. Each thread keeps a small free list per class, so acquiring and
+ * releasing a block is normally a vector push/pop with no lock and no
+ * malloc. When a thread's list overflows, half of it moves to a shared
+ * mutex-protected list, and a thread whose list is empty refills in one
+ * batch from there. This keeps blocks flowing correctly when an io thread
+ * allocates a buffer and a worker thread releases it. Requests above the
+ * largest class are served straight from the heap and are never pooled.
+ */
+
+#ifndef BUFFERPOOL_HPP
+#define BUFFERPOOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @struct BufferBlock
+ * @brief Header placed in front of every pooled allocation.
+ *
+ * The bytes follow the header directly; see bytes().
+ */
+struct alignas(16) BufferBlock
+{
+    /// Number of PooledBuffer handles that refer to this block.
+    std::atomic<uint32_t> refs{1};
+
+    /// Index of the size class, or BufferPool::kUnpooled.
+    uint32_t sizeClass{0};
+
+    /// Usable bytes after the header.
+    std::size_t capacity{0};
+
+    uint8_t*       bytes()       { return reinterpret_cast<uint8_t*>(this + 1); }
+    const uint8_t* bytes() const { return reinterpret_cast<const uint8_t*>(this + 1); }
+};
+
+/**
+ * @class BufferPool
+ * @brief Process-wide slab allocator for BufferBlock instances.
+ *
+ * Use instance(); the pool is intentionally never destroyed so that
+ * buffers released during static destruction still have a home.
+ */
+class BufferPool
+{
+public:
+    /// Number of pooled size classes (256 B, 1 KiB, ..., 1 MiB).
+    static constexpr std::size_t kClassCount = 7;
+
+    /// Capacity of the smallest size class.
+    static constexpr std::size_t kMinBlockSize = 256;
+
+    /// Capacity of the largest pooled size class.
+    static constexpr std::size_t kMaxBlockSize = kMinBlockSize << (2 * (kClassCount - 1));
+
+    /// sizeClass value marking a heap-only block.
+    static constexpr uint32_t kUnpooled = 0xFFFFFFFFu;
+
+    /// @brief The shared pool.
+    static BufferPool& instance()
+    {
+        static BufferPool* pool = new BufferPool();
+        return *pool;
+    }
+
+    /**
+     * @brief Obtain a block with at least @p minCapacity usable bytes.
+     * @return A block whose reference count is 1.
+     */
+    BufferBlock* acquire(std::size_t minCapacity)
+    {
+        const uint32_t cls = classFor(minCapacity);
+        if (cls == kUnpooled)
+            return allocate(minCapacity, kUnpooled);
+
+        if (!t_cacheDestroyed)
+        {
+            auto& local = localCache().lists[cls];
+            if (local.empty())
+                refill(cls, local);
+            if (!local.empty())
+            {
+                BufferBlock* block = local.back();
+                local.pop_back();
+                block->refs.store(1, std::memory_order_relaxed);
+                return block;
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_central[cls].mutex);
+            auto& shared = m_central[cls].blocks;
+            if (!shared.empty())
+            {
+                BufferBlock* block = shared.back();
+                shared.pop_back();
+                m_central[cls].idle.store(shared.size(), std::memory_order_relaxed);
+                block->refs.store(1, std::memory_order_relaxed);
+                return block;
+            }
+        }
+
+        return allocate(classCapacity(cls), cls);
+    }
+
+    /// @brief Return a block whose reference count has dropped to zero.
+    void release(BufferBlock* block)
+    {
+        if (block->sizeClass == kUnpooled)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        if (t_cacheDestroyed)
+        {
+            pushCentral(block->sizeClass, &block, 1);
+            return;
+        }
+
+        auto& local = localCache().lists[block->sizeClass];
+        local.push_back(block);
+        if (local.size() >= kLocalLimit)
+        {
+            const std::size_t half = local.size() / 2;
+            pushCentral(block->sizeClass, local.data() + half, local.size() - half);
+            local.resize(half);
+        }
+    }
+
+    /// @brief Number of blocks ever obtained from the heap (pooled or not).
+    uint64_t heapAllocations() const { return m_heapAllocations.load(std::memory_order_relaxed); }
+
+    /// @brief Occupancy of one size class; see classStats().
+    struct ClassStats
+    {
+        std::size_t blockSize{0};  ///< classCapacity() of the class.
+        uint64_t    blocks{0};     ///< Blocks that exist: in use or cached by a thread or the shared list.
+        uint64_t    idleShared{0}; ///< Blocks in the shared free list.
+    };
+
+    /**
+     * @brief Occupancy of size class @p cls, read without taking any lock.
+     * @details Both counts change only on the slow paths (heap allocation,
+     *          shared-list transfers), so reading them costs the hot path nothing.
+     */
+    ClassStats classStats(uint32_t cls) const
+    {
+        ClassStats stats;
+        stats.blockSize  = classCapacity(cls);
+        stats.blocks     = m_central[cls].created.load(std::memory_order_relaxed);
+        stats.idleShared = m_central[cls].idle.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// @brief Capacity of size class @p cls.
+    static constexpr std::size_t classCapacity(uint32_t cls) { return kMinBlockSize << (2 * cls); }
+
+    /// @brief Size class that can hold @p bytes, or kUnpooled if none can.
+    static uint32_t classFor(std::size_t bytes)
+    {
+        for (uint32_t cls = 0; cls < kClassCount; ++cls)
+        {
+            if (bytes <= classCapacity(cls))
+                return cls;
+        }
+        return kUnpooled;
+    }
+
+private:
+    /// Blocks a thread keeps per class before spilling half to the shared list.
+    static constexpr std::size_t kLocalLimit = 64;
+
+    /// Blocks moved from the shared list into an empty thread list at once.
+    static constexpr std::size_t kRefillBatch = 16;
+
+    /// Bytes the shared list may hold per class; extra blocks are freed.
+    static constexpr std::size_t kCentralBytesLimit = 32u * 1024u * 1024u;
+
+    struct CentralList
+    {
+        std::mutex                mutex;
+        std::vector<BufferBlock*> blocks;
+
+        /// Blocks of the class that exist, and a mirror of blocks.size(), for classStats().
+        std::atomic<uint64_t>    created{0};
+        std::atomic<std::size_t> idle{0};
+    };
+
+    struct ThreadCache
+    {
+        std::array<std::vector<BufferBlock*>, kClassCount> lists;
+
+        ~ThreadCache()
+        {
+            t_cacheDestroyed = true;
+            for (uint32_t cls = 0; cls < kClassCount; ++cls)
+            {
+                if (!lists[cls].empty())
+                    instance().pushCentral(cls, lists[cls].data(), lists[cls].size());
+            }
+        }
+    };
+
+    BufferPool() = default;
+
+    static ThreadCache& localCache()
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    BufferBlock* allocate(std::size_t capacity, uint32_t cls)
+    {
+        m_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (cls != kUnpooled)
+            m_central[cls].created.fetch_add(1, std::memory_order_relaxed);
+        void* raw = ::operator new(sizeof(BufferBlock) + capacity);
+        auto* block = new (raw) BufferBlock();
+        block->sizeClass = cls;
+        block->capacity  = capacity;
+        return block;
+    }
+
+    void refill(uint32_t cls, std::vector<BufferBlock*>& local)
+    {
+        std::lock_guard<std::mutex> lock(m_central[cls].mutex);
+        auto& shared = m_central[cls].blocks;
+        const std::size_t n = shared.size() < kRefillBatch ? shared.size() : kRefillBatch;
+        local.insert(local.end(), shared.end() - static_cast<std::ptrdiff_t>(n), shared.end());
+        shared.resize(shared.size() - n);
+        m_central[cls].idle.store(shared.size(), std::memory_order_relaxed);
+    }
+
+    void pushCentral(uint32_t cls, BufferBlock* const* blocks, std::size_t count)
+    {
+        const std::size_t limit = kCentralBytesLimit / classCapacity(cls);
+
+        std::lock_guard<std::mutex> lock(m_central[cls].mutex);
+        auto& shared = m_central[cls].blocks;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (shared.size() < limit)
+                shared.push_back(blocks[i]);
+            else
+            {
+                ::operator delete(blocks[i]);
+                m_central[cls].created.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        m_central[cls].idle.store(shared.size(), std::memory_order_relaxed);
+    }
+
+    /// Set once this thread's cache is gone; later releases go to the shared list.
+    static thread_local bool t_cacheDestroyed;
+
+    std::array<CentralList, kClassCount> m_central;
+    std::atomic<uint64_t>                m_heapAllocations{0};
+};
+
+inline thread_local bool BufferPool::t_cacheDestroyed = false;
+
+#endif // BUFFERPOOL_HPP
@@ -0,0 +1,346 @@
+/**
+ * @file PooledBuffer.hpp
+ * @brief Reference-counted byte buffer allocated from the BufferPool.
+ *
+ * @details PooledBuffer keeps the value semantics and most of the API of
+ * std::vector<uint8_t>, so code that builds or compares byte buffers does
+ * not change. Underneath, copies share one pooled block and only bump a
+ * reference count. A buffer is copied only when a shared block is written
+ * through a non-const accessor (copy-on-write). slice() returns a view of a
+ * byte range of the same block. This is how a frame read from the socket
+ * becomes Request::payload without a copy.
+ */
+
+#ifndef POOLEDBUFFER_HPP
+#define POOLEDBUFFER_HPP
+
+#include "memory/BufferPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PooledBuffer
+ * @brief Shared, copy-on-write view over a pooled byte block.
+ *
+ * One handle must not be used from two threads at the same time. Separate
+ * handles that share a block may be used and released on any threads.
+ */
+class PooledBuffer
+{
+public:
+    using value_type      = uint8_t;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = uint8_t&;
+    using const_reference = const uint8_t&;
+    using pointer         = uint8_t*;
+    using const_pointer   = const uint8_t*;
+    using iterator        = uint8_t*;
+    using const_iterator  = const uint8_t*;
+
+    PooledBuffer() noexcept = default;
+
+    /// @brief @p size zero-initialised bytes, like std::vector(size).
+    explicit PooledBuffer(size_type size) : PooledBuffer(size, 0) {}
+
+    /// @brief @p size bytes set to @p value.
+    PooledBuffer(size_type size, uint8_t value)
+    {
+        allocateExact(size);
+        if (size > 0)
+            std::memset(mutableData(), value, size);
+    }
+
+    PooledBuffer(std::initializer_list<uint8_t> bytes)
+    {
+        assignBytes(bytes.begin(), bytes.size());
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    PooledBuffer(InputIt first, InputIt last)
+    {
+        assign(first, last);
+    }
+
+    /// @brief Copy the contents of a vector into a pooled block.
+    PooledBuffer(const std::vector<uint8_t>& bytes)
+    {
+        assignBytes(bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief @p size bytes left uninitialised.
+     *
+     * Use it for buffers that are about to be overwritten completely,
+     * such as socket reads and encoded frames.
+     */
+    static PooledBuffer uninitialized(size_type size)
+    {
+        PooledBuffer buffer;
+        buffer.allocateExact(size);
+        return buffer;
+    }
+
+    PooledBuffer(const PooledBuffer& other) noexcept
+        : m_block(other.m_block), m_offset(other.m_offset), m_size(other.m_size)
+    {
+        if (m_block)
+            m_block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : m_block(other.m_block), m_offset(other.m_offset), m_size(other.m_size)
+    {
+        other.m_block  = nullptr;
+        other.m_offset = 0;
+        other.m_size   = 0;
+    }
+
+    PooledBuffer& operator=(const PooledBuffer& other) noexcept
+    {
+        if (this != &other)
+        {
+            PooledBuffer copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            PooledBuffer moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    PooledBuffer& operator=(std::initializer_list<uint8_t> bytes)
+    {
+        assignBytes(bytes.begin(), bytes.size());
+        return *this;
+    }
+
+    ~PooledBuffer() { reset(); }
+
+    void swap(PooledBuffer& other) noexcept
+    {
+        std::swap(m_block, other.m_block);
+        std::swap(m_offset, other.m_offset);
+        std::swap(m_size, other.m_size);
+    }
+
+    // ------------------------------------------------------------------
+    // Read access (never copies)
+    // ------------------------------------------------------------------
+
+    size_type size() const noexcept { return m_size; }
+    bool      empty() const noexcept { return m_size == 0; }
+
+    /// @brief Bytes available before the buffer must move to a bigger block.
+    size_type capacity() const noexcept { return m_block ? m_block->capacity - m_offset : 0; }
+
+    const uint8_t* data() const noexcept { return m_block ? m_block->bytes() + m_offset : nullptr; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + m_size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const uint8_t& operator[](size_type i) const { return data()[i]; }
+
+    /// @brief Number of handles sharing this buffer's block (0 if none).
+    uint32_t useCount() const noexcept
+    {
+        return m_block ? m_block->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief A buffer over bytes [offset, offset + length) sharing this block.
+     * @throws std::out_of_range if the range exceeds size().
+     */
+    PooledBuffer slice(size_type offset, size_type length) const
+    {
+        if (offset > m_size || length > m_size - offset)
+            throw std::out_of_range("[PooledBuffer] slice out of range");
+
+        PooledBuffer view(*this);
+        view.m_offset += offset;
+        view.m_size    = length;
+        return view;
+    }
+
+    /// @brief Copy the contents into a plain vector.
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(begin(), end()); }
+
+    // ------------------------------------------------------------------
+    // Write access (detaches from a shared block first)
+    // ------------------------------------------------------------------
+
+    uint8_t* data() { return m_size ? mutableData() : nullptr; }
+    iterator begin() { return data(); }
+    iterator end() { return data() + m_size; }
+    uint8_t& operator[](size_type i) { return mutableData()[i]; }
+
+    /// @brief Resize, zero-filling any new bytes.
+    void resize(size_type size)
+    {
+        if (size <= m_size)
+        {
+            m_size = size; // shrinking only narrows this handle's view
+            return;
+        }
+        const size_type old = m_size;
+        detach(size);
+        std::memset(m_block->bytes() + m_offset + old, 0, size - old);
+        m_size = size;
+    }
+
+    void reserve(size_type size)
+    {
+        if (size == 0 && !m_block)
+            return;
+        detach(size);
+    }
+
+    void clear() noexcept { reset(); }
+
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value)
+        {
+            // Fill a fresh block first: the source may alias this buffer.
+            PooledBuffer fresh = uninitialized(static_cast<size_type>(last - first));
+            if (!fresh.empty())
+                std::copy(first, last, fresh.m_block->bytes());
+            swap(fresh);
+        }
+        else
+        {
+            clear();
+            for (; first != last; ++first)
+                push_back(static_cast<uint8_t>(*first));
+        }
+    }
+
+    void push_back(uint8_t value)
+    {
+        reserveForAppend(m_size + 1);
+        m_block->bytes()[m_offset + m_size++] = value;
+    }
+
+    /// @brief Append @p length bytes from @p bytes.
+    void append(const uint8_t* bytes, size_type length)
+    {
+        if (length == 0)
+            return;
+        reserveForAppend(m_size + length);
+        std::memcpy(m_block->bytes() + m_offset + m_size, bytes, length);
+        m_size += length;
+    }
+
+private:
+    void reset() noexcept
+    {
+        if (m_block && m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            BufferPool::instance().release(m_block);
+        m_block  = nullptr;
+        m_offset = 0;
+        m_size   = 0;
+    }
+
+    void allocateExact(size_type size)
+    {
+        reset();
+        if (size == 0)
+            return;
+        m_block = BufferPool::instance().acquire(size);
+        m_size  = size;
+    }
+
+    void assignBytes(const uint8_t* bytes, size_type length)
+    {
+        if (isUnique() && m_block->capacity >= length)
+        {
+            std::memmove(m_block->bytes(), bytes, length);
+            m_offset = 0;
+            m_size   = length;
+            return;
+        }
+
+        PooledBuffer fresh = uninitialized(length);
+        if (length > 0)
+            std::memcpy(fresh.m_block->bytes(), bytes, length);
+        swap(fresh);
+    }
+
+    bool isUnique() const noexcept
+    {
+        return m_block && m_block->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    /// Grow geometrically so repeated appends stay amortised O(1).
+    void reserveForAppend(size_type required)
+    {
+        if (isUnique() && capacity() >= required)
+            return;
+        detach(std::max<size_type>(required, m_size * 2));
+    }
+
+    uint8_t* mutableData()
+    {
+        detach(m_size);
+        return m_block->bytes() + m_offset;
+    }
+
+    /**
+     * Make this handle the sole owner of a block with room for
+     * @p minCapacity bytes after m_offset, copying the current contents
+     * if a new block is needed.
+     */
+    void detach(size_type minCapacity)
+    {
+        if (isUnique() && capacity() >= minCapacity)
+            return;
+
+        BufferBlock* fresh = BufferPool::instance().acquire(std::max<size_type>(minCapacity, 1));
+        if (m_size > 0)
+            std::memcpy(fresh->bytes(), m_block->bytes() + m_offset, m_size);
+
+        const size_type size = m_size;
+        reset();
+        m_block = fresh;
+        m_size  = size;
+    }
+
+    BufferBlock* m_block{nullptr};
+    size_type    m_offset{0};
+    size_type    m_size{0};
+};
+
+inline bool operator==(const PooledBuffer& a, const PooledBuffer& b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator!=(const PooledBuffer& a, const PooledBuffer& b) { return !(a == b); }
+
+inline bool operator==(const PooledBuffer& a, const std::vector<uint8_t>& b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator==(const std::vector<uint8_t>& a, const PooledBuffer& b) { return b == a; }
+
+#endif // POOLEDBUFFER_HPP
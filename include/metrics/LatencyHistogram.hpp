@@ -0,0 +1,143 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @brief Fixed-size log-linear (HDR-style) histogram of nanosecond latencies.
+ *
+ * @details Values below 64 ns get a bucket each. Above that, every power of
+ * two is split into 32 equal sub-buckets, so a bucket is never wider than
+ * 1/32 of its lower bound: a percentile read back is within about 3% of the
+ * true value. 1024 buckets reach 2^36 ns (about 68 s); larger values land in
+ * the last bucket. Recording is an index computation and an increment, and
+ * two histograms merge by adding their buckets.
+ *
+ * This class is a plain value, owned by one thread. LatencyRecorder keeps
+ * the concurrent per-thread copies and merges them into one of these.
+ */
+
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief Bucketed distribution of latencies with percentile queries.
+ */
+class LatencyHistogram
+{
+public:
+    /// Each power of two above the linear range is split into 2^kSubBucketBits buckets.
+    static constexpr unsigned kSubBucketBits = 5;
+
+    /// Largest value with its own range is 2^kMaxValueBits - 1 ns.
+    static constexpr unsigned kMaxValueBits = 36;
+
+    static constexpr std::size_t kSubBucketCount = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount    = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    /// @brief Bucket that @p value falls into.
+    static constexpr std::size_t bucketIndex(uint64_t value)
+    {
+        if (value < 2 * kSubBucketCount)
+            return static_cast<std::size_t>(value);
+        if (value >> kMaxValueBits)
+            return kBucketCount - 1;
+        const unsigned shift = highestBit(value) - kSubBucketBits;
+        return shift * kSubBucketCount + static_cast<std::size_t>(value >> shift);
+    }
+
+    /// @brief Largest value that falls into bucket @p index.
+    static constexpr uint64_t bucketUpperBound(std::size_t index)
+    {
+        if (index < 2 * kSubBucketCount)
+            return index;
+        const std::size_t shift = index / kSubBucketCount - 1;
+        const uint64_t    base  = index - shift * kSubBucketCount; // in [kSubBucketCount, 2 * kSubBucketCount)
+        return ((base + 1) << shift) - 1;
+    }
+
+    /// @brief Add @p count occurrences of @p nanos.
+    void record(uint64_t nanos, uint64_t count = 1)
+    {
+        m_counts[bucketIndex(nanos)] += count;
+        m_count += count;
+        m_sum += nanos * count;
+        m_max = std::max(m_max, nanos);
+    }
+
+    /// @brief Add every value recorded in @p other.
+    void merge(const LatencyHistogram& other)
+    {
+        for (std::size_t i = 0; i < kBucketCount; ++i)
+            m_counts[i] += other.m_counts[i];
+        mergeTotals(other.m_sum, other.m_max);
+        m_count += other.m_count;
+    }
+
+    /// @brief Add @p count values to bucket @p index; pair with mergeTotals().
+    void mergeBucket(std::size_t index, uint64_t count)
+    {
+        m_counts[index] += count;
+        m_count += count;
+    }
+
+    /// @brief Add the sum and maximum of values merged with mergeBucket().
+    void mergeTotals(uint64_t sum, uint64_t max)
+    {
+        m_sum += sum;
+        m_max = std::max(m_max, max);
+    }
+
+    /**
+     * @brief Smallest recorded value that @p percent of the values do not exceed.
+     * @param percent In [0, 100].
+     * @return The upper bound of the bucket it falls into, capped at max();
+     *         0 if the histogram is empty.
+     */
+    uint64_t percentile(double percent) const
+    {
+        if (m_count == 0)
+            return 0;
+        const double   clamped = std::min(std::max(percent, 0.0), 100.0);
+        const uint64_t rank    = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * m_count + 0.5));
+
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i)
+        {
+            seen += m_counts[i];
+            if (seen >= rank)
+                return std::min(bucketUpperBound(i), m_max);
+        }
+        return m_max;
+    }
+
+    uint64_t count() const { return m_count; }
+    uint64_t sum() const { return m_sum; }
+    uint64_t max() const { return m_max; }
+    double   mean() const { return m_count ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0; }
+
+    /// @brief Occurrences recorded in bucket @p index.
+    uint64_t bucketCount(std::size_t index) const { return m_counts[index]; }
+
+private:
+    static constexpr unsigned highestBit(uint64_t value)
+    {
+#if defined(__GNUC__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1)
+            ++bit;
+        return bit;
+#endif
+    }
+
+    std::array<uint64_t, kBucketCount> m_counts{};
+    uint64_t                           m_count{0};
+    uint64_t                           m_sum{0};
+    uint64_t                           m_max{0};
+};
+
+#endif // LATENCYHISTOGRAM_HPP
@@ -0,0 +1,218 @@
+/**
+ * @file LatencyRecorder.hpp
+ * @brief Process-wide per-thread latency histograms keyed by RequestType and stage.
+ *
+ * @details A request is stamped with steady_clock (the vDSO TSC clock on
+ * Linux) as it moves through the server:
+ *
+ *   received ─DECODE─▶ decoded ─QUEUE─▶ command start ─SERVICE─▶ command end
+ *   reply queued on its session ─SEND─▶ write complete
+ *
+ * TOTAL is received → write complete. SEND includes TLS encryption and the
+ * socket write. The hand-off of the reply from the worker back to the io
+ * thread is whatever TOTAL leaves unexplained.
+ *
+ * Each interval is recorded where its end is stamped, into a histogram that
+ * belongs to the recording thread. Recording takes no lock and does no
+ * read-modify-write atomics: the owner thread is the only writer, and it
+ * updates relaxed atomics only so that histogram() can read them from
+ * another thread. histogram() merges every thread's copy on demand.
+ */
+
+#ifndef LATENCYRECORDER_HPP
+#define LATENCYRECORDER_HPP
+
+#include "metrics/LatencyHistogram.hpp"
+#include "server/RequestTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @enum LatencyStage
+ * @brief Interval of a request's life; see the file comment.
+ */
+enum class LatencyStage : uint8_t
+{
+    DECODE  = 0, ///< Frame received → request decoded (io thread).
+    QUEUE   = 1, ///< Decoded → command started (waiting for a worker).
+    SERVICE = 2, ///< Command started → command returned (worker).
+    SEND    = 3, ///< Reply queued on the session → written to the socket (io thread).
+    TOTAL   = 4, ///< Frame received → reply written.
+};
+
+/// @brief Number of LatencyStage values; keep in sync with the enum above.
+constexpr std::size_t kLatencyStageCount = 5;
+
+/// @brief Lower-case name of a stage, for logs and statistics.
+constexpr const char* latencyStageName(LatencyStage stage)
+{
+    switch (stage)
+    {
+    case LatencyStage::DECODE:  return "decode";
+    case LatencyStage::QUEUE:   return "queue";
+    case LatencyStage::SERVICE: return "service";
+    case LatencyStage::SEND:    return "send";
+    case LatencyStage::TOTAL:   return "total";
+    }
+    return "unknown";
+}
+
+/**
+ * @class LatencyRecorder
+ * @brief Lock-free per-thread recording, merged on demand.
+ *
+ * Use instance(); like BufferPool, the recorder is never destroyed so that
+ * threads still running during static destruction can record.
+ */
+class LatencyRecorder
+{
+public:
+    /// @brief The shared recorder.
+    static LatencyRecorder& instance()
+    {
+        static LatencyRecorder* recorder = new LatencyRecorder();
+        return *recorder;
+    }
+
+    /// @brief Current time in nanoseconds of the monotonic clock; never 0.
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// @brief Record one @p stage interval of @p nanos for a request of @p type.
+    void record(RequestType type, LatencyStage stage, uint64_t nanos)
+    {
+        Cell& cell = localCell(slot(type, stage));
+        const std::size_t bucket = LatencyHistogram::bucketIndex(nanos);
+        cell.counts[bucket].store(cell.counts[bucket].load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_relaxed);
+        cell.sum.store(cell.sum.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+        if (nanos > cell.max.load(std::memory_order_relaxed))
+            cell.max.store(nanos, std::memory_order_relaxed);
+    }
+
+    /// @brief Record the interval from @p since (a now() stamp) to now; ignored if @p since is 0.
+    void recordSince(RequestType type, LatencyStage stage, int64_t since)
+    {
+        if (since == 0)
+            return;
+        const int64_t elapsed = now() - since;
+        record(type, stage, elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0);
+    }
+
+    /// @brief Everything recorded so far for @p type and @p stage, over all threads.
+    LatencyHistogram histogram(RequestType type, LatencyStage stage) const
+    {
+        LatencyHistogram  merged;
+        const std::size_t index = slot(type, stage);
+
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto& thread : m_threads)
+        {
+            const Cell* cell = thread->cells[index].load(std::memory_order_acquire);
+            if (!cell)
+                continue;
+            for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i)
+            {
+                const uint64_t count = cell->counts[i].load(std::memory_order_relaxed);
+                if (count != 0)
+                    merged.mergeBucket(i, count);
+            }
+            merged.mergeTotals(cell->sum.load(std::memory_order_relaxed), cell->max.load(std::memory_order_relaxed));
+        }
+        return merged;
+    }
+
+    LatencyRecorder(const LatencyRecorder&)            = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+private:
+    /// One thread's histogram for one (type, stage) pair.
+    struct Cell
+    {
+        std::array<std::atomic<uint64_t>, LatencyHistogram::kBucketCount> counts{};
+        std::atomic<uint64_t>                                              sum{0};
+        std::atomic<uint64_t>                                              max{0};
+    };
+
+    /// Unknown request types share a trailing slot, as in the pipeline lanes.
+    static constexpr std::size_t kSlotCount = (kRequestTypeCount + 1) * kLatencyStageCount;
+
+    /// One thread's cells, allocated on first use; kept after the thread exits.
+    struct ThreadCells
+    {
+        std::array<std::atomic<Cell*>, kSlotCount> cells{};
+
+        ~ThreadCells()
+        {
+            for (auto& cell : cells)
+                delete cell.load(std::memory_order_relaxed);
+        }
+    };
+
+    LatencyRecorder() = default;
+
+    static std::size_t slot(RequestType type, LatencyStage stage)
+    {
+        return requestTypeIndex(type) * kLatencyStageCount + static_cast<std::size_t>(stage);
+    }
+
+    Cell& localCell(std::size_t index)
+    {
+        thread_local ThreadCells* t_cells = nullptr;
+        if (!t_cells)
+        {
+            auto cells = std::make_unique<ThreadCells>();
+            t_cells    = cells.get();
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            m_threads.push_back(std::move(cells));
+        }
+
+        Cell* cell = t_cells->cells[index].load(std::memory_order_relaxed);
+        if (!cell)
+        {
+            cell = new Cell();
+            t_cells->cells[index].store(cell, std::memory_order_release);
+        }
+        return *cell;
+    }
+
+    mutable std::mutex                        m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadCells>> m_threads;
+};
+
+/**
+ * @class ScopedLatency
+ * @brief Records the lifetime of the object as one stage interval.
+ */
+class ScopedLatency
+{
+public:
+    ScopedLatency(RequestType type, LatencyStage stage)
+        : m_type(type)
+        , m_stage(stage)
+        , m_start(LatencyRecorder::now())
+    {}
+
+    ~ScopedLatency() { LatencyRecorder::instance().recordSince(m_type, m_stage, m_start); }
+
+    ScopedLatency(const ScopedLatency&)            = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    RequestType  m_type;
+    LatencyStage m_stage;
+    int64_t      m_start;
+};
+
+#endif // LATENCYRECORDER_HPP
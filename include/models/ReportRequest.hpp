@@ -1,16 +1,21 @@
 /**
  * @file ReportRequest.hpp
- * @brief POD-compatible struct representing a report generation request.
+ * @brief Struct representing a report generation request.
  *
  * @details Carries the parameters required to identify and scope a report:
  * the report type (e.g., "EndOfDay") and the inclusive date range. Passed
  * directly to IReportService::generateReport() and into the BaseReport
- * pipeline.
+ * pipeline. On the wire it is a ReportRequestPOD, optionally followed by a
+ * ReportOptionsPOD, decoded by ReportCommand::decode(); the dates stay day
+ * numbers throughout.
  */
 
 #ifndef REPORTREQUEST_HPP
 #define REPORTREQUEST_HPP
 
+#include "models/TradingDate.hpp"
+#include "pod/TradingPOD.hpp"
+
 #include <string>
 
 /**
@@ -22,11 +27,14 @@ struct ReportRequest
     /// @brief Identifies which report to generate (e.g., "EndOfDay", "Blotter").
     std::string reportType;
 
-    /// @brief Inclusive start date in ISO 8601 format (YYYY-MM-DD).
-    std::string dateFrom;
+    /// @brief Inclusive start date.
+    TradingDate dateFrom;
+
+    /// @brief Inclusive end date.
+    TradingDate dateTo;
 
-    /// @brief Inclusive end date in ISO 8601 format (YYYY-MM-DD).
-    std::string dateTo;
+    /// @brief Layout of the reply's data; TEXT unless the request carries a ReportOptionsPOD.
+    ReportFormat format{ReportFormat::TEXT};
 };
 
 #endif // REPORTREQUEST_HPP
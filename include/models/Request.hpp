@@ -11,10 +11,23 @@
 #define REQUEST_HPP
 
 #include <cstdint>
-#include <vector>
 
+#include "memory/PooledBuffer.hpp"
 #include "server/RequestTypes.hpp"
 
+/**
+ * @struct RequestTiming
+ * @brief LatencyRecorder::now() stamps taken by the transport (0 = not taken).
+ */
+struct RequestTiming
+{
+    /// @brief The whole frame had been read off the connection.
+    int64_t receivedAt{0};
+
+    /// @brief The frame had been decoded into a Request.
+    int64_t decodedAt{0};
+};
+
 /**
  * @struct Request
  * @brief Represents a client request with a typed operation and binary payload.
@@ -24,8 +37,28 @@ struct Request
     /// @brief The type of operation requested by the client.
     RequestType type{RequestType::GET_MARKET_DATA};
 
+    /// @brief Transport session the request arrived on (0 if none).
+    /// @details Lets session-scoped operations such as SUBSCRIBE address
+    ///          pushed messages back to the right client.
+    uint64_t sessionId{0};
+
     /// @brief Binary payload containing operation-specific parameters.
-    std::vector<uint8_t> payload;
+    /// @details Usually a slice of the frame buffer the request was read into.
+    PooledBuffer payload;
+
+    /// @brief When the request arrived; lets the pipeline time its queueing.
+    RequestTiming timing;
+
+    /// @brief Client-chosen id echoed on every part of the reply; valid if hasRequestId.
+    uint64_t requestId{0};
+
+    /// @brief The frame carried a request id: the client pipelines requests
+    ///        and matches replies by id, so they may complete out of order.
+    bool hasRequestId{false};
+
+    /// @brief Codecs the client can decode the reply's data with
+    ///        (a compression::codecBit() set, 0 = uncompressed only).
+    uint8_t acceptCodecs{0};
 };
 
 #endif // REQUEST_HPP
@@ -11,8 +11,10 @@
 #define RESPONSE_HPP
 
 #include <cstdint>
+#include <functional>
 #include <string>
-#include <vector>
+
+#include "memory/PooledBuffer.hpp"
 
 /**
  * @struct Response
@@ -27,7 +29,31 @@ struct Response
     std::string message;
 
     /// @brief Binary payload containing the operation result data.
-    std::vector<uint8_t> data;
+    PooledBuffer data;
+
+    /// @brief True for server-initiated messages (e.g. subscription updates)
+    ///        that do not answer a request.
+    bool push{false};
+
+    /// @brief True for a partial reply of a streamed request; more responses
+    ///        for the same request follow, and the last one has it cleared.
+    bool more{false};
+
+    /// @brief Id of the request this answers; valid if hasRequestId.
+    /// @details Set by the transport from the Request, not by commands.
+    uint64_t requestId{0};
+
+    /// @brief The request carried an id, so the reply is tagged with it.
+    bool hasRequestId{false};
+
+    /// @brief Codec @c data is compressed with (a compression::Codec, 0 = none).
+    /// @details Set by the transport when it compresses a large reply.
+    uint8_t codec{0};
 };
 
+/// @brief Receives responses produced asynchronously. For a streamed reply it
+///        is called once per chunk, in order; only the last call has
+///        Response::more cleared.
+using ResponseCallback = std::function<void(Response)>;
+
 #endif // RESPONSE_HPP
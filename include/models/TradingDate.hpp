@@ -0,0 +1,142 @@
+/**
+ * @file TradingDate.hpp
+ * @brief Calendar date held as a day number, with ISO 8601 conversion.
+ *
+ * @details A TradingDate is the number of days since 1970-01-01 in the
+ * proleptic Gregorian calendar. Ranges are then integer ranges: splitting a
+ * report into days, or comparing and stepping dates, needs no calendar
+ * arithmetic or string handling. Conversion to and from year/month/day uses
+ * Howard Hinnant's days_from_civil / civil_from_days algorithms. Text is
+ * only ever YYYY-MM-DD.
+ */
+
+#ifndef TRADINGDATE_HPP
+#define TRADINGDATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @struct TradingDate
+ * @brief Days since the Unix epoch; ordered and trivially copyable.
+ */
+struct TradingDate
+{
+    /// Length of the ISO 8601 text form, "YYYY-MM-DD".
+    static constexpr std::size_t kIsoLength = 10;
+
+    int32_t days{0}; ///< Days since 1970-01-01.
+
+    /// @brief The date @p year-@p month-@p day (month and day 1-based).
+    static constexpr TradingDate fromCivil(int32_t year, uint32_t month, uint32_t day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        const int32_t  era = (year >= 0 ? year : year - 399) / 400;
+        const uint32_t yoe = static_cast<uint32_t>(year - era * 400);
+        const uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return TradingDate{era * 146097 + static_cast<int32_t>(doe) - 719468};
+    }
+
+    /// @brief Split into year, month (1-12) and day (1-31).
+    constexpr void toCivil(int32_t& year, uint32_t& month, uint32_t& day) const
+    {
+        const int32_t  z   = days + 719468;
+        const int32_t  era = (z >= 0 ? z : z - 146096) / 146097;
+        const uint32_t doe = static_cast<uint32_t>(z - era * 146097);
+        const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const uint32_t mp  = (5 * doy + 2) / 153;
+        day   = doy - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year  = static_cast<int32_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+    }
+
+    /**
+     * @brief Parse "YYYY-MM-DD".
+     * @return false (leaving @p out untouched) unless @p text is exactly a
+     *         valid date in that form.
+     */
+    static bool parseIso(std::string_view text, TradingDate& out)
+    {
+        if (text.size() != kIsoLength || text[4] != '-' || text[7] != '-')
+            return false;
+
+        uint32_t fields[3] = {0, 0, 0};
+        const std::size_t starts[3] = {0, 5, 8};
+        const std::size_t lengths[3] = {4, 2, 2};
+        for (int f = 0; f < 3; ++f)
+        {
+            for (std::size_t i = 0; i < lengths[f]; ++i)
+            {
+                const char c = text[starts[f] + i];
+                if (c < '0' || c > '9')
+                    return false;
+                fields[f] = fields[f] * 10 + static_cast<uint32_t>(c - '0');
+            }
+        }
+
+        const uint32_t month = fields[1];
+        const uint32_t day   = fields[2];
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(static_cast<int32_t>(fields[0]), month))
+            return false;
+
+        out = fromCivil(static_cast<int32_t>(fields[0]), month, day);
+        return true;
+    }
+
+    /// @brief Write "YYYY-MM-DD" to @p out (kIsoLength bytes, no terminator).
+    ///        Years outside 0-9999 are not representable and wrap.
+    void formatIso(char* out) const
+    {
+        int32_t  year;
+        uint32_t month, day;
+        toCivil(year, month, day);
+        const auto y = static_cast<uint32_t>(year) % 10000;
+        out[0] = static_cast<char>('0' + y / 1000);
+        out[1] = static_cast<char>('0' + y / 100 % 10);
+        out[2] = static_cast<char>('0' + y / 10 % 10);
+        out[3] = static_cast<char>('0' + y % 10);
+        out[4] = '-';
+        out[5] = static_cast<char>('0' + month / 10);
+        out[6] = static_cast<char>('0' + month % 10);
+        out[7] = '-';
+        out[8] = static_cast<char>('0' + day / 10);
+        out[9] = static_cast<char>('0' + day % 10);
+    }
+
+    /// @brief "YYYY-MM-DD".
+    std::string toIso() const
+    {
+        std::string text(kIsoLength, '\0');
+        formatIso(&text[0]);
+        return text;
+    }
+
+    /// @brief True for 0000-01-01 .. 9999-12-31, the dates parseIso() accepts and toIso() writes.
+    constexpr bool inIsoRange() const
+    {
+        return days >= fromCivil(0, 1, 1).days && days <= fromCivil(9999, 12, 31).days;
+    }
+
+    static constexpr bool isLeapYear(int32_t year)
+    {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static constexpr uint32_t daysInMonth(int32_t year, uint32_t month)
+    {
+        constexpr uint8_t kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && isLeapYear(year) ? 29u : kDays[month - 1];
+    }
+
+    constexpr TradingDate operator+(int32_t n) const { return TradingDate{days + n}; }
+    constexpr bool operator==(TradingDate other) const { return days == other.days; }
+    constexpr bool operator!=(TradingDate other) const { return days != other.days; }
+    constexpr bool operator<(TradingDate other) const { return days < other.days; }
+    constexpr bool operator<=(TradingDate other) const { return days <= other.days; }
+};
+
+#endif // TRADINGDATE_HPP
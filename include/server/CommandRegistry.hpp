@@ -2,17 +2,26 @@
  * @file CommandRegistry.hpp
  * @brief Maps RequestType enum values to command factory functions.
  *
- * @details The CommandRegistry owns a map of CommandFactory callables keyed
- * by RequestType. The TradingServerFacade calls create() to obtain a
- * ready-to-execute ICommand instance for every incoming request.
+ * @details RequestType is a dense enum, so the CommandRegistry stores one
+ * slot per type in a flat array indexed by requestTypeIndex() instead of
+ * hashing. A slot holds a CommandFactory, which builds a heap-allocated
+ * ICommand, a RequestHandler, which performs the operation directly with no
+ * allocation, or a StreamingHandler, which may also emit partial responses. The TradingServerFacade calls execute() for every incoming
+ * request; create() remains for callers that need the command object.
+ *
+ * An AsyncHandler hands the request to threads of its own (order entry
+ * does, to the owner thread of the symbol's book) and completes it later.
+ * The facade's handleRequestAsync() calls it through executeAsync();
+ * execute() waits for its completion, so BATCH and synchronous callers
+ * still work.
  */
 
 #ifndef COMMANDREGISTRY_HPP
 #define COMMANDREGISTRY_HPP
 
+#include <array>
 #include <functional>
 #include <memory>
-#include <unordered_map>
 
 #include "ICommand.hpp"
 #include "RequestTypes.hpp"
@@ -23,6 +32,31 @@
  */
 using CommandFactory = std::function<std::unique_ptr<ICommand>(const Request&)>;
 
+/**
+ * @brief Handler that executes a request in place and returns its Response.
+ *
+ * Typically forwards to a command's static run() with a service captured
+ * at registration, so no command object or shared_ptr copy is made per call.
+ */
+using RequestHandler = std::function<Response(const Request&)>;
+
+/**
+ * @brief Handler whose reply may be streamed as several responses.
+ *
+ * Partial responses go to @c onChunk with Response::more set; the returned
+ * Response is the last one. If @c onChunk is empty the handler must return
+ * the whole result instead.
+ */
+using StreamingHandler = std::function<Response(const Request&, const ResponseCallback& onChunk)>;
+
+/**
+ * @brief Handler that completes its request on threads of its own.
+ *
+ * Must neither block nor throw: @c onComplete is called exactly once,
+ * usually on another thread, possibly before the handler returns.
+ */
+using AsyncHandler = std::function<void(const Request&, ResponseCallback onComplete)>;
+
 /**
  * @class CommandRegistry
  * @brief Registry that maps RequestType values to CommandFactory functions.
@@ -42,6 +76,10 @@ public:
      * @param type    The request type to associate with the factory.
      * @param factory A callable that constructs the corresponding ICommand.
      *
+     * Replaces any factory or handler previously registered for @p type.
+     *
+     * @throws std::out_of_range if @p type is not a known RequestType.
+     *
      * // TODO: REGISTER — Call this method for every new command you add.
      *          Example:
      *            registry.registerCommand(RequestType::MY_NEW_TYPE,
@@ -51,6 +89,42 @@ public:
      */
     void registerCommand(RequestType type, CommandFactory factory);
 
+    /**
+     * @brief Register an allocation-free handler for the given request type.
+     * @param type    The request type to associate with the handler.
+     * @param handler A callable that executes the request directly.
+     *
+     * Replaces any factory or handler previously registered for @p type.
+     * Example:
+     *   registry.registerHandler(RequestType::CALCULATE,
+     *       [svc](const Request& r) { return CalculationCommand::run(*svc, r); });
+     *
+     * @throws std::out_of_range if @p type is not a known RequestType.
+     */
+    void registerHandler(RequestType type, RequestHandler handler);
+
+    /**
+     * @brief Register a handler that may stream its reply in several parts.
+     * @param type    The request type to associate with the handler.
+     * @param handler A callable that executes the request, emitting chunks.
+     *
+     * Replaces any factory or handler previously registered for @p type.
+     *
+     * @throws std::out_of_range if @p type is not a known RequestType.
+     */
+    void registerStreamingHandler(RequestType type, StreamingHandler handler);
+
+    /**
+     * @brief Register a handler that completes requests on its own threads.
+     * @param type    The request type to associate with the handler.
+     * @param handler A callable that queues the request and returns.
+     *
+     * Replaces any factory or handler previously registered for @p type.
+     *
+     * @throws std::out_of_range if @p type is not a known RequestType.
+     */
+    void registerAsyncHandler(RequestType type, AsyncHandler handler);
+
     /**
      * @brief Create an ICommand instance for the given request.
      * @param request The incoming client request.
@@ -59,9 +133,55 @@ public:
      */
     std::unique_ptr<ICommand> create(const Request& request) const;
 
+    /**
+     * @brief Execute the request with its registered handler or command.
+     * @param request The incoming client request.
+     * @return The operation's Response.
+     * @throws std::out_of_range if nothing is registered for the request type.
+     *
+     * Prefers the handler; falls back to create()->execute() otherwise.
+     */
+    Response execute(const Request& request) const;
+
+    /**
+     * @brief Execute the request, passing partial responses to @p onChunk.
+     * @return The final Response.
+     * @throws std::out_of_range if nothing is registered for the request type.
+     *
+     * Only streaming handlers and commands that override executeStreaming()
+     * emit chunks; everything else returns its single response.
+     */
+    Response execute(const Request& request, const ResponseCallback& onChunk) const;
+
+    /**
+     * @brief Execute the request, delivering the response to @p onComplete.
+     * @throws std::out_of_range if nothing is registered for the request type.
+     *
+     * An async handler is called as is; everything else runs inline, as
+     * execute(request, onComplete) followed by onComplete(final response).
+     */
+    void executeAsync(const Request& request, ResponseCallback onComplete) const;
+
+    /// @brief True if @p type is registered with an AsyncHandler.
+    bool isAsync(RequestType type) const;
+
+    /// @brief True if a factory or handler is registered for @p type.
+    bool isRegistered(RequestType type) const;
+
 private:
-    /// @brief Internal map from RequestType to CommandFactory.
-    std::unordered_map<RequestType, CommandFactory> m_factories;
+    struct Slot
+    {
+        CommandFactory   factory;
+        RequestHandler   handler;
+        StreamingHandler streaming;
+        AsyncHandler     async;
+    };
+
+    /// @brief Slot for @p type; throws std::out_of_range for unknown types.
+    const Slot& slotFor(RequestType type) const;
+
+    /// @brief One slot per RequestType, indexed by requestTypeIndex().
+    std::array<Slot, kRequestTypeCount> m_slots;
 };
 
 #endif // COMMANDREGISTRY_HPP
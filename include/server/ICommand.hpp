@@ -31,6 +31,21 @@ public:
      * @return A Response containing the operation result or an error.
      */
     virtual Response execute() = 0;
+
+    /**
+     * @brief Execute the command, streaming partial results to @p onChunk.
+     * @param onChunk Receives partial responses with Response::more set; may
+     *                be empty, in which case the whole result is returned.
+     * @return The final response.
+     *
+     * Commands whose result can be produced incrementally override this; the
+     * default calls execute().
+     */
+    virtual Response executeStreaming(const ResponseCallback& onChunk)
+    {
+        (void)onChunk;
+        return execute();
+    }
 };
 
 #endif // ICOMMAND_HPP
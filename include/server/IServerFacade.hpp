@@ -10,6 +10,9 @@
 #ifndef ISERVERFACADE_HPP
 #define ISERVERFACADE_HPP
 
+#include <functional>
+#include <utility>
+
 #include "models/Request.hpp"
 #include "models/Response.hpp"
 
@@ -33,6 +36,38 @@ public:
      */
     virtual Response handleRequest(const Request& request) = 0;
 
+    /**
+     * @brief Handle a request whose reply may be streamed in several parts.
+     * @param request The decoded client request.
+     * @param onChunk Receives each partial response (Response::more set) on
+     *                the calling thread, before this call returns.
+     * @return The final response (Response::more cleared).
+     *
+     * The default implementation does not stream and calls handleRequest().
+     */
+    virtual Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk)
+    {
+        (void)onChunk;
+        return handleRequest(request);
+    }
+
+    /**
+     * @brief Handle a request and deliver the response through a callback.
+     * @param request    The decoded client request.
+     * @param onComplete Invoked with the response, possibly on another
+     *                   thread: once per chunk for a streamed reply, exactly
+     *                   once otherwise. Only the last call has
+     *                   Response::more cleared.
+     *
+     * The default implementation runs handleRequestStreaming() inline on the
+     * calling thread. Implementations that execute commands on worker threads
+     * override this so transport threads never block on a command.
+     */
+    virtual void handleRequestAsync(Request request, ResponseCallback onComplete)
+    {
+        onComplete(handleRequestStreaming(request, onComplete));
+    }
+
     // TODO: EXTEND — Add new entry points here for additional server
     //               capabilities (e.g., handleBatchRequest(), subscribe(),
     //               getServerStatus()) as the API surface grows.
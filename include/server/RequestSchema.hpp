@@ -0,0 +1,150 @@
+/**
+ * @file RequestSchema.hpp
+ * @brief Compile-time mapping from RequestType to the POD its payload carries.
+ *
+ * @details Commands and services decode Request::payload through
+ * bindRequest<Type>(). It returns a PodArrayView over the payload bytes,
+ * checked against the schema registered here for that RequestType, so
+ * records are read in place and never copied into intermediate structs.
+ * Wire layout and validation rules are described in pod/PodView.hpp.
+ */
+
+#ifndef REQUESTSCHEMA_HPP
+#define REQUESTSCHEMA_HPP
+
+#include "models/Request.hpp"
+#include "pod/PodView.hpp"
+#include "server/RequestTypes.hpp"
+
+#include <cstddef>
+
+/**
+ * @struct RequestSchema
+ * @brief Payload traits of a RequestType.
+ *
+ * Specialisations define @c Record (the POD type of each payload record)
+ * and @c kHasPodPayload.
+ */
+template <RequestType Type>
+struct RequestSchema;
+
+/// Symbols whose market data is requested.
+template <>
+struct RequestSchema<RequestType::GET_MARKET_DATA>
+{
+    using Record = SymbolPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Positions to run the calculation over.
+template <>
+struct RequestSchema<RequestType::CALCULATE>
+{
+    using Record = PositionPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// The operation and its predicates; an optional TradePOD section may
+/// follow (read both with pod::bindSection(), see ManipulationEngine).
+template <>
+struct RequestSchema<RequestType::MANIPULATE>
+{
+    using Record = ManipulationSpecPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// One record: report type and day range, then an optional ReportOptionsPOD section (see ReportCommand::decode()).
+template <>
+struct RequestSchema<RequestType::GENERATE_REPORT>
+{
+    using Record = ReportRequestPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Symbols to start receiving pushed updates for.
+template <>
+struct RequestSchema<RequestType::SUBSCRIBE>
+{
+    using Record = SymbolPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Symbols to stop receiving pushed updates for.
+template <>
+struct RequestSchema<RequestType::UNSUBSCRIBE>
+{
+    using Record = SymbolPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// No payload: the whole snapshot is always returned.
+template <>
+struct RequestSchema<RequestType::GET_STATS>
+{
+    using Record = void;
+    static constexpr bool kHasPodPayload = false;
+};
+
+/// One record per sub-request; their payloads follow the section back to
+/// back (read the records with pod::bindSection(), see BatchCommand).
+template <>
+struct RequestSchema<RequestType::BATCH>
+{
+    using Record = BatchItemPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Exactly one record: the first missing sequence number and how many follow.
+template <>
+struct RequestSchema<RequestType::RECOVER_MARKET_DATA>
+{
+    using Record = MarketDataRecoveryPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Exactly one record: the order to match and, if a limit order, rest.
+template <>
+struct RequestSchema<RequestType::SUBMIT_ORDER>
+{
+    using Record = OrderPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+/// Exactly one record: the resting order to cancel.
+template <>
+struct RequestSchema<RequestType::CANCEL_ORDER>
+{
+    using Record = OrderCancelPOD;
+    static constexpr bool kHasPodPayload = true;
+};
+
+// TODO: EXTEND — Add a RequestSchema specialisation for every new
+//               RequestType alongside its command factory.
+
+/**
+ * @brief Bind @p out to the POD records of @p request.
+ * @tparam Type The RequestType whose schema the payload must match.
+ * @return PodDecodeStatus::OK on success; see toString() for the others.
+ */
+template <RequestType Type>
+PodDecodeStatus bindRequest(const Request&                                          request,
+                            PodArrayView<typename RequestSchema<Type>::Record>&     out)
+{
+    static_assert(RequestSchema<Type>::kHasPodPayload, "RequestType has no POD payload schema");
+    return pod::bindArray(request.payload.data(), request.payload.size(), out);
+}
+
+/**
+ * @brief Build a POD payload (header + records) in a pooled buffer.
+ * @param records First record.
+ * @param count   Number of records.
+ */
+template <typename T>
+PooledBuffer makePodPayload(const T* records, std::size_t count)
+{
+    PooledBuffer payload = PooledBuffer::uninitialized(pod::payloadSize<T>(count));
+    pod::writeArray(payload.data(), records, count);
+    return payload;
+}
+
+#endif // REQUESTSCHEMA_HPP
@@ -10,7 +10,9 @@
 #ifndef REQUESTTYPES_HPP
 #define REQUESTTYPES_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <string_view>
 
 /**
  * @enum RequestType
@@ -22,12 +24,68 @@ enum class RequestType : uint32_t
     CALCULATE        = 1, ///< Run a financial calculation (e.g., P&L, VaR).
     MANIPULATE       = 2, ///< Transform or filter trading data.
     GENERATE_REPORT  = 3, ///< Generate a structured report (e.g., end-of-day).
+    SUBSCRIBE        = 4, ///< Start pushing market data updates for symbols.
+    UNSUBSCRIBE      = 5, ///< Stop pushing market data updates for symbols.
+    GET_STATS        = 6, ///< Snapshot of server counters and latency percentiles.
+    BATCH            = 7, ///< Several sub-requests in one frame, answered in one reply.
+    RECOVER_MARKET_DATA = 8, ///< Resend multicast market data ticks by sequence number.
+    SUBMIT_ORDER     = 9, ///< Enter a market or limit order into its symbol's book.
+    CANCEL_ORDER     = 10, ///< Take a resting order off its book.
 
     // TODO: EXTEND — Add new request types here and register the
     //               corresponding command factory in CommandRegistry.
     //               Example:
-    //                 STREAM_QUOTES = 4,
-    //                 PLACE_ORDER   = 5,
+    //                 AMEND_ORDER   = 11,
 };
 
+/// @brief Number of RequestType values; keep in sync with the enum above.
+constexpr std::size_t kRequestTypeCount = 11;
+
+/**
+ * @brief Dense zero-based index of a RequestType.
+ * @return The enum value, or kRequestTypeCount if it is out of range.
+ */
+constexpr std::size_t requestTypeIndex(RequestType type)
+{
+    const auto index = static_cast<std::size_t>(type);
+    return index < kRequestTypeCount ? index : kRequestTypeCount;
+}
+
+/// @brief Enumerator name of a RequestType, for logs and statistics.
+constexpr const char* requestTypeName(RequestType type)
+{
+    switch (type)
+    {
+    case RequestType::GET_MARKET_DATA: return "GET_MARKET_DATA";
+    case RequestType::CALCULATE:       return "CALCULATE";
+    case RequestType::MANIPULATE:      return "MANIPULATE";
+    case RequestType::GENERATE_REPORT: return "GENERATE_REPORT";
+    case RequestType::SUBSCRIBE:       return "SUBSCRIBE";
+    case RequestType::UNSUBSCRIBE:     return "UNSUBSCRIBE";
+    case RequestType::GET_STATS:       return "GET_STATS";
+    case RequestType::BATCH:           return "BATCH";
+    case RequestType::RECOVER_MARKET_DATA: return "RECOVER_MARKET_DATA";
+    case RequestType::SUBMIT_ORDER:    return "SUBMIT_ORDER";
+    case RequestType::CANCEL_ORDER:    return "CANCEL_ORDER";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @brief RequestType whose requestTypeName() is @p name.
+ * @return false, leaving @p out unchanged, if no type has that name.
+ */
+constexpr bool parseRequestType(std::string_view name, RequestType& out)
+{
+    for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+    {
+        if (name == requestTypeName(static_cast<RequestType>(t)))
+        {
+            out = static_cast<RequestType>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif // REQUESTTYPES_HPP
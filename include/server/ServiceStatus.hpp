@@ -0,0 +1,53 @@
+/**
+ * @file ServiceStatus.hpp
+ * @brief Load state of one service during a staged startup.
+ *
+ * @details The server accepts connections before every service has loaded
+ * its state. A ServiceReadiness keeps one ServiceStatus per service and
+ * refuses the requests of those not READY; GET_STATS reports them.
+ */
+
+#ifndef SERVICESTATUS_HPP
+#define SERVICESTATUS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum ServiceState
+ * @brief Where a service is in its startup.
+ */
+enum class ServiceState : uint8_t
+{
+    WARMING_UP = 0, ///< Still loading; its requests are refused.
+    READY      = 1, ///< Loaded; its requests are served.
+    FAILED     = 2, ///< Loading failed; its requests are refused until restart.
+};
+
+/// @brief Name of a ServiceState, for logs.
+constexpr const char* serviceStateName(ServiceState state)
+{
+    switch (state)
+    {
+    case ServiceState::WARMING_UP: return "warming up";
+    case ServiceState::READY:      return "ready";
+    case ServiceState::FAILED:     return "failed";
+    }
+    return "unknown";
+}
+
+/**
+ * @struct ServiceStatus
+ * @brief Snapshot of one service's readiness.
+ */
+struct ServiceStatus
+{
+    std::string  name;
+    ServiceState state{ServiceState::WARMING_UP};
+
+    /// From the start of the startup to READY or FAILED; so far while WARMING_UP.
+    std::chrono::milliseconds elapsed{0};
+};
+
+#endif // SERVICESTATUS_HPP
@@ -0,0 +1,35 @@
+/**
+ * @file IMarketDataRecoveryService.hpp
+ * @brief Pure virtual interface for resending sequenced market data ticks.
+ *
+ * @details A multicast consumer that sees a gap in the sequence numbers asks
+ * for the missing ticks over its regular session. Ticks that are no longer
+ * retained cannot be recovered; the consumer falls back to a
+ * GET_MARKET_DATA snapshot instead.
+ */
+
+#ifndef IMARKETDATARECOVERYSERVICE_HPP
+#define IMARKETDATARECOVERYSERVICE_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+
+/**
+ * @class IMarketDataRecoveryService
+ * @brief Abstract interface for RECOVER_MARKET_DATA requests.
+ */
+class IMarketDataRecoveryService
+{
+public:
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~IMarketDataRecoveryService() = default;
+
+    /**
+     * @brief Resend a range of ticks by sequence number.
+     * @param request RECOVER_MARKET_DATA request carrying one MarketDataRecoveryPOD.
+     * @return A Response with the retained part of the range as SequencedMarketDataPOD records.
+     */
+    virtual Response recover(const Request& request) = 0;
+};
+
+#endif // IMARKETDATARECOVERYSERVICE_HPP
@@ -0,0 +1,48 @@
+/**
+ * @file IOrderService.hpp
+ * @brief Pure virtual interface for order entry.
+ *
+ * @details Orders are matched on the thread that owns their symbol's book,
+ * not on the caller's, so both operations complete through a callback
+ * instead of returning the Response.
+ *
+ *   SUBMIT_ORDER request  : PayloadHeader + 1 × OrderPOD
+ *   CANCEL_ORDER request  : PayloadHeader + 1 × OrderCancelPOD
+ *   Response data (both)  : PayloadHeader + 1 × OrderAckPOD
+ *                           + PayloadHeader + N × TradePOD (this order's fills)
+ */
+
+#ifndef IORDERSERVICE_HPP
+#define IORDERSERVICE_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+
+/**
+ * @class IOrderService
+ * @brief Abstract interface for SUBMIT_ORDER and CANCEL_ORDER requests.
+ */
+class IOrderService
+{
+public:
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~IOrderService() = default;
+
+    /**
+     * @brief Match an order against its book and rest what a limit order has left.
+     * @param request    SUBMIT_ORDER request carrying one OrderPOD.
+     * @param onComplete Called exactly once with the acknowledgement and fills,
+     *                   usually on another thread.
+     */
+    virtual void submit(const Request& request, ResponseCallback onComplete) = 0;
+
+    /**
+     * @brief Take a resting order off its book.
+     * @param request    CANCEL_ORDER request carrying one OrderCancelPOD.
+     * @param onComplete Called exactly once with the acknowledgement, usually
+     *                   on another thread.
+     */
+    virtual void cancel(const Request& request, ResponseCallback onComplete) = 0;
+};
+
+#endif // IORDERSERVICE_HPP
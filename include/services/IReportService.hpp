@@ -31,6 +31,21 @@ public:
      */
     virtual Response generateReport(const ReportRequest& request) = 0;
 
+    /**
+     * @brief Generate a report, streaming it as several responses.
+     * @param request Specifies the report type and the date range.
+     * @param onChunk Receives each partial response (Response::more set) in
+     *                order; if empty, the whole report is returned instead.
+     * @return The final response.
+     *
+     * The default implementation does not stream and calls generateReport().
+     */
+    virtual Response generateReportStreaming(const ReportRequest& request, const ResponseCallback& onChunk)
+    {
+        (void)onChunk;
+        return generateReport(request);
+    }
+
     // TODO: EXTEND — Add new report entry points here (e.g., scheduleReport(),
     //               exportReport()) as reporting requirements grow.
 };
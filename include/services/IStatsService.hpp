@@ -0,0 +1,30 @@
+/**
+ * @file IStatsService.hpp
+ * @brief Pure virtual interface for the server's own metrics.
+ */
+
+#ifndef ISTATSSERVICE_HPP
+#define ISTATSSERVICE_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+
+/**
+ * @class IStatsService
+ * @brief Abstract interface for GET_STATS requests.
+ */
+class IStatsService
+{
+public:
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~IStatsService() = default;
+
+    /**
+     * @brief Take a snapshot of the server's counters.
+     * @param request GET_STATS request; its payload is ignored.
+     * @return A Response whose data holds the snapshot sections.
+     */
+    virtual Response getStats(const Request& request) = 0;
+};
+
+#endif // ISTATSSERVICE_HPP
@@ -0,0 +1,44 @@
+/**
+ * @file ISubscriptionService.hpp
+ * @brief Pure virtual interface for session-scoped market data subscriptions.
+ *
+ * @details Unlike IMarketDataService::subscribe(), which only tracks interest
+ * in a symbol, a subscription service binds symbols to the session that sent
+ * the request (Request::sessionId) and pushes later updates to that session.
+ */
+
+#ifndef ISUBSCRIPTIONSERVICE_HPP
+#define ISUBSCRIPTIONSERVICE_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+
+/**
+ * @class ISubscriptionService
+ * @brief Abstract interface for SUBSCRIBE / UNSUBSCRIBE requests.
+ */
+class ISubscriptionService
+{
+public:
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~ISubscriptionService() = default;
+
+    /**
+     * @brief Start pushing updates for the requested symbols to the session.
+     * @param request SUBSCRIBE request carrying SymbolPOD records.
+     * @return A Response with the current snapshot of each symbol.
+     */
+    virtual Response subscribe(const Request& request) = 0;
+
+    /**
+     * @brief Stop pushing updates for the requested symbols to the session.
+     * @param request UNSUBSCRIBE request carrying SymbolPOD records.
+     * @return A Response indicating success or failure.
+     */
+    virtual Response unsubscribe(const Request& request) = 0;
+
+    // TODO: EXTEND — Add subscription options here (e.g., throttling
+    //               intervals, field masks) as client requirements grow.
+};
+
+#endif // ISUBSCRIPTIONSERVICE_HPP
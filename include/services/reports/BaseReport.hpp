@@ -5,15 +5,37 @@
  * @details Defines a fixed three-step pipeline: fetchData → computeReport →
  * format. Concrete report classes (e.g., EndOfDayReport) override each pure
  * virtual step without changing the pipeline sequence.
+ *
+ * generateStreaming() runs the same steps once per trading day of the
+ * requested range. Days are processed in windows of the pool's concurrency:
+ * every day in a window runs fetchData → computeReport → format on its own
+ * thread, then the window's formatted rows go to the sink in date order
+ * before the next window starts. Peak memory is one window of days and the
+ * first rows are delivered after one window, however long the range is.
+ * Overrides must therefore be safe to call concurrently for different days.
+ * A caller that already holds some days (ReportService's cache) passes a
+ * filter, and only the days it asks for are run.
+ *
+ * A report that supportsColumnar() can also write each day as a binary
+ * block (see ReportBlockHeaderPOD) with writeColumns(), straight from its
+ * figures; generateColumnarStreaming() windows the days the same way.
+ * format() remains the text rendering of the same rows.
+ *
+ * A day the report's source cannot fully answer (isFinal() is false) is
+ * still generated, but ReportService does not cache it.
  */
 
 #ifndef BASEREPORT_HPP
 #define BASEREPORT_HPP
 
+#include <functional>
 #include <string>
 #include <vector>
 
+#include "concurrency/ForkJoinPool.hpp"
+#include "memory/PooledBuffer.hpp"
 #include "models/ReportRequest.hpp"
+#include "models/TradingDate.hpp"
 
 /// @brief A generic report payload — a collection of formatted string rows.
 using Report = std::vector<std::string>;
@@ -21,6 +43,15 @@ using Report = std::vector<std::string>;
 /// @brief Intermediate raw data retrieved from the database layer.
 using ReportData = std::vector<std::string>;
 
+/// @brief Receives the formatted rows of one day, in date order.
+using ReportChunkSink = std::function<void(TradingDate day, Report&& rows)>;
+
+/// @brief Receives the columnar block of one day (empty if it has no rows), in date order.
+using ReportBlockSink = std::function<void(TradingDate day, PooledBuffer&& block)>;
+
+/// @brief Selects the days of a range that have to be generated.
+using ReportDayFilter = std::function<bool(TradingDate day)>;
+
 /**
  * @class BaseReport
  * @brief Abstract base implementing the Template Method pattern for report generation.
@@ -51,6 +82,41 @@ public:
      */
     Report generate(const ReportRequest& request);
 
+    /**
+     * @brief Run the pipeline per trading day and stream each day's rows.
+     * @param request Report type and inclusive date range.
+     * @param pool    Threads shared by the days of a window.
+     * @param sink    Called on the caller's thread with each day's rows, in
+     *                date order.
+     * @param needed  Optional; days it rejects are skipped (not passed to
+     *                the sink). Called on the caller's thread.
+     * @throws std::invalid_argument if the range is reversed or a day is
+     *         outside TradingDate::inIsoRange(); any exception thrown by a
+     *         pipeline step is rethrown (days before it have already been
+     *         delivered).
+     */
+    void generateStreaming(const ReportRequest& request, ForkJoinPool& pool, const ReportChunkSink& sink,
+                           const ReportDayFilter& needed = {});
+
+    /// @brief True if writeColumns() is implemented.
+    virtual bool supportsColumnar() const { return false; }
+
+    /**
+     * @brief generateStreaming() for the columnar format: one writeColumns() block per day.
+     * @throws std::logic_error if the report does not supportsColumnar();
+     *         otherwise as generateStreaming().
+     */
+    void generateColumnarStreaming(const ReportRequest& request, ForkJoinPool& pool, const ReportBlockSink& sink,
+                                   const ReportDayFilter& needed = {});
+
+    /**
+     * @brief False if the rows of @p day may still change, e.g. because the
+     *        data source holds no complete record of it.
+     * @details ReportService caches only final days before the current one.
+     *          Called on the caller's thread; the default is true.
+     */
+    virtual bool isFinal(TradingDate day) const;
+
 protected:
     /**
      * @brief Fetch raw data required for the report.
@@ -72,6 +138,16 @@ protected:
      * @return The final formatted report.
      */
     virtual Report format(const ReportData& data) = 0;
+
+    /**
+     * @brief Write the rows of @p day as one ReportBlockHeaderPOD block.
+     * @details Override together with supportsColumnar(); called
+     *          concurrently for different days. The default throws
+     *          std::logic_error.
+     * @return The block (see ReportBlockWriter), or an empty buffer if the
+     *         day has no rows.
+     */
+    virtual PooledBuffer writeColumns(TradingDate day);
 };
 
 #endif // BASEREPORT_HPP
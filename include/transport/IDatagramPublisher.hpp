@@ -0,0 +1,34 @@
+/**
+ * @file IDatagramPublisher.hpp
+ * @brief Interface for sending self-contained datagrams, e.g. to a multicast group.
+ *
+ * @details Unlike ITransport and ISessionPublisher there are no sessions and
+ * no flow control: a datagram is sent once, or lost. Services that publish
+ * this way number their messages so receivers can detect and repair gaps.
+ */
+
+#ifndef IDATAGRAMPUBLISHER_HPP
+#define IDATAGRAMPUBLISHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class IDatagramPublisher
+ * @brief Fire-and-forget delivery of one datagram at a time.
+ */
+class IDatagramPublisher
+{
+public:
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~IDatagramPublisher() = default;
+
+    /**
+     * @brief Send @p size bytes at @p data as one datagram.
+     * @details Thread-safe. Never blocks on the receivers.
+     * @return False if the datagram could not be handed to the network.
+     */
+    virtual bool sendDatagram(const uint8_t* data, std::size_t size) = 0;
+};
+
+#endif // IDATAGRAMPUBLISHER_HPP
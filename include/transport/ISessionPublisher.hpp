@@ -0,0 +1,56 @@
+/**
+ * @file ISessionPublisher.hpp
+ * @brief Interface for pushing server-initiated messages to one session.
+ *
+ * @details ITransport::send() broadcasts to every client. A publisher
+ * addresses a single session by the id stamped on its requests
+ * (Request::sessionId), and reports when that session's outbound queue has
+ * drained so callers can pace pushes to a slow client.
+ */
+
+#ifndef ISESSIONPUBLISHER_HPP
+#define ISESSIONPUBLISHER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "models/Response.hpp"
+
+/**
+ * @class ISessionPublisher
+ * @brief Targeted, flow-controlled delivery of pushed responses.
+ */
+class ISessionPublisher
+{
+public:
+    /// Called once the published messages have been written out.
+    using DrainedHandler = std::function<void()>;
+
+    /// Called once when a session disconnects.
+    using SessionClosedHandler = std::function<void(uint64_t sessionId)>;
+
+    /// @brief Virtual destructor to ensure proper cleanup of derived classes.
+    virtual ~ISessionPublisher() = default;
+
+    /**
+     * @brief Queue @p messages for one session as a single batched write.
+     * @param sessionId Target session.
+     * @param messages  Responses to encode and send, in order.
+     * @param onDrained Invoked (on a transport thread) when the session's
+     *                  outbound queue is empty again. Never invoked if the
+     *                  session closes first.
+     * @return False if no such session is connected.
+     */
+    virtual bool publish(uint64_t              sessionId,
+                         std::vector<Response> messages,
+                         DrainedHandler        onDrained) = 0;
+
+    /**
+     * @brief Install the handler notified when any session disconnects.
+     * @details Install it before the transport is started.
+     */
+    virtual void setSessionClosedHandler(SessionClosedHandler handler) = 0;
+};
+
+#endif // ISESSIONPUBLISHER_HPP
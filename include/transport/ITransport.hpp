@@ -10,11 +10,14 @@
 #ifndef ITRANSPORT_HPP
 #define ITRANSPORT_HPP
 
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+
+#include "memory/PooledBuffer.hpp"
 
 /// @brief Alias for a raw binary buffer used in transport operations.
-using RawBuffer = std::vector<uint8_t>;
+/// @details Pooled and reference-counted: copies share the underlying block.
+using RawBuffer = PooledBuffer;
 
 /**
  * @class ITransport
@@ -35,6 +38,20 @@ public:
      */
     virtual void send(const RawBuffer& buffer) = 0;
 
+    /**
+     * @brief Send several buffers as one batch.
+     * @param buffers Pointer to the first of @p count buffers.
+     * @param count   Number of buffers.
+     *
+     * Transports that can merge the batch into fewer writes override this.
+     * The default sends each buffer in turn.
+     */
+    virtual void sendBatch(const RawBuffer* buffers, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            send(buffers[i]);
+    }
+
     /**
      * @brief Receive a raw binary buffer from the transport.
      * @return The received data.
@@ -0,0 +1,73 @@
+/**
+ * @file TransportStats.hpp
+ * @brief Outbound queue, handshake and per-session metrics of a transport.
+ *
+ * @details Sessions bump the TransportCounters they were given from their
+ * io_context threads; the transport sums them with the live queue depths
+ * into a TransportStats snapshot on request.
+ */
+
+#ifndef TRANSPORTSTATS_HPP
+#define TRANSPORTSTATS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct TransportCounters
+ * @brief Monotonic backpressure counters, updated with relaxed atomics.
+ */
+struct TransportCounters
+{
+    /// Market data frames dropped because a session's queue was full.
+    std::atomic<uint64_t> droppedFrames{0};
+
+    /// Sessions closed because their replies overflowed the queue limits.
+    std::atomic<uint64_t> slowConsumerDisconnects{0};
+
+    /// Completed TLS handshakes, and how many of them resumed a session.
+    std::atomic<uint64_t> handshakes{0};
+    std::atomic<uint64_t> resumedHandshakes{0};
+
+    /// TLS handshakes that failed.
+    std::atomic<uint64_t> failedHandshakes{0};
+
+    /// Sessions whose outbound records are encrypted by the kernel.
+    std::atomic<uint64_t> kernelTlsSessions{0};
+};
+
+/**
+ * @struct TransportStats
+ * @brief Point-in-time snapshot of the transport's outbound queues.
+ */
+struct TransportStats
+{
+    std::size_t sessions{0};              ///< Live sessions.
+    std::size_t queuedFrames{0};          ///< Frames queued across all sessions.
+    std::size_t queuedBytes{0};           ///< Bytes queued across all sessions.
+    std::size_t maxSessionQueuedBytes{0}; ///< Deepest single session queue.
+    uint64_t    droppedFrames{0};         ///< See TransportCounters.
+    uint64_t    slowConsumerDisconnects{0};
+    uint64_t    handshakes{0};            ///< See TransportCounters.
+    uint64_t    resumedHandshakes{0};
+    uint64_t    failedHandshakes{0};
+    uint64_t    kernelTlsSessions{0};
+};
+
+/**
+ * @struct SessionStats
+ * @brief Point-in-time throughput and queue depth of one session.
+ */
+struct SessionStats
+{
+    uint64_t    id{0};
+    uint64_t    requests{0};     ///< Frames received.
+    uint64_t    bytesIn{0};      ///< Bytes received, length prefixes included.
+    uint64_t    bytesOut{0};     ///< Bytes written, length prefixes included.
+    std::size_t queuedFrames{0}; ///< Frames waiting behind the in-flight write.
+    std::size_t queuedBytes{0};
+};
+
+#endif // TRANSPORTSTATS_HPP
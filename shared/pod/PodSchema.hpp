@@ -0,0 +1,239 @@
+/**
+ * @file PodSchema.hpp
+ * @brief Compile-time schema identifiers and versions for the shared PODs.
+ *
+ * @details Every POD that can travel in a request or response payload has a
+ * PodSchema specialisation. It gives the type a stable schema id and a
+ * layout version. Both are written into the PayloadHeader so a peer built
+ * against a different layout is rejected instead of misread. The sizeof
+ * checks below pin each layout: if one fails, bump that type's version
+ * together with the new expected size.
+ *
+ * @note Shared between client and server; keep it free of server headers.
+ */
+
+#ifndef PODSCHEMA_HPP
+#define PODSCHEMA_HPP
+
+#include "pod/TradingPOD.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @enum PodSchemaId
+ * @brief Stable identifier of a POD layout on the wire.
+ */
+enum class PodSchemaId : uint16_t
+{
+    NONE         = 0, ///< Payload carries no POD records.
+    MARKET_DATA  = 1, ///< MarketDataPOD
+    ORDER        = 2, ///< OrderPOD
+    POSITION     = 3, ///< PositionPOD
+    TRADE        = 4, ///< TradePOD
+    SYMBOL       = 5, ///< SymbolPOD
+    RISK_SUMMARY = 6, ///< RiskSummaryPOD
+    MANIPULATION_SPEC = 7, ///< ManipulationSpecPOD
+    REPORT_REQUEST    = 8, ///< ReportRequestPOD
+    SERVER_STATS      = 9, ///< ServerStatsPOD
+    SESSION_STATS     = 10, ///< SessionStatsPOD
+    LATENCY_STATS     = 11, ///< LatencyStatsPOD
+    BUFFER_POOL_STATS = 12, ///< BufferPoolStatsPOD
+    BATCH_ITEM        = 13, ///< BatchItemPOD
+    BATCH_RESULT      = 14, ///< BatchResultPOD
+    MARKET_DATA_RECOVERY  = 15, ///< MarketDataRecoveryPOD
+    SEQUENCED_MARKET_DATA = 16, ///< SequencedMarketDataPOD
+    ORDER_CANCEL          = 17, ///< OrderCancelPOD
+    ORDER_ACK             = 18, ///< OrderAckPOD
+    BAR                   = 19, ///< BarPOD
+    SERVICE_READINESS     = 20, ///< ServiceReadinessPOD
+    REPORT_OPTIONS        = 21, ///< ReportOptionsPOD
+
+    // TODO: EXTEND — Add an id here for every new POD in TradingPOD.hpp.
+};
+
+/**
+ * @struct PodSchema
+ * @brief Schema traits of a POD type; only the specialisations are defined.
+ */
+template <typename T>
+struct PodSchema;
+
+template <>
+struct PodSchema<MarketDataPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::MARKET_DATA;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<OrderPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::ORDER;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<PositionPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::POSITION;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<TradePOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::TRADE;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<SymbolPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::SYMBOL;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<RiskSummaryPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::RISK_SUMMARY;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<ManipulationSpecPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::MANIPULATION_SPEC;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<ReportRequestPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::REPORT_REQUEST;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<ServerStatsPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::SERVER_STATS;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<SessionStatsPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::SESSION_STATS;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<LatencyStatsPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::LATENCY_STATS;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<BufferPoolStatsPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::BUFFER_POOL_STATS;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<BatchItemPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::BATCH_ITEM;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<BatchResultPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::BATCH_RESULT;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<MarketDataRecoveryPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::MARKET_DATA_RECOVERY;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<SequencedMarketDataPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::SEQUENCED_MARKET_DATA;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<OrderCancelPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::ORDER_CANCEL;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<OrderAckPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::ORDER_ACK;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<BarPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::BAR;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<ServiceReadinessPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::SERVICE_READINESS;
+    static constexpr uint16_t    version = 1;
+};
+
+template <>
+struct PodSchema<ReportOptionsPOD>
+{
+    static constexpr PodSchemaId id      = PodSchemaId::REPORT_OPTIONS;
+    static constexpr uint16_t    version = 1;
+};
+
+// Layout pins — see the file comment before editing.
+static_assert(sizeof(MarketDataPOD) == 72, "MarketDataPOD layout changed; bump its schema version");
+static_assert(sizeof(OrderPOD)      == 66, "OrderPOD layout changed; bump its schema version");
+static_assert(sizeof(PositionPOD)   == 64, "PositionPOD layout changed; bump its schema version");
+static_assert(sizeof(TradePOD)      == 73, "TradePOD layout changed; bump its schema version");
+static_assert(offsetof(MarketDataPOD, bid) == 32 && offsetof(OrderPOD, side) == 56
+                  && offsetof(PositionPOD, unrealisedPnl) == 48 && offsetof(TradePOD, side) == 64,
+              "a generated POD layout changed; check its field list in TradingPOD.hpp");
+static_assert(sizeof(SymbolPOD)     == 32, "SymbolPOD layout changed; bump its schema version");
+static_assert(sizeof(RiskSummaryPOD) == 52, "RiskSummaryPOD layout changed; bump its schema version");
+static_assert(sizeof(ManipulationSpecPOD) == 74, "ManipulationSpecPOD layout changed; bump its schema version");
+static_assert(sizeof(ReportRequestPOD) == 40, "ReportRequestPOD layout changed; bump its schema version");
+static_assert(sizeof(ReportOptionsPOD) == 8, "ReportOptionsPOD layout changed; bump its schema version");
+static_assert(sizeof(ServerStatsPOD) == 136, "ServerStatsPOD layout changed; bump its schema version");
+static_assert(sizeof(SessionStatsPOD) == 40, "SessionStatsPOD layout changed; bump its schema version");
+static_assert(sizeof(LatencyStatsPOD) == 68, "LatencyStatsPOD layout changed; bump its schema version");
+static_assert(sizeof(BufferPoolStatsPOD) == 24, "BufferPoolStatsPOD layout changed; bump its schema version");
+static_assert(sizeof(ServiceReadinessPOD) == 32, "ServiceReadinessPOD layout changed; bump its schema version");
+static_assert(sizeof(BatchItemPOD) == 8, "BatchItemPOD layout changed; bump its schema version");
+static_assert(sizeof(BatchResultPOD) == 64, "BatchResultPOD layout changed; bump its schema version");
+static_assert(sizeof(MarketDataPacketHeaderPOD) == 24, "MarketDataPacketHeaderPOD layout changed; bump its version");
+static_assert(sizeof(MarketDataRecoveryPOD) == 16, "MarketDataRecoveryPOD layout changed; bump its schema version");
+static_assert(sizeof(SequencedMarketDataPOD) == 80, "SequencedMarketDataPOD layout changed; bump its schema version");
+static_assert(sizeof(OrderCancelPOD) == 40, "OrderCancelPOD layout changed; bump its schema version");
+static_assert(sizeof(OrderAckPOD) == 32, "OrderAckPOD layout changed; bump its schema version");
+static_assert(sizeof(BarPOD) == 100, "BarPOD layout changed; bump its schema version");
+static_assert(sizeof(ReportBlockHeaderPOD) == 24, "ReportBlockHeaderPOD layout changed; bump its version");
+static_assert(sizeof(ReportColumnPOD) == 32, "ReportColumnPOD layout changed; bump its version");
+
+#endif // PODSCHEMA_HPP
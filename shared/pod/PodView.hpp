@@ -0,0 +1,248 @@
+/**
+ * @file PodView.hpp
+ * @brief Bounds-checked, zero-copy views of packed PODs inside a byte buffer.
+ *
+ * @details A POD payload is a PayloadHeader followed by @c count records of a
+ * single POD type:
+ *
+ *   [ PayloadHeader (8 bytes) ][ count × sizeof(T) bytes ]
+ *
+ * Binding a view checks the header against PodSchema<T> and the buffer
+ * size, then points straight into the buffer. Nothing is copied or
+ * allocated, and each field is read in place. All PODs are packed (alignment
+ * 1), so a record may start at any offset. Fields use native byte order,
+ * like the PODs themselves; both supported platforms are little-endian.
+ *
+ * @note Shared between client and server; keep it free of server headers.
+ */
+
+#ifndef PODVIEW_HPP
+#define PODVIEW_HPP
+
+#include "pod/PodSchema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#pragma pack(push, 1)
+
+/**
+ * @struct PayloadHeader
+ * @brief Leading descriptor of a POD payload.
+ */
+struct PayloadHeader
+{
+    uint16_t schemaId; ///< PodSchemaId of the records that follow.
+    uint16_t version;  ///< PodSchema<T>::version the sender was built with.
+    uint32_t count;    ///< Number of records after the header.
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PayloadHeader) == 8, "PayloadHeader must stay 8 bytes");
+
+/**
+ * @enum PodDecodeStatus
+ * @brief Outcome of binding a view to a payload.
+ */
+enum class PodDecodeStatus
+{
+    OK,               ///< View bound successfully.
+    TRUNCATED,        ///< Buffer shorter than the header or the declared records.
+    SCHEMA_MISMATCH,  ///< Header names a different POD type.
+    VERSION_MISMATCH, ///< Header carries a different layout version.
+    TRAILING_BYTES,   ///< Buffer longer than header + declared records.
+    OUT_OF_RANGE,     ///< A record field holds a value its decoder does not accept.
+};
+
+/// @brief Human-readable description of @p status, for error responses.
+inline const char* toString(PodDecodeStatus status)
+{
+    switch (status)
+    {
+        case PodDecodeStatus::OK:               return "ok";
+        case PodDecodeStatus::TRUNCATED:        return "payload truncated";
+        case PodDecodeStatus::SCHEMA_MISMATCH:  return "payload schema mismatch";
+        case PodDecodeStatus::VERSION_MISMATCH: return "payload schema version mismatch";
+        case PodDecodeStatus::TRAILING_BYTES:   return "unexpected bytes after payload records";
+        case PodDecodeStatus::OUT_OF_RANGE:     return "payload field out of range";
+    }
+    return "unknown payload error";
+}
+
+/**
+ * @class PodArrayView
+ * @brief Read-only contiguous range of @p T records inside a byte buffer.
+ * @tparam T A packed POD with a PodSchema specialisation.
+ *
+ * The view does not own the bytes: keep the underlying buffer (for example
+ * Request::payload) alive while the view is in use.
+ */
+template <typename T>
+class PodArrayView
+{
+    static_assert(std::is_trivially_copyable<T>::value, "PodArrayView requires a trivially copyable POD");
+    static_assert(alignof(T) == 1, "PodArrayView requires a #pragma pack(1) POD");
+
+public:
+    using value_type     = T;
+    using const_iterator = const T*;
+
+    PodArrayView() = default;
+
+    /// @brief View @p count records starting at @p records.
+    PodArrayView(const T* records, std::size_t count) : m_records(records), m_count(count) {}
+
+    std::size_t    size() const { return m_count; }
+    bool           empty() const { return m_count == 0; }
+    const T*       data() const { return m_records; }
+    const_iterator begin() const { return m_records; }
+    const_iterator end() const { return m_records + m_count; }
+
+    /// @brief Unchecked access; @p i must be less than size().
+    const T& operator[](std::size_t i) const { return m_records[i]; }
+
+    /// @brief Checked access.
+    /// @throws std::out_of_range if @p i is not less than size().
+    const T& at(std::size_t i) const
+    {
+        if (i >= m_count)
+            throw std::out_of_range("[PodArrayView] index out of range");
+        return m_records[i];
+    }
+
+private:
+    const T*    m_records{nullptr};
+    std::size_t m_count{0};
+};
+
+/**
+ * @class PodView
+ * @brief Read-only view of exactly one @p T record inside a byte buffer.
+ */
+template <typename T>
+class PodView
+{
+public:
+    PodView() = default;
+    explicit PodView(const T* record) : m_record(record) {}
+
+    bool     valid() const { return m_record != nullptr; }
+    const T& operator*() const { return *m_record; }
+    const T* operator->() const { return m_record; }
+
+private:
+    const T* m_record{nullptr};
+};
+
+namespace pod
+{
+    /// @brief Bytes needed for a payload of @p count records of @p T.
+    template <typename T>
+    constexpr std::size_t payloadSize(std::size_t count)
+    {
+        return sizeof(PayloadHeader) + count * sizeof(T);
+    }
+
+    /**
+     * @brief Bind @p out to the first section of a multi-section payload.
+     * @param data     Start of the section.
+     * @param size     Bytes available from @p data.
+     * @param out      Receives the records on success; untouched otherwise.
+     * @param consumed Receives the section size (header + records) on success.
+     *
+     * Several sections (each a PayloadHeader plus records) may follow each
+     * other; bytes after this one are left for the next call.
+     */
+    template <typename T>
+    PodDecodeStatus bindSection(const uint8_t* data, std::size_t size, PodArrayView<T>& out,
+                                std::size_t& consumed)
+    {
+        if (size < sizeof(PayloadHeader))
+            return PodDecodeStatus::TRUNCATED;
+
+        PayloadHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.schemaId != static_cast<uint16_t>(PodSchema<T>::id))
+            return PodDecodeStatus::SCHEMA_MISMATCH;
+        if (header.version != PodSchema<T>::version)
+            return PodDecodeStatus::VERSION_MISMATCH;
+        if ((size - sizeof(PayloadHeader)) / sizeof(T) < header.count)
+            return PodDecodeStatus::TRUNCATED;
+
+        out      = PodArrayView<T>(reinterpret_cast<const T*>(data + sizeof(PayloadHeader)), header.count);
+        consumed = payloadSize<T>(header.count);
+        return PodDecodeStatus::OK;
+    }
+
+    /**
+     * @brief Validate a payload and bind @p out to its records.
+     * @param data Start of the payload.
+     * @param size Payload size in bytes.
+     * @param out  Receives the records on success; untouched otherwise.
+     */
+    template <typename T>
+    PodDecodeStatus bindArray(const uint8_t* data, std::size_t size, PodArrayView<T>& out)
+    {
+        if (size < sizeof(PayloadHeader))
+            return PodDecodeStatus::TRUNCATED;
+
+        PayloadHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.schemaId != static_cast<uint16_t>(PodSchema<T>::id))
+            return PodDecodeStatus::SCHEMA_MISMATCH;
+        if (header.version != PodSchema<T>::version)
+            return PodDecodeStatus::VERSION_MISMATCH;
+
+        const std::size_t body = size - sizeof(PayloadHeader);
+        if (body / sizeof(T) < header.count)
+            return PodDecodeStatus::TRUNCATED;
+        if (body != static_cast<std::size_t>(header.count) * sizeof(T))
+            return PodDecodeStatus::TRAILING_BYTES;
+
+        out = PodArrayView<T>(reinterpret_cast<const T*>(data + sizeof(PayloadHeader)), header.count);
+        return PodDecodeStatus::OK;
+    }
+
+    /**
+     * @brief Validate a single-record payload and bind @p out to it.
+     * @return TRUNCATED or TRAILING_BYTES if the payload holds other than one record.
+     */
+    template <typename T>
+    PodDecodeStatus bindOne(const uint8_t* data, std::size_t size, PodView<T>& out)
+    {
+        PodArrayView<T> records;
+        const PodDecodeStatus status = bindArray(data, size, records);
+        if (status != PodDecodeStatus::OK)
+            return status;
+        if (records.size() != 1)
+            return records.empty() ? PodDecodeStatus::TRUNCATED : PodDecodeStatus::TRAILING_BYTES;
+
+        out = PodView<T>(records.data());
+        return PodDecodeStatus::OK;
+    }
+
+    /**
+     * @brief Write a header and @p count records to @p out.
+     * @param out Destination of at least payloadSize<T>(count) bytes.
+     * @return Bytes written.
+     */
+    template <typename T>
+    std::size_t writeArray(uint8_t* out, const T* records, std::size_t count)
+    {
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<T>::id),
+                                   PodSchema<T>::version,
+                                   static_cast<uint32_t>(count)};
+        std::memcpy(out, &header, sizeof(header));
+        if (count > 0)
+            std::memcpy(out + sizeof(header), records, count * sizeof(T));
+        return payloadSize<T>(count);
+    }
+} // namespace pod
+
+#endif // PODVIEW_HPP
@@ -7,6 +7,10 @@
  * are serialised directly into the RawBuffer transmitted over the transport
  * layer — no additional serialisation library is required for iteration 1.
  *
+ * The market data, order, position and trade layouts are expanded from
+ * field lists (HFT_*_FIELDS). The server builds aligned internal records
+ * from the same lists, so the wire layout and the internal one never drift.
+ *
  * @note Include this header on both client and server sides. Do NOT add
  *       non-POD members (std::string, pointers, virtual methods, etc.).
  */
@@ -18,18 +22,67 @@
 
 #pragma pack(push, 1)
 
+/**
+ * @name Field lists
+ * @brief The single definition of the POD layouts that have an internal twin.
+ *
+ * Each list names the fields in wire order as FIELD(type, name), and the
+ * instrument as SYMBOL(name). The packed structs below expand SYMBOL to
+ * char[32]; the server expands the same lists into naturally aligned
+ * records that hold an interned symbol id instead, together with the
+ * conversions between the two (see Records.hpp). A field added here
+ * therefore reaches both layouts and both conversions.
+ * @{
+ */
+
+#define HFT_MARKET_DATA_FIELDS(FIELD, SYMBOL) \
+    SYMBOL(symbol)                           /* Null-terminated instrument identifier. */ \
+    FIELD(double, bid)                       /* Best bid price. */ \
+    FIELD(double, ask)                       /* Best ask price. */ \
+    FIELD(double, last)                      /* Last traded price. */ \
+    FIELD(uint64_t, volume)                  /* Traded volume in the current session. */ \
+    FIELD(int64_t, timestamp)                /* Unix epoch timestamp in microseconds. */
+
+#define HFT_ORDER_FIELDS(FIELD, SYMBOL) \
+    FIELD(uint64_t, orderId)                 /* Unique order identifier. */ \
+    SYMBOL(symbol)                           /* Instrument identifier. */ \
+    FIELD(double, price)                     /* Limit price (0.0 for market orders). */ \
+    FIELD(uint64_t, quantity)                /* Order quantity (number of units). */ \
+    FIELD(uint8_t, side)                     /* 0 = Buy, 1 = Sell. */ \
+    FIELD(uint8_t, type)                     /* 0 = Market, 1 = Limit, 2 = Stop. */ \
+    FIELD(int64_t, timestamp)                /* Order creation time (Unix epoch, microseconds). */
+
+#define HFT_POSITION_FIELDS(FIELD, SYMBOL) \
+    SYMBOL(symbol)                           /* Instrument identifier. */ \
+    FIELD(int64_t, quantity)                 /* Net position (positive = long, negative = short). */ \
+    FIELD(double, avgPrice)                  /* Volume-weighted average entry price. */ \
+    FIELD(double, unrealisedPnl)             /* Mark-to-market unrealised P&L. */ \
+    FIELD(int64_t, timestamp)                /* Position snapshot time (Unix epoch, microseconds). */
+
+#define HFT_TRADE_FIELDS(FIELD, SYMBOL) \
+    FIELD(uint64_t, tradeId)                 /* Unique trade identifier. */ \
+    FIELD(uint64_t, orderId)                 /* Parent order identifier. */ \
+    SYMBOL(symbol)                           /* Instrument identifier. */ \
+    FIELD(double, price)                     /* Execution price. */ \
+    FIELD(uint64_t, quantity)                /* Executed quantity. */ \
+    FIELD(uint8_t, side)                     /* 0 = Buy fill, 1 = Sell fill. */ \
+    FIELD(int64_t, timestamp)                /* Execution time (Unix epoch, microseconds). */
+
+/// Wire expansion of a FIELD entry.
+#define HFT_POD_FIELD(type, name) type name;
+
+/// Wire expansion of a SYMBOL entry.
+#define HFT_POD_SYMBOL(name) char name[32];
+
+/** @} */
+
 /**
  * @struct MarketDataPOD
  * @brief Point-in-time snapshot of a tradeable instrument.
  */
 struct MarketDataPOD
 {
-    char     symbol[32];  ///< Null-terminated instrument identifier.
-    double   bid;         ///< Best bid price.
-    double   ask;         ///< Best ask price.
-    double   last;        ///< Last traded price.
-    uint64_t volume;      ///< Traded volume in the current session.
-    int64_t  timestamp;   ///< Unix epoch timestamp in microseconds.
+    HFT_MARKET_DATA_FIELDS(HFT_POD_FIELD, HFT_POD_SYMBOL)
 };
 
 /**
@@ -38,13 +91,7 @@ struct MarketDataPOD
  */
 struct OrderPOD
 {
-    uint64_t orderId;     ///< Unique order identifier.
-    char     symbol[32];  ///< Instrument identifier.
-    double   price;       ///< Limit price (0.0 for market orders).
-    uint64_t quantity;    ///< Order quantity (number of units).
-    uint8_t  side;        ///< 0 = Buy, 1 = Sell.
-    uint8_t  type;        ///< 0 = Market, 1 = Limit, 2 = Stop.
-    int64_t  timestamp;   ///< Order creation time (Unix epoch, microseconds).
+    HFT_ORDER_FIELDS(HFT_POD_FIELD, HFT_POD_SYMBOL)
 };
 
 /**
@@ -53,11 +100,7 @@ struct OrderPOD
  */
 struct PositionPOD
 {
-    char     symbol[32];  ///< Instrument identifier.
-    int64_t  quantity;    ///< Net position (positive = long, negative = short).
-    double   avgPrice;    ///< Volume-weighted average entry price.
-    double   unrealisedPnl; ///< Mark-to-market unrealised P&L.
-    int64_t  timestamp;   ///< Position snapshot time (Unix epoch, microseconds).
+    HFT_POSITION_FIELDS(HFT_POD_FIELD, HFT_POD_SYMBOL)
 };
 
 /**
@@ -66,15 +109,367 @@ struct PositionPOD
  */
 struct TradePOD
 {
-    uint64_t tradeId;     ///< Unique trade identifier.
-    uint64_t orderId;     ///< Parent order identifier.
-    char     symbol[32];  ///< Instrument identifier.
-    double   price;       ///< Execution price.
-    uint64_t quantity;    ///< Executed quantity.
-    uint8_t  side;        ///< 0 = Buy fill, 1 = Sell fill.
-    int64_t  timestamp;   ///< Execution time (Unix epoch, microseconds).
+    HFT_TRADE_FIELDS(HFT_POD_FIELD, HFT_POD_SYMBOL)
+};
+
+/**
+ * @struct SymbolPOD
+ * @brief Instrument key used by requests that only name a symbol.
+ */
+struct SymbolPOD
+{
+    char     symbol[32];  ///< Null-terminated instrument identifier.
+};
+
+/**
+ * @struct RiskSummaryPOD
+ * @brief Portfolio-level result of a CALCULATE request.
+ */
+struct RiskSummaryPOD
+{
+    double   totalUnrealisedPnl; ///< Sum of the per-position unrealised P&L.
+    double   grossExposure;      ///< Sum of |quantity × mark| over all positions.
+    double   historicalVar;      ///< Scenario loss not exceeded at `confidence` (>= 0).
+    double   parametricVar;      ///< Normal approximation from the scenario P&L moments (>= 0).
+    double   confidence;         ///< VaR confidence level, e.g. 0.99.
+    uint32_t positionCount;      ///< Positions in the request.
+    uint32_t unmarkedCount;      ///< Positions without a market price (marked at avgPrice).
+    uint32_t scenarioCount;      ///< Scenarios behind the VaR figures (0 = none loaded).
+};
+
+/**
+ * @enum ManipulationOp
+ * @brief Operation selected by ManipulationSpecPOD::op.
+ */
+enum class ManipulationOp : uint8_t
+{
+    FILTER      = 0, ///< Trades matching the predicates, in timestamp order.
+    DAILY_PIVOT = 1, ///< One summary row per (UTC day, symbol, side) of the matching trades.
+    OHLCV_BARS  = 2, ///< The OHLCV bars of the matching symbols and time range (BarPOD).
+};
+
+/**
+ * @struct ManipulationSpecPOD
+ * @brief Predicates and operation of a MANIPULATE request.
+ *
+ * Every predicate is optional; its "unset" value is given per field.
+ */
+struct ManipulationSpecPOD
+{
+    uint8_t  op;            ///< A ManipulationOp.
+    uint8_t  sideMask;      ///< Bit 0 = buys, bit 1 = sells; 0 = both.
+    char     symbol[32];    ///< Only this instrument; empty = all.
+    int64_t  fromTimestamp; ///< Inclusive lower bound (Unix epoch, microseconds); 0 = unbounded.
+    int64_t  toTimestamp;   ///< Exclusive upper bound; 0 = unbounded.
+    double   minPrice;      ///< Inclusive; 0 = unbounded.
+    double   maxPrice;      ///< Inclusive; 0 = unbounded.
+    uint64_t minQuantity;   ///< Inclusive; 0 = unbounded.
+};
+
+/**
+ * @struct ReportRequestPOD
+ * @brief Parameters of a GENERATE_REPORT request.
+ *
+ * Dates are day numbers since 1970-01-01 (see TradingDate), so the range is
+ * read without parsing text.
+ */
+struct ReportRequestPOD
+{
+    char    reportType[32]; ///< Registered report name, NUL-padded (e.g. "EndOfDay").
+    int32_t dateFrom;       ///< First day of the range, inclusive.
+    int32_t dateTo;         ///< Last day of the range, inclusive.
+};
+
+/**
+ * @enum ReportFormat
+ * @brief ReportOptionsPOD::format: layout of a GENERATE_REPORT reply's data.
+ */
+enum class ReportFormat : uint8_t
+{
+    TEXT     = 0, ///< UTF-8 rows, each terminated by '\n' (the default).
+    COLUMNAR = 1, ///< One ReportBlockHeaderPOD block per day that has rows.
+};
+
+/**
+ * @struct ReportOptionsPOD
+ * @brief Optional second section of a GENERATE_REPORT request.
+ *
+ * A request without it is answered in ReportFormat::TEXT.
+ */
+struct ReportOptionsPOD
+{
+    uint8_t format;      ///< A ReportFormat.
+    uint8_t reserved[7];
+};
+
+/**
+ * @struct ServerStatsPOD
+ * @brief Server-wide counters of a GET_STATS reply (exactly one record).
+ *
+ * Counters are totals since the server started; the client derives rates
+ * from two polls.
+ */
+struct ServerStatsPOD
+{
+    int64_t  timestamp;               ///< When the snapshot was taken (Unix epoch, microseconds).
+    uint32_t sessions;                ///< Live client sessions.
+    uint32_t reserved;
+    uint64_t queuedFrames;            ///< Outbound frames queued across all sessions.
+    uint64_t queuedBytes;             ///< Outbound bytes queued across all sessions.
+    uint64_t maxSessionQueuedBytes;   ///< Deepest single session queue.
+    uint64_t droppedFrames;           ///< Market data frames dropped by full session queues.
+    uint64_t slowConsumerDisconnects; ///< Sessions closed because their replies overflowed.
+    uint64_t handshakes;              ///< Completed TLS handshakes.
+    uint64_t resumedHandshakes;       ///< ...of which resumed a session.
+    uint64_t failedHandshakes;        ///< Failed TLS handshakes.
+    uint64_t kernelTlsSessions;       ///< Sessions whose records the kernel encrypts.
+    uint64_t reportCacheHits;         ///< Closed report days served from the cache.
+    uint64_t reportCacheMisses;       ///< Closed report days formatted again.
+    uint64_t reportCacheBytes;        ///< Report cache bytes held in memory.
+    uint64_t residentBookHits;        ///< CALCULATE requests served by a resident book.
+    uint64_t residentBookMisses;      ///< CALCULATE requests that loaded a new book.
+    uint64_t heapAllocations;         ///< Frame buffers ever taken from the heap.
+};
+
+/**
+ * @struct SessionStatsPOD
+ * @brief Throughput and outbound queue of one session in a GET_STATS reply.
+ */
+struct SessionStatsPOD
+{
+    uint64_t sessionId;
+    uint64_t requests;     ///< Frames received.
+    uint64_t bytesIn;      ///< Bytes received, length prefixes included.
+    uint64_t bytesOut;     ///< Bytes written, length prefixes included.
+    uint32_t queuedFrames; ///< Outbound frames waiting.
+    uint32_t queuedBytes;  ///< Outbound bytes waiting.
+};
+
+/**
+ * @struct LatencyStatsPOD
+ * @brief Latency distribution of one stage of one request type, in nanoseconds.
+ *
+ * Stages: 0 decode, 1 queue, 2 service, 3 send, 4 total (frame received →
+ * reply written).
+ */
+struct LatencyStatsPOD
+{
+    uint32_t requestType; ///< A RequestType.
+    uint8_t  stage;       ///< See the stage list above.
+    uint8_t  reserved[3];
+    uint32_t queued;      ///< Requests of this type waiting for a worker (same for every stage).
+    uint64_t count;       ///< Intervals recorded since the server started.
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+    uint64_t mean;
+};
+
+/**
+ * @struct BufferPoolStatsPOD
+ * @brief Occupancy of one frame buffer size class in a GET_STATS reply.
+ */
+struct BufferPoolStatsPOD
+{
+    uint64_t blockSize;  ///< Usable bytes per block of the class.
+    uint64_t blocks;     ///< Blocks of the class that exist (in use or cached).
+    uint64_t idleShared; ///< ...of which sit in the shared free list.
 };
 
+/**
+ * @struct ServiceReadinessPOD
+ * @brief Startup state of one service in a GET_STATS reply.
+ */
+struct ServiceReadinessPOD
+{
+    char     name[24];   ///< Service name, NUL-padded (e.g. "market data").
+    uint8_t  state;      ///< 0 warming up, 1 ready, 2 failed to load.
+    uint8_t  reserved[3];
+    uint32_t loadMillis; ///< Server start to ready or failed; so far while warming up.
+};
+
+/**
+ * @struct BatchItemPOD
+ * @brief One sub-request of a BATCH request.
+ *
+ * The sub-request payloads follow the BatchItemPOD section in item order,
+ * each exactly payloadBytes long and laid out as its own request type
+ * expects (usually a PayloadHeader and its records).
+ */
+struct BatchItemPOD
+{
+    uint32_t requestType;  ///< A RequestType other than BATCH.
+    uint32_t payloadBytes; ///< Bytes of this sub-request's payload.
+};
+
+/**
+ * @struct BatchResultPOD
+ * @brief Outcome of one sub-request of a BATCH reply, in item order.
+ *
+ * The reply data of every sub-request follows the BatchResultPOD section in
+ * the same order, each exactly dataBytes long.
+ */
+struct BatchResultPOD
+{
+    uint32_t requestType; ///< The sub-request's RequestType.
+    uint8_t  success;     ///< 1 if the sub-request succeeded.
+    uint8_t  reserved[3];
+    uint32_t dataBytes;   ///< Bytes of this sub-request's reply data.
+    char     message[52]; ///< Response::message, NUL-padded, truncated to fit.
+};
+
+/**
+ * @struct MarketDataPacketHeaderPOD
+ * @brief First bytes of every multicast market data datagram.
+ *
+ * @c count MarketDataPOD records follow, carrying the sequence numbers
+ * sequence .. sequence + count - 1. Sequence numbers count ticks, start at
+ * 1 and restart with every @c epoch, so a consumer that sees a new epoch
+ * resets instead of recovering.
+ */
+struct MarketDataPacketHeaderPOD
+{
+    uint32_t magic;    ///< kMarketDataPacketMagic ("HFTM").
+    uint16_t version;  ///< kMarketDataPacketVersion.
+    uint16_t count;    ///< MarketDataPOD records in this datagram.
+    uint64_t sequence; ///< Sequence number of the first record.
+    int64_t  epoch;    ///< Publisher start time (Unix epoch, microseconds).
+};
+
+/// @brief MarketDataPacketHeaderPOD::magic.
+constexpr uint32_t kMarketDataPacketMagic = 0x4846544d;
+
+/// @brief MarketDataPacketHeaderPOD::version.
+constexpr uint16_t kMarketDataPacketVersion = 1;
+
+/**
+ * @struct MarketDataRecoveryPOD
+ * @brief RECOVER_MARKET_DATA request: the multicast ticks to send again.
+ */
+struct MarketDataRecoveryPOD
+{
+    uint64_t fromSequence; ///< First missing sequence number.
+    uint32_t count;        ///< Ticks wanted from there on.
+    uint32_t reserved;
+};
+
+/**
+ * @struct SequencedMarketDataPOD
+ * @brief A multicast tick with its sequence number, as recovery returns it.
+ */
+struct SequencedMarketDataPOD
+{
+    uint64_t      sequence;
+    MarketDataPOD data;
+};
+
+/**
+ * @struct OrderCancelPOD
+ * @brief CANCEL_ORDER request: the resting order to take off its book.
+ */
+struct OrderCancelPOD
+{
+    uint64_t orderId;    ///< OrderPOD::orderId of the resting order.
+    char     symbol[32]; ///< Its instrument, which selects the book.
+};
+
+/**
+ * @enum OrderStatus
+ * @brief OrderAckPOD::status: what became of an order.
+ */
+enum class OrderStatus : uint8_t
+{
+    RESTING   = 0, ///< Filled in part or not at all; the rest is on the book.
+    FILLED    = 1, ///< Filled completely.
+    CANCELLED = 2, ///< The rest is off the book: cancelled, or no more liquidity for it.
+};
+
+/**
+ * @struct OrderAckPOD
+ * @brief First section of a SUBMIT_ORDER or CANCEL_ORDER reply.
+ */
+struct OrderAckPOD
+{
+    uint64_t orderId;           ///< The order acknowledged.
+    uint64_t filledQuantity;    ///< Units filled by this request.
+    uint64_t remainingQuantity; ///< Units unfilled: on the book if RESTING, taken off it if CANCELLED.
+    uint32_t fillCount;         ///< TradePODs in the reply's second section.
+    uint8_t  status;            ///< An OrderStatus.
+    uint8_t  reserved[3];
+};
+
+/**
+ * @struct BarPOD
+ * @brief One OHLCV bar of an OHLCV_BARS reply.
+ */
+struct BarPOD
+{
+    char     symbol[32];     ///< Instrument identifier.
+    int64_t  start;          ///< First microsecond of the bar (Unix epoch).
+    int64_t  intervalMicros; ///< Width of the bar in microseconds.
+    double   open;           ///< Price of the first trade in the bar.
+    double   high;
+    double   low;
+    double   close;          ///< Price of the last trade in the bar.
+    double   vwap;           ///< Volume-weighted average price.
+    uint64_t volume;         ///< Quantity traded in the bar.
+    uint32_t fills;          ///< Trades in the bar.
+};
+
+/**
+ * @enum ReportColumnType
+ * @brief ReportColumnPOD::type: how a column's values are stored.
+ */
+enum class ReportColumnType : uint8_t
+{
+    UINT32  = 0, ///< rowCount little-endian uint32_t.
+    UINT64  = 1, ///< rowCount little-endian uint64_t.
+    FLOAT64 = 2, ///< rowCount IEEE-754 doubles.
+    UTF8    = 3, ///< rowCount + 1 uint32_t offsets, then the text they index.
+};
+
+/**
+ * @struct ReportBlockHeaderPOD
+ * @brief First bytes of every block of a ReportFormat::COLUMNAR report.
+ *
+ * A block holds one day's rows. @c columnCount ReportColumnPODs follow the
+ * header, then the column data, each column starting at a multiple of 8
+ * bytes from the start of the block. Row i of a UTF8 column is the bytes
+ * [offsets[i], offsets[i + 1]) after its offset table. The next block, if
+ * any, starts @c blockBytes (a multiple of 8) after this one.
+ */
+struct ReportBlockHeaderPOD
+{
+    uint32_t magic;       ///< kReportBlockMagic ("HFTR").
+    uint16_t version;     ///< kReportBlockVersion.
+    uint16_t columnCount; ///< ReportColumnPODs after the header.
+    int32_t  day;         ///< Day of the rows (days since 1970-01-01).
+    uint32_t rowCount;    ///< Values in every column.
+    uint32_t blockBytes;  ///< Header, descriptors, columns and padding.
+    uint32_t reserved;
+};
+
+/**
+ * @struct ReportColumnPOD
+ * @brief Name, type and position of one column of a report block.
+ */
+struct ReportColumnPOD
+{
+    char     name[20];    ///< Column name, NUL-padded (e.g. "vwap").
+    uint8_t  type;        ///< A ReportColumnType.
+    uint8_t  reserved[3];
+    uint32_t offset;      ///< Of the column data, from the start of the block.
+    uint32_t bytes;       ///< Of the column data, without padding.
+};
+
+/// @brief ReportBlockHeaderPOD::magic.
+constexpr uint32_t kReportBlockMagic = 0x48465452;
+
+/// @brief ReportBlockHeaderPOD::version.
+constexpr uint16_t kReportBlockVersion = 1;
+
 // TODO: EXTEND — Add new shared POD types here following the same
 //               #pragma pack(1) convention. Ensure the struct contains
 //               only fixed-size primitive members so the binary layout
@@ -3,10 +3,22 @@
  * @brief Entry point for the HFT Trading Server.
  *
  * @details Wires up all layers of the 3-tier architecture:
- *   - Stub service implementations (replace with real ones when available)
- *   - CommandRegistry populated with all four command factories
+ *   - In-memory service implementations (market data, calculation,
+ *     manipulation, reports) and the order matching engine
+ *   - CommandRegistry populated with a handler for every RequestType
  *   - TradingServerFacade backed by the registry and services
- *   - BoostAsioSslTransport bound to the configured host/port
+ *   - PipelinedServerFacade running commands on a worker pool with one
+ *     priority lane per RequestType
+ *   - RateLimitedServerFacade in front of it when --rate-limit or
+ *     --type-rate-limit is set, refusing sessions over their budget
+ *   - WarmupServerFacade outermost, refusing the requests of services
+ *     whose state (snapshot, journal tail) is still being loaded on a
+ *     separate thread while the listener is built and started
+ *   - The transport chosen with --transport: BoostAsioSslTransport (TLS,
+ *     the default), TcpTransport (plain TCP), UnixSocketTransport or
+ *     ShmTransport (shared-memory rings), bound to the configured
+ *     host/port or socket path and dispatching every client session's
+ *     requests to the facade
  *
  * Usage:
  *   hft_server_exe [options]
@@ -14,10 +26,13 @@
  * Run with --help to see all available options.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <csignal>
 #include <cstdlib>
+#include <future>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -25,29 +40,56 @@
 
 #include <cxxopts.hpp>
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 // ── Transport ──────────────────────────────────────────────────────────────
 #include "BoostAsioSslTransport.hpp"
+#include "PayloadCompression.hpp"
+#include "PlainStreamTransport.hpp"
+#include "ShmTransport.hpp"
+#include "TransportConfig.hpp"
+#include "UdpMulticastSender.hpp"
 
 // ── Server / Command layer ─────────────────────────────────────────────────
+#include "PipelinedServerFacade.hpp"
+#include "RateLimitedServerFacade.hpp"
+#include "RateLimiter.hpp"
+#include "ServiceReadiness.hpp"
 #include "TradingServerFacade.hpp"
+#include "WarmupServerFacade.hpp"
 #include "server/CommandRegistry.hpp"
 #include "server/RequestTypes.hpp"
 
 #include "commands/CalculationCommand.hpp"
 #include "commands/GetMarketDataCommand.hpp"
 #include "commands/ManipulationCommand.hpp"
+#include "commands/OrderCommand.hpp"
+#include "commands/RecoveryCommand.hpp"
 #include "commands/ReportCommand.hpp"
-
-// ── Stub service implementations (replace with real ones when ready) ──────
-#include "StubServices.hpp"
+#include "commands/StatsCommand.hpp"
+#include "commands/SubscriptionCommand.hpp"
+
+// ── Service implementations (stubs where no real one exists yet) ──────────
+#include "CalculationEngine.hpp"
+#include "EndOfDayReport.hpp"
+#include "RiskKernels.hpp"
+#include "InMemoryMarketDataService.hpp"
+#include "ManipulationEngine.hpp"
+#include "MatchingEngine.hpp"
+#include "MulticastFeed.hpp"
+#include "PodJournal.hpp"
+#include "SubscriptionManager.hpp"
+#include "ReportService.hpp"
+#include "ServiceSnapshot.hpp"
+#include "StatsService.hpp"
 
 // ── Models ─────────────────────────────────────────────────────────────────
-#include "models/ReportRequest.hpp"
 #include "models/Request.hpp"
 #include "models/Response.hpp"
 
+#include "metrics/LatencyRecorder.hpp"
+
 // ==========================================================================
 // Graceful shutdown
 // ==========================================================================
@@ -60,12 +102,94 @@ namespace
     /// Raw pointer so the signal handler (C linkage) can reach the transport.
     ITransport* g_transport = nullptr;
 
+    /// Lines the async logger can hold before it overwrites the oldest.
+    constexpr std::size_t kLogQueueSlots = 8192;
+
     void onShutdownSignal(int signum)
     {
         // Only async-signal-safe operations: atomic store + nothing else.
         g_shutdown.store(true, std::memory_order_relaxed);
         (void)signum;
     }
+
+    /// "lz4,deflate" for a codec set, "none" if it is empty.
+    std::string codecList(uint8_t codecs)
+    {
+        std::string list;
+        for (auto codec : {compression::Codec::LZ4, compression::Codec::ZSTD, compression::Codec::DEFLATE})
+        {
+            if (codecs & compression::codecBit(codec))
+                list += (list.empty() ? "" : ",") + std::string(compression::codecName(codec));
+        }
+        return list.empty() ? "none" : list;
+    }
+
+    /// "p50/p99/p99.9" of @p histogram in microseconds.
+    std::string percentilesUs(const LatencyHistogram& histogram)
+    {
+        return fmt::format("{:.1f}/{:.1f}/{:.1f}", histogram.percentile(50.0) / 1e3,
+                           histogram.percentile(99.0) / 1e3, histogram.percentile(99.9) / 1e3);
+    }
+
+    /// One line per request type that was served: p50/p99/p99.9 of every stage.
+    void logLatencies()
+    {
+        const LatencyRecorder& recorder = LatencyRecorder::instance();
+        for (std::size_t i = 0; i < kRequestTypeCount; ++i)
+        {
+            const auto             type  = static_cast<RequestType>(i);
+            const LatencyHistogram total = recorder.histogram(type, LatencyStage::TOTAL);
+            if (total.count() == 0)
+                continue;
+
+            std::string stages;
+            for (std::size_t stage = 0; stage + 1 < kLatencyStageCount; ++stage)
+            {
+                const auto id = static_cast<LatencyStage>(stage);
+                stages += fmt::format(", {} {}", latencyStageName(id), percentilesUs(recorder.histogram(type, id)));
+            }
+            spdlog::info("Latency     : {} x{} p50/p99/p99.9 us: total {}{}", requestTypeName(type), total.count(),
+                         percentilesUs(total), stages);
+        }
+    }
+
+    /// Calls @p apply(type, value) for each entry of "GENERATE_REPORT=2,MANIPULATE=10".
+    template <typename Apply>
+    void parseTypeValues(const std::string& list, const char* option, Apply apply)
+    {
+        std::stringstream in(list);
+        std::string       entry;
+        while (std::getline(in, entry, ','))
+        {
+            if (entry.empty())
+                continue;
+            const std::size_t equals = entry.find('=');
+            RequestType       type   = RequestType::GET_MARKET_DATA;
+            if (equals == std::string::npos || !parseRequestType(entry.substr(0, equals), type))
+                throw std::invalid_argument(fmt::format("--{}: expected TYPE=value, got '{}'", option, entry));
+            try
+            {
+                apply(type, std::stod(entry.substr(equals + 1)));
+            }
+            catch (const std::logic_error&)
+            {
+                throw std::invalid_argument(fmt::format("--{}: '{}' is not a number", option, entry));
+            }
+        }
+    }
+
+    /// "GENERATE_REPORT 3, MANIPULATE 1" for the types with refused requests, "none" if there are none.
+    std::string rejectedList(const RateLimiter& limiter)
+    {
+        std::string list;
+        for (std::size_t i = 0; i < kRequestTypeCount; ++i)
+        {
+            const auto type = static_cast<RequestType>(i);
+            if (const uint64_t rejected = limiter.rejected(type))
+                list += fmt::format("{}{} {}", list.empty() ? "" : ", ", requestTypeName(type), rejected);
+        }
+        return list.empty() ? "none" : list;
+    }
 } // namespace
 
 // ==========================================================================
@@ -74,15 +198,50 @@ namespace
 
 int main(int argc, char* argv[])
 {
-    // ── Set up a named, coloured console logger ────────────────────────────
-    auto logger = spdlog::stdout_color_mt("hft");
+    // ── Set up a named, coloured, asynchronous console logger ──────────────
+    // A log call formats into a preallocated ring slot and returns; one
+    // background thread writes to stdout. When the ring is full the oldest
+    // line is overwritten, so an io thread never waits on the console.
+    spdlog::init_thread_pool(kLogQueueSlots, 1);
+    auto logger = spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>("hft");
+    logger->flush_on(spdlog::level::warn);
     spdlog::set_default_logger(logger);
+    spdlog::flush_every(std::chrono::seconds(1));
     spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%n] %v");
 
     // ── Parse command-line arguments with cxxopts ──────────────────────────
-    cxxopts::Options options("hft_server_exe", "HFT Trading Server — Boost.Asio SSL/TLS");
+    cxxopts::Options options("hft_server_exe",
+                             "HFT Trading Server — Boost.Asio over TLS, TCP, Unix sockets or shared memory");
 
     options.add_options()
+        ("transport", "Listener: tls, tcp (no encryption), unix (Unix domain socket) or shm (shared memory)",
+            cxxopts::value<std::string>()->default_value("tls"))
+        ("unix-path", "Socket file of --transport unix",
+            cxxopts::value<std::string>()->default_value("/tmp/hft_server.sock"))
+        ("shm-path", "Socket file that --transport shm clients attach their regions over",
+            cxxopts::value<std::string>()->default_value("/tmp/hft_server.shm"))
+        ("shm-wake", "How shm sessions wait for their rings: futex or spin (one busy core per client)",
+            cxxopts::value<std::string>()->default_value("futex"))
+        ("multicast-group", "Also send every market data update to this UDP group (default: no multicast)",
+            cxxopts::value<std::string>())
+        ("multicast-port", "UDP port of --multicast-group",
+            cxxopts::value<uint16_t>()->default_value("30001"))
+        ("multicast-interface", "IPv4 address of the interface multicast leaves by (default: routing table)",
+            cxxopts::value<std::string>())
+        ("multicast-ttl", "Hops multicast datagrams may travel (1 = local network)",
+            cxxopts::value<int>()->default_value("1"))
+        ("multicast-flush-us", "Microseconds a tick waits to share its datagram (0 = one tick per datagram)",
+            cxxopts::value<unsigned>()->default_value("100"))
+        ("multicast-history", "Ticks kept for RECOVER_MARKET_DATA",
+            cxxopts::value<std::size_t>()->default_value("65536"))
+        ("order-shards", "Order book threads; each owns the books of its symbols",
+            cxxopts::value<std::size_t>()->default_value("1"))
+        ("order-capacity", "Resting orders per order book thread",
+            cxxopts::value<std::size_t>()->default_value("65536"))
+        ("tick-size", "Price increment of limit orders",
+            cxxopts::value<double>()->default_value("0.01"))
+        ("order-first-cpu", "Pin order book thread i to CPU first + i (-1 = unpinned)",
+            cxxopts::value<int>()->default_value("-1"))
         ("p,port",  "TCP port to listen on",
             cxxopts::value<uint16_t>()->default_value("8443"))
         ("H,host",  "Bind address",
@@ -93,6 +252,68 @@ int main(int argc, char* argv[])
             cxxopts::value<std::string>()->default_value("certs/server.key"))
         ("l,log-level", "Log level: trace|debug|info|warn|error|critical",
             cxxopts::value<std::string>()->default_value("info"))
+        ("io-threads", "Number of io threads (one io_context per thread)",
+            cxxopts::value<std::size_t>()->default_value("1"))
+        ("pin-cpus", "Pin io thread i to CPU i",
+            cxxopts::value<bool>()->default_value("false"))
+        ("busy-poll", "io threads spin instead of sleeping (one busy core per io thread)",
+            cxxopts::value<bool>()->default_value("false"))
+        ("tcp-nodelay", "Disable Nagle's algorithm on TCP connections",
+            cxxopts::value<bool>()->default_value("true"))
+        ("socket-busy-poll-us", "SO_BUSY_POLL of TCP connections in microseconds (0 = kernel default)",
+            cxxopts::value<unsigned>()->default_value("0"))
+        ("workers", "Number of command worker threads",
+            cxxopts::value<std::size_t>()->default_value("2"))
+        ("coalesce-bytes", "Max bytes of queued frames merged into one write",
+            cxxopts::value<std::size_t>()->default_value("16384"))
+        ("calc-threads", "Extra threads for scenario VaR (0 = calculate on the worker only)",
+            cxxopts::value<std::size_t>()->default_value(std::to_string(ForkJoinPool::defaultWorkers())))
+        ("report-threads", "Extra threads for report day partitions (0 = generate on the worker only)",
+            cxxopts::value<std::size_t>()->default_value(std::to_string(ForkJoinPool::defaultWorkers())))
+        ("report-cache-mb", "Memory for cached closed report days in MiB (0 = no cache)",
+            cxxopts::value<std::size_t>()->default_value("64"))
+        ("report-spill-dir", "Directory for report days evicted from memory (default: drop them)",
+            cxxopts::value<std::string>())
+        ("journal-dir", "Directory of the trade and order journals (default: no journal)",
+            cxxopts::value<std::string>())
+        ("journal-flush-ms", "Group commit window of the journals in milliseconds",
+            cxxopts::value<unsigned>()->default_value("2"))
+        ("snapshot-path", "Snapshot file restored on start and rewritten periodically (default: no snapshots)",
+            cxxopts::value<std::string>())
+        ("snapshot-interval-s", "Seconds between snapshots (0 = only at shutdown)",
+            cxxopts::value<unsigned>()->default_value("60"))
+        ("resident-books", "Books kept resident and re-marked on ticks (0 = recompute every CALCULATE)",
+            cxxopts::value<std::size_t>()->default_value("8"))
+        ("bar-interval-s", "Width of the OHLCV bars kept per symbol in seconds",
+            cxxopts::value<unsigned>()->default_value("60"))
+        ("bars-per-symbol", "OHLCV bars kept per symbol (the default covers a day of minute bars)",
+            cxxopts::value<std::size_t>()->default_value("1440"))
+        ("max-queued-bytes", "Per-session outbound queue limit in bytes (0 = unbounded)",
+            cxxopts::value<std::size_t>()->default_value("4194304"))
+        ("max-queued-frames", "Per-session outbound queue limit in frames (0 = unbounded)",
+            cxxopts::value<std::size_t>()->default_value("8192"))
+        ("max-pipelined", "Requests with an id a session may have in flight (1 = lock-step)",
+            cxxopts::value<std::size_t>()->default_value("64"))
+        ("handshake-threads", "Threads for TLS handshakes (0 = on the io threads)",
+            cxxopts::value<std::size_t>()->default_value("1"))
+        ("tls-session-lifetime-s", "Seconds a TLS session can be resumed (0 = no resumption)",
+            cxxopts::value<unsigned>()->default_value("3600"))
+        ("tls-session-cache", "TLS sessions kept in the server-side cache",
+            cxxopts::value<std::size_t>()->default_value("20480"))
+        ("ktls", "Let the kernel encrypt outbound TLS 1.3 records (Linux kTLS, falls back per connection)",
+            cxxopts::value<bool>()->default_value("false"))
+        ("compression", "Codecs replies may be compressed with: lz4,zstd,deflate, all or none",
+            cxxopts::value<std::string>()->default_value("all"))
+        ("compress-min-bytes", "Compress reply data of at least this many bytes (0 = never)",
+            cxxopts::value<std::size_t>()->default_value("65536"))
+        ("rate-limit", "Cost units per second each session may spend (0 = unlimited)",
+            cxxopts::value<double>()->default_value("0"))
+        ("rate-burst", "Cost units a session may spend at once (0 = one second's worth)",
+            cxxopts::value<double>()->default_value("0"))
+        ("type-rate-limit", "Requests per second per session of single types, e.g. GENERATE_REPORT=2,MANIPULATE=10",
+            cxxopts::value<std::string>())
+        ("request-cost", "Cost units of request types, e.g. CALCULATE=5 (defaults: 1, reports 100)",
+            cxxopts::value<std::string>())
         ("h,help",  "Print this help message and exit");
 
     cxxopts::ParseResult args;
@@ -130,56 +351,443 @@ int main(int argc, char* argv[])
     const std::string host     = args["host"].as<std::string>();
     const std::string certFile = args["cert"].as<std::string>();
     const std::string keyFile  = args["key"].as<std::string>();
+    const std::string listener = args["transport"].as<std::string>();
+    const std::string unixPath = args["unix-path"].as<std::string>();
+    const std::string shmPath  = args["shm-path"].as<std::string>();
+    const std::string shmWake  = args["shm-wake"].as<std::string>();
+    if (listener != "tls" && listener != "tcp" && listener != "unix" && listener != "shm")
+    {
+        spdlog::error("Argument error: unknown transport '{}' (tls, tcp, unix or shm)", listener);
+        return EXIT_FAILURE;
+    }
+    if (shmWake != "futex" && shmWake != "spin")
+    {
+        spdlog::error("Argument error: unknown --shm-wake '{}' (futex or spin)", shmWake);
+        return EXIT_FAILURE;
+    }
+
+    TransportConfig transportConfig;
+    transportConfig.ioThreads = args["io-threads"].as<std::size_t>();
+    transportConfig.pinCpus   = args["pin-cpus"].as<bool>();
+    transportConfig.busyPoll             = args["busy-poll"].as<bool>();
+    transportConfig.tcpNoDelay           = args["tcp-nodelay"].as<bool>();
+    transportConfig.socketBusyPollMicros = args["socket-busy-poll-us"].as<unsigned>();
+    transportConfig.maxCoalescedBytes    = args["coalesce-bytes"].as<std::size_t>();
+    transportConfig.maxQueuedBytes       = args["max-queued-bytes"].as<std::size_t>();
+    transportConfig.maxQueuedFrames      = args["max-queued-frames"].as<std::size_t>();
+    transportConfig.maxPipelinedRequests = args["max-pipelined"].as<std::size_t>();
+    transportConfig.handshakeThreads     = args["handshake-threads"].as<std::size_t>();
+    transportConfig.tlsSessionLifetime   = std::chrono::seconds(args["tls-session-lifetime-s"].as<unsigned>());
+    transportConfig.tlsSessionCacheSize  = args["tls-session-cache"].as<std::size_t>();
+    transportConfig.kernelTls            = args["ktls"].as<bool>();
+    transportConfig.compressMinBytes     = args["compress-min-bytes"].as<std::size_t>();
+    transportConfig.shmBusySpin          = shmWake == "spin";
+    try
+    {
+        transportConfig.compressionCodecs = compression::parseCodecs(args["compression"].as<std::string>());
+    }
+    catch (const std::invalid_argument& ex)
+    {
+        spdlog::error("Argument error: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+
+    CalculationConfig calculationConfig;
+    calculationConfig.threads       = args["calc-threads"].as<std::size_t>();
+    calculationConfig.residentBooks = args["resident-books"].as<std::size_t>();
+    const std::size_t reportThreads = args["report-threads"].as<std::size_t>();
+
+    TradeAggregatesConfig aggregatesConfig;
+    aggregatesConfig.barMicros     = static_cast<int64_t>(args["bar-interval-s"].as<unsigned>()) * 1000 * 1000;
+    aggregatesConfig.barsPerSymbol = args["bars-per-symbol"].as<std::size_t>();
+    if (aggregatesConfig.barMicros == 0 || aggregatesConfig.barsPerSymbol == 0)
+    {
+        spdlog::error("--bar-interval-s and --bars-per-symbol must be at least 1");
+        return EXIT_FAILURE;
+    }
+
+    ReportCacheConfig reportCacheConfig;
+    reportCacheConfig.maxMemoryBytes = args["report-cache-mb"].as<std::size_t>() * 1024 * 1024;
+    if (args.count("report-spill-dir"))
+        reportCacheConfig.spillDirectory = args["report-spill-dir"].as<std::string>();
+
+    PipelineConfig pipelineConfig;
+    pipelineConfig.workerCount = args["workers"].as<std::size_t>();
 
-    spdlog::info("Starting HFT server on {}:{}", host, port);
-    spdlog::info("Certificate : {}", certFile);
-    spdlog::info("Private key : {}", keyFile);
+    // Orders skip the worker lanes: the transport thread hands them to the
+    // owner of their book, which never blocks.
+    pipelineConfig.directTypes = {RequestType::SUBMIT_ORDER, RequestType::CANCEL_ORDER};
+
+    RateLimitConfig rateLimitConfig;
+    rateLimitConfig.session = TokenBucketLimit{args["rate-limit"].as<double>(), args["rate-burst"].as<double>()};
+    std::shared_ptr<RateLimiter> limiter;
+    try
+    {
+        if (args.count("type-rate-limit"))
+            parseTypeValues(args["type-rate-limit"].as<std::string>(), "type-rate-limit",
+                            [&rateLimitConfig](RequestType type, double rate) {
+                                rateLimitConfig.perType.at(requestTypeIndex(type)) = TokenBucketLimit{rate, 0.0};
+                            });
+        if (args.count("request-cost"))
+            parseTypeValues(args["request-cost"].as<std::string>(), "request-cost",
+                            [&rateLimitConfig](RequestType type, double cost) {
+                                rateLimitConfig.cost.at(requestTypeIndex(type)) = cost;
+                            });
+        limiter = std::make_shared<RateLimiter>(rateLimitConfig);
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::error("Argument error: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+
+    MatchingEngineConfig matchingConfig;
+    matchingConfig.shards         = args["order-shards"].as<std::size_t>();
+    matchingConfig.ordersPerShard = args["order-capacity"].as<std::size_t>();
+    matchingConfig.tickSize       = args["tick-size"].as<double>();
+    matchingConfig.firstCpu       = args["order-first-cpu"].as<int>();
+
+    if (transportConfig.ioThreads == 0 || pipelineConfig.workerCount == 0)
+    {
+        spdlog::error("--io-threads and --workers must be at least 1");
+        return EXIT_FAILURE;
+    }
+
+    if (listener == "unix")
+        spdlog::info("Starting HFT server on unix:{}", unixPath);
+    else if (listener == "shm")
+        spdlog::info("Starting HFT server on shared memory, attached over unix:{} ({} wake-ups)", shmPath, shmWake);
+    else
+        spdlog::info("Starting HFT server on {}:{}{}", host, port, listener == "tcp" ? " (plain TCP)" : "");
+    spdlog::info("IO threads  : {}{}{}", transportConfig.ioThreads,
+                 transportConfig.pinCpus ? " (pinned)" : "", transportConfig.busyPoll ? " (busy-polling)" : "");
+    spdlog::info("Workers     : {}", pipelineConfig.workerCount);
+    if (limiter->enabled())
+        spdlog::info("Admission   : {} cost unit(s)/s per session (burst {}), per-type limits: {}",
+                     rateLimitConfig.session.rate, args["rate-burst"].as<double>(),
+                     args.count("type-rate-limit") ? args["type-rate-limit"].as<std::string>() : "none");
+    if (listener == "tls")
+    {
+        spdlog::info("Certificate : {}", certFile);
+        spdlog::info("Private key : {}", keyFile);
+        spdlog::info("TLS         : {} handshake thread(s), sessions resumable for {} s{}",
+                     transportConfig.handshakeThreads, transportConfig.tlsSessionLifetime.count(),
+                     transportConfig.kernelTls ? ", kernel TLS offload" : "");
+    }
+    spdlog::info("Compression : {} above {} bytes", codecList(transportConfig.compressionCodecs
+                                                          & compression::availableCodecs()),
+                 transportConfig.compressMinBytes);
+    spdlog::info("Risk        : {} kernels, {} extra VaR thread(s)",
+                 risk::activeIsa(), calculationConfig.threads);
+    spdlog::info("Reports     : {} extra thread(s), {} KiB chunks, {} MiB cache{}{}",
+                 reportThreads, ReportService::kChunkBytes / 1024, reportCacheConfig.maxMemoryBytes >> 20,
+                 reportCacheConfig.spillDirectory.empty() ? "" : ", spill to ",
+                 reportCacheConfig.spillDirectory);
+    spdlog::info("Aggregates  : {} s OHLCV bars, {} per symbol", aggregatesConfig.barMicros / 1000000,
+                 aggregatesConfig.barsPerSymbol);
     spdlog::debug("Log level   : {}", logLevelStr);
 
+    JournalConfig tradeJournalConfig;
+    if (args.count("journal-dir"))
+    {
+        tradeJournalConfig.directory     = args["journal-dir"].as<std::string>();
+        tradeJournalConfig.name          = "trades";
+        tradeJournalConfig.flushInterval = std::chrono::milliseconds(args["journal-flush-ms"].as<unsigned>());
+    }
+    JournalConfig orderJournalConfig = tradeJournalConfig;
+    orderJournalConfig.name          = "orders";
+
+    std::string snapshotPath;
+    if (args.count("snapshot-path"))
+        snapshotPath = args["snapshot-path"].as<std::string>();
+    const std::chrono::seconds snapshotInterval(args["snapshot-interval-s"].as<unsigned>());
+
+    std::string         multicastGroup;
+    MulticastConfig     multicastConfig;
+    MulticastFeedConfig multicastFeedConfig;
+    if (args.count("multicast-group"))
+    {
+        multicastGroup                    = args["multicast-group"].as<std::string>();
+        multicastConfig.group             = multicastGroup;
+        multicastConfig.port              = args["multicast-port"].as<uint16_t>();
+        multicastConfig.ttl               = args["multicast-ttl"].as<int>();
+        multicastFeedConfig.flushInterval = std::chrono::microseconds(args["multicast-flush-us"].as<unsigned>());
+        multicastFeedConfig.historySize   = args["multicast-history"].as<std::size_t>();
+        if (args.count("multicast-interface"))
+            multicastConfig.interfaceAddress = args["multicast-interface"].as<std::string>();
+    }
+
     // ── Build service layer ────────────────────────────────────────────────
-    // TODO: Replace stubs with real implementations once they are available.
-    auto marketDataService   = std::make_shared<StubMarketDataService>();
-    auto calculationService  = std::make_shared<StubCalculationService>();
-    auto manipulationService = std::make_shared<StubManipulationService>();
-    auto reportService       = std::make_shared<StubReportService>();
+    auto marketDataService   = std::make_shared<InMemoryMarketDataService>();
+    auto calculationService  = std::make_shared<CalculationEngine>(marketDataService, calculationConfig);
+    auto manipulationService = std::make_shared<ManipulationEngine>(aggregatesConfig);
+    std::shared_ptr<ReportService> reportService;
+    try
+    {
+        reportService = std::make_shared<ReportService>(reportThreads, reportCacheConfig);
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::critical("Failed to create report service: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+    auto subscriptions       = std::make_shared<SubscriptionManager>(marketDataService);
+    auto statsService        = std::make_shared<StatsService>(calculationService, reportService);
+
+    // The resident trade store holds the trades of the day the server started.
+    const TradingDate today = PodJournal<TradePOD>::dayOf(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    // End-of-day rows come from the aggregates the trade store keeps, not a
+    // scan of its trades. Earlier days are aggregated from their journal
+    // segment. A day is complete only if the journal has it or the server
+    // ran all of it; the others are answered but not cached.
+    const bool journaled = !tradeJournalConfig.directory.empty();
+    reportService->registerReport("EndOfDay", [manipulationService, tradeJournalConfig, journaled, today]() {
+        return std::make_unique<EndOfDayReport>(
+            [manipulationService, tradeJournalConfig, journaled, today](TradingDate day) {
+                if (journaled && day < today)
+                    return journalDaySummaries(tradeJournalConfig, day);
+                return manipulationService->daySummaries(day.days);
+            },
+            [journaled, today](TradingDate day) { return journaled || today < day; });
+    });
+
+    // ── Readiness: the listener starts before the services have loaded ────
+    // Requests for a service still loading are answered "warming up", so
+    // market data is served while books, trades and reports catch up.
+    auto       readiness       = std::make_shared<ServiceReadiness>();
+    const auto marketDataReady = readiness->addService(
+        "market data", {RequestType::GET_MARKET_DATA, RequestType::SUBSCRIBE, RequestType::UNSUBSCRIBE,
+                        RequestType::RECOVER_MARKET_DATA});
+    const auto calculationReady = readiness->addService("resident books", {RequestType::CALCULATE});
+    const auto tradesReady      = readiness->addService(
+        "trades", {RequestType::MANIPULATE, RequestType::SUBMIT_ORDER, RequestType::CANCEL_ORDER});
+    const auto reportsReady = readiness->addService("reports", {RequestType::GENERATE_REPORT});
+
+    // ── Journals: opened here; today's trades are mapped back in later ─────
+    std::unique_ptr<PodJournal<TradePOD>> tradeJournal;
+    std::unique_ptr<PodJournal<OrderPOD>> orderJournal;
+    if (!tradeJournalConfig.directory.empty())
+    {
+        try
+        {
+            tradeJournal = std::make_unique<PodJournal<TradePOD>>(tradeJournalConfig);
+            orderJournal = std::make_unique<PodJournal<OrderPOD>>(orderJournalConfig);
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::critical("Failed to open journal: {}", ex.what());
+            return EXIT_FAILURE;
+        }
+    }
 
-    spdlog::debug("Service layer created (stubs)");
+    std::unique_ptr<ServiceSnapshot> snapshot;
+    if (!snapshotPath.empty())
+        snapshot = std::make_unique<ServiceSnapshot>(marketDataService, calculationService, manipulationService);
+
+    // ── Staged load: the snapshot, then the journal tail, off the main thread
+    // Each service is marked ready as soon as its part is in, while main
+    // builds the registry, the TLS context and the listener. Loading fails
+    // as a whole: its services stay refused and the server shuts down.
+    std::atomic<bool>  loadFailed{false};
+    std::promise<void> marketDataRestored;
+    std::future<void>  marketDataLoaded = marketDataRestored.get_future();
+    const auto         markReady        = [&readiness](ServiceReadiness::ServiceId id) {
+        if (readiness->markReady(id))
+        {
+            const ServiceStatus status = readiness->status(id);
+            spdlog::info("Ready       : {} after {} ms", status.name, status.elapsed.count());
+        }
+    };
+    auto loading = std::async(std::launch::async, [&]() {
+        bool       marketDataSignalled = false;
+        const auto signalMarketData    = [&]() {
+            if (!marketDataSignalled)
+            {
+                marketDataSignalled = true;
+                marketDataRestored.set_value();
+            }
+        };
+        try
+        {
+            // Warm restart: restore the last snapshot before the journal tail.
+            uint64_t tradeReplayFrom = 0;
+            if (snapshot)
+            {
+                const auto start    = std::chrono::steady_clock::now();
+                const auto restored = snapshot->restore(snapshotPath, today, [&](ServiceSnapshot::Part part) {
+                    if (part == ServiceSnapshot::Part::MARKET_DATA)
+                    {
+                        markReady(marketDataReady);
+                        signalMarketData();
+                    }
+                    else if (part == ServiceSnapshot::Part::RESIDENT_BOOKS)
+                        markReady(calculationReady);
+                });
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start);
+                tradeReplayFrom = restored.tradeReplayFrom;
+                if (restored.found)
+                    spdlog::info("Snapshot    : {} restored in {} ms ({} symbol(s), {} book(s), {} trade(s))",
+                                 snapshotPath, elapsed.count(), restored.symbols, restored.books, restored.trades);
+                else
+                    spdlog::info("Snapshot    : {} not found, starting cold", snapshotPath);
+            }
+            markReady(marketDataReady);
+            signalMarketData();
+            markReady(calculationReady);
+
+            // Journals: today's trades are mapped back in, nothing is parsed.
+            // Only the records after the snapshot's watermark are replayed.
+            if (tradeJournal)
+            {
+                const auto        todayTrades = PodJournal<TradePOD>::openDay(tradeJournalConfig, today);
+                const std::size_t replayFrom =
+                    static_cast<std::size_t>(std::min<uint64_t>(tradeReplayFrom, todayTrades.records.size()));
+                if (todayTrades.day)
+                    manipulationService->recordTrades(todayTrades.records.data() + replayFrom,
+                                                      todayTrades.records.size() - replayFrom);
+                spdlog::info("Journal     : {} ({} trade(s) today, {} replayed, {} ms commit window)",
+                             tradeJournalConfig.directory, todayTrades.records.size(),
+                             todayTrades.records.size() - replayFrom, tradeJournalConfig.flushInterval.count());
+            }
+            markReady(tradesReady);
+
+            // End-of-day rows read the trade aggregates, so reports follow the trades.
+            markReady(reportsReady);
+            spdlog::info("Startup     : all services ready after {} ms",
+                         readiness->status(reportsReady).elapsed.count());
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::critical("Failed to load service state: {}", ex.what());
+            for (const auto id : {marketDataReady, calculationReady, tradesReady, reportsReady})
+                readiness->markFailed(id);
+            loadFailed.store(true);
+            g_shutdown.store(true, std::memory_order_relaxed);
+            signalMarketData();
+        }
+    });
+
+    // ── Order entry: accepted orders and fills go to the journals ────────
+    // Each fill is journalled before it is recorded, so the store stays a
+    // prefix of today's journal and the snapshot watermark remains valid.
+    std::shared_ptr<MatchingEngine> matchingEngine;
+    try
+    {
+        PodJournal<TradePOD>* trades = tradeJournal.get();
+        PodJournal<OrderPOD>* orders = orderJournal.get();
+        MatchingEngine::OrderSink onOrders;
+        if (orders)
+            onOrders = [orders](const OrderPOD* accepted, std::size_t count) { orders->append(accepted, count); };
+        matchingEngine = std::make_shared<MatchingEngine>(
+            matchingConfig,
+            [trades, manipulationService](const TradePOD* fills, std::size_t count) {
+                if (trades)
+                    trades->append(fills, count);
+                manipulationService->recordTrades(fills, count);
+            },
+            std::move(onOrders));
+        spdlog::info("Orders      : {} book thread(s){}, {} resting order(s) each, tick size {}",
+                     matchingConfig.shards,
+                     matchingConfig.firstCpu >= 0 ? fmt::format(" pinned from CPU {}", matchingConfig.firstCpu) : "",
+                     matchingConfig.ordersPerShard, matchingConfig.tickSize);
+        if (matchingEngine->pinFailures() > 0)
+            spdlog::warn("Orders      : {} book thread(s) could not be pinned", matchingEngine->pinFailures());
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::critical("Failed to create matching engine: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+
+    // ── Multicast feed ─────────────────────────────────────────────────────
+    // Created after market data is restored, so the restored snapshots are
+    // not multicast; books and trades may still be loading.
+    std::shared_ptr<UdpMulticastSender> multicastSender;
+    std::shared_ptr<MulticastFeed>      multicastFeed;
+    if (!multicastGroup.empty())
+    {
+        marketDataLoaded.wait();
+        if (loadFailed.load())
+            return EXIT_FAILURE;
+        try
+        {
+            multicastSender = std::make_shared<UdpMulticastSender>(multicastConfig);
+            multicastFeed   = std::make_shared<MulticastFeed>(marketDataService, multicastSender, multicastFeedConfig);
+            spdlog::info("Multicast   : udp:{}:{} ({} tick(s) per datagram, {} us flush, {} tick(s) recoverable)",
+                         multicastGroup, multicastConfig.port, multicastFeed->ticksPerDatagram(),
+                         multicastFeedConfig.flushInterval.count(), multicastFeedConfig.historySize);
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::critical("Failed to create multicast feed: {}", ex.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    spdlog::debug("Service layer created (in-memory market data, calculation, manipulation and reports)");
 
     // ── Populate the CommandRegistry ───────────────────────────────────────
     CommandRegistry registry;
 
-    registry.registerCommand(
+    // Handlers run each command's static run() in place: no command object
+    // is allocated and no shared_ptr is copied per request.
+    registry.registerHandler(
         RequestType::GET_MARKET_DATA,
         [marketDataService](const Request& req) {
-            return std::make_unique<GetMarketDataCommand>(marketDataService, req);
+            return GetMarketDataCommand::run(*marketDataService, req);
         });
 
-    registry.registerCommand(
+    registry.registerHandler(
         RequestType::CALCULATE,
         [calculationService](const Request& req) {
-            return std::make_unique<CalculationCommand>(calculationService, req);
+            return CalculationCommand::run(*calculationService, req);
         });
 
-    registry.registerCommand(
+    registry.registerHandler(
         RequestType::MANIPULATE,
         [manipulationService](const Request& req) {
-            return std::make_unique<ManipulationCommand>(manipulationService, req);
+            return ManipulationCommand::run(*manipulationService, req);
         });
 
-    registry.registerCommand(
+    // Reports stream: each chunk is sent as soon as its days are formatted.
+    registry.registerStreamingHandler(
         RequestType::GENERATE_REPORT,
-        [reportService](const Request& req) {
-            // TODO: Replace placeholder deserialisation with wire format parser.
-            ReportRequest reportReq;
-            reportReq.reportType = "EndOfDay";
-            reportReq.dateFrom   = "2026-01-01";
-            reportReq.dateTo     = "2026-12-31";
-            (void)req;
-            return std::make_unique<ReportCommand>(reportService, reportReq);
+        [reportService](const Request& req, const ResponseCallback& onChunk) {
+            return ReportCommand::runStreaming(*reportService, req, onChunk);
+        });
+
+    const auto subscriptionHandler = [subscriptions](const Request& req) {
+        return SubscriptionCommand::run(*subscriptions, req);
+    };
+    registry.registerHandler(RequestType::SUBSCRIBE, subscriptionHandler);
+    registry.registerHandler(RequestType::UNSUBSCRIBE, subscriptionHandler);
+
+    registry.registerHandler(
+        RequestType::GET_STATS,
+        [statsService](const Request& req) {
+            return StatsCommand::run(*statsService, req);
         });
 
-    spdlog::debug("CommandRegistry populated ({} commands)",
-                  static_cast<int>(RequestType::GENERATE_REPORT) + 1);
+    // Gaps in the multicast feed are repaired over the client's regular session.
+    if (multicastFeed)
+        registry.registerHandler(
+            RequestType::RECOVER_MARKET_DATA,
+            [multicastFeed](const Request& req) {
+                return RecoveryCommand::run(*multicastFeed, req);
+            });
+
+    // Orders complete on the owner thread of their symbol's book.
+    const auto orderHandler = [matchingEngine](const Request& req, ResponseCallback onComplete) {
+        OrderCommand::run(*matchingEngine, req, std::move(onComplete));
+    };
+    registry.registerAsyncHandler(RequestType::SUBMIT_ORDER, orderHandler);
+    registry.registerAsyncHandler(RequestType::CANCEL_ORDER, orderHandler);
+
+    spdlog::debug("CommandRegistry populated ({} commands)", kRequestTypeCount);
 
     // ── Build server facade ────────────────────────────────────────────────
     auto facade = std::make_shared<TradingServerFacade>(
@@ -189,8 +797,57 @@ int main(int argc, char* argv[])
         reportService,
         std::move(registry));
 
+    // ── Build the request pipeline ─────────────────────────────────────────
+    // Transport threads only decode and enqueue; commands run on workers.
+    auto pipeline = std::make_shared<PipelinedServerFacade>(facade, pipelineConfig);
+
+    // Sessions over their budget are answered on the transport thread,
+    // before their requests take a lane slot or a worker.
+    std::shared_ptr<IServerFacade> entry = pipeline;
+    if (limiter->enabled())
+        entry = std::make_shared<RateLimitedServerFacade>(pipeline, limiter);
+
+    // Outermost: requests for a service still loading are neither charged
+    // nor queued. Once everything is ready the gate is one atomic load.
+    entry = std::make_shared<WarmupServerFacade>(entry, readiness);
+
     // ── Build transport ────────────────────────────────────────────────────
-    BoostAsioSslTransport transport(host, port, certFile, keyFile);
+    // Each accepted client gets its own session that decodes frames and
+    // hands them to the pipeline; replies come back on the io_context. All
+    // socket listeners share the framing and session code; shm sessions
+    // carry the same frames through rings instead.
+    std::unique_ptr<SessionTransport> listening;
+    try
+    {
+        if (listener == "tcp")
+            listening = std::make_unique<TcpTransport>(
+                boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(host), port), entry, transportConfig);
+        else if (listener == "unix")
+            listening = std::make_unique<UnixSocketTransport>(
+                boost::asio::local::stream_protocol::endpoint(unixPath), entry, transportConfig);
+        else if (listener == "shm")
+            listening = std::make_unique<ShmTransport>(shmPath, entry, transportConfig);
+        else
+            listening = std::make_unique<BoostAsioSslTransport>(host, port, certFile, keyFile, entry,
+                                                                transportConfig);
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::critical("Failed to create transport: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+    SessionTransport& transport = *listening;
+
+    // Subscribed snapshots are pushed straight to their sessions.
+    subscriptions->attach(transport);
+
+    // GET_STATS reads the transport, the lanes and the readiness; all outlive every request.
+    PipelinedServerFacade* lanes = pipeline.get();
+    statsService->attach(StatsSources{
+        [&transport]() { return transport.stats(); },
+        [&transport]() { return transport.sessionStats(); },
+        [lanes](RequestType type) { return lanes->queueDepth(type); },
+        [readiness]() { return readiness->statuses(); }});
 
     // ── Install signal handlers ────────────────────────────────────────────
     // NOTE: Only async-signal-safe operations are used inside the handler.
@@ -199,7 +856,7 @@ int main(int argc, char* argv[])
     std::signal(SIGINT,  onShutdownSignal);
     std::signal(SIGTERM, onShutdownSignal);
 
-    // ── Start transport (non-blocking — runs io_context on a background thread)
+    // ── Start transport (non-blocking — runs the io_context pool threads) ──
     try
     {
         transport.start();
@@ -210,27 +867,95 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-    spdlog::info("Server running. Press Ctrl+C to stop.");
+    spdlog::info("Server running{}. Press Ctrl+C to stop.", readiness->allReady() ? "" : ", services still loading");
 
     // ── Block main thread until a shutdown signal is received ──────────────
     // transport.start() is non-blocking (background thread). Without this loop
     // main() would return immediately and the process would exit, which is why
     // the server appeared to start and stop instantly.
+    // The same thread writes the periodic snapshots.
+    const auto saveSnapshot = [&snapshot, &snapshotPath, today]() {
+        try
+        {
+            const auto        start   = std::chrono::steady_clock::now();
+            const std::size_t bytes   = snapshot->save(snapshotPath, today);
+            const auto        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+            spdlog::debug("Snapshot written to {} ({} bytes, {} ms)", snapshotPath, bytes, elapsed.count());
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::error("Snapshot failed: {}", ex.what());
+        }
+    };
+
+    auto nextSnapshot = std::chrono::steady_clock::now() + snapshotInterval;
     while (!g_shutdown.load(std::memory_order_relaxed))
+    {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // A snapshot taken while loading would miss what is not loaded yet.
+        if (snapshot && snapshotInterval.count() > 0 && readiness->allReady()
+            && std::chrono::steady_clock::now() >= nextSnapshot)
+        {
+            saveSnapshot();
+            nextSnapshot = std::chrono::steady_clock::now() + snapshotInterval;
+        }
+    }
 
     // ── Graceful shutdown ──────────────────────────────────────────────────
-    spdlog::info("Shutdown signal received — stopping server...");
+    if (loadFailed.load())
+        spdlog::info("Loading failed — stopping server...");
+    else
+        spdlog::info("Shutdown signal received — stopping server...");
     try
     {
+        const TransportStats stats = transport.stats();
+        spdlog::info("Outbound    : {} market data frame(s) dropped, {} slow-consumer disconnect(s)",
+                     stats.droppedFrames, stats.slowConsumerDisconnects);
+        if (listener == "tls")
+            spdlog::info("Handshakes  : {} complete ({} resumed, {} kernel TLS), {} failed", stats.handshakes,
+                         stats.resumedHandshakes, stats.kernelTlsSessions, stats.failedHandshakes);
+        if (multicastFeed)
+        {
+            multicastFeed->stop();
+            const MulticastFeedStats  feed   = multicastFeed->stats();
+            const DatagramSenderStats sender = multicastSender->stats();
+            spdlog::info("Multicast   : {} tick(s) in {} datagram(s), {} send error(s), {} recovery request(s) "
+                         "resent {} tick(s), {} aged out",
+                         feed.ticks, sender.datagrams, sender.errors, feed.recoveries, feed.recoveredTicks,
+                         feed.agedOutTicks);
+        }
+        logLatencies();
+        if (limiter->enabled())
+            spdlog::info("Admission   : refused {}", rejectedList(*limiter));
+
         transport.stop();
+        pipeline->stop();
+
+        // A signal during startup waits for the load to finish; it cannot be interrupted.
+        loading.wait();
+
+        // Publishes the last fills to the journals before the snapshot counts them.
+        matchingEngine->stop();
+        const MatchingEngineStats orders = matchingEngine->stats();
+        spdlog::info("Orders      : {} matched, {} cancelled, {} rejected, {} execution(s), {} resting{}",
+                     orders.orders, orders.cancels, orders.rejected, orders.executions, orders.resting,
+                     orders.publishErrors ? fmt::format(", {} journal error(s)", orders.publishErrors) : "");
+
+        // Nothing changes the services any more: the final snapshot is exact.
+        // After a failed load the previous snapshot is kept as it is.
+        if (snapshot && readiness->allReady())
+            saveSnapshot();
     }
     catch (const std::exception& ex)
     {
         spdlog::error("Error during shutdown: {}", ex.what());
     }
 
-    spdlog::info("Server stopped cleanly.");
-    return EXIT_SUCCESS;
+    if (const std::size_t dropped = spdlog::thread_pool()->overrun_counter())
+        spdlog::warn("Log         : {} line(s) dropped by the full log queue", dropped);
+    spdlog::info("Server stopped{}.", loadFailed.load() ? "" : " cleanly");
+    spdlog::shutdown();
+    return loadFailed.load() ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
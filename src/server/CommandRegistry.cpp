@@ -1,15 +1,33 @@
 /**
  * @file CommandRegistry.cpp
- * @brief Implementation of CommandRegistry — maps RequestType to CommandFactory.
+ * @brief Implementation of CommandRegistry — flat RequestType-indexed dispatch table.
  */
 
 #include "server/CommandRegistry.hpp"
 
+#include <future>
+#include <memory>
 #include <stdexcept>
+#include <utility>
+
+namespace
+{
+    std::size_t checkedIndex(RequestType type)
+    {
+        const std::size_t index = requestTypeIndex(type);
+        if (index >= kRequestTypeCount)
+            throw std::out_of_range("No command registered for the given RequestType");
+        return index;
+    }
+} // namespace
 
 void CommandRegistry::registerCommand(RequestType type, CommandFactory factory)
 {
-    m_factories[type] = std::move(factory);
+    Slot& slot   = m_slots[checkedIndex(type)];
+    slot.factory   = std::move(factory);
+    slot.handler   = nullptr;
+    slot.streaming = nullptr;
+    slot.async     = nullptr;
 
     // TODO: REGISTER — Register your new command factory here.
     //       This method is called from the application bootstrap code (main.cpp
@@ -22,12 +40,93 @@ void CommandRegistry::registerCommand(RequestType type, CommandFactory factory)
     //             });
 }
 
+void CommandRegistry::registerHandler(RequestType type, RequestHandler handler)
+{
+    Slot& slot   = m_slots[checkedIndex(type)];
+    slot.handler   = std::move(handler);
+    slot.factory   = nullptr;
+    slot.streaming = nullptr;
+    slot.async     = nullptr;
+}
+
+void CommandRegistry::registerStreamingHandler(RequestType type, StreamingHandler handler)
+{
+    Slot& slot     = m_slots[checkedIndex(type)];
+    slot.streaming = std::move(handler);
+    slot.factory   = nullptr;
+    slot.handler   = nullptr;
+    slot.async     = nullptr;
+}
+
+void CommandRegistry::registerAsyncHandler(RequestType type, AsyncHandler handler)
+{
+    Slot& slot     = m_slots[checkedIndex(type)];
+    slot.async     = std::move(handler);
+    slot.factory   = nullptr;
+    slot.handler   = nullptr;
+    slot.streaming = nullptr;
+}
+
+const CommandRegistry::Slot& CommandRegistry::slotFor(RequestType type) const
+{
+    const Slot& slot = m_slots[checkedIndex(type)];
+    if (!slot.factory && !slot.handler && !slot.streaming && !slot.async)
+        throw std::out_of_range("No command registered for the given RequestType");
+    return slot;
+}
+
 std::unique_ptr<ICommand> CommandRegistry::create(const Request& request) const
 {
-    auto it = m_factories.find(request.type);
-    if (it == m_factories.end())
+    const Slot& slot = slotFor(request.type);
+    if (!slot.factory)
+        throw std::out_of_range("RequestType is registered as a handler, not a command factory");
+    return slot.factory(request);
+}
+
+Response CommandRegistry::execute(const Request& request) const
+{
+    return execute(request, ResponseCallback{});
+}
+
+Response CommandRegistry::execute(const Request& request, const ResponseCallback& onChunk) const
+{
+    const Slot& slot = slotFor(request.type);
+    if (slot.handler)
+        return slot.handler(request);
+    if (slot.streaming)
+        return slot.streaming(request, onChunk);
+    if (slot.async)
     {
-        throw std::out_of_range("No command registered for the given RequestType");
+        // Synchronous callers wait for the handler's own thread.
+        // The promise is shared: set_value() may still be returning when get() does.
+        auto done  = std::make_shared<std::promise<Response>>();
+        auto reply = done->get_future();
+        slot.async(request, [done](Response response) { done->set_value(std::move(response)); });
+        return reply.get();
     }
-    return it->second(request);
+    return slot.factory(request)->executeStreaming(onChunk);
+}
+
+void CommandRegistry::executeAsync(const Request& request, ResponseCallback onComplete) const
+{
+    const Slot& slot = slotFor(request.type);
+    if (slot.async)
+    {
+        slot.async(request, std::move(onComplete));
+        return;
+    }
+    onComplete(execute(request, onComplete));
+}
+
+bool CommandRegistry::isAsync(RequestType type) const
+{
+    const std::size_t index = requestTypeIndex(type);
+    return index < kRequestTypeCount && m_slots[index].async;
+}
+
+bool CommandRegistry::isRegistered(RequestType type) const
+{
+    const std::size_t index = requestTypeIndex(type);
+    return index < kRequestTypeCount && (m_slots[index].factory || m_slots[index].handler || m_slots[index].streaming
+                                        || m_slots[index].async);
 }
@@ -0,0 +1,198 @@
+/**
+ * @file PipelinedServerFacade.cpp
+ * @brief Implementation of PipelinedServerFacade.
+ */
+
+#include "PipelinedServerFacade.hpp"
+
+#include "metrics/LatencyRecorder.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    /// Busy-poll iterations before an idle worker parks on the condition variable.
+    constexpr int kSpinIterations = 256;
+} // namespace
+
+PipelinedServerFacade::PipelinedServerFacade(std::shared_ptr<IServerFacade> inner,
+                                             PipelineConfig                 config)
+    : m_inner(std::move(inner))
+{
+    if (!m_inner)
+        throw std::invalid_argument("[PipelinedServerFacade] inner facade must not be null");
+    if (config.workerCount == 0)
+        throw std::invalid_argument("[PipelinedServerFacade] workerCount must be at least 1");
+
+    for (auto& lane : m_lanes)
+        lane = std::make_unique<BoundedMpmcQueue<Job>>(config.laneCapacity);
+    for (RequestType type : config.directTypes)
+        m_direct[requestTypeIndex(type)] = true;
+
+    // With several workers, worker 0 is reserved for the GET_MARKET_DATA lane.
+    m_workers.reserve(config.workerCount);
+    for (std::size_t i = 0; i < config.workerCount; ++i)
+    {
+        const std::size_t highestLane =
+            (config.workerCount > 1 && i == 0)
+                ? requestTypeIndex(RequestType::GET_MARKET_DATA)
+                : kLaneCount - 1;
+        m_workers.emplace_back([this, highestLane]() { workerLoop(highestLane); });
+    }
+}
+
+PipelinedServerFacade::~PipelinedServerFacade()
+{
+    stop();
+}
+
+Response PipelinedServerFacade::handleRequest(const Request& request)
+{
+    return m_inner->handleRequest(request);
+}
+
+Response PipelinedServerFacade::handleRequestStreaming(const Request& request, const ResponseCallback& onChunk)
+{
+    return m_inner->handleRequestStreaming(request, onChunk);
+}
+
+void PipelinedServerFacade::handleRequestAsync(Request request, ResponseCallback onComplete)
+{
+    // stop() waits for this count to reach zero before draining the lanes,
+    // so a job pushed after the check below is still failed exactly once.
+    m_posting.fetch_add(1, std::memory_order_seq_cst);
+    if (m_stopping.load(std::memory_order_seq_cst))
+    {
+        m_posting.fetch_sub(1, std::memory_order_release);
+        onComplete(Response{false, "Server is shutting down", {}});
+        return;
+    }
+
+    const std::size_t index = requestTypeIndex(request.type);
+    if (m_direct[index])
+    {
+        m_posting.fetch_sub(1, std::memory_order_release);
+        m_inner->handleRequestAsync(std::move(request), std::move(onComplete));
+        return;
+    }
+
+    auto&      lane = *m_lanes[index];
+    Job        job{std::move(request), std::move(onComplete)};
+    const bool accepted = lane.tryPush(std::move(job));
+    m_posting.fetch_sub(1, std::memory_order_release);
+
+    if (!accepted)
+    {
+        // tryPush leaves the job intact on failure.
+        job.onComplete(Response{false, "Server busy: request queue full", {}});
+        return;
+    }
+
+    // Pairs with the seq_cst increment in workerLoop(): either the worker
+    // sees the job, or we see the sleeper and wake it. All sleepers are
+    // woken because the express worker cannot serve every lane.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idleCv.notify_all();
+    }
+}
+
+void PipelinedServerFacade::stop()
+{
+    if (m_stopping.exchange(true, std::memory_order_seq_cst))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idleCv.notify_all();
+    }
+
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+
+    // Fail whatever is still queued so every callback runs exactly once.
+    // Producers that passed the stopping check may still be pushing.
+    while (m_posting.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+
+    Job job;
+    for (auto& lane : m_lanes)
+    {
+        while (lane->tryPop(job))
+            job.onComplete(Response{false, "Server is shutting down", {}});
+    }
+}
+
+std::size_t PipelinedServerFacade::queueDepth(RequestType type) const
+{
+    return m_lanes[requestTypeIndex(type)]->sizeApprox();
+}
+
+// ==========================================================================
+// Worker side
+// ==========================================================================
+
+bool PipelinedServerFacade::tryPopJob(std::size_t highestLane, Job& out)
+{
+    for (std::size_t lane = 0; lane <= highestLane; ++lane)
+    {
+        if (m_lanes[lane]->tryPop(out))
+            return true;
+    }
+    return false;
+}
+
+bool PipelinedServerFacade::hasWork(std::size_t highestLane) const
+{
+    for (std::size_t lane = 0; lane <= highestLane; ++lane)
+    {
+        if (!m_lanes[lane]->emptyApprox())
+            return true;
+    }
+    return false;
+}
+
+void PipelinedServerFacade::workerLoop(std::size_t highestLane)
+{
+    Job job;
+    int idleSpins = 0;
+
+    while (!m_stopping.load(std::memory_order_relaxed))
+    {
+        if (tryPopJob(highestLane, job))
+        {
+            idleSpins = 0;
+            LatencyRecorder::instance().recordSince(job.request.type, LatencyStage::QUEUE,
+                                                    job.request.timing.decodedAt);
+            job.onComplete(m_inner->handleRequestStreaming(job.request, job.onComplete));
+            job = Job{};
+            continue;
+        }
+
+        if (++idleSpins < kSpinIterations)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Park until a producer signals new work (or shutdown).
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(m_idleMutex);
+            m_idleCv.wait_for(lock, std::chrono::milliseconds(10), [this, highestLane]() {
+                return m_stopping.load(std::memory_order_relaxed) || hasWork(highestLane);
+            });
+        }
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        idleSpins = 0;
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file PipelinedServerFacade.hpp
+ * @brief IServerFacade decorator that executes requests on a worker pool.
+ *
+ * @details Transport threads hand decoded requests to handleRequestAsync(),
+ * which pushes them into one lock-free bounded lane per RequestType and
+ * returns immediately. Worker threads drain the lanes in priority order
+ * (RequestType enum order, GET_MARKET_DATA first) and run the wrapped
+ * facade. When more than one worker is configured, worker 0 only serves
+ * the GET_MARKET_DATA lane, so quotes are never stuck behind reports that
+ * occupy every other worker.
+ *
+ * Types listed in PipelineConfig::directTypes skip the lanes: they are
+ * passed to the wrapped facade's handleRequestAsync() on the transport
+ * thread. This is for commands that queue to threads of their own and
+ * never block, such as order entry, which would otherwise wait behind
+ * every other lane.
+ */
+
+#ifndef PIPELINEDSERVERFACADE_HPP
+#define PIPELINEDSERVERFACADE_HPP
+
+#include "concurrency/BoundedMpmcQueue.hpp"
+#include "server/IServerFacade.hpp"
+#include "server/RequestTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct PipelineConfig
+ * @brief Sizing of the request pipeline.
+ */
+struct PipelineConfig
+{
+    /// @brief Number of command worker threads.
+    std::size_t workerCount{2};
+
+    /// @brief Capacity of each per-RequestType lane; full lanes reject requests.
+    std::size_t laneCapacity{1024};
+
+    /// @brief Types handed straight to the inner facade's handleRequestAsync().
+    std::vector<RequestType> directTypes;
+};
+
+/**
+ * @class PipelinedServerFacade
+ * @brief Staged pipeline: per-type priority lanes feeding a worker pool.
+ */
+class PipelinedServerFacade : public IServerFacade
+{
+public:
+    /**
+     * @brief Wrap @p inner and start the worker threads.
+     * @param inner  The facade that actually executes commands.
+     * @param config Worker count and lane capacity.
+     * @throws std::invalid_argument if @p inner is null or workerCount is 0.
+     */
+    PipelinedServerFacade(std::shared_ptr<IServerFacade> inner, PipelineConfig config = {});
+
+    ~PipelinedServerFacade() override;
+
+    PipelinedServerFacade(const PipelinedServerFacade&)            = delete;
+    PipelinedServerFacade& operator=(const PipelinedServerFacade&) = delete;
+
+    /// @brief Execute synchronously on the caller's thread (bypasses the lanes).
+    Response handleRequest(const Request& request) override;
+
+    /// @brief Execute synchronously on the caller's thread, streaming to @p onChunk.
+    Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk) override;
+
+    /**
+     * @brief Queue the request on its lane; @p onComplete runs on a worker.
+     *
+     * A streamed reply reaches @p onComplete as several calls from the same
+     * worker, in order; the worker stays with the request until the last.
+     *
+     * If the lane is full (or the pipeline is stopped) the callback is
+     * invoked immediately on the caller's thread with a failure response.
+     * Direct types are not queued here; the inner facade completes them.
+     */
+    void handleRequestAsync(Request request, ResponseCallback onComplete) override;
+
+    /**
+     * @brief Stop accepting work, wake and join all workers, then fail every
+     *        request still queued. Safe to race with handleRequestAsync():
+     *        each callback runs exactly once.
+     */
+    void stop();
+
+    /// @brief Approximate number of requests waiting in the lane for @p type.
+    std::size_t queueDepth(RequestType type) const;
+
+private:
+    /// One unit of queued work.
+    struct Job
+    {
+        Request          request;
+        ResponseCallback onComplete;
+    };
+
+    /// Lanes: one per RequestType plus a trailing lane for unknown types.
+    static constexpr std::size_t kLaneCount = kRequestTypeCount + 1;
+
+    void workerLoop(std::size_t highestLane);
+    bool tryPopJob(std::size_t highestLane, Job& out);
+    bool hasWork(std::size_t highestLane) const;
+
+    std::shared_ptr<IServerFacade> m_inner;
+
+    std::array<std::unique_ptr<BoundedMpmcQueue<Job>>, kLaneCount> m_lanes;
+    std::array<bool, kLaneCount>                                   m_direct{};
+    std::vector<std::thread>                                       m_workers;
+
+    std::atomic<bool> m_stopping{false};
+    std::atomic<int>  m_posting{0}; ///< handleRequestAsync() calls past the stopping check.
+
+    /// Idle workers park here; producers only notify when someone sleeps.
+    std::atomic<int>        m_sleepers{0};
+    std::mutex              m_idleMutex;
+    std::condition_variable m_idleCv;
+};
+
+#endif // PIPELINEDSERVERFACADE_HPP
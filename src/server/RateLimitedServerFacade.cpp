@@ -0,0 +1,69 @@
+/**
+ * @file RateLimitedServerFacade.cpp
+ * @brief Implementation of RateLimitedServerFacade.
+ */
+
+#include "RateLimitedServerFacade.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    const char* const kSessionLimitMessage = "Rate limited: session request budget exhausted";
+} // namespace
+
+RateLimitedServerFacade::RateLimitedServerFacade(std::shared_ptr<IServerFacade> inner,
+                                                 std::shared_ptr<RateLimiter>   limiter)
+    : m_inner(std::move(inner))
+    , m_limiter(std::move(limiter))
+{
+    if (!m_inner || !m_limiter)
+        throw std::invalid_argument("[RateLimitedServerFacade] inner facade and limiter must not be null");
+    for (std::size_t t = 0; t < m_typeLimitMessages.size(); ++t)
+        m_typeLimitMessages[t] = std::string("Rate limited: too many ")
+                                 + requestTypeName(static_cast<RequestType>(t)) + " requests";
+}
+
+Response RateLimitedServerFacade::handleRequest(const Request& request)
+{
+    Response refusal;
+    if (!admit(request, refusal))
+        return refusal;
+    return m_inner->handleRequest(request);
+}
+
+Response RateLimitedServerFacade::handleRequestStreaming(const Request& request, const ResponseCallback& onChunk)
+{
+    Response refusal;
+    if (!admit(request, refusal))
+        return refusal;
+    return m_inner->handleRequestStreaming(request, onChunk);
+}
+
+void RateLimitedServerFacade::handleRequestAsync(Request request, ResponseCallback onComplete)
+{
+    Response refusal;
+    if (!admit(request, refusal))
+    {
+        onComplete(std::move(refusal));
+        return;
+    }
+    m_inner->handleRequestAsync(std::move(request), std::move(onComplete));
+}
+
+bool RateLimitedServerFacade::admit(const Request& request, Response& refusal) const
+{
+    switch (m_limiter->admit(request))
+    {
+    case RateLimiter::Verdict::ADMITTED:
+        return true;
+    case RateLimiter::Verdict::SESSION_LIMIT:
+        refusal = Response{false, kSessionLimitMessage, {}};
+        return false;
+    case RateLimiter::Verdict::TYPE_LIMIT:
+        refusal = Response{false, m_typeLimitMessages[requestTypeIndex(request.type)], {}};
+        return false;
+    }
+    return true;
+}
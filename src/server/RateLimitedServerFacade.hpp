@@ -0,0 +1,56 @@
+/**
+ * @file RateLimitedServerFacade.hpp
+ * @brief IServerFacade decorator that admits requests through a RateLimiter.
+ *
+ * @details Sits in front of the pipeline: a request its session cannot
+ * pay for is answered on the transport thread with a failure Response,
+ * before it is queued or any command is created, so a client flooding
+ * GENERATE_REPORT or MANIPULATE never takes a lane slot or a worker from
+ * anyone else. Admitted requests are passed on unchanged.
+ */
+
+#ifndef RATELIMITEDSERVERFACADE_HPP
+#define RATELIMITEDSERVERFACADE_HPP
+
+#include "RateLimiter.hpp"
+#include "server/IServerFacade.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+
+/**
+ * @class RateLimitedServerFacade
+ * @brief Per-session admission control in front of another facade.
+ */
+class RateLimitedServerFacade : public IServerFacade
+{
+public:
+    /**
+     * @param inner   The facade admitted requests are passed to.
+     * @param limiter Decides which requests are admitted.
+     * @throws std::invalid_argument if @p inner or @p limiter is null.
+     */
+    RateLimitedServerFacade(std::shared_ptr<IServerFacade> inner, std::shared_ptr<RateLimiter> limiter);
+
+    /// @copydoc IServerFacade::handleRequest
+    Response handleRequest(const Request& request) override;
+
+    /// @copydoc IServerFacade::handleRequestStreaming
+    Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk) override;
+
+    /// @brief Admit or refuse on the caller's thread; admitted requests go to the inner facade.
+    void handleRequestAsync(Request request, ResponseCallback onComplete) override;
+
+private:
+    /// True if admitted; otherwise @p refusal holds the failure Response.
+    bool admit(const Request& request, Response& refusal) const;
+
+    std::shared_ptr<IServerFacade> m_inner;
+    std::shared_ptr<RateLimiter>   m_limiter;
+
+    /// Refusal messages per type, built once so a refusal only copies a string.
+    std::array<std::string, kRequestTypeCount + 1> m_typeLimitMessages;
+};
+
+#endif // RATELIMITEDSERVERFACADE_HPP
@@ -0,0 +1,219 @@
+/**
+ * @file RateLimiter.cpp
+ * @brief Implementation of RateLimiter.
+ */
+
+#include "RateLimiter.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double kNanosPerSecond = 1e9;
+
+    /// Can @p bucket, already refilled to @p tokens, pay @p amount?
+    bool canPay(double tokens, double amount, const TokenBucketLimit& limit)
+    {
+        return tokens >= amount || tokens >= limit.burst;
+    }
+
+    void checkLimit(const TokenBucketLimit& limit)
+    {
+        if (limit.rate < 0.0 || limit.burst < 0.0)
+            throw std::invalid_argument("[RateLimiter] rates and bursts must not be negative");
+    }
+
+    /// A burst of 0 means one second's worth of tokens.
+    void normalise(TokenBucketLimit& limit)
+    {
+        if (limit.burst == 0.0)
+            limit.burst = limit.rate;
+    }
+} // namespace
+
+std::array<double, kRequestTypeCount> defaultRequestCosts()
+{
+    std::array<double, kRequestTypeCount> costs{};
+    costs.fill(1.0);
+    costs[requestTypeIndex(RequestType::CALCULATE)]           = 10.0;
+    costs[requestTypeIndex(RequestType::MANIPULATE)]          = 20.0;
+    costs[requestTypeIndex(RequestType::GENERATE_REPORT)]     = 100.0;
+    costs[requestTypeIndex(RequestType::RECOVER_MARKET_DATA)] = 5.0;
+    return costs;
+}
+
+// ==========================================================================
+// Construction and queries
+// ==========================================================================
+
+RateLimiter::RateLimiter(RateLimitConfig config)
+    : m_config(config)
+    , m_stripes(std::make_unique<Stripe[]>(kStripes))
+{
+    checkLimit(m_config.session);
+    normalise(m_config.session);
+    m_enabled = m_config.session.rate > 0.0;
+    for (TokenBucketLimit& limit : m_config.perType)
+    {
+        checkLimit(limit);
+        normalise(limit);
+        m_enabled = m_enabled || limit.rate > 0.0;
+    }
+    for (double cost : m_config.cost)
+    {
+        if (cost < 0.0)
+            throw std::invalid_argument("[RateLimiter] costs must not be negative");
+    }
+}
+
+double RateLimiter::cost(const Request& request) const
+{
+    return demand(request).cost;
+}
+
+uint64_t RateLimiter::rejected(RequestType type) const
+{
+    return m_rejected[requestTypeIndex(type)].load(std::memory_order_relaxed);
+}
+
+std::size_t RateLimiter::trackedSessions() const
+{
+    std::size_t sessions = 0;
+    for (std::size_t i = 0; i < kStripes; ++i)
+    {
+        std::lock_guard<std::mutex> lock(m_stripes[i].mutex);
+        sessions += m_stripes[i].sessions.size();
+    }
+    return sessions;
+}
+
+// ==========================================================================
+// Admission
+// ==========================================================================
+
+RateLimiter::Verdict RateLimiter::admit(const Request& request)
+{
+    if (!m_enabled || request.sessionId == 0)
+        return Verdict::ADMITTED;
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return admit(request, std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+RateLimiter::Verdict RateLimiter::admit(const Request& request, int64_t nowNs)
+{
+    if (!m_enabled || request.sessionId == 0)
+        return Verdict::ADMITTED;
+
+    const Demand need   = demand(request);
+    Stripe&      stripe = m_stripes[request.sessionId % kStripes];
+    Verdict      verdict = Verdict::ADMITTED;
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        auto                        found = stripe.sessions.find(request.sessionId);
+        if (found == stripe.sessions.end())
+        {
+            if (stripe.sessions.size() >= stripe.sweepAt)
+                sweep(stripe, nowNs);
+            found = stripe.sessions.emplace(request.sessionId, newSession(nowNs)).first;
+        }
+        Session& session = found->second;
+
+        // Check every bucket before charging any, so a refusal costs nothing.
+        const double sessionTokens = refill(session.session, m_config.session, nowNs);
+        if (m_config.session.rate > 0.0 && !canPay(sessionTokens, need.cost, m_config.session))
+            verdict = Verdict::SESSION_LIMIT;
+        for (std::size_t t = 0; t < kRequestTypeCount && verdict == Verdict::ADMITTED; ++t)
+        {
+            const TokenBucketLimit& limit = m_config.perType[t];
+            if (need.requests[t] > 0 && limit.rate > 0.0
+                && !canPay(refill(session.types[t], limit, nowNs), need.requests[t], limit))
+                verdict = Verdict::TYPE_LIMIT;
+        }
+
+        if (verdict == Verdict::ADMITTED)
+        {
+            if (m_config.session.rate > 0.0)
+                session.session = Bucket{sessionTokens - need.cost, nowNs};
+            for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+            {
+                if (need.requests[t] > 0 && m_config.perType[t].rate > 0.0)
+                    session.types[t] =
+                        Bucket{refill(session.types[t], m_config.perType[t], nowNs) - need.requests[t], nowNs};
+            }
+        }
+    }
+
+    if (verdict != Verdict::ADMITTED)
+        m_rejected[requestTypeIndex(request.type)].fetch_add(1, std::memory_order_relaxed);
+    return verdict;
+}
+
+// ==========================================================================
+// Helpers
+// ==========================================================================
+
+RateLimiter::Demand RateLimiter::demand(const Request& request) const
+{
+    Demand            need;
+    const std::size_t index = requestTypeIndex(request.type);
+    if (index == kRequestTypeCount)
+        return need; // unknown types fail in the facade; charge nothing
+    need.cost = m_config.cost[index];
+    need.requests[index] = 1;
+    if (request.type != RequestType::BATCH)
+        return need;
+
+    // A malformed batch is refused by BatchCommand; it is charged as BATCH alone.
+    PodArrayView<BatchItemPOD> items;
+    std::size_t                offset = 0;
+    if (pod::bindSection(request.payload.data(), request.payload.size(), items, offset) != PodDecodeStatus::OK)
+        return need;
+    for (const BatchItemPOD& item : items)
+    {
+        const std::size_t sub = requestTypeIndex(static_cast<RequestType>(item.requestType));
+        if (sub == kRequestTypeCount || sub == index)
+            continue;
+        need.cost += m_config.cost[sub];
+        ++need.requests[sub];
+    }
+    return need;
+}
+
+RateLimiter::Session RateLimiter::newSession(int64_t nowNs) const
+{
+    Session session;
+    session.session = Bucket{m_config.session.burst, nowNs};
+    for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+        session.types[t] = Bucket{m_config.perType[t].burst, nowNs};
+    return session;
+}
+
+double RateLimiter::refill(const Bucket& bucket, const TokenBucketLimit& limit, int64_t nowNs)
+{
+    const double elapsed = static_cast<double>(std::max<int64_t>(0, nowNs - bucket.updatedNs)) / kNanosPerSecond;
+    return std::min(limit.burst, bucket.tokens + elapsed * limit.rate);
+}
+
+bool RateLimiter::full(const Session& session, int64_t nowNs) const
+{
+    if (refill(session.session, m_config.session, nowNs) < m_config.session.burst)
+        return false;
+    for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+    {
+        if (refill(session.types[t], m_config.perType[t], nowNs) < m_config.perType[t].burst)
+            return false;
+    }
+    return true;
+}
+
+void RateLimiter::sweep(Stripe& stripe, int64_t nowNs) const
+{
+    for (auto it = stripe.sessions.begin(); it != stripe.sessions.end();)
+        it = full(it->second, nowNs) ? stripe.sessions.erase(it) : std::next(it);
+    stripe.sweepAt = std::max(kSweepMinimum, stripe.sessions.size() * 2);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file RateLimiter.hpp
+ * @brief Per-session token buckets that admit or refuse requests by weighted cost.
+ *
+ * @details Every session has a bucket of cost units, refilled at
+ * RateLimitConfig::session.rate up to its burst, and charged
+ * RateLimitConfig::cost of each request: a GET_MARKET_DATA costs 1, a
+ * GENERATE_REPORT 100 by default. A BATCH costs its own weight plus that
+ * of every sub-request, so batching does not get around the limit. Types
+ * with an entry in RateLimitConfig::perType also get a bucket of their
+ * own per session, counted in requests. A request is admitted only if
+ * every bucket it draws on can pay; a bucket that is full always can, so
+ * a request that costs more than the burst still gets through, leaving
+ * the bucket in debt until it refills.
+ *
+ * Sessions are spread over cache-line-aligned stripes, each a small map
+ * under its own mutex. A session's requests arrive on its io thread, so
+ * a stripe lock is practically never contended. A bucket that has refilled
+ * completely behaves exactly like a new one, so sessions whose buckets
+ * are all full are dropped whenever a stripe grows: the limiter needs no
+ * notice of closed sessions and holds state only for recently active ones.
+ *
+ * Requests without a session (sessionId 0, e.g. the server's own) are
+ * never limited.
+ */
+
+#ifndef RATELIMITER_HPP
+#define RATELIMITER_HPP
+
+#include "concurrency/BoundedMpmcQueue.hpp" // kCacheLineSize
+#include "models/Request.hpp"
+#include "server/RequestTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @struct TokenBucketLimit
+ * @brief Refill rate and depth of one token bucket.
+ */
+struct TokenBucketLimit
+{
+    /// @brief Tokens added per second; 0 disables the bucket.
+    double rate{0.0};
+
+    /// @brief Most tokens the bucket holds; 0 means one second's worth (rate).
+    double burst{0.0};
+};
+
+/// @brief Default cost weights: quotes and orders 1, heavy scans and reports far more.
+std::array<double, kRequestTypeCount> defaultRequestCosts();
+
+/**
+ * @struct RateLimitConfig
+ * @brief Session budget, per-type limits and cost weights of a RateLimiter.
+ */
+struct RateLimitConfig
+{
+    /// @brief Cost units per second of each session, over all its requests.
+    TokenBucketLimit session;
+
+    /// @brief Requests per second of one type, per session; rate 0 = no such limit.
+    std::array<TokenBucketLimit, kRequestTypeCount> perType{};
+
+    /// @brief Cost units charged to the session bucket per request of each type.
+    std::array<double, kRequestTypeCount> cost = defaultRequestCosts();
+};
+
+/**
+ * @class RateLimiter
+ * @brief Admission decisions for requests, one set of token buckets per session.
+ */
+class RateLimiter
+{
+public:
+    /// @brief Outcome of admit().
+    enum class Verdict
+    {
+        ADMITTED,      ///< Charged to the session's buckets.
+        SESSION_LIMIT, ///< The session has spent its cost budget.
+        TYPE_LIMIT,    ///< The session sent too many requests of one type.
+    };
+
+    /**
+     * @throws std::invalid_argument if a rate, burst or cost is negative.
+     */
+    explicit RateLimiter(RateLimitConfig config);
+
+    /// @brief True if any bucket is configured; otherwise admit() always admits.
+    bool enabled() const { return m_enabled; }
+
+    /// @brief Charge @p request to its session's buckets at the current time.
+    Verdict admit(const Request& request);
+
+    /// @brief As above, at steady-clock time @p nowNs (nanoseconds).
+    Verdict admit(const Request& request, int64_t nowNs);
+
+    /// @brief Cost units @p request draws from the session bucket.
+    double cost(const Request& request) const;
+
+    /// @brief Requests of @p type refused so far.
+    uint64_t rejected(RequestType type) const;
+
+    /// @brief Sessions currently holding buckets.
+    std::size_t trackedSessions() const;
+
+private:
+    /// Bucket level at a point in time; refilled lazily.
+    struct Bucket
+    {
+        double  tokens{0.0};
+        int64_t updatedNs{0};
+    };
+
+    /// The buckets of one session.
+    struct Session
+    {
+        Bucket                                session;
+        std::array<Bucket, kRequestTypeCount> types{};
+    };
+
+    /// What one request draws on: its cost and, per type, how many requests.
+    struct Demand
+    {
+        double                                  cost{0.0};
+        std::array<uint32_t, kRequestTypeCount> requests{};
+    };
+
+    static constexpr std::size_t kStripes      = 64;
+    static constexpr std::size_t kSweepMinimum = 256; ///< Sessions a stripe holds before its first sweep.
+
+    struct alignas(kCacheLineSize) Stripe
+    {
+        std::mutex                            mutex;
+        std::unordered_map<uint64_t, Session> sessions;
+        std::size_t                           sweepAt{kSweepMinimum};
+    };
+
+    Demand demand(const Request& request) const;
+    Session newSession(int64_t nowNs) const;
+    static double refill(const Bucket& bucket, const TokenBucketLimit& limit, int64_t nowNs);
+    bool full(const Session& session, int64_t nowNs) const;
+    void sweep(Stripe& stripe, int64_t nowNs) const;
+
+    RateLimitConfig m_config;
+    bool            m_enabled{false};
+
+    std::unique_ptr<Stripe[]>                                 m_stripes;
+    std::array<std::atomic<uint64_t>, kRequestTypeCount + 1> m_rejected{};
+};
+
+#endif // RATELIMITER_HPP
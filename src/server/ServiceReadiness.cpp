@@ -0,0 +1,157 @@
+/**
+ * @file ServiceReadiness.cpp
+ * @brief Implementation of ServiceReadiness.
+ */
+
+#include "ServiceReadiness.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+ServiceReadiness::ServiceReadiness()
+    : m_start(std::chrono::steady_clock::now())
+{
+}
+
+ServiceReadiness::ServiceId ServiceReadiness::addService(std::string name, std::initializer_list<RequestType> types)
+{
+    if (name.empty())
+        throw std::invalid_argument("[ServiceReadiness] service name must not be empty");
+
+    auto service              = std::make_unique<Service>();
+    service->warmingUpMessage = "Warming up: " + name + " is still loading";
+    service->failedMessage    = "Unavailable: " + name + " failed to load";
+    service->name             = std::move(name);
+    for (RequestType type : types)
+    {
+        const std::size_t index = requestTypeIndex(type);
+        if (index == kRequestTypeCount || type == RequestType::BATCH)
+            throw std::invalid_argument("[ServiceReadiness] cannot gate request type "
+                                        + std::to_string(static_cast<uint32_t>(type)));
+        if (std::find(service->types.begin(), service->types.end(), index) == service->types.end())
+            service->types.push_back(index);
+    }
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t index : service->types)
+        m_pending[index].fetch_add(1, std::memory_order_relaxed);
+    m_warmingUp.fetch_add(1, std::memory_order_relaxed);
+    m_services.push_back(std::move(service));
+    return m_services.size() - 1;
+}
+
+bool ServiceReadiness::markReady(ServiceId id)
+{
+    return settle(id, ServiceState::READY);
+}
+
+bool ServiceReadiness::markFailed(ServiceId id)
+{
+    return settle(id, ServiceState::FAILED);
+}
+
+bool ServiceReadiness::settle(ServiceId id, ServiceState state)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (id >= m_services.size())
+        throw std::out_of_range("[ServiceReadiness] unknown service id " + std::to_string(id));
+
+    Service& service = *m_services[id];
+    if (service.state.load(std::memory_order_relaxed) != static_cast<uint8_t>(ServiceState::WARMING_UP))
+        return false;
+
+    service.elapsedMicros = elapsedMicros();
+    // Release: a request admitted after this sees everything the loader wrote.
+    service.state.store(static_cast<uint8_t>(state), std::memory_order_release);
+    if (state == ServiceState::READY)
+    {
+        for (std::size_t index : service.types)
+            m_pending[index].fetch_sub(1, std::memory_order_release);
+    }
+    else
+        m_failed.store(true);
+    m_warmingUp.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+// ==========================================================================
+// Admission
+// ==========================================================================
+
+bool ServiceReadiness::admit(const Request& request, Response& refusal) const
+{
+    const std::size_t index = requestTypeIndex(request.type);
+    if (index == kRequestTypeCount)
+        return true; // unknown types fail in the facade
+    if (request.type != RequestType::BATCH)
+        return admitType(index, refusal);
+    if (allReady())
+        return true;
+
+    // A malformed batch is refused by BatchCommand; only its sub-requests are gated.
+    PodArrayView<BatchItemPOD> items;
+    std::size_t                offset = 0;
+    if (pod::bindSection(request.payload.data(), request.payload.size(), items, offset) != PodDecodeStatus::OK)
+        return true;
+    for (const BatchItemPOD& item : items)
+    {
+        const std::size_t sub = requestTypeIndex(static_cast<RequestType>(item.requestType));
+        if (sub != kRequestTypeCount && sub != index && !admitType(sub, refusal))
+            return false;
+    }
+    return true;
+}
+
+bool ServiceReadiness::admitType(std::size_t type, Response& refusal) const
+{
+    if (m_pending[type].load(std::memory_order_acquire) == 0)
+        return true;
+
+    // Slow path, only while starting up: name the service the type waits for.
+    for (const auto& service : m_services)
+    {
+        const auto state = static_cast<ServiceState>(service->state.load(std::memory_order_acquire));
+        if (state == ServiceState::READY
+            || std::find(service->types.begin(), service->types.end(), type) == service->types.end())
+            continue;
+        refusal = Response{false, state == ServiceState::FAILED ? service->failedMessage : service->warmingUpMessage, {}};
+        return false;
+    }
+    return true; // the last service became ready since the load above
+}
+
+// ==========================================================================
+// Status
+// ==========================================================================
+
+ServiceStatus ServiceReadiness::status(ServiceId id) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (id >= m_services.size())
+        throw std::out_of_range("[ServiceReadiness] unknown service id " + std::to_string(id));
+
+    const Service& service = *m_services[id];
+    ServiceStatus  status;
+    status.name            = service.name;
+    status.state           = static_cast<ServiceState>(service.state.load(std::memory_order_relaxed));
+    const int64_t micros   = status.state == ServiceState::WARMING_UP ? elapsedMicros() : service.elapsedMicros;
+    status.elapsed         = std::chrono::milliseconds(micros / 1000);
+    return status;
+}
+
+std::vector<ServiceStatus> ServiceReadiness::statuses() const
+{
+    std::vector<ServiceStatus> all;
+    all.reserve(m_services.size());
+    for (ServiceId id = 0; id < m_services.size(); ++id)
+        all.push_back(status(id));
+    return all;
+}
+
+int64_t ServiceReadiness::elapsedMicros() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ServiceReadiness.hpp
+ * @brief Which services have finished loading, and which requests may run.
+ *
+ * @details main starts the transport as soon as it can and loads the
+ * services' state (snapshot, journal tail) on another thread. Each service
+ * is registered with the request types that need it; until it is marked
+ * ready, admit() refuses those types with a "warming up" Response, so a
+ * client learns to retry instead of reading a half-restored book. Types no
+ * service claims (GET_STATS) are always admitted, and a BATCH is admitted
+ * only if every one of its sub-request types is.
+ *
+ * Services are registered before the first admit() and never removed.
+ * After that every method is thread-safe: admit() of a ready type is one
+ * acquire load, so the gate costs nothing once startup is over.
+ */
+
+#ifndef SERVICEREADINESS_HPP
+#define SERVICEREADINESS_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+#include "server/RequestTypes.hpp"
+#include "server/ServiceStatus.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class ServiceReadiness
+ * @brief Per-service load state and the request types each one gates.
+ */
+class ServiceReadiness
+{
+public:
+    /// @brief Handle of a registered service.
+    using ServiceId = std::size_t;
+
+    /// @brief Starts the clock ServiceStatus::elapsed is measured from.
+    ServiceReadiness();
+
+    ServiceReadiness(const ServiceReadiness&)            = delete;
+    ServiceReadiness& operator=(const ServiceReadiness&) = delete;
+
+    /**
+     * @brief Register a service, warming up, that the requests of @p types need.
+     * @details A type may be gated by several services; it is admitted
+     *          once all of them are ready. Not thread-safe: call before
+     *          requests are admitted.
+     * @throws std::invalid_argument if @p name is empty, or a type is BATCH
+     *         (gated by its sub-requests) or out of range.
+     */
+    ServiceId addService(std::string name, std::initializer_list<RequestType> types);
+
+    /// @brief Mark @p id ready. @return False if it was no longer warming up.
+    bool markReady(ServiceId id);
+
+    /// @brief Mark @p id failed; its types stay refused. @return False if it was no longer warming up.
+    bool markFailed(ServiceId id);
+
+    /// @brief True if every service is ready.
+    bool allReady() const { return m_warmingUp.load(std::memory_order_acquire) == 0 && !m_failed.load(); }
+
+    /**
+     * @brief True if @p request may run now.
+     * @details Otherwise @p refusal holds the failure Response naming the
+     *          service it waits for.
+     */
+    bool admit(const Request& request, Response& refusal) const;
+
+    /// @brief State of @p id.
+    ServiceStatus status(ServiceId id) const;
+
+    /// @brief State of every service, in registration order.
+    std::vector<ServiceStatus> statuses() const;
+
+private:
+    struct Service
+    {
+        std::string              name;
+        std::string              warmingUpMessage;
+        std::string              failedMessage;
+        std::vector<std::size_t> types;
+        std::atomic<uint8_t>     state{static_cast<uint8_t>(ServiceState::WARMING_UP)};
+        int64_t                  elapsedMicros{0}; ///< Set under m_mutex when the state leaves WARMING_UP.
+    };
+
+    bool settle(ServiceId id, ServiceState state);
+
+    /// True if @p type is admitted; otherwise @p refusal is set from the first service it waits for.
+    bool admitType(std::size_t type, Response& refusal) const;
+
+    int64_t elapsedMicros() const;
+
+    const std::chrono::steady_clock::time_point m_start;
+    std::vector<std::unique_ptr<Service>>       m_services;
+
+    /// Serialises state changes with status(); admit() only reads the atomics.
+    mutable std::mutex m_mutex;
+
+    /// Services of each type not ready yet; 0 means the type is admitted.
+    std::array<std::atomic<uint32_t>, kRequestTypeCount> m_pending{};
+
+    std::atomic<std::size_t> m_warmingUp{0};
+    std::atomic<bool>        m_failed{false};
+};
+
+#endif // SERVICEREADINESS_HPP
@@ -5,7 +5,11 @@
 
 #include "TradingServerFacade.hpp"
 
+#include "commands/BatchCommand.hpp"
+#include "metrics/LatencyRecorder.hpp"
+
 #include <stdexcept>
+#include <utility>
 
 TradingServerFacade::TradingServerFacade(
     std::shared_ptr<IMarketDataService>   marketDataService,
@@ -23,10 +27,18 @@ TradingServerFacade::TradingServerFacade(
 
 Response TradingServerFacade::handleRequest(const Request& request)
 {
+    return handleRequestStreaming(request, ResponseCallback{});
+}
+
+Response TradingServerFacade::handleRequestStreaming(const Request& request, const ResponseCallback& onChunk)
+{
+    const ScopedLatency timer(request.type, LatencyStage::SERVICE);
     try
     {
-        auto command = m_registry.create(request);
-        return command->execute();
+        // BATCH runs its sub-requests through this facade's own registry.
+        if (request.type == RequestType::BATCH)
+            return BatchCommand::run(m_registry, request);
+        return m_registry.execute(request, onChunk);
     }
     catch (const std::out_of_range& e)
     {
@@ -37,3 +49,13 @@ Response TradingServerFacade::handleRequest(const Request& request)
         return Response{false, std::string("Internal server error: ") + e.what(), {}};
     }
 }
+
+void TradingServerFacade::handleRequestAsync(Request request, ResponseCallback onComplete)
+{
+    if (!m_registry.isAsync(request.type))
+    {
+        onComplete(handleRequestStreaming(request, onComplete));
+        return;
+    }
+    m_registry.executeAsync(request, std::move(onComplete));
+}
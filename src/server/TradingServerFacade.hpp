@@ -4,7 +4,9 @@
  *
  * @details Receives requests from the transport layer, uses the CommandRegistry
  * to create the appropriate command, and executes it. All four service
- * dependencies are injected via the constructor.
+ * dependencies are injected via the constructor. BATCH requests are served
+ * by the facade itself: BatchCommand runs each sub-request through the same
+ * registry.
  */
 
 #ifndef TRADINGSERVERFACADE_HPP
@@ -54,6 +56,15 @@ public:
     /// @copydoc IServerFacade::handleRequest
     Response handleRequest(const Request& request) override;
 
+    /// @copydoc IServerFacade::handleRequestStreaming
+    /// Each call is recorded as LatencyStage::SERVICE.
+    Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk) override;
+
+    /// @copydoc IServerFacade::handleRequestAsync
+    /// Types registered with an AsyncHandler are completed by the handler's
+    /// own threads; everything else runs inline as by default.
+    void handleRequestAsync(Request request, ResponseCallback onComplete) override;
+
 private:
     std::shared_ptr<IMarketDataService>   m_marketDataService;
     std::shared_ptr<ICalculationService>  m_calculationService;
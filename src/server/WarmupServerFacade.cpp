@@ -0,0 +1,45 @@
+/**
+ * @file WarmupServerFacade.cpp
+ * @brief Implementation of WarmupServerFacade.
+ */
+
+#include "WarmupServerFacade.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+WarmupServerFacade::WarmupServerFacade(std::shared_ptr<IServerFacade>          inner,
+                                       std::shared_ptr<const ServiceReadiness> readiness)
+    : m_inner(std::move(inner))
+    , m_readiness(std::move(readiness))
+{
+    if (!m_inner || !m_readiness)
+        throw std::invalid_argument("[WarmupServerFacade] inner facade and readiness must not be null");
+}
+
+Response WarmupServerFacade::handleRequest(const Request& request)
+{
+    Response refusal;
+    if (!m_readiness->admit(request, refusal))
+        return refusal;
+    return m_inner->handleRequest(request);
+}
+
+Response WarmupServerFacade::handleRequestStreaming(const Request& request, const ResponseCallback& onChunk)
+{
+    Response refusal;
+    if (!m_readiness->admit(request, refusal))
+        return refusal;
+    return m_inner->handleRequestStreaming(request, onChunk);
+}
+
+void WarmupServerFacade::handleRequestAsync(Request request, ResponseCallback onComplete)
+{
+    Response refusal;
+    if (!m_readiness->admit(request, refusal))
+    {
+        onComplete(std::move(refusal));
+        return;
+    }
+    m_inner->handleRequestAsync(std::move(request), std::move(onComplete));
+}
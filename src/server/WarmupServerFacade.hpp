@@ -0,0 +1,48 @@
+/**
+ * @file WarmupServerFacade.hpp
+ * @brief IServerFacade decorator that refuses requests for services still loading.
+ *
+ * @details Outermost facade while the server starts: a request whose
+ * service is not ready in the ServiceReadiness is answered on the
+ * transport thread with a "warming up" failure Response, before it is
+ * rate limited, queued or routed. Every other request is passed on
+ * unchanged, so market data is served while reports are still loading.
+ */
+
+#ifndef WARMUPSERVERFACADE_HPP
+#define WARMUPSERVERFACADE_HPP
+
+#include "ServiceReadiness.hpp"
+#include "server/IServerFacade.hpp"
+
+#include <memory>
+
+/**
+ * @class WarmupServerFacade
+ * @brief Readiness gate in front of another facade.
+ */
+class WarmupServerFacade : public IServerFacade
+{
+public:
+    /**
+     * @param inner     The facade admitted requests are passed to.
+     * @param readiness Which services have loaded.
+     * @throws std::invalid_argument if @p inner or @p readiness is null.
+     */
+    WarmupServerFacade(std::shared_ptr<IServerFacade> inner, std::shared_ptr<const ServiceReadiness> readiness);
+
+    /// @copydoc IServerFacade::handleRequest
+    Response handleRequest(const Request& request) override;
+
+    /// @copydoc IServerFacade::handleRequestStreaming
+    Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk) override;
+
+    /// @brief Refuse on the caller's thread while warming up; admitted requests go to the inner facade.
+    void handleRequestAsync(Request request, ResponseCallback onComplete) override;
+
+private:
+    std::shared_ptr<IServerFacade>          m_inner;
+    std::shared_ptr<const ServiceReadiness> m_readiness;
+};
+
+#endif // WARMUPSERVERFACADE_HPP
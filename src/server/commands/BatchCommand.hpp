@@ -0,0 +1,156 @@
+/**
+ * @file BatchCommand.hpp
+ * @brief ICommand implementation that runs the sub-requests of a BATCH.
+ *
+ * @details One BATCH frame replaces many small ones: the transport, framing,
+ * queueing and dispatch work is paid once, and every sub-request runs back
+ * to back on the same worker.
+ *
+ * ### BATCH
+ *   Request payload : PayloadHeader + N × BatchItemPOD, then the N
+ *                     sub-request payloads back to back
+ *   Response data   : PayloadHeader + N × BatchResultPOD, then the reply
+ *                     data of the N sub-requests back to back
+ *
+ * Sub-requests run in order through the CommandRegistry, as if each had
+ * arrived in its own frame on the same session. A failing sub-request only
+ * fails its own BatchResultPOD (and contributes no data); the batch fails
+ * as a whole only if its payload is malformed. Sub-payloads are slices of
+ * the batch payload, so nothing is copied on the way in. Streamed replies
+ * (GENERATE_REPORT) are returned whole, and a BATCH cannot contain a BATCH.
+ */
+
+#ifndef BATCHCOMMAND_HPP
+#define BATCHCOMMAND_HPP
+
+#include "server/CommandRegistry.hpp"
+#include "server/ICommand.hpp"
+#include "server/RequestSchema.hpp"
+#include "models/Request.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @class BatchCommand
+ * @brief Command that runs every sub-request of a BATCH and packs the replies.
+ */
+class BatchCommand final : public ICommand
+{
+public:
+    /**
+     * @brief Construct the command with the registry and request.
+     * @param registry Dispatches the sub-requests; must outlive the command.
+     * @param request  The incoming BATCH request.
+     */
+    BatchCommand(const CommandRegistry& registry, const Request& request)
+        : m_registry(registry)
+        , m_request(request)
+    {}
+
+    /// @copydoc ICommand::execute
+    Response execute() override
+    {
+        return run(m_registry, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Called by TradingServerFacade for every BATCH request.
+     */
+    static Response run(const CommandRegistry& registry, const Request& request)
+    {
+        PodArrayView<BatchItemPOD> items;
+        std::size_t                offset = 0;
+        const PodDecodeStatus      status =
+            pod::bindSection(request.payload.data(), request.payload.size(), items, offset);
+        if (status != PodDecodeStatus::OK)
+            return Response{false, std::string("BatchService: ") + toString(status), {}};
+        if (items.empty())
+            return Response{false, "BatchService: no sub-requests", {}};
+
+        std::size_t payloadBytes = 0;
+        for (const BatchItemPOD& item : items)
+            payloadBytes += item.payloadBytes;
+        if (payloadBytes > request.payload.size() - offset)
+            return Response{false, "BatchService: sub-request payloads truncated", {}};
+        if (payloadBytes < request.payload.size() - offset)
+            return Response{false, "BatchService: unexpected bytes after sub-request payloads", {}};
+
+        std::vector<Response> replies;
+        replies.reserve(items.size());
+        std::size_t dataBytes = 0;
+        for (const BatchItemPOD& item : items)
+        {
+            Request sub;
+            sub.type      = static_cast<RequestType>(item.requestType);
+            sub.sessionId = request.sessionId;
+            sub.timing    = request.timing;
+            sub.payload   = request.payload.slice(offset, item.payloadBytes);
+            offset += item.payloadBytes;
+
+            replies.push_back(runOne(registry, sub));
+            if (replies.back().success)
+                dataBytes += replies.back().data.size();
+        }
+
+        Response response{true, "OK",
+                          PooledBuffer::uninitialized(pod::payloadSize<BatchResultPOD>(replies.size()) + dataBytes)};
+        uint8_t* out = response.data.data();
+
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<BatchResultPOD>::id),
+                                   PodSchema<BatchResultPOD>::version,
+                                   static_cast<uint32_t>(replies.size())};
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+
+        for (std::size_t i = 0; i < replies.size(); ++i)
+        {
+            BatchResultPOD result{};
+            result.requestType = items[i].requestType;
+            result.success     = replies[i].success ? 1 : 0;
+            result.dataBytes   = replies[i].success ? static_cast<uint32_t>(replies[i].data.size()) : 0;
+            std::memcpy(result.message, replies[i].message.data(),
+                        std::min(replies[i].message.size(), sizeof(result.message) - 1));
+            std::memcpy(out, &result, sizeof(result));
+            out += sizeof(result);
+        }
+        for (const Response& reply : replies)
+        {
+            if (!reply.success || reply.data.empty())
+                continue;
+            std::memcpy(out, reply.data.data(), reply.data.size());
+            out += reply.data.size();
+        }
+
+        return response;
+    }
+
+private:
+    /// @brief One sub-request; failures are reported, never thrown.
+    static Response runOne(const CommandRegistry& registry, const Request& sub)
+    {
+        if (sub.type == RequestType::BATCH)
+            return Response{false, "BatchService: BATCH cannot be nested", {}};
+        try
+        {
+            return registry.execute(sub);
+        }
+        catch (const std::out_of_range& e)
+        {
+            return Response{false, std::string("Unknown request type: ") + e.what(), {}};
+        }
+        catch (const std::exception& e)
+        {
+            return Response{false, std::string("Internal server error: ") + e.what(), {}};
+        }
+    }
+
+    const CommandRegistry& m_registry;
+    Request                m_request;
+};
+
+#endif // BATCHCOMMAND_HPP
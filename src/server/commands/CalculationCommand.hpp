@@ -17,7 +17,7 @@
  * @class CalculationCommand
  * @brief Command that executes a financial calculation based on the request.
  */
-class CalculationCommand : public ICommand
+class CalculationCommand final : public ICommand
 {
 public:
     /**
@@ -34,7 +34,16 @@ public:
     /// @copydoc ICommand::execute
     Response execute() override
     {
-        return m_service->calculate(m_request);
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(ICalculationService& service, const Request& request)
+    {
+        return service.calculate(request);
     }
 
 private:
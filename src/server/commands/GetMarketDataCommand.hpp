@@ -17,7 +17,7 @@
  * @class GetMarketDataCommand
  * @brief Command that retrieves market data for the parameters in the request.
  */
-class GetMarketDataCommand : public ICommand
+class GetMarketDataCommand final : public ICommand
 {
 public:
     /**
@@ -34,7 +34,16 @@ public:
     /// @copydoc ICommand::execute
     Response execute() override
     {
-        return m_service->getData(m_request);
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(IMarketDataService& service, const Request& request)
+    {
+        return service.getData(request);
     }
 
 private:
@@ -1,6 +1,11 @@
 /**
  * @file ManipulationCommand.hpp
- * @brief ICommand implementation that delegates to IManipulationService::manipulate().
+ * @brief ICommand implementation that delegates to IManipulationService.
+ *
+ * @details The ManipulationSpecPOD at the head of the payload selects the
+ * entry point: DAILY_PIVOT and OHLCV_BARS go to transform(), everything else
+ * (including malformed payloads and unknown operations, which the service
+ * rejects) to manipulate().
  */
 
 #ifndef MANIPULATIONCOMMAND_HPP
@@ -9,6 +14,7 @@
 #include "server/ICommand.hpp"
 #include "services/IManipulationService.hpp"
 #include "models/Request.hpp"
+#include "pod/PodView.hpp"
 
 #include <memory>
 #include <utility>
@@ -17,7 +23,7 @@
  * @class ManipulationCommand
  * @brief Command that applies a data manipulation operation based on the request.
  */
-class ManipulationCommand : public ICommand
+class ManipulationCommand final : public ICommand
 {
 public:
     /**
@@ -34,7 +40,24 @@ public:
     /// @copydoc ICommand::execute
     Response execute() override
     {
-        return m_service->manipulate(m_request);
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(IManipulationService& service, const Request& request)
+    {
+        PodArrayView<ManipulationSpecPOD> spec;
+        std::size_t                       consumed = 0;
+        if (pod::bindSection(request.payload.data(), request.payload.size(), spec, consumed)
+                == PodDecodeStatus::OK
+            && spec.size() == 1
+            && (spec[0].op == static_cast<uint8_t>(ManipulationOp::DAILY_PIVOT)
+                || spec[0].op == static_cast<uint8_t>(ManipulationOp::OHLCV_BARS)))
+            return service.transform(request);
+        return service.manipulate(request);
     }
 
 private:
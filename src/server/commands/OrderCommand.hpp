@@ -0,0 +1,64 @@
+/**
+ * @file OrderCommand.hpp
+ * @brief ICommand implementation that delegates SUBMIT_ORDER / CANCEL_ORDER
+ *        to IOrderService.
+ */
+
+#ifndef ORDERCOMMAND_HPP
+#define ORDERCOMMAND_HPP
+
+#include "server/ICommand.hpp"
+#include "services/IOrderService.hpp"
+#include "models/Request.hpp"
+
+#include <future>
+#include <memory>
+#include <utility>
+
+/**
+ * @class OrderCommand
+ * @brief Command that enters an order into its book or cancels a resting one.
+ */
+class OrderCommand final : public ICommand
+{
+public:
+    /**
+     * @brief Construct the command with the required service and request.
+     * @param service Shared pointer to the order service.
+     * @param request The incoming SUBMIT_ORDER or CANCEL_ORDER request.
+     */
+    OrderCommand(std::shared_ptr<IOrderService> service,
+                 const Request&                 request)
+        : m_service(std::move(service))
+        , m_request(request)
+    {}
+
+    /// @copydoc ICommand::execute
+    /// Waits for the book's owner thread to complete the request.
+    Response execute() override
+    {
+        auto done  = std::make_shared<std::promise<Response>>();
+        auto reply = done->get_future();
+        run(*m_service, m_request, [done](Response response) { done->set_value(std::move(response)); });
+        return reply.get();
+    }
+
+    /**
+     * @brief Hand the request to the service without constructing a command object.
+     * @details Used by CommandRegistry async handlers; @p onComplete runs on
+     *          the book's owner thread.
+     */
+    static void run(IOrderService& service, const Request& request, ResponseCallback onComplete)
+    {
+        if (request.type == RequestType::CANCEL_ORDER)
+            service.cancel(request, std::move(onComplete));
+        else
+            service.submit(request, std::move(onComplete));
+    }
+
+private:
+    std::shared_ptr<IOrderService> m_service;
+    Request                        m_request;
+};
+
+#endif // ORDERCOMMAND_HPP
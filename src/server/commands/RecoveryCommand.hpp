@@ -0,0 +1,55 @@
+/**
+ * @file RecoveryCommand.hpp
+ * @brief ICommand implementation that delegates RECOVER_MARKET_DATA to
+ *        IMarketDataRecoveryService.
+ */
+
+#ifndef RECOVERYCOMMAND_HPP
+#define RECOVERYCOMMAND_HPP
+
+#include "server/ICommand.hpp"
+#include "services/IMarketDataRecoveryService.hpp"
+#include "models/Request.hpp"
+
+#include <memory>
+#include <utility>
+
+/**
+ * @class RecoveryCommand
+ * @brief Command that resends the multicast ticks a consumer missed.
+ */
+class RecoveryCommand final : public ICommand
+{
+public:
+    /**
+     * @brief Construct the command with the required service and request.
+     * @param service Shared pointer to the recovery service.
+     * @param request The incoming RECOVER_MARKET_DATA request.
+     */
+    RecoveryCommand(std::shared_ptr<IMarketDataRecoveryService> service,
+                    const Request&                              request)
+        : m_service(std::move(service))
+        , m_request(request)
+    {}
+
+    /// @copydoc ICommand::execute
+    Response execute() override
+    {
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(IMarketDataRecoveryService& service, const Request& request)
+    {
+        return service.recover(request);
+    }
+
+private:
+    std::shared_ptr<IMarketDataRecoveryService> m_service;
+    Request                                     m_request;
+};
+
+#endif // RECOVERYCOMMAND_HPP
@@ -1,6 +1,11 @@
 /**
  * @file ReportCommand.hpp
  * @brief ICommand implementation that delegates to IReportService::generateReport().
+ *
+ * @details The payload is one ReportRequestPOD, optionally followed by a
+ * section of one ReportOptionsPOD that selects the reply's format. decode()
+ * reads both in place; the only allocation is the report type, and names
+ * up to the string's small-buffer size need none.
  */
 
 #ifndef REPORTCOMMAND_HPP
@@ -9,40 +14,112 @@
 #include "server/ICommand.hpp"
 #include "services/IReportService.hpp"
 #include "models/ReportRequest.hpp"
+#include "models/Request.hpp"
+#include "pod/PodView.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
 
 /**
  * @class ReportCommand
  * @brief Command that triggers report generation based on a ReportRequest.
- *
- * @note The constructor accepts a ReportRequest (not a generic Request) because
- * report generation requires structured parameters beyond a raw payload.
  */
-class ReportCommand : public ICommand
+class ReportCommand final : public ICommand
 {
 public:
     /**
-     * @brief Construct the command with the required service and report request.
-     * @param service       Shared pointer to the report service.
-     * @param reportRequest The structured report parameters.
+     * @brief Construct the command with the required service and request.
+     * @param service Shared pointer to the report service.
+     * @param request The incoming client request.
      */
     ReportCommand(std::shared_ptr<IReportService> service,
-                  ReportRequest                   reportRequest)
+                  const Request&                  request)
         : m_service(std::move(service))
-        , m_reportRequest(std::move(reportRequest))
+        , m_request(request)
     {}
 
     /// @copydoc ICommand::execute
     Response execute() override
     {
-        return m_service->generateReport(m_reportRequest);
+        return run(*m_service, m_request);
+    }
+
+    /// @copydoc ICommand::executeStreaming
+    Response executeStreaming(const ResponseCallback& onChunk) override
+    {
+        return runStreaming(*m_service, m_request, onChunk);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(IReportService& service, const Request& request)
+    {
+        return runStreaming(service, request, ResponseCallback{});
+    }
+
+    /// @brief Streaming counterpart of run(); see IReportService::generateReportStreaming().
+    static Response runStreaming(IReportService&         service,
+                                 const Request&          request,
+                                 const ResponseCallback& onChunk)
+    {
+        ReportRequest         reportRequest;
+        const PodDecodeStatus status = decode(request, reportRequest);
+        if (status != PodDecodeStatus::OK)
+            return Response{false, std::string("ReportService: ") + toString(status), {}};
+        return onChunk ? service.generateReportStreaming(reportRequest, onChunk)
+                       : service.generateReport(reportRequest);
+    }
+
+    /**
+     * @brief Read the ReportRequestPOD, and the ReportOptionsPOD if present, carried by @p request.
+     * @return PodDecodeStatus::OK with @p out filled, or why the payload is
+     *         not one ReportRequestPOD followed by at most one ReportOptionsPOD;
+     *         OUT_OF_RANGE for a day outside 0000-01-01 .. 9999-12-31.
+     */
+    static PodDecodeStatus decode(const Request& request, ReportRequest& out)
+    {
+        const uint8_t*    data = request.payload.data();
+        const std::size_t size = request.payload.size();
+
+        PodArrayView<ReportRequestPOD> params;
+        std::size_t                    consumed = 0;
+        PodDecodeStatus                status   = pod::bindSection(data, size, params, consumed);
+        if (status != PodDecodeStatus::OK)
+            return status;
+        if (params.size() != 1)
+            return params.empty() ? PodDecodeStatus::TRUNCATED : PodDecodeStatus::TRAILING_BYTES;
+
+        out.format = ReportFormat::TEXT;
+        if (consumed < size)
+        {
+            PodView<ReportOptionsPOD> options;
+            status = pod::bindOne(data + consumed, size - consumed, options);
+            if (status != PodDecodeStatus::OK)
+                return status;
+            out.format = static_cast<ReportFormat>(options->format); // ReportService rejects unknown formats
+        }
+
+        const ReportRequestPOD& record = params[0];
+        const TradingDate       from{record.dateFrom};
+        const TradingDate       to{record.dateTo};
+        if (!from.inIsoRange() || !to.inIsoRange())
+            return PodDecodeStatus::OUT_OF_RANGE;
+
+        out.reportType.assign(record.reportType, ::strnlen(record.reportType, sizeof(record.reportType)));
+        out.dateFrom = from;
+        out.dateTo   = to;
+        return PodDecodeStatus::OK;
     }
 
 private:
     std::shared_ptr<IReportService> m_service;
-    ReportRequest                   m_reportRequest;
+    Request                         m_request;
 };
 
 #endif // REPORTCOMMAND_HPP
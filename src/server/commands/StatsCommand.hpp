@@ -0,0 +1,54 @@
+/**
+ * @file StatsCommand.hpp
+ * @brief ICommand implementation that delegates GET_STATS to IStatsService.
+ */
+
+#ifndef STATSCOMMAND_HPP
+#define STATSCOMMAND_HPP
+
+#include "server/ICommand.hpp"
+#include "services/IStatsService.hpp"
+#include "models/Request.hpp"
+
+#include <memory>
+#include <utility>
+
+/**
+ * @class StatsCommand
+ * @brief Command that returns a snapshot of the server's counters.
+ */
+class StatsCommand final : public ICommand
+{
+public:
+    /**
+     * @brief Construct the command with the required service and request.
+     * @param service Shared pointer to the stats service.
+     * @param request The incoming GET_STATS request.
+     */
+    StatsCommand(std::shared_ptr<IStatsService> service,
+                 const Request&                 request)
+        : m_service(std::move(service))
+        , m_request(request)
+    {}
+
+    /// @copydoc ICommand::execute
+    Response execute() override
+    {
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(IStatsService& service, const Request& request)
+    {
+        return service.getStats(request);
+    }
+
+private:
+    std::shared_ptr<IStatsService> m_service;
+    Request                        m_request;
+};
+
+#endif // STATSCOMMAND_HPP
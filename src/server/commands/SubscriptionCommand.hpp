@@ -0,0 +1,57 @@
+/**
+ * @file SubscriptionCommand.hpp
+ * @brief ICommand implementation that delegates SUBSCRIBE / UNSUBSCRIBE to
+ *        ISubscriptionService.
+ */
+
+#ifndef SUBSCRIPTIONCOMMAND_HPP
+#define SUBSCRIPTIONCOMMAND_HPP
+
+#include "server/ICommand.hpp"
+#include "services/ISubscriptionService.hpp"
+#include "models/Request.hpp"
+
+#include <memory>
+#include <utility>
+
+/**
+ * @class SubscriptionCommand
+ * @brief Command that adds or removes the requesting session's subscriptions.
+ */
+class SubscriptionCommand final : public ICommand
+{
+public:
+    /**
+     * @brief Construct the command with the required service and request.
+     * @param service Shared pointer to the subscription service.
+     * @param request The incoming SUBSCRIBE or UNSUBSCRIBE request.
+     */
+    SubscriptionCommand(std::shared_ptr<ISubscriptionService> service,
+                        const Request&                        request)
+        : m_service(std::move(service))
+        , m_request(request)
+    {}
+
+    /// @copydoc ICommand::execute
+    Response execute() override
+    {
+        return run(*m_service, m_request);
+    }
+
+    /**
+     * @brief Perform the operation without constructing a command object.
+     * @details Used by CommandRegistry handlers on the allocation-free path.
+     */
+    static Response run(ISubscriptionService& service, const Request& request)
+    {
+        if (request.type == RequestType::UNSUBSCRIBE)
+            return service.unsubscribe(request);
+        return service.subscribe(request);
+    }
+
+private:
+    std::shared_ptr<ISubscriptionService> m_service;
+    Request                               m_request;
+};
+
+#endif // SUBSCRIPTIONCOMMAND_HPP
@@ -0,0 +1,472 @@
+/**
+ * @file CalculationEngine.cpp
+ * @brief Implementation of CalculationEngine.
+ */
+
+#include "CalculationEngine.hpp"
+
+#include "RiskKernels.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    /// Scenario rows per parallelFor chunk are sized to roughly this many multiply-adds.
+    constexpr std::size_t kFlopsPerChunk = 64 * 1024;
+
+    /// Per-thread SoA columns, reused across requests to avoid reallocating.
+    struct PositionColumns
+    {
+        std::vector<double>   quantity;
+        std::vector<double>   avgPrice;
+        std::vector<double>   mark;
+        std::vector<double>   pnl;
+        std::vector<SymbolId> ids;
+
+        void resize(std::size_t n)
+        {
+            quantity.resize(n);
+            avgPrice.resize(n);
+            mark.resize(n);
+            pnl.resize(n);
+            ids.resize(n);
+        }
+    };
+
+    /// Fingerprint of the fields that define a book (not its P&L or timestamps).
+    uint64_t fingerprint(const PodArrayView<PositionPOD>& positions)
+    {
+        uint64_t h = 1469598103934665603ull;
+        const auto mix = [&h](const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                h ^= bytes[i];
+                h *= 1099511628211ull;
+            }
+        };
+        for (const PositionPOD& position : positions)
+        {
+            const SymbolKey key(position.symbol);
+            mix(key.bytes, sizeof(key.bytes));
+            mix(&position.quantity, sizeof(position.quantity));
+            mix(&position.avgPrice, sizeof(position.avgPrice));
+        }
+        return h;
+    }
+
+    thread_local PositionColumns     t_columns;
+    thread_local std::vector<double> t_exposure;
+    thread_local std::vector<double> t_scenarioPnl;
+
+    /// @p summary with the VaR fields computeVar() filled in @p var.
+    RiskSummaryPOD withVar(RiskSummaryPOD summary, const RiskSummaryPOD& var)
+    {
+        summary.historicalVar = var.historicalVar;
+        summary.parametricVar = var.parametricVar;
+        summary.scenarioCount = var.scenarioCount;
+        return summary;
+    }
+
+    /// Standard normal quantile (Acklam's rational approximation, |error| < 1.2e-9).
+    double inverseNormalCdf(double p)
+    {
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                                   -2.759285104469687e+02, 1.383577518672690e+02,
+                                   -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                                   -1.556989798598866e+02, 6.680131188771972e+01,
+                                   -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                                   -2.400758277161838e+00, -2.549732539343734e+00,
+                                   4.374664141464968e+00,  2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                                   2.445134137142996e+00, 3.754408661907416e+00};
+        constexpr double kLow = 0.02425;
+
+        if (p < kLow)
+        {
+            const double q = std::sqrt(-2.0 * std::log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                 / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        if (p > 1.0 - kLow)
+            return -inverseNormalCdf(1.0 - p);
+
+        const double q = p - 0.5;
+        const double r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+             / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+} // namespace
+
+CalculationEngine::CalculationEngine(std::shared_ptr<InMemoryMarketDataService> marketData,
+                                     CalculationConfig                          config)
+    : m_marketData(std::move(marketData))
+    , m_config(config)
+    , m_z(0.0)
+    , m_pool(config.threads)
+{
+    if (!m_marketData)
+        throw std::invalid_argument("[CalculationEngine] marketData must not be null");
+    if (!(config.confidence > 0.5 && config.confidence < 1.0))
+        throw std::invalid_argument("[CalculationEngine] confidence must be in (0.5, 1)");
+
+    m_z = inverseNormalCdf(config.confidence);
+
+    if (m_config.residentBooks > 0)
+        m_listenerId = m_marketData->addUpdateListener(
+            [this](SymbolId id, const MarketDataPOD& snapshot) { onTick(id, snapshot); });
+}
+
+CalculationEngine::~CalculationEngine()
+{
+    if (m_config.residentBooks > 0)
+        m_marketData->removeUpdateListener(m_listenerId);
+}
+
+// ==========================================================================
+// calculate() — resident book if enabled, full recompute otherwise
+// ==========================================================================
+
+Response CalculationEngine::calculate(const Request& request)
+{
+    PodArrayView<PositionPOD> positions;
+    const PodDecodeStatus status = bindRequest<RequestType::CALCULATE>(request, positions);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("CalculationService: ") + toString(status), {}};
+    if (positions.empty())
+        return Response{false, "CalculationService: no positions supplied", {}};
+
+    try
+    {
+        return m_config.residentBooks > 0 ? calculateResident(positions) : calculateFull(positions);
+    }
+    catch (const std::length_error& ex)
+    {
+        return Response{false, std::string("CalculationService: ") + ex.what(), {}};
+    }
+}
+
+// ==========================================================================
+// Full recompute — mark, P&L kernel, scenario VaR
+// ==========================================================================
+
+Response CalculationEngine::calculateFull(const PodArrayView<PositionPOD>& positions)
+{
+    const std::size_t      n     = positions.size();
+    const MarketDataCache& cache = m_marketData->cache();
+
+    RiskSummaryPOD summary{};
+    summary.confidence    = m_config.confidence;
+    summary.positionCount = static_cast<uint32_t>(n);
+
+    // ── AoS → SoA, marking each position from the cache ───────────────────
+    PositionColumns& columns = t_columns;
+    columns.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const PositionPOD& position = positions[i];
+        const SymbolId     id       = cache.find(SymbolKey(position.symbol));
+
+        MarketDataRecord snapshot;
+        const bool       marked = id != kInvalidSymbolId && cache.load(id, snapshot) && snapshot.last > 0.0;
+
+        columns.quantity[i] = static_cast<double>(position.quantity);
+        columns.avgPrice[i] = position.avgPrice;
+        columns.mark[i]     = marked ? snapshot.last : position.avgPrice;
+        columns.ids[i]      = id;
+        if (!marked)
+            ++summary.unmarkedCount;
+        summary.grossExposure += std::fabs(columns.quantity[i] * columns.mark[i]);
+    }
+
+    summary.totalUnrealisedPnl = risk::unrealisedPnl(columns.quantity.data(), columns.avgPrice.data(),
+                                                     columns.mark.data(), columns.pnl.data(), n);
+
+    if (const auto set = scenarios())
+    {
+        // Net positions into one exposure per scenario column.
+        std::vector<double>& exposure = t_exposure;
+        exposure.assign(set->columns, 0.0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const SymbolId id = columns.ids[i];
+            if (id < set->columnOf.size() && set->columnOf[id] >= 0)
+                exposure[static_cast<std::size_t>(set->columnOf[id])] += columns.quantity[i] * columns.mark[i];
+        }
+        computeVar(*set, exposure, summary);
+    }
+
+    // ── Response: priced positions, then the summary section ──────────────
+    Response response{true, "OK",
+                      PooledBuffer::uninitialized(pod::payloadSize<PositionPOD>(n)
+                                                  + pod::payloadSize<RiskSummaryPOD>(1))};
+    uint8_t* out = response.data.data();
+    out += pod::writeArray(out, positions.data(), n);
+
+    uint8_t* record = out - n * sizeof(PositionPOD);
+    for (std::size_t i = 0; i < n; ++i, record += sizeof(PositionPOD))
+        std::memcpy(record + offsetof(PositionPOD, unrealisedPnl), &columns.pnl[i], sizeof(double));
+
+    pod::writeArray(out, &summary, 1);
+    return response;
+}
+
+// ==========================================================================
+// Incremental mode — resident books re-marked by ticks
+// ==========================================================================
+
+Response CalculationEngine::calculateResident(const PodArrayView<PositionPOD>& positions)
+{
+    const std::shared_ptr<ResidentBook> resident = residentBook(positions);
+    const std::shared_ptr<const ScenarioSet> set = scenarios();
+
+    // Under the book's lock only snapshot it: ticks wait for the copy, never
+    // for the VaR run, which reads the snapshot after the lock is released.
+    RiskSummaryPOD       summary{};
+    std::vector<double>& exposure   = t_exposure;
+    bool                 varCurrent = true;
+    uint64_t             version    = 0;
+    Response             response;
+    uint8_t*             out = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(resident->mutex);
+        if (resident->book.loaded())
+            m_bookHits.fetch_add(1, std::memory_order_relaxed);
+        else
+        {
+            m_bookMisses.fetch_add(1, std::memory_order_relaxed);
+            resident->book.load(positions, *m_marketData);
+        }
+        const IncrementalBook& book = resident->book;
+
+        summary.totalUnrealisedPnl = book.totalUnrealisedPnl();
+        summary.grossExposure      = book.grossExposure();
+        summary.confidence         = m_config.confidence;
+        summary.positionCount      = static_cast<uint32_t>(book.positions().size());
+        summary.unmarkedCount      = book.unmarkedCount();
+
+        version = book.version();
+        if (set)
+        {
+            varCurrent = resident->varScenarios == set && resident->varVersion == version;
+            if (varCurrent)
+                summary = withVar(summary, resident->var);
+            else
+            {
+                exposure.assign(set->columns, 0.0);
+                book.forEachExposure([&](SymbolId id, double value) {
+                    if (id < set->columnOf.size() && set->columnOf[id] >= 0)
+                        exposure[static_cast<std::size_t>(set->columnOf[id])] += value;
+                });
+            }
+        }
+
+        const std::size_t n = book.positions().size();
+        response            = Response{true, "OK",
+                            PooledBuffer::uninitialized(pod::payloadSize<PositionPOD>(n)
+                                                        + pod::payloadSize<RiskSummaryPOD>(1))};
+        out = response.data.data();
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<PositionPOD>::id),
+                                   PodSchema<PositionPOD>::version, static_cast<uint32_t>(n)};
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        out += book.writePositions(out, m_marketData->cache());
+    }
+
+    if (!varCurrent)
+    {
+        RiskSummaryPOD var{};
+        computeVar(*set, exposure, var);
+        summary = withVar(summary, var);
+
+        // Keep it for the next request unless a newer one was stored meanwhile.
+        std::lock_guard<std::mutex> lock(resident->mutex);
+        if (resident->varScenarios != set || resident->varVersion < version)
+        {
+            resident->varScenarios = set;
+            resident->varVersion   = version;
+            resident->var          = var;
+        }
+    }
+    pod::writeArray(out, &summary, 1);
+    return response;
+}
+
+std::shared_ptr<CalculationEngine::ResidentBook>
+CalculationEngine::residentBook(const PodArrayView<PositionPOD>& positions)
+{
+    const uint64_t key = fingerprint(positions);
+
+    std::lock_guard<std::mutex> lock(m_booksMutex);
+    for (auto it = m_books.begin(); it != m_books.end(); ++it)
+    {
+        if ((*it)->fingerprint != key || (*it)->positionCount != positions.size())
+            continue;
+        std::rotate(m_books.begin(), it, it + 1); // most recently used first
+        return m_books.front();
+    }
+
+    // Publish the book before it is loaded. A tick that arrives in between
+    // finds it not loaded and is skipped, but its snapshot is already in
+    // the cache, so load() picks it up.
+    auto resident           = std::make_shared<ResidentBook>();
+    resident->fingerprint   = key;
+    resident->positionCount = positions.size();
+    if (m_books.size() >= m_config.residentBooks)
+        m_books.pop_back();
+    m_books.insert(m_books.begin(), resident);
+    return resident;
+}
+
+void CalculationEngine::onTick(SymbolId id, const MarketDataPOD& snapshot)
+{
+    std::lock_guard<std::mutex> lock(m_booksMutex);
+    for (const auto& resident : m_books)
+    {
+        std::lock_guard<std::mutex> bookLock(resident->mutex);
+        if (resident->book.loaded())
+            resident->book.applyTick(id, snapshot.last);
+    }
+}
+
+CalculationEngine::ResidentBookStats CalculationEngine::residentBookStats() const
+{
+    return ResidentBookStats{m_bookHits.load(std::memory_order_relaxed), m_bookMisses.load(std::memory_order_relaxed)};
+}
+
+std::size_t CalculationEngine::residentBookCount() const
+{
+    std::lock_guard<std::mutex> lock(m_booksMutex);
+    return m_books.size();
+}
+
+void CalculationEngine::exportResidentBooks(std::vector<PositionPOD>& positions,
+                                            std::vector<std::size_t>& bookSizes) const
+{
+    positions.clear();
+    bookSizes.clear();
+
+    std::lock_guard<std::mutex> lock(m_booksMutex);
+    for (const auto& resident : m_books)
+    {
+        std::lock_guard<std::mutex> bookLock(resident->mutex);
+        if (!resident->book.loaded())
+            continue;
+        const std::size_t offset = positions.size();
+        positions.resize(offset + resident->book.positions().size());
+        resident->book.writePositions(reinterpret_cast<uint8_t*>(positions.data() + offset), m_marketData->cache());
+        bookSizes.push_back(positions.size() - offset);
+    }
+}
+
+void CalculationEngine::restoreResidentBooks(const PodArrayView<PositionPOD>& positions,
+                                             const std::vector<std::size_t>& bookSizes)
+{
+    std::vector<std::size_t> offsets(bookSizes.size());
+    std::size_t              total = 0;
+    for (std::size_t i = 0; i < bookSizes.size(); ++i)
+    {
+        offsets[i] = total;
+        total += bookSizes[i];
+    }
+    if (total > positions.size())
+        throw std::invalid_argument("[CalculationEngine] resident books need " + std::to_string(total)
+                                    + " positions, got " + std::to_string(positions.size()));
+    if (m_config.residentBooks == 0)
+        return;
+
+    // Least recently used first, so that each book lands in front of the
+    // previous one and the first book ends up most recently used.
+    const std::size_t kept = std::min(bookSizes.size(), m_config.residentBooks);
+    for (std::size_t i = kept; i-- > 0;)
+    {
+        const PodArrayView<PositionPOD> book(positions.data() + offsets[i], bookSizes[i]);
+        const std::shared_ptr<ResidentBook> resident = residentBook(book);
+
+        std::lock_guard<std::mutex> lock(resident->mutex);
+        resident->book.load(book, *m_marketData);
+    }
+}
+
+// ==========================================================================
+// Scenario VaR
+// ==========================================================================
+
+void CalculationEngine::computeVar(const ScenarioSet& set, const std::vector<double>& exposure,
+                                   RiskSummaryPOD& summary)
+{
+    if (set.rows == 0)
+        return;
+
+    // One dot product per scenario row, rows split across the pool.
+    std::vector<double>& pnl = t_scenarioPnl;
+    pnl.resize(set.rows);
+    const double*     returns = set.returns.data();
+    const double*     weights = exposure.data();
+    const std::size_t width   = set.columns;
+    const std::size_t grain   = std::max<std::size_t>(1, kFlopsPerChunk / width);
+    m_pool.parallelFor(set.rows, grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s = begin; s < end; ++s)
+            pnl[s] = risk::dot(returns + s * width, weights, width);
+    });
+
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (const double value : pnl)
+    {
+        sum   += value;
+        sumSq += value * value;
+    }
+    const double rows     = static_cast<double>(set.rows);
+    const double mean     = sum / rows;
+    const double variance = set.rows > 1 ? std::max(0.0, (sumSq - rows * mean * mean) / (rows - 1.0)) : 0.0;
+
+    const auto tail = static_cast<std::size_t>((1.0 - m_config.confidence) * rows);
+    const auto kth  = pnl.begin() + static_cast<std::ptrdiff_t>(std::min(tail, set.rows - 1));
+    std::nth_element(pnl.begin(), kth, pnl.end());
+
+    summary.historicalVar = std::max(0.0, -*kth);
+    summary.parametricVar = std::max(0.0, m_z * std::sqrt(variance) - mean);
+    summary.scenarioCount = static_cast<uint32_t>(set.rows);
+}
+
+// ==========================================================================
+// Scenario matrix
+// ==========================================================================
+
+void CalculationEngine::setScenarios(const std::vector<std::string>& symbols, std::vector<double> returns)
+{
+    if (symbols.empty() ? !returns.empty() : returns.size() % symbols.size() != 0)
+        throw std::invalid_argument("[CalculationEngine] returns must hold whole rows of symbols.size()");
+
+    auto set = std::make_shared<ScenarioSet>();
+    set->columnOf.assign(m_marketData->cache().capacity(), -1);
+    set->columns = symbols.size();
+    set->rows    = symbols.empty() ? 0 : returns.size() / symbols.size();
+    set->returns = std::move(returns);
+    for (std::size_t col = 0; col < symbols.size(); ++col)
+        set->columnOf[m_marketData->intern(symbols[col])] = static_cast<int32_t>(col);
+
+    std::lock_guard<std::mutex> lock(m_scenarioMutex);
+    m_scenarios = std::move(set);
+}
+
+std::size_t CalculationEngine::scenarioCount() const
+{
+    const auto set = scenarios();
+    return set ? set->rows : 0;
+}
+
+std::shared_ptr<const CalculationEngine::ScenarioSet> CalculationEngine::scenarios() const
+{
+    std::lock_guard<std::mutex> lock(m_scenarioMutex);
+    return m_scenarios;
+}
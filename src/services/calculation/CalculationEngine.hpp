@@ -0,0 +1,199 @@
+/**
+ * @file CalculationEngine.hpp
+ * @brief ICalculationService computing position P&L and portfolio VaR.
+ *
+ * @details CALCULATE carries the book as PositionPOD records. The engine
+ * marks every position at the latest `last` price in the market data cache.
+ * A position with no price yet is marked at its avgPrice and counted as
+ * unmarked. The records are copied once into structure-of-arrays columns
+ * so that the P&L kernel (RiskKernels.hpp) streams contiguous doubles
+ * through AVX2/AVX-512 lanes.
+ *
+ * VaR uses a scenario matrix of one-period relative returns, one column
+ * per symbol, loaded with setScenarios(). Positions are first netted into
+ * a per-column exposure vector (quantity × mark). Each scenario's
+ * portfolio P&L is then one dot product of its row with that vector, and
+ * the rows are split across a ForkJoinPool. Historical VaR is the loss at
+ * the confidence quantile of those P&Ls. Parametric VaR is z × σ − μ of
+ * the same distribution, so it reflects the correlations in the scenarios
+ * without building a covariance matrix. Both are 0 while no scenarios are
+ * loaded.
+ *
+ * ### Incremental mode
+ * With CalculationConfig::residentBooks > 0, the engine keeps the most
+ * recently requested books resident as IncrementalBooks, keyed by a
+ * fingerprint of their (symbol, quantity, avgPrice) records. A market data
+ * listener re-marks only the positions of each ticked symbol and moves the
+ * running totals. A CALCULATE for a resident book then copies out the
+ * always-fresh positions and totals instead of re-marking the whole book.
+ * VaR is recomputed only when a tick has moved the book or the scenario set
+ * has changed since the last request. A request holds the book's lock only
+ * to copy out its positions, totals and exposures. The VaR run reads that
+ * copy afterwards, so the market data update path, which re-marks the
+ * books on every tick, never waits for it. The least recently used book is
+ * evicted when a new one arrives and all slots are full.
+ *
+ * ### CALCULATE
+ *   Request payload : PayloadHeader + N × PositionPOD
+ *   Response data   : PayloadHeader + N × PositionPOD (unrealisedPnl filled in)
+ *                     PayloadHeader + 1 × RiskSummaryPOD
+ * Read the two sections with pod::bindSection().
+ */
+
+#ifndef CALCULATIONENGINE_HPP
+#define CALCULATIONENGINE_HPP
+
+#include "IncrementalBook.hpp"
+#include "InMemoryMarketDataService.hpp"
+#include "concurrency/ForkJoinPool.hpp"
+#include "services/ICalculationService.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CalculationConfig
+ * @brief Tuning options of the calculation engine.
+ */
+struct CalculationConfig
+{
+    /// @brief VaR confidence level in (0.5, 1).
+    double confidence{0.99};
+
+    /// @brief Worker threads for scenario VaR besides the caller.
+    std::size_t threads{ForkJoinPool::defaultWorkers()};
+
+    /// @brief Books kept resident and re-marked on ticks (0 = recompute every request).
+    std::size_t residentBooks{8};
+};
+
+/**
+ * @class CalculationEngine
+ * @brief Vectorised P&L and parallel scenario VaR over the market data cache.
+ */
+class CalculationEngine : public ICalculationService
+{
+public:
+    /**
+     * @param marketData Source of marks and of symbol ids.
+     * @param config     Confidence level and thread count.
+     * @throws std::invalid_argument if @p marketData is null or the
+     *         confidence level is outside (0.5, 1).
+     */
+    explicit CalculationEngine(std::shared_ptr<InMemoryMarketDataService> marketData,
+                               CalculationConfig                          config = {});
+
+    /// Removes the tick listener from the market data service.
+    ~CalculationEngine() override;
+
+    CalculationEngine(const CalculationEngine&)            = delete;
+    CalculationEngine& operator=(const CalculationEngine&) = delete;
+
+    /// @copydoc ICalculationService::calculate
+    Response calculate(const Request& request) override;
+
+    /**
+     * @brief Replace the VaR scenario matrix.
+     * @param symbols Column symbols; interned into the market data cache.
+     * @param returns Row-major [scenario][column] relative returns.
+     * @throws std::invalid_argument if @p returns is not a whole number of rows.
+     * @throws std::length_error if the symbol capacity is exhausted.
+     *
+     * Safe to call while requests are running; they finish on the old set.
+     */
+    void setScenarios(const std::vector<std::string>& symbols, std::vector<double> returns);
+
+    /// @brief Rows of the current scenario matrix.
+    std::size_t scenarioCount() const;
+
+    /// @brief Books currently kept resident by incremental mode.
+    std::size_t residentBookCount() const;
+
+    /// @brief CALCULATE requests served by a resident book, and those that loaded one.
+    struct ResidentBookStats
+    {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    /// @brief Resident book hit and miss counts; reads no lock.
+    ResidentBookStats residentBookStats() const;
+
+    /**
+     * @brief Copy out the loaded resident books, most recently used first.
+     * @param positions Receives the positions of every book, concatenated.
+     * @param bookSizes Receives the position count of each book.
+     */
+    void exportResidentBooks(std::vector<PositionPOD>& positions, std::vector<std::size_t>& bookSizes) const;
+
+    /**
+     * @brief Make the books of exportResidentBooks() resident again, in the
+     *        same order, marked at the current market data.
+     * @details Books beyond CalculationConfig::residentBooks are dropped,
+     *          least recently used first.
+     * @throws std::invalid_argument if @p bookSizes add up to more than
+     *         @p positions holds.
+     */
+    void restoreResidentBooks(const PodArrayView<PositionPOD>& positions, const std::vector<std::size_t>& bookSizes);
+
+private:
+    struct ScenarioSet
+    {
+        std::vector<int32_t> columnOf; ///< Column per SymbolId, -1 if not modelled.
+        std::size_t          columns{0};
+        std::size_t          rows{0};
+        std::vector<double>  returns;
+    };
+
+    /// A book kept current between requests; guarded by its own mutex.
+    struct ResidentBook
+    {
+        std::mutex      mutex;
+        uint64_t        fingerprint{0};
+        std::size_t     positionCount{0};
+        IncrementalBook book;
+
+        /// VaR of the book as of varVersion under varScenarios.
+        std::shared_ptr<const ScenarioSet> varScenarios;
+        uint64_t                           varVersion{0};
+        RiskSummaryPOD                     var{};
+    };
+
+    std::shared_ptr<const ScenarioSet> scenarios() const;
+
+    Response calculateFull(const PodArrayView<PositionPOD>& positions);
+    Response calculateResident(const PodArrayView<PositionPOD>& positions);
+
+    /// Resident book for @p positions, loading a new one if needed.
+    std::shared_ptr<ResidentBook> residentBook(const PodArrayView<PositionPOD>& positions);
+
+    void onTick(SymbolId id, const MarketDataPOD& snapshot);
+
+    /// Fill the VaR fields of @p summary; @p exposure is indexed by column.
+    void computeVar(const ScenarioSet& set, const std::vector<double>& exposure, RiskSummaryPOD& summary);
+
+    std::shared_ptr<InMemoryMarketDataService> m_marketData;
+    CalculationConfig                          m_config;
+    double                                     m_z; ///< Standard normal quantile of the confidence.
+    ForkJoinPool                               m_pool;
+
+    mutable std::mutex                 m_scenarioMutex;
+    std::shared_ptr<const ScenarioSet> m_scenarios;
+
+    InMemoryMarketDataService::ListenerId m_listenerId{0};
+
+    /// Resident books, most recently used first.
+    mutable std::mutex                         m_booksMutex;
+    std::vector<std::shared_ptr<ResidentBook>> m_books;
+
+    /// Counted by calculateResident(); read by residentBookStats() without a lock.
+    std::atomic<uint64_t> m_bookHits{0};
+    std::atomic<uint64_t> m_bookMisses{0};
+};
+
+#endif // CALCULATIONENGINE_HPP
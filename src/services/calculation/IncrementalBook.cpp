@@ -0,0 +1,126 @@
+/**
+ * @file IncrementalBook.cpp
+ * @brief Implementation of IncrementalBook.
+ */
+
+#include "IncrementalBook.hpp"
+
+#include <cmath>
+#include <cstring>
+
+void IncrementalBook::load(const PodArrayView<PositionPOD>& positions, InMemoryMarketDataService& marketData)
+{
+    m_positions.resize(positions.size());
+    m_groups.clear();
+    m_groupOf.clear();
+    m_unmarked = 0;
+
+    const auto intern = [&marketData](const SymbolKey& key) { return marketData.intern(key); };
+    for (uint32_t i = 0; i < m_positions.size(); ++i)
+    {
+        PositionRecord& position = m_positions[i];
+        fromWire(positions[i], position, intern);
+        const SymbolId id = position.symbol;
+
+        auto [it, inserted] = m_groupOf.emplace(id, static_cast<uint32_t>(m_groups.size()));
+        if (inserted)
+        {
+            m_groups.emplace_back();
+            m_groups.back().id = id;
+        }
+
+        Group&       group    = m_groups[it->second];
+        const double quantity = static_cast<double>(position.quantity);
+        group.members.push_back(i);
+        group.netQuantity += quantity;
+        group.absQuantity += std::fabs(quantity);
+        group.unmarkedNet += quantity * position.avgPrice;
+    }
+
+    for (Group& group : m_groups)
+    {
+        MarketDataRecord snapshot;
+        if (marketData.cache().load(group.id, snapshot) && snapshot.last > 0.0)
+        {
+            mark(group, snapshot.last);
+            continue;
+        }
+
+        // No price yet: mark at cost.
+        for (const uint32_t i : group.members)
+        {
+            m_positions[i].unrealisedPnl = 0.0;
+            group.gross += std::fabs(static_cast<double>(m_positions[i].quantity) * m_positions[i].avgPrice);
+        }
+        m_unmarked += static_cast<uint32_t>(group.members.size());
+    }
+
+    resync();
+    m_loaded = true;
+}
+
+bool IncrementalBook::applyTick(SymbolId id, double last)
+{
+    const auto it = m_groupOf.find(id);
+    if (it == m_groupOf.end() || !(last > 0.0))
+        return false;
+
+    Group& group = m_groups[it->second];
+    if (group.marked && group.mark == last)
+        return false;
+
+    const double oldPnl   = group.pnl;
+    const double oldGross = group.gross;
+    if (!group.marked)
+        m_unmarked -= static_cast<uint32_t>(group.members.size());
+
+    mark(group, last);
+    m_totalPnl      += group.pnl - oldPnl;
+    m_grossExposure += group.gross - oldGross;
+    ++m_version;
+
+    if (++m_ticksSinceResync >= kResyncTicks)
+        resync();
+    return true;
+}
+
+void IncrementalBook::mark(Group& group, double last)
+{
+    double pnl = 0.0;
+    for (const uint32_t i : group.members)
+    {
+        PositionRecord& position = m_positions[i];
+        position.unrealisedPnl = static_cast<double>(position.quantity) * (last - position.avgPrice);
+        pnl += position.unrealisedPnl;
+    }
+
+    group.mark   = last;
+    group.marked = true;
+    group.pnl    = pnl;
+    group.gross  = group.absQuantity * last;
+}
+
+std::size_t IncrementalBook::writePositions(uint8_t* out, const MarketDataCache& cache) const
+{
+    const auto symbolOf = [&cache](SymbolId id) -> const SymbolKey& { return cache.symbol(id); };
+    for (const PositionRecord& position : m_positions)
+    {
+        PositionPOD wire;
+        toWire(position, wire, symbolOf);
+        std::memcpy(out, &wire, sizeof(wire));
+        out += sizeof(wire);
+    }
+    return m_positions.size() * sizeof(PositionPOD);
+}
+
+void IncrementalBook::resync()
+{
+    m_totalPnl      = 0.0;
+    m_grossExposure = 0.0;
+    for (const Group& group : m_groups)
+    {
+        m_totalPnl      += group.pnl;
+        m_grossExposure += group.gross;
+    }
+    m_ticksSinceResync = 0;
+}
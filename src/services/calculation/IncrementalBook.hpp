@@ -0,0 +1,113 @@
+/**
+ * @file IncrementalBook.hpp
+ * @brief A marked position book kept current tick by tick.
+ *
+ * @details load() groups positions by symbol and marks them once from the
+ * market data cache. After that, applyTick() re-marks only the positions
+ * of the ticked symbol. It recomputes their group's P&L and gross exposure
+ * exactly and moves the book totals by the difference, so a tick costs
+ * O(positions in that symbol) rather than O(book). The totals are re-summed
+ * from the group subtotals every kResyncTicks ticks, so rounding drift in
+ * the running sums cannot build up.
+ *
+ * Positions in a symbol with no price yet are marked at their avgPrice
+ * (zero P&L) until the first tick for that symbol arrives.
+ *
+ * Positions are kept as aligned PositionRecords (40 bytes, symbol as id)
+ * and converted back to PositionPODs only by writePositions().
+ *
+ * Not thread-safe: CalculationEngine serialises access per book.
+ */
+
+#ifndef INCREMENTALBOOK_HPP
+#define INCREMENTALBOOK_HPP
+
+#include "InMemoryMarketDataService.hpp"
+#include "Records.hpp"
+#include "pod/PodView.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class IncrementalBook
+ * @brief Positions, per-symbol groups and running portfolio totals.
+ */
+class IncrementalBook
+{
+public:
+    /// Ticks between exact re-summations of the book totals.
+    static constexpr uint32_t kResyncTicks = 4096;
+
+    /**
+     * @brief Replace the book with @p positions, marked from the cache.
+     * @throws std::length_error if a new symbol exceeds the symbol capacity.
+     */
+    void load(const PodArrayView<PositionPOD>& positions, InMemoryMarketDataService& marketData);
+
+    /// @brief True once load() has completed.
+    bool loaded() const { return m_loaded; }
+
+    /**
+     * @brief Re-mark the positions in @p id at @p last.
+     * @return true if any position moved (the book version advanced).
+     */
+    bool applyTick(SymbolId id, double last);
+
+    /// @brief Positions with unrealisedPnl kept current.
+    const std::vector<PositionRecord>& positions() const { return m_positions; }
+
+    /**
+     * @brief Write positions() to @p out as packed PositionPODs, symbols taken from @p cache.
+     * @return Bytes written: positions().size() × sizeof(PositionPOD).
+     */
+    std::size_t writePositions(uint8_t* out, const MarketDataCache& cache) const;
+
+    double   totalUnrealisedPnl() const { return m_totalPnl; }
+    double   grossExposure() const { return m_grossExposure; }
+    uint32_t unmarkedCount() const { return m_unmarked; }
+
+    /// @brief Incremented by every applyTick() that moved the book.
+    uint64_t version() const { return m_version; }
+
+    /// @brief Call @p fn(SymbolId, netExposure) once per symbol in the book.
+    template <typename Fn>
+    void forEachExposure(Fn&& fn) const
+    {
+        for (const Group& group : m_groups)
+            fn(group.id, group.marked ? group.netQuantity * group.mark : group.unmarkedNet);
+    }
+
+private:
+    struct Group
+    {
+        SymbolId              id{kInvalidSymbolId};
+        std::vector<uint32_t> members;          ///< Indices into m_positions.
+        double                netQuantity{0.0};
+        double                absQuantity{0.0};
+        double                unmarkedNet{0.0}; ///< Σ quantity × avgPrice while unmarked.
+        double                mark{0.0};
+        double                pnl{0.0};
+        double                gross{0.0};
+        bool                  marked{false};
+    };
+
+    /// Re-mark @p group at @p last and refresh its subtotals.
+    void mark(Group& group, double last);
+
+    void resync();
+
+    std::vector<PositionRecord>            m_positions;
+    std::vector<Group>                     m_groups;
+    std::unordered_map<SymbolId, uint32_t> m_groupOf;
+    double                                 m_totalPnl{0.0};
+    double                                 m_grossExposure{0.0};
+    uint32_t                               m_unmarked{0};
+    uint32_t                               m_ticksSinceResync{0};
+    uint64_t                               m_version{0};
+    bool                                   m_loaded{false};
+};
+
+#endif // INCREMENTALBOOK_HPP
@@ -0,0 +1,178 @@
+/**
+ * @file RiskKernels.cpp
+ * @brief Scalar, AVX2 and AVX-512 kernels with one-time runtime dispatch.
+ */
+
+#include "RiskKernels.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#    define HFT_RISK_X86_DISPATCH 1
+#    include <immintrin.h>
+#endif
+
+// ==========================================================================
+// Scalar reference kernels
+// ==========================================================================
+
+double risk::scalar::unrealisedPnl(const double* quantity, const double* avgPrice,
+                                   const double* mark, double* pnl, std::size_t n)
+{
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        pnl[i] = quantity[i] * (mark[i] - avgPrice[i]);
+        total += pnl[i];
+    }
+    return total;
+}
+
+double risk::scalar::dot(const double* a, const double* b, std::size_t n)
+{
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+        total += a[i] * b[i];
+    return total;
+}
+
+#ifdef HFT_RISK_X86_DISPATCH
+
+// ==========================================================================
+// AVX2 + FMA — 4 doubles per lane
+// ==========================================================================
+
+namespace
+{
+    __attribute__((target("avx2,fma")))
+    double horizontalSum(__m256d v)
+    {
+        const __m128d low  = _mm256_castpd256_pd128(v);
+        const __m128d high = _mm256_extractf128_pd(v, 1);
+        const __m128d pair = _mm_add_pd(low, high);
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+
+    __attribute__((target("avx2,fma")))
+    double unrealisedPnlAvx2(const double* quantity, const double* avgPrice, const double* mark,
+                             double* pnl, std::size_t n)
+    {
+        __m256d     acc = _mm256_setzero_pd();
+        std::size_t i   = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(mark + i), _mm256_loadu_pd(avgPrice + i));
+            const __m256d p    = _mm256_mul_pd(_mm256_loadu_pd(quantity + i), diff);
+            _mm256_storeu_pd(pnl + i, p);
+            acc = _mm256_add_pd(acc, p);
+        }
+        double total = horizontalSum(acc);
+        return total + risk::scalar::unrealisedPnl(quantity + i, avgPrice + i, mark + i, pnl + i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    double dotAvx2(const double* a, const double* b, std::size_t n)
+    {
+        // Two accumulators hide the FMA latency.
+        __m256d     acc0 = _mm256_setzero_pd();
+        __m256d     acc1 = _mm256_setzero_pd();
+        std::size_t i    = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+        }
+        for (; i + 4 <= n; i += 4)
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+
+        const double total = horizontalSum(_mm256_add_pd(acc0, acc1));
+        return total + risk::scalar::dot(a + i, b + i, n - i);
+    }
+
+// ==========================================================================
+// AVX-512F — 8 doubles per lane
+// ==========================================================================
+
+    __attribute__((target("avx512f")))
+    double unrealisedPnlAvx512(const double* quantity, const double* avgPrice, const double* mark,
+                               double* pnl, std::size_t n)
+    {
+        __m512d     acc = _mm512_setzero_pd();
+        std::size_t i   = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m512d diff = _mm512_sub_pd(_mm512_loadu_pd(mark + i), _mm512_loadu_pd(avgPrice + i));
+            const __m512d p    = _mm512_mul_pd(_mm512_loadu_pd(quantity + i), diff);
+            _mm512_storeu_pd(pnl + i, p);
+            acc = _mm512_add_pd(acc, p);
+        }
+        const double total = _mm512_reduce_add_pd(acc);
+        return total + risk::scalar::unrealisedPnl(quantity + i, avgPrice + i, mark + i, pnl + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    double dotAvx512(const double* a, const double* b, std::size_t n)
+    {
+        __m512d     acc0 = _mm512_setzero_pd();
+        __m512d     acc1 = _mm512_setzero_pd();
+        std::size_t i    = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+            acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), acc1);
+        }
+        for (; i + 8 <= n; i += 8)
+            acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+
+        const double total = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+        return total + risk::scalar::dot(a + i, b + i, n - i);
+    }
+} // namespace
+
+#endif // HFT_RISK_X86_DISPATCH
+
+// ==========================================================================
+// Dispatch — resolved once, on first use
+// ==========================================================================
+
+namespace
+{
+    struct KernelTable
+    {
+        double (*unrealisedPnl)(const double*, const double*, const double*, double*, std::size_t);
+        double (*dot)(const double*, const double*, std::size_t);
+        const char* isa;
+    };
+
+    KernelTable selectKernels()
+    {
+#ifdef HFT_RISK_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return {unrealisedPnlAvx512, dotAvx512, "avx512f"};
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {unrealisedPnlAvx2, dotAvx2, "avx2"};
+#endif
+        return {risk::scalar::unrealisedPnl, risk::scalar::dot, "scalar"};
+    }
+
+    const KernelTable& kernels()
+    {
+        static const KernelTable table = selectKernels();
+        return table;
+    }
+} // namespace
+
+double risk::unrealisedPnl(const double* quantity, const double* avgPrice, const double* mark,
+                           double* pnl, std::size_t n)
+{
+    return kernels().unrealisedPnl(quantity, avgPrice, mark, pnl, n);
+}
+
+double risk::dot(const double* a, const double* b, std::size_t n)
+{
+    return kernels().dot(a, b, n);
+}
+
+const char* risk::activeIsa()
+{
+    return kernels().isa;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file RiskKernels.hpp
+ * @brief SIMD inner loops of the calculation engine over structure-of-arrays data.
+ *
+ * @details Each kernel has a scalar version and, on x86-64 builds with GCC
+ * or Clang, AVX2+FMA and AVX-512F versions compiled with per-function
+ * target attributes. The widest version the CPU supports is chosen once at
+ * first use through __builtin_cpu_supports(), so one binary runs on any
+ * x86-64 host without -march flags. Vector versions accumulate in several
+ * lanes, so results can differ from the scalar sum in the last bits.
+ */
+
+#ifndef RISKKERNELS_HPP
+#define RISKKERNELS_HPP
+
+#include <cstddef>
+
+namespace risk
+{
+    /**
+     * @brief pnl[i] = quantity[i] × (mark[i] − avgPrice[i]) for i < n.
+     * @return The sum of pnl[0..n).
+     */
+    double unrealisedPnl(const double* quantity, const double* avgPrice, const double* mark,
+                         double* pnl, std::size_t n);
+
+    /// @brief Σ a[i] × b[i] for i < n.
+    double dot(const double* a, const double* b, std::size_t n);
+
+    /// @brief Instruction set of the selected kernels: "avx512f", "avx2" or "scalar".
+    const char* activeIsa();
+
+    /// Portable reference versions, always available (used by tests).
+    namespace scalar
+    {
+        double unrealisedPnl(const double* quantity, const double* avgPrice, const double* mark,
+                             double* pnl, std::size_t n);
+        double dot(const double* a, const double* b, std::size_t n);
+    } // namespace scalar
+} // namespace risk
+
+#endif // RISKKERNELS_HPP
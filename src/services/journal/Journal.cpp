@@ -0,0 +1,447 @@
+/**
+ * @file Journal.cpp
+ * @brief Implementation of Journal and JournalDay.
+ */
+
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr const char* kSuffix = ".jnl";
+
+    std::size_t pageSize()
+    {
+        static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    std::size_t fileBytes(uint64_t capacity, uint32_t recordSize)
+    {
+        return sizeof(JournalFileHeader) + static_cast<std::size_t>(capacity) * recordSize;
+    }
+
+    std::runtime_error journalError(const std::string& what, const std::string& path, int error)
+    {
+        return std::runtime_error("[Journal] " + what + " " + path + ": " + std::strerror(error));
+    }
+
+    /// Empty if @p header describes records of this schema; otherwise why not.
+    std::string checkHeader(const JournalFileHeader& header, uint16_t schemaId, uint16_t version,
+                            uint32_t recordSize)
+    {
+        if (std::memcmp(header.magic, JournalFileHeader::kMagic, sizeof(header.magic)) != 0)
+            return "not a journal segment";
+        if (header.schemaId != schemaId || header.version != version || header.recordSize != recordSize)
+            return "segment holds a different record schema";
+        if (header.committed > header.capacity)
+            return "segment header is corrupt";
+        return {};
+    }
+} // namespace
+
+/// A shared read-write mapping of a whole segment file.
+struct Journal::Mapping
+{
+    void*       base{nullptr};
+    std::size_t bytes{0};
+
+    ~Mapping()
+    {
+        if (base)
+            ::munmap(base, bytes);
+    }
+
+    JournalFileHeader* header() const { return static_cast<JournalFileHeader*>(base); }
+    uint8_t*           records() const { return static_cast<uint8_t*>(base) + sizeof(JournalFileHeader); }
+};
+
+/// Writer state of one day's segment. Fields are guarded by Journal::m_mutex.
+struct Journal::Segment
+{
+    TradingDate              day;
+    std::string              path;
+    int                      fd{-1};
+    uint64_t                 capacity{0};
+    uint64_t                 count{0};  ///< Records appended.
+    uint64_t                 synced{0}; ///< Records committed by the flusher.
+    std::shared_ptr<Mapping> map;       ///< Replaced when the file grows.
+
+    ~Segment()
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+};
+
+// ==========================================================================
+// JournalDay — read side
+// ==========================================================================
+
+std::shared_ptr<const JournalDay> JournalDay::open(const JournalConfig& config, TradingDate day, uint16_t schemaId,
+                                                   uint16_t version, uint32_t recordSize)
+{
+    const std::string path = Journal::segmentPath(config, day);
+    const int         fd   = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+            return nullptr;
+        throw journalError("cannot open", path, errno);
+    }
+
+    struct stat       status {};
+    JournalFileHeader header{};
+    if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(header)
+        || ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+    {
+        ::close(fd);
+        throw std::runtime_error("[Journal] truncated segment " + path);
+    }
+    const std::string problem = checkHeader(header, schemaId, version, recordSize);
+    if (!problem.empty())
+    {
+        ::close(fd);
+        throw std::runtime_error("[Journal] " + problem + ": " + path);
+    }
+
+    const std::size_t bytes = std::min(fileBytes(header.capacity, recordSize), static_cast<std::size_t>(status.st_size));
+    void*             base  = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    const int         error = errno;
+    ::close(fd); // the mapping keeps the file referenced
+    if (base == MAP_FAILED)
+        throw journalError("cannot map", path, error);
+
+    std::shared_ptr<JournalDay> view(new JournalDay());
+    view->m_base    = base;
+    view->m_bytes   = bytes;
+    view->m_records = static_cast<const uint8_t*>(base) + sizeof(JournalFileHeader);
+    view->m_day     = day;
+
+    // The writer's flusher advances committed concurrently; take one reading.
+    const uint64_t committed = __atomic_load_n(&static_cast<const JournalFileHeader*>(base)->committed,
+                                               __ATOMIC_ACQUIRE);
+    view->m_count = static_cast<std::size_t>(
+        std::min<uint64_t>(committed, (bytes - sizeof(JournalFileHeader)) / recordSize));
+    return view;
+}
+
+JournalDay::~JournalDay()
+{
+    if (m_base)
+        ::munmap(m_base, m_bytes);
+}
+
+// ==========================================================================
+// Journal — construction and file naming
+// ==========================================================================
+
+Journal::Journal(JournalConfig config, uint16_t schemaId, uint16_t version, uint32_t recordSize)
+    : m_config(std::move(config))
+    , m_schemaId(schemaId)
+    , m_version(version)
+    , m_recordSize(recordSize)
+{
+    if (m_recordSize == 0)
+        throw std::invalid_argument("[Journal] record size must be positive");
+    m_config.initialRecords = std::max<std::size_t>(m_config.initialRecords, 1);
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_config.directory, ec);
+    if (ec)
+        throw std::runtime_error("[Journal] cannot create directory " + m_config.directory + ": " + ec.message());
+
+    m_flusher = std::thread([this]() { flusherLoop(); });
+}
+
+Journal::~Journal()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_flushCv.notify_one();
+    m_flusher.join();
+}
+
+std::string Journal::segmentPath(const JournalConfig& config, TradingDate day)
+{
+    return config.directory + "/" + config.name + "-" + day.toIso() + kSuffix;
+}
+
+std::vector<TradingDate> Journal::days(const JournalConfig& config)
+{
+    std::vector<TradingDate> result;
+    std::error_code          ec;
+    const std::string        prefix = config.name + "-";
+    for (const auto& entry : std::filesystem::directory_iterator(config.directory, ec))
+    {
+        const std::string file = entry.path().filename().string();
+        if (file.size() != prefix.size() + TradingDate::kIsoLength + std::strlen(kSuffix)
+            || file.compare(0, prefix.size(), prefix) != 0
+            || file.compare(file.size() - std::strlen(kSuffix), std::string::npos, kSuffix) != 0)
+            continue;
+
+        TradingDate day;
+        if (TradingDate::parseIso(std::string_view(file).substr(prefix.size(), TradingDate::kIsoLength), day))
+            result.push_back(day);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// ==========================================================================
+// Appending
+// ==========================================================================
+
+void Journal::append(TradingDate day, const void* records, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_active || m_active->day != day)
+        openSegmentLocked(day);
+    if (m_active->count + count > m_active->capacity)
+        growLocked(count);
+
+    const std::size_t bytes = count * m_recordSize;
+    std::memcpy(m_active->map->records() + m_active->count * m_recordSize, records, bytes);
+    m_active->count += count;
+    m_appended += count;
+
+    // Wake the flusher once per batch; it then waits out the commit window.
+    const bool first = m_pendingBytes == 0;
+    m_pendingBytes += bytes;
+    const bool wake = first || m_pendingBytes >= m_config.flushBytes;
+    lock.unlock();
+    if (wake)
+        m_flushCv.notify_one();
+}
+
+void Journal::openSegmentLocked(TradingDate day)
+{
+    if (m_active && m_active->synced < m_active->count)
+        m_sealed.push_back(m_active);
+    m_active.reset();
+
+    // A day still being completed by the flusher is continued, not reopened.
+    const auto sealed = std::find_if(m_sealed.begin(), m_sealed.end(),
+                                     [day](const std::shared_ptr<Segment>& s) { return s->day == day; });
+    if (sealed != m_sealed.end())
+    {
+        m_active = *sealed;
+        m_sealed.erase(sealed);
+        return;
+    }
+
+    auto segment  = std::make_shared<Segment>();
+    segment->day  = day;
+    segment->path = segmentPath(m_config, day);
+    segment->fd   = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (segment->fd < 0)
+        throw journalError("cannot open", segment->path, errno);
+
+    struct stat status {};
+    if (::fstat(segment->fd, &status) != 0)
+        throw journalError("cannot stat", segment->path, errno);
+
+    JournalFileHeader header{};
+    if (status.st_size == 0)
+    {
+        std::memcpy(header.magic, JournalFileHeader::kMagic, sizeof(header.magic));
+        header.schemaId   = m_schemaId;
+        header.version    = m_version;
+        header.recordSize = m_recordSize;
+        header.day        = day.days;
+        header.capacity   = m_config.initialRecords;
+        const int error   = ::posix_fallocate(segment->fd, 0, static_cast<off_t>(fileBytes(header.capacity, m_recordSize)));
+        if (error != 0)
+            throw journalError("cannot preallocate", segment->path, error);
+        if (::pwrite(segment->fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+            throw journalError("cannot write", segment->path, errno);
+    }
+    else
+    {
+        // Reopened after a restart: continue after the last committed record.
+        if (::pread(segment->fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+            throw std::runtime_error("[Journal] truncated segment " + segment->path);
+        const std::string problem = checkHeader(header, m_schemaId, m_version, m_recordSize);
+        if (!problem.empty())
+            throw std::runtime_error("[Journal] " + problem + ": " + segment->path);
+        if (static_cast<std::size_t>(status.st_size) < fileBytes(header.capacity, m_recordSize))
+            throw std::runtime_error("[Journal] truncated segment " + segment->path);
+    }
+
+    segment->capacity = header.capacity;
+    segment->count    = header.committed;
+    segment->synced   = header.committed;
+
+    auto map   = std::make_shared<Mapping>();
+    map->bytes = fileBytes(segment->capacity, m_recordSize);
+    map->base  = ::mmap(nullptr, map->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (map->base == MAP_FAILED)
+    {
+        map->base = nullptr;
+        throw journalError("cannot map", segment->path, errno);
+    }
+    segment->map = std::move(map);
+    m_active     = std::move(segment);
+}
+
+void Journal::growLocked(std::size_t needed)
+{
+    Segment&       segment  = *m_active;
+    const uint64_t capacity = std::max<uint64_t>(segment.capacity * 2, segment.count + needed);
+
+    const int error = ::posix_fallocate(segment.fd, 0, static_cast<off_t>(fileBytes(capacity, m_recordSize)));
+    if (error != 0)
+        throw journalError("cannot grow", segment.path, error);
+
+    // A new mapping of the larger file; the flusher may still hold the old one.
+    auto map   = std::make_shared<Mapping>();
+    map->bytes = fileBytes(capacity, m_recordSize);
+    map->base  = ::mmap(nullptr, map->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+    if (map->base == MAP_FAILED)
+    {
+        map->base = nullptr;
+        throw journalError("cannot map", segment.path, errno);
+    }
+    map->header()->capacity = capacity;
+    segment.capacity        = capacity;
+    segment.map             = std::move(map);
+}
+
+// ==========================================================================
+// Group commit
+// ==========================================================================
+
+bool Journal::sync()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const uint64_t               target   = m_appended;
+    const uint64_t               failures = m_syncFailures;
+    if (m_durable >= target)
+        return true;
+    m_flushRequested = true;
+    m_flushCv.notify_one();
+    m_durableCv.wait(lock, [&]() { return m_durable >= target || m_syncFailures != failures; });
+    return m_durable >= target;
+}
+
+bool Journal::flush(std::unique_lock<std::mutex>& lock)
+{
+    struct Work
+    {
+        std::shared_ptr<Segment> segment;
+        std::shared_ptr<Mapping> map;
+        uint64_t                 from;
+        uint64_t                 to;
+        bool                     ok;
+    };
+
+    std::vector<Work> work;
+    for (const auto& segment : m_sealed)
+        work.push_back(Work{segment, segment->map, segment->synced, segment->count, true});
+    if (m_active && m_active->synced < m_active->count)
+        work.push_back(Work{m_active, m_active->map, m_active->synced, m_active->count, true});
+    const uint64_t target = m_appended;
+    m_pendingBytes        = 0;
+    m_flushRequested      = false;
+
+    lock.unlock();
+    const std::size_t page = pageSize();
+    for (Work& w : work)
+    {
+        // Records first, then the committed count that makes them visible.
+        const std::size_t begin = sizeof(JournalFileHeader) + static_cast<std::size_t>(w.from) * m_recordSize;
+        const std::size_t end   = sizeof(JournalFileHeader) + static_cast<std::size_t>(w.to) * m_recordSize;
+        const std::size_t start = begin / page * page;
+        auto*             base  = static_cast<uint8_t*>(w.map->base);
+        w.ok = ::msync(base + start, end - start, MS_SYNC) == 0;
+        if (w.ok)
+        {
+            __atomic_store_n(&w.map->header()->committed, w.to, __ATOMIC_RELEASE);
+            w.ok = ::msync(base, sizeof(JournalFileHeader), MS_SYNC) == 0;
+        }
+    }
+    lock.lock();
+
+    bool ok = true;
+    for (const Work& w : work)
+    {
+        if (w.ok)
+            w.segment->synced = std::max(w.segment->synced, w.to);
+        else
+        {
+            ++m_syncFailures;
+            ok = false;
+        }
+    }
+    m_sealed.erase(std::remove_if(m_sealed.begin(), m_sealed.end(),
+                                  [](const std::shared_ptr<Segment>& s) { return s->synced >= s->count; }),
+                   m_sealed.end());
+    if (ok)
+        m_durable = std::max(m_durable, target);
+    m_durableCv.notify_all();
+    return ok;
+}
+
+void Journal::flusherLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        const auto due = [&]() { return m_stop || m_flushRequested || m_pendingBytes >= m_config.flushBytes; };
+        if (m_config.flushInterval.count() > 0)
+        {
+            // Idle until the first record of a batch arrives, then let the
+            // batch grow for one commit window unless asked sooner.
+            m_flushCv.wait(lock, [&]() { return due() || m_pendingBytes > 0 || !m_sealed.empty(); });
+            m_flushCv.wait_for(lock, m_config.flushInterval, due);
+        }
+        else
+            m_flushCv.wait(lock, due);
+
+        const bool stop = m_stop;
+        if (!flush(lock) && !stop)
+        {
+            // Retry failed segments on the next pass rather than spinning.
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            lock.lock();
+        }
+        if (stop)
+            return;
+    }
+}
+
+uint64_t Journal::appendedRecords() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_appended;
+}
+
+uint64_t Journal::durableRecords() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_durable;
+}
+
+uint64_t Journal::syncFailures() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_syncFailures;
+}
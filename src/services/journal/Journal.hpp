@@ -0,0 +1,205 @@
+/**
+ * @file Journal.hpp
+ * @brief Append-only journal of fixed-size records in memory-mapped day segments.
+ *
+ * @details Each trading day has one segment file in the journal directory,
+ * `<name>-YYYY-MM-DD.jnl`, so the file name is the day index. A segment is a
+ * JournalFileHeader followed by packed records exactly as they are in
+ * memory. The file is preallocated and mapped shared. append() copies the
+ * records into the mapping under a short lock and returns. It makes no
+ * system call unless it has to roll to a new day or grow the file.
+ *
+ * Durability is a group commit. A flusher thread msyncs everything appended
+ * since its last pass, then advances the header's committed count and
+ * msyncs the header. It runs every JournalConfig::flushInterval, as soon as
+ * flushBytes are pending, or when a caller blocks in sync(). Records past
+ * the committed count are ignored when a segment is reopened, so a crash
+ * loses at most the last unsynced batch and never leaves a torn record
+ * visible.
+ *
+ * Readers map a day with JournalDay::open() and scan the records in place.
+ * Nothing is deserialised, on startup or when a report reads history.
+ */
+
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include "models/TradingDate.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct JournalFileHeader
+ * @brief First bytes of every segment file.
+ */
+struct JournalFileHeader
+{
+    static constexpr char kMagic[8] = {'H', 'F', 'T', 'J', 'R', 'N', 'L', '1'};
+
+    char     magic[8];   ///< kMagic.
+    uint16_t schemaId;   ///< PodSchemaId of the records.
+    uint16_t version;    ///< PodSchema version of the records.
+    uint32_t recordSize; ///< sizeof the record type.
+    int32_t  day;        ///< TradingDate::days of the segment.
+    uint32_t reserved;
+    uint64_t capacity;   ///< Records the file has room for.
+    uint64_t committed;  ///< Records known to be on disk; written by the flusher only.
+    uint8_t  padding[24];
+};
+
+static_assert(sizeof(JournalFileHeader) == 64, "JournalFileHeader layout changed");
+
+/**
+ * @struct JournalConfig
+ * @brief Location and commit policy of a Journal.
+ */
+struct JournalConfig
+{
+    /// @brief Directory of the segment files; created if missing.
+    std::string directory;
+
+    /// @brief File name prefix, e.g. "trades".
+    std::string name;
+
+    /// @brief Records a new segment is preallocated for; it doubles when full.
+    std::size_t initialRecords{64 * 1024};
+
+    /// @brief Longest time an appended record waits for its fsync (0 = only
+    ///        on sync() or flushBytes).
+    std::chrono::milliseconds flushInterval{2};
+
+    /// @brief Pending bytes that start a flush before the interval is up.
+    std::size_t flushBytes{1024 * 1024};
+};
+
+/**
+ * @class JournalDay
+ * @brief Read-only mapping of one day's segment.
+ *
+ * A segment that is still being written can be opened; the view holds the
+ * records committed when it was opened.
+ */
+class JournalDay
+{
+public:
+    /**
+     * @brief Map the segment of @p day, if there is one.
+     * @return Null if the journal has no segment for @p day.
+     * @throws std::runtime_error if the file is not a segment of records
+     *         with this schema, version and size.
+     */
+    static std::shared_ptr<const JournalDay> open(const JournalConfig& config, TradingDate day, uint16_t schemaId,
+                                                  uint16_t version, uint32_t recordSize);
+
+    ~JournalDay();
+
+    JournalDay(const JournalDay&)            = delete;
+    JournalDay& operator=(const JournalDay&) = delete;
+
+    TradingDate    day() const { return m_day; }
+    std::size_t    size() const { return m_count; }
+    const uint8_t* records() const { return m_records; }
+
+private:
+    JournalDay() = default;
+
+    void*          m_base{nullptr};
+    std::size_t    m_bytes{0};
+    const uint8_t* m_records{nullptr};
+    std::size_t    m_count{0};
+    TradingDate    m_day;
+};
+
+/**
+ * @class Journal
+ * @brief Appends records of one fixed size to the segment of their day.
+ *
+ * Thread-safe. Records for one day are stored in append order. Appending to
+ * a different day seals the current segment (the flusher completes it) and
+ * continues that day's segment, so late records are kept too.
+ */
+class Journal
+{
+public:
+    /**
+     * @param config     Directory, name and commit policy.
+     * @param schemaId   PodSchemaId of the records, checked by readers.
+     * @param version    PodSchema version of the records.
+     * @param recordSize Size of one record in bytes.
+     * @throws std::runtime_error if the directory cannot be created.
+     */
+    Journal(JournalConfig config, uint16_t schemaId, uint16_t version, uint32_t recordSize);
+
+    /// Flushes everything appended and stops the flusher.
+    ~Journal();
+
+    Journal(const Journal&)            = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * @brief Append @p count records of @p day.
+     * @throws std::runtime_error if the segment cannot be opened or grown
+     *         (e.g. the disk is full, or an existing file is not a segment
+     *         of these records).
+     */
+    void append(TradingDate day, const void* records, std::size_t count);
+
+    /**
+     * @brief Block until every record appended before the call is on disk.
+     * @return false if an msync failed first; the records stay pending and
+     *         are retried by later passes.
+     */
+    bool sync();
+
+    /// @brief Records appended since construction.
+    uint64_t appendedRecords() const;
+
+    /// @brief Of those, records committed to disk.
+    uint64_t durableRecords() const;
+
+    /// @brief msync failures so far; such records stay uncommitted.
+    uint64_t syncFailures() const;
+
+    /// @brief Days with a segment in @p config's directory, ascending.
+    static std::vector<TradingDate> days(const JournalConfig& config);
+
+    /// @brief Path of the segment of @p day.
+    static std::string segmentPath(const JournalConfig& config, TradingDate day);
+
+private:
+    struct Mapping;
+    struct Segment;
+
+    void openSegmentLocked(TradingDate day);
+    void growLocked(std::size_t needed);
+    bool flush(std::unique_lock<std::mutex>& lock);
+    void flusherLoop();
+
+    JournalConfig m_config;
+    uint16_t      m_schemaId;
+    uint16_t      m_version;
+    uint32_t      m_recordSize;
+
+    mutable std::mutex                    m_mutex;
+    std::condition_variable               m_flushCv;   ///< Wakes the flusher.
+    std::condition_variable               m_durableCv; ///< Wakes sync() callers.
+    std::shared_ptr<Segment>              m_active;
+    std::vector<std::shared_ptr<Segment>> m_sealed;    ///< Earlier segments still to be completed.
+    uint64_t                              m_appended{0};
+    uint64_t                              m_durable{0};
+    uint64_t                              m_syncFailures{0};
+    std::size_t                           m_pendingBytes{0};
+    bool                                  m_flushRequested{false};
+    bool                                  m_stop{false};
+    std::thread                           m_flusher;
+};
+
+#endif // JOURNAL_HPP
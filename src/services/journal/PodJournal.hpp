@@ -0,0 +1,94 @@
+/**
+ * @file PodJournal.hpp
+ * @brief Typed Journal of OrderPODs or TradePODs, partitioned by the record's day.
+ *
+ * @details The day of a record is the UTC day of its timestamp. A batch
+ * spanning midnight is split at the day boundary. Reading a day yields a
+ * PodArrayView over the mapped segment, the same view type the request
+ * decoders hand out, so history can go straight into the services.
+ */
+
+#ifndef PODJOURNAL_HPP
+#define PODJOURNAL_HPP
+
+#include "Journal.hpp"
+#include "pod/PodView.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class PodJournal
+ * @brief Journal<T> with the schema of @p T and day partitioning by timestamp.
+ * @tparam T A packed POD with a PodSchema and an int64_t @c timestamp in
+ *           Unix epoch microseconds.
+ */
+template <typename T>
+class PodJournal
+{
+public:
+    static constexpr int64_t kMicrosPerDay = 86400LL * 1000 * 1000;
+
+    /// A mapped day and the records in it; the view is valid while @c day is held.
+    struct DayView
+    {
+        std::shared_ptr<const JournalDay> day;
+        PodArrayView<T>                   records;
+    };
+
+    /// @copydoc Journal::Journal
+    explicit PodJournal(JournalConfig config)
+        : m_journal(std::move(config), static_cast<uint16_t>(PodSchema<T>::id), PodSchema<T>::version,
+                    static_cast<uint32_t>(sizeof(T)))
+    {}
+
+    /// @brief The UTC day of @p timestamp (microseconds since the epoch).
+    static TradingDate dayOf(int64_t timestamp)
+    {
+        const int64_t day = timestamp >= 0 ? timestamp / kMicrosPerDay : -((-timestamp + kMicrosPerDay - 1) / kMicrosPerDay);
+        return TradingDate{static_cast<int32_t>(day)};
+    }
+
+    /// @brief Append @p count records, each to the segment of its day.
+    void append(const T* records, std::size_t count)
+    {
+        std::size_t first = 0;
+        while (first < count)
+        {
+            const TradingDate day  = dayOf(records[first].timestamp);
+            std::size_t       last = first + 1;
+            while (last < count && dayOf(records[last].timestamp) == day)
+                ++last;
+            m_journal.append(day, records + first, last - first);
+            first = last;
+        }
+    }
+
+    /// @copydoc Journal::sync
+    bool sync() { return m_journal.sync(); }
+
+    Journal&       journal() { return m_journal; }
+    const Journal& journal() const { return m_journal; }
+
+    /**
+     * @brief Map the committed records of @p day.
+     * @return An empty view (null @c day) if the journal has no such day.
+     * @throws std::runtime_error if the segment holds other records.
+     */
+    static DayView openDay(const JournalConfig& config, TradingDate day)
+    {
+        DayView view;
+        view.day = JournalDay::open(config, day, static_cast<uint16_t>(PodSchema<T>::id), PodSchema<T>::version,
+                                    static_cast<uint32_t>(sizeof(T)));
+        if (view.day)
+            view.records = PodArrayView<T>(reinterpret_cast<const T*>(view.day->records()), view.day->size());
+        return view;
+    }
+
+private:
+    Journal m_journal;
+};
+
+#endif // PODJOURNAL_HPP
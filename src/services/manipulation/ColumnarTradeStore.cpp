@@ -0,0 +1,253 @@
+/**
+ * @file ColumnarTradeStore.cpp
+ * @brief Implementation of ColumnarTradeStore.
+ */
+
+#include "ColumnarTradeStore.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    /// Reorder the rows from @p first on so that row first + i becomes old row first + order[i].
+    template <typename T>
+    void permute(std::vector<T>& column, std::size_t first, const std::vector<uint32_t>& order,
+                 std::vector<T>& scratch)
+    {
+        scratch.resize(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            scratch[i] = column[first + order[i]];
+        std::copy(scratch.begin(), scratch.end(), column.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+} // namespace
+
+// ==========================================================================
+// Loading
+// ==========================================================================
+
+void ColumnarTradeStore::append(const TradePOD* trades, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    const std::size_t n = size() + count;
+    m_tradeId.reserve(n);
+    m_orderId.reserve(n);
+    m_symbolCode.reserve(n);
+    m_price.reserve(n);
+    m_quantity.reserve(n);
+    m_side.reserve(n);
+    m_timestamp.reserve(n);
+
+    const std::size_t sorted  = size();
+    bool              inOrder = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const TradePOD& trade = trades[i];
+        if (!m_timestamp.empty() && trade.timestamp < m_timestamp.back())
+            inOrder = false;
+
+        m_tradeId.push_back(trade.tradeId);
+        m_orderId.push_back(trade.orderId);
+        m_symbolCode.push_back(internSymbol(SymbolKey(trade.symbol)));
+        m_price.push_back(trade.price);
+        m_quantity.push_back(trade.quantity);
+        m_side.push_back(trade.side);
+        m_timestamp.push_back(trade.timestamp);
+    }
+
+    if (!inOrder)
+        mergeAppended(sorted);
+}
+
+void ColumnarTradeStore::clear()
+{
+    m_tradeId.clear();
+    m_orderId.clear();
+    m_symbolCode.clear();
+    m_price.clear();
+    m_quantity.clear();
+    m_side.clear();
+    m_timestamp.clear();
+    m_symbols.clear();
+    std::fill(m_symbolSlots.begin(), m_symbolSlots.end(), 0u);
+}
+
+void ColumnarTradeStore::mergeAppended(std::size_t sorted)
+{
+    // Rows before the first one later than the batch's earliest trade stay put.
+    const auto    batch    = m_timestamp.begin() + static_cast<std::ptrdiff_t>(sorted);
+    const int64_t earliest = *std::min_element(batch, m_timestamp.end());
+    const auto    first    = static_cast<std::size_t>(std::upper_bound(m_timestamp.begin(), batch, earliest)
+                                                      - m_timestamp.begin());
+
+    // Row order of [first, size()), relative to first: the batch sorted by
+    // (timestamp, arrival), then merged after the sorted rows it ties with.
+    const int64_t* timestamps = m_timestamp.data() + first;
+    const auto     before     = [timestamps](uint32_t a, uint32_t b) {
+        return timestamps[a] < timestamps[b] || (timestamps[a] == timestamps[b] && a < b);
+    };
+    m_appendOrder.resize(size() - sorted);
+    std::iota(m_appendOrder.begin(), m_appendOrder.end(), static_cast<uint32_t>(sorted - first));
+    std::sort(m_appendOrder.begin(), m_appendOrder.end(), before);
+
+    m_mergeOrder.resize(size() - first);
+    const auto  kept = static_cast<uint32_t>(sorted - first);
+    uint32_t    next = 0;
+    std::size_t out  = 0;
+    for (const uint32_t row : m_appendOrder)
+    {
+        while (next < kept && timestamps[next] <= timestamps[row])
+            m_mergeOrder[out++] = next++;
+        m_mergeOrder[out++] = row;
+    }
+    while (next < kept)
+        m_mergeOrder[out++] = next++;
+
+    permute(m_tradeId, first, m_mergeOrder, m_scratchU64);
+    permute(m_orderId, first, m_mergeOrder, m_scratchU64);
+    permute(m_quantity, first, m_mergeOrder, m_scratchU64);
+    permute(m_symbolCode, first, m_mergeOrder, m_scratchU32);
+    permute(m_price, first, m_mergeOrder, m_scratchF64);
+    permute(m_side, first, m_mergeOrder, m_scratchU8);
+    permute(m_timestamp, first, m_mergeOrder, m_scratchI64);
+}
+
+// ==========================================================================
+// Symbol dictionary
+// ==========================================================================
+
+uint32_t ColumnarTradeStore::findSymbol(const SymbolKey& key) const
+{
+    if (m_symbolSlots.empty())
+        return kNoSymbol;
+
+    const std::size_t mask = m_symbolSlots.size() - 1;
+    for (std::size_t i = key.hash() & mask;; i = (i + 1) & mask)
+    {
+        const uint32_t slot = m_symbolSlots[i];
+        if (slot == 0)
+            return kNoSymbol;
+        if (m_symbols[slot - 1] == key)
+            return slot - 1;
+    }
+}
+
+uint32_t ColumnarTradeStore::internSymbol(const SymbolKey& key)
+{
+    // Keep the load factor at or below one half so probe chains stay short.
+    if ((m_symbols.size() + 1) * 2 > m_symbolSlots.size())
+        rehashSymbols(std::max<std::size_t>(16, m_symbolSlots.size() * 2));
+
+    const std::size_t mask = m_symbolSlots.size() - 1;
+    for (std::size_t i = key.hash() & mask;; i = (i + 1) & mask)
+    {
+        uint32_t& slot = m_symbolSlots[i];
+        if (slot == 0)
+        {
+            m_symbols.push_back(key);
+            slot = static_cast<uint32_t>(m_symbols.size());
+            return slot - 1;
+        }
+        if (m_symbols[slot - 1] == key)
+            return slot - 1;
+    }
+}
+
+void ColumnarTradeStore::rehashSymbols(std::size_t buckets)
+{
+    m_symbolSlots.assign(buckets, 0u);
+    const std::size_t mask = buckets - 1;
+    for (std::size_t code = 0; code < m_symbols.size(); ++code)
+    {
+        std::size_t i = m_symbols[code].hash() & mask;
+        while (m_symbolSlots[i] != 0)
+            i = (i + 1) & mask;
+        m_symbolSlots[i] = static_cast<uint32_t>(code + 1);
+    }
+}
+
+// ==========================================================================
+// Queries
+// ==========================================================================
+
+std::size_t ColumnarTradeStore::select(const TradeFilter& filter, std::vector<uint32_t>& rows) const
+{
+    // Time range: binary search on the sorted timestamp column.
+    const auto        begin = m_timestamp.begin();
+    const std::size_t lo    = static_cast<std::size_t>(
+        std::lower_bound(begin, m_timestamp.end(), filter.fromTimestamp) - begin);
+    const std::size_t hi = static_cast<std::size_t>(
+        std::lower_bound(begin + static_cast<std::ptrdiff_t>(lo), m_timestamp.end(), filter.toTimestamp) - begin);
+
+    rows.resize(hi > lo ? hi - lo : 0);
+    if (rows.empty())
+        return 0;
+
+    const bool bySymbol = filter.symbolCode != TradeFilter::kAnySymbol;
+    const bool bySide   = filter.sideMask == 1 || filter.sideMask == 2;
+    const auto side     = static_cast<uint8_t>(filter.sideMask == 1 ? 0 : 1);
+
+    uint8_t     keep[kBlockRows];
+    std::size_t n = 0;
+    for (std::size_t start = lo; start < hi; start += kBlockRows)
+    {
+        const std::size_t len = std::min(kBlockRows, hi - start);
+        std::fill(keep, keep + len, uint8_t{1});
+
+        // One branch-free pass per active predicate.
+        if (bySymbol)
+        {
+            const uint32_t* codes = m_symbolCode.data() + start;
+            for (std::size_t i = 0; i < len; ++i)
+                keep[i] &= static_cast<uint8_t>(codes[i] == filter.symbolCode);
+        }
+        if (bySide)
+        {
+            const uint8_t* sides = m_side.data() + start;
+            for (std::size_t i = 0; i < len; ++i)
+                keep[i] &= static_cast<uint8_t>(sides[i] == side);
+        }
+        if (filter.minPrice > 0.0)
+        {
+            const double* prices = m_price.data() + start;
+            for (std::size_t i = 0; i < len; ++i)
+                keep[i] &= static_cast<uint8_t>(prices[i] >= filter.minPrice);
+        }
+        if (filter.maxPrice > 0.0)
+        {
+            const double* prices = m_price.data() + start;
+            for (std::size_t i = 0; i < len; ++i)
+                keep[i] &= static_cast<uint8_t>(prices[i] <= filter.maxPrice);
+        }
+        if (filter.minQuantity > 0)
+        {
+            const uint64_t* quantities = m_quantity.data() + start;
+            for (std::size_t i = 0; i < len; ++i)
+                keep[i] &= static_cast<uint8_t>(quantities[i] >= filter.minQuantity);
+        }
+
+        // Compact without branching: always write, advance only on a match.
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            rows[n] = static_cast<uint32_t>(start + i);
+            n += keep[i];
+        }
+    }
+
+    rows.resize(n);
+    return n;
+}
+
+void ColumnarTradeStore::materialise(std::size_t row, TradePOD& out) const
+{
+    out.tradeId = m_tradeId[row];
+    out.orderId = m_orderId[row];
+    std::copy(std::begin(m_symbols[m_symbolCode[row]].bytes), std::end(m_symbols[m_symbolCode[row]].bytes),
+              out.symbol);
+    out.price     = m_price[row];
+    out.quantity  = m_quantity[row];
+    out.side      = m_side[row];
+    out.timestamp = m_timestamp[row];
+}
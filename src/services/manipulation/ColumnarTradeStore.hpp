@@ -0,0 +1,135 @@
+/**
+ * @file ColumnarTradeStore.hpp
+ * @brief Column-per-field trade store with dictionary-encoded symbols.
+ *
+ * @details TradePOD records are split into one contiguous array per field.
+ * Symbols are dictionary-encoded into dense 32-bit codes local to the store,
+ * so a symbol predicate compares integers instead of 32-byte keys. Rows are
+ * kept sorted by timestamp: a time-range predicate becomes two binary
+ * searches that narrow the scan before any other column is read.
+ *
+ * select() evaluates the remaining predicates a block of rows at a time.
+ * Each active predicate makes one branch-free pass over its own column and
+ * ANDs its result into a byte mask, which the compiler turns into SIMD
+ * compares. Predicates left unset cost nothing. The surviving row numbers
+ * are then compacted into a caller-owned vector, so a query allocates
+ * nothing once that vector has grown to the working-set size.
+ *
+ * Not thread-safe: ManipulationEngine guards its resident store with a
+ * shared mutex and gives each worker thread its own scratch store.
+ */
+
+#ifndef COLUMNARTRADESTORE_HPP
+#define COLUMNARTRADESTORE_HPP
+
+#include "SymbolTable.hpp"
+#include "pod/TradingPOD.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @struct TradeFilter
+ * @brief Decoded predicates of a query; defaults select every row.
+ */
+struct TradeFilter
+{
+    static constexpr uint32_t kAnySymbol = 0xFFFFFFFFu;
+
+    uint32_t symbolCode{kAnySymbol}; ///< Store-local symbol code, or kAnySymbol.
+    uint8_t  sideMask{0};            ///< Bit 0 = buys, bit 1 = sells; 0 = both.
+    int64_t  fromTimestamp{std::numeric_limits<int64_t>::min()}; ///< Inclusive.
+    int64_t  toTimestamp{std::numeric_limits<int64_t>::max()};   ///< Exclusive.
+    double   minPrice{0.0};          ///< Inclusive; 0 = unbounded.
+    double   maxPrice{0.0};          ///< Inclusive; 0 = unbounded.
+    uint64_t minQuantity{0};         ///< Inclusive; 0 = unbounded.
+};
+
+/**
+ * @class ColumnarTradeStore
+ * @brief Timestamp-sorted, structure-of-arrays store of fills.
+ */
+class ColumnarTradeStore
+{
+public:
+    /// Returned by findSymbol() for symbols the store has never seen.
+    static constexpr uint32_t kNoSymbol = TradeFilter::kAnySymbol;
+
+    /// Rows evaluated per predicate pass; sized so a block's mask stays in L1.
+    static constexpr std::size_t kBlockRows = 1024;
+
+    /**
+     * @brief Append @p count trades, keeping the rows sorted by timestamp.
+     * @details In-order appends (the usual case for a fill stream) cost
+     *          O(count). Otherwise the batch is sorted and merged into the
+     *          rows from its earliest timestamp on, so a batch slightly
+     *          behind the newest row costs O(count log count) plus the rows
+     *          it overlaps, not a re-sort of the store. Equal timestamps
+     *          keep their arrival order. The merge scratch is kept for the
+     *          next out-of-order batch.
+     */
+    void append(const TradePOD* trades, std::size_t count);
+
+    /// @brief Drop every row and symbol; column capacity is kept for reuse.
+    void clear();
+
+    /// @brief Number of rows.
+    std::size_t size() const { return m_timestamp.size(); }
+
+    /// @brief Number of distinct symbols.
+    std::size_t symbolCount() const { return m_symbols.size(); }
+
+    /// @brief Store-local code of @p key, or kNoSymbol.
+    uint32_t findSymbol(const SymbolKey& key) const;
+
+    /// @brief The symbol behind @p code; @p code must be below symbolCount().
+    const SymbolKey& symbol(uint32_t code) const { return m_symbols[code]; }
+
+    /**
+     * @brief Row numbers matching @p filter, ascending (timestamp order).
+     * @param rows Overwritten with the result; its capacity is reused.
+     * @return rows.size().
+     */
+    std::size_t select(const TradeFilter& filter, std::vector<uint32_t>& rows) const;
+
+    /// @brief Rebuild row @p row as a TradePOD.
+    void materialise(std::size_t row, TradePOD& out) const;
+
+    // ── Column access (row-aligned, timestamp order) ──────────────────────
+    const int64_t*  timestamps() const { return m_timestamp.data(); }
+    const uint32_t* symbolCodes() const { return m_symbolCode.data(); }
+    const double*   prices() const { return m_price.data(); }
+    const uint64_t* quantities() const { return m_quantity.data(); }
+    const uint8_t*  sides() const { return m_side.data(); }
+
+private:
+    uint32_t internSymbol(const SymbolKey& key);
+    void     rehashSymbols(std::size_t buckets);
+    void     mergeAppended(std::size_t sorted);
+
+    // Columns
+    std::vector<uint64_t> m_tradeId;
+    std::vector<uint64_t> m_orderId;
+    std::vector<uint32_t> m_symbolCode;
+    std::vector<double>   m_price;
+    std::vector<uint64_t> m_quantity;
+    std::vector<uint8_t>  m_side;
+    std::vector<int64_t>  m_timestamp;
+
+    // Merge scratch of mergeAppended(), sized to the rows it reorders.
+    std::vector<uint32_t> m_appendOrder;
+    std::vector<uint32_t> m_mergeOrder;
+    std::vector<uint64_t> m_scratchU64;
+    std::vector<uint32_t> m_scratchU32;
+    std::vector<double>   m_scratchF64;
+    std::vector<uint8_t>  m_scratchU8;
+    std::vector<int64_t>  m_scratchI64;
+
+    // Symbol dictionary: code → key, plus an open-addressed key → code+1 index.
+    std::vector<SymbolKey> m_symbols;
+    std::vector<uint32_t>  m_symbolSlots;
+};
+
+#endif // COLUMNARTRADESTORE_HPP
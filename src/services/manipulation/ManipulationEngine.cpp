@@ -0,0 +1,450 @@
+/**
+ * @file ManipulationEngine.cpp
+ * @brief Implementation of ManipulationEngine.
+ */
+
+#include "ManipulationEngine.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// One DAILY_PIVOT bucket.
+    struct PivotGroup
+    {
+        int64_t  day;
+        uint32_t symbolCode;
+        uint8_t  side;
+        uint32_t fills;
+        uint64_t quantity;
+        double   notional;
+    };
+
+    // Per-thread scratch, reused across requests to avoid reallocating.
+    thread_local ColumnarTradeStore      t_requestStore;
+    thread_local TradeAggregates         t_requestAggregates;
+    thread_local std::vector<uint32_t>   t_rows;
+    thread_local std::vector<PivotGroup> t_groups;
+    thread_local std::vector<uint32_t>   t_groupSlots; ///< Open-addressed group index + 1.
+    thread_local std::vector<DaySummary> t_days;
+    thread_local std::vector<OhlcvBar>   t_bars;
+    thread_local std::vector<uint32_t>   t_barEnds; ///< End of each symbol's bars in t_bars.
+
+    /// Translate @p spec into store-local predicates.
+    /// @return false if the spec names a symbol the store has never seen.
+    bool toFilter(const ColumnarTradeStore& store, const ManipulationSpecPOD& spec, TradeFilter& filter)
+    {
+        if (spec.symbol[0] != '\0')
+        {
+            filter.symbolCode = store.findSymbol(SymbolKey(spec.symbol));
+            if (filter.symbolCode == ColumnarTradeStore::kNoSymbol)
+                return false;
+        }
+        filter.sideMask = static_cast<uint8_t>(spec.sideMask & 0x3);
+        if (spec.fromTimestamp != 0)
+            filter.fromTimestamp = spec.fromTimestamp;
+        if (spec.toTimestamp != 0)
+            filter.toTimestamp = spec.toTimestamp;
+        filter.minPrice    = spec.minPrice;
+        filter.maxPrice    = spec.maxPrice;
+        filter.minQuantity = spec.minQuantity;
+        return true;
+    }
+
+    /// A payload of @p count T records; returns the first one.
+    template <typename T>
+    T* allocateRecords(Response& response, std::size_t count)
+    {
+        response.data = PooledBuffer::uninitialized(pod::payloadSize<T>(count));
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<T>::id),
+                                   PodSchema<T>::version,
+                                   static_cast<uint32_t>(count)};
+        std::memcpy(response.data.data(), &header, sizeof(header));
+        return reinterpret_cast<T*>(response.data.data() + sizeof(PayloadHeader));
+    }
+
+    /// Can a pivot with @p spec be answered from daily summaries?
+    bool coversWholeDays(const ManipulationSpecPOD& spec)
+    {
+        return spec.minPrice == 0.0 && spec.maxPrice == 0.0 && spec.minQuantity == 0
+               && spec.fromTimestamp % ManipulationEngine::kMicrosPerDay == 0
+               && spec.toTimestamp % ManipulationEngine::kMicrosPerDay == 0;
+    }
+
+    /// Codes of the symbols a query covers, ordered by symbol.
+    void symbolCodes(const ColumnarTradeStore& store, const TradeFilter& filter, std::vector<uint32_t>& codes)
+    {
+        codes.clear();
+        if (filter.symbolCode != TradeFilter::kAnySymbol)
+        {
+            codes.push_back(filter.symbolCode);
+            return;
+        }
+        for (uint32_t code = 0; code < store.symbolCount(); ++code)
+            codes.push_back(code);
+        std::sort(codes.begin(), codes.end(), [&store](uint32_t a, uint32_t b) {
+            return std::memcmp(store.symbol(a).bytes, store.symbol(b).bytes, SymbolKey::kSize) < 0;
+        });
+    }
+
+    /// Sort @p groups by day, symbol and side and write them as pivot rows.
+    Response pivotRows(const ColumnarTradeStore& store, std::vector<PivotGroup>& groups)
+    {
+        std::sort(groups.begin(), groups.end(), [&store](const PivotGroup& a, const PivotGroup& b) {
+            if (a.day != b.day)
+                return a.day < b.day;
+            if (a.symbolCode != b.symbolCode)
+                return std::memcmp(store.symbol(a.symbolCode).bytes, store.symbol(b.symbolCode).bytes,
+                                   SymbolKey::kSize) < 0;
+            return a.side < b.side;
+        });
+
+        Response  response{true, "OK", {}};
+        TradePOD* out = allocateRecords<TradePOD>(response, groups.size());
+        for (std::size_t g = 0; g < groups.size(); ++g)
+        {
+            const PivotGroup& group = groups[g];
+            TradePOD&         row   = out[g];
+            row.tradeId  = group.fills;
+            row.orderId  = 0;
+            std::memcpy(row.symbol, store.symbol(group.symbolCode).bytes, sizeof(row.symbol));
+            row.price     = group.quantity > 0 ? group.notional / static_cast<double>(group.quantity) : 0.0;
+            row.quantity  = group.quantity;
+            row.side      = group.side;
+            row.timestamp = group.day * ManipulationEngine::kMicrosPerDay;
+        }
+        return response;
+    }
+
+    uint64_t groupHash(int64_t day, uint32_t symbolCode, uint8_t side)
+    {
+        uint64_t h = static_cast<uint64_t>(day) * 0x9E3779B97F4A7C15ull;
+        h ^= (static_cast<uint64_t>(symbolCode) << 1 | side) + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    void rehashGroups(std::size_t buckets)
+    {
+        t_groupSlots.assign(buckets, 0u);
+        const std::size_t mask = buckets - 1;
+        for (std::size_t g = 0; g < t_groups.size(); ++g)
+        {
+            const PivotGroup& group = t_groups[g];
+            std::size_t       i     = groupHash(group.day, group.symbolCode, group.side) & mask;
+            while (t_groupSlots[i] != 0)
+                i = (i + 1) & mask;
+            t_groupSlots[i] = static_cast<uint32_t>(g + 1);
+        }
+    }
+} // namespace
+
+// ==========================================================================
+// IManipulationService
+// ==========================================================================
+
+ManipulationEngine::ManipulationEngine(TradeAggregatesConfig aggregates)
+    : m_aggregatesConfig(aggregates)
+    , m_aggregates(aggregates)
+{}
+
+Response ManipulationEngine::manipulate(const Request& request)
+{
+    return run(request, false);
+}
+
+Response ManipulationEngine::transform(const Request& request)
+{
+    return run(request, true);
+}
+
+Response ManipulationEngine::run(const Request& request, bool transform)
+{
+    const uint8_t*    data = request.payload.data();
+    const std::size_t size = request.payload.size();
+
+    PodArrayView<ManipulationSpecPOD> spec;
+    std::size_t                       consumed = 0;
+    PodDecodeStatus                   status   = pod::bindSection(data, size, spec, consumed);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("ManipulationService: ") + toString(status), {}};
+    if (spec.size() != 1)
+        return Response{false, "ManipulationService: expected exactly one ManipulationSpecPOD", {}};
+
+    const auto op        = static_cast<ManipulationOp>(spec[0].op);
+    const bool supported = transform ? op == ManipulationOp::DAILY_PIVOT || op == ManipulationOp::OHLCV_BARS
+                                     : op == ManipulationOp::FILTER;
+    if (!supported)
+        return Response{false,
+                        "ManipulationService: unsupported operation " + std::to_string(spec[0].op),
+                        {}};
+
+    // Optional trades section; without one the query runs over the day store.
+    PodArrayView<TradePOD> trades;
+    if (consumed < size)
+    {
+        std::size_t tradeBytes = 0;
+        status = pod::bindSection(data + consumed, size - consumed, trades, tradeBytes);
+        if (status == PodDecodeStatus::OK && consumed + tradeBytes != size)
+            status = PodDecodeStatus::TRAILING_BYTES;
+        if (status != PodDecodeStatus::OK)
+            return Response{false, std::string("ManipulationService: ") + toString(status), {}};
+    }
+
+    if (!trades.empty())
+    {
+        ColumnarTradeStore& store = t_requestStore;
+        store.clear();
+        store.append(trades.data(), trades.size());
+        if (op == ManipulationOp::FILTER)
+            return filter(store, spec[0]);
+        if (op == ManipulationOp::DAILY_PIVOT)
+            return dailyPivot(store, spec[0]); // one scan; aggregating first would not save any
+
+        TradeAggregates& aggregates = t_requestAggregates;
+        if (aggregates.config().barMicros != m_aggregatesConfig.barMicros
+            || aggregates.config().barsPerSymbol != m_aggregatesConfig.barsPerSymbol)
+            aggregates = TradeAggregates(m_aggregatesConfig);
+        aggregates.clear();
+        for (const TradePOD& trade : trades)
+            aggregates.record(trade, store.findSymbol(SymbolKey(trade.symbol)));
+        return ohlcvBars(store, aggregates, spec[0]);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    if (op == ManipulationOp::FILTER)
+        return filter(m_store, spec[0]);
+    if (op == ManipulationOp::OHLCV_BARS)
+        return ohlcvBars(m_store, m_aggregates, spec[0]);
+    return coversWholeDays(spec[0]) ? aggregatePivot(m_store, m_aggregates, spec[0]) : dailyPivot(m_store, spec[0]);
+}
+
+// ==========================================================================
+// FILTER — selected rows, materialised in place
+// ==========================================================================
+
+Response ManipulationEngine::filter(const ColumnarTradeStore& store, const ManipulationSpecPOD& spec)
+{
+    std::vector<uint32_t>& rows = t_rows;
+    TradeFilter            predicates;
+    if (!toFilter(store, spec, predicates))
+        rows.clear();
+    else
+        store.select(predicates, rows);
+
+    Response  response{true, "OK", {}};
+    TradePOD* out = allocateRecords<TradePOD>(response, rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        store.materialise(rows[i], out[i]);
+    return response;
+}
+
+// ==========================================================================
+// DAILY_PIVOT — hash aggregation by (day, symbol, side)
+// ==========================================================================
+
+Response ManipulationEngine::dailyPivot(const ColumnarTradeStore& store, const ManipulationSpecPOD& spec)
+{
+    std::vector<uint32_t>& rows = t_rows;
+    TradeFilter            predicates;
+    if (!toFilter(store, spec, predicates))
+        rows.clear();
+    else
+        store.select(predicates, rows);
+
+    std::vector<PivotGroup>& groups = t_groups;
+    groups.clear();
+    rehashGroups(64);
+
+    const int64_t*  timestamps = store.timestamps();
+    const uint32_t* codes      = store.symbolCodes();
+    const uint8_t*  sides      = store.sides();
+    const uint64_t* quantities = store.quantities();
+    const double*   prices     = store.prices();
+
+    for (const uint32_t row : rows)
+    {
+        const int64_t  day  = TradeAggregates::dayOf(timestamps[row]);
+        const uint32_t code = codes[row];
+        const uint8_t  side = sides[row];
+
+        const std::size_t mask = t_groupSlots.size() - 1;
+        std::size_t       i    = groupHash(day, code, side) & mask;
+        for (;; i = (i + 1) & mask)
+        {
+            const uint32_t slot = t_groupSlots[i];
+            if (slot == 0)
+            {
+                groups.push_back(PivotGroup{day, code, side, 0, 0, 0.0});
+                t_groupSlots[i] = static_cast<uint32_t>(groups.size());
+                break;
+            }
+            const PivotGroup& group = groups[slot - 1];
+            if (group.day == day && group.symbolCode == code && group.side == side)
+                break;
+        }
+
+        PivotGroup& group = groups[t_groupSlots[i] - 1];
+        ++group.fills;
+        group.quantity += quantities[row];
+        group.notional += prices[row] * static_cast<double>(quantities[row]);
+
+        // Keep the load factor at or below one half.
+        if (groups.size() * 2 > t_groupSlots.size())
+            rehashGroups(t_groupSlots.size() * 2);
+    }
+
+    return pivotRows(store, groups);
+}
+
+Response ManipulationEngine::aggregatePivot(const ColumnarTradeStore& store, const TradeAggregates& aggregates,
+                                            const ManipulationSpecPOD& spec)
+{
+    std::vector<PivotGroup>& groups = t_groups;
+    groups.clear();
+    TradeFilter predicates;
+    if (!toFilter(store, spec, predicates))
+        return pivotRows(store, groups);
+
+    // coversWholeDays(): the bounds are midnights, so they select whole days.
+    const int64_t fromDay = spec.fromTimestamp != 0 ? spec.fromTimestamp / kMicrosPerDay
+                                                    : std::numeric_limits<int64_t>::min();
+    const int64_t toDay = spec.toTimestamp != 0 ? spec.toTimestamp / kMicrosPerDay
+                                                : std::numeric_limits<int64_t>::max();
+    std::vector<DaySummary>& days = t_days;
+    days.clear();
+    if (predicates.symbolCode != TradeFilter::kAnySymbol)
+        aggregates.days(predicates.symbolCode, fromDay, toDay, days);
+    else
+    {
+        for (uint32_t code = 0; code < store.symbolCount(); ++code)
+            aggregates.days(code, fromDay, toDay, days);
+    }
+
+    for (const DaySummary& summary : days)
+    {
+        for (uint8_t side = 0; side < 2; ++side)
+        {
+            const SideTotals& totals = summary.sides[side];
+            if (totals.fills > 0 && (predicates.sideMask == 0 || (predicates.sideMask & (1u << side))))
+                groups.push_back(PivotGroup{summary.day, summary.symbolCode, side, totals.fills, totals.quantity,
+                                            totals.notional});
+        }
+    }
+    return pivotRows(store, groups);
+}
+
+// ==========================================================================
+// OHLCV_BARS — read from the aggregates
+// ==========================================================================
+
+Response ManipulationEngine::ohlcvBars(const ColumnarTradeStore& store, const TradeAggregates& aggregates,
+                                       const ManipulationSpecPOD& spec)
+{
+    if (spec.sideMask != 0 || spec.minPrice != 0.0 || spec.maxPrice != 0.0 || spec.minQuantity != 0)
+        return Response{false, "ManipulationService: OHLCV_BARS takes only symbol and time predicates", {}};
+
+    std::vector<uint32_t>& codes = t_rows;
+    std::vector<OhlcvBar>& bars  = t_bars;
+    std::vector<uint32_t>& ends  = t_barEnds;
+    bars.clear();
+    ends.clear();
+    TradeFilter predicates;
+    if (toFilter(store, spec, predicates))
+        symbolCodes(store, predicates, codes);
+    else
+        codes.clear();
+    for (const uint32_t code : codes)
+    {
+        aggregates.bars(code, predicates.fromTimestamp, predicates.toTimestamp, bars);
+        ends.push_back(static_cast<uint32_t>(bars.size()));
+    }
+
+    Response      response{true, "OK", {}};
+    BarPOD*       out      = allocateRecords<BarPOD>(response, bars.size());
+    const int64_t interval = aggregates.config().barMicros;
+    std::size_t   b        = 0;
+    for (std::size_t c = 0; c < codes.size(); ++c)
+    {
+        for (; b < ends[c]; ++b)
+        {
+            const OhlcvBar& bar = bars[b];
+            BarPOD&         row = out[b];
+            std::memcpy(row.symbol, store.symbol(codes[c]).bytes, sizeof(row.symbol));
+            row.start          = bar.start;
+            row.intervalMicros = interval;
+            row.open           = bar.open;
+            row.high           = bar.high;
+            row.low            = bar.low;
+            row.close          = bar.close;
+            row.vwap           = bar.vwap();
+            row.volume         = bar.volume;
+            row.fills          = bar.fills;
+        }
+    }
+    return response;
+}
+
+// ==========================================================================
+// Resident day store
+// ==========================================================================
+
+void ManipulationEngine::recordTrades(const TradePOD* trades, std::size_t count)
+{
+    std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+    m_store.append(trades, count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_aggregates.record(trades[i], m_store.findSymbol(SymbolKey(trades[i].symbol)));
+}
+
+void ManipulationEngine::clearTrades()
+{
+    std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+    m_store.clear();
+    m_aggregates.clear();
+}
+
+std::size_t ManipulationEngine::tradeCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    return m_store.size();
+}
+
+std::vector<TradePOD> ManipulationEngine::trades() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    std::vector<TradePOD>               out(m_store.size());
+    for (std::size_t row = 0; row < out.size(); ++row)
+        m_store.materialise(row, out[row]);
+    return out;
+}
+
+std::vector<SymbolDaySummary> ManipulationEngine::daySummaries(int64_t day) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    std::vector<uint32_t>               codes;
+    symbolCodes(m_store, TradeFilter{}, codes);
+
+    std::vector<SymbolDaySummary> out;
+    std::vector<DaySummary>       summaries;
+    for (const uint32_t code : codes)
+    {
+        summaries.clear();
+        m_aggregates.days(code, day, day + 1, summaries);
+        for (const DaySummary& summary : summaries)
+            out.push_back(SymbolDaySummary{m_store.symbol(code), summary});
+    }
+    return out;
+}
+
+uint64_t ManipulationEngine::lateTrades() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    return m_aggregates.lateTrades();
+}
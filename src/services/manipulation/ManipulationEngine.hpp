@@ -0,0 +1,113 @@
+/**
+ * @file ManipulationEngine.hpp
+ * @brief IManipulationService filtering and pivoting trades in a column store.
+ *
+ * @details A MANIPULATE request names an operation and its predicates in a
+ * ManipulationSpecPOD. The trades it runs over are either carried in the
+ * request or, when the request carries none, the engine's resident day
+ * store, which the fill stream feeds through recordTrades().
+ *
+ * Predicates are pushed down into ColumnarTradeStore::select(). The time
+ * range narrows the scan by binary search, an unknown symbol ends the query
+ * before any row is read, and the rest are evaluated column by column over
+ * blocks of rows. Matching rows are written straight into the response
+ * buffer as packed TradePODs. The row and group scratch belongs to the
+ * worker thread and is reused, so a query makes no per-row allocation.
+ *
+ * ### MANIPULATE
+ *   Request payload : PayloadHeader + 1 × ManipulationSpecPOD
+ *                     [PayloadHeader + N × TradePOD]   (optional)
+ *   Response data   : PayloadHeader + M × TradePOD
+ *
+ * FILTER (manipulate()) returns the matching trades in timestamp order.
+ * DAILY_PIVOT (transform()) hash-aggregates them by UTC day, symbol and
+ * side. Each group becomes one TradePOD: the timestamp is the day's
+ * midnight, price the VWAP, quantity the total, tradeId the fill count and
+ * orderId 0. Rows are ordered by day, symbol and side (buys first).
+ *
+ * OHLCV_BARS (transform()) returns BarPODs, ordered by symbol and start:
+ *   Response data   : PayloadHeader + M × BarPOD
+ * It takes only the symbol and time predicates; the time range selects
+ * bars by their start.
+ *
+ * recordTrades() also keeps TradeAggregates of the resident store: one
+ * ring of OHLCV bars and one summary per UTC day for every symbol. Bars
+ * are always read from them. A pivot of the resident store is too, when it
+ * has no price or quantity predicate and its time bounds fall on
+ * midnights: it then costs O(symbols × days) instead of a scan of the day's
+ * trades. Trades carried in a request have no aggregates; their bars are
+ * built per request.
+ */
+
+#ifndef MANIPULATIONENGINE_HPP
+#define MANIPULATIONENGINE_HPP
+
+#include "ColumnarTradeStore.hpp"
+#include "TradeAggregates.hpp"
+#include "services/IManipulationService.hpp"
+
+#include <cstddef>
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * @class ManipulationEngine
+ * @brief Columnar trade filtering and daily pivots.
+ */
+class ManipulationEngine : public IManipulationService
+{
+public:
+    /// Microseconds per UTC day, the DAILY_PIVOT bucket width.
+    static constexpr int64_t kMicrosPerDay = 86400LL * 1000 * 1000;
+
+    /**
+     * @param aggregates Bar width and depth of the resident aggregates.
+     * @throws std::invalid_argument if the bar width or depth is 0.
+     */
+    explicit ManipulationEngine(TradeAggregatesConfig aggregates = {});
+
+    /// @brief FILTER over the request's trades or the resident store.
+    Response manipulate(const Request& request) override;
+
+    /// @brief DAILY_PIVOT or OHLCV_BARS over the request's trades or the resident store.
+    Response transform(const Request& request) override;
+
+    /**
+     * @brief Append fills to the resident day store.
+     * @details Safe to call while requests are running; queries see the
+     *          store either before or after the whole batch.
+     */
+    void recordTrades(const TradePOD* trades, std::size_t count);
+
+    /// @brief Drop the resident store, e.g. at the start of a trading day.
+    void clearTrades();
+
+    /// @brief Rows in the resident store.
+    std::size_t tradeCount() const;
+
+    /// @brief The resident store as TradePODs in timestamp order, e.g. for a snapshot.
+    std::vector<TradePOD> trades() const;
+
+    /// @brief Every symbol's summary of UTC day @p day (TradingDate::days), ordered by symbol.
+    std::vector<SymbolDaySummary> daySummaries(int64_t day) const;
+
+    /// @brief Resident trades too old for their symbol's bar ring.
+    uint64_t lateTrades() const;
+
+private:
+    Response run(const Request& request, bool transform);
+
+    static Response filter(const ColumnarTradeStore& store, const ManipulationSpecPOD& spec);
+    static Response dailyPivot(const ColumnarTradeStore& store, const ManipulationSpecPOD& spec);
+    static Response aggregatePivot(const ColumnarTradeStore& store, const TradeAggregates& aggregates,
+                                   const ManipulationSpecPOD& spec);
+    static Response ohlcvBars(const ColumnarTradeStore& store, const TradeAggregates& aggregates,
+                              const ManipulationSpecPOD& spec);
+
+    TradeAggregatesConfig     m_aggregatesConfig;
+    mutable std::shared_mutex m_storeMutex;
+    ColumnarTradeStore        m_store;
+    TradeAggregates           m_aggregates;
+};
+
+#endif // MANIPULATIONENGINE_HPP
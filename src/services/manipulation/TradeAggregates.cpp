@@ -0,0 +1,164 @@
+/**
+ * @file TradeAggregates.cpp
+ * @brief Implementation of TradeAggregates.
+ */
+
+#include "TradeAggregates.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int64_t kMicrosPerDay = 86400LL * 1000 * 1000;
+
+    /// Division rounding towards negative infinity, for timestamps before 1970.
+    int64_t floorDiv(int64_t value, int64_t divisor)
+    {
+        const int64_t quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    std::size_t ringSlot(int64_t interval, std::size_t depth)
+    {
+        const int64_t slot = interval % static_cast<int64_t>(depth);
+        return static_cast<std::size_t>(slot < 0 ? slot + static_cast<int64_t>(depth) : slot);
+    }
+} // namespace
+
+TradeAggregates::TradeAggregates(TradeAggregatesConfig config)
+    : m_config(config)
+{
+    if (m_config.barMicros <= 0 || m_config.barsPerSymbol == 0)
+        throw std::invalid_argument("[TradeAggregates] barMicros and barsPerSymbol must be positive");
+}
+
+int64_t TradeAggregates::dayOf(int64_t timestamp)
+{
+    return floorDiv(timestamp, kMicrosPerDay);
+}
+
+// ==========================================================================
+// Ingest
+// ==========================================================================
+
+void TradeAggregates::record(const TradePOD& trade, uint32_t symbolCode)
+{
+    if (symbolCode >= m_symbols.size())
+        m_symbols.resize(static_cast<std::size_t>(symbolCode) + 1);
+    SymbolAggregates& symbol = m_symbols[symbolCode];
+
+    DaySummary& summary = dayFor(symbol, dayOf(trade.timestamp), symbolCode);
+    add(summary.ohlcv, trade);
+    SideTotals& side = summary.sides[trade.side == 0 ? 0 : 1];
+    ++side.fills;
+    side.quantity += trade.quantity;
+    side.notional += trade.price * static_cast<double>(trade.quantity);
+
+    const int64_t depth    = static_cast<int64_t>(m_config.barsPerSymbol);
+    const int64_t interval = floorDiv(trade.timestamp, m_config.barMicros);
+    if (symbol.ring.empty())
+        symbol.ring.resize(m_config.barsPerSymbol);
+    else if (interval <= symbol.latest - depth)
+    {
+        ++m_lateTrades; // its bar has already been overwritten
+        return;
+    }
+
+    OhlcvBar&     bar   = symbol.ring[ringSlot(interval, m_config.barsPerSymbol)];
+    const int64_t start = interval * m_config.barMicros;
+    if (bar.fills == 0 || bar.start != start)
+    {
+        bar       = OhlcvBar{};
+        bar.start = start;
+    }
+    add(bar, trade);
+    symbol.latest = std::max(symbol.latest, interval);
+}
+
+void TradeAggregates::clear()
+{
+    m_symbols.clear();
+    m_lateTrades = 0;
+}
+
+void TradeAggregates::add(OhlcvBar& bar, const TradePOD& trade)
+{
+    const double price = trade.price;
+    if (bar.fills == 0)
+    {
+        bar.open = bar.high = bar.low = bar.close = price;
+        bar.openTime = bar.closeTime = trade.timestamp;
+    }
+    else
+    {
+        if (trade.timestamp < bar.openTime)
+        {
+            bar.open     = price;
+            bar.openTime = trade.timestamp;
+        }
+        if (trade.timestamp >= bar.closeTime)
+        {
+            bar.close     = price;
+            bar.closeTime = trade.timestamp;
+        }
+        bar.high = std::max(bar.high, price);
+        bar.low  = std::min(bar.low, price);
+    }
+    bar.notional += price * static_cast<double>(trade.quantity);
+    bar.volume += trade.quantity;
+    ++bar.fills;
+}
+
+DaySummary& TradeAggregates::dayFor(SymbolAggregates& symbol, int64_t day, uint32_t symbolCode)
+{
+    // Fills arrive in time order, so the day is almost always the last one.
+    if (!symbol.days.empty() && symbol.days.back().day == day)
+        return symbol.days.back();
+
+    auto it = std::lower_bound(symbol.days.begin(), symbol.days.end(), day,
+                               [](const DaySummary& summary, int64_t d) { return summary.day < d; });
+    if (it == symbol.days.end() || it->day != day)
+    {
+        DaySummary summary;
+        summary.day         = day;
+        summary.symbolCode  = symbolCode;
+        summary.ohlcv.start = day * kMicrosPerDay;
+        it                  = symbol.days.insert(it, summary);
+    }
+    return *it;
+}
+
+// ==========================================================================
+// Queries
+// ==========================================================================
+
+void TradeAggregates::bars(uint32_t symbolCode, int64_t fromTime, int64_t toTime, std::vector<OhlcvBar>& out) const
+{
+    if (symbolCode >= m_symbols.size() || m_symbols[symbolCode].ring.empty() || fromTime >= toTime)
+        return;
+    const SymbolAggregates& symbol = m_symbols[symbolCode];
+
+    // Only the newest barsPerSymbol intervals can still be in the ring.
+    const int64_t depth = static_cast<int64_t>(m_config.barsPerSymbol);
+    const int64_t first = std::max(symbol.latest - depth + 1, floorDiv(fromTime, m_config.barMicros));
+    const int64_t last  = std::min(symbol.latest, floorDiv(toTime, m_config.barMicros));
+    for (int64_t interval = first; interval <= last; ++interval)
+    {
+        const OhlcvBar& bar = symbol.ring[ringSlot(interval, m_config.barsPerSymbol)];
+        if (bar.fills > 0 && bar.start == interval * m_config.barMicros && bar.start >= fromTime
+            && bar.start < toTime)
+            out.push_back(bar);
+    }
+}
+
+void TradeAggregates::days(uint32_t symbolCode, int64_t fromDay, int64_t toDay, std::vector<DaySummary>& out) const
+{
+    if (symbolCode >= m_symbols.size())
+        return;
+    for (const DaySummary& summary : m_symbols[symbolCode].days)
+    {
+        if (summary.day >= fromDay && summary.day < toDay)
+            out.push_back(summary);
+    }
+}
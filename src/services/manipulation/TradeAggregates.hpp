@@ -0,0 +1,163 @@
+/**
+ * @file TradeAggregates.hpp
+ * @brief Per-symbol OHLCV bars and daily totals, maintained as trades arrive.
+ *
+ * @details Every recorded trade updates two aggregates of its symbol, so
+ * queries that only need totals read O(symbols × bars) figures instead of
+ * rescanning O(trades) rows:
+ *   - the bar of its interval (TradeAggregatesConfig::barMicros) in a
+ *     fixed-size ring per symbol, holding the most recent barsPerSymbol
+ *     intervals. A trade older than the ring is counted in lateTrades()
+ *     and left out of the bars, but not out of the daily totals.
+ *   - the summary of its UTC day: open, high, low, close, and fills,
+ *     quantity and notional per side, from which VWAP and volume follow.
+ *
+ * Open and close are the prices of the earliest and latest trade by
+ * timestamp (the first of equal timestamps opens, the last closes), so
+ * trades recorded out of order aggregate as if they had arrived sorted.
+ *
+ * Symbols are identified by the codes of the ColumnarTradeStore the trades
+ * were appended to; the caller passes each trade's code. A side other
+ * than 0 counts as a sell.
+ *
+ * Not thread-safe: ManipulationEngine updates it under the same lock as its
+ * resident store.
+ */
+
+#ifndef TRADEAGGREGATES_HPP
+#define TRADEAGGREGATES_HPP
+
+#include "SymbolTable.hpp"
+#include "pod/TradingPOD.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @struct TradeAggregatesConfig
+ * @brief Bar width and ring depth of a TradeAggregates.
+ */
+struct TradeAggregatesConfig
+{
+    /// @brief Width of one bar in microseconds (default one minute).
+    int64_t barMicros{60LL * 1000 * 1000};
+
+    /// @brief Bars kept per symbol; the default covers a day of minute bars.
+    std::size_t barsPerSymbol{1440};
+};
+
+/**
+ * @struct OhlcvBar
+ * @brief Open, high, low, close and volume of the trades in one interval.
+ */
+struct OhlcvBar
+{
+    int64_t  start{0};     ///< First microsecond of the interval.
+    int64_t  openTime{0};  ///< Timestamp of the opening trade.
+    int64_t  closeTime{0}; ///< Timestamp of the closing trade.
+    double   open{0.0};
+    double   high{0.0};
+    double   low{0.0};
+    double   close{0.0};
+    double   notional{0.0}; ///< Sum of price × quantity.
+    uint64_t volume{0};
+    uint32_t fills{0};
+
+    /// @brief Volume-weighted average price; 0 without volume.
+    double vwap() const { return volume > 0 ? notional / static_cast<double>(volume) : 0.0; }
+};
+
+/**
+ * @struct SideTotals
+ * @brief Fills, quantity and notional of one side.
+ */
+struct SideTotals
+{
+    uint32_t fills{0};
+    uint64_t quantity{0};
+    double   notional{0.0};
+};
+
+/**
+ * @struct DaySummary
+ * @brief One symbol's trading over one UTC day.
+ */
+struct DaySummary
+{
+    int64_t    day{0};        ///< Days since 1970-01-01 (TradingDate::days).
+    uint32_t   symbolCode{0}; ///< Code in the trades' ColumnarTradeStore.
+    OhlcvBar   ohlcv;         ///< The whole day as one bar.
+    SideTotals sides[2];      ///< [0] = buys, [1] = sells.
+};
+
+/**
+ * @struct SymbolDaySummary
+ * @brief A DaySummary with its symbol resolved, for readers outside the store.
+ */
+struct SymbolDaySummary
+{
+    SymbolKey  symbol;
+    DaySummary summary;
+};
+
+/**
+ * @class TradeAggregates
+ * @brief Rolling OHLCV bars and daily summaries per symbol.
+ */
+class TradeAggregates
+{
+public:
+    /**
+     * @throws std::invalid_argument if barMicros or barsPerSymbol is 0.
+     */
+    explicit TradeAggregates(TradeAggregatesConfig config = {});
+
+    /// @brief Add @p trade, whose symbol has code @p symbolCode.
+    void record(const TradePOD& trade, uint32_t symbolCode);
+
+    /// @brief Forget every trade.
+    void clear();
+
+    /// @brief Bar width and depth.
+    const TradeAggregatesConfig& config() const { return m_config; }
+
+    /// @brief Trades too old for their symbol's bar ring.
+    uint64_t lateTrades() const { return m_lateTrades; }
+
+    /**
+     * @brief The bars of @p symbolCode starting in [fromTime, toTime), oldest first.
+     * @details Appended to @p out; intervals without trades are skipped.
+     */
+    void bars(uint32_t symbolCode, int64_t fromTime, int64_t toTime, std::vector<OhlcvBar>& out) const;
+
+    /**
+     * @brief The daily summaries of @p symbolCode for days in [fromDay, toDay), oldest first.
+     * @details Appended to @p out.
+     */
+    void days(uint32_t symbolCode, int64_t fromDay, int64_t toDay, std::vector<DaySummary>& out) const;
+
+    /// @brief One past the highest symbol code recorded.
+    std::size_t symbolCount() const { return m_symbols.size(); }
+
+    /// @brief UTC day number of @p timestamp (microseconds since the epoch).
+    static int64_t dayOf(int64_t timestamp);
+
+private:
+    struct SymbolAggregates
+    {
+        std::vector<OhlcvBar>   ring;   ///< Sized on the first trade; slot = interval mod size.
+        int64_t                 latest{std::numeric_limits<int64_t>::min()}; ///< Newest interval held.
+        std::vector<DaySummary> days;   ///< Sorted by day; usually one.
+    };
+
+    static void add(OhlcvBar& bar, const TradePOD& trade);
+    DaySummary& dayFor(SymbolAggregates& symbol, int64_t day, uint32_t symbolCode);
+
+    TradeAggregatesConfig         m_config;
+    std::vector<SymbolAggregates> m_symbols;
+    uint64_t                      m_lateTrades{0};
+};
+
+#endif // TRADEAGGREGATES_HPP
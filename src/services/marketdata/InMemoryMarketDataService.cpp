@@ -0,0 +1,132 @@
+/**
+ * @file InMemoryMarketDataService.cpp
+ * @brief Implementation of InMemoryMarketDataService.
+ */
+
+#include "InMemoryMarketDataService.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    /// Symbols resolved and prefetched ahead of their snapshot copies.
+    constexpr std::size_t kLookupBlock = 16;
+} // namespace
+
+InMemoryMarketDataService::InMemoryMarketDataService(std::size_t maxSymbols)
+    : m_cache(maxSymbols)
+    , m_subscribers(std::make_unique<std::atomic<uint32_t>[]>(maxSymbols))
+{
+}
+
+// ==========================================================================
+// getData() — SymbolPOD[] in, MarketDataPOD[] out, no locks taken
+// ==========================================================================
+
+Response InMemoryMarketDataService::getData(const Request& request)
+{
+    PodArrayView<SymbolPOD> symbols;
+    const PodDecodeStatus status = bindRequest<RequestType::GET_MARKET_DATA>(request, symbols);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("MarketDataService: ") + toString(status), {}};
+    if (symbols.empty())
+        return Response{false, "MarketDataService: no symbols requested", {}};
+
+    Response response{true, "OK", PooledBuffer::uninitialized(pod::payloadSize<MarketDataPOD>(symbols.size()))};
+    uint8_t* out = response.data.data();
+
+    const PayloadHeader header{static_cast<uint16_t>(PodSchema<MarketDataPOD>::id),
+                               PodSchema<MarketDataPOD>::version,
+                               static_cast<uint32_t>(symbols.size())};
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+
+    // Resolve a block of symbols and prefetch their slots before copying any
+    // snapshot, so the slot misses of a block overlap instead of queueing.
+    SymbolId ids[kLookupBlock];
+    for (std::size_t first = 0; first < symbols.size(); first += kLookupBlock)
+    {
+        const std::size_t count = std::min(kLookupBlock, symbols.size() - first);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SymbolKey key(symbols[first + i].symbol);
+            ids[i] = m_cache.find(key);
+            if (ids[i] == kInvalidSymbolId)
+                return Response{false, std::string("MarketDataService: unknown symbol ") + key.bytes, {}};
+            m_cache.prefetch(ids[i]);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            MarketDataPOD snapshot{};
+            if (!m_cache.load(ids[i], snapshot))
+                std::memcpy(snapshot.symbol, m_cache.symbol(ids[i]).bytes, sizeof(snapshot.symbol));
+
+            std::memcpy(out, &snapshot, sizeof(snapshot));
+            out += sizeof(snapshot);
+        }
+    }
+
+    return response;
+}
+
+// ==========================================================================
+// Subscriptions and feed updates
+// ==========================================================================
+
+void InMemoryMarketDataService::subscribe(const std::string& symbol)
+{
+    const SymbolId id = m_cache.intern(SymbolKey(symbol.c_str()));
+    m_subscribers[id].fetch_add(1, std::memory_order_relaxed);
+}
+
+void InMemoryMarketDataService::unsubscribe(const std::string& symbol)
+{
+    const SymbolId id = m_cache.find(SymbolKey(symbol.c_str()));
+    if (id == kInvalidSymbolId)
+        return;
+
+    uint32_t count = m_subscribers[id].load(std::memory_order_relaxed);
+    while (count > 0
+           && !m_subscribers[id].compare_exchange_weak(count, count - 1, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint32_t InMemoryMarketDataService::subscriberCount(const std::string& symbol) const
+{
+    const SymbolId id = m_cache.find(SymbolKey(symbol.c_str()));
+    return id == kInvalidSymbolId ? 0 : m_subscribers[id].load(std::memory_order_relaxed);
+}
+
+SymbolId InMemoryMarketDataService::update(const MarketDataPOD& snapshot)
+{
+    const SymbolId id = m_cache.intern(SymbolKey(snapshot.symbol));
+    update(id, snapshot);
+    return id;
+}
+
+void InMemoryMarketDataService::update(SymbolId id, const MarketDataPOD& snapshot)
+{
+    m_cache.store(id, snapshot);
+    for (const auto& entry : m_listeners)
+        entry.second(id, snapshot);
+}
+
+std::vector<MarketDataPOD> InMemoryMarketDataService::snapshots() const
+{
+    const std::size_t          symbols = m_cache.size();
+    std::vector<MarketDataPOD> out;
+    out.reserve(symbols);
+
+    MarketDataPOD snapshot;
+    for (std::size_t id = 0; id < symbols; ++id)
+    {
+        if (m_cache.load(static_cast<SymbolId>(id), snapshot))
+            out.push_back(snapshot);
+    }
+    return out;
+}
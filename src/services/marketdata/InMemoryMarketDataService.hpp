@@ -0,0 +1,134 @@
+/**
+ * @file InMemoryMarketDataService.hpp
+ * @brief IMarketDataService that serves top-of-book snapshots from memory.
+ *
+ * @details Backed by a MarketDataCache. A feed handler publishes snapshots
+ * through update(). getData() decodes the requested SymbolPOD records in
+ * place, reads each symbol's latest MarketDataPOD without taking a lock,
+ * and returns them as a MarketDataPOD payload in the same order. Symbols are
+ * resolved a block at a time and their cache slots prefetched before any
+ * snapshot is copied, so a request for hundreds of symbols overlaps its
+ * cache misses.
+ *
+ * ### GET_MARKET_DATA
+ *   Request payload : PayloadHeader + N × SymbolPOD
+ *   Response data   : PayloadHeader + N × MarketDataPOD
+ *
+ * A symbol that is known but has no snapshot yet comes back with only its
+ * symbol field set. An unknown symbol fails the whole request.
+ *
+ * Update listeners are called after every update(). The SubscriptionManager
+ * uses one to push snapshots to sessions; the CalculationEngine uses one to
+ * re-mark resident books.
+ */
+
+#ifndef INMEMORYMARKETDATASERVICE_HPP
+#define INMEMORYMARKETDATASERVICE_HPP
+
+#include "MarketDataCache.hpp"
+#include "services/IMarketDataService.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class InMemoryMarketDataService
+ * @brief Lock-free-read market data service over a MarketDataCache.
+ */
+class InMemoryMarketDataService : public IMarketDataService
+{
+public:
+    /// Default symbol capacity.
+    static constexpr std::size_t kDefaultMaxSymbols = 4096;
+
+    /// Called on the feed thread after a snapshot has been stored.
+    using UpdateListener = std::function<void(SymbolId id, const MarketDataPOD& snapshot)>;
+
+    /// Handle returned by addUpdateListener().
+    using ListenerId = std::size_t;
+
+    /**
+     * @param maxSymbols Maximum number of distinct symbols.
+     * @throws std::invalid_argument if @p maxSymbols is 0.
+     */
+    explicit InMemoryMarketDataService(std::size_t maxSymbols = kDefaultMaxSymbols);
+
+    /// @copydoc IMarketDataService::getData
+    Response getData(const Request& request) override;
+
+    /**
+     * @brief Intern @p symbol and count a subscriber for it.
+     * @throws std::length_error if the symbol capacity is exhausted.
+     */
+    void subscribe(const std::string& symbol) override;
+
+    /// @brief Drop a subscriber; the symbol and its last snapshot are kept.
+    void unsubscribe(const std::string& symbol) override;
+
+    /**
+     * @brief Publish a snapshot from the feed, interning its symbol if needed.
+     * @return The symbol id, for callers that update by id afterwards.
+     * @throws std::length_error if the symbol capacity is exhausted.
+     */
+    SymbolId update(const MarketDataPOD& snapshot);
+
+    /// @brief Publish a snapshot for an already-interned symbol.
+    void update(SymbolId id, const MarketDataPOD& snapshot);
+
+    /**
+     * @brief Id of @p symbol, interning it without subscribing.
+     * @throws std::length_error if the symbol capacity is exhausted.
+     */
+    SymbolId intern(const std::string& symbol) { return m_cache.intern(SymbolKey(symbol.c_str())); }
+
+    /// @copydoc intern(const std::string&)
+    SymbolId intern(const SymbolKey& symbol) { return m_cache.intern(symbol); }
+
+    /// @brief Number of active subscriptions to @p symbol.
+    uint32_t subscriberCount(const std::string& symbol) const;
+
+    /**
+     * @brief Add a listener notified by every update().
+     * @details Not synchronised with update(): add and remove listeners
+     *          only while the feed is not publishing.
+     */
+    ListenerId addUpdateListener(UpdateListener listener)
+    {
+        m_listeners.emplace_back(m_nextListenerId, std::move(listener));
+        return m_nextListenerId++;
+    }
+
+    /// @brief Remove a listener added with addUpdateListener().
+    void removeUpdateListener(ListenerId id)
+    {
+        m_listeners.erase(std::remove_if(m_listeners.begin(), m_listeners.end(),
+                                         [id](const auto& entry) { return entry.first == id; }),
+                          m_listeners.end());
+    }
+
+    /**
+     * @brief Latest snapshot of every symbol that has one, in SymbolId order.
+     * @details Each snapshot is read consistently; together they are not a
+     *          single point in time while the feed keeps publishing.
+     */
+    std::vector<MarketDataPOD> snapshots() const;
+
+    /// @brief The underlying cache (read-only access for other services).
+    const MarketDataCache& cache() const { return m_cache; }
+
+private:
+    using ListenerEntry = std::pair<ListenerId, UpdateListener>;
+
+    MarketDataCache                          m_cache;
+    std::vector<ListenerEntry>               m_listeners;
+    ListenerId                               m_nextListenerId{0};
+    std::unique_ptr<std::atomic<uint32_t>[]> m_subscribers; ///< Indexed by SymbolId.
+};
+
+#endif // INMEMORYMARKETDATASERVICE_HPP
@@ -0,0 +1,173 @@
+/**
+ * @file MarketDataCache.hpp
+ * @brief Symbol-indexed, seqlock-protected store of the latest market data snapshot.
+ *
+ * @details One cache-line-aligned slot per interned symbol holds the most
+ * recent top-of-book snapshot. Writers (the feed) bump the slot's sequence
+ * to an odd value, store the snapshot and bump it back to even. Readers
+ * copy the snapshot and retry only if the sequence changed or was odd
+ * during the copy. Reads therefore never take a lock and never block a
+ * writer. The snapshot is stored as relaxed atomic 64-bit words, so a read
+ * that races with a write is well defined: it is simply discarded.
+ *
+ * Slots hold a MarketDataRecord, not the packed MarketDataPOD: the symbol is
+ * implied by the slot, so sequence and snapshot fit one cache line and a
+ * read touches a single line. Internal readers load the record; the
+ * MarketDataPOD overloads convert at the edge, taking the symbol from the
+ * symbol table.
+ */
+
+#ifndef MARKETDATACACHE_HPP
+#define MARKETDATACACHE_HPP
+
+#include "Records.hpp"
+#include "SymbolTable.hpp"
+#include "concurrency/BoundedMpmcQueue.hpp" // kCacheLineSize
+#include "pod/TradingPOD.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * @class MarketDataCache
+ * @brief Latest snapshot per symbol; readers never lock or block writers.
+ */
+class MarketDataCache
+{
+public:
+    /**
+     * @param maxSymbols Maximum number of distinct symbols.
+     * @throws std::invalid_argument if @p maxSymbols is 0.
+     */
+    explicit MarketDataCache(std::size_t maxSymbols)
+        : m_symbols(maxSymbols)
+        , m_slots(std::make_unique<Slot[]>(maxSymbols))
+    {
+    }
+
+    /// @brief Intern @p symbol (idempotent) and return its id.
+    /// @throws std::length_error if the symbol capacity is exhausted.
+    SymbolId intern(const SymbolKey& symbol) { return m_symbols.intern(symbol); }
+
+    /// @brief Id of @p symbol, or kInvalidSymbolId if it is unknown.
+    SymbolId find(const SymbolKey& symbol) const { return m_symbols.find(symbol); }
+
+    /// @brief The symbol interned as @p id.
+    const SymbolKey& symbol(SymbolId id) const { return m_symbols.key(id); }
+
+    /// @brief Number of interned symbols.
+    std::size_t size() const { return m_symbols.size(); }
+
+    /// @brief Maximum number of symbols; every id is below this.
+    std::size_t capacity() const { return m_symbols.capacity(); }
+
+    /**
+     * @brief Publish a new snapshot for @p id.
+     * @param id   Interned symbol id; must be less than size().
+     * @param data Snapshot to store.
+     *
+     * Concurrent writers to the same id are serialised by the sequence CAS.
+     */
+    void store(SymbolId id, const MarketDataRecord& data)
+    {
+        Slot& slot = m_slots[id];
+
+        uint64_t seq = slot.sequence.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if ((seq & 1u) == 0
+                && slot.sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire))
+                break;
+            seq = slot.sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &data, sizeof(MarketDataRecord));
+        for (std::size_t i = 0; i < kWords; ++i)
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+
+        slot.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the latest snapshot of @p id into @p out.
+     * @return false if nothing has been stored for @p id yet.
+     */
+    bool load(SymbolId id, MarketDataRecord& out) const
+    {
+        const Slot& slot = m_slots[id];
+        uint64_t    words[kWords];
+
+        for (;;)
+        {
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1u)
+                continue; // write in progress
+
+            for (std::size_t i = 0; i < kWords; ++i)
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before)
+            {
+                if (before == 0)
+                    return false;
+                std::memcpy(&out, words, sizeof(MarketDataRecord));
+                return true;
+            }
+        }
+    }
+
+    /// @brief store() a wire snapshot; its symbol field is ignored, @p id names the symbol.
+    void store(SymbolId id, const MarketDataPOD& data)
+    {
+        MarketDataRecord record;
+        fromWire(data, record, [id](const SymbolKey&) { return id; });
+        store(id, record);
+    }
+
+    /// @brief load() as a wire snapshot, with the interned symbol filled in.
+    bool load(SymbolId id, MarketDataPOD& out) const
+    {
+        MarketDataRecord record;
+        if (!load(id, record))
+            return false;
+        toWire(record, out, [this](SymbolId symbolId) -> const SymbolKey& { return m_symbols.key(symbolId); });
+        return true;
+    }
+
+    /// @brief Start loading the slot of @p id into the cache ahead of load().
+    void prefetch(SymbolId id) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&m_slots[id], 0, 3);
+#else
+        (void)id;
+#endif
+    }
+
+    /// @brief Number of snapshots ever stored for @p id (0 = never updated).
+    uint64_t version(SymbolId id) const
+    {
+        return m_slots[id].sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(MarketDataRecord) + 7) / 8;
+
+    struct alignas(kCacheLineSize) Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> words[kWords] = {};
+    };
+    static_assert(sizeof(Slot) == kCacheLineSize, "a snapshot must fit one cache line with its sequence");
+
+    SymbolTable             m_symbols;
+    std::unique_ptr<Slot[]> m_slots;
+};
+
+#endif // MARKETDATACACHE_HPP
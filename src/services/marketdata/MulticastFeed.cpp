@@ -0,0 +1,202 @@
+/**
+ * @file MulticastFeed.cpp
+ * @brief Implementation of MulticastFeed.
+ */
+
+#include "MulticastFeed.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    int64_t nowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+} // namespace
+
+// ==========================================================================
+// Constructor / destructor
+// ==========================================================================
+
+MulticastFeed::MulticastFeed(std::shared_ptr<InMemoryMarketDataService> marketData,
+                             std::shared_ptr<IDatagramPublisher>        publisher,
+                             MulticastFeedConfig                        config)
+    : m_marketData(std::move(marketData))
+    , m_publisher(std::move(publisher))
+    , m_config(config)
+    , m_epoch(nowMicros())
+{
+    if (!m_marketData || !m_publisher)
+        throw std::invalid_argument("[MulticastFeed] marketData and publisher must not be null");
+    if (m_config.maxDatagramBytes < sizeof(MarketDataPacketHeaderPOD) + sizeof(MarketDataPOD))
+        throw std::invalid_argument("[MulticastFeed] maxDatagramBytes cannot hold one tick");
+    if (m_config.historySize == 0 || m_config.maxRecoveryTicks == 0)
+        throw std::invalid_argument("[MulticastFeed] historySize and maxRecoveryTicks must be at least 1");
+
+    // The header counts ticks in 16 bits.
+    m_ticksPerDatagram = std::min<std::size_t>(
+        (m_config.maxDatagramBytes - sizeof(MarketDataPacketHeaderPOD)) / sizeof(MarketDataPOD),
+        std::numeric_limits<uint16_t>::max());
+    m_datagram.resize(sizeof(MarketDataPacketHeaderPOD) + m_ticksPerDatagram * sizeof(MarketDataPOD));
+    m_history.resize(m_config.historySize);
+
+    if (m_config.flushInterval.count() > 0)
+        m_flusher = std::thread([this]() { flushLoop(); });
+
+    m_listenerId = m_marketData->addUpdateListener(
+        [this](SymbolId, const MarketDataPOD& snapshot) { onUpdate(snapshot); });
+}
+
+MulticastFeed::~MulticastFeed()
+{
+    m_marketData->removeUpdateListener(m_listenerId);
+    stop();
+}
+
+void MulticastFeed::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        if (m_batchCount > 0)
+            sendBatchLocked();
+    }
+    m_batchStarted.notify_all();
+    if (m_flusher.joinable())
+        m_flusher.join();
+}
+
+// ==========================================================================
+// Publishing — sequence, batch, send
+// ==========================================================================
+
+void MulticastFeed::onUpdate(const MarketDataPOD& snapshot)
+{
+    bool started = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64_t sequence = ++m_stats.ticks;
+        m_history[(sequence - 1) % m_history.size()] = SequencedMarketDataPOD{sequence, snapshot};
+
+        if (m_batchCount == 0)
+        {
+            m_batchFirst    = sequence;
+            m_batchDeadline = std::chrono::steady_clock::now() + m_config.flushInterval;
+            started         = true;
+        }
+        std::memcpy(m_datagram.data() + sizeof(MarketDataPacketHeaderPOD) + m_batchCount * sizeof(MarketDataPOD),
+                    &snapshot, sizeof(snapshot));
+        ++m_batchCount;
+
+        if (m_batchCount == m_ticksPerDatagram || m_config.flushInterval.count() == 0 || m_stopping)
+        {
+            sendBatchLocked();
+            started = false;
+        }
+    }
+    if (started)
+        m_batchStarted.notify_one(); // the flusher sleeps until a batch starts
+}
+
+void MulticastFeed::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_batchCount > 0)
+        sendBatchLocked();
+}
+
+void MulticastFeed::sendBatchLocked()
+{
+    const MarketDataPacketHeaderPOD header{kMarketDataPacketMagic, kMarketDataPacketVersion,
+                                           static_cast<uint16_t>(m_batchCount), m_batchFirst, m_epoch};
+    std::memcpy(m_datagram.data(), &header, sizeof(header));
+
+    ++m_stats.datagrams;
+    if (!m_publisher->sendDatagram(m_datagram.data(), sizeof(header) + m_batchCount * sizeof(MarketDataPOD)))
+        ++m_stats.sendFailures; // receivers recover the ticks like any other loss
+    m_batchCount = 0;
+}
+
+void MulticastFeed::flushLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping)
+    {
+        if (m_batchCount == 0)
+        {
+            m_batchStarted.wait(lock);
+            continue;
+        }
+
+        // A full batch may have been sent and a new one started meanwhile: re-read the deadline.
+        const auto deadline = m_batchDeadline;
+        if (std::chrono::steady_clock::now() >= deadline)
+            sendBatchLocked();
+        else
+            m_batchStarted.wait_until(lock, deadline);
+    }
+}
+
+// ==========================================================================
+// RECOVER_MARKET_DATA
+// ==========================================================================
+
+Response MulticastFeed::recover(const Request& request)
+{
+    PodArrayView<MarketDataRecoveryPOD> ranges;
+    const PodDecodeStatus status = bindRequest<RequestType::RECOVER_MARKET_DATA>(request, ranges);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("MulticastFeed: ") + toString(status), {}};
+    if (ranges.size() != 1)
+        return Response{false, "MulticastFeed: expected exactly one recovery range", {}};
+
+    const MarketDataRecoveryPOD range = ranges[0];
+    if (range.fromSequence == 0 || range.count == 0)
+        return Response{false, "MulticastFeed: empty recovery range (sequence numbers start at 1)", {}};
+
+    const uint64_t requestedEnd = range.fromSequence > std::numeric_limits<uint64_t>::max() - range.count
+                                      ? std::numeric_limits<uint64_t>::max()
+                                      : range.fromSequence + range.count;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t last   = m_stats.ticks;
+    const uint64_t oldest = last > m_history.size() ? last - m_history.size() + 1 : 1;
+    const uint64_t from   = std::max(range.fromSequence, oldest);
+    const uint64_t end    = std::min({requestedEnd, last + 1, from + m_config.maxRecoveryTicks});
+    const std::size_t count = end > from ? static_cast<std::size_t>(end - from) : 0;
+
+    PooledBuffer payload = PooledBuffer::uninitialized(pod::payloadSize<SequencedMarketDataPOD>(count));
+    const PayloadHeader header{static_cast<uint16_t>(PodSchema<SequencedMarketDataPOD>::id),
+                               PodSchema<SequencedMarketDataPOD>::version, static_cast<uint32_t>(count)};
+    uint8_t* out = payload.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    for (uint64_t sequence = from; sequence < end; ++sequence)
+    {
+        std::memcpy(out, &m_history[(sequence - 1) % m_history.size()], sizeof(SequencedMarketDataPOD));
+        out += sizeof(SequencedMarketDataPOD);
+    }
+
+    ++m_stats.recoveries;
+    m_stats.recoveredTicks += count;
+    if (from > range.fromSequence)
+        m_stats.agedOutTicks += std::min(from, requestedEnd) - range.fromSequence;
+    return Response{true, from > range.fromSequence ? "Recovered (older ticks aged out)" : "Recovered",
+                    std::move(payload)};
+}
+
+MulticastFeedStats MulticastFeed::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
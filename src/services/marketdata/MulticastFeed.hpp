@@ -0,0 +1,157 @@
+/**
+ * @file MulticastFeed.hpp
+ * @brief Publishes every market data update as sequenced datagrams, and
+ *        resends the ticks a receiver missed.
+ *
+ * @details Subscriptions push to each session separately. The multicast feed
+ * sends every InMemoryMarketDataService::update() once, to any number of
+ * receivers on the network, through an IDatagramPublisher (normally a
+ * UdpMulticastSender):
+ *
+ *   datagram = MarketDataPacketHeaderPOD + count × MarketDataPOD
+ *
+ * Every tick gets the next sequence number, starting at 1. Ticks are batched
+ * until a datagram is full (MulticastFeedConfig::maxDatagramBytes) or the
+ * first tick of the batch has waited MulticastFeedConfig::flushInterval.
+ * Unlike subscriptions, nothing is conflated: receivers see every tick, in
+ * order, or a gap in the sequence numbers.
+ *
+ * UDP may drop datagrams. The last historySize ticks are therefore kept,
+ * and a receiver that sees a gap sends RECOVER_MARKET_DATA over its regular
+ * session (TLS, TCP, Unix socket or shared memory):
+ *
+ *   Request data  : PayloadHeader + 1 × MarketDataRecoveryPOD
+ *   Response data : PayloadHeader + N × SequencedMarketDataPOD
+ *
+ * The reply holds the retained part of the range, at most maxRecoveryTicks
+ * ticks. If its first sequence number is above the requested one, the
+ * missing ticks have aged out and the receiver must rebuild its state from
+ * a GET_MARKET_DATA snapshot instead. Ticks after the last one published
+ * are not included, so an empty reply means "nothing newer yet".
+ *
+ * Batch and history share one mutex. Datagrams are sent while it is held,
+ * which keeps them in sequence order; IDatagramPublisher::sendDatagram()
+ * never blocks, so the feed thread is only delayed by the copy into the
+ * kernel.
+ */
+
+#ifndef MULTICASTFEED_HPP
+#define MULTICASTFEED_HPP
+
+#include "InMemoryMarketDataService.hpp"
+#include "services/IMarketDataRecoveryService.hpp"
+#include "transport/IDatagramPublisher.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct MulticastFeedConfig
+ * @brief Batching and retention of a MulticastFeed.
+ */
+struct MulticastFeedConfig
+{
+    /// @brief Largest datagram sent; the default fits an Ethernet MTU with room for IP/UDP headers.
+    std::size_t maxDatagramBytes{1400};
+
+    /// @brief Longest a tick waits for others to share its datagram (0 = one tick per datagram).
+    std::chrono::microseconds flushInterval{100};
+
+    /// @brief Ticks kept for RECOVER_MARKET_DATA.
+    std::size_t historySize{65536};
+
+    /// @brief Ticks returned by one RECOVER_MARKET_DATA reply at most.
+    std::size_t maxRecoveryTicks{4096};
+};
+
+/**
+ * @struct MulticastFeedStats
+ * @brief Counters of a MulticastFeed, all since construction.
+ */
+struct MulticastFeedStats
+{
+    uint64_t ticks{0};          ///< Ticks sequenced, i.e. the last sequence number.
+    uint64_t datagrams{0};      ///< Datagrams handed to the publisher.
+    uint64_t sendFailures{0};   ///< Datagrams the publisher could not send.
+    uint64_t recoveries{0};     ///< RECOVER_MARKET_DATA requests answered.
+    uint64_t recoveredTicks{0}; ///< Ticks resent by those replies.
+    uint64_t agedOutTicks{0};   ///< Requested ticks that were no longer retained.
+};
+
+/**
+ * @class MulticastFeed
+ * @brief Sequenced, batched datagram feed with a bounded history for gap recovery.
+ */
+class MulticastFeed : public IMarketDataRecoveryService
+{
+public:
+    /**
+     * @brief Listen for updates published to @p marketData and send them through @p publisher.
+     * @details Starts the flusher thread when the flush interval is not 0.
+     * @throws std::invalid_argument if either pointer is null, a datagram
+     *         cannot hold one tick, or historySize / maxRecoveryTicks is 0.
+     */
+    MulticastFeed(std::shared_ptr<InMemoryMarketDataService> marketData,
+                  std::shared_ptr<IDatagramPublisher>        publisher,
+                  MulticastFeedConfig                        config = {});
+
+    /// Removes the update listener, then stops as stop() does.
+    ~MulticastFeed() override;
+
+    MulticastFeed(const MulticastFeed&)            = delete;
+    MulticastFeed& operator=(const MulticastFeed&) = delete;
+
+    /// @copydoc IMarketDataRecoveryService::recover
+    Response recover(const Request& request) override;
+
+    /// @brief Send the ticks waiting for their datagram to fill up now.
+    void flush();
+
+    /// @brief Send what is batched and join the flusher; later ticks are sent one per datagram.
+    void stop();
+
+    /// @brief Publisher start time carried by every datagram (Unix epoch, microseconds).
+    int64_t epoch() const { return m_epoch; }
+
+    /// @brief Ticks that fit into one datagram.
+    std::size_t ticksPerDatagram() const { return m_ticksPerDatagram; }
+
+    /// @brief Snapshot of the counters.
+    MulticastFeedStats stats() const;
+
+private:
+    void onUpdate(const MarketDataPOD& snapshot);
+
+    /// Send the batched ticks as one datagram; m_mutex must be held.
+    void sendBatchLocked();
+
+    /// Flusher thread: sends batches whose first tick has waited flushInterval.
+    void flushLoop();
+
+    std::shared_ptr<InMemoryMarketDataService> m_marketData;
+    std::shared_ptr<IDatagramPublisher>        m_publisher;
+    MulticastFeedConfig                        m_config;
+    InMemoryMarketDataService::ListenerId      m_listenerId{0};
+    std::size_t                                m_ticksPerDatagram{0};
+    int64_t                                    m_epoch{0};
+
+    mutable std::mutex                    m_mutex;
+    std::condition_variable               m_batchStarted;
+    std::vector<uint8_t>                  m_datagram;   ///< Header space, then the batched ticks.
+    std::size_t                           m_batchCount{0};
+    uint64_t                              m_batchFirst{0}; ///< Sequence number of the first batched tick.
+    std::chrono::steady_clock::time_point m_batchDeadline{};
+    std::vector<SequencedMarketDataPOD>   m_history; ///< Ring, indexed by (sequence - 1) % size.
+    MulticastFeedStats                    m_stats;
+    bool                                  m_stopping{false};
+
+    std::thread m_flusher;
+};
+
+#endif // MULTICASTFEED_HPP
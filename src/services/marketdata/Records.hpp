@@ -0,0 +1,95 @@
+/**
+ * @file Records.hpp
+ * @brief Naturally aligned internal twins of the packed wire PODs, and the
+ *        conversions between them.
+ *
+ * @details The wire structs in TradingPOD.hpp are #pragma pack(1): their
+ * doubles and 64-bit integers follow a char[32] symbol or single-byte
+ * fields, so they are unaligned and the compiler must assume the worst.
+ * Services keep their state in the records below instead. Every field is
+ * naturally aligned, and the symbol is its interned SymbolId, so a record
+ * is smaller than its POD (MarketDataRecord: 48 bytes instead of 72) and
+ * comparing symbols is comparing integers.
+ *
+ * Records and conversions are expanded from the same field lists as the
+ * PODs (HFT_*_FIELDS in TradingPOD.hpp), so the two layouts cannot drift:
+ * a field added to a list appears in the POD, in the record, and in both
+ * directions of the conversion.
+ *
+ * Conversion happens at the edge only: fromWire() when a request or a feed
+ * update comes in, toWire() when a reply, push or snapshot goes out. The
+ * symbol is mapped by a caller-supplied function, normally
+ * InMemoryMarketDataService::intern() one way and MarketDataCache::symbol()
+ * the other.
+ */
+
+#ifndef RECORDS_HPP
+#define RECORDS_HPP
+
+#include "SymbolTable.hpp"
+#include "pod/TradingPOD.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/// Record expansion of a FIELD entry.
+#define HFT_RECORD_FIELD(type, name) type name;
+
+/// Record expansion of a SYMBOL entry.
+#define HFT_RECORD_SYMBOL(name) SymbolId name;
+
+#define HFT_FROM_WIRE_FIELD(type, name) out.name = in.name;
+#define HFT_FROM_WIRE_SYMBOL(name) out.name = intern(SymbolKey(in.name));
+#define HFT_TO_WIRE_FIELD(type, name) out.name = in.name;
+#define HFT_TO_WIRE_SYMBOL(name) std::memcpy(out.name, symbolOf(in.name).bytes, sizeof(out.name));
+
+/**
+ * @brief Define record @p Record for the POD @p Pod from the field list @p FIELDS,
+ *        with fromWire() and toWire() between them.
+ *
+ * fromWire(pod, record, intern): intern(const SymbolKey&) returns the SymbolId.
+ * toWire(record, pod, symbolOf): symbolOf(SymbolId) returns the SymbolKey.
+ */
+#define HFT_DEFINE_RECORD(Record, Pod, FIELDS)                                                           \
+    struct Record                                                                                        \
+    {                                                                                                    \
+        FIELDS(HFT_RECORD_FIELD, HFT_RECORD_SYMBOL)                                                      \
+    };                                                                                                   \
+    static_assert(std::is_trivially_copyable<Record>::value, #Record " must stay trivially copyable");   \
+    static_assert(sizeof(Record) <= sizeof(Pod), #Record " must not be larger than " #Pod);              \
+                                                                                                         \
+    template <typename Intern>                                                                           \
+    inline void fromWire(const Pod& in, Record& out, Intern&& intern)                                    \
+    {                                                                                                    \
+        FIELDS(HFT_FROM_WIRE_FIELD, HFT_FROM_WIRE_SYMBOL)                                                \
+    }                                                                                                    \
+                                                                                                         \
+    template <typename SymbolOf>                                                                         \
+    inline void toWire(const Record& in, Pod& out, SymbolOf&& symbolOf)                                  \
+    {                                                                                                    \
+        FIELDS(HFT_TO_WIRE_FIELD, HFT_TO_WIRE_SYMBOL)                                                    \
+    }
+
+/// @brief Market data snapshot; the symbol is implied by a cache slot or given as an id.
+HFT_DEFINE_RECORD(MarketDataRecord, MarketDataPOD, HFT_MARKET_DATA_FIELDS)
+
+/// @brief Order as the server keeps it.
+HFT_DEFINE_RECORD(OrderRecord, OrderPOD, HFT_ORDER_FIELDS)
+
+/// @brief Position of a resident book.
+HFT_DEFINE_RECORD(PositionRecord, PositionPOD, HFT_POSITION_FIELDS)
+
+/// @brief Fill as the server keeps it.
+HFT_DEFINE_RECORD(TradeRecord, TradePOD, HFT_TRADE_FIELDS)
+
+// TODO: EXTEND — Give a new POD a field list in TradingPOD.hpp and a
+//               HFT_DEFINE_RECORD line here when services keep it as state.
+
+// Natural alignment is the point: pin it, and the sizes the comments rely on.
+static_assert(alignof(MarketDataRecord) == 8 && sizeof(MarketDataRecord) == 48, "MarketDataRecord layout changed");
+static_assert(alignof(OrderRecord) == 8 && sizeof(OrderRecord) == 48, "OrderRecord layout changed");
+static_assert(alignof(PositionRecord) == 8 && sizeof(PositionRecord) == 40, "PositionRecord layout changed");
+static_assert(alignof(TradeRecord) == 8 && sizeof(TradeRecord) == 56, "TradeRecord layout changed");
+
+#endif // RECORDS_HPP
@@ -0,0 +1,258 @@
+/**
+ * @file SubscriptionManager.cpp
+ * @brief Implementation of SubscriptionManager.
+ */
+
+#include "SubscriptionManager.hpp"
+
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /// Latest snapshot of each id as a MarketDataPOD payload.
+    PooledBuffer snapshotPayload(const MarketDataCache& cache, const SymbolId* ids, std::size_t count)
+    {
+        PooledBuffer payload = PooledBuffer::uninitialized(pod::payloadSize<MarketDataPOD>(count));
+        uint8_t* out = payload.data();
+
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<MarketDataPOD>::id),
+                                   PodSchema<MarketDataPOD>::version,
+                                   static_cast<uint32_t>(count)};
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            MarketDataPOD snapshot{};
+            if (!cache.load(ids[i], snapshot))
+                std::memcpy(snapshot.symbol, cache.symbol(ids[i]).bytes, sizeof(snapshot.symbol));
+            std::memcpy(out, &snapshot, sizeof(snapshot));
+            out += sizeof(snapshot);
+        }
+        return payload;
+    }
+
+    Response makePush(PooledBuffer data)
+    {
+        Response push{true, "MarketData", std::move(data)};
+        push.push = true;
+        return push;
+    }
+
+    template <typename T>
+    void eraseValue(std::vector<T>& values, const T& value)
+    {
+        values.erase(std::remove(values.begin(), values.end(), value), values.end());
+    }
+} // namespace
+
+SubscriptionManager::SubscriptionManager(std::shared_ptr<InMemoryMarketDataService> marketData)
+    : m_marketData(std::move(marketData))
+{
+    if (!m_marketData)
+        throw std::invalid_argument("[SubscriptionManager] marketData must not be null");
+
+    m_subscribers.resize(m_marketData->cache().capacity());
+    m_listenerId = m_marketData->addUpdateListener(
+        [this](SymbolId id, const MarketDataPOD& snapshot) { onUpdate(id, snapshot); });
+}
+
+SubscriptionManager::~SubscriptionManager()
+{
+    m_marketData->removeUpdateListener(m_listenerId);
+}
+
+void SubscriptionManager::attach(ISessionPublisher& publisher)
+{
+    m_publisher = &publisher;
+    publisher.setSessionClosedHandler([this](uint64_t sessionId) { removeSession(sessionId); });
+}
+
+// ==========================================================================
+// SUBSCRIBE / UNSUBSCRIBE
+// ==========================================================================
+
+Response SubscriptionManager::subscribe(const Request& request)
+{
+    if (request.sessionId == 0)
+        return Response{false, "SubscriptionManager: request has no session", {}};
+
+    PodArrayView<SymbolPOD> symbols;
+    const PodDecodeStatus status = bindRequest<RequestType::SUBSCRIBE>(request, symbols);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("SubscriptionManager: ") + toString(status), {}};
+    if (symbols.empty())
+        return Response{false, "SubscriptionManager: no symbols requested", {}};
+
+    const MarketDataCache& cache = m_marketData->cache();
+    std::vector<SymbolId>  ids;
+    ids.reserve(symbols.size());
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Session& session = m_sessions[request.sessionId];
+
+        for (const SymbolPOD& requested : symbols)
+        {
+            const SymbolKey key(requested.symbol);
+            SymbolId        id = cache.find(key);
+
+            const bool subscribed = id != kInvalidSymbolId
+                && std::find(session.symbols.begin(), session.symbols.end(), id)
+                       != session.symbols.end();
+            if (!subscribed)
+            {
+                m_marketData->subscribe(key.bytes); // interns the symbol
+                id = cache.find(key);
+                session.symbols.push_back(id);
+                m_subscribers[id].push_back(request.sessionId);
+            }
+            ids.push_back(id);
+        }
+    }
+    catch (const std::length_error& ex)
+    {
+        return Response{false, std::string("SubscriptionManager: ") + ex.what(), {}};
+    }
+
+    return Response{true, "Subscribed", snapshotPayload(cache, ids.data(), ids.size())};
+}
+
+Response SubscriptionManager::unsubscribe(const Request& request)
+{
+    PodArrayView<SymbolPOD> symbols;
+    const PodDecodeStatus status = bindRequest<RequestType::UNSUBSCRIBE>(request, symbols);
+    if (status != PodDecodeStatus::OK)
+        return Response{false, std::string("SubscriptionManager: ") + toString(status), {}};
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_sessions.find(request.sessionId);
+    if (it == m_sessions.end())
+        return Response{true, "Unsubscribed", {}};
+
+    for (const SymbolPOD& requested : symbols)
+    {
+        const SymbolId id = m_marketData->cache().find(SymbolKey(requested.symbol));
+        if (id != kInvalidSymbolId)
+            unsubscribeLocked(request.sessionId, it->second, id);
+    }
+
+    if (it->second.symbols.empty() && !it->second.writing)
+        m_sessions.erase(it);
+    return Response{true, "Unsubscribed", {}};
+}
+
+void SubscriptionManager::removeSession(uint64_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_sessions.find(sessionId);
+    if (it == m_sessions.end())
+        return;
+
+    const std::vector<SymbolId> symbols = it->second.symbols;
+    for (const SymbolId id : symbols)
+        unsubscribeLocked(sessionId, it->second, id);
+    m_sessions.erase(it);
+}
+
+void SubscriptionManager::unsubscribeLocked(uint64_t sessionId, Session& session, SymbolId id)
+{
+    const auto pos = std::find(session.symbols.begin(), session.symbols.end(), id);
+    if (pos == session.symbols.end())
+        return;
+
+    session.symbols.erase(pos);
+    if (session.dirtySet.erase(id) != 0)
+        eraseValue(session.dirty, id);
+    eraseValue(m_subscribers[id], sessionId);
+    m_marketData->unsubscribe(m_marketData->cache().symbol(id).bytes);
+}
+
+std::size_t SubscriptionManager::subscriptionCount(uint64_t sessionId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_sessions.find(sessionId);
+    return it == m_sessions.end() ? 0 : it->second.symbols.size();
+}
+
+uint64_t SubscriptionManager::conflatedUpdates() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_conflated;
+}
+
+// ==========================================================================
+// Fan-out — push to idle sessions, mark busy ones dirty
+// ==========================================================================
+
+void SubscriptionManager::onUpdate(SymbolId id, const MarketDataPOD& snapshot)
+{
+    if (!m_publisher)
+        return;
+
+    std::vector<uint64_t> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const uint64_t sessionId : m_subscribers[id])
+        {
+            Session& session = m_sessions[sessionId];
+            if (!session.writing)
+            {
+                session.writing = true;
+                ready.push_back(sessionId);
+            }
+            else if (session.dirtySet.insert(id).second)
+                session.dirty.push_back(id);
+            else
+                ++m_conflated;
+        }
+    }
+    if (ready.empty())
+        return;
+
+    // One payload for every idle subscriber; each session shares the block.
+    const Response push = makePush(makePodPayload(&snapshot, 1));
+    for (const uint64_t sessionId : ready)
+        publish(sessionId, push);
+}
+
+void SubscriptionManager::onDrained(uint64_t sessionId)
+{
+    std::vector<SymbolId> dirty;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_sessions.find(sessionId);
+        if (it == m_sessions.end())
+            return;
+
+        Session& session = it->second;
+        if (session.dirty.empty())
+        {
+            session.writing = false;
+            if (session.symbols.empty())
+                m_sessions.erase(it);
+            return;
+        }
+        dirty.swap(session.dirty);
+        session.dirtySet.clear();
+    }
+
+    publish(sessionId, makePush(snapshotPayload(m_marketData->cache(), dirty.data(), dirty.size())));
+}
+
+void SubscriptionManager::publish(uint64_t sessionId, Response push)
+{
+    std::vector<Response> messages;
+    messages.push_back(std::move(push));
+
+    if (!m_publisher->publish(sessionId, std::move(messages),
+                              [this, sessionId]() { onDrained(sessionId); }))
+        removeSession(sessionId);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file SubscriptionManager.hpp
+ * @brief Pushes market data updates to the sessions subscribed to them.
+ *
+ * @details SUBSCRIBE binds symbols to the session the request arrived on.
+ * Every InMemoryMarketDataService::update() for a subscribed symbol is then
+ * fanned out to those sessions through an ISessionPublisher.
+ *
+ * Each session has at most one published batch outstanding. If an update
+ * arrives while a batch is still being written, only the symbol id is marked
+ * dirty. Further updates to a dirty symbol are conflated, because the
+ * snapshot is read from the cache when the batch is built. When the session
+ * drains, all of its dirty symbols go out as one push, so a slow client gets
+ * the latest state of every symbol instead of a growing backlog of stale
+ * ticks.
+ *
+ * ### Push message
+ *   Response::push = true, message "MarketData"
+ *   Response data  : PayloadHeader + N × MarketDataPOD
+ *
+ * Subscription tables are guarded by one mutex. Publishing always happens
+ * outside it.
+ */
+
+#ifndef SUBSCRIPTIONMANAGER_HPP
+#define SUBSCRIPTIONMANAGER_HPP
+
+#include "InMemoryMarketDataService.hpp"
+#include "services/ISubscriptionService.hpp"
+#include "transport/ISessionPublisher.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class SubscriptionManager
+ * @brief Session-scoped subscriptions with per-session conflation.
+ */
+class SubscriptionManager : public ISubscriptionService
+{
+public:
+    /**
+     * @brief Listen for updates published to @p marketData.
+     * @throws std::invalid_argument if @p marketData is null.
+     */
+    explicit SubscriptionManager(std::shared_ptr<InMemoryMarketDataService> marketData);
+
+    /// Removes the update listener from the market data service.
+    ~SubscriptionManager() override;
+
+    SubscriptionManager(const SubscriptionManager&)            = delete;
+    SubscriptionManager& operator=(const SubscriptionManager&) = delete;
+
+    /**
+     * @brief Route pushes through @p publisher and drop sessions it closes.
+     * @details Call once, before the transport starts; @p publisher must
+     *          outlive this manager's use of it.
+     */
+    void attach(ISessionPublisher& publisher);
+
+    /// @copydoc ISubscriptionService::subscribe
+    Response subscribe(const Request& request) override;
+
+    /// @copydoc ISubscriptionService::unsubscribe
+    Response unsubscribe(const Request& request) override;
+
+    /// @brief Drop every subscription of a disconnected session.
+    void removeSession(uint64_t sessionId);
+
+    /// @brief Number of symbols @p sessionId is subscribed to.
+    std::size_t subscriptionCount(uint64_t sessionId) const;
+
+    /// @brief Updates that replaced a snapshot still waiting to be pushed.
+    uint64_t conflatedUpdates() const;
+
+private:
+    struct Session
+    {
+        std::vector<SymbolId>        symbols; ///< Subscribed symbol ids.
+        std::vector<SymbolId>        dirty;   ///< Updated while writing, in update order.
+        std::unordered_set<SymbolId> dirtySet;
+        bool                         writing{false};
+    };
+
+    void onUpdate(SymbolId id, const MarketDataPOD& snapshot);
+    void onDrained(uint64_t sessionId);
+    void publish(uint64_t sessionId, Response push);
+
+    /// Drop @p sessionId's subscription to @p id; m_mutex must be held.
+    void unsubscribeLocked(uint64_t sessionId, Session& session, SymbolId id);
+
+    std::shared_ptr<InMemoryMarketDataService> m_marketData;
+    InMemoryMarketDataService::ListenerId      m_listenerId{0};
+    ISessionPublisher*                         m_publisher{nullptr};
+
+    mutable std::mutex                          m_mutex;
+    std::unordered_map<uint64_t, Session>       m_sessions;
+    std::vector<std::vector<uint64_t>>          m_subscribers; ///< Session ids, indexed by SymbolId.
+    uint64_t                                    m_conflated{0};
+};
+
+#endif // SUBSCRIPTIONMANAGER_HPP
@@ -0,0 +1,167 @@
+/**
+ * @file SymbolTable.hpp
+ * @brief Insert-only interning table from char[32] symbols to dense ids.
+ *
+ * @details Symbols are interned once, when they are subscribed to or first
+ * seen on the feed. Each one gets the next dense id, which then indexes
+ * straight into per-symbol arrays. The table uses open addressing with a
+ * fixed power-of-two capacity. Inserts are serialised by a mutex, but
+ * lookups take no lock: an entry's key is fully written before its id is
+ * published with a release store, and readers load the id with acquire.
+ * Entries are never removed, so an id stays valid for the life of the table.
+ */
+
+#ifndef SYMBOLTABLE_HPP
+#define SYMBOLTABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+/// @brief Dense identifier of an interned symbol.
+using SymbolId = uint32_t;
+
+/// @brief Returned by lookups for symbols that were never interned.
+constexpr SymbolId kInvalidSymbolId = 0xFFFFFFFFu;
+
+/**
+ * @struct SymbolKey
+ * @brief Zero-padded 32-byte symbol, compared and hashed as raw bytes.
+ */
+struct SymbolKey
+{
+    static constexpr std::size_t kSize = 32;
+
+    char bytes[kSize]{};
+
+    SymbolKey() = default;
+
+    /// @brief Copy up to 31 characters of @p symbol (stops at the first NUL),
+    ///        so a fixed char[32] POD field need not be terminated.
+    explicit SymbolKey(const char* symbol)
+    {
+        for (std::size_t i = 0; i + 1 < kSize && symbol[i] != '\0'; ++i)
+            bytes[i] = symbol[i];
+    }
+
+    bool operator==(const SymbolKey& other) const
+    {
+        return std::memcmp(bytes, other.bytes, kSize) == 0;
+    }
+
+    /// @brief FNV-1a over the significant characters.
+    uint64_t hash() const
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (std::size_t i = 0; i < kSize && bytes[i] != '\0'; ++i)
+        {
+            h ^= static_cast<uint8_t>(bytes[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+};
+
+/**
+ * @class SymbolTable
+ * @brief Lock-free-read interning of symbols into [0, capacity) ids.
+ */
+class SymbolTable
+{
+public:
+    /**
+     * @param maxSymbols Maximum number of distinct symbols.
+     * @throws std::invalid_argument if @p maxSymbols is 0.
+     */
+    explicit SymbolTable(std::size_t maxSymbols)
+        : m_maxSymbols(maxSymbols)
+    {
+        if (maxSymbols == 0)
+            throw std::invalid_argument("[SymbolTable] maxSymbols must be at least 1");
+
+        // Keep the load factor at or below one half so probe chains stay short.
+        std::size_t buckets = 2;
+        while (buckets < maxSymbols * 2)
+            buckets <<= 1;
+        m_mask    = buckets - 1;
+        m_entries = std::make_unique<Entry[]>(buckets);
+        m_keys    = std::make_unique<SymbolKey[]>(maxSymbols);
+    }
+
+    /// @brief Id of @p key, or kInvalidSymbolId if it was never interned.
+    SymbolId find(const SymbolKey& key) const
+    {
+        for (std::size_t i = key.hash() & m_mask;; i = (i + 1) & m_mask)
+        {
+            const Entry& entry = m_entries[i];
+            const uint32_t idPlusOne = entry.idPlusOne.load(std::memory_order_acquire);
+            if (idPlusOne == 0)
+                return kInvalidSymbolId;
+            if (entry.key == key)
+                return idPlusOne - 1;
+        }
+    }
+
+    /**
+     * @brief Id of @p key, interning it first if needed.
+     * @throws std::length_error if the table already holds maxSymbols symbols.
+     */
+    SymbolId intern(const SymbolKey& key)
+    {
+        const SymbolId existing = find(key);
+        if (existing != kInvalidSymbolId)
+            return existing;
+
+        std::lock_guard<std::mutex> lock(m_insertMutex);
+        for (std::size_t i = key.hash() & m_mask;; i = (i + 1) & m_mask)
+        {
+            Entry& entry = m_entries[i];
+            const uint32_t idPlusOne = entry.idPlusOne.load(std::memory_order_relaxed);
+            if (idPlusOne != 0)
+            {
+                if (entry.key == key)
+                    return idPlusOne - 1; // raced with another insert
+                continue;
+            }
+
+            const std::size_t id = m_size.load(std::memory_order_relaxed);
+            if (id >= m_maxSymbols)
+                throw std::length_error("[SymbolTable] symbol capacity exhausted");
+
+            entry.key = key;
+            m_keys[id] = key;
+            m_size.store(id + 1, std::memory_order_release);
+            entry.idPlusOne.store(static_cast<uint32_t>(id + 1), std::memory_order_release);
+            return static_cast<SymbolId>(id);
+        }
+    }
+
+    /// @brief The symbol interned as @p id; @p id must be less than size().
+    const SymbolKey& key(SymbolId id) const { return m_keys[id]; }
+
+    /// @brief Number of interned symbols.
+    std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+    /// @brief Maximum number of symbols.
+    std::size_t capacity() const { return m_maxSymbols; }
+
+private:
+    struct Entry
+    {
+        std::atomic<uint32_t> idPlusOne{0}; ///< 0 while the bucket is empty.
+        SymbolKey             key;
+    };
+
+    std::size_t                  m_maxSymbols;
+    std::size_t                  m_mask{0};
+    std::unique_ptr<Entry[]>     m_entries;
+    std::unique_ptr<SymbolKey[]> m_keys;
+    std::atomic<std::size_t>     m_size{0};
+    std::mutex                   m_insertMutex;
+};
+
+#endif // SYMBOLTABLE_HPP
@@ -0,0 +1,412 @@
+/**
+ * @file MatchingEngine.cpp
+ * @brief Implementation of MatchingEngine.
+ */
+
+#include "MatchingEngine.hpp"
+
+#include "metrics/LatencyRecorder.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /// Records handed to a sink per call at most.
+    constexpr std::size_t kPublishBatch = 1024;
+
+    /// Sleep of the publisher when there was nothing to publish.
+    constexpr std::chrono::microseconds kPublishIdle{50};
+
+    constexpr uint8_t kMarketOrder = 0;
+    constexpr uint8_t kLimitOrder  = 1;
+    constexpr uint8_t kStopOrder   = 2;
+
+    int64_t nowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// Only the owner thread writes a shard counter, so a plain store suffices.
+    void bump(std::atomic<uint64_t>& counter, uint64_t by = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    Response reject(std::string message)
+    {
+        return Response{false, "MatchingEngine: " + message, {}};
+    }
+
+    TradePOD makeTrade(uint64_t tradeId, uint64_t orderId, const SymbolKey& symbol, double price,
+                       uint64_t quantity, uint8_t side, int64_t timestamp)
+    {
+        TradePOD trade{};
+        trade.tradeId = tradeId;
+        trade.orderId = orderId;
+        std::memcpy(trade.symbol, symbol.bytes, sizeof(trade.symbol));
+        trade.price     = price;
+        trade.quantity  = quantity;
+        trade.side      = side;
+        trade.timestamp = timestamp;
+        return trade;
+    }
+
+    /// Wait for room rather than drop the record; the publisher is draining.
+    template <typename T>
+    void publish(BoundedMpmcQueue<T>& queue, const T& record)
+    {
+        while (!queue.tryPush(record))
+            std::this_thread::yield();
+    }
+
+    /// Ack section followed by an empty or partly filled TradePOD section.
+    PooledBuffer ackPayload(const OrderAckPOD& ack, std::size_t fills)
+    {
+        PooledBuffer payload = PooledBuffer::uninitialized(pod::payloadSize<OrderAckPOD>(1)
+                                                           + pod::payloadSize<TradePOD>(fills));
+        uint8_t* out = payload.data() + pod::writeArray(payload.data(), &ack, 1);
+        const PayloadHeader header{static_cast<uint16_t>(PodSchema<TradePOD>::id), PodSchema<TradePOD>::version,
+                                   static_cast<uint32_t>(fills)};
+        std::memcpy(out, &header, sizeof(header));
+        return payload;
+    }
+} // namespace
+
+/// A validated request on its way to the owner of its symbol.
+struct MatchingEngine::Job
+{
+    Request          request;
+    ResponseCallback onComplete;
+    SymbolId         symbol{kInvalidSymbolId};
+    int64_t          priceTicks{0};
+};
+
+/// Books of the symbols with id % shards == index; touched only by the shard's owner thread.
+struct alignas(kCacheLineSize) MatchingEngine::Shard
+{
+    Shard(std::size_t shardIndex, const MatchingEngineConfig& config, int64_t firstTradeId)
+        : index(shardIndex)
+        , book(OrderBookConfig{(config.maxSymbols + config.shards - 1) / config.shards, config.ordersPerShard,
+                               config.levelsPerShard})
+        , executions(config.maxFillsPerOrder)
+        , lastTrade(static_cast<uint64_t>(firstTradeId))
+    {}
+
+    std::size_t                       index;
+    OrderBook                         book;
+    std::vector<OrderBook::Execution> executions; ///< Scratch of one submit.
+    uint64_t                          lastTrade;  ///< Shard-local trade sequence.
+
+    std::atomic<uint64_t> orders{0};
+    std::atomic<uint64_t> cancels{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> matches{0};
+    std::atomic<uint64_t> resting{0};
+};
+
+// ==========================================================================
+// Constructor / destructor
+// ==========================================================================
+
+MatchingEngine::MatchingEngine(MatchingEngineConfig config, TradeSink onTrades, OrderSink onOrders)
+    : m_config(config)
+    , m_symbols(config.maxSymbols == 0 ? 1 : config.maxSymbols)
+    , m_onTrades(std::move(onTrades))
+    , m_onOrders(std::move(onOrders))
+{
+    if (m_config.shards == 0 || m_config.maxSymbols == 0 || m_config.maxFillsPerOrder == 0
+        || m_config.queueCapacity == 0 || m_config.publishCapacity == 0)
+        throw std::invalid_argument("[MatchingEngine] shards, maxSymbols, maxFillsPerOrder and queue capacities "
+                                    "must be at least 1");
+    if (!(m_config.tickSize > 0.0))
+        throw std::invalid_argument("[MatchingEngine] tickSize must be positive");
+
+    if (m_onTrades)
+        m_trades = std::make_unique<BoundedMpmcQueue<TradePOD>>(m_config.publishCapacity);
+    if (m_onOrders)
+        m_orders = std::make_unique<BoundedMpmcQueue<OrderPOD>>(m_config.publishCapacity);
+
+    // Trade ids are (sequence * shards + shard), the sequence starting at the
+    // start time in microseconds: unique within a run, and above the ids of
+    // earlier runs unless one of them filled faster than once per microsecond.
+    const int64_t epoch = nowMicros();
+    m_shards.reserve(m_config.shards);
+    for (std::size_t i = 0; i < m_config.shards; ++i)
+        m_shards.push_back(std::make_unique<Shard>(i, m_config, epoch));
+    m_executor = std::make_unique<ShardedExecutor<Job>>(
+        ShardedExecutorConfig{m_config.shards, m_config.queueCapacity, m_config.firstCpu},
+        [this](std::size_t shard, Job& job) { run(shard, job); });
+    if (m_trades || m_orders)
+        m_publisher = std::thread([this]() { publishLoop(); });
+}
+
+MatchingEngine::~MatchingEngine()
+{
+    stop();
+}
+
+void MatchingEngine::stop()
+{
+    if (m_stopping.exchange(true))
+        return;
+
+    // Fail whatever is still queued so every callback runs exactly once.
+    m_executor->stop([](Job& job) { job.onComplete(reject("shutting down")); });
+
+    // The shards are joined: everything they published is drained before the publisher exits.
+    m_publisherStopping.store(true, std::memory_order_release);
+    if (m_publisher.joinable())
+        m_publisher.join();
+}
+
+// ==========================================================================
+// Caller side — validate, route, enqueue
+// ==========================================================================
+
+void MatchingEngine::submit(const Request& request, ResponseCallback onComplete)
+{
+    PodArrayView<OrderPOD> orders;
+    const PodDecodeStatus  status = bindRequest<RequestType::SUBMIT_ORDER>(request, orders);
+    if (status != PodDecodeStatus::OK)
+        return onComplete(reject(toString(status)));
+    if (orders.size() != 1)
+        return onComplete(reject("expected exactly one order"));
+
+    const OrderPOD& order = orders[0];
+    if (order.orderId == 0)
+        return onComplete(reject("order id 0 is reserved"));
+    if (order.quantity == 0)
+        return onComplete(reject("quantity must be positive"));
+    if (order.side != OrderBook::kBuy && order.side != OrderBook::kSell)
+        return onComplete(reject("side must be 0 (buy) or 1 (sell)"));
+    if (order.type == kStopOrder)
+        return onComplete(reject("stop orders are not supported"));
+    if (order.type != kMarketOrder && order.type != kLimitOrder)
+        return onComplete(reject("unknown order type"));
+
+    int64_t priceTicks = 0;
+    if (order.type == kLimitOrder)
+    {
+        const double ticks = std::round(order.price / m_config.tickSize);
+        if (!(ticks >= 1.0) || ticks > 9.0e15
+            || std::fabs(ticks * m_config.tickSize - order.price) > m_config.tickSize * 1e-6)
+            return onComplete(reject("limit price must be a positive multiple of the tick size"));
+        priceTicks = static_cast<int64_t>(ticks);
+    }
+
+    SymbolId symbol = kInvalidSymbolId;
+    try
+    {
+        symbol = m_symbols.intern(SymbolKey(order.symbol)); // locks only the first time a symbol is seen
+    }
+    catch (const std::length_error&)
+    {
+        return onComplete(reject("symbol capacity exhausted"));
+    }
+    enqueue(Job{request, std::move(onComplete), symbol, priceTicks});
+}
+
+void MatchingEngine::cancel(const Request& request, ResponseCallback onComplete)
+{
+    PodArrayView<OrderCancelPOD> cancels;
+    const PodDecodeStatus        status = bindRequest<RequestType::CANCEL_ORDER>(request, cancels);
+    if (status != PodDecodeStatus::OK)
+        return onComplete(reject(toString(status)));
+    if (cancels.size() != 1)
+        return onComplete(reject("expected exactly one cancel"));
+
+    // A symbol that never had an order has no resting ones.
+    const SymbolId symbol = m_symbols.find(SymbolKey(cancels[0].symbol));
+    if (symbol == kInvalidSymbolId)
+        return onComplete(reject("unknown order"));
+    enqueue(Job{request, std::move(onComplete), symbol, 0});
+}
+
+void MatchingEngine::enqueue(Job job)
+{
+    if (m_stopping.load(std::memory_order_relaxed))
+        return job.onComplete(reject("shutting down"));
+
+    // post() leaves the job intact on failure.
+    if (!m_executor->post(m_executor->shardOf(job.symbol), std::move(job)))
+        job.onComplete(reject(m_stopping.load(std::memory_order_relaxed) ? "shutting down" : "order queue full"));
+}
+
+// ==========================================================================
+// Owner side — match and reply
+// ==========================================================================
+
+void MatchingEngine::run(std::size_t shardIndex, Job& job)
+{
+    Shard& shard = *m_shards[shardIndex];
+    LatencyRecorder::instance().recordSince(job.request.type, LatencyStage::QUEUE, job.request.timing.decodedAt);
+    Response response;
+    {
+        const ScopedLatency timer(job.request.type, LatencyStage::SERVICE);
+        response = job.request.type == RequestType::CANCEL_ORDER ? processCancel(shard, job)
+                                                                 : processSubmit(shard, job);
+    }
+    job.onComplete(std::move(response));
+}
+
+Response MatchingEngine::processSubmit(Shard& shard, const Job& job)
+{
+    PodArrayView<OrderPOD> orders;
+    bindRequest<RequestType::SUBMIT_ORDER>(job.request, orders); // validated by submit()
+    const OrderPOD& order = orders[0];
+
+    const OrderBook::Order  entry{order.orderId, job.priceTicks, order.quantity, order.side,
+                                 order.type == kMarketOrder};
+    const OrderBook::Result result = shard.book.submit(job.symbol / m_shards.size(), entry,
+                                                       shard.executions.data(), shard.executions.size());
+    if (result.outcome == OrderBook::Outcome::DUPLICATE_ID)
+    {
+        bump(shard.rejected);
+        return reject("duplicate order id");
+    }
+    if (result.outcome == OrderBook::Outcome::BOOK_FULL && result.filled == 0)
+    {
+        bump(shard.rejected);
+        return reject("order book full");
+    }
+
+    const int64_t    now    = nowMicros();
+    const SymbolKey& symbol = m_symbols.key(job.symbol);
+    if (m_orders)
+    {
+        OrderPOD accepted = order;
+        if (accepted.timestamp == 0)
+            accepted.timestamp = now; // the journal files orders under the day of their timestamp
+        publish(*m_orders, accepted);
+    }
+
+    const OrderAckPOD ack{order.orderId, result.filled, result.remaining,
+                          static_cast<uint32_t>(result.executions), static_cast<uint8_t>(result.status), {}};
+    PooledBuffer payload = ackPayload(ack, result.executions);
+    uint8_t*     out     = payload.data() + pod::payloadSize<OrderAckPOD>(1) + sizeof(PayloadHeader);
+
+    const uint8_t contra = order.side == OrderBook::kBuy ? OrderBook::kSell : OrderBook::kBuy;
+    for (std::size_t i = 0; i < result.executions; ++i)
+    {
+        const OrderBook::Execution& execution = shard.executions[i];
+        const uint64_t tradeId = ++shard.lastTrade * m_shards.size() + shard.index;
+        const double   price   = static_cast<double>(execution.priceTicks) * m_config.tickSize;
+
+        const TradePOD own = makeTrade(tradeId, order.orderId, symbol, price, execution.quantity, order.side, now);
+        std::memcpy(out, &own, sizeof(own));
+        out += sizeof(own);
+        if (m_trades)
+        {
+            publish(*m_trades, own);
+            publish(*m_trades, makeTrade(tradeId, execution.restingOrderId, symbol, price, execution.quantity,
+                                         contra, now));
+        }
+    }
+
+    bump(shard.orders);
+    bump(shard.matches, result.executions);
+    shard.resting.store(shard.book.restingOrders(), std::memory_order_relaxed);
+
+    switch (result.outcome)
+    {
+    case OrderBook::Outcome::BOOK_FULL:  return Response{true, "Order book full: rest cancelled", std::move(payload)};
+    case OrderBook::Outcome::FILL_LIMIT: return Response{true, "Fill limit reached: rest cancelled", std::move(payload)};
+    default:                             break;
+    }
+    switch (result.status)
+    {
+    case OrderStatus::FILLED:  return Response{true, "Filled", std::move(payload)};
+    case OrderStatus::RESTING: return Response{true, "Resting", std::move(payload)};
+    default:                   return Response{true, "Cancelled", std::move(payload)};
+    }
+}
+
+Response MatchingEngine::processCancel(Shard& shard, const Job& job)
+{
+    PodArrayView<OrderCancelPOD> cancels;
+    bindRequest<RequestType::CANCEL_ORDER>(job.request, cancels); // validated by cancel()
+    const uint64_t orderId = cancels[0].orderId;
+
+    const OrderBook::Result result = shard.book.cancel(job.symbol / m_shards.size(), orderId);
+    if (result.outcome == OrderBook::Outcome::UNKNOWN_ORDER)
+    {
+        bump(shard.rejected);
+        return reject("unknown order");
+    }
+
+    bump(shard.cancels);
+    shard.resting.store(shard.book.restingOrders(), std::memory_order_relaxed);
+    const OrderAckPOD ack{orderId, 0, result.remaining, 0, static_cast<uint8_t>(OrderStatus::CANCELLED), {}};
+    return Response{true, "Cancelled", ackPayload(ack, 0)};
+}
+
+// ==========================================================================
+// Publisher — hand fills and accepted orders to the sinks
+// ==========================================================================
+
+void MatchingEngine::publishLoop()
+{
+    std::vector<OrderPOD> orders(kPublishBatch);
+    std::vector<TradePOD> trades(kPublishBatch);
+    for (;;)
+    {
+        // Read the flag first: whatever was published before it was set is drained below.
+        const bool stopping = m_publisherStopping.load(std::memory_order_acquire);
+        if (publishOnce(orders, trades) > 0)
+            continue;
+        if (stopping)
+            return;
+        std::this_thread::sleep_for(kPublishIdle);
+    }
+}
+
+std::size_t MatchingEngine::publishOnce(std::vector<OrderPOD>& orders, std::vector<TradePOD>& trades)
+{
+    std::size_t orderCount = 0;
+    while (m_orders && orderCount < orders.size() && m_orders->tryPop(orders[orderCount]))
+        ++orderCount;
+    std::size_t tradeCount = 0;
+    while (m_trades && tradeCount < trades.size() && m_trades->tryPop(trades[tradeCount]))
+        ++tradeCount;
+
+    try
+    {
+        if (orderCount > 0)
+            m_onOrders(orders.data(), orderCount);
+        if (tradeCount > 0)
+            m_onTrades(trades.data(), tradeCount);
+    }
+    catch (const std::exception&)
+    {
+        m_publishErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+    return orderCount + tradeCount;
+}
+
+MatchingEngineStats MatchingEngine::stats() const
+{
+    MatchingEngineStats stats;
+    for (const auto& shard : m_shards)
+    {
+        stats.orders += shard->orders.load(std::memory_order_relaxed);
+        stats.cancels += shard->cancels.load(std::memory_order_relaxed);
+        stats.rejected += shard->rejected.load(std::memory_order_relaxed);
+        stats.executions += shard->matches.load(std::memory_order_relaxed);
+        stats.resting += shard->resting.load(std::memory_order_relaxed);
+    }
+    stats.publishErrors = m_publishErrors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::size_t MatchingEngine::pinFailures() const
+{
+    return m_executor->pinFailures();
+}
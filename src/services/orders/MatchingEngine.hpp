@@ -0,0 +1,177 @@
+/**
+ * @file MatchingEngine.hpp
+ * @brief Order entry: per-symbol price-level books, each matched by the one
+ *        thread that owns its shard.
+ *
+ * @details Symbols are interned into dense ids and spread over
+ * MatchingEngineConfig::shards by id. A shard is an OrderBook with the
+ * books of its symbols, matched by the owner thread and drained from the
+ * inbound queue of one ShardedExecutor shard, optionally pinned to its own
+ * CPU. submit() and cancel() validate the request on the
+ * caller's thread, push it to the owning shard and return; the owner
+ * matches it and replies through the request's callback. No book is ever
+ * touched by two threads, so the books take no locks, and once the engine
+ * is constructed nothing on the order path allocates: requests and
+ * callbacks move through preallocated rings, orders and levels come from
+ * the books' pools, and replies are PooledBuffers.
+ *
+ *   SUBMIT_ORDER : PayloadHeader + 1 × OrderPOD
+ *   CANCEL_ORDER : PayloadHeader + 1 × OrderCancelPOD
+ *   Response data: PayloadHeader + 1 × OrderAckPOD
+ *                + PayloadHeader + N × TradePOD (the request's own fills)
+ *
+ * Market orders (OrderPOD::type 0) take what the opposite side offers and
+ * cancel the rest. Limit orders (type 1) match up to their price, which
+ * must lie on the tick grid, and rest the remainder. Stop orders are
+ * rejected. One order matches at most maxFillsPerOrder resting orders; a
+ * limit order that reaches that limit is not rested, since its remainder
+ * may still cross the book.
+ *
+ * Order ids are unique per symbol. A submit is refused as a duplicate only
+ * while an order with its id rests on the same symbol's book, and a cancel
+ * names the symbol of the order it takes off, so one id may rest on two
+ * symbols. The rule holds whichever shards the symbols land on: it does
+ * not change with MatchingEngineConfig::shards.
+ *
+ * Every match yields two TradePODs with the same tradeId, one for each
+ * order. Both go to the trade sink; accepted OrderPODs go to the order
+ * sink. The sinks run on a publisher thread that drains lock-free queues
+ * filled by the shards, so journal writes and the resident trade store
+ * never hold up matching. A full queue makes the shard wait for room
+ * rather than drop a fill.
+ */
+
+#ifndef MATCHINGENGINE_HPP
+#define MATCHINGENGINE_HPP
+
+#include "OrderBook.hpp"
+#include "SymbolTable.hpp"
+#include "concurrency/BoundedMpmcQueue.hpp"
+#include "concurrency/ShardedExecutor.hpp"
+#include "services/IOrderService.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct MatchingEngineConfig
+ * @brief Shards, capacities and price grid of a MatchingEngine.
+ */
+struct MatchingEngineConfig
+{
+    /// @brief Owner threads; a symbol belongs to shard (symbol id % shards).
+    std::size_t shards{1};
+
+    /// @brief Symbols with a book, over all shards.
+    std::size_t maxSymbols{4096};
+
+    /// @brief Resting orders one shard can hold.
+    std::size_t ordersPerShard{65536};
+
+    /// @brief Price levels one shard can hold.
+    std::size_t levelsPerShard{16384};
+
+    /// @brief Resting orders one incoming order matches at most.
+    std::size_t maxFillsPerOrder{256};
+
+    /// @brief Requests waiting for one shard; a full queue rejects.
+    std::size_t queueCapacity{4096};
+
+    /// @brief Trades, and accepted orders, waiting for the publisher.
+    std::size_t publishCapacity{65536};
+
+    /// @brief Price increment; limit prices must be positive multiples of it.
+    double tickSize{0.01};
+
+    /// @brief Pin shard i to CPU (firstCpu + i) % cores; -1 leaves the owner threads unpinned.
+    int firstCpu{-1};
+};
+
+/**
+ * @struct MatchingEngineStats
+ * @brief Counters of a MatchingEngine, all since construction.
+ */
+struct MatchingEngineStats
+{
+    uint64_t orders{0};        ///< Orders matched (and possibly rested).
+    uint64_t cancels{0};       ///< Resting orders cancelled.
+    uint64_t rejected{0};      ///< Requests the books refused: duplicate id, book full, unknown order.
+    uint64_t executions{0};    ///< Matches, each reported as two TradePODs.
+    uint64_t resting{0};       ///< Orders on the books now.
+    uint64_t publishErrors{0}; ///< Batches whose sink threw.
+};
+
+/**
+ * @class MatchingEngine
+ * @brief Sharded, single-writer limit order books behind IOrderService.
+ */
+class MatchingEngine : public IOrderService
+{
+public:
+    /// @brief Receives fills on the publisher thread, in match order per shard.
+    using TradeSink = std::function<void(const TradePOD* trades, std::size_t count)>;
+
+    /// @brief Receives accepted orders on the publisher thread.
+    using OrderSink = std::function<void(const OrderPOD* orders, std::size_t count)>;
+
+    /**
+     * @brief Allocate the books and queues and start the shard threads, and
+     *        the publisher if there is a sink.
+     * @throws std::invalid_argument if a count or capacity is 0 or the tick size is not positive.
+     */
+    explicit MatchingEngine(MatchingEngineConfig config = {}, TradeSink onTrades = {}, OrderSink onOrders = {});
+
+    /// Stops as stop() does.
+    ~MatchingEngine() override;
+
+    MatchingEngine(const MatchingEngine&)            = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    /// @copydoc IOrderService::submit
+    void submit(const Request& request, ResponseCallback onComplete) override;
+
+    /// @copydoc IOrderService::cancel
+    void cancel(const Request& request, ResponseCallback onComplete) override;
+
+    /// @brief Join the shards, fail what they had queued, then publish the rest and join the publisher.
+    void stop();
+
+    /// @brief Snapshot of the counters.
+    MatchingEngineStats stats() const;
+
+    /// @brief Owner threads that asked for a CPU and could not be pinned to it.
+    std::size_t pinFailures() const;
+
+private:
+    struct Job;
+    struct Shard;
+
+    void enqueue(Job job);
+    void run(std::size_t shard, Job& job);
+    Response processSubmit(Shard& shard, const Job& job);
+    Response processCancel(Shard& shard, const Job& job);
+    void publishLoop();
+    std::size_t publishOnce(std::vector<OrderPOD>& orders, std::vector<TradePOD>& trades);
+
+    MatchingEngineConfig m_config;
+    SymbolTable          m_symbols;
+    TradeSink            m_onTrades;
+    OrderSink            m_onOrders;
+
+    std::vector<std::unique_ptr<Shard>>         m_shards;
+    std::unique_ptr<ShardedExecutor<Job>>       m_executor;
+    std::unique_ptr<BoundedMpmcQueue<TradePOD>> m_trades; ///< Null without a trade sink.
+    std::unique_ptr<BoundedMpmcQueue<OrderPOD>> m_orders; ///< Null without an order sink.
+
+    std::atomic<bool>     m_stopping{false};
+    std::atomic<bool>     m_publisherStopping{false};
+    std::atomic<uint64_t> m_publishErrors{0};
+    std::thread           m_publisher;
+};
+
+#endif // MATCHINGENGINE_HPP
@@ -0,0 +1,269 @@
+/**
+ * @file OrderBook.cpp
+ * @brief Implementation of OrderIndex and OrderBook.
+ */
+
+#include "OrderBook.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+// ==========================================================================
+// OrderIndex
+// ==========================================================================
+
+OrderIndex::OrderIndex(std::size_t maxOrders)
+{
+    std::size_t buckets = 2;
+    unsigned    bits    = 1;
+    while (buckets < maxOrders * 2)
+    {
+        buckets <<= 1;
+        ++bits;
+    }
+    m_entries.resize(buckets);
+    m_mask  = buckets - 1;
+    m_shift = 64 - bits;
+}
+
+uint32_t OrderIndex::find(uint32_t book, uint64_t orderId) const
+{
+    for (std::size_t i = home(book, orderId);; i = (i + 1) & m_mask)
+    {
+        const Entry& entry = m_entries[i];
+        if (entry.orderId == orderId && entry.book == book)
+            return entry.node;
+        if (entry.orderId == 0)
+            return kNilIndex;
+    }
+}
+
+void OrderIndex::insert(uint32_t book, uint64_t orderId, uint32_t node)
+{
+    std::size_t i = home(book, orderId);
+    while (m_entries[i].orderId != 0)
+        i = (i + 1) & m_mask;
+    m_entries[i] = Entry{orderId, book, node};
+}
+
+void OrderIndex::erase(uint32_t book, uint64_t orderId)
+{
+    std::size_t hole = home(book, orderId);
+    while (m_entries[hole].orderId != orderId || m_entries[hole].book != book)
+        hole = (hole + 1) & m_mask;
+
+    // Move later entries of the chain into the hole unless that would put
+    // them before their home bucket.
+    for (std::size_t i = (hole + 1) & m_mask; m_entries[i].orderId != 0; i = (i + 1) & m_mask)
+    {
+        const std::size_t h       = home(m_entries[i].book, m_entries[i].orderId);
+        const bool        stayPut = hole <= i ? (hole < h && h <= i) : (hole < h || h <= i);
+        if (stayPut)
+            continue;
+        m_entries[hole] = m_entries[i];
+        hole            = i;
+    }
+    m_entries[hole] = Entry{};
+}
+
+// ==========================================================================
+// OrderBook — construction and queries
+// ==========================================================================
+
+OrderBook::OrderBook(const OrderBookConfig& config)
+    : m_books(config.books)
+    , m_orders(config.maxOrders)
+    , m_levels(config.maxLevels)
+    , m_index(config.maxOrders)
+{
+    if (config.books == 0 || config.maxOrders == 0 || config.maxLevels == 0)
+        throw std::invalid_argument("[OrderBook] books, maxOrders and maxLevels must be at least 1");
+    if (config.books >= kNilIndex || config.maxOrders >= kNilIndex || config.maxLevels >= kNilIndex)
+        throw std::invalid_argument("[OrderBook] capacities must fit 32-bit indices");
+}
+
+bool OrderBook::best(std::size_t book, uint8_t side, Level& out) const
+{
+    const uint32_t index = m_books[book].best[side];
+    if (index == kNilIndex)
+        return false;
+    const LevelNode& level = m_levels[index];
+    out                    = Level{level.priceTicks, level.quantity, level.orders};
+    return true;
+}
+
+// ==========================================================================
+// Matching
+// ==========================================================================
+
+OrderBook::Result OrderBook::submit(std::size_t book, const Order& order, Execution* executions,
+                                    std::size_t maxExecutions)
+{
+    Result result;
+    result.remaining = order.quantity;
+    if (m_index.find(static_cast<uint32_t>(book), order.orderId) != kNilIndex)
+    {
+        result.outcome = Outcome::DUPLICATE_ID;
+        return result;
+    }
+
+    // The head of the opposite side is the best price; its head order the oldest.
+    uint32_t& best      = m_books[book].best[order.side == kBuy ? kSell : kBuy];
+    uint64_t  remaining = order.quantity;
+    while (remaining > 0 && best != kNilIndex)
+    {
+        LevelNode& level = m_levels[best];
+        if (!order.market && better(order.side, level.priceTicks, order.priceTicks))
+            break; // past the limit price
+        if (result.executions == maxExecutions)
+        {
+            result.outcome = Outcome::FILL_LIMIT;
+            break;
+        }
+
+        const uint32_t head     = level.head;
+        OrderNode&     resting  = m_orders[head];
+        const uint64_t quantity = std::min(remaining, resting.quantity);
+        executions[result.executions++] = Execution{resting.orderId, level.priceTicks, quantity};
+
+        remaining -= quantity;
+        resting.quantity -= quantity;
+        level.quantity -= quantity;
+        if (resting.quantity == 0)
+            removeOrder(head); // may remove the level and advance best
+    }
+
+    result.filled    = order.quantity - remaining;
+    result.remaining = remaining;
+    if (remaining == 0)
+    {
+        result.status = OrderStatus::FILLED;
+        return result;
+    }
+    if (order.market || result.outcome == Outcome::FILL_LIMIT)
+        return result; // CANCELLED: a remainder past the fill limit may still cross
+
+    if (!rest(book, order, remaining))
+    {
+        result.outcome = Outcome::BOOK_FULL;
+        return result;
+    }
+    result.status = OrderStatus::RESTING;
+    return result;
+}
+
+OrderBook::Result OrderBook::cancel(std::size_t book, uint64_t orderId)
+{
+    Result         result;
+    const uint32_t node = m_index.find(static_cast<uint32_t>(book), orderId);
+    if (node == kNilIndex)
+    {
+        result.outcome = Outcome::UNKNOWN_ORDER;
+        return result;
+    }
+
+    const OrderNode& order = m_orders[node];
+    result.remaining       = order.quantity;
+    m_levels[order.level].quantity -= order.quantity;
+    removeOrder(node);
+    return result;
+}
+
+// ==========================================================================
+// Intrusive lists
+// ==========================================================================
+
+bool OrderBook::rest(std::size_t book, const Order& order, uint64_t quantity)
+{
+    const uint32_t node = m_orders.acquire();
+    if (node == kNilIndex)
+        return false;
+    const uint32_t levelIndex = levelFor(book, order.side, order.priceTicks);
+    if (levelIndex == kNilIndex)
+    {
+        m_orders.release(node);
+        return false;
+    }
+
+    LevelNode& level = m_levels[levelIndex];
+    m_orders[node]   = OrderNode{order.orderId, quantity, level.tail, kNilIndex, levelIndex,
+                               static_cast<uint32_t>(book)};
+    if (level.tail != kNilIndex)
+        m_orders[level.tail].next = node;
+    else
+        level.head = node;
+    level.tail = node;
+    level.quantity += quantity;
+    ++level.orders;
+
+    m_index.insert(static_cast<uint32_t>(book), order.orderId, node);
+    return true;
+}
+
+uint32_t OrderBook::levelFor(std::size_t book, uint8_t side, int64_t priceTicks)
+{
+    // Walk from the touch past every better level.
+    uint32_t& head = m_books[book].best[side];
+    uint32_t  prev = kNilIndex;
+    uint32_t  next = head;
+    while (next != kNilIndex && better(side, m_levels[next].priceTicks, priceTicks))
+    {
+        prev = next;
+        next = m_levels[next].next;
+    }
+    if (next != kNilIndex && m_levels[next].priceTicks == priceTicks)
+        return next;
+
+    const uint32_t index = m_levels.acquire();
+    if (index == kNilIndex)
+        return kNilIndex;
+
+    LevelNode& level = m_levels[index];
+    level            = LevelNode{};
+    level.priceTicks = priceTicks;
+    level.prev       = prev;
+    level.next       = next;
+    level.side       = side;
+    if (prev != kNilIndex)
+        m_levels[prev].next = index;
+    else
+        head = index;
+    if (next != kNilIndex)
+        m_levels[next].prev = index;
+    return index;
+}
+
+void OrderBook::removeOrder(uint32_t node)
+{
+    const OrderNode& order      = m_orders[node];
+    const uint32_t   levelIndex = order.level;
+    LevelNode&       level      = m_levels[levelIndex];
+
+    if (order.prev != kNilIndex)
+        m_orders[order.prev].next = order.next;
+    else
+        level.head = order.next;
+    if (order.next != kNilIndex)
+        m_orders[order.next].prev = order.prev;
+    else
+        level.tail = order.prev;
+    --level.orders;
+
+    const uint32_t book = order.book;
+    m_index.erase(book, order.orderId);
+    m_orders.release(node);
+    if (level.head == kNilIndex)
+        removeLevel(book, levelIndex);
+}
+
+void OrderBook::removeLevel(uint32_t book, uint32_t index)
+{
+    const LevelNode& level = m_levels[index];
+    if (level.prev != kNilIndex)
+        m_levels[level.prev].next = level.next;
+    else
+        m_books[book].best[level.side] = level.next;
+    if (level.next != kNilIndex)
+        m_levels[level.next].prev = level.prev;
+    m_levels.release(index);
+}
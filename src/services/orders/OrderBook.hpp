@@ -0,0 +1,263 @@
+/**
+ * @file OrderBook.hpp
+ * @brief Price-level limit order books of one shard, in preallocated pools.
+ *
+ * @details One OrderBook holds the books of every symbol its shard owns and
+ * is only used by the shard's owner thread, so nothing in it is atomic or
+ * locked. All memory is allocated by the constructor:
+ *
+ *   - orders and price levels live in fixed-capacity NodePools and are
+ *     linked by 32-bit indices instead of pointers;
+ *   - each level is an intrusive FIFO of its orders (time priority);
+ *   - each side of a book is an intrusive list of its levels, best price
+ *     first: matching takes the head, and a new resting order walks from
+ *     the touch to its price, which is short because orders arrive near it;
+ *   - an OrderIndex maps (book, id) of resting orders to their nodes, so a
+ *     cancel unlinks its order without searching. Ids are scoped to their
+ *     book: the same id may rest in two books, whichever shards own them.
+ *
+ * Prices are integer ticks. MatchingEngine converts them from and to the
+ * doubles of the wire PODs.
+ */
+
+#ifndef ORDERBOOK_HPP
+#define ORDERBOOK_HPP
+
+#include "pod/TradingPOD.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief "No node" in the index-linked lists below.
+constexpr uint32_t kNilIndex = 0xFFFFFFFFu;
+
+/**
+ * @class NodePool
+ * @brief Fixed array of nodes with an intrusive free list through Node::next.
+ * @tparam Node Default-constructible node with a uint32_t @c next member.
+ */
+template <typename Node>
+class NodePool
+{
+public:
+    explicit NodePool(std::size_t capacity)
+        : m_nodes(capacity)
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+            m_nodes[i].next = i + 1 < capacity ? static_cast<uint32_t>(i + 1) : kNilIndex;
+        m_free = capacity > 0 ? 0 : kNilIndex;
+    }
+
+    /// @brief Index of a free node, or kNilIndex if the pool is exhausted.
+    uint32_t acquire()
+    {
+        const uint32_t index = m_free;
+        if (index != kNilIndex)
+        {
+            m_free = m_nodes[index].next;
+            ++m_used;
+        }
+        return index;
+    }
+
+    /// @brief Return the node at @p index to the pool.
+    void release(uint32_t index)
+    {
+        m_nodes[index].next = m_free;
+        m_free              = index;
+        --m_used;
+    }
+
+    Node&       operator[](uint32_t index) { return m_nodes[index]; }
+    const Node& operator[](uint32_t index) const { return m_nodes[index]; }
+
+    std::size_t used() const { return m_used; }
+    std::size_t capacity() const { return m_nodes.size(); }
+
+private:
+    std::vector<Node> m_nodes;
+    uint32_t          m_free{kNilIndex};
+    std::size_t       m_used{0};
+};
+
+/**
+ * @class OrderIndex
+ * @brief Open-addressing map from (book, order id) to node index, sized up front.
+ *
+ * @details Linear probing at a load factor of at most one half; erase()
+ * shifts the rest of the probe chain back instead of leaving tombstones,
+ * so lookups never slow down as orders come and go. Id 0 marks an empty
+ * bucket and cannot be stored.
+ */
+class OrderIndex
+{
+public:
+    /// @param maxOrders Most ids stored at once.
+    explicit OrderIndex(std::size_t maxOrders);
+
+    /// @brief Node of @p orderId in @p book, or kNilIndex.
+    uint32_t find(uint32_t book, uint64_t orderId) const;
+
+    /// @brief Store @p orderId of @p book; it must not be stored already.
+    void insert(uint32_t book, uint64_t orderId, uint32_t node);
+
+    /// @brief Remove @p orderId of @p book; it must be stored.
+    void erase(uint32_t book, uint64_t orderId);
+
+private:
+    struct Entry
+    {
+        uint64_t orderId{0};
+        uint32_t book{0};
+        uint32_t node{kNilIndex};
+    };
+
+    std::size_t home(uint32_t book, uint64_t orderId) const
+    {
+        const uint64_t key = orderId ^ (static_cast<uint64_t>(book) * 0xC2B2AE3D27D4EB4Full);
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    std::vector<Entry> m_entries;
+    std::size_t        m_mask{0};
+    unsigned           m_shift{0};
+};
+
+/**
+ * @struct OrderBookConfig
+ * @brief Capacities of an OrderBook, shared by all of its books.
+ */
+struct OrderBookConfig
+{
+    std::size_t books{1024};      ///< Symbols the shard keeps a book for.
+    std::size_t maxOrders{65536}; ///< Resting orders over all books.
+    std::size_t maxLevels{16384}; ///< Price levels over all books.
+};
+
+/**
+ * @class OrderBook
+ * @brief The books of one shard: price-time priority matching in ticks.
+ */
+class OrderBook
+{
+public:
+    static constexpr uint8_t kBuy  = 0; ///< OrderPOD::side of a buy.
+    static constexpr uint8_t kSell = 1; ///< OrderPOD::side of a sell.
+
+    /// @brief An order to match; @c priceTicks is ignored for market orders.
+    struct Order
+    {
+        uint64_t orderId;
+        int64_t  priceTicks;
+        uint64_t quantity;
+        uint8_t  side;
+        bool     market;
+    };
+
+    /// @brief One match of the incoming order against a resting one.
+    struct Execution
+    {
+        uint64_t restingOrderId;
+        int64_t  priceTicks; ///< The resting order's price.
+        uint64_t quantity;
+    };
+
+    enum class Outcome : uint8_t
+    {
+        ACCEPTED,      ///< Matched and, if a limit order, rested as the status says.
+        DUPLICATE_ID,  ///< An order with this id is resting in the book; nothing was done.
+        BOOK_FULL,     ///< No order node or level was left to rest the remainder.
+        FILL_LIMIT,    ///< maxExecutions reached; the remainder was not rested.
+        UNKNOWN_ORDER, ///< cancel(): no such resting order in this book.
+    };
+
+    struct Result
+    {
+        Outcome     outcome{Outcome::ACCEPTED};
+        OrderStatus status{OrderStatus::CANCELLED};
+        uint64_t    filled{0};
+        uint64_t    remaining{0}; ///< Resting if RESTING, cancelled otherwise.
+        std::size_t executions{0};
+    };
+
+    /// @brief Best level of one side of a book.
+    struct Level
+    {
+        int64_t     priceTicks{0};
+        uint64_t    quantity{0};
+        std::size_t orders{0};
+    };
+
+    /**
+     * @brief Allocate the pools and the order index.
+     * @throws std::invalid_argument if a capacity is 0 or does not fit 32-bit indices.
+     */
+    explicit OrderBook(const OrderBookConfig& config);
+
+    OrderBook(const OrderBook&)            = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    /**
+     * @brief Match @p order against book @p book, then rest a limit order's remainder.
+     * @param executions    Receives the matches, in order.
+     * @param maxExecutions Room in @p executions; matching stops when it is full.
+     */
+    Result submit(std::size_t book, const Order& order, Execution* executions, std::size_t maxExecutions);
+
+    /// @brief Take resting order @p orderId off book @p book.
+    Result cancel(std::size_t book, uint64_t orderId);
+
+    /// @brief Best level of @p side in @p book; false if that side is empty.
+    bool best(std::size_t book, uint8_t side, Level& out) const;
+
+    /// @brief Resting orders over all books.
+    std::size_t restingOrders() const { return m_orders.used(); }
+
+    /// @brief Price levels in use over all books.
+    std::size_t levels() const { return m_levels.used(); }
+
+private:
+    struct OrderNode
+    {
+        uint64_t orderId{0};
+        uint64_t quantity{0};
+        uint32_t prev{kNilIndex}; ///< Earlier order at the same level.
+        uint32_t next{kNilIndex}; ///< Later order at the same level; free list link.
+        uint32_t level{kNilIndex};
+        uint32_t book{0};
+    };
+
+    struct LevelNode
+    {
+        int64_t  priceTicks{0};
+        uint64_t quantity{0};
+        uint32_t head{kNilIndex}; ///< Oldest order.
+        uint32_t tail{kNilIndex}; ///< Newest order.
+        uint32_t prev{kNilIndex}; ///< Better level of the same side.
+        uint32_t next{kNilIndex}; ///< Worse level of the same side; free list link.
+        uint32_t orders{0};
+        uint8_t  side{kBuy};
+    };
+
+    /// Best level of each side (indexed by side) of one book.
+    struct Sides
+    {
+        uint32_t best[2]{kNilIndex, kNilIndex};
+    };
+
+    /// True if @p a is a better price than @p b for @p side.
+    static bool better(uint8_t side, int64_t a, int64_t b) { return side == kBuy ? a > b : a < b; }
+
+    bool     rest(std::size_t book, const Order& order, uint64_t quantity);
+    uint32_t levelFor(std::size_t book, uint8_t side, int64_t priceTicks);
+    void     removeOrder(uint32_t node);
+    void     removeLevel(uint32_t book, uint32_t level);
+
+    std::vector<Sides>  m_books;
+    NodePool<OrderNode> m_orders;
+    NodePool<LevelNode> m_levels;
+    OrderIndex          m_index;
+};
+
+#endif // ORDERBOOK_HPP
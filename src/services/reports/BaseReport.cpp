@@ -5,6 +5,15 @@
 
 #include "services/reports/BaseReport.hpp"
 
+#include "models/TradingDate.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 Report BaseReport::generate(const ReportRequest& request)
 {
     // Step 1: Retrieve raw data from the data source.
@@ -20,3 +29,100 @@ Report BaseReport::generate(const ReportRequest& request)
     //               enrich, postProcess) by adding virtual methods to
     //               BaseReport.hpp and calling them in this sequence.
 }
+
+// ==========================================================================
+// generateStreaming() — day partitions, parallel per window, in-order output
+// ==========================================================================
+
+namespace
+{
+    /// Run @p produce for every needed day, one window at a time, and pass the results to @p sink in date order.
+    template <typename Result, typename Produce, typename Sink>
+    void streamDays(const ReportRequest& request, ForkJoinPool& pool, const ReportDayFilter& needed,
+                    const Produce& produce, const Sink& sink)
+    {
+        const TradingDate from = request.dateFrom;
+        const TradingDate to   = request.dateTo;
+        if (!from.inIsoRange() || !to.inIsoRange())
+            throw std::invalid_argument("dates must be within 0000-01-01 .. 9999-12-31");
+        if (to < from)
+            throw std::invalid_argument("dateFrom is after dateTo");
+
+        std::vector<TradingDate> days;
+        days.reserve(static_cast<std::size_t>(static_cast<int64_t>(to.days) - from.days) + 1);
+        for (TradingDate day = from; day <= to; day = day + 1)
+        {
+            if (!needed || needed(day))
+                days.push_back(day);
+        }
+        if (days.empty())
+            return;
+
+        const std::size_t window = std::min(days.size(), pool.concurrency());
+
+        std::vector<Result>             results(window);
+        std::vector<std::exception_ptr> errors(window);
+
+        for (std::size_t first = 0; first < days.size(); first += window)
+        {
+            const std::size_t count = std::min(window, days.size() - first);
+            for (std::size_t i = 0; i < count; ++i)
+                errors[i] = nullptr;
+
+            pool.parallelFor(count, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    try
+                    {
+                        results[i] = produce(days[first + i]);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            });
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (errors[i])
+                    std::rethrow_exception(errors[i]);
+                sink(days[first + i], std::move(results[i]));
+                results[i] = Result{};
+            }
+        }
+    }
+} // namespace
+
+void BaseReport::generateStreaming(const ReportRequest& request, ForkJoinPool& pool,
+                                   const ReportChunkSink& sink, const ReportDayFilter& needed)
+{
+    streamDays<Report>(
+        request, pool, needed,
+        [&](TradingDate day) {
+            ReportRequest partition = request;
+            partition.dateFrom      = day;
+            partition.dateTo        = day;
+            return generate(partition);
+        },
+        sink);
+}
+
+void BaseReport::generateColumnarStreaming(const ReportRequest& request, ForkJoinPool& pool,
+                                           const ReportBlockSink& sink, const ReportDayFilter& needed)
+{
+    if (!supportsColumnar())
+        throw std::logic_error("report has no columnar format");
+    streamDays<PooledBuffer>(
+        request, pool, needed, [&](TradingDate day) { return writeColumns(day); }, sink);
+}
+
+bool BaseReport::isFinal(TradingDate) const
+{
+    return true;
+}
+
+PooledBuffer BaseReport::writeColumns(TradingDate)
+{
+    throw std::logic_error("report has no columnar format");
+}
@@ -5,30 +5,148 @@
 
 #include "EndOfDayReport.hpp"
 
+#include "PodJournal.hpp"
+#include "ReportBlockWriter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    /// "date,symbol,open,high,low,close,volume,vwap,buyVolume,sellVolume,fills".
+    std::string summaryRow(const std::string& date, const SymbolDaySummary& entry)
+    {
+        const OhlcvBar& day = entry.summary.ohlcv;
+        char            row[256];
+        const int       length = std::snprintf(
+            row, sizeof(row), "%s,%s,%.10g,%.10g,%.10g,%.10g,%llu,%.10g,%llu,%llu,%u", date.c_str(),
+            entry.symbol.bytes, day.open, day.high, day.low, day.close, static_cast<unsigned long long>(day.volume),
+            day.vwap(), static_cast<unsigned long long>(entry.summary.sides[0].quantity),
+            static_cast<unsigned long long>(entry.summary.sides[1].quantity), day.fills);
+        return std::string(row, static_cast<std::size_t>(length > 0 ? length : 0));
+    }
+
+    struct SymbolKeyHash
+    {
+        std::size_t operator()(const SymbolKey& key) const { return static_cast<std::size_t>(key.hash()); }
+    };
+} // namespace
+
+std::vector<SymbolDaySummary> journalDaySummaries(const JournalConfig& trades, TradingDate day)
+{
+    const auto                    view = PodJournal<TradePOD>::openDay(trades, day);
+    std::vector<SymbolDaySummary> out;
+    if (!view.day)
+        return out;
+
+    // One day-wide bar per symbol: only the daily summaries are read.
+    TradeAggregates aggregates(TradeAggregatesConfig{PodJournal<TradePOD>::kMicrosPerDay, 1});
+    std::unordered_map<SymbolKey, uint32_t, SymbolKeyHash> codes;
+    std::vector<SymbolKey>                                 symbols;
+    for (const TradePOD& trade : view.records)
+    {
+        const SymbolKey symbol(trade.symbol);
+        const auto      code = codes.emplace(symbol, static_cast<uint32_t>(symbols.size()));
+        if (code.second)
+            symbols.push_back(symbol);
+        aggregates.record(trade, code.first->second);
+    }
+
+    std::vector<DaySummary> summaries;
+    for (uint32_t code = 0; code < symbols.size(); ++code)
+    {
+        summaries.clear();
+        aggregates.days(code, day.days, day.days + 1, summaries);
+        for (const DaySummary& summary : summaries)
+            out.push_back(SymbolDaySummary{symbols[code], summary});
+    }
+    std::sort(out.begin(), out.end(), [](const SymbolDaySummary& a, const SymbolDaySummary& b) {
+        return std::memcmp(a.symbol.bytes, b.symbol.bytes, SymbolKey::kSize) < 0;
+    });
+    return out;
+}
+
+EndOfDayReport::EndOfDayReport(DaySummarySource source, DayCompleteCheck complete)
+    : m_source(std::move(source))
+    , m_complete(std::move(complete))
+{}
+
+bool EndOfDayReport::isFinal(TradingDate day) const
+{
+    return !m_complete || m_complete(day);
+}
+
 ReportData EndOfDayReport::fetchData(const ReportRequest& request)
 {
-    // TODO: IMPLEMENT — Query the database for all trades, positions, and P&L
-    //                   for the date range [request.dateFrom, request.dateTo].
-    //                   Example:
-    //                     return m_db->query(
-    //                         "SELECT * FROM trades WHERE date BETWEEN ? AND ?",
-    //                         request.dateFrom, request.dateTo);
-    (void)request;
-    return {};
+    ReportData rows;
+    if (!m_source)
+        return rows;
+    for (TradingDate day = request.dateFrom; day <= request.dateTo; day = day + 1)
+    {
+        const std::string date = day.toIso();
+        for (const SymbolDaySummary& entry : m_source(day))
+            rows.push_back(summaryRow(date, entry));
+    }
+    return rows;
 }
 
 ReportData EndOfDayReport::computeReport(const ReportData& data)
 {
-    // TODO: IMPLEMENT — Aggregate raw trade rows: sum volumes, compute net P&L,
-    //                   group by symbol, calculate average prices, etc.
-    (void)data;
-    return {};
+    // TODO: IMPLEMENT — Compute net P&L from positions once fetchData() has
+    //                   them; the trade figures are already aggregated.
+    return data;
 }
 
 Report EndOfDayReport::format(const ReportData& data)
 {
-    // TODO: IMPLEMENT — Transform computed rows into the final report layout,
-    //                   e.g., CSV lines, JSON, or a fixed-width text table.
-    (void)data;
-    return {};
+    // TODO: IMPLEMENT — Transform computed rows into another report layout,
+    //                   e.g. JSON or a fixed-width text table; rows are CSV.
+    return data;
+}
+
+PooledBuffer EndOfDayReport::writeColumns(TradingDate day)
+{
+    if (!m_source)
+        return PooledBuffer{};
+    const std::vector<SymbolDaySummary> entries = m_source(day);
+    if (entries.empty())
+        return PooledBuffer{};
+
+    std::size_t textBytes = 0;
+    for (const SymbolDaySummary& entry : entries)
+        textBytes += ::strnlen(entry.symbol.bytes, sizeof(entry.symbol.bytes));
+
+    ReportBlockWriter writer(day, static_cast<uint32_t>(entries.size()));
+    const auto symbol     = writer.addColumn("symbol", ReportColumnType::UTF8, textBytes);
+    const auto open       = writer.addColumn("open", ReportColumnType::FLOAT64);
+    const auto high       = writer.addColumn("high", ReportColumnType::FLOAT64);
+    const auto low        = writer.addColumn("low", ReportColumnType::FLOAT64);
+    const auto close      = writer.addColumn("close", ReportColumnType::FLOAT64);
+    const auto volume     = writer.addColumn("volume", ReportColumnType::UINT64);
+    const auto vwap       = writer.addColumn("vwap", ReportColumnType::FLOAT64);
+    const auto buyVolume  = writer.addColumn("buyVolume", ReportColumnType::UINT64);
+    const auto sellVolume = writer.addColumn("sellVolume", ReportColumnType::UINT64);
+    const auto fills      = writer.addColumn("fills", ReportColumnType::UINT32);
+    writer.allocate();
+
+    for (uint32_t row = 0; row < entries.size(); ++row)
+    {
+        const SymbolDaySummary& entry = entries[row];
+        const OhlcvBar&         bar   = entry.summary.ohlcv;
+        writer.appendText(symbol, entry.symbol.bytes, ::strnlen(entry.symbol.bytes, sizeof(entry.symbol.bytes)));
+        writer.set(open, row, bar.open);
+        writer.set(high, row, bar.high);
+        writer.set(low, row, bar.low);
+        writer.set(close, row, bar.close);
+        writer.set(volume, row, static_cast<uint64_t>(bar.volume));
+        writer.set(vwap, row, bar.vwap());
+        writer.set(buyVolume, row, static_cast<uint64_t>(entry.summary.sides[0].quantity));
+        writer.set(sellVolume, row, static_cast<uint64_t>(entry.summary.sides[1].quantity));
+        writer.set(fills, row, static_cast<uint32_t>(bar.fills));
+    }
+    return writer.finish();
 }
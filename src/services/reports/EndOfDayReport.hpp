@@ -5,13 +5,54 @@
  * @details Produces a daily summary of all trades, positions, and P&L for a
  * given trading session. Overrides all three pipeline steps defined in
  * BaseReport.
+ *
+ * With a DaySummarySource, each day has one CSV row per traded symbol:
+ *
+ *     date,symbol,open,high,low,close,volume,vwap,buyVolume,sellVolume,fills
+ *
+ * The source returns the per-symbol summaries that TradeAggregates keeps
+ * up to date as trades are recorded, so a day costs O(symbols) however many
+ * trades it had. Without a source, every step returns an empty collection.
+ * A source that does not hold every trade of a day (e.g. a day before the
+ * server started, with no trade journal to read it from) says so through
+ * a DayCompleteCheck; such a day is not final and is never cached.
+ * journalDaySummaries() aggregates a past day from its journal segment.
+ *
+ * In the columnar format each day is one block with the same figures as
+ * typed columns, written from the summaries without formatting them:
+ *
+ *     symbol (UTF8), open, high, low, close (FLOAT64), volume (UINT64),
+ *     vwap (FLOAT64), buyVolume, sellVolume (UINT64), fills (UINT32)
+ *
+ * The date is the block's ReportBlockHeaderPOD::day.
  */
 
 #ifndef ENDOFDAYREPORT_HPP
 #define ENDOFDAYREPORT_HPP
 
+#include "Journal.hpp"
+#include "TradeAggregates.hpp"
+#include "models/TradingDate.hpp"
 #include "services/reports/BaseReport.hpp"
 
+#include <functional>
+#include <vector>
+
+/// @brief Every symbol's summary of one day, ordered by symbol; called concurrently for different days.
+using DaySummarySource = std::function<std::vector<SymbolDaySummary>(TradingDate day)>;
+
+/// @brief True if the DaySummarySource holds every trade of the day.
+using DayCompleteCheck = std::function<bool(TradingDate day)>;
+
+/**
+ * @brief Every symbol's summary of @p day, aggregated from the day's
+ *        segment of the trade journal described by @p trades.
+ * @details O(trades of the day), reading them in place; ordered by symbol.
+ *          Empty if the journal has no segment for the day.
+ * @throws std::runtime_error if the segment holds other records.
+ */
+std::vector<SymbolDaySummary> journalDaySummaries(const JournalConfig& trades, TradingDate day);
+
 /**
  * @class EndOfDayReport
  * @brief Generates a daily trading summary report.
@@ -20,18 +61,32 @@ class EndOfDayReport : public BaseReport
 {
 public:
     EndOfDayReport() = default;
+
+    /**
+     * @param source   Supplies the aggregated figures of each day.
+     * @param complete Optional; days it rejects are not final. Without it every day is.
+     */
+    explicit EndOfDayReport(DaySummarySource source, DayCompleteCheck complete = {});
+
     ~EndOfDayReport() override = default;
 
+    /// @copydoc BaseReport::supportsColumnar
+    bool supportsColumnar() const override { return true; }
+
+    /// @brief False for a day the source does not hold every trade of.
+    bool isFinal(TradingDate day) const override;
+
 protected:
     /**
-     * @brief Fetch all trades and positions for the requested date range.
+     * @brief Fetch the aggregated figures of every day in the requested range.
      * @param request The report request specifying the date range.
-     * @return Raw rows from the database.
+     * @return One row per symbol and day, in date then symbol order.
      */
     ReportData fetchData(const ReportRequest& request) override;
 
     /**
      * @brief Compute P&L totals and aggregate positions.
+     * @details The figures are aggregated at ingest, so the rows pass through.
      * @param data Raw rows returned by fetchData().
      * @return Computed summary rows.
      */
@@ -43,6 +98,13 @@ protected:
      * @return Formatted report lines.
      */
     Report format(const ReportData& data) override;
+
+    /// @copydoc BaseReport::writeColumns
+    PooledBuffer writeColumns(TradingDate day) override;
+
+private:
+    DaySummarySource m_source;
+    DayCompleteCheck m_complete;
 };
 
 #endif // ENDOFDAYREPORT_HPP
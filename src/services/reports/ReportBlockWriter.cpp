@@ -0,0 +1,135 @@
+/**
+ * @file ReportBlockWriter.cpp
+ * @brief Implementation of ReportBlockWriter.
+ */
+
+#include "ReportBlockWriter.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    constexpr std::size_t kColumnAlignment = 8;
+
+    std::size_t alignUp(std::size_t bytes)
+    {
+        return (bytes + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+    }
+
+    std::size_t valueWidth(ReportColumnType type)
+    {
+        switch (type)
+        {
+            case ReportColumnType::UINT32:  return sizeof(uint32_t);
+            case ReportColumnType::UINT64:  return sizeof(uint64_t);
+            case ReportColumnType::FLOAT64: return sizeof(double);
+            case ReportColumnType::UTF8:    return 0;
+        }
+        throw std::invalid_argument("[ReportBlockWriter] unknown column type "
+                                    + std::to_string(static_cast<unsigned>(type)));
+    }
+} // namespace
+
+ReportBlockWriter::ReportBlockWriter(TradingDate day, uint32_t rowCount)
+    : m_day(day)
+    , m_rowCount(rowCount)
+{
+}
+
+ReportBlockWriter::ColumnId ReportBlockWriter::addColumn(const char* name, ReportColumnType type,
+                                                         std::size_t textBytes)
+{
+    if (m_bytes)
+        throw std::logic_error("[ReportBlockWriter] columns must be declared before allocate()");
+
+    Column column;
+    const std::size_t length = name ? ::strnlen(name, sizeof(column.descriptor.name)) : 0;
+    if (length == 0 || length == sizeof(column.descriptor.name))
+        throw std::invalid_argument("[ReportBlockWriter] column name must be 1 to "
+                                    + std::to_string(sizeof(column.descriptor.name) - 1) + " characters");
+    column.width = valueWidth(type);
+    if (column.width != 0 && textBytes != 0)
+        throw std::invalid_argument("[ReportBlockWriter] only UTF8 columns have text bytes");
+    if (m_columns.size() == std::numeric_limits<uint16_t>::max())
+        throw std::length_error("[ReportBlockWriter] too many columns");
+
+    std::memcpy(column.descriptor.name, name, length);
+    column.descriptor.type = static_cast<uint8_t>(type);
+    column.textBytes       = textBytes;
+    m_columns.push_back(column);
+    return m_columns.size() - 1;
+}
+
+void ReportBlockWriter::allocate()
+{
+    if (m_bytes)
+        throw std::logic_error("[ReportBlockWriter] block already allocated");
+
+    // Header and descriptors, then each column at the next 8-byte boundary.
+    std::size_t end = alignUp(sizeof(ReportBlockHeaderPOD) + m_columns.size() * sizeof(ReportColumnPOD));
+    for (Column& column : m_columns)
+    {
+        const std::size_t bytes = column.width != 0
+                                      ? column.width * m_rowCount
+                                      : (static_cast<std::size_t>(m_rowCount) + 1) * sizeof(uint32_t) + column.textBytes;
+        column.offset = end;
+        end           = alignUp(end + bytes);
+        if (end > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("[ReportBlockWriter] block exceeds 4 GiB");
+        column.descriptor.offset = static_cast<uint32_t>(column.offset);
+        column.descriptor.bytes  = static_cast<uint32_t>(bytes);
+    }
+
+    // Zero-filled, so the padding and reserved fields read as 0.
+    m_buffer = PooledBuffer(end);
+    m_bytes  = m_buffer.data();
+
+    ReportBlockHeaderPOD header{};
+    header.magic       = kReportBlockMagic;
+    header.version     = kReportBlockVersion;
+    header.columnCount = static_cast<uint16_t>(m_columns.size());
+    header.day         = m_day.days;
+    header.rowCount    = m_rowCount;
+    header.blockBytes  = static_cast<uint32_t>(end);
+    std::memcpy(m_bytes, &header, sizeof(header));
+    for (std::size_t i = 0; i < m_columns.size(); ++i)
+        std::memcpy(m_bytes + sizeof(header) + i * sizeof(ReportColumnPOD), &m_columns[i].descriptor,
+                    sizeof(ReportColumnPOD));
+}
+
+void ReportBlockWriter::appendText(ColumnId column, const char* bytes, std::size_t size)
+{
+    if (!m_bytes || column >= m_columns.size() || m_columns[column].width != 0)
+        throw std::logic_error("[ReportBlockWriter] appendText() needs an allocated UTF8 column");
+
+    Column& text = m_columns[column];
+    if (text.rowsWritten == m_rowCount || size > text.textBytes - text.textWritten)
+        throw std::logic_error("[ReportBlockWriter] more text than declared for column "
+                               + std::string(text.descriptor.name));
+
+    // offsets[0] is already 0; offsets[row + 1] ends the row.
+    uint8_t* const offsets = m_bytes + text.offset;
+    uint8_t* const data    = offsets + (static_cast<std::size_t>(m_rowCount) + 1) * sizeof(uint32_t);
+    if (size > 0)
+        std::memcpy(data + text.textWritten, bytes, size);
+    text.textWritten += static_cast<uint32_t>(size);
+    ++text.rowsWritten;
+    std::memcpy(offsets + text.rowsWritten * sizeof(uint32_t), &text.textWritten, sizeof(uint32_t));
+}
+
+PooledBuffer ReportBlockWriter::finish()
+{
+    if (!m_bytes)
+        throw std::logic_error("[ReportBlockWriter] finish() before allocate()");
+    for (const Column& column : m_columns)
+    {
+        if (column.width == 0 && (column.rowsWritten != m_rowCount || column.textWritten != column.textBytes))
+            throw std::logic_error("[ReportBlockWriter] column " + std::string(column.descriptor.name)
+                                   + " is incomplete");
+    }
+    m_bytes = nullptr;
+    return std::move(m_buffer);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ReportBlockWriter.hpp
+ * @brief Lays out one day of a columnar report in a pooled buffer.
+ *
+ * @details A report declares its columns (with the total text size of the
+ * UTF8 ones), calls allocate(), then stores each value straight from the
+ * figures it computed: no row strings and no number formatting. finish()
+ * returns the block, laid out as ReportBlockHeaderPOD describes, for the
+ * client to read column by column.
+ *
+ *     ReportBlockWriter writer(day, rows);
+ *     const auto symbol = writer.addColumn("symbol", ReportColumnType::UTF8, textBytes);
+ *     const auto vwap   = writer.addColumn("vwap", ReportColumnType::FLOAT64);
+ *     writer.allocate();
+ *     for (uint32_t row = 0; row < rows; ++row) { writer.appendText(symbol, ...); writer.set(vwap, row, ...); }
+ *     PooledBuffer block = writer.finish();
+ */
+
+#ifndef REPORTBLOCKWRITER_HPP
+#define REPORTBLOCKWRITER_HPP
+
+#include "memory/PooledBuffer.hpp"
+#include "models/TradingDate.hpp"
+#include "pod/TradingPOD.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class ReportBlockWriter
+ * @brief Builds one ReportBlockHeaderPOD block, column by column.
+ */
+class ReportBlockWriter
+{
+public:
+    /// @brief Handle of a declared column.
+    using ColumnId = std::size_t;
+
+    /// @param rowCount Values every column will hold.
+    ReportBlockWriter(TradingDate day, uint32_t rowCount);
+
+    /**
+     * @brief Declare the next column.
+     * @param name      Up to 19 characters.
+     * @param textBytes Total bytes of the column's rows; UTF8 columns only.
+     * @throws std::invalid_argument if @p name is empty or too long, or
+     *         @p textBytes is set for a numeric column.
+     * @throws std::logic_error after allocate().
+     */
+    ColumnId addColumn(const char* name, ReportColumnType type, std::size_t textBytes = 0);
+
+    /**
+     * @brief Allocate the block and write its header and column descriptors.
+     * @throws std::length_error if the block would exceed 4 GiB.
+     * @throws std::logic_error if called twice.
+     */
+    void allocate();
+
+    /**
+     * @brief Store row @p row of a UINT32, UINT64 or FLOAT64 column.
+     * @details Unchecked, as it runs once per value: @p T must match the
+     *          column's type, @p row be below rowCount, and allocate() have run.
+     */
+    template <typename T>
+    void set(ColumnId column, uint32_t row, T value)
+    {
+        static_assert(std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value
+                          || std::is_same<T, double>::value,
+                      "report columns hold uint32_t, uint64_t or double");
+        std::memcpy(m_bytes + m_columns[column].offset + row * sizeof(T), &value, sizeof(T));
+    }
+
+    /// @brief Store the next row of a UTF8 column. Call after allocate(), once per row, in row order.
+    void appendText(ColumnId column, const char* bytes, std::size_t size);
+
+    /**
+     * @brief The finished block.
+     * @throws std::logic_error if the block was not allocated, or a UTF8
+     *         column did not receive exactly rowCount rows of its declared size.
+     */
+    PooledBuffer finish();
+
+private:
+    struct Column
+    {
+        ReportColumnPOD descriptor{};
+        std::size_t     width{0};      ///< Bytes per value; 0 for UTF8.
+        std::size_t     textBytes{0};  ///< Declared text size (UTF8).
+        std::size_t     offset{0};     ///< Of the values, or of the UTF8 offset table.
+        uint32_t        rowsWritten{0};
+        uint32_t        textWritten{0};
+    };
+
+    const TradingDate   m_day;
+    const uint32_t      m_rowCount;
+    std::vector<Column> m_columns;
+    PooledBuffer        m_buffer;
+    uint8_t*            m_bytes{nullptr}; ///< m_buffer's bytes once allocated.
+};
+
+#endif // REPORTBLOCKWRITER_HPP
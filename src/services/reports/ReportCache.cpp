@@ -0,0 +1,227 @@
+/**
+ * @file ReportCache.cpp
+ * @brief Implementation of ReportCache.
+ */
+
+#include "ReportCache.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    /// Bookkeeping charged per entry on top of its text.
+    constexpr std::size_t kEntryOverhead = 128;
+
+    class StringBlob final : public ReportCache::Blob
+    {
+    public:
+        explicit StringBlob(std::string text) : m_text(std::move(text)) {}
+        const char* data() const override { return m_text.data(); }
+        std::size_t size() const override { return m_text.size(); }
+
+    private:
+        std::string m_text;
+    };
+
+    /// Read-only private mapping of a whole spill file.
+    class MappedBlob final : public ReportCache::Blob
+    {
+    public:
+        MappedBlob(void* base, std::size_t size) : m_base(base), m_size(size) {}
+        ~MappedBlob() override { ::munmap(m_base, m_size); }
+        const char* data() const override { return static_cast<const char*>(m_base); }
+        std::size_t size() const override { return m_size; }
+
+    private:
+        void*       m_base;
+        std::size_t m_size;
+    };
+
+    bool writeFile(const std::string& path, const char* data, std::size_t size)
+    {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0)
+            return false;
+        std::size_t written = 0;
+        while (written < size)
+        {
+            const ssize_t n = ::write(fd, data + written, size - written);
+            if (n <= 0)
+            {
+                ::close(fd);
+                return false;
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        return ::close(fd) == 0;
+    }
+
+    std::shared_ptr<const ReportCache::Blob> mapFile(const std::string& path, std::size_t size)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+        void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file referenced
+        if (base == MAP_FAILED)
+            return nullptr;
+        return std::make_shared<MappedBlob>(base, size);
+    }
+} // namespace
+
+ReportCache::ReportCache(ReportCacheConfig config)
+    : m_config(std::move(config))
+{
+    if (!m_config.spillDirectory.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(m_config.spillDirectory, ec);
+        if (ec)
+            throw std::runtime_error("[ReportCache] cannot create spill directory "
+                                     + m_config.spillDirectory + ": " + ec.message());
+    }
+}
+
+ReportCache::~ReportCache()
+{
+    for (const Node& node : m_spilled)
+        ::unlink(node.path.c_str());
+}
+
+// ==========================================================================
+// Lookup and insertion
+// ==========================================================================
+
+std::shared_ptr<const ReportCache::Blob> ReportCache::find(const std::string& reportType, TradingDate day)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_index.find(Key{reportType, day.days});
+    if (found == m_index.end())
+    {
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    ++m_stats.hits;
+    const Lru::iterator it   = found->second;
+    Lru&                list = it->spilled ? m_spilled : m_memory;
+    list.splice(list.begin(), list, it);
+    return it->blob;
+}
+
+void ReportCache::store(const std::string& reportType, TradingDate day, std::string text)
+{
+    if (!enabled())
+        return;
+
+    Node node;
+    node.key   = Key{reportType, day.days};
+    node.bytes = text.size() + reportType.size() + kEntryOverhead;
+    node.blob  = std::make_shared<StringBlob>(std::move(text));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto existing = m_index.find(node.key);
+    if (existing != m_index.end())
+        eraseLocked(existing->second);
+
+    m_memory.push_front(std::move(node));
+    m_index.emplace(m_memory.front().key, m_memory.begin());
+    m_stats.memoryBytes += m_memory.front().bytes;
+    evictLocked();
+}
+
+ReportCache::Stats ReportCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats   = m_stats;
+    stats.entries = m_index.size();
+    return stats;
+}
+
+// ==========================================================================
+// Eviction — memory LRU spills (or drops), spill LRU deletes
+// ==========================================================================
+
+void ReportCache::evictLocked()
+{
+    while (m_stats.memoryBytes > m_config.maxMemoryBytes && !m_memory.empty())
+    {
+        const Lru::iterator victim = std::prev(m_memory.end());
+        if (m_config.spillDirectory.empty() || !spillLocked(*victim))
+        {
+            eraseLocked(victim);
+            continue;
+        }
+        m_stats.memoryBytes -= victim->bytes;
+        victim->bytes   = victim->blob->size();
+        victim->spilled = true;
+        m_stats.spilledBytes += victim->bytes;
+        m_spilled.splice(m_spilled.begin(), m_memory, victim);
+    }
+
+    while (m_stats.spilledBytes > m_config.maxSpillBytes && !m_spilled.empty())
+        eraseLocked(std::prev(m_spilled.end()));
+}
+
+bool ReportCache::spillLocked(Node& node)
+{
+    // An empty day costs nothing worth spilling; mmap cannot map 0 bytes.
+    const std::size_t size = node.blob->size();
+    if (size == 0 || size > m_config.maxSpillBytes)
+        return false;
+
+    const std::string path = spillPath(node.key);
+    if (!writeFile(path, node.blob->data(), size))
+    {
+        ++m_stats.spillFailures;
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    auto mapped = mapFile(path, size);
+    if (!mapped)
+    {
+        ++m_stats.spillFailures;
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    node.blob = std::move(mapped);
+    node.path = path;
+    return true;
+}
+
+void ReportCache::eraseLocked(Lru::iterator it)
+{
+    if (it->spilled)
+    {
+        // Readers holding the mapping keep it valid after the unlink.
+        ::unlink(it->path.c_str());
+        m_stats.spilledBytes -= it->bytes;
+        m_index.erase(it->key);
+        m_spilled.erase(it);
+        return;
+    }
+    m_stats.memoryBytes -= it->bytes;
+    m_index.erase(it->key);
+    m_memory.erase(it);
+}
+
+std::string ReportCache::spillPath(const Key& key) const
+{
+    std::string name;
+    for (const char c : key.type)
+    {
+        const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        name.push_back(safe ? c : '_');
+    }
+    return m_config.spillDirectory + "/" + name + "-" + TradingDate{key.day}.toIso() + "-"
+           + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + ".rpt";
+}
@@ -0,0 +1,143 @@
+/**
+ * @file ReportCache.hpp
+ * @brief LRU cache of formatted report days, optionally spilled to mmap'd files.
+ *
+ * @details Reports over closed trading days never change, so ReportService
+ * stores each closed day's formatted text here, keyed by (report type, day).
+ * A month-range request then reuses the days it shares with earlier
+ * requests and runs the pipeline only for the rest.
+ *
+ * Entries live in memory up to ReportCacheConfig::maxMemoryBytes, least
+ * recently used first out. With a spill directory configured, an entry
+ * evicted from memory is written to a file there and served from a
+ * read-only memory mapping until the spill budget is exhausted; the page
+ * cache then decides what stays resident. Spilled files belong to this
+ * process and are removed when the cache is destroyed.
+ *
+ * Thread-safe. find() hands out shared ownership, so an entry being read
+ * stays valid even if it is evicted meanwhile.
+ */
+
+#ifndef REPORTCACHE_HPP
+#define REPORTCACHE_HPP
+
+#include "models/TradingDate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @struct ReportCacheConfig
+ * @brief Size limits and spill location of a ReportCache.
+ */
+struct ReportCacheConfig
+{
+    /// @brief Bytes of day text kept in memory (0 disables the cache).
+    std::size_t maxMemoryBytes{64u * 1024u * 1024u};
+
+    /// @brief Directory for spilled days; empty = evicted days are dropped.
+    std::string spillDirectory;
+
+    /// @brief Bytes of spilled files kept before the oldest are deleted.
+    std::size_t maxSpillBytes{1024u * 1024u * 1024u};
+};
+
+/**
+ * @class ReportCache
+ * @brief (report type, day) → formatted text, bounded in memory and on disk.
+ */
+class ReportCache
+{
+public:
+    /// @brief Immutable text of one cached day, in memory or mapped from disk.
+    class Blob
+    {
+    public:
+        virtual ~Blob() = default;
+        virtual const char* data() const = 0;
+        virtual std::size_t size() const = 0;
+    };
+
+    /// @brief Counters for operators; a consistent snapshot.
+    struct Stats
+    {
+        uint64_t    hits{0};
+        uint64_t    misses{0};
+        std::size_t entries{0};
+        std::size_t memoryBytes{0};
+        std::size_t spilledBytes{0};
+        uint64_t    spillFailures{0};
+    };
+
+    /**
+     * @param config Limits and spill directory.
+     * @throws std::runtime_error if the spill directory cannot be created.
+     */
+    explicit ReportCache(ReportCacheConfig config = {});
+
+    /// Removes every spilled file.
+    ~ReportCache();
+
+    ReportCache(const ReportCache&)            = delete;
+    ReportCache& operator=(const ReportCache&) = delete;
+
+    /// @brief The cached text of @p day, or null; marks it most recently used.
+    std::shared_ptr<const Blob> find(const std::string& reportType, TradingDate day);
+
+    /// @brief Insert or replace the text of @p day, evicting as needed.
+    void store(const std::string& reportType, TradingDate day, std::string text);
+
+    /// @brief False when maxMemoryBytes is 0.
+    bool enabled() const { return m_config.maxMemoryBytes > 0; }
+
+    Stats stats() const;
+
+private:
+    struct Key
+    {
+        std::string type;
+        int32_t     day;
+
+        bool operator==(const Key& other) const { return day == other.day && type == other.type; }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            return std::hash<std::string>()(key.type) ^ (static_cast<std::size_t>(key.day) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    struct Node
+    {
+        Key                         key;
+        std::shared_ptr<const Blob> blob;
+        std::size_t                 bytes{0}; ///< Charged against the memory or spill budget.
+        bool                        spilled{false};
+        std::string                 path;     ///< Spill file, if spilled.
+    };
+
+    using Lru = std::list<Node>;
+
+    void        evictLocked();
+    bool        spillLocked(Node& node);
+    void        eraseLocked(Lru::iterator it);
+    std::string spillPath(const Key& key) const;
+
+    ReportCacheConfig m_config;
+
+    mutable std::mutex                              m_mutex;
+    Lru                                             m_memory;  ///< In-memory entries, most recent first.
+    Lru                                             m_spilled; ///< Mapped entries, most recent first.
+    std::unordered_map<Key, Lru::iterator, KeyHash> m_index;
+    Stats                                           m_stats;
+};
+
+#endif // REPORTCACHE_HPP
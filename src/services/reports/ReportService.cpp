@@ -0,0 +1,200 @@
+/**
+ * @file ReportService.cpp
+ * @brief Implementation of ReportService.
+ */
+
+#include "ReportService.hpp"
+
+#include "EndOfDayReport.hpp"
+#include "models/TradingDate.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    PooledBuffer toBuffer(const std::string& bytes)
+    {
+        PooledBuffer buffer = PooledBuffer::uninitialized(bytes.size());
+        if (!bytes.empty())
+            std::memcpy(buffer.data(), bytes.data(), bytes.size());
+        return buffer;
+    }
+
+    /// Appended to the report type to key cached columnar days.
+    constexpr const char* kColumnarCacheSuffix = "#columnar";
+
+    /// The current UTC calendar day; days before it are closed.
+    TradingDate currentDay()
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        return TradingDate{static_cast<int32_t>(std::chrono::duration_cast<std::chrono::hours>(now).count() / 24)};
+    }
+} // namespace
+
+ReportService::ReportService(std::size_t threads, ReportCacheConfig cache)
+    : m_pool(threads)
+    , m_cache(std::move(cache))
+{
+    registerReport("EndOfDay", []() { return std::make_unique<EndOfDayReport>(); });
+
+    // TODO: EXTEND — Register new BaseReport subclasses here.
+}
+
+void ReportService::registerReport(const std::string& reportType, ReportFactory factory)
+{
+    m_factories[reportType] = std::move(factory);
+}
+
+Response ReportService::generateReport(const ReportRequest& request)
+{
+    return generateReportStreaming(request, ResponseCallback{});
+}
+
+// ==========================================================================
+// Streaming — cached and generated days, cut into kChunkBytes partial responses
+// ==========================================================================
+
+Response ReportService::generateReportStreaming(const ReportRequest& request, const ResponseCallback& onChunk)
+{
+    const auto factory = m_factories.find(request.reportType);
+    if (factory == m_factories.end())
+        return Response{false, "ReportService: unknown report type " + request.reportType, {}};
+    if (request.format != ReportFormat::TEXT && request.format != ReportFormat::COLUMNAR)
+        return Response{false,
+                        "ReportService: unknown report format "
+                            + std::to_string(static_cast<unsigned>(request.format)),
+                        {}};
+
+    const TradingDate from = request.dateFrom;
+    const TradingDate to   = request.dateTo;
+    if (!from.inIsoRange() || !to.inIsoRange())
+        return Response{false, "ReportService: dates must be within 0000-01-01 .. 9999-12-31", {}};
+    if (to < from)
+        return Response{false, "ReportService: dateFrom is after dateTo", {}};
+    if (static_cast<int64_t>(to.days) - from.days >= kMaxReportDays)
+        return Response{false,
+                        "ReportService: range exceeds " + std::to_string(kMaxReportDays) + " days",
+                        {}};
+
+    std::unique_ptr<BaseReport> report;
+    try
+    {
+        report = factory->second();
+    }
+    catch (const std::exception& ex)
+    {
+        return Response{false, std::string("ReportService: ") + ex.what(), {}};
+    }
+    const bool columnar = request.format == ReportFormat::COLUMNAR;
+    if (columnar && !report->supportsColumnar())
+        return Response{false, "ReportService: report type " + request.reportType + " has no columnar format", {}};
+
+    // Each format's days are cached apart.
+    const std::string cacheKey = columnar ? request.reportType + kColumnarCacheSuffix : request.reportType;
+
+    // Closed days already formatted, by offset from dateFrom.
+    const TradingDate today = currentDay();
+    std::vector<std::shared_ptr<const ReportCache::Blob>> cached;
+    if (m_cache.enabled() && from < today)
+    {
+        cached.resize(static_cast<std::size_t>(to.days - from.days) + 1);
+        for (TradingDate day = from; day <= to && day < today; day = day + 1)
+            cached[static_cast<std::size_t>(day.days - from.days)] = m_cache.find(cacheKey, day);
+    }
+    const auto isCached = [&](TradingDate day) {
+        const auto offset = static_cast<std::size_t>(day.days - from.days);
+        return offset < cached.size() && cached[offset] != nullptr;
+    };
+
+    std::string pending;
+    pending.reserve(kChunkBytes);
+
+    const auto emit = [&](const char* bytes, std::size_t size) {
+        if (!onChunk)
+        {
+            pending.append(bytes, size);
+            return;
+        }
+        while (size > 0)
+        {
+            const std::size_t take = std::min(size, kChunkBytes - pending.size());
+            pending.append(bytes, take);
+            bytes += take;
+            size -= take;
+            if (pending.size() == kChunkBytes)
+            {
+                Response chunk{true, "", toBuffer(pending)};
+                chunk.more = true;
+                onChunk(std::move(chunk));
+                pending.clear();
+            }
+        }
+    };
+
+    // Cached days are emitted as the generated days around them arrive.
+    TradingDate next = from;
+    const auto emitCachedBefore = [&](TradingDate end) {
+        for (; next < end; next = next + 1)
+        {
+            if (isCached(next))
+            {
+                const auto& blob = cached[static_cast<std::size_t>(next.days - from.days)];
+                emit(blob->data(), blob->size());
+            }
+        }
+    };
+
+    const auto sink = [&](TradingDate day, Report&& rows) {
+        emitCachedBefore(day);
+
+        std::size_t bytes = 0;
+        for (const std::string& row : rows)
+            bytes += row.size() + 1;
+        std::string text;
+        text.reserve(bytes);
+        for (const std::string& row : rows)
+        {
+            text.append(row);
+            text.push_back('\n');
+        }
+
+        emit(text.data(), text.size());
+        if (m_cache.enabled() && day < today && report->isFinal(day))
+            m_cache.store(cacheKey, day, std::move(text));
+        next = day + 1;
+    };
+
+    // Blocks are self-delimiting, so a day's block is emitted as is.
+    const auto blockSink = [&](TradingDate day, PooledBuffer&& block) {
+        emitCachedBefore(day);
+
+        const char* bytes = reinterpret_cast<const char*>(block.data());
+        emit(bytes, block.size());
+        if (m_cache.enabled() && day < today && report->isFinal(day))
+            m_cache.store(cacheKey, day, std::string(bytes, block.size()));
+        next = day + 1;
+    };
+
+    try
+    {
+        const auto needed = [&](TradingDate day) { return !isCached(day); };
+        if (columnar)
+            report->generateColumnarStreaming(request, m_pool, blockSink, needed);
+        else
+            report->generateStreaming(request, m_pool, sink, needed);
+        emitCachedBefore(to + 1);
+    }
+    catch (const std::exception& ex)
+    {
+        return Response{false, std::string("ReportService: ") + ex.what(), {}};
+    }
+    return Response{true, "OK", toBuffer(pending)};
+}
@@ -0,0 +1,95 @@
+/**
+ * @file ReportService.hpp
+ * @brief IReportService that runs BaseReport pipelines and streams the rows.
+ *
+ * @details Report types are registered by name with a factory. Each request
+ * gets a fresh report object, whose pipeline runs one trading day per
+ * partition on a shared ForkJoinPool (see BaseReport::generateStreaming()).
+ *
+ * ### GENERATE_REPORT
+ *   Request payload : PayloadHeader + 1 × ReportRequestPOD, then optionally
+ *                     PayloadHeader + 1 × ReportOptionsPOD (see ReportCommand)
+ *   Response data   : ReportFormat::TEXT — UTF-8 rows, each terminated by '\n';
+ *                     ReportFormat::COLUMNAR — one ReportBlockHeaderPOD block
+ *                     per day with rows, in date order
+ *
+ * COLUMNAR is refused for a report that does not supportsColumnar().
+ *
+ * generateReportStreaming() emits the days in date order as partial
+ * responses of exactly kChunkBytes each (Response::more set, empty
+ * message; a chunk may end mid-row or mid-block). The final response
+ * carries whatever is left, with message "OK". If a pipeline step fails partway, the final
+ * response reports the failure after the chunks already sent.
+ * generateReport() returns the whole report in a single response.
+ *
+ * The output of every closed day (before today, UTC) is kept in a
+ * ReportCache keyed by report type, format and day. A request runs the pipeline
+ * only for the days the cache does not hold, so overlapping month ranges
+ * and repeated requests cost a lookup per day. Today's figures can still
+ * change and are always generated, as are days the report's source cannot
+ * fully answer (BaseReport::isFinal()).
+ */
+
+#ifndef REPORTSERVICE_HPP
+#define REPORTSERVICE_HPP
+
+#include "ReportCache.hpp"
+#include "concurrency/ForkJoinPool.hpp"
+#include "services/IReportService.hpp"
+#include "services/reports/BaseReport.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class ReportService
+ * @brief Named report pipelines, partitioned by day and streamed in chunks.
+ */
+class ReportService : public IReportService
+{
+public:
+    /// Builds a report object for one request.
+    using ReportFactory = std::function<std::unique_ptr<BaseReport>()>;
+
+    /// Target payload size of one streamed chunk.
+    static constexpr std::size_t kChunkBytes = 64 * 1024;
+
+    /// Longest accepted range, in days (inclusive of both ends).
+    static constexpr int32_t kMaxReportDays = 3660;
+
+    /**
+     * @param threads Pool threads besides the caller for day partitions.
+     * @param cache   Limits of the closed-day cache.
+     * @throws std::runtime_error if the cache's spill directory cannot be
+     *         created.
+     *
+     * Registers "EndOfDay" (EndOfDayReport).
+     */
+    explicit ReportService(std::size_t threads = ForkJoinPool::defaultWorkers(), ReportCacheConfig cache = {});
+
+    /**
+     * @brief Register or replace the factory for @p reportType.
+     * @details Call during startup, before requests are served; days
+     *          already cached for the type are not invalidated.
+     */
+    void registerReport(const std::string& reportType, ReportFactory factory);
+
+    /// @copydoc IReportService::generateReport
+    Response generateReport(const ReportRequest& request) override;
+
+    /// @copydoc IReportService::generateReportStreaming
+    Response generateReportStreaming(const ReportRequest& request, const ResponseCallback& onChunk) override;
+
+    /// @brief Hit, miss and size counters of the closed-day cache.
+    ReportCache::Stats cacheStats() const { return m_cache.stats(); }
+
+private:
+    std::unordered_map<std::string, ReportFactory> m_factories;
+    ForkJoinPool                                   m_pool;
+    ReportCache                                    m_cache;
+};
+
+#endif // REPORTSERVICE_HPP
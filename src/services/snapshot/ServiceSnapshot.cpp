@@ -0,0 +1,88 @@
+/**
+ * @file ServiceSnapshot.cpp
+ * @brief Implementation of ServiceSnapshot.
+ */
+
+#include "ServiceSnapshot.hpp"
+#include "Snapshot.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+ServiceSnapshot::ServiceSnapshot(std::shared_ptr<InMemoryMarketDataService> marketData,
+                                 std::shared_ptr<CalculationEngine>         calculation,
+                                 std::shared_ptr<ManipulationEngine>        manipulation)
+    : m_marketData(std::move(marketData))
+    , m_calculation(std::move(calculation))
+    , m_manipulation(std::move(manipulation))
+{
+    if (!m_marketData || !m_calculation || !m_manipulation)
+        throw std::invalid_argument("[ServiceSnapshot] services must not be null");
+}
+
+std::size_t ServiceSnapshot::save(const std::string& path, TradingDate tradeDay) const
+{
+    const std::vector<MarketDataPOD> marketData = m_marketData->snapshots();
+
+    std::vector<PositionPOD> positions;
+    std::vector<std::size_t> bookSizes;
+    m_calculation->exportResidentBooks(positions, bookSizes);
+    std::vector<ResidentBookRecord> books(bookSizes.size());
+    for (std::size_t i = 0; i < bookSizes.size(); ++i)
+        books[i].positionCount = bookSizes[i];
+
+    const std::vector<TradePOD> trades = m_manipulation->trades();
+    JournalWatermark            watermark{};
+    watermark.day     = tradeDay.days;
+    watermark.records = trades.size();
+
+    SnapshotWriter writer;
+    writer.add(SnapshotSection::MARKET_DATA, marketData);
+    writer.add(SnapshotSection::RESIDENT_POSITIONS, positions);
+    writer.add(SnapshotSection::RESIDENT_BOOKS, books);
+    writer.add(SnapshotSection::RESIDENT_TRADES, trades);
+    writer.add(SnapshotSection::TRADE_WATERMARK, &watermark, 1);
+    return writer.write(path);
+}
+
+ServiceSnapshot::Restored ServiceSnapshot::restore(const std::string& path, TradingDate tradeDay,
+                                                   const PartRestored& onPart)
+{
+    Restored restored;
+    const std::unique_ptr<SnapshotReader> reader = SnapshotReader::open(path);
+    if (!reader)
+        return restored;
+    restored.found     = true;
+    restored.createdAt = reader->createdAt();
+
+    const auto marketData = reader->section<MarketDataPOD>(SnapshotSection::MARKET_DATA);
+    for (const MarketDataPOD& snapshot : marketData)
+        m_marketData->update(snapshot);
+    restored.symbols = marketData.size();
+    if (onPart)
+        onPart(Part::MARKET_DATA);
+
+    const auto               books = reader->section<ResidentBookRecord>(SnapshotSection::RESIDENT_BOOKS);
+    std::vector<std::size_t> bookSizes;
+    bookSizes.reserve(books.size());
+    for (const ResidentBookRecord& book : books)
+        bookSizes.push_back(static_cast<std::size_t>(book.positionCount));
+    m_calculation->restoreResidentBooks(reader->section<PositionPOD>(SnapshotSection::RESIDENT_POSITIONS),
+                                        bookSizes);
+    restored.books = m_calculation->residentBookCount();
+    if (onPart)
+        onPart(Part::RESIDENT_BOOKS);
+
+    const auto watermark = reader->section<JournalWatermark>(SnapshotSection::TRADE_WATERMARK);
+    if (watermark.size() == 1 && watermark[0].day == tradeDay.days)
+    {
+        const auto trades = reader->section<TradePOD>(SnapshotSection::RESIDENT_TRADES);
+        m_manipulation->recordTrades(trades.data(), trades.size());
+        restored.trades          = trades.size();
+        restored.tradeReplayFrom = watermark[0].records;
+    }
+    if (onPart)
+        onPart(Part::TRADES);
+    return restored;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ServiceSnapshot.hpp
+ * @brief Saves and restores the in-memory state of the services as one snapshot.
+ *
+ * @details A snapshot holds what would otherwise take longest to rebuild
+ * after a restart:
+ *   - the latest MarketDataPOD of every symbol,
+ *   - the resident books of the calculation engine (their positions; they
+ *     are re-marked from the restored market data on load),
+ *   - the manipulation engine's day store and the trade journal watermark,
+ *     the number of records of that day's journal segment it already holds.
+ *
+ * On start, restore() loads the snapshot and main replays only the journal
+ * records after the watermark. The day store is fed from the trade journal
+ * in journal order, so its row count is the watermark.
+ */
+
+#ifndef SERVICESNAPSHOT_HPP
+#define SERVICESNAPSHOT_HPP
+
+#include "CalculationEngine.hpp"
+#include "InMemoryMarketDataService.hpp"
+#include "ManipulationEngine.hpp"
+#include "models/TradingDate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @class ServiceSnapshot
+ * @brief Snapshot of market data, resident books and resident trades.
+ *
+ * save() can run while requests are served. Each service is copied under
+ * its own lock, so the services are not captured at one instant, but each
+ * one is internally consistent.
+ */
+class ServiceSnapshot
+{
+public:
+    /// @brief What restore() found and loaded.
+    struct Restored
+    {
+        bool        found{false};     ///< A snapshot file existed.
+        int64_t     createdAt{0};     ///< Unix epoch microseconds it was written.
+        std::size_t symbols{0};
+        std::size_t books{0};
+        std::size_t trades{0};
+        uint64_t    tradeReplayFrom{0}; ///< First record of the day's trade journal not yet restored.
+    };
+
+    /// @brief A part of the state restore() has finished loading.
+    enum class Part
+    {
+        MARKET_DATA,    ///< Market data is restored; the books follow.
+        RESIDENT_BOOKS, ///< Resident books are restored and marked.
+        TRADES,         ///< The day store holds the snapshot's trades (or none of another day).
+    };
+
+    /// @brief Called by restore() as each Part is done, on its thread.
+    using PartRestored = std::function<void(Part)>;
+
+    ServiceSnapshot(std::shared_ptr<InMemoryMarketDataService> marketData,
+                    std::shared_ptr<CalculationEngine>         calculation,
+                    std::shared_ptr<ManipulationEngine>        manipulation);
+
+    /**
+     * @brief Write the services' state to @p path, replacing the previous snapshot.
+     * @param tradeDay Day of the trades in the manipulation engine's store.
+     * @return Bytes written.
+     * @throws std::runtime_error on an I/O error; the previous snapshot is kept.
+     */
+    std::size_t save(const std::string& path, TradingDate tradeDay) const;
+
+    /**
+     * @brief Load the snapshot at @p path into the services.
+     * @details Market data is restored first, so resident books are marked
+     *          at the snapshot prices. Trades are restored only if they are
+     *          of @p tradeDay; otherwise the whole day is left to the journal.
+     *          @p onPart, if set, is told as each part is done, so a
+     *          staged startup can serve market data while books and
+     *          trades are still loading. It is not called if there is no
+     *          snapshot.
+     * @return found == false if there is no snapshot at @p path.
+     * @throws std::runtime_error if the file is not a valid snapshot.
+     */
+    Restored restore(const std::string& path, TradingDate tradeDay, const PartRestored& onPart = {});
+
+private:
+    std::shared_ptr<InMemoryMarketDataService> m_marketData;
+    std::shared_ptr<CalculationEngine>         m_calculation;
+    std::shared_ptr<ManipulationEngine>        m_manipulation;
+};
+
+#endif // SERVICESNAPSHOT_HPP
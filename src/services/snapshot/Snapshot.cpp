@@ -0,0 +1,244 @@
+/**
+ * @file Snapshot.cpp
+ * @brief Implementation of SnapshotWriter and SnapshotReader.
+ */
+
+#include "Snapshot.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace
+{
+    std::runtime_error snapshotError(const std::string& what, const std::string& path, int error)
+    {
+        return std::runtime_error("[Snapshot] " + what + " " + path + ": " + std::strerror(error));
+    }
+
+    std::size_t alignUp(std::size_t bytes)
+    {
+        return (bytes + SnapshotWriter::kAlignment - 1) & ~(SnapshotWriter::kAlignment - 1);
+    }
+
+    /// Zeros for the gaps between sections.
+    const uint8_t kPadding[SnapshotWriter::kAlignment] = {};
+
+    /// Write every byte of @p iov, resuming after short writes.
+    bool writeAll(int fd, std::vector<iovec>& iov)
+    {
+        std::size_t first = 0;
+        while (first < iov.size())
+        {
+            const int     batch   = static_cast<int>(std::min<std::size_t>(iov.size() - first, IOV_MAX));
+            const ssize_t written = ::writev(fd, iov.data() + first, batch);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            std::size_t left = static_cast<std::size_t>(written);
+            while (first < iov.size() && left >= iov[first].iov_len)
+                left -= iov[first++].iov_len;
+            if (left > 0)
+            {
+                iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+        return true;
+    }
+
+    /// Make a rename in the directory of @p path durable.
+    void syncDirectory(const std::string& path)
+    {
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        if (directory.empty())
+            directory = ".";
+        const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+        ::fsync(fd);
+        ::close(fd);
+    }
+} // namespace
+
+// ==========================================================================
+// SnapshotWriter
+// ==========================================================================
+
+void SnapshotWriter::addRaw(SnapshotSection tag, const void* records, uint32_t recordSize, std::size_t count)
+{
+    const Section section{static_cast<uint32_t>(tag), recordSize, records, count};
+    for (Section& existing : m_sections)
+    {
+        if (existing.tag == section.tag)
+        {
+            existing = section;
+            return;
+        }
+    }
+    m_sections.push_back(section);
+}
+
+std::size_t SnapshotWriter::write(const std::string& path) const
+{
+    SnapshotFileHeader header{};
+    std::memcpy(header.magic, SnapshotFileHeader::kMagic, sizeof(header.magic));
+    header.version      = SnapshotFileHeader::kVersion;
+    header.sectionCount = static_cast<uint32_t>(m_sections.size());
+    header.createdAt    = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+
+    // Lay out the sections, then gather header, table, data and padding
+    // into one writev().
+    std::vector<SnapshotSectionEntry> table(m_sections.size());
+    std::size_t offset = alignUp(sizeof(header) + table.size() * sizeof(SnapshotSectionEntry));
+    for (std::size_t i = 0; i < m_sections.size(); ++i)
+    {
+        table[i].tag        = m_sections[i].tag;
+        table[i].recordSize = m_sections[i].recordSize;
+        table[i].count      = m_sections[i].count;
+        table[i].offset     = offset;
+        offset = alignUp(offset + m_sections[i].count * m_sections[i].recordSize);
+    }
+    const std::size_t total = offset;
+
+    std::vector<iovec> iov;
+    iov.reserve(2 + 2 * m_sections.size() + 1);
+    std::size_t position = 0;
+    const auto  push     = [&iov, &position](const void* data, std::size_t size) {
+        if (size == 0)
+            return;
+        iov.push_back(iovec{const_cast<void*>(data), size});
+        position += size;
+    };
+    const auto pad = [&push, &position](std::size_t to) { push(kPadding, to - position); };
+
+    push(&header, sizeof(header));
+    push(table.data(), table.size() * sizeof(SnapshotSectionEntry));
+    for (std::size_t i = 0; i < m_sections.size(); ++i)
+    {
+        pad(static_cast<std::size_t>(table[i].offset));
+        push(m_sections[i].records, m_sections[i].count * m_sections[i].recordSize);
+    }
+    pad(total);
+
+    const std::string temp = path + ".tmp";
+    const int         fd   = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        throw snapshotError("cannot create", temp, errno);
+
+    if (!writeAll(fd, iov) || ::fsync(fd) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        ::unlink(temp.c_str());
+        throw snapshotError("cannot write", temp, error);
+    }
+    ::close(fd);
+
+    if (::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        const int error = errno;
+        ::unlink(temp.c_str());
+        throw snapshotError("cannot rename to", path, error);
+    }
+    syncDirectory(path);
+    return total;
+}
+
+// ==========================================================================
+// SnapshotReader
+// ==========================================================================
+
+std::unique_ptr<SnapshotReader> SnapshotReader::open(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+            return nullptr;
+        throw snapshotError("cannot open", path, errno);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw snapshotError("cannot stat", path, error);
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes < sizeof(SnapshotFileHeader))
+    {
+        ::close(fd);
+        throw std::runtime_error("[Snapshot] truncated snapshot " + path);
+    }
+
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED)
+        throw snapshotError("cannot map", path, error);
+
+    std::unique_ptr<SnapshotReader> reader(new SnapshotReader());
+    reader->m_base     = base;
+    reader->m_bytes    = bytes;
+    reader->m_header   = static_cast<const SnapshotFileHeader*>(base);
+    reader->m_sections = reinterpret_cast<const SnapshotSectionEntry*>(reader->m_header + 1);
+
+    const SnapshotFileHeader& header = *reader->m_header;
+    if (std::memcmp(header.magic, SnapshotFileHeader::kMagic, sizeof(header.magic)) != 0)
+        throw std::runtime_error("[Snapshot] not a snapshot: " + path);
+    if (header.version != SnapshotFileHeader::kVersion)
+        throw std::runtime_error("[Snapshot] unsupported snapshot version " + std::to_string(header.version) + ": "
+                                 + path);
+    if (header.sectionCount > (bytes - sizeof(header)) / sizeof(SnapshotSectionEntry))
+        throw std::runtime_error("[Snapshot] truncated snapshot " + path);
+
+    for (uint32_t i = 0; i < header.sectionCount; ++i)
+    {
+        const SnapshotSectionEntry& entry = reader->m_sections[i];
+        const bool fits = entry.recordSize > 0 && entry.offset % SnapshotWriter::kAlignment == 0 && entry.offset <= bytes
+                          && entry.count <= (bytes - entry.offset) / entry.recordSize;
+        if (!fits)
+            throw std::runtime_error("[Snapshot] section " + std::to_string(entry.tag) + " is corrupt: " + path);
+    }
+    return reader;
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    if (m_base)
+        ::munmap(m_base, m_bytes);
+}
+
+const SnapshotSectionEntry* SnapshotReader::find(SnapshotSection tag, uint32_t recordSize) const
+{
+    for (uint32_t i = 0; i < m_header->sectionCount; ++i)
+    {
+        const SnapshotSectionEntry& entry = m_sections[i];
+        if (entry.tag != static_cast<uint32_t>(tag))
+            continue;
+        if (entry.recordSize != recordSize)
+            throw std::runtime_error("[Snapshot] section " + std::to_string(entry.tag) + " holds "
+                                     + std::to_string(entry.recordSize) + "-byte records, expected "
+                                     + std::to_string(recordSize));
+        return &entry;
+    }
+    return nullptr;
+}
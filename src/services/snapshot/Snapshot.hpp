@@ -0,0 +1,203 @@
+/**
+ * @file Snapshot.hpp
+ * @brief Binary snapshot file of POD arrays, written in one call and read mapped.
+ *
+ * @details A snapshot is a SnapshotFileHeader, a table of SnapshotSectionEntry
+ * and then the sections, each an array of packed PODs exactly as they are in
+ * memory. Every section starts on a 64-byte boundary, so a mapped section is
+ * as cache-aligned as the arrays it was written from.
+ *
+ * SnapshotWriter gathers the sections by pointer and writes the whole file
+ * with writev(), fsyncs it and renames it over the previous snapshot. A crash
+ * while writing leaves the previous snapshot in place. SnapshotReader maps
+ * the file read-only and hands out a PodArrayView per section; restoring
+ * copies straight from the mapping into the services.
+ */
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "pod/PodView.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @enum SnapshotSection
+ * @brief Tag of a section in a snapshot file.
+ */
+enum class SnapshotSection : uint32_t
+{
+    MARKET_DATA        = 1, ///< MarketDataPOD, latest snapshot per symbol.
+    RESIDENT_POSITIONS = 2, ///< PositionPOD of every resident book, concatenated.
+    RESIDENT_BOOKS     = 3, ///< ResidentBookRecord per resident book, MRU first.
+    RESIDENT_TRADES    = 4, ///< TradePOD, the manipulation engine's day store.
+    TRADE_WATERMARK    = 5, ///< One JournalWatermark for the trade journal.
+};
+
+#pragma pack(push, 1)
+
+/**
+ * @struct ResidentBookRecord
+ * @brief One resident book: its positions are the next positionCount
+ *        records of the RESIDENT_POSITIONS section.
+ */
+struct ResidentBookRecord
+{
+    uint64_t positionCount;
+};
+
+/**
+ * @struct JournalWatermark
+ * @brief How much of a journal day the snapshot already holds.
+ */
+struct JournalWatermark
+{
+    int32_t  day;      ///< TradingDate::days of the journal segment.
+    uint32_t reserved;
+    uint64_t records;  ///< Leading records of that segment reflected in the snapshot.
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ResidentBookRecord) == 8, "ResidentBookRecord layout changed");
+static_assert(sizeof(JournalWatermark) == 16, "JournalWatermark layout changed");
+
+/**
+ * @struct SnapshotFileHeader
+ * @brief First bytes of every snapshot file.
+ */
+struct SnapshotFileHeader
+{
+    static constexpr char     kMagic[8] = {'H', 'F', 'T', 'S', 'N', 'A', 'P', '1'};
+    static constexpr uint32_t kVersion  = 1;
+
+    char     magic[8];     ///< kMagic.
+    uint32_t version;      ///< kVersion.
+    uint32_t sectionCount; ///< Entries in the section table that follows.
+    int64_t  createdAt;    ///< Unix epoch microseconds.
+    uint8_t  padding[40];
+};
+
+static_assert(sizeof(SnapshotFileHeader) == 64, "SnapshotFileHeader layout changed");
+
+/**
+ * @struct SnapshotSectionEntry
+ * @brief Where one section is and what it holds.
+ */
+struct SnapshotSectionEntry
+{
+    uint32_t tag;        ///< SnapshotSection.
+    uint32_t recordSize; ///< sizeof the record type.
+    uint64_t count;      ///< Records in the section.
+    uint64_t offset;     ///< From the start of the file; a multiple of 64.
+    uint64_t reserved;
+};
+
+static_assert(sizeof(SnapshotSectionEntry) == 32, "SnapshotSectionEntry layout changed");
+
+/**
+ * @class SnapshotWriter
+ * @brief Collects sections and writes them as one snapshot file.
+ *
+ * add() keeps only the pointer: the records must stay alive and unchanged
+ * until write() returns.
+ */
+class SnapshotWriter
+{
+public:
+    /// Section alignment in the file.
+    static constexpr std::size_t kAlignment = 64;
+
+    /// @brief Add @p count records of @p T as section @p tag (replacing an earlier one).
+    template <typename T>
+    void add(SnapshotSection tag, const T* records, std::size_t count)
+    {
+        addRaw(tag, records, static_cast<uint32_t>(sizeof(T)), count);
+    }
+
+    /// @copydoc add
+    template <typename T>
+    void add(SnapshotSection tag, const std::vector<T>& records)
+    {
+        add(tag, records.data(), records.size());
+    }
+
+    /**
+     * @brief Write the snapshot to @p path atomically.
+     * @details Writes `<path>.tmp` with writev(), fsyncs it, renames it to
+     *          @p path and fsyncs the directory.
+     * @return Bytes written.
+     * @throws std::runtime_error on any I/O error; @p path is left as it was.
+     */
+    std::size_t write(const std::string& path) const;
+
+private:
+    struct Section
+    {
+        uint32_t    tag;
+        uint32_t    recordSize;
+        const void* records;
+        std::size_t count;
+    };
+
+    void addRaw(SnapshotSection tag, const void* records, uint32_t recordSize, std::size_t count);
+
+    std::vector<Section> m_sections;
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Read-only mapping of a snapshot file.
+ */
+class SnapshotReader
+{
+public:
+    /**
+     * @brief Map the snapshot at @p path.
+     * @return Null if there is no file at @p path.
+     * @throws std::runtime_error if the file is not a valid snapshot.
+     */
+    static std::unique_ptr<SnapshotReader> open(const std::string& path);
+
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&)            = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /// @brief Unix epoch microseconds when the snapshot was written.
+    int64_t createdAt() const { return m_header->createdAt; }
+
+    /// @brief Size of the mapped file.
+    std::size_t bytes() const { return m_bytes; }
+
+    /**
+     * @brief The records of section @p tag, in place in the mapping.
+     * @return An empty view if the snapshot has no such section.
+     * @throws std::runtime_error if the section holds records of another size.
+     */
+    template <typename T>
+    PodArrayView<T> section(SnapshotSection tag) const
+    {
+        const SnapshotSectionEntry* entry = find(tag, static_cast<uint32_t>(sizeof(T)));
+        if (!entry)
+            return {};
+        return PodArrayView<T>(reinterpret_cast<const T*>(static_cast<const uint8_t*>(m_base) + entry->offset),
+                               static_cast<std::size_t>(entry->count));
+    }
+
+private:
+    SnapshotReader() = default;
+
+    const SnapshotSectionEntry* find(SnapshotSection tag, uint32_t recordSize) const;
+
+    void*                       m_base{nullptr};
+    std::size_t                 m_bytes{0};
+    const SnapshotFileHeader*   m_header{nullptr};
+    const SnapshotSectionEntry* m_sections{nullptr};
+};
+
+#endif // SNAPSHOT_HPP
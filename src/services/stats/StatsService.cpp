@@ -0,0 +1,147 @@
+/**
+ * @file StatsService.cpp
+ * @brief Implementation of StatsService.
+ */
+
+#include "StatsService.hpp"
+
+#include "memory/BufferPool.hpp"
+#include "metrics/LatencyRecorder.hpp"
+#include "pod/PodView.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+StatsService::StatsService(std::shared_ptr<CalculationEngine> calculation, std::shared_ptr<ReportService> reports)
+    : m_calculation(std::move(calculation))
+    , m_reports(std::move(reports))
+{
+}
+
+void StatsService::attach(StatsSources sources)
+{
+    m_sources = std::move(sources);
+}
+
+Response StatsService::getStats(const Request& request)
+{
+    (void)request;
+
+    // ── Server-wide totals ────────────────────────────────────────────────
+    ServerStatsPOD server{};
+    server.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    if (m_sources.transport)
+    {
+        const TransportStats transport = m_sources.transport();
+        server.sessions                = static_cast<uint32_t>(transport.sessions);
+        server.queuedFrames            = transport.queuedFrames;
+        server.queuedBytes             = transport.queuedBytes;
+        server.maxSessionQueuedBytes   = transport.maxSessionQueuedBytes;
+        server.droppedFrames           = transport.droppedFrames;
+        server.slowConsumerDisconnects = transport.slowConsumerDisconnects;
+        server.handshakes              = transport.handshakes;
+        server.resumedHandshakes       = transport.resumedHandshakes;
+        server.failedHandshakes        = transport.failedHandshakes;
+        server.kernelTlsSessions       = transport.kernelTlsSessions;
+    }
+    if (m_reports)
+    {
+        const ReportCache::Stats cache = m_reports->cacheStats();
+        server.reportCacheHits         = cache.hits;
+        server.reportCacheMisses       = cache.misses;
+        server.reportCacheBytes        = cache.memoryBytes;
+    }
+    if (m_calculation)
+    {
+        const CalculationEngine::ResidentBookStats books = m_calculation->residentBookStats();
+        server.residentBookHits                          = books.hits;
+        server.residentBookMisses                        = books.misses;
+    }
+    BufferPool& pool       = BufferPool::instance();
+    server.heapAllocations = pool.heapAllocations();
+
+    // ── Latency percentiles and lane depth per request type ───────────────
+    const LatencyRecorder&       recorder = LatencyRecorder::instance();
+    std::vector<LatencyStatsPOD> latencies;
+    latencies.reserve(kRequestTypeCount * kLatencyStageCount);
+    for (std::size_t t = 0; t < kRequestTypeCount; ++t)
+    {
+        const auto     type   = static_cast<RequestType>(t);
+        const uint32_t queued = m_sources.queueDepth ? static_cast<uint32_t>(m_sources.queueDepth(type)) : 0;
+        for (std::size_t s = 0; s < kLatencyStageCount; ++s)
+        {
+            const LatencyHistogram histogram = recorder.histogram(type, static_cast<LatencyStage>(s));
+
+            LatencyStatsPOD record{};
+            record.requestType = static_cast<uint32_t>(type);
+            record.stage       = static_cast<uint8_t>(s);
+            record.queued      = queued;
+            record.count       = histogram.count();
+            record.p50         = histogram.percentile(50.0);
+            record.p90         = histogram.percentile(90.0);
+            record.p99         = histogram.percentile(99.0);
+            record.p999        = histogram.percentile(99.9);
+            record.max         = histogram.max();
+            record.mean        = static_cast<uint64_t>(histogram.mean());
+            latencies.push_back(record);
+        }
+    }
+
+    // ── Buffer pool occupancy ─────────────────────────────────────────────
+    std::vector<BufferPoolStatsPOD> classes(BufferPool::kClassCount);
+    for (uint32_t cls = 0; cls < BufferPool::kClassCount; ++cls)
+    {
+        const BufferPool::ClassStats stats = pool.classStats(cls);
+        classes[cls].blockSize             = stats.blockSize;
+        classes[cls].blocks                = stats.blocks;
+        classes[cls].idleShared            = stats.idleShared;
+    }
+
+    // ── Sessions ──────────────────────────────────────────────────────────
+    std::vector<SessionStatsPOD> sessions;
+    if (m_sources.sessions)
+    {
+        for (const SessionStats& session : m_sources.sessions())
+        {
+            SessionStatsPOD record{};
+            record.sessionId    = session.id;
+            record.requests     = session.requests;
+            record.bytesIn      = session.bytesIn;
+            record.bytesOut     = session.bytesOut;
+            record.queuedFrames = static_cast<uint32_t>(session.queuedFrames);
+            record.queuedBytes  = static_cast<uint32_t>(session.queuedBytes);
+            sessions.push_back(record);
+        }
+    }
+
+    // ── Service readiness ─────────────────────────────────────────────────
+    std::vector<ServiceReadinessPOD> services;
+    if (m_sources.services)
+    {
+        for (const ServiceStatus& status : m_sources.services())
+        {
+            ServiceReadinessPOD record{};
+            std::strncpy(record.name, status.name.c_str(), sizeof(record.name) - 1);
+            record.state      = static_cast<uint8_t>(status.state);
+            record.loadMillis = static_cast<uint32_t>(status.elapsed.count());
+            services.push_back(record);
+        }
+    }
+
+    Response response{true, "OK",
+                      PooledBuffer::uninitialized(pod::payloadSize<ServerStatsPOD>(1)
+                                                  + pod::payloadSize<LatencyStatsPOD>(latencies.size())
+                                                  + pod::payloadSize<BufferPoolStatsPOD>(classes.size())
+                                                  + pod::payloadSize<SessionStatsPOD>(sessions.size())
+                                                  + pod::payloadSize<ServiceReadinessPOD>(services.size()))};
+    uint8_t* out = response.data.data();
+    out += pod::writeArray(out, &server, 1);
+    out += pod::writeArray(out, latencies.data(), latencies.size());
+    out += pod::writeArray(out, classes.data(), classes.size());
+    out += pod::writeArray(out, sessions.data(), sessions.size());
+    pod::writeArray(out, services.data(), services.size());
+    return response;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file StatsService.hpp
+ * @brief GET_STATS: a packed snapshot of the server's counters.
+ *
+ * @details The reply data is a sequence of POD sections, each read with
+ * pod::bindSection() in this order:
+ *
+ *   1. ServerStatsPOD      — one record: transport, cache and pool totals
+ *   2. LatencyStatsPOD     — one per RequestType and stage, with lane depth
+ *   3. BufferPoolStatsPOD  — one per buffer pool size class
+ *   4. SessionStatsPOD     — one per live session
+ *   5. ServiceReadinessPOD — one per service of the staged startup
+ *
+ * Nothing here is counted on behalf of the snapshot. Every source keeps
+ * its own counters with relaxed atomics (latency histograms per thread)
+ * and this service only reads them, so a poll never holds a lock that a
+ * request or tick needs. The transport's session table lock is the one
+ * exception, and only session setup and teardown take it.
+ */
+
+#ifndef STATSSERVICE_HPP
+#define STATSSERVICE_HPP
+
+#include "CalculationEngine.hpp"
+#include "ReportService.hpp"
+#include "transport/TransportStats.hpp"
+#include "server/RequestTypes.hpp"
+#include "server/ServiceStatus.hpp"
+#include "services/IStatsService.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct StatsSources
+ * @brief Counters owned by layers built after the services; any may be empty.
+ */
+struct StatsSources
+{
+    /// Transport-wide queue and handshake counters.
+    std::function<TransportStats()> transport;
+
+    /// Throughput of every live session.
+    std::function<std::vector<SessionStats>()> sessions;
+
+    /// Requests of a type waiting for a worker.
+    std::function<std::size_t(RequestType)> queueDepth;
+
+    /// Load state of every service, while starting up and after.
+    std::function<std::vector<ServiceStatus>()> services;
+};
+
+/**
+ * @class StatsService
+ * @brief IStatsService over the engines, the latency recorder, the buffer
+ *        pool and the attached transport and pipeline.
+ */
+class StatsService final : public IStatsService
+{
+public:
+    /**
+     * @param calculation Source of the resident book hit rate; may be null.
+     * @param reports     Source of the report cache hit rate; may be null.
+     */
+    StatsService(std::shared_ptr<CalculationEngine> calculation, std::shared_ptr<ReportService> reports);
+
+    /**
+     * @brief Read transport and pipeline counters through @p sources.
+     * @details Call once, before the transport starts; whatever the
+     *          sources capture must outlive this service's use of it.
+     */
+    void attach(StatsSources sources);
+
+    /// @copydoc IStatsService::getStats
+    Response getStats(const Request& request) override;
+
+private:
+    std::shared_ptr<CalculationEngine> m_calculation;
+    std::shared_ptr<ReportService>     m_reports;
+    StatsSources                       m_sources;
+};
+
+#endif // STATSSERVICE_HPP
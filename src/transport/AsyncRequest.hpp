@@ -0,0 +1,103 @@
+/**
+ * @file AsyncRequest.hpp
+ * @brief Asio completion-token front end for IServerFacade::handleRequestAsync().
+ *
+ * @details asyncHandleRequest() starts a request on a facade and completes
+ * with its final Response through any Asio completion token: a plain
+ * callback, boost::asio::use_future, or, in a C++20 build
+ * (-DHFT_CXX_STANDARD=20), boost::asio::use_awaitable. A coroutine can then
+ * write
+ *
+ *     Response reply = co_await asyncHandleRequest(*facade, request, executor, use_awaitable);
+ *
+ * and wait for a worker, an order book thread or a command's own I/O
+ * without holding a thread, instead of nesting its next step in the
+ * callback.
+ *
+ * The completion handler runs on its associated executor, or on
+ * @p executor if it has none, never on the thread that finished the
+ * request; that executor counts the request as outstanding work until
+ * then. Parts of a streamed reply (Response::more set) go to @p onPart on
+ * the producing thread, in order; only the final part completes the
+ * operation.
+ */
+
+#ifndef ASYNCREQUEST_HPP
+#define ASYNCREQUEST_HPP
+
+#include "server/IServerFacade.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+
+namespace detail
+{
+    /// Starts the request; owns the handler until the final response arrives.
+    struct AsyncRequestInitiation
+    {
+        template <typename Handler, typename Executor>
+        void operator()(Handler&& handler, IServerFacade* facade, Request request, ResponseCallback onPart,
+                        const Executor& executor) const
+        {
+            using HandlerType = std::decay_t<Handler>;
+            using WorkGuard   = boost::asio::executor_work_guard<
+                boost::asio::associated_executor_t<HandlerType, Executor>>;
+
+            // ResponseCallback must be copyable; the handler need not be.
+            struct Pending
+            {
+                HandlerType handler;
+                WorkGuard   work;
+            };
+            WorkGuard  work(boost::asio::get_associated_executor(handler, executor));
+            const auto pending = std::make_shared<Pending>(Pending{std::forward<Handler>(handler), std::move(work)});
+
+            facade->handleRequestAsync(
+                std::move(request), [pending, onPart = std::move(onPart)](Response response) {
+                    if (response.more)
+                    {
+                        if (onPart)
+                            onPart(std::move(response));
+                        return;
+                    }
+                    boost::asio::post(pending->work.get_executor(),
+                                      [pending, response = std::move(response)]() mutable {
+                                          pending->handler(std::move(response));
+                                          pending->work.reset();
+                                      });
+                });
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Run @p request on @p facade and complete with its final Response.
+ * @param facade   Executes the request; must outlive the operation.
+ * @param request  The decoded request.
+ * @param executor Runs the completion handler unless it has an associated executor.
+ * @param onPart   Receives the parts of a streamed reply on the producing thread; may be empty.
+ * @param token    Completion token with signature void(Response).
+ */
+template <typename Executor, typename CompletionToken>
+auto asyncHandleRequest(IServerFacade& facade, Request request, const Executor& executor, ResponseCallback onPart,
+                        CompletionToken&& token)
+{
+    return boost::asio::async_initiate<CompletionToken, void(Response)>(
+        detail::AsyncRequestInitiation{}, token, &facade, std::move(request), std::move(onPart), executor);
+}
+
+/// @brief As above, for requests whose reply is not streamed (parts are discarded).
+template <typename Executor, typename CompletionToken>
+auto asyncHandleRequest(IServerFacade& facade, Request request, const Executor& executor, CompletionToken&& token)
+{
+    return asyncHandleRequest(facade, std::move(request), executor, ResponseCallback{},
+                              std::forward<CompletionToken>(token));
+}
+
+#endif // ASYNCREQUEST_HPP
@@ -6,39 +6,56 @@
  * Each message on the wire is:
  *   [ 4-byte big-endian uint32_t length ][ <length> bytes payload ]
  *
- * The io_context runs on a dedicated background thread started by start().
- * send() and receive() perform synchronous writes / reads on the active
- * SSL socket and are safe to call from any thread after start() returns.
+ * start() launches an IoContextPool (one io_context per thread). Each
+ * accepted socket is created on the next context in round-robin order, so
+ * all of its handlers run on one thread. Every handshaked connection is
+ * handed to its own SslSession, which drives the async read → facade
+ * dispatch → async write loop for that client. Broadcasts, pushes and
+ * statistics are SessionTransport's.
+ *
+ * With a handshake pool, the socket's TCP layer is first moved onto a
+ * handshake context. The SSL stream and its internal timers stay on the
+ * session's context. After the handshake, the descriptor is released from
+ * the handshake reactor and assigned to the session's context before the
+ * session starts there.
+ *
+ * With TransportConfig::kernelTls, the socket is offered to the kernel for
+ * record encryption before the session is created (see KernelTls.hpp).
  */
 
 #include "BoostAsioSslTransport.hpp"
 
-#include <array>
-#include <cstring>
+#include "KernelTls.hpp"
+#include "logging/Log.hpp"
+
 #include <stdexcept>
+#include <string>
+#include <utility>
 
-#include <spdlog/spdlog.h>
+#include <openssl/ssl.h>
+#include <unistd.h>
 
 namespace
 {
-    /// Encode a 32-bit value as 4 big-endian bytes.
-    std::array<uint8_t, 4> encodeBE32(uint32_t value)
-    {
-        return {{
-            static_cast<uint8_t>((value >> 24) & 0xFF),
-            static_cast<uint8_t>((value >> 16) & 0xFF),
-            static_cast<uint8_t>((value >>  8) & 0xFF),
-            static_cast<uint8_t>( value        & 0xFF)
-        }};
-    }
+    /// TLS 1.2 suites: forward-secret ECDHE with AES-GCM only, fastest first.
+    constexpr const char* kTls12Ciphers = "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:"
+                                          "ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384";
+
+    /// TLS 1.3 suites (always ECDHE), AES-GCM first.
+    constexpr const char* kTls13Ciphers = "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256";
 
-    /// Decode 4 big-endian bytes into a 32-bit value.
-    uint32_t decodeBE32(const uint8_t* bytes)
+    /// Key exchange groups in order of preference.
+    constexpr const char* kGroups = "X25519:P-256:P-384";
+
+    /// Scopes cached sessions to this server.
+    constexpr unsigned char kSessionIdContext[] = "hft_server";
+
+    /// "address:port" of the client, for logs; only called when the line is enabled.
+    std::string peerName(const boost::asio::ip::tcp::socket& socket)
     {
-        return (static_cast<uint32_t>(bytes[0]) << 24)
-             | (static_cast<uint32_t>(bytes[1]) << 16)
-             | (static_cast<uint32_t>(bytes[2]) <<  8)
-             |  static_cast<uint32_t>(bytes[3]);
+        boost::system::error_code ec;
+        const auto                remote = socket.remote_endpoint(ec);
+        return ec ? std::string("unknown peer") : remote.address().to_string() + ":" + std::to_string(remote.port());
     }
 } // namespace
 
@@ -46,28 +63,72 @@ namespace
 // Constructor
 // ==========================================================================
 
-BoostAsioSslTransport::BoostAsioSslTransport(const std::string& host,
-                                             uint16_t           port,
-                                             const std::string& certFile,
-                                             const std::string& keyFile)
-    : m_host(host)
+BoostAsioSslTransport::BoostAsioSslTransport(const std::string&             host,
+                                             uint16_t                       port,
+                                             const std::string&             certFile,
+                                             const std::string&             keyFile,
+                                             std::shared_ptr<IServerFacade> facade,
+                                             TransportConfig                config)
+    : SessionTransport(std::move(facade), config)
+    , m_host(host)
     , m_port(port)
     , m_certFile(certFile)
     , m_keyFile(keyFile)
-    , m_ioContext()
+    , m_handshakePool(config.handshakeThreads > 0 ? std::make_unique<IoContextPool>(config.handshakeThreads)
+                                                  : nullptr)
     , m_sslContext(boost::asio::ssl::context::tls_server)
-    , m_acceptor(m_ioContext)
-    , m_workGuard(boost::asio::make_work_guard(m_ioContext))
+    , m_acceptor(m_ioPool.ioContextAt(0))
 {
-    // ── SSL context configuration ──────────────────────────────────────────
+    configureTls();
+
+    m_sslContext.use_certificate_chain_file(m_certFile);
+    m_sslContext.use_private_key_file(m_keyFile, boost::asio::ssl::context::pem);
+}
+
+// ==========================================================================
+// configureTls() — versions, cipher preference, session resumption
+// ==========================================================================
+
+void BoostAsioSslTransport::configureTls()
+{
+    // Every AES-GCM suite needs TLS 1.2 or later.
     m_sslContext.set_options(
         boost::asio::ssl::context::default_workarounds |
         boost::asio::ssl::context::no_sslv2            |
         boost::asio::ssl::context::no_sslv3            |
+        boost::asio::ssl::context::no_tlsv1            |
+        boost::asio::ssl::context::no_tlsv1_1          |
         boost::asio::ssl::context::single_dh_use);
 
-    m_sslContext.use_certificate_chain_file(m_certFile);
-    m_sslContext.use_private_key_file(m_keyFile, boost::asio::ssl::context::pem);
+    SSL_CTX* ctx = m_sslContext.native_handle();
+    SSL_CTX_set_options(ctx, SSL_OP_CIPHER_SERVER_PREFERENCE | SSL_OP_NO_RENEGOTIATION);
+    if (SSL_CTX_set_cipher_list(ctx, kTls12Ciphers) != 1 || SSL_CTX_set_ciphersuites(ctx, kTls13Ciphers) != 1
+        || SSL_CTX_set1_groups_list(ctx, kGroups) != 1)
+        throw std::runtime_error("[BoostAsioSslTransport] OpenSSL rejected the cipher configuration");
+
+    // Resumption: a stateful cache for clients that send a session id and
+    // stateless tickets for the rest, both valid for the same lifetime.
+    if (m_config.tlsSessionLifetime.count() > 0)
+    {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(ctx, static_cast<long>(m_config.tlsSessionCacheSize));
+        SSL_CTX_set_timeout(ctx, static_cast<long>(m_config.tlsSessionLifetime.count()));
+        SSL_CTX_set_session_id_context(ctx, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+        SSL_CTX_set_num_tickets(ctx, 1);
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+        SSL_CTX_set_num_tickets(ctx, 0);
+    }
+
+    if (m_config.kernelTls)
+    {
+        if (!ktls::available())
+            HFT_LOG_WARN("[transport] Kernel TLS is not supported by this build; encrypting in user space");
+        ktls::prepareContext(ctx);
+    }
 }
 
 // ==========================================================================
@@ -80,7 +141,7 @@ BoostAsioSslTransport::~BoostAsioSslTransport()
 }
 
 // ==========================================================================
-// start() — bind, listen, launch io_context thread, begin accept loop
+// start() — bind, listen, launch io_context threads, begin accept loop
 // ==========================================================================
 
 void BoostAsioSslTransport::start()
@@ -97,22 +158,18 @@ void BoostAsioSslTransport::start()
     m_acceptor.bind(endpoint);
     m_acceptor.listen(boost::asio::socket_base::max_listen_connections);
 
-    spdlog::info("[transport] Listening on {}:{}", m_host, m_port);
+    HFT_LOG_INFO("[transport] Listening on {}:{} ({} io thread(s){}, {} handshake thread(s))",
+                 m_host, m_port, m_ioPool.size(),
+                 m_config.pinCpus ? ", pinned" : "",
+                 m_handshakePool ? m_handshakePool->size() : 0);
 
     // ── Start accepting connections ────────────────────────────────────────
     acceptNextConnection();
 
-    // ── Run io_context on a dedicated background thread ───────────────────
-    m_ioThread = std::thread([this]() {
-        try
-        {
-            m_ioContext.run();
-        }
-        catch (const std::exception& ex)
-        {
-            spdlog::error("[transport] io_context error: {}", ex.what());
-        }
-    });
+    // ── Run one thread per io_context ─────────────────────────────────────
+    m_ioPool.start();
+    if (m_handshakePool)
+        m_handshakePool->start();
 }
 
 // ==========================================================================
@@ -128,155 +185,148 @@ void BoostAsioSslTransport::stop()
     boost::system::error_code ec;
     m_acceptor.close(ec);
 
-    // Shut down the active socket if one exists.
-    {
-        std::lock_guard<std::mutex> lock(m_socketMutex);
-        if (m_activeSocket)
-        {
-            m_activeSocket->lowest_layer().cancel(ec);
-            m_activeSocket->lowest_layer().close(ec);
-            m_activeSocket.reset();
-        }
-    }
-
-    // Release the work guard so io_context::run() can return.
-    m_workGuard.reset();
-    m_ioContext.stop();
-
-    if (m_ioThread.joinable())
-        m_ioThread.join();
-
-    spdlog::info("[transport] Stopped.");
-}
-
-// ==========================================================================
-// send() — length-prefix frame then write payload to active SSL socket
-// ==========================================================================
-
-void BoostAsioSslTransport::send(const RawBuffer& buffer)
-{
-    std::lock_guard<std::mutex> lock(m_socketMutex);
-
-    if (!m_activeSocket)
-        throw std::runtime_error("[BoostAsioSslTransport] send(): no active connection");
-
-    // Build the 4-byte length header + payload in a single gather-write.
-    const auto header = encodeBE32(static_cast<uint32_t>(buffer.size()));
-
-    const std::array<boost::asio::const_buffer, 2> bufs = {{
-        boost::asio::buffer(header),
-        boost::asio::buffer(buffer)
-    }};
-
-    boost::system::error_code ec;
-    boost::asio::write(*m_activeSocket, bufs, ec);
-
-    if (ec)
-        throw std::runtime_error(
-            "[BoostAsioSslTransport] send() failed: " + ec.message());
-}
-
-// ==========================================================================
-// receive() — read length-prefix header then payload from active SSL socket
-// ==========================================================================
-
-RawBuffer BoostAsioSslTransport::receive()
-{
-    std::lock_guard<std::mutex> lock(m_socketMutex);
-
-    if (!m_activeSocket)
-        throw std::runtime_error("[BoostAsioSslTransport] receive(): no active connection");
+    // Join the handshake threads first so that no session is added while
+    // the live ones are being closed. Sockets still handshaking are
+    // dropped with the pool.
+    if (m_handshakePool)
+        m_handshakePool->stop();
 
-    // ── Read the 4-byte length header ──────────────────────────────────────
-    std::array<uint8_t, 4> header{};
-    boost::system::error_code ec;
-
-    boost::asio::read(*m_activeSocket,
-                      boost::asio::buffer(header),
-                      boost::asio::transfer_exactly(4),
-                      ec);
-    if (ec)
-        throw std::runtime_error(
-            "[BoostAsioSslTransport] receive() header read failed: " + ec.message());
+    // Close every live session. The closes are posted to each session's
+    // io_context ahead of the pool's stop request, so they run first.
+    closeSessions();
 
-    const uint32_t payloadLen = decodeBE32(header.data());
+    m_ioPool.stop();
 
-    if (payloadLen == 0)
-        return {};
-
-    // ── Read the payload ───────────────────────────────────────────────────
-    RawBuffer payload(payloadLen);
-    boost::asio::read(*m_activeSocket,
-                      boost::asio::buffer(payload),
-                      boost::asio::transfer_exactly(payloadLen),
-                      ec);
-    if (ec)
-        throw std::runtime_error(
-            "[BoostAsioSslTransport] receive() payload read failed: " + ec.message());
-
-    return payload;
+    HFT_LOG_INFO("[transport] Stopped.");
 }
 
 // ==========================================================================
-// acceptNextConnection() — async accept → SSL handshake → set active socket
+// acceptNextConnection() — async accept → re-arm → SSL handshake
 // ==========================================================================
 
 void BoostAsioSslTransport::acceptNextConnection()
 {
-    auto socket = std::make_shared<SslSocket>(m_ioContext, m_sslContext);
+    // Bind the new connection to the next io_context for its whole
+    // lifetime; with a handshake pool, only its TCP layer starts out there.
+    boost::asio::io_context& sessionContext = m_ioPool.getIoContext();
+    auto socket = std::make_shared<SslSocket>(sessionContext, m_sslContext);
+    if (m_handshakePool)
+        socket->next_layer() = boost::asio::ip::tcp::socket(m_handshakePool->getIoContext());
 
     m_acceptor.async_accept(
         socket->lowest_layer(),
-        [this, socket](const boost::system::error_code& ec)
+        [this, socket, &sessionContext](const boost::system::error_code& ec)
         {
             if (ec)
             {
                 if (ec != boost::asio::error::operation_aborted)
-                    spdlog::error("[transport] accept error: {}", ec.message());
+                    HFT_LOG_ERROR("[transport] accept error: {}", ec.message());
                 return; // acceptor was closed — do not re-arm
             }
 
-            spdlog::info("[transport] Accepted connection from {}",
-                         socket->lowest_layer().remote_endpoint().address().to_string()
-                         + ":" + std::to_string(socket->lowest_layer().remote_endpoint().port()));
+            // Re-arm straight away so a slow handshake never delays the
+            // next client's accept.
+            if (m_running)
+                acceptNextConnection();
+
+            HFT_LOG_INFO("[transport] Accepted connection from {}", peerName(socket->next_layer()));
 
-            // Disable Nagle for low-latency HFT traffic.
-            socket->lowest_layer().set_option(
-                boost::asio::ip::tcp::no_delay(true));
+            // Nagle off (by default) for low-latency HFT traffic.
+            tuneTcpSocket(socket->next_layer());
 
-            doHandshake(socket);
+            doHandshake(socket, sessionContext);
         });
 }
 
 // ==========================================================================
-// doHandshake() — async TLS server handshake, then promote to active socket
+// doHandshake() — async TLS server handshake, then start a session
 // ==========================================================================
 
-void BoostAsioSslTransport::doHandshake(std::shared_ptr<SslSocket> socket)
+void BoostAsioSslTransport::doHandshake(std::shared_ptr<SslSocket> socket, boost::asio::io_context& sessionContext)
 {
     socket->async_handshake(
         boost::asio::ssl::stream_base::server,
-        [this, socket](const boost::system::error_code& ec)
+        [this, socket, &sessionContext](const boost::system::error_code& ec)
         {
             if (ec)
             {
-                spdlog::warn("[transport] TLS handshake failed: {}", ec.message());
-                // Re-arm accept so the server keeps running.
-                if (m_running)
-                    acceptNextConnection();
+                m_counters->failedHandshakes.fetch_add(1, std::memory_order_relaxed);
+                HFT_LOG_WARN("[transport] TLS handshake failed: {}", ec.message());
                 return;
             }
 
-            spdlog::info("[transport] TLS handshake complete.");
+            if (!m_running)
+                return;
 
+            if (m_handshakePool && !moveToContext(*socket, sessionContext))
             {
-                std::lock_guard<std::mutex> lock(m_socketMutex);
-                m_activeSocket = socket;
+                m_counters->failedHandshakes.fetch_add(1, std::memory_order_relaxed);
+                return;
             }
 
-            // Re-arm accept so the server is ready for the next client
-            // once the current one disconnects.
-            if (m_running)
-                acceptNextConnection();
+            const bool resumed = SSL_session_reused(socket->native_handle()) == 1;
+            m_counters->handshakes.fetch_add(1, std::memory_order_relaxed);
+            if (resumed)
+                m_counters->resumedHandshakes.fetch_add(1, std::memory_order_relaxed);
+
+            const uint64_t id = nextSessionId();
+            HFT_LOG_INFO("[transport] TLS handshake complete — session {}{}", id, resumed ? " (resumed)" : "");
+
+            // Nothing has been written since the handshake, so the kernel
+            // can take over at OpenSSL's current record sequence number.
+            bool kernelTls = false;
+            if (m_config.kernelTls)
+            {
+                const std::string reason =
+                    ktls::enableTransmit(socket->native_handle(), socket->next_layer().native_handle());
+                kernelTls = reason.empty();
+                if (kernelTls)
+                    m_counters->kernelTlsSessions.fetch_add(1, std::memory_order_relaxed);
+                else
+                    HFT_LOG_DEBUG("[transport] Session {} encrypts in user space: {}", id, reason);
+            }
+
+            auto session = std::make_shared<SslSession>(id, socket, m_facade, closeHandler(), m_config, m_counters,
+                                                        kernelTls);
+            addSession(session);
+
+            // The session's handlers all run on its own context.
+            boost::asio::post(sessionContext, [session]() { session->start(); });
         });
 }
+
+// ==========================================================================
+// moveToContext() — hand a handshaked socket to its session's io_context
+// ==========================================================================
+
+bool BoostAsioSslTransport::moveToContext(SslSocket& socket, boost::asio::io_context& sessionContext)
+{
+    // No operation is pending on the socket here, so the descriptor can
+    // leave the handshake reactor and join the session's.
+    boost::system::error_code ec;
+    boost::asio::ip::tcp::socket& tcp      = socket.next_layer();
+    const auto                    protocol = tcp.local_endpoint(ec).protocol();
+    if (ec)
+    {
+        HFT_LOG_WARN("[transport] Connection lost after TLS handshake: {}", ec.message());
+        return false;
+    }
+
+    const auto descriptor = tcp.release(ec);
+    if (ec)
+    {
+        HFT_LOG_WARN("[transport] Cannot release handshaked socket: {}", ec.message());
+        return false;
+    }
+
+    boost::asio::ip::tcp::socket moved(sessionContext);
+    moved.assign(protocol, descriptor, ec);
+    if (ec)
+    {
+        ::close(descriptor);
+        HFT_LOG_WARN("[transport] Cannot move handshaked socket: {}", ec.message());
+        return false;
+    }
+    tcp = std::move(moved);
+    return true;
+}
@@ -12,22 +12,35 @@
  *   [ 4 bytes big-endian uint32_t payload length ][ <length> bytes payload ]
  *
  * ### Connection model
- * The server accepts one client connection at a time. After a client
- * disconnects (or an error occurs) `acceptNextConnection()` is re-invoked
- * automatically so the server is always ready for the next client.
+ * Every accepted and handshaked connection becomes an independent
+ * SslSession with its own socket and async read/dispatch/write loop, so any
+ * number of clients can be served concurrently. The acceptor is re-armed
+ * immediately after each accept.
+ *
+ * ### TLS
+ * TLS 1.2 and 1.3 only, ECDHE key exchange and AES-GCM preferred by the
+ * server. Sessions can be resumed from the server-side cache or a session
+ * ticket for TransportConfig::tlsSessionLifetime, so a reconnecting client
+ * skips the key exchange and certificate signature. With
+ * TransportConfig::handshakeThreads > 0, handshakes run on their own
+ * IoContextPool. The socket is registered there until the handshake
+ * completes and then moves to its session's io_context, so a reconnect
+ * storm does not delay the connected sessions.
  */
 
 #ifndef BOOSTASIOSSL_TRANSPORT_HPP
 #define BOOSTASIOSSL_TRANSPORT_HPP
 
-#include "transport/ITransport.hpp"
+#include "server/IServerFacade.hpp"
+
+#include "IoContextPool.hpp"
+#include "SessionTransport.hpp"
+#include "StreamSession.hpp"
+#include "TransportConfig.hpp"
 
-#include <atomic>
 #include <cstdint>
 #include <memory>
-#include <mutex>
 #include <string>
-#include <thread>
 
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
@@ -36,11 +49,15 @@
  * @class BoostAsioSslTransport
  * @brief Boost.Asio + SSL/TLS implementation of ITransport.
  *
- * Manages the io_context, SSL context, and the acceptor/socket lifecycle.
- * `start()` runs the io_context on a dedicated background thread.
- * `send()` and `receive()` operate on the currently active SSL socket.
+ * Manages the SSL context, acceptor and handshake pool; the io_context
+ * pool and the set of live sessions are SessionTransport's. `start()`
+ * launches one thread per io_context; each accepted connection is bound
+ * round-robin to one context for its lifetime. Inbound frames are
+ * dispatched to the injected IServerFacade by each session, and `send()`
+ * pushes a frame to every connected client. As an ISessionPublisher,
+ * `publish()` pushes responses to one session.
  */
-class BoostAsioSslTransport : public ITransport
+class BoostAsioSslTransport final : public SessionTransport
 {
 public:
     /**
@@ -49,20 +66,18 @@ public:
      * @param port      TCP port to listen on.
      * @param certFile  Path to the PEM-encoded server certificate.
      * @param keyFile   Path to the PEM-encoded private key.
+     * @param facade    Server entry point that executes client requests.
+     * @param config    Threading, coalescing and outbound queue options.
      */
-    explicit BoostAsioSslTransport(const std::string& host,
-                                   uint16_t           port,
-                                   const std::string& certFile,
-                                   const std::string& keyFile);
+    explicit BoostAsioSslTransport(const std::string&             host,
+                                   uint16_t                       port,
+                                   const std::string&             certFile,
+                                   const std::string&             keyFile,
+                                   std::shared_ptr<IServerFacade> facade,
+                                   TransportConfig                config = {});
 
     ~BoostAsioSslTransport() override;
 
-    /// @copydoc ITransport::send
-    void send(const RawBuffer& buffer) override;
-
-    /// @copydoc ITransport::receive
-    RawBuffer receive() override;
-
     /// @copydoc ITransport::start
     void start() override;
 
@@ -70,36 +85,32 @@ public:
     void stop() override;
 
 private:
-    using SslSocket = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
+    using SslSocket = SslStream;
 
     /// Begin an async accept cycle; re-invoked after each connection.
     void acceptNextConnection();
 
-    /// Perform the async SSL handshake then mark the socket as active.
-    void doHandshake(std::shared_ptr<SslSocket> socket);
+    /// Protocol versions, ciphers and session resumption of m_sslContext.
+    void configureTls();
+
+    /// Perform the async SSL handshake then start a session on the socket.
+    void doHandshake(std::shared_ptr<SslSocket> socket, boost::asio::io_context& sessionContext);
+
+    /// Move a socket from the handshake pool to @p sessionContext.
+    static bool moveToContext(SslSocket& socket, boost::asio::io_context& sessionContext);
 
     std::string  m_host;
     uint16_t     m_port;
     std::string  m_certFile;
     std::string  m_keyFile;
 
-    boost::asio::io_context        m_ioContext;
+    /// Contexts that run TLS handshakes; null when they run on m_ioPool.
+    /// Destroyed before the base's m_ioPool: sockets still handshaking hold
+    /// timers of m_ioPool's contexts.
+    std::unique_ptr<IoContextPool> m_handshakePool;
+
     boost::asio::ssl::context      m_sslContext;
     boost::asio::ip::tcp::acceptor m_acceptor;
-
-    /// Work guard keeps io_context alive even when there are no pending ops.
-    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_workGuard;
-
-    /// Background thread that drives the io_context event loop.
-    std::thread m_ioThread;
-
-    /// The currently active (connected + handshaked) SSL socket.
-    std::shared_ptr<SslSocket> m_activeSocket;
-
-    /// Protects m_activeSocket from concurrent access by send/receive.
-    std::mutex m_socketMutex;
-
-    std::atomic<bool> m_running{false};
 };
 
 #endif // BOOSTASIOSSL_TRANSPORT_HPP
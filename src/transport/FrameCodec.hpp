@@ -0,0 +1,279 @@
+/**
+ * @file FrameCodec.hpp
+ * @brief Wire encoding of Request / Response payloads and the length prefix.
+ *
+ * @details Header-only and free of Boost.Asio so that the framing rules can
+ * be shared by every transport implementation and exercised directly by the
+ * unit-test suite. Decoding never copies: Request::payload and
+ * Response::data are slices of the buffer they were decoded from.
+ *
+ * ### Frame layout
+ *   [ 4 bytes big-endian uint32_t payload length ][ <length> bytes payload ]
+ *
+ * ### Request payload
+ *   [ 4 bytes big-endian header: bits 0-15 RequestType, bits 16-31 request flags ]
+ *   [ 8 bytes big-endian request id, if request flag bit 0 is set ][ operation-specific parameters ]
+ *
+ * Request flag bits 1-3 list the codecs the client can decode a reply's
+ * data with (LZ4, zstd, deflate; see PayloadCompression.hpp).
+ *
+ * ### Response payload
+ *   [ 1 byte status flags (bit 0 success, bit 1 push, bit 2 more, bit 3 request id,
+ *     bits 4-5 codec of Response::data, 0 = uncompressed) ]
+ *   [ 8 bytes big-endian request id, if status bit 3 is set ][ 4 bytes big-endian message length ]
+ *   [ <message length> bytes message ][ remaining bytes: Response::data ]
+ *
+ * A request without an id is answered in lock-step: the session reads the
+ * next frame once the reply has been queued. A request with an id may be
+ * followed by more requests straight away. Its reply, and every part of a
+ * streamed reply, carries the same id and can arrive in any order relative
+ * to the replies of other requests. Clients that never set the flag see the
+ * original format unchanged.
+ */
+
+#ifndef FRAMECODEC_HPP
+#define FRAMECODEC_HPP
+
+#include "models/Request.hpp"
+#include "models/Response.hpp"
+#include "transport/ITransport.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace framing
+{
+    /// Size of the big-endian length prefix that precedes every frame.
+    constexpr std::size_t kLengthPrefixSize = 4;
+
+    /// Upper bound on a single frame payload; larger frames are rejected.
+    constexpr uint32_t kMaxFrameSize = 64u * 1024u * 1024u;
+
+    /// Size of the fixed response header (status flags + message length).
+    constexpr std::size_t kResponseHeaderSize = 1 + 4;
+
+    /// Response status flag: the operation completed successfully.
+    constexpr uint8_t kResponseSuccess = 0x01;
+
+    /// Response status flag: server-initiated push, not a reply to a request.
+    constexpr uint8_t kResponsePush = 0x02;
+
+    /// Response status flag: partial reply; more responses to the same request follow.
+    constexpr uint8_t kResponseMore = 0x04;
+
+    /// Response status flag: a request id follows the status byte.
+    constexpr uint8_t kResponseRequestId = 0x08;
+
+    /// Response status bits naming the codec of Response::data (0 = none).
+    constexpr uint8_t kResponseCodecMask = 0x30;
+
+    /// Shift of the codec within the response status byte.
+    constexpr unsigned kResponseCodecShift = 4;
+
+    /// Request flag: a request id follows the header.
+    constexpr uint16_t kRequestHasId = 0x0001;
+
+    /// Request flags listing the codecs the client accepts (Request::acceptCodecs).
+    constexpr uint16_t kRequestAcceptCodecs = 0x000E;
+
+    /// Shift of Request::acceptCodecs within the request flags.
+    constexpr unsigned kRequestAcceptShift = 1;
+
+    /// Request flags this build understands; frames with others set are rejected.
+    constexpr uint16_t kKnownRequestFlags = kRequestHasId | kRequestAcceptCodecs;
+
+    /// Size of the fixed request header (type + flags).
+    constexpr std::size_t kRequestHeaderSize = 4;
+
+    /// Size of a request id on the wire.
+    constexpr std::size_t kRequestIdSize = 8;
+
+    /// Encode a 32-bit value as 4 big-endian bytes.
+    inline std::array<uint8_t, 4> encodeBE32(uint32_t value)
+    {
+        return {{
+            static_cast<uint8_t>((value >> 24) & 0xFF),
+            static_cast<uint8_t>((value >> 16) & 0xFF),
+            static_cast<uint8_t>((value >>  8) & 0xFF),
+            static_cast<uint8_t>( value        & 0xFF)
+        }};
+    }
+
+    /// Write a 32-bit value as 4 big-endian bytes at @p out.
+    inline void writeBE32(uint8_t* out, uint32_t value)
+    {
+        const auto bytes = encodeBE32(value);
+        std::memcpy(out, bytes.data(), bytes.size());
+    }
+
+    /// Decode 4 big-endian bytes into a 32-bit value.
+    inline uint32_t decodeBE32(const uint8_t* bytes)
+    {
+        return (static_cast<uint32_t>(bytes[0]) << 24)
+             | (static_cast<uint32_t>(bytes[1]) << 16)
+             | (static_cast<uint32_t>(bytes[2]) <<  8)
+             |  static_cast<uint32_t>(bytes[3]);
+    }
+
+    /// Write a 64-bit value as 8 big-endian bytes at @p out.
+    inline void writeBE64(uint8_t* out, uint64_t value)
+    {
+        writeBE32(out, static_cast<uint32_t>(value >> 32));
+        writeBE32(out + 4, static_cast<uint32_t>(value));
+    }
+
+    /// Decode 8 big-endian bytes into a 64-bit value.
+    inline uint64_t decodeBE64(const uint8_t* bytes)
+    {
+        return (static_cast<uint64_t>(decodeBE32(bytes)) << 32) | decodeBE32(bytes + 4);
+    }
+
+    /**
+     * @brief Decode a request payload (without the length prefix).
+     * @param payload Raw bytes read from the wire.
+     * @param out     Receives the decoded request on success.
+     * @return false if the payload is too short for its header, or sets a
+     *         request flag this build does not know.
+     */
+    inline bool decodeRequest(const RawBuffer& payload, Request& out)
+    {
+        if (payload.size() < kRequestHeaderSize)
+            return false;
+
+        const uint32_t header = decodeBE32(payload.data());
+        const auto     flags  = static_cast<uint16_t>(header >> 16);
+        if ((flags & ~kKnownRequestFlags) != 0)
+            return false;
+
+        std::size_t offset = kRequestHeaderSize;
+        out.hasRequestId   = (flags & kRequestHasId) != 0;
+        out.requestId      = 0;
+        out.acceptCodecs   = static_cast<uint8_t>((flags & kRequestAcceptCodecs) >> kRequestAcceptShift);
+        if (out.hasRequestId)
+        {
+            if (payload.size() < offset + kRequestIdSize)
+                return false;
+            out.requestId = decodeBE64(payload.data() + offset);
+            offset += kRequestIdSize;
+        }
+
+        out.type    = static_cast<RequestType>(header & 0xFFFFu);
+        out.payload = payload.slice(offset, payload.size() - offset); // shares the frame buffer
+        return true;
+    }
+
+    /**
+     * @brief Encode a request payload (without the length prefix).
+     * @param request The request to serialise; its id is sent if hasRequestId,
+     *                and its accepted codecs in the request flags.
+     * @return The header, the optional request id and the request parameters.
+     */
+    inline RawBuffer encodeRequest(const Request& request)
+    {
+        const std::size_t idSize = request.hasRequestId ? kRequestIdSize : 0;
+        const auto        flags  = static_cast<uint16_t>(
+            (request.hasRequestId ? kRequestHasId : 0)
+            | ((static_cast<uint16_t>(request.acceptCodecs) << kRequestAcceptShift) & kRequestAcceptCodecs));
+
+        RawBuffer out = RawBuffer::uninitialized(kRequestHeaderSize + idSize + request.payload.size());
+        writeBE32(out.data(), static_cast<uint32_t>(flags) << 16 | (static_cast<uint32_t>(request.type) & 0xFFFFu));
+        if (request.hasRequestId)
+            writeBE64(out.data() + kRequestHeaderSize, request.requestId);
+        if (!request.payload.empty())
+            std::memcpy(out.data() + kRequestHeaderSize + idSize, request.payload.data(), request.payload.size());
+        return out;
+    }
+
+    /**
+     * @brief Encode a response into a complete frame, length prefix included.
+     *
+     * The whole frame is produced in a single contiguous buffer so that it
+     * can be written with one call (and, over TLS, one record).
+     *
+     * @param response The response to serialise.
+     * @return [length][flags][request id, if tagged][message length][message][data].
+     */
+    inline RawBuffer encodeResponseFrame(const Response& response)
+    {
+        const std::size_t idSize = response.hasRequestId ? kRequestIdSize : 0;
+        const std::size_t payloadLen =
+            kResponseHeaderSize + idSize + response.message.size() + response.data.size();
+
+        RawBuffer frame = RawBuffer::uninitialized(kLengthPrefixSize + payloadLen);
+        uint8_t*  out   = frame.data();
+
+        writeBE32(out, static_cast<uint32_t>(payloadLen));
+        out += kLengthPrefixSize;
+
+        *out++ = static_cast<uint8_t>((response.success ? kResponseSuccess : 0)
+                                    | (response.push ? kResponsePush : 0)
+                                    | (response.more ? kResponseMore : 0)
+                                    | (response.hasRequestId ? kResponseRequestId : 0)
+                                    | ((response.codec << kResponseCodecShift) & kResponseCodecMask));
+        if (response.hasRequestId)
+        {
+            writeBE64(out, response.requestId);
+            out += kRequestIdSize;
+        }
+        writeBE32(out, static_cast<uint32_t>(response.message.size()));
+        out += 4;
+
+        if (!response.message.empty())
+            std::memcpy(out, response.message.data(), response.message.size());
+        out += response.message.size();
+
+        if (!response.data.empty())
+            std::memcpy(out, response.data.data(), response.data.size());
+
+        return frame;
+    }
+
+    /**
+     * @brief Decode a response payload (without the length prefix).
+     * @param payload Raw bytes read from the wire.
+     * @param out     Receives the decoded response on success.
+     * @return false if the payload is truncated or inconsistent.
+     */
+    inline bool decodeResponse(const RawBuffer& payload, Response& out)
+    {
+        if (payload.size() < kResponseHeaderSize)
+            return false;
+
+        const uint8_t     status = payload[0];
+        const std::size_t header = kResponseHeaderSize + ((status & kResponseRequestId) ? kRequestIdSize : 0);
+        if (payload.size() < header)
+            return false;
+
+        const uint32_t msgLen = decodeBE32(payload.data() + header - 4);
+        if (payload.size() - header < msgLen)
+            return false;
+
+        const auto* msg = reinterpret_cast<const char*>(payload.data() + header);
+        out.success      = (status & kResponseSuccess) != 0;
+        out.push         = (status & kResponsePush) != 0;
+        out.more         = (status & kResponseMore) != 0;
+        out.hasRequestId = (status & kResponseRequestId) != 0;
+        out.requestId    = out.hasRequestId ? decodeBE64(payload.data() + 1) : 0;
+        out.codec        = static_cast<uint8_t>((status & kResponseCodecMask) >> kResponseCodecShift);
+        out.message.assign(msg, msgLen);
+        out.data = payload.slice(header + msgLen, payload.size() - header - msgLen);
+        return true;
+    }
+
+    /**
+     * @brief Prepend the length prefix to an already-encoded payload.
+     * @param payload The payload to frame.
+     * @return [length][payload] in a single contiguous buffer.
+     */
+    inline RawBuffer makeFrame(const RawBuffer& payload)
+    {
+        RawBuffer frame = RawBuffer::uninitialized(kLengthPrefixSize + payload.size());
+        writeBE32(frame.data(), static_cast<uint32_t>(payload.size()));
+        if (!payload.empty())
+            std::memcpy(frame.data() + kLengthPrefixSize, payload.data(), payload.size());
+        return frame;
+    }
+} // namespace framing
+
+#endif // FRAMECODEC_HPP
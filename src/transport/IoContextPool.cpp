@@ -0,0 +1,106 @@
+/**
+ * @file IoContextPool.cpp
+ * @brief Implementation of the io_context-per-thread pool.
+ */
+
+#include "IoContextPool.hpp"
+
+#include "concurrency/CpuAffinity.hpp"
+#include "logging/Log.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+IoContextPool::IoContextPool(std::size_t poolSize, bool pinCpus, bool busyPoll)
+    : m_pinCpus(pinCpus)
+    , m_busyPoll(busyPoll)
+{
+    if (poolSize == 0)
+        throw std::invalid_argument("[IoContextPool] pool size must be at least 1");
+
+    m_contexts.reserve(poolSize);
+    m_workGuards.reserve(poolSize);
+    for (std::size_t i = 0; i < poolSize; ++i)
+    {
+        // Each context is only ever run by one thread.
+        m_contexts.push_back(std::make_unique<boost::asio::io_context>(1));
+        m_workGuards.push_back(boost::asio::make_work_guard(*m_contexts.back()));
+    }
+}
+
+IoContextPool::~IoContextPool()
+{
+    stop();
+}
+
+void IoContextPool::start()
+{
+    if (!m_threads.empty())
+        return; // already started
+
+    const std::size_t cpuCount =
+        std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    m_threads.reserve(m_contexts.size());
+    for (std::size_t i = 0; i < m_contexts.size(); ++i)
+    {
+        m_threads.emplace_back([this, i, cpuCount]() {
+            if (m_pinCpus)
+                pinCurrentThread(i % cpuCount);
+
+            try
+            {
+                boost::asio::io_context& context = *m_contexts[i];
+                if (!m_busyPoll)
+                    context.run();
+                else
+                    while (!context.stopped()) // the work guard keeps poll() from stopping it
+                        context.poll();
+            }
+            catch (const std::exception& ex)
+            {
+                HFT_LOG_ERROR("[transport] io_context {} error: {}", i, ex.what());
+            }
+        });
+    }
+}
+
+void IoContextPool::stop()
+{
+    m_workGuards.clear();
+
+    // Post the stop behind any work already queued (e.g. session closes)
+    // so that it runs before the loop exits.
+    for (auto& context : m_contexts)
+    {
+        auto* ctx = context.get();
+        boost::asio::post(*ctx, [ctx]() { ctx->stop(); });
+    }
+
+    for (auto& thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    m_threads.clear();
+}
+
+boost::asio::io_context& IoContextPool::getIoContext()
+{
+    const std::size_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+    return *m_contexts[index % m_contexts.size()];
+}
+
+void IoContextPool::pinCurrentThread(std::size_t cpu)
+{
+#ifdef __linux__
+    const int rc = pinCurrentThreadToCpu(cpu);
+    if (rc != 0)
+        HFT_LOG_WARN("[transport] failed to pin io thread to CPU {} (error {})", cpu, rc);
+    else
+        HFT_LOG_DEBUG("[transport] io thread pinned to CPU {}", cpu);
+#else
+    (void)cpu;
+    HFT_LOG_WARN("[transport] CPU pinning is not supported on this platform");
+#endif
+}
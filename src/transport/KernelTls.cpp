@@ -0,0 +1,218 @@
+/**
+ * @file KernelTls.cpp
+ * @brief Implementation of the kTLS transmit offload.
+ */
+
+#include "KernelTls.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#define HFT_KTLS_SUPPORTED 1
+#include <cerrno>
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace
+{
+    constexpr std::size_t kMaxSecret = EVP_MAX_MD_SIZE;
+
+    /// What the callbacks learn about one connection; attached as ex_data.
+    struct ConnectionKeys
+    {
+        uint8_t     serverSecret[kMaxSecret]{};
+        std::size_t serverSecretSize{0};
+        uint64_t    recordsSent{0}; ///< Records sent under the application key.
+        bool        keyUpdated{false};
+    };
+
+    void freeKeys(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*)
+    {
+        if (auto* keys = static_cast<ConnectionKeys*>(ptr))
+        {
+            OPENSSL_cleanse(keys, sizeof(*keys));
+            delete keys;
+        }
+    }
+
+    int keysIndex()
+    {
+        static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, freeKeys);
+        return index;
+    }
+
+    ConnectionKeys* keysOf(const SSL* ssl, bool create)
+    {
+        auto* keys = static_cast<ConnectionKeys*>(SSL_get_ex_data(ssl, keysIndex()));
+        if (!keys && create)
+        {
+            keys = new ConnectionKeys();
+            SSL_set_ex_data(const_cast<SSL*>(ssl), keysIndex(), keys);
+        }
+        return keys;
+    }
+
+    int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    /// Keep the server's first application traffic secret of TLS 1.3.
+    void onKeylog(const SSL* ssl, const char* line)
+    {
+        static constexpr char kLabel[] = "SERVER_TRAFFIC_SECRET_0 ";
+        if (std::strncmp(line, kLabel, sizeof(kLabel) - 1) != 0)
+            return;
+
+        // "<label> <client random hex> <secret hex>"
+        const char* hex = std::strchr(line + sizeof(kLabel) - 1, ' ');
+        if (!hex)
+            return;
+        ++hex;
+
+        ConnectionKeys* keys = keysOf(ssl, true);
+        std::size_t     size = 0;
+        for (; hex[0] && hex[1] && size < kMaxSecret; hex += 2)
+        {
+            const int high = hexValue(hex[0]);
+            const int low  = hexValue(hex[1]);
+            if (high < 0 || low < 0)
+                break;
+            keys->serverSecret[size++] = static_cast<uint8_t>(high << 4 | low);
+        }
+        keys->serverSecretSize = size;
+    }
+
+    /// Count the NewSessionTickets sent after a TLS 1.3 handshake; note client KeyUpdates.
+    void onMessage(int writeP, int version, int contentType, const void* buf, size_t len, SSL* ssl, void*)
+    {
+        if (version != TLS1_3_VERSION || contentType != SSL3_RT_HANDSHAKE || len == 0)
+            return;
+        const uint8_t type = static_cast<const uint8_t*>(buf)[0];
+        if (writeP && type == SSL3_MT_NEWSESSION_TICKET)
+            ++keysOf(ssl, true)->recordsSent;
+        else if (!writeP && type == SSL3_MT_KEY_UPDATE)
+            keysOf(ssl, true)->keyUpdated = true;
+    }
+
+#ifdef HFT_KTLS_SUPPORTED
+    /// HKDF-Expand-Label(secret, label, "", size) of RFC 8446 section 7.1.
+    bool expandLabel(const EVP_MD* md, const uint8_t* secret, std::size_t secretSize, const char* label,
+                     uint8_t* out, std::size_t size)
+    {
+        uint8_t           info[2 + 1 + 255 + 1];
+        const std::size_t labelSize = 6 + std::strlen(label);
+        info[0] = static_cast<uint8_t>(size >> 8);
+        info[1] = static_cast<uint8_t>(size);
+        info[2] = static_cast<uint8_t>(labelSize);
+        std::memcpy(info + 3, "tls13 ", 6);
+        std::memcpy(info + 9, label, labelSize - 6);
+        info[3 + labelSize] = 0; // empty context
+        const std::size_t infoSize = 4 + labelSize;
+
+        std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr),
+                                                                        EVP_PKEY_CTX_free);
+        std::size_t outSize = size;
+        return ctx && EVP_PKEY_derive_init(ctx.get()) == 1
+               && EVP_PKEY_CTX_hkdf_mode(ctx.get(), EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) == 1
+               && EVP_PKEY_CTX_set_hkdf_md(ctx.get(), md) == 1
+               && EVP_PKEY_CTX_set1_hkdf_key(ctx.get(), secret, static_cast<int>(secretSize)) == 1
+               && EVP_PKEY_CTX_add1_hkdf_info(ctx.get(), info, static_cast<int>(infoSize)) == 1
+               && EVP_PKEY_derive(ctx.get(), out, &outSize) == 1 && outSize == size;
+    }
+
+    /// Fill a kernel crypto_info with the key, IV and sequence number, then install it.
+    template <typename CryptoInfo>
+    std::string install(int fd, uint16_t cipherType, const EVP_MD* md, const ConnectionKeys& keys)
+    {
+        CryptoInfo    info{};
+        uint8_t       iv[sizeof(info.salt) + sizeof(info.iv)];
+        const uint8_t* secret = keys.serverSecret;
+        if (!expandLabel(md, secret, keys.serverSecretSize, "key", info.key, sizeof(info.key))
+            || !expandLabel(md, secret, keys.serverSecretSize, "iv", iv, sizeof(iv)))
+            return "key derivation failed";
+
+        info.info.version     = TLS_1_3_VERSION;
+        info.info.cipher_type = cipherType;
+        std::memcpy(info.salt, iv, sizeof(info.salt));
+        std::memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+        for (std::size_t i = 0; i < sizeof(info.rec_seq); ++i)
+            info.rec_seq[i] = static_cast<uint8_t>(keys.recordsSent >> (8 * (sizeof(info.rec_seq) - 1 - i)));
+
+        std::string error;
+        if (::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0)
+            error = std::string("tls ULP unavailable: ") + std::strerror(errno);
+        else if (::setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) != 0)
+            error = std::string("TLS_TX rejected: ") + std::strerror(errno);
+
+        OPENSSL_cleanse(&info, sizeof(info));
+        OPENSSL_cleanse(iv, sizeof(iv));
+        return error;
+    }
+#endif
+} // namespace
+
+namespace ktls
+{
+    bool available()
+    {
+#ifdef HFT_KTLS_SUPPORTED
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void prepareContext(SSL_CTX* ctx)
+    {
+        keysIndex();
+        SSL_CTX_set_keylog_callback(ctx, onKeylog);
+        SSL_CTX_set_msg_callback(ctx, onMessage);
+    }
+
+    std::string enableTransmit(SSL* ssl, int fd)
+    {
+#ifdef HFT_KTLS_SUPPORTED
+        if (SSL_version(ssl) != TLS1_3_VERSION)
+            return "not a TLS 1.3 connection";
+
+        const ConnectionKeys* keys = keysOf(ssl, false);
+        if (!keys || keys->serverSecretSize == 0)
+            return "traffic secret not captured";
+
+        switch (SSL_CIPHER_get_id(SSL_get_current_cipher(ssl)))
+        {
+        case TLS1_3_CK_AES_128_GCM_SHA256:
+            return install<tls12_crypto_info_aes_gcm_128>(fd, TLS_CIPHER_AES_GCM_128, EVP_sha256(), *keys);
+        case TLS1_3_CK_AES_256_GCM_SHA384:
+            return install<tls12_crypto_info_aes_gcm_256>(fd, TLS_CIPHER_AES_GCM_256, EVP_sha384(), *keys);
+        default:
+            return std::string("cipher ") + SSL_CIPHER_get_name(SSL_get_current_cipher(ssl)) + " not offloaded";
+        }
+#else
+        (void)ssl;
+        (void)fd;
+        return "not supported by this build";
+#endif
+    }
+
+    bool keyUpdateReceived(const SSL* ssl)
+    {
+        const ConnectionKeys* keys = keysOf(ssl, false);
+        return keys && keys->keyUpdated;
+    }
+} // namespace ktls
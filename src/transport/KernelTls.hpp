@@ -0,0 +1,64 @@
+/**
+ * @file KernelTls.hpp
+ * @brief Optional kernel TLS (kTLS) offload of outbound record encryption.
+ *
+ * @details Boost.Asio drives OpenSSL through memory BIOs, so OpenSSL's own
+ * kTLS support, which needs a socket BIO, never engages. This module
+ * offloads transmission itself once the handshake is done. It derives the
+ * server's TLS 1.3 write key and IV from the application traffic secret,
+ * then installs them on the socket with setsockopt(SOL_TLS, TLS_TX) at the
+ * sequence number OpenSSL has reached. The secret is captured with the
+ * keylog callback. The sequence number is the count of NewSessionTicket
+ * records sent since the handshake.
+ *
+ * From then on the session writes plaintext frames straight to the TCP
+ * socket and the kernel frames and encrypts the records. A report stream
+ * or a broadcast batch is copied once into the kernel instead of being
+ * encrypted into a user-space buffer first. The same plaintext buffer is
+ * shared by every subscribed session. Reads still go through OpenSSL.
+ *
+ * Only TLS 1.3 with AES-GCM is offloaded. TLS 1.2 connections, kernels
+ * without the `tls` module and non-Linux builds keep encrypting in user
+ * space; enableTransmit() reports why. A client that requests a TLS 1.3
+ * key update is disconnected, because OpenSSL would answer with the
+ * replaced key.
+ */
+
+#ifndef KERNELTLS_HPP
+#define KERNELTLS_HPP
+
+#include <string>
+
+#include <openssl/ssl.h>
+
+namespace ktls
+{
+    /// @brief False if this build has no kTLS support (not Linux, or no <linux/tls.h>).
+    bool available();
+
+    /**
+     * @brief Install the callbacks enableTransmit() depends on.
+     * @details Call once, before any connection is accepted. Replaces the
+     *          context's keylog and message callbacks.
+     */
+    void prepareContext(SSL_CTX* ctx);
+
+    /**
+     * @brief Move record encryption of data sent on @p fd to the kernel.
+     * @param ssl The connection, with its handshake complete and no
+     *            application data written yet.
+     * @param fd  Its TCP socket.
+     * @return Empty on success; otherwise why the connection stays in user
+     *         space. The connection is usable either way.
+     */
+    std::string enableTransmit(SSL* ssl, int fd);
+
+    /**
+     * @brief True once the client has sent a TLS 1.3 KeyUpdate.
+     * @details The kernel still holds the old write key, so a connection
+     *          offloaded with enableTransmit() must be closed.
+     */
+    bool keyUpdateReceived(const SSL* ssl);
+} // namespace ktls
+
+#endif // KERNELTLS_HPP
@@ -0,0 +1,247 @@
+/**
+ * @file PayloadCompression.cpp
+ * @brief Implementation of the optional payload codecs.
+ */
+
+#include "PayloadCompression.hpp"
+
+#include "FrameCodec.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+#ifdef HFT_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef HFT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HFT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace compression
+{
+    namespace
+    {
+#ifdef HFT_HAVE_ZSTD
+        /// Zstandard level: most of the ratio of higher levels at several hundred MB/s.
+        constexpr int kZstdLevel = 3;
+#endif
+#ifdef HFT_HAVE_ZLIB
+        /// zlib level: its fast end, since zstd covers the high-ratio case.
+        constexpr int kDeflateLevel = 3;
+#endif
+    } // namespace
+
+    // ==========================================================================
+    // Codec sets
+    // ==========================================================================
+
+    uint8_t availableCodecs()
+    {
+        uint8_t codecs = 0;
+#ifdef HFT_HAVE_LZ4
+        codecs |= codecBit(Codec::LZ4);
+#endif
+#ifdef HFT_HAVE_ZSTD
+        codecs |= codecBit(Codec::ZSTD);
+#endif
+#ifdef HFT_HAVE_ZLIB
+        codecs |= codecBit(Codec::DEFLATE);
+#endif
+        return codecs;
+    }
+
+    const char* codecName(Codec codec)
+    {
+        switch (codec)
+        {
+        case Codec::NONE:    return "none";
+        case Codec::LZ4:     return "lz4";
+        case Codec::ZSTD:    return "zstd";
+        case Codec::DEFLATE: return "deflate";
+        }
+        return "unknown";
+    }
+
+    uint8_t parseCodecs(const std::string& list)
+    {
+        uint8_t            codecs = 0;
+        std::stringstream  in(list);
+        std::string        name;
+        while (std::getline(in, name, ','))
+        {
+            if (name == "all")
+                codecs |= kAllCodecs;
+            else if (name == "lz4")
+                codecs |= codecBit(Codec::LZ4);
+            else if (name == "zstd")
+                codecs |= codecBit(Codec::ZSTD);
+            else if (name == "deflate")
+                codecs |= codecBit(Codec::DEFLATE);
+            else if (name != "none" && !name.empty())
+                throw std::invalid_argument("[compression] unknown codec '" + name + "'");
+        }
+        return codecs;
+    }
+
+    Codec chooseCodec(uint8_t offered, bool preferRatio)
+    {
+        static constexpr Codec kByRatio[] = {Codec::ZSTD, Codec::DEFLATE, Codec::LZ4};
+        static constexpr Codec kBySpeed[] = {Codec::LZ4, Codec::ZSTD, Codec::DEFLATE};
+        for (Codec codec : preferRatio ? kByRatio : kBySpeed)
+            if (offered & codecBit(codec))
+                return codec;
+        return Codec::NONE;
+    }
+
+    // ==========================================================================
+    // PayloadCompressor — contexts created on first use and kept
+    // ==========================================================================
+
+    struct PayloadCompressor::Contexts
+    {
+#ifdef HFT_HAVE_LZ4
+        std::unique_ptr<char[]> lz4State;
+#endif
+#ifdef HFT_HAVE_ZSTD
+        ZSTD_CCtx* zstd{nullptr};
+#endif
+#ifdef HFT_HAVE_ZLIB
+        z_stream deflate{};
+        bool     deflateReady{false};
+#endif
+
+        ~Contexts()
+        {
+#ifdef HFT_HAVE_ZSTD
+            ZSTD_freeCCtx(zstd);
+#endif
+#ifdef HFT_HAVE_ZLIB
+            if (deflateReady)
+                deflateEnd(&deflate);
+#endif
+        }
+    };
+
+    PayloadCompressor::PayloadCompressor()
+        : m_contexts(std::make_unique<Contexts>())
+    {
+    }
+
+    PayloadCompressor::~PayloadCompressor() = default;
+
+    bool PayloadCompressor::compress(Codec codec, const uint8_t* data, std::size_t size, PooledBuffer& out)
+    {
+        // Anything that does not fit in one byte less than the input is not worth sending.
+        if (size <= kRawSizePrefix + 1 || size > framing::kMaxFrameSize)
+            return false;
+        const std::size_t capacity = size - kRawSizePrefix - 1;
+
+        out = PooledBuffer::uninitialized(kRawSizePrefix + capacity);
+        uint8_t*    dst    = out.data() + kRawSizePrefix;
+        std::size_t packed = 0;
+
+        switch (codec)
+        {
+#ifdef HFT_HAVE_LZ4
+        case Codec::LZ4:
+        {
+            if (!m_contexts->lz4State)
+                m_contexts->lz4State = std::make_unique<char[]>(static_cast<std::size_t>(LZ4_sizeofState()));
+            const int n = LZ4_compress_fast_extState(m_contexts->lz4State.get(), reinterpret_cast<const char*>(data),
+                                                     reinterpret_cast<char*>(dst), static_cast<int>(size),
+                                                     static_cast<int>(capacity), 1);
+            if (n <= 0)
+                return false;
+            packed = static_cast<std::size_t>(n);
+            break;
+        }
+#endif
+#ifdef HFT_HAVE_ZSTD
+        case Codec::ZSTD:
+        {
+            if (!m_contexts->zstd && !(m_contexts->zstd = ZSTD_createCCtx()))
+                return false;
+            const std::size_t n = ZSTD_compressCCtx(m_contexts->zstd, dst, capacity, data, size, kZstdLevel);
+            if (ZSTD_isError(n))
+                return false;
+            packed = n;
+            break;
+        }
+#endif
+#ifdef HFT_HAVE_ZLIB
+        case Codec::DEFLATE:
+        {
+            z_stream& stream = m_contexts->deflate;
+            if (!m_contexts->deflateReady)
+            {
+                if (deflateInit(&stream, kDeflateLevel) != Z_OK)
+                    return false;
+                m_contexts->deflateReady = true;
+            }
+            else if (deflateReset(&stream) != Z_OK)
+                return false;
+
+            stream.next_in   = const_cast<Bytef*>(data);
+            stream.avail_in  = static_cast<uInt>(size);
+            stream.next_out  = dst;
+            stream.avail_out = static_cast<uInt>(capacity);
+            if (::deflate(&stream, Z_FINISH) != Z_STREAM_END)
+                return false; // did not fit: not smaller than the input
+            packed = capacity - stream.avail_out;
+            break;
+        }
+#endif
+        default:
+            return false;
+        }
+
+        framing::writeBE32(out.data(), static_cast<uint32_t>(size));
+        out.resize(kRawSizePrefix + packed);
+        return true;
+    }
+
+    // ==========================================================================
+    // decompress()
+    // ==========================================================================
+
+    bool decompress(Codec codec, const uint8_t* data, std::size_t size, PooledBuffer& out, std::size_t maxSize)
+    {
+        if (size < kRawSizePrefix)
+            return false;
+        const std::size_t raw = framing::decodeBE32(data);
+        if (raw == 0 || raw > maxSize)
+            return false;
+
+        const uint8_t*    src     = data + kRawSizePrefix;
+        const std::size_t srcSize = size - kRawSizePrefix;
+        out                       = PooledBuffer::uninitialized(raw);
+
+        switch (codec)
+        {
+#ifdef HFT_HAVE_LZ4
+        case Codec::LZ4:
+            return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()),
+                                       static_cast<int>(srcSize), static_cast<int>(raw))
+                   == static_cast<int>(raw);
+#endif
+#ifdef HFT_HAVE_ZSTD
+        case Codec::ZSTD:
+            return ZSTD_decompress(out.data(), raw, src, srcSize) == raw;
+#endif
+#ifdef HFT_HAVE_ZLIB
+        case Codec::DEFLATE:
+        {
+            uLongf written = static_cast<uLongf>(raw);
+            return uncompress(out.data(), &written, src, static_cast<uLong>(srcSize)) == Z_OK && written == raw;
+        }
+#endif
+        default:
+            (void)src;
+            (void)srcSize;
+            return false;
+        }
+    }
+} // namespace compression
@@ -0,0 +1,114 @@
+/**
+ * @file PayloadCompression.hpp
+ * @brief Optional compression of large Response::data payloads.
+ *
+ * @details A client lists the codecs it can decode in the request flags
+ * (see FrameCodec.hpp). A reply at least TransportConfig::compressMinBytes
+ * long is then compressed with one of them, and the codec is named in the
+ * reply's status byte. Report downloads prefer the best ratio
+ * (zstd, then deflate, then LZ4); everything else prefers speed (LZ4, then
+ * zstd, then deflate). A compressed payload is laid out as
+ *
+ *   [ 4 bytes big-endian uncompressed size ][ codec stream ]
+ *
+ * and is only sent if it is smaller than the original data.
+ *
+ * Each codec is compiled in only if its library was found at configure
+ * time (HFT_HAVE_LZ4, HFT_HAVE_ZSTD, HFT_HAVE_ZLIB); availableCodecs()
+ * reports which. A PayloadCompressor keeps its compression contexts
+ * between calls, so a session allocates them once.
+ */
+
+#ifndef PAYLOADCOMPRESSION_HPP
+#define PAYLOADCOMPRESSION_HPP
+
+#include "memory/PooledBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace compression
+{
+    /// @brief Payload codec, as carried in bits 4-5 of the response status byte.
+    enum class Codec : uint8_t
+    {
+        NONE    = 0,
+        LZ4     = 1, ///< LZ4 block format: fastest, lowest ratio.
+        ZSTD    = 2, ///< Zstandard frame: best ratio at a moderate cost.
+        DEFLATE = 3, ///< zlib stream: for builds without zstd.
+    };
+
+    /// @brief Bit of @p codec in a codec set such as Request::acceptCodecs.
+    constexpr uint8_t codecBit(Codec codec)
+    {
+        return codec == Codec::NONE ? 0 : static_cast<uint8_t>(1u << (static_cast<unsigned>(codec) - 1));
+    }
+
+    /// @brief Set of every codec the wire format defines.
+    constexpr uint8_t kAllCodecs = codecBit(Codec::LZ4) | codecBit(Codec::ZSTD) | codecBit(Codec::DEFLATE);
+
+    /// @brief Size of the uncompressed-size prefix of a compressed payload.
+    constexpr std::size_t kRawSizePrefix = 4;
+
+    /// @brief Codecs compiled into this build.
+    uint8_t availableCodecs();
+
+    /// @brief Lower-case name of @p codec ("lz4", "zstd", "deflate", "none").
+    const char* codecName(Codec codec);
+
+    /**
+     * @brief Parse a comma-separated list of codec names.
+     * @param list "lz4,zstd,deflate", "all" or "none".
+     * @return The codec set; "all" is every codec the wire format defines.
+     * @throws std::invalid_argument on an unknown name.
+     */
+    uint8_t parseCodecs(const std::string& list);
+
+    /**
+     * @brief The preferred codec of @p offered.
+     * @param offered     Codecs both sides support.
+     * @param preferRatio Rank by compression ratio (reports) instead of speed.
+     * @return Codec::NONE if @p offered is empty.
+     */
+    Codec chooseCodec(uint8_t offered, bool preferRatio);
+
+    /**
+     * @class PayloadCompressor
+     * @brief Compresses payloads, reusing its codec contexts between calls.
+     *
+     * Not thread-safe: one compressor serves one thread at a time.
+     */
+    class PayloadCompressor
+    {
+    public:
+        PayloadCompressor();
+        ~PayloadCompressor();
+
+        PayloadCompressor(const PayloadCompressor&)            = delete;
+        PayloadCompressor& operator=(const PayloadCompressor&) = delete;
+
+        /**
+         * @brief Compress @p size bytes at @p data with @p codec.
+         * @param out Receives [BE32 size][stream] on success.
+         * @return false if @p codec is not compiled in, fails, or does not
+         *         make the payload smaller; @p out is then unspecified.
+         */
+        bool compress(Codec codec, const uint8_t* data, std::size_t size, PooledBuffer& out);
+
+    private:
+        struct Contexts;
+        std::unique_ptr<Contexts> m_contexts;
+    };
+
+    /**
+     * @brief Decompress a payload produced by PayloadCompressor::compress().
+     * @param maxSize Largest uncompressed size accepted.
+     * @return false if @p codec is not compiled in, the stream is corrupt,
+     *         or its declared size is above @p maxSize or does not match.
+     */
+    bool decompress(Codec codec, const uint8_t* data, std::size_t size, PooledBuffer& out, std::size_t maxSize);
+} // namespace compression
+
+#endif // PAYLOADCOMPRESSION_HPP
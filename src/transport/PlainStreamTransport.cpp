@@ -0,0 +1,176 @@
+/**
+ * @file PlainStreamTransport.cpp
+ * @brief Implementation of the plain TCP and Unix domain socket transports.
+ *
+ * @details The accept loop is the TLS transport's without the handshake:
+ * each accepted socket is created on the next io_context in round-robin
+ * order and handed straight to a StreamSession there. What differs between
+ * TCP and Unix sockets (binding, socket options, naming) is overloaded on
+ * the endpoint and socket types below.
+ */
+
+#include "PlainStreamTransport.hpp"
+
+#include "logging/Log.hpp"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+    using Tcp  = boost::asio::ip::tcp;
+    using Unix = boost::asio::local::stream_protocol;
+
+    /// "tcp://address:port" or "unix:path", for logs.
+    std::string describe(const Tcp::endpoint& endpoint)
+    {
+        return "tcp://" + endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+    }
+
+    std::string describe(const Unix::endpoint& endpoint)
+    {
+        return "unix:" + endpoint.path();
+    }
+
+    /// Options set between open() and bind().
+    void prepareBind(Tcp::acceptor& acceptor, const Tcp::endpoint&)
+    {
+        acceptor.set_option(Tcp::acceptor::reuse_address(true));
+    }
+
+    void prepareBind(Unix::acceptor&, const Unix::endpoint& endpoint)
+    {
+        // A previous run that did not stop cleanly leaves its socket file,
+        // which would fail the bind with "address in use".
+        SessionTransport::removeSocketFile(endpoint.path());
+    }
+
+    /// Undo what binding left in the filesystem.
+    void releaseEndpoint(const Tcp::endpoint&) {}
+
+    void releaseEndpoint(const Unix::endpoint& endpoint)
+    {
+        SessionTransport::removeSocketFile(endpoint.path());
+    }
+} // namespace
+
+// ==========================================================================
+// Constructor / destructor
+// ==========================================================================
+
+template <typename Protocol>
+PlainStreamTransport<Protocol>::PlainStreamTransport(Endpoint                       endpoint,
+                                                     std::shared_ptr<IServerFacade> facade,
+                                                     TransportConfig                config)
+    : SessionTransport(std::move(facade), config)
+    , m_endpoint(std::move(endpoint))
+    , m_acceptor(m_ioPool.ioContextAt(0))
+{
+}
+
+template <typename Protocol>
+PlainStreamTransport<Protocol>::~PlainStreamTransport()
+{
+    stop();
+}
+
+// ==========================================================================
+// start() — bind, listen, launch io_context threads, begin accept loop
+// ==========================================================================
+
+template <typename Protocol>
+void PlainStreamTransport<Protocol>::start()
+{
+    if (m_running.exchange(true))
+        return; // already started
+
+    try
+    {
+        m_acceptor.open(m_endpoint.protocol());
+        prepareBind(m_acceptor, m_endpoint);
+        m_acceptor.bind(m_endpoint);
+        m_acceptor.listen(boost::asio::socket_base::max_listen_connections);
+    }
+    catch (...)
+    {
+        boost::system::error_code ignored;
+        m_acceptor.close(ignored);
+        m_running = false;
+        throw;
+    }
+    m_endpoint = m_acceptor.local_endpoint(); // the port chosen for port 0
+
+    HFT_LOG_INFO("[transport] Listening on {} without TLS ({} io thread(s){}{})", describe(m_endpoint),
+                 m_ioPool.size(), m_config.pinCpus ? ", pinned" : "", m_config.busyPoll ? ", busy-polling" : "");
+
+    acceptNextConnection();
+    m_ioPool.start();
+}
+
+// ==========================================================================
+// stop() — graceful shutdown
+// ==========================================================================
+
+template <typename Protocol>
+void PlainStreamTransport<Protocol>::stop()
+{
+    if (!m_running.exchange(false))
+        return; // already stopped
+
+    boost::system::error_code ec;
+    m_acceptor.close(ec);
+    releaseEndpoint(m_endpoint);
+
+    // Posted ahead of the pool's stop request, so the closes run first.
+    closeSessions();
+    m_ioPool.stop();
+
+    HFT_LOG_INFO("[transport] Stopped.");
+}
+
+// ==========================================================================
+// acceptNextConnection() — async accept → re-arm → start a session
+// ==========================================================================
+
+template <typename Protocol>
+void PlainStreamTransport<Protocol>::acceptNextConnection()
+{
+    // The connection is bound to the next io_context for its whole lifetime.
+    boost::asio::io_context& sessionContext = m_ioPool.getIoContext();
+    auto                     socket         = std::make_shared<Socket>(sessionContext);
+
+    m_acceptor.async_accept(
+        *socket,
+        [this, socket, &sessionContext](const boost::system::error_code& ec)
+        {
+            if (ec)
+            {
+                if (ec != boost::asio::error::operation_aborted)
+                    HFT_LOG_ERROR("[transport] accept error: {}", ec.message());
+                return; // acceptor was closed — do not re-arm
+            }
+
+            if (!m_running)
+                return;
+            acceptNextConnection();
+
+            if constexpr (std::is_same_v<Protocol, Tcp>)
+                tuneTcpSocket(*socket);
+
+            const uint64_t id = nextSessionId();
+            HFT_LOG_INFO("[transport] Accepted connection on {} — session {}", describe(m_endpoint), id);
+
+            auto session =
+                std::make_shared<Session>(id, socket, m_facade, closeHandler(), m_config, m_counters);
+            addSession(session);
+            boost::asio::post(sessionContext, [session]() { session->start(); });
+        });
+}
+
+// ==========================================================================
+// Instantiations
+// ==========================================================================
+
+template class PlainStreamTransport<boost::asio::ip::tcp>;
+template class PlainStreamTransport<boost::asio::local::stream_protocol>;
@@ -0,0 +1,90 @@
+/**
+ * @file PlainStreamTransport.hpp
+ * @brief Unencrypted ITransport over plain TCP or a Unix domain socket.
+ *
+ * @details For clients on the same host or inside a trusted rack, where TLS
+ * only adds record encryption to every frame and a handshake to every
+ * connect. The wire protocol, sessions, pipelining, compression and
+ * backpressure are exactly those of BoostAsioSslTransport: each accepted
+ * connection becomes a StreamSession over the raw socket, and the session
+ * table is SessionTransport's.
+ *
+ * - TcpTransport listens on host:port. Accepted sockets get
+ *   TransportConfig::tcpNoDelay and socketBusyPollMicros.
+ * - UnixSocketTransport listens on a filesystem path. A socket file left
+ *   behind by a previous run is removed before binding (any other kind of
+ *   file is not touched), and the file is removed again by stop().
+ *
+ * With TransportConfig::busyPoll the io threads spin instead of sleeping,
+ * which matters most here: on loopback and Unix sockets the wake-up of a
+ * sleeping io thread is a large part of the round trip.
+ *
+ * There is no authentication on either: bind TCP to a trusted interface,
+ * and rely on the permissions of the socket file's directory.
+ */
+
+#ifndef PLAINSTREAMTRANSPORT_HPP
+#define PLAINSTREAMTRANSPORT_HPP
+
+#include "server/IServerFacade.hpp"
+
+#include "SessionTransport.hpp"
+#include "StreamSession.hpp"
+#include "TransportConfig.hpp"
+
+#include <memory>
+
+#include <boost/asio.hpp>
+
+/**
+ * @class PlainStreamTransport
+ * @brief SessionTransport that accepts unencrypted stream connections.
+ *
+ * @tparam Protocol boost::asio::ip::tcp or boost::asio::local::stream_protocol;
+ *                  instantiated for both in PlainStreamTransport.cpp.
+ */
+template <typename Protocol>
+class PlainStreamTransport final : public SessionTransport
+{
+public:
+    using Endpoint = typename Protocol::endpoint;
+    using Socket   = typename Protocol::socket;
+    using Session  = StreamSession<Socket>;
+
+    /**
+     * @brief Construct the transport; nothing is bound until start().
+     * @param endpoint Address to listen on (host and port, or socket path).
+     * @param facade   Server entry point that executes client requests.
+     * @param config   Threading, socket, coalescing and outbound queue options.
+     */
+    PlainStreamTransport(Endpoint endpoint, std::shared_ptr<IServerFacade> facade, TransportConfig config = {});
+
+    ~PlainStreamTransport() override;
+
+    /// @copydoc ITransport::start
+    void start() override;
+
+    /// @copydoc ITransport::stop
+    void stop() override;
+
+    /// @brief Address listened on; after start(), with the port chosen for port 0.
+    const Endpoint& localEndpoint() const { return m_endpoint; }
+
+private:
+    /// Begin an async accept cycle; re-invoked after each connection.
+    void acceptNextConnection();
+
+    Endpoint                    m_endpoint;
+    typename Protocol::acceptor m_acceptor;
+};
+
+extern template class PlainStreamTransport<boost::asio::ip::tcp>;
+extern template class PlainStreamTransport<boost::asio::local::stream_protocol>;
+
+/// Plain TCP transport for trusted networks.
+using TcpTransport = PlainStreamTransport<boost::asio::ip::tcp>;
+
+/// Unix domain socket transport for clients on the same host.
+using UnixSocketTransport = PlainStreamTransport<boost::asio::local::stream_protocol>;
+
+#endif // PLAINSTREAMTRANSPORT_HPP
@@ -0,0 +1,210 @@
+/**
+ * @file SessionTransport.cpp
+ * @brief Implementation of the session table shared by the socket transports.
+ */
+
+#include "SessionTransport.hpp"
+
+#include "FrameCodec.hpp"
+#include "logging/Log.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ==========================================================================
+// Constructor
+// ==========================================================================
+
+SessionTransport::SessionTransport(std::shared_ptr<IServerFacade> facade, TransportConfig config)
+    : m_config(config)
+    , m_ioPool(config.ioThreads, config.pinCpus, config.busyPoll)
+    , m_facade(std::move(facade))
+    , m_counters(std::make_shared<TransportCounters>())
+{
+    if (!m_facade)
+        throw std::invalid_argument("[SessionTransport] facade must not be null");
+}
+
+// ==========================================================================
+// send() — frame once, then queue the frame on every live session
+// ==========================================================================
+
+void SessionTransport::send(const RawBuffer& buffer)
+{
+    const RawBuffer frame = framing::makeFrame(buffer);
+
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    for (auto& entry : m_sessions)
+        entry.second->deliver(frame);
+}
+
+// ==========================================================================
+// sendBatch() — frame each buffer once; one post per session for the batch
+// ==========================================================================
+
+void SessionTransport::sendBatch(const RawBuffer* buffers, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    std::vector<RawBuffer> frames;
+    frames.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        frames.push_back(framing::makeFrame(buffers[i]));
+
+    // Sessions receive reference-counted copies of the same frame buffers
+    // and merge them into as few writes as the coalescing limit allows.
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    for (auto& entry : m_sessions)
+        entry.second->deliverBatch(frames);
+}
+
+// ==========================================================================
+// receive() — not available; sessions dispatch inbound frames themselves
+// ==========================================================================
+
+RawBuffer SessionTransport::receive()
+{
+    throw std::logic_error(
+        "[SessionTransport] receive(): inbound frames are dispatched "
+        "to the facade by each session");
+}
+
+// ==========================================================================
+// publish() — targeted push to one session
+// ==========================================================================
+
+bool SessionTransport::publish(uint64_t              sessionId,
+                               std::vector<Response> messages,
+                               DrainedHandler        onDrained)
+{
+    std::shared_ptr<TransportSession> session;
+    {
+        std::lock_guard<std::mutex> lock(m_sessionsMutex);
+        const auto it = m_sessions.find(sessionId);
+        if (it == m_sessions.end())
+            return false;
+        session = it->second;
+    }
+
+    session->publish(std::move(messages), std::move(onDrained));
+    return true;
+}
+
+void SessionTransport::setSessionClosedHandler(SessionClosedHandler handler)
+{
+    m_sessionClosedHandler = std::move(handler);
+}
+
+// ==========================================================================
+// stats(), sessionStats() — live queue depths, shared counters, per-session throughput
+// ==========================================================================
+
+TransportStats SessionTransport::stats() const
+{
+    TransportStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_sessionsMutex);
+        stats.sessions = m_sessions.size();
+        for (const auto& entry : m_sessions)
+        {
+            const std::size_t bytes = entry.second->queuedBytes();
+            stats.queuedFrames += entry.second->queuedFrames();
+            stats.queuedBytes  += bytes;
+            if (bytes > stats.maxSessionQueuedBytes)
+                stats.maxSessionQueuedBytes = bytes;
+        }
+    }
+    stats.droppedFrames           = m_counters->droppedFrames.load(std::memory_order_relaxed);
+    stats.slowConsumerDisconnects = m_counters->slowConsumerDisconnects.load(std::memory_order_relaxed);
+    stats.handshakes              = m_counters->handshakes.load(std::memory_order_relaxed);
+    stats.resumedHandshakes       = m_counters->resumedHandshakes.load(std::memory_order_relaxed);
+    stats.failedHandshakes        = m_counters->failedHandshakes.load(std::memory_order_relaxed);
+    stats.kernelTlsSessions       = m_counters->kernelTlsSessions.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<SessionStats> SessionTransport::sessionStats() const
+{
+    std::vector<SessionStats> sessions;
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    sessions.reserve(m_sessions.size());
+    for (const auto& entry : m_sessions)
+        sessions.push_back(entry.second->stats());
+    return sessions;
+}
+
+// ==========================================================================
+// Session table — registration, teardown, close notifications
+// ==========================================================================
+
+std::function<void(uint64_t)> SessionTransport::closeHandler()
+{
+    return [this](uint64_t closedId) { onSessionClosed(closedId); };
+}
+
+void SessionTransport::addSession(std::shared_ptr<TransportSession> session)
+{
+    const uint64_t              id = session->id();
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    m_sessions.emplace(id, std::move(session));
+}
+
+void SessionTransport::closeSessions()
+{
+    std::vector<std::shared_ptr<TransportSession>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(m_sessionsMutex);
+        for (auto& entry : m_sessions)
+            sessions.push_back(entry.second);
+        m_sessions.clear();
+    }
+    for (auto& session : sessions)
+        session->close();
+}
+
+void SessionTransport::onSessionClosed(uint64_t sessionId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sessionsMutex);
+        m_sessions.erase(sessionId);
+    }
+
+    // Outside the lock: the handler may call back into publish().
+    if (m_sessionClosedHandler)
+        m_sessionClosedHandler(sessionId);
+}
+
+// ==========================================================================
+// tuneTcpSocket() — Nagle and busy polling of an accepted TCP connection
+// ==========================================================================
+
+void SessionTransport::tuneTcpSocket(boost::asio::ip::tcp::socket& socket) const
+{
+    boost::system::error_code ec;
+    socket.set_option(boost::asio::ip::tcp::no_delay(m_config.tcpNoDelay), ec);
+
+#ifdef SO_BUSY_POLL
+    if (m_config.socketBusyPollMicros > 0)
+    {
+        const int micros = static_cast<int>(m_config.socketBusyPollMicros);
+        if (::setsockopt(socket.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &micros, sizeof(micros)) != 0)
+            HFT_LOG_DEBUG("[transport] SO_BUSY_POLL of {} us refused (needs CAP_NET_ADMIN)", micros);
+    }
+#endif
+}
+
+// ==========================================================================
+// removeSocketFile() — stale Unix socket files
+// ==========================================================================
+
+void SessionTransport::removeSocketFile(const std::string& path)
+{
+    struct stat info{};
+    if (::lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        ::unlink(path.c_str());
+}
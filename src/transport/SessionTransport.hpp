@@ -0,0 +1,147 @@
+/**
+ * @file SessionTransport.hpp
+ * @brief Base of the socket transports: io threads, live sessions and fan-out.
+ *
+ * @details BoostAsioSslTransport (TLS), TcpTransport and UnixSocketTransport
+ * differ only in how a connection is accepted and set up. Everything after
+ * that is shared and lives here: the IoContextPool that runs the sessions,
+ * the table of live sessions, broadcast (send/sendBatch), targeted pushes
+ * (ISessionPublisher) and the statistics read by GET_STATS.
+ *
+ * A derived transport accepts a connection, wraps it in a StreamSession
+ * with closeHandler() as its close handler, registers it with
+ * addSession() and posts its start() to the session's io_context.
+ * stop() calls closeSessions() before stopping the pool. ShmTransport
+ * does the same with ShmSessions, whose io_context only hosts the socket
+ * each client attached over.
+ */
+
+#ifndef SESSIONTRANSPORT_HPP
+#define SESSIONTRANSPORT_HPP
+
+#include "server/IServerFacade.hpp"
+#include "transport/ISessionPublisher.hpp"
+#include "transport/ITransport.hpp"
+#include "transport/TransportStats.hpp"
+
+#include "IoContextPool.hpp"
+#include "TransportConfig.hpp"
+#include "TransportSession.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+/**
+ * @class SessionTransport
+ * @brief ITransport and ISessionPublisher over a table of live sessions.
+ *
+ * start() and stop() are left to the derived transport.
+ */
+class SessionTransport : public ITransport, public ISessionPublisher
+{
+public:
+    ~SessionTransport() override = default;
+
+    SessionTransport(const SessionTransport&)            = delete;
+    SessionTransport& operator=(const SessionTransport&) = delete;
+
+    /**
+     * @brief Frame @p buffer and queue it on every connected session.
+     * @param buffer The payload to push to all clients.
+     */
+    void send(const RawBuffer& buffer) override;
+
+    /**
+     * @brief Frame each buffer and queue the whole batch on every session.
+     * @param buffers Payloads to push to all clients, in order.
+     * @param count   Number of payloads.
+     */
+    void sendBatch(const RawBuffer* buffers, std::size_t count) override;
+
+    /**
+     * @brief Not supported: inbound frames are dispatched per session.
+     * @throws std::logic_error always.
+     */
+    RawBuffer receive() override;
+
+    /// @copydoc ISessionPublisher::publish
+    bool publish(uint64_t              sessionId,
+                 std::vector<Response> messages,
+                 DrainedHandler        onDrained) override;
+
+    /// @copydoc ISessionPublisher::setSessionClosedHandler
+    void setSessionClosedHandler(SessionClosedHandler handler) override;
+
+    /// @brief Outbound queue depths and backpressure counters; safe from any thread.
+    TransportStats stats() const;
+
+    /// @brief Throughput and queue depth of every live session; safe from any thread.
+    std::vector<SessionStats> sessionStats() const;
+
+    /// @brief Remove the Unix socket file at @p path; any other kind of file is left alone.
+    /// @details For listeners on a path, which a run that did not stop cleanly leaves behind.
+    static void removeSocketFile(const std::string& path);
+
+protected:
+    /**
+     * @brief Create the io_context pool; threads are launched by start().
+     * @param facade Server entry point that sessions dispatch to; must not be null.
+     * @param config Threading, socket and outbound queue options.
+     */
+    SessionTransport(std::shared_ptr<IServerFacade> facade, TransportConfig config);
+
+    /// @brief Id for the next session.
+    uint64_t nextSessionId() { return m_nextSessionId.fetch_add(1, std::memory_order_relaxed); }
+
+    /// @brief Close handler to construct sessions with; unregisters them.
+    std::function<void(uint64_t)> closeHandler();
+
+    /// @brief Register a session; it receives broadcasts from now on.
+    void addSession(std::shared_ptr<TransportSession> session);
+
+    /// @brief Close every live session and empty the table.
+    /// @details The closes are posted, so they run before a later pool stop.
+    void closeSessions();
+
+    /// @brief Apply the Nagle and SO_BUSY_POLL options of m_config to an accepted socket.
+    void tuneTcpSocket(boost::asio::ip::tcp::socket& socket) const;
+
+    TransportConfig m_config;
+
+    /// io_contexts and the threads that drive them; context 0 hosts the acceptor.
+    IoContextPool m_ioPool;
+
+    /// Entry point that every session dispatches decoded requests to.
+    std::shared_ptr<IServerFacade> m_facade;
+
+    /// Backpressure counters shared with every session.
+    std::shared_ptr<TransportCounters> m_counters;
+
+    std::atomic<bool> m_running{false};
+
+private:
+    /// Remove a closed session from the live-session table.
+    void onSessionClosed(uint64_t sessionId);
+
+    /// Live sessions keyed by session id.
+    std::unordered_map<uint64_t, std::shared_ptr<TransportSession>> m_sessions;
+
+    /// Protects m_sessions; never held across socket I/O.
+    mutable std::mutex m_sessionsMutex;
+
+    /// Notified after a session has been removed; set before start().
+    SessionClosedHandler m_sessionClosedHandler;
+
+    /// Source of transport-unique session ids.
+    std::atomic<uint64_t> m_nextSessionId{1};
+};
+
+#endif // SESSIONTRANSPORT_HPP
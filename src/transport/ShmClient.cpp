@@ -0,0 +1,122 @@
+/**
+ * @file ShmClient.cpp
+ * @brief Implementation of the shared-memory client: create, attach, stream.
+ */
+
+#include "ShmClient.hpp"
+
+#include "FrameCodec.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    /// "/hft-shm-<pid>-<n>": unique per process and per client within it.
+    std::string nextRegionName()
+    {
+        static std::atomic<uint64_t> counter{0};
+        return "/hft-shm-" + std::to_string(::getpid()) + "-" + std::to_string(counter.fetch_add(1) + 1);
+    }
+} // namespace
+
+// ==========================================================================
+// Constructor / destructor — create the region and attach it
+// ==========================================================================
+
+ShmClient::ShmClient(const std::string& controlPath, uint32_t ringBytes, shm::WakeMode mode)
+    : m_name(nextRegionName())
+    , m_control(m_io)
+    , m_mode(mode)
+{
+    m_region = shm::Region::create(m_name, ringBytes);
+    uint8_t status = shm::kAttachRefused;
+    try
+    {
+        m_control.connect(boost::asio::local::stream_protocol::endpoint(controlPath));
+        const std::array<uint8_t, 4> prefix = framing::encodeBE32(static_cast<uint32_t>(m_name.size()));
+        boost::asio::write(m_control, std::array<boost::asio::const_buffer, 2>{boost::asio::buffer(prefix),
+                                                                                 boost::asio::buffer(m_name)});
+        boost::asio::read(m_control, boost::asio::buffer(&status, 1));
+    }
+    catch (...)
+    {
+        shm::Region::unlink(m_name);
+        throw;
+    }
+
+    // Both sides have it mapped (or the server refused it): the name is no longer needed.
+    shm::Region::unlink(m_name);
+    if (status != shm::kAttachAccepted)
+        throw std::runtime_error("[ShmClient] server refused region " + m_name);
+
+    m_requests  = m_region.requests();
+    m_responses = m_region.responses();
+}
+
+ShmClient::~ShmClient()
+{
+    close();
+}
+
+void ShmClient::close()
+{
+    m_region.close();
+    boost::system::error_code ignored;
+    m_control.close(ignored);
+}
+
+// ==========================================================================
+// Stream operations
+// ==========================================================================
+
+std::size_t ShmClient::readSome(uint8_t* out, std::size_t size, boost::system::error_code& ec)
+{
+    ec = {};
+    if (m_responses.readable() == 0)
+        m_responses.waitReadable([this]() { return serverGone(); }, m_mode, true);
+
+    // Bytes written before the server left are still delivered.
+    const std::size_t n = m_responses.read(out, size, true);
+    if (n == 0)
+        ec = boost::asio::error::eof;
+    return n;
+}
+
+std::size_t ShmClient::writeSome(const uint8_t* data, std::size_t size, boost::system::error_code& ec)
+{
+    ec = {};
+    do
+    {
+        if (m_region.closed())
+            break;
+        const std::size_t n = m_requests.write(data, size, true);
+        if (n > 0)
+            return n;
+    } while (m_requests.waitWritable([this]() { return serverGone(); }, m_mode, true));
+
+    ec = boost::asio::error::broken_pipe;
+    return 0;
+}
+
+bool ShmClient::serverGone()
+{
+    if (m_serverGone || m_region.closed())
+        return true;
+
+    // A server that exits without closing the region still closes its socket.
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_nextSocketCheck)
+        return false;
+    m_nextSocketCheck = now + shm::kWaitSlice;
+
+    uint8_t       byte = 0;
+    const ssize_t n    = ::recv(m_control.native_handle(), &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    m_serverGone       = n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+    return m_serverGone;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file ShmClient.hpp
+ * @brief Client side of ShmTransport: a region, attached, used as a stream.
+ *
+ * @details The constructor creates a region of two rings, attaches it over
+ * the server's control socket (see ShmTransport.hpp) and removes its name
+ * again, so nothing is left in /dev/shm once both sides have unmapped it.
+ *
+ * ShmClient then reads responses and writes requests like a connected
+ * socket: read_some()/write_some() satisfy Boost.Asio's SyncReadStream and
+ * SyncWriteStream, so boost::asio::read and boost::asio::write frame
+ * requests and replies exactly as they do over TCP. Both block until the
+ * rings let them make progress, waiting in the client's own wake mode.
+ *
+ * Reads report boost::asio::error::eof once the server has closed the
+ * region (after the bytes it wrote before closing) or has exited; writes
+ * then report broken_pipe. Not thread-safe: use it from one thread at a
+ * time.
+ */
+
+#ifndef SHMCLIENT_HPP
+#define SHMCLIENT_HPP
+
+#include "ShmRing.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/asio.hpp>
+
+/**
+ * @class ShmClient
+ * @brief Attached shared-memory connection to an ShmTransport.
+ */
+class ShmClient
+{
+public:
+    /// @brief Ring size used when the caller does not choose one (1 MiB each way).
+    static constexpr uint32_t kDefaultRingBytes = 1u << 20;
+
+    /**
+     * @brief Create a region and attach it to the server listening on @p controlPath.
+     * @param ringBytes Size of each ring; a power of two, at least shm::kMinRingBytes.
+     * @param mode      How this client waits for its rings.
+     * @throws std::invalid_argument for a bad ring size; boost::system::system_error
+     *         if the control socket cannot be reached; std::runtime_error if the
+     *         region cannot be created or the server refuses it.
+     */
+    explicit ShmClient(const std::string& controlPath,
+                       uint32_t           ringBytes = kDefaultRingBytes,
+                       shm::WakeMode      mode      = shm::WakeMode::FUTEX);
+
+    ~ShmClient();
+
+    ShmClient(const ShmClient&)            = delete;
+    ShmClient& operator=(const ShmClient&) = delete;
+
+    /// @brief Read response bytes into the first non-empty buffer (SyncReadStream).
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers, boost::system::error_code& ec)
+    {
+        for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers);
+             ++it)
+        {
+            const boost::asio::mutable_buffer buffer(*it);
+            if (buffer.size() > 0)
+                return readSome(static_cast<uint8_t*>(buffer.data()), buffer.size(), ec);
+        }
+        ec = {};
+        return 0;
+    }
+
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers)
+    {
+        boost::system::error_code ec;
+        const std::size_t         n = read_some(buffers, ec);
+        if (ec)
+            throw boost::system::system_error(ec);
+        return n;
+    }
+
+    /// @brief Write request bytes from the first non-empty buffer (SyncWriteStream).
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers, boost::system::error_code& ec)
+    {
+        for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers);
+             ++it)
+        {
+            const boost::asio::const_buffer buffer(*it);
+            if (buffer.size() > 0)
+                return writeSome(static_cast<const uint8_t*>(buffer.data()), buffer.size(), ec);
+        }
+        ec = {};
+        return 0;
+    }
+
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers)
+    {
+        boost::system::error_code ec;
+        const std::size_t         n = write_some(buffers, ec);
+        if (ec)
+            throw boost::system::system_error(ec);
+        return n;
+    }
+
+    /// @brief Detach: mark the region closed and close the control socket.
+    void close();
+
+    /// @brief Name the region was created under (already unlinked).
+    const std::string& regionName() const { return m_name; }
+
+private:
+    std::size_t readSome(uint8_t* out, std::size_t size, boost::system::error_code& ec);
+    std::size_t writeSome(const uint8_t* data, std::size_t size, boost::system::error_code& ec);
+
+    /// True once the region is closed or the server's end of the socket is;
+    /// the socket is looked at no more than once per shm::kWaitSlice.
+    bool serverGone();
+
+    std::string                                  m_name;
+    boost::asio::io_context                      m_io;
+    boost::asio::local::stream_protocol::socket m_control;
+    shm::Region                                  m_region;
+    shm::Ring                                    m_requests;
+    shm::Ring                                    m_responses;
+    shm::WakeMode                                m_mode;
+
+    std::chrono::steady_clock::time_point m_nextSocketCheck{};
+    bool                                  m_serverGone{false};
+};
+
+#endif // SHMCLIENT_HPP
@@ -0,0 +1,195 @@
+/**
+ * @file ShmRing.cpp
+ * @brief Futex wake-ups and the mapping of shared-memory regions.
+ */
+
+#include "ShmRing.hpp"
+
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace shm
+{
+    namespace
+    {
+        std::string errnoText()
+        {
+            return std::strerror(errno);
+        }
+
+        RingControl* controlAt(void* base, std::size_t index)
+        {
+            return reinterpret_cast<RingControl*>(static_cast<uint8_t*>(base) + sizeof(RegionHeader)) + index;
+        }
+
+        uint8_t* ringBytesAt(void* base, uint32_t ringBytes, std::size_t index)
+        {
+            return static_cast<uint8_t*>(base) + sizeof(RegionHeader) + 2 * sizeof(RingControl)
+                   + index * static_cast<std::size_t>(ringBytes);
+        }
+    } // namespace
+
+    // ==========================================================================
+    // Spinning and futex
+    // ==========================================================================
+
+    unsigned spinIterations()
+    {
+        static const unsigned iterations = std::thread::hardware_concurrency() > 1 ? kSpinIterations : 0;
+        return iterations;
+    }
+
+    void futexWait(std::atomic<uint32_t>& word, uint32_t expected, bool shared)
+    {
+#ifdef __linux__
+        const auto      seconds = std::chrono::duration_cast<std::chrono::seconds>(kWaitSlice);
+        const timespec  timeout{static_cast<time_t>(seconds.count()),
+                               static_cast<long>(std::chrono::nanoseconds(kWaitSlice - seconds).count())};
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, expected,
+                  &timeout, nullptr, 0);
+#else
+        (void)shared;
+        if (word.load() == expected)
+            std::this_thread::yield();
+#endif
+    }
+
+    void futexWake(std::atomic<uint32_t>& word, bool shared)
+    {
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, INT32_MAX,
+                  nullptr, nullptr, 0);
+#else
+        (void)word;
+        (void)shared;
+#endif
+    }
+
+    // ==========================================================================
+    // Region — create (client), open (server), close, unmap
+    // ==========================================================================
+
+    Region::Region(void* base, std::size_t size)
+        : m_base(base)
+        , m_size(size)
+    {
+        const uint32_t ringBytes = header().ringBytes;
+        m_requests               = Ring(controlAt(base, 0), ringBytesAt(base, ringBytes, 0), ringBytes);
+        m_responses              = Ring(controlAt(base, 1), ringBytesAt(base, ringBytes, 1), ringBytes);
+    }
+
+    Region::~Region()
+    {
+        if (m_base)
+            ::munmap(m_base, m_size);
+    }
+
+    Region::Region(Region&& other) noexcept
+        : m_base(std::exchange(other.m_base, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_requests(other.m_requests)
+        , m_responses(other.m_responses)
+    {
+    }
+
+    Region& Region::operator=(Region&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_base)
+                ::munmap(m_base, m_size);
+            m_base      = std::exchange(other.m_base, nullptr);
+            m_size      = std::exchange(other.m_size, 0);
+            m_requests  = other.m_requests;
+            m_responses = other.m_responses;
+        }
+        return *this;
+    }
+
+    Region Region::create(const std::string& name, uint32_t ringBytes)
+    {
+        if (ringBytes < kMinRingBytes || (ringBytes & (ringBytes - 1)) != 0)
+            throw std::invalid_argument("[shm] ring size must be a power of two of at least 4096 bytes");
+
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("[shm] cannot create " + name + ": " + errnoText());
+
+        const std::size_t size = regionSize(ringBytes);
+        void*             base = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+            base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const std::string error = errnoText();
+        ::close(fd);
+        if (base == MAP_FAILED)
+        {
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error("[shm] cannot map " + name + ": " + error);
+        }
+
+        auto* header      = new (base) RegionHeader{};
+        header->ringBytes = ringBytes;
+        new (controlAt(base, 0)) RingControl{};
+        new (controlAt(base, 1)) RingControl{};
+        return Region(base, size);
+    }
+
+    Region Region::open(const std::string& name)
+    {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+            throw std::runtime_error("[shm] cannot open " + name + ": " + errnoText());
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(RegionHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("[shm] " + name + " is too small for a region header");
+        }
+
+        const auto size = static_cast<std::size_t>(info.st_size);
+        void*      base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const std::string error = errnoText();
+        ::close(fd);
+        if (base == MAP_FAILED)
+            throw std::runtime_error("[shm] cannot map " + name + ": " + error);
+
+        const auto* header    = static_cast<const RegionHeader*>(base);
+        const uint32_t ringBytes = header->ringBytes;
+        if (header->magic != kRegionMagic || header->version != kRegionVersion || ringBytes < kMinRingBytes
+            || (ringBytes & (ringBytes - 1)) != 0 || regionSize(ringBytes) != size)
+        {
+            ::munmap(base, size);
+            throw std::runtime_error("[shm] " + name + " is not a version " + std::to_string(kRegionVersion)
+                                     + " region");
+        }
+        return Region(base, size);
+    }
+
+    void Region::unlink(const std::string& name)
+    {
+        ::shm_unlink(name.c_str());
+    }
+
+    void Region::close()
+    {
+        if (!m_base)
+            return;
+        header().closed.store(1, std::memory_order_release);
+        m_requests.wakeAll(true);
+        m_responses.wakeAll(true);
+    }
+} // namespace shm
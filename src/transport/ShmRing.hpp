@@ -0,0 +1,427 @@
+/**
+ * @file ShmRing.hpp
+ * @brief Single-producer/single-consumer byte rings in a shared-memory region.
+ *
+ * @details A ShmTransport client and the server share one region per
+ * connection, laid out as
+ *
+ *   [ RegionHeader ][ request RingControl ][ response RingControl ]
+ *   [ request bytes (ringBytes) ][ response bytes (ringBytes) ]
+ *
+ * The client writes requests and reads responses; the server does the
+ * opposite. Each ring is a byte pipe carrying exactly what a socket would:
+ * length-prefixed frames (see FrameCodec.hpp), which may wrap around the
+ * end of the ring and may be written and read in parts. A frame larger
+ * than the ring simply passes through in several parts.
+ *
+ * Positions are free-running 64-bit byte counts: the producer owns head,
+ * the consumer owns tail, and head - tail bytes are readable. Writing or
+ * reading moves data with memcpy and publishes the new position with a
+ * release store; no syscall is involved.
+ *
+ * The other process can write any value to either position. A ring whose
+ * head - tail exceeds its capacity (a head run ahead, or a tail past the
+ * head) is corrupt(): it reads as empty and full, readAll() and writeAll()
+ * give up, and the server closes the session. No copy ever exceeds the
+ * ring, whatever the positions say.
+ *
+ * A side with nothing to do waits by spinning (WakeMode::SPIN) or, after a
+ * short spin, on a futex (WakeMode::FUTEX). On a single CPU it does not
+ * spin at all: the other side could not run meanwhile. The choice is each consumer's
+ * own: a producer only calls futex_wake when its consumer has announced
+ * that it is asleep, so a busy ring never leaves user space in either mode.
+ * Futex sleeps time out every kWaitSlice, so a waiter notices a closed
+ * region or a stop request even if no wake arrives.
+ */
+
+#ifndef SHMRING_HPP
+#define SHMRING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace shm
+{
+    /// @brief "HFTR": first word of every region.
+    constexpr uint32_t kRegionMagic = 0x48465452;
+
+    /// @brief Layout version; a region of another version is refused.
+    constexpr uint16_t kRegionVersion = 1;
+
+    /// @brief Smallest ring accepted (bytes, power of two).
+    constexpr uint32_t kMinRingBytes = 4096;
+
+    /// @brief Longest single futex sleep before the stop condition is checked again.
+    constexpr std::chrono::milliseconds kWaitSlice{50};
+
+    /// @brief Iterations a waiter spins before it sleeps (FUTEX) or checks for a stop (SPIN).
+    constexpr unsigned kSpinIterations = 2000;
+
+    /// @brief Longest region name accepted by the attach handshake (see ShmTransport.hpp).
+    constexpr uint32_t kMaxRegionName = 255;
+
+    /// @brief Attach handshake status bytes.
+    constexpr uint8_t kAttachAccepted = 0;
+    constexpr uint8_t kAttachRefused  = 1;
+
+    /// @brief How a consumer waits for its ring.
+    enum class WakeMode : uint8_t
+    {
+        SPIN,  ///< Never sleep: lowest latency, one busy core per waiter.
+        FUTEX, ///< Spin briefly, then sleep on a futex until woken.
+    };
+
+    /// @brief Lower-case name of @p mode ("spin", "futex").
+    inline const char* wakeModeName(WakeMode mode)
+    {
+        return mode == WakeMode::SPIN ? "spin" : "futex";
+    }
+
+    /// @brief Tell the core a spin-wait is in progress.
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    /**
+     * @brief kSpinIterations, or 0 on a single CPU.
+     * @details With one CPU the side being waited for cannot run while the
+     *          waiter spins, so spinning only delays it.
+     */
+    unsigned spinIterations();
+
+    /// @brief Sleep while @p word equals @p expected, for at most kWaitSlice.
+    /// @param shared The word lives in memory shared with another process.
+    void futexWait(std::atomic<uint32_t>& word, uint32_t expected, bool shared);
+
+    /// @brief Wake every thread sleeping on @p word.
+    void futexWake(std::atomic<uint32_t>& word, bool shared);
+
+    /**
+     * @struct Signal
+     * @brief Wake-up word of one waiter, notified by one or more producers.
+     *
+     * The waiter sets @c waiting before its last check and sleeps on
+     * @c sequence; notify() bumps @c sequence and only enters the kernel if
+     * @c waiting is set. Both use sequentially consistent operations, so a
+     * notification is never lost between the check and the sleep.
+     */
+    struct Signal
+    {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint32_t> waiting{0};
+
+        /// @brief Record progress and wake a sleeping waiter.
+        void notify(bool shared)
+        {
+            sequence.fetch_add(1);
+            if (waiting.load() != 0)
+                futexWake(sequence, shared);
+        }
+
+        /**
+         * @brief Wait until @p ready() or @p stopped() holds.
+         * @return ready() at the end of the wait.
+         */
+        template <typename Ready, typename Stopped>
+        bool wait(Ready ready, Stopped stopped, WakeMode mode, bool shared)
+        {
+            const unsigned spins = spinIterations();
+            for (unsigned i = 0; i < spins; ++i)
+            {
+                if (ready())
+                    return true;
+                cpuRelax();
+            }
+            while (!stopped())
+            {
+                if (mode == WakeMode::SPIN)
+                {
+                    for (unsigned i = 0; i < spins && !ready(); ++i)
+                        cpuRelax();
+                    if (ready())
+                        return true;
+                    if (spins == 0)
+                        std::this_thread::yield(); // one CPU: let the other side run
+                    continue;
+                }
+
+                const uint32_t seen = sequence.load();
+                waiting.store(1);
+                if (ready())
+                {
+                    waiting.store(0);
+                    return true;
+                }
+                futexWait(sequence, seen, shared);
+                waiting.store(0);
+                if (ready())
+                    return true;
+            }
+            return ready();
+        }
+    };
+
+    /**
+     * @struct RingControl
+     * @brief Positions and wake-up words of one ring, in shared memory.
+     *
+     * The producer's line holds @c head and the signal its consumer sleeps
+     * on; the consumer's line holds @c tail and the signal the producer
+     * sleeps on when the ring is full.
+     */
+    struct RingControl
+    {
+        alignas(64) std::atomic<uint64_t> head{0};
+        Signal data;
+        alignas(64) std::atomic<uint64_t> tail{0};
+        Signal space;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory rings need lock-free 64-bit atomics");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared-memory rings need lock-free 32-bit atomics");
+
+    /**
+     * @struct RegionHeader
+     * @brief First bytes of a region: identification, ring size, close flag.
+     */
+    struct alignas(64) RegionHeader
+    {
+        uint32_t              magic{kRegionMagic};
+        uint16_t              version{kRegionVersion};
+        uint16_t              reserved{0};
+        uint32_t              ringBytes{0};
+        std::atomic<uint32_t> closed{0}; ///< Set by either side when it leaves.
+    };
+
+    /// @brief Bytes of a region whose rings hold @p ringBytes each.
+    constexpr std::size_t regionSize(uint32_t ringBytes)
+    {
+        return sizeof(RegionHeader) + 2 * sizeof(RingControl) + 2 * static_cast<std::size_t>(ringBytes);
+    }
+
+    /**
+     * @class Ring
+     * @brief View of one ring: a producer or a consumer side, never both.
+     */
+    class Ring
+    {
+    public:
+        Ring() = default;
+
+        /// @param capacity Bytes at @p bytes; a power of two.
+        Ring(RingControl* control, uint8_t* bytes, uint32_t capacity)
+            : m_control(control), m_bytes(bytes), m_mask(capacity - 1)
+        {}
+
+        /// @brief Bytes the consumer can read now; 0 if corrupt().
+        std::size_t readable() const
+        {
+            const uint64_t used = m_control->head.load(std::memory_order_acquire)
+                                  - m_control->tail.load(std::memory_order_relaxed);
+            return used <= capacity() ? static_cast<std::size_t>(used) : 0;
+        }
+
+        /// @brief Bytes the producer can write now; 0 if corrupt().
+        std::size_t writable() const
+        {
+            const uint64_t used = m_control->head.load(std::memory_order_relaxed)
+                                  - m_control->tail.load(std::memory_order_acquire);
+            return used <= capacity() ? capacity() - static_cast<std::size_t>(used) : 0;
+        }
+
+        /// @brief True if the positions claim more than the ring holds, or a tail past the head.
+        bool corrupt() const
+        {
+            return m_control->head.load(std::memory_order_acquire) - m_control->tail.load(std::memory_order_acquire)
+                   > capacity();
+        }
+
+        std::size_t capacity() const { return static_cast<std::size_t>(m_mask) + 1; }
+
+        /// @brief Producer: copy up to @p size bytes in; returns how many fit.
+        std::size_t write(const uint8_t* data, std::size_t size, bool shared)
+        {
+            const uint64_t    head = m_control->head.load(std::memory_order_relaxed);
+            const std::size_t n    = std::min(size, writable());
+            if (n == 0)
+                return 0;
+            const std::size_t at    = static_cast<std::size_t>(head & m_mask);
+            const std::size_t first = std::min(n, capacity() - at);
+            std::memcpy(m_bytes + at, data, first);
+            std::memcpy(m_bytes, data + first, n - first);
+            m_control->head.store(head + n, std::memory_order_release);
+            m_control->data.notify(shared);
+            return n;
+        }
+
+        /// @brief Consumer: copy up to @p size bytes out; returns how many were read.
+        std::size_t read(uint8_t* out, std::size_t size, bool shared)
+        {
+            const std::size_t n = peek(out, std::min(size, readable()));
+            if (n == 0)
+                return 0;
+            m_control->tail.store(m_control->tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+            m_control->space.notify(shared);
+            return n;
+        }
+
+        /// @brief Consumer: copy up to @p size readable bytes out without consuming them.
+        std::size_t peek(uint8_t* out, std::size_t size) const
+        {
+            const std::size_t n     = std::min(size, readable()); // at most capacity()
+            const uint64_t    tail  = m_control->tail.load(std::memory_order_relaxed);
+            const std::size_t at    = static_cast<std::size_t>(tail & m_mask);
+            const std::size_t first = std::min(n, capacity() - at);
+            std::memcpy(out, m_bytes + at, first);
+            std::memcpy(out + first, m_bytes, n - first);
+            return n;
+        }
+
+        /**
+         * @brief Producer: write all @p size bytes, waiting for space as needed.
+         * @return false if @p stopped() became true first, or the ring is corrupt().
+         */
+        template <typename Stopped>
+        bool writeAll(const uint8_t* data, std::size_t size, Stopped stopped, WakeMode mode, bool shared)
+        {
+            while (size > 0)
+            {
+                const std::size_t n = write(data, size, shared);
+                data += n;
+                size -= n;
+                if (size > 0
+                    && (!m_control->space.wait([this]() { return writable() > 0 || corrupt(); }, stopped, mode,
+                                               shared)
+                        || corrupt()))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Consumer: read exactly @p size bytes, waiting for data as needed.
+         * @return false if @p stopped() became true first, or the ring is corrupt().
+         */
+        template <typename Stopped>
+        bool readAll(uint8_t* out, std::size_t size, Stopped stopped, WakeMode mode, bool shared)
+        {
+            while (size > 0)
+            {
+                const std::size_t n = read(out, size, shared);
+                out += n;
+                size -= n;
+                if (size > 0
+                    && (!m_control->data.wait([this]() { return readable() > 0 || corrupt(); }, stopped, mode,
+                                              shared)
+                        || corrupt()))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Consumer: wait until bytes are readable.
+         * @return false if @p stopped() became true first.
+         */
+        template <typename Stopped>
+        bool waitReadable(Stopped stopped, WakeMode mode, bool shared)
+        {
+            return m_control->data.wait([this]() { return readable() > 0; }, stopped, mode, shared);
+        }
+
+        /**
+         * @brief Producer: wait until bytes are writable.
+         * @return false if @p stopped() became true first.
+         */
+        template <typename Stopped>
+        bool waitWritable(Stopped stopped, WakeMode mode, bool shared)
+        {
+            return m_control->space.wait([this]() { return writable() > 0; }, stopped, mode, shared);
+        }
+
+        /// @brief Wake both sides, e.g. after the region was closed.
+        void wakeAll(bool shared)
+        {
+            m_control->data.notify(shared);
+            m_control->space.notify(shared);
+        }
+
+    private:
+        RingControl* m_control{nullptr};
+        uint8_t*     m_bytes{nullptr};
+        uint64_t     m_mask{0};
+    };
+
+    /**
+     * @class Region
+     * @brief A mapped region: its header and its two rings.
+     *
+     * Owns the mapping; moving transfers it, destruction unmaps it.
+     */
+    class Region
+    {
+    public:
+        Region() = default;
+        ~Region();
+
+        Region(Region&& other) noexcept;
+        Region& operator=(Region&& other) noexcept;
+        Region(const Region&)            = delete;
+        Region& operator=(const Region&) = delete;
+
+        /**
+         * @brief Create, size and map a new region named @p name (client side).
+         * @param ringBytes Size of each ring; a power of two, at least kMinRingBytes.
+         * @throws std::invalid_argument for a bad ring size; std::runtime_error
+         *         if the region cannot be created or mapped.
+         */
+        static Region create(const std::string& name, uint32_t ringBytes);
+
+        /**
+         * @brief Map the existing region @p name (server side).
+         * @throws std::runtime_error if it cannot be opened or mapped, or its
+         *         header, version or size do not match.
+         */
+        static Region open(const std::string& name);
+
+        /// @brief Remove the name; mappings stay valid until unmapped.
+        static void unlink(const std::string& name);
+
+        bool valid() const { return m_base != nullptr; }
+
+        RegionHeader& header() const { return *static_cast<RegionHeader*>(m_base); }
+
+        /// @brief Client → server ring.
+        Ring requests() const { return m_requests; }
+
+        /// @brief Server → client ring.
+        Ring responses() const { return m_responses; }
+
+        /// @brief Mark the region closed (by either side) and wake every waiter.
+        void close();
+
+        /// @brief True once either side has closed the region.
+        bool closed() const { return header().closed.load(std::memory_order_acquire) != 0; }
+
+    private:
+        Region(void* base, std::size_t size);
+
+        void*       m_base{nullptr};
+        std::size_t m_size{0};
+        Ring        m_requests;
+        Ring        m_responses;
+    };
+} // namespace shm
+
+#endif // SHMRING_HPP
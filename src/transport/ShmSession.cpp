@@ -0,0 +1,294 @@
+/**
+ * @file ShmSession.cpp
+ * @brief Implementation of the shared-memory session: reader thread,
+ *        dispatch, and replies copied straight into the response ring.
+ */
+
+#include "ShmSession.hpp"
+
+#include "FrameCodec.hpp"
+#include "logging/Log.hpp"
+#include "metrics/LatencyRecorder.hpp"
+
+#include <algorithm>
+#include <utility>
+
+ShmSession::ShmSession(uint64_t                           id,
+                       shm::Region                        region,
+                       std::shared_ptr<ControlSocket>     control,
+                       std::shared_ptr<IServerFacade>     facade,
+                       CloseHandler                       onClose,
+                       shm::WakeMode                      mode,
+                       const TransportConfig&             config,
+                       std::shared_ptr<TransportCounters> counters)
+    : m_id(id)
+    , m_region(std::move(region))
+    , m_requests(m_region.requests())
+    , m_responses(m_region.responses())
+    , m_control(std::move(control))
+    , m_facade(std::move(facade))
+    , m_onClose(std::move(onClose))
+    , m_counters(std::move(counters))
+    , m_mode(mode)
+    , m_maxPipelined(std::max<std::size_t>(config.maxPipelinedRequests, 1))
+{
+}
+
+ShmSession::~ShmSession()
+{
+    join();
+    if (m_reader.joinable())
+        m_reader.detach(); // destroyed by the reader itself
+}
+
+void ShmSession::start()
+{
+    if (closed())
+        return; // closed before it started, e.g. by a concurrent stop()
+    m_reader = std::thread([this]() { readLoop(); });
+    watchControl();
+}
+
+void ShmSession::join()
+{
+    if (m_reader.joinable() && m_reader.get_id() != std::this_thread::get_id())
+        m_reader.join();
+}
+
+std::size_t ShmSession::queuedBytes() const
+{
+    return m_responses.readable();
+}
+
+SessionStats ShmSession::stats() const
+{
+    SessionStats stats;
+    stats.id           = m_id;
+    stats.requests     = m_requestCount.load(std::memory_order_relaxed);
+    stats.bytesIn      = m_bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut     = m_bytesOut.load(std::memory_order_relaxed);
+    stats.queuedFrames = queuedFrames();
+    stats.queuedBytes  = queuedBytes();
+    return stats;
+}
+
+// ==========================================================================
+// Read path — reader thread: length prefix, payload, dispatch
+// ==========================================================================
+
+void ShmSession::readLoop()
+{
+    const auto stopped = [this]() { return closed() || m_region.closed(); };
+    const auto canRead = [this]()
+    { return !m_lockStepPending.load() && m_pendingRequests.load() < m_maxPipelined; };
+
+    uint8_t prefix[framing::kLengthPrefixSize];
+    while (m_progress.wait(canRead, stopped, m_mode, false)
+           && m_requests.readAll(prefix, sizeof(prefix), stopped, m_mode, true))
+    {
+        const uint32_t payloadLen = framing::decodeBE32(prefix);
+        if (payloadLen > framing::kMaxFrameSize)
+        {
+            HFT_LOG_WARN("[shm session {}] frame of {} bytes exceeds the limit", m_id, payloadLen);
+            shutdown("oversized frame");
+            return;
+        }
+
+        RawBuffer payload(payloadLen);
+        if (!m_requests.readAll(payload.data(), payloadLen, stopped, m_mode, true))
+            break;
+        dispatch(std::move(payload), LatencyRecorder::now());
+    }
+
+    if (!closed() && m_requests.corrupt())
+    {
+        HFT_LOG_WARN("[shm session {}] request ring positions are corrupt — disconnecting", m_id);
+        shutdown("protocol violation");
+        return;
+    }
+    shutdown(closed() ? nullptr : "client detached");
+}
+
+void ShmSession::dispatch(RawBuffer payload, int64_t receivedAt)
+{
+    m_requestCount.fetch_add(1, std::memory_order_relaxed);
+    m_bytesIn.fetch_add(framing::kLengthPrefixSize + payload.size(), std::memory_order_relaxed);
+
+    Request    request;
+    const bool decoded = framing::decodeRequest(payload, request);
+    request.sessionId  = m_id;
+    payload.clear(); // the request now holds the only reference
+    if (!decoded)
+    {
+        writeReply(framing::encodeResponseFrame(Response{false, "Malformed request frame", {}}));
+        return;
+    }
+
+    request.timing.receivedAt = receivedAt;
+    request.timing.decodedAt  = LatencyRecorder::now();
+    LatencyRecorder::instance().record(request.type, LatencyStage::DECODE,
+                                       static_cast<uint64_t>(request.timing.decodedAt - receivedAt));
+
+    const RequestType type         = request.type;
+    const bool        hasRequestId = request.hasRequestId;
+    const uint64_t    requestId    = request.requestId;
+
+    // Before dispatching: an inline facade answers before handleRequestAsync returns.
+    m_pendingRequests.fetch_add(1);
+    m_lockStepPending = !hasRequestId;
+
+    auto self = shared_from_this();
+    m_facade->handleRequestAsync(std::move(request),
+                                 [this, self, type, receivedAt, hasRequestId, requestId](Response response)
+                                 {
+                                     response.hasRequestId = hasRequestId;
+                                     response.requestId    = requestId;
+                                     onResponse(response, type, receivedAt);
+                                 });
+}
+
+// ==========================================================================
+// Write path — any thread → response ring
+// ==========================================================================
+
+void ShmSession::onResponse(const Response& response, RequestType type, int64_t receivedAt)
+{
+    const int64_t queuedAt = LatencyRecorder::now();
+    if (!writeReply(framing::encodeResponseFrame(response)) || response.more)
+        return;
+
+    LatencyRecorder::instance().recordSince(type, LatencyStage::SEND, queuedAt);
+    LatencyRecorder::instance().recordSince(type, LatencyStage::TOTAL, receivedAt);
+
+    m_pendingRequests.fetch_sub(1);
+    if (!response.hasRequestId)
+        m_lockStepPending = false;
+    m_progress.notify(false);
+}
+
+bool ShmSession::writeReply(const RawBuffer& frame)
+{
+    const std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (closed())
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + kReplyTimeout;
+    const auto stopped  = [this, deadline]()
+    { return closed() || m_region.closed() || std::chrono::steady_clock::now() > deadline; };
+    if (!m_responses.writeAll(frame.data(), frame.size(), stopped, m_mode, true))
+    {
+        if (!closed() && m_responses.corrupt())
+        {
+            HFT_LOG_WARN("[shm session {}] response ring positions are corrupt — disconnecting", m_id);
+            shutdown("protocol violation");
+            return false;
+        }
+        if (!closed() && !m_region.closed())
+        {
+            HFT_LOG_WARN("[shm session {}] slow consumer: no ring space for {} s — disconnecting", m_id,
+                         kReplyTimeout.count());
+            if (m_counters)
+                m_counters->slowConsumerDisconnects.fetch_add(1, std::memory_order_relaxed);
+        }
+        shutdown(nullptr);
+        return false;
+    }
+
+    m_bytesOut.fetch_add(frame.size(), std::memory_order_relaxed);
+    return true;
+}
+
+bool ShmSession::writeMarketData(const RawBuffer& frame)
+{
+    const std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (closed())
+        return false;
+
+    if (m_responses.corrupt())
+    {
+        HFT_LOG_WARN("[shm session {}] response ring positions are corrupt — disconnecting", m_id);
+        shutdown("protocol violation");
+        return false;
+    }
+    if (m_responses.writable() < frame.size())
+    {
+        if (m_counters)
+            m_counters->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_responses.write(frame.data(), frame.size(), true);
+    m_bytesOut.fetch_add(frame.size(), std::memory_order_relaxed);
+    return true;
+}
+
+void ShmSession::deliver(RawBuffer frame)
+{
+    writeMarketData(frame);
+}
+
+void ShmSession::deliverBatch(std::vector<RawBuffer> frames)
+{
+    for (const auto& frame : frames)
+        writeMarketData(frame);
+}
+
+void ShmSession::publish(std::vector<Response> messages, ISessionPublisher::DrainedHandler onDrained)
+{
+    for (const auto& message : messages)
+        writeMarketData(framing::encodeResponseFrame(message));
+
+    // Posted, not called: the handler may publish again, and would recurse here.
+    if (onDrained && !closed())
+        boost::asio::post(m_control->get_executor(), std::move(onDrained));
+}
+
+// ==========================================================================
+// Liveness and shutdown
+// ==========================================================================
+
+void ShmSession::watchControl()
+{
+    auto self = shared_from_this();
+    m_control->async_read_some(boost::asio::buffer(&m_controlByte, 1),
+                               [this, self](const boost::system::error_code& ec, std::size_t)
+                               {
+                                   if (!ec)
+                                   {
+                                       watchControl(); // the client sends nothing; ignore it
+                                       return;
+                                   }
+                                   if (ec != boost::asio::error::operation_aborted)
+                                       shutdown("client disconnected");
+                               });
+}
+
+void ShmSession::close()
+{
+    shutdown(nullptr);
+}
+
+void ShmSession::shutdown(const char* reason)
+{
+    if (m_closed.exchange(true))
+        return;
+
+    if (reason)
+        HFT_LOG_INFO("[shm session {}] {}", m_id, reason);
+
+    // Wakes the reader, any writer waiting for space, and the client.
+    m_region.close();
+    m_progress.notify(false);
+
+    auto control = m_control;
+    boost::asio::post(control->get_executor(),
+                      [control]()
+                      {
+                          boost::system::error_code ignored;
+                          control->cancel(ignored);
+                          control->close(ignored);
+                      });
+
+    if (m_onClose)
+        m_onClose(m_id);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file ShmSession.hpp
+ * @brief One client attached through a shared-memory region.
+ *
+ * @details The ShmTransport counterpart of StreamSession. The client writes
+ * length-prefixed Request frames into the region's request ring and reads
+ * Response frames from its response ring (see ShmRing.hpp); the frames are
+ * byte for byte those of the socket transports, so tagging, pipelining and
+ * streamed replies work unchanged.
+ *
+ * A dedicated reader thread takes frames off the request ring, decodes them
+ * and hands them to IServerFacade::handleRequestAsync(). It waits for the
+ * ring in the transport's wake mode: spinning, or sleeping on a futex that
+ * the client only wakes when the reader has announced it is asleep. Replies
+ * are copied into the response ring on the thread that produced them,
+ * under a mutex that keeps the ring single-producer; there is no write
+ * queue and no io_context hop, so a request and its reply never leave user
+ * space while both sides are busy.
+ *
+ * Flow control mirrors StreamSession:
+ * - A request without an id is answered in lock-step, a tagged one is
+ *   pipelined up to TransportConfig::maxPipelinedRequests in flight.
+ * - A reply waits for ring space; if the client has not made room within
+ *   kReplyTimeout it is too slow and is disconnected.
+ * - Broadcast and pushed frames are market data: one that does not fit in
+ *   the ring right now is dropped and counted.
+ * - A streamed reply paces its worker naturally: each part waits for space.
+ * - A ring whose positions the client corrupted (ShmRing::corrupt()) is a
+ *   protocol violation and closes the session.
+ *
+ * Replies are never compressed: compression only pays for itself on a
+ * link, and here the "link" is a memcpy.
+ *
+ * The Unix socket the client attached over stays open as a liveness
+ * signal: when the client process exits, its end closes and the session
+ * shuts down even if the client never marked the region closed. Drained
+ * handlers of publish() run on that socket's io_context.
+ */
+
+#ifndef SHMSESSION_HPP
+#define SHMSESSION_HPP
+
+#include "server/IServerFacade.hpp"
+#include "transport/ISessionPublisher.hpp"
+#include "transport/TransportStats.hpp"
+
+#include "ShmRing.hpp"
+#include "TransportConfig.hpp"
+#include "TransportSession.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+/**
+ * @class ShmSession
+ * @brief Per-client read → dispatch → write loop over a shared-memory region.
+ *
+ * Owned through std::shared_ptr. The reader thread uses the session
+ * without holding a reference, so the owner must keep one until join().
+ */
+class ShmSession final : public TransportSession, public std::enable_shared_from_this<ShmSession>
+{
+public:
+    using ControlSocket = boost::asio::local::stream_protocol::socket;
+
+    /// Invoked once when the session has shut down.
+    using CloseHandler = std::function<void(uint64_t sessionId)>;
+
+    /// @brief Longest a reply waits for room in the response ring.
+    static constexpr std::chrono::seconds kReplyTimeout{5};
+
+    /**
+     * @brief Construct a session around an opened region.
+     * @param id       Transport-unique session identifier.
+     * @param region   The client's region, mapped with shm::Region::open().
+     * @param control  The Unix socket the client attached over.
+     * @param facade   Server entry point that executes decoded requests.
+     * @param onClose  Called once the session has shut down.
+     * @param mode     How the reader and blocked writers wait for the rings.
+     * @param config   Transport options (pipelining limit).
+     * @param counters Backpressure counters shared with the transport; may be null.
+     */
+    ShmSession(uint64_t                           id,
+               shm::Region                        region,
+               std::shared_ptr<ControlSocket>     control,
+               std::shared_ptr<IServerFacade>     facade,
+               CloseHandler                       onClose,
+               shm::WakeMode                      mode,
+               const TransportConfig&             config   = {},
+               std::shared_ptr<TransportCounters> counters = nullptr);
+
+    ~ShmSession() override;
+
+    ShmSession(const ShmSession&)            = delete;
+    ShmSession& operator=(const ShmSession&) = delete;
+
+    /// @brief Launch the reader thread and watch the control socket.
+    void start() override;
+
+    /// @brief Copy an already-framed market data buffer into the response ring.
+    void deliver(RawBuffer frame) override;
+
+    /// @brief Copy several framed market data buffers, in order.
+    void deliverBatch(std::vector<RawBuffer> frames) override;
+
+    /**
+     * @brief Encode pushed responses and copy them into the response ring.
+     * @param messages  Responses to send, in order.
+     * @param onDrained Posted to the control socket's io_context once they
+     *                  have been copied; dropped if the session is closed.
+     */
+    void publish(std::vector<Response> messages, ISessionPublisher::DrainedHandler onDrained) override;
+
+    /// @brief Shut the session down; safe to call from any thread.
+    void close() override;
+
+    /// @brief Wait for the reader thread to exit; call after close().
+    void join();
+
+    /// @brief True once the session has shut down.
+    bool closed() const { return m_closed.load(std::memory_order_acquire); }
+
+    /// @brief Transport-unique session identifier.
+    uint64_t id() const override { return m_id; }
+
+    /// @brief Always 0: frames go straight into the ring.
+    std::size_t queuedFrames() const override { return 0; }
+
+    /// @brief Bytes in the response ring the client has not read yet.
+    std::size_t queuedBytes() const override;
+
+    /// @brief Throughput and ring depth so far; safe from any thread.
+    SessionStats stats() const override;
+
+private:
+    /// Reader thread: frames off the request ring until the session closes.
+    void readLoop();
+
+    /// Decode and dispatch one request frame received at @p receivedAt.
+    void dispatch(RawBuffer payload, int64_t receivedAt);
+
+    /// A reply from a worker (or the reader); final parts free a pipeline slot.
+    void onResponse(const Response& response, RequestType type, int64_t receivedAt);
+
+    /// Copy a reply frame into the response ring, waiting up to kReplyTimeout.
+    bool writeReply(const RawBuffer& frame);
+
+    /// Copy a market data frame if it fits now; false if it was dropped.
+    bool writeMarketData(const RawBuffer& frame);
+
+    /// Await EOF on the control socket.
+    void watchControl();
+
+    /// Close the region and the control socket, then call onClose once.
+    /// @param reason Logged if not null; null for a close the server asked for.
+    void shutdown(const char* reason);
+
+    uint64_t                           m_id;
+    shm::Region                        m_region;
+    shm::Ring                          m_requests;
+    shm::Ring                          m_responses;
+    std::shared_ptr<ControlSocket>     m_control;
+    std::shared_ptr<IServerFacade>     m_facade;
+    CloseHandler                       m_onClose;
+    std::shared_ptr<TransportCounters> m_counters;
+    shm::WakeMode                      m_mode;
+
+    /// Limit on in-flight requests before the reader stops (at least 1).
+    std::size_t m_maxPipelined;
+
+    /// Requests dispatched whose final reply has not been written yet.
+    std::atomic<std::size_t> m_pendingRequests{0};
+
+    /// A request without an id is pending; nothing is read until it is answered.
+    std::atomic<bool> m_lockStepPending{false};
+
+    /// Notified by replies that free the reader; private to this process.
+    shm::Signal m_progress;
+
+    /// Keeps the response ring single-producer across worker threads.
+    std::mutex m_writeMutex;
+
+    /// Throughput; read by stats().
+    std::atomic<uint64_t> m_requestCount{0};
+    std::atomic<uint64_t> m_bytesIn{0};
+    std::atomic<uint64_t> m_bytesOut{0};
+
+    /// Target of the control socket watch; its value is never used.
+    uint8_t m_controlByte{0};
+
+    std::thread m_reader;
+
+    /// Set once by shutdown().
+    std::atomic<bool> m_closed{false};
+};
+
+#endif // SHMSESSION_HPP
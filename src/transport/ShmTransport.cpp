@@ -0,0 +1,205 @@
+/**
+ * @file ShmTransport.cpp
+ * @brief Implementation of the shared-memory transport: the attach socket,
+ *        the handshake, and the lifetime of the sessions' reader threads.
+ */
+
+#include "ShmTransport.hpp"
+
+#include "FrameCodec.hpp"
+#include "logging/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <utility>
+
+struct ShmTransport::Attach
+{
+    explicit Attach(boost::asio::io_context& context)
+        : socket(std::make_shared<Unix::socket>(context))
+    {
+    }
+
+    std::shared_ptr<Unix::socket>                       socket;
+    std::array<uint8_t, framing::kLengthPrefixSize>     prefix{};
+    std::string                                         name;
+    uint8_t                                             status{shm::kAttachRefused};
+};
+
+// ==========================================================================
+// Constructor / destructor
+// ==========================================================================
+
+ShmTransport::ShmTransport(std::string controlPath, std::shared_ptr<IServerFacade> facade, TransportConfig config)
+    : SessionTransport(std::move(facade), config)
+    , m_controlPath(std::move(controlPath))
+    , m_mode(config.shmBusySpin ? shm::WakeMode::SPIN : shm::WakeMode::FUTEX)
+    , m_acceptor(m_ioPool.ioContextAt(0))
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+    stop();
+}
+
+// ==========================================================================
+// start() — bind the attach socket, launch io_context threads
+// ==========================================================================
+
+void ShmTransport::start()
+{
+    if (m_running.exchange(true))
+        return; // already started
+
+    const Unix::endpoint endpoint(m_controlPath);
+    try
+    {
+        m_acceptor.open(endpoint.protocol());
+        removeSocketFile(m_controlPath); // left behind by a run that did not stop cleanly
+        m_acceptor.bind(endpoint);
+        m_acceptor.listen(boost::asio::socket_base::max_listen_connections);
+    }
+    catch (...)
+    {
+        boost::system::error_code ignored;
+        m_acceptor.close(ignored);
+        m_running = false;
+        throw;
+    }
+
+    HFT_LOG_INFO("[transport] Attaching shared-memory clients on unix:{} ({} wake-ups, {} io thread(s))",
+                 m_controlPath, shm::wakeModeName(m_mode), m_ioPool.size());
+
+    acceptNextConnection();
+    m_ioPool.start();
+}
+
+// ==========================================================================
+// stop() — close sessions, join their readers, stop the pool
+// ==========================================================================
+
+void ShmTransport::stop()
+{
+    if (!m_running.exchange(false))
+        return; // already stopped
+
+    boost::system::error_code ec;
+    m_acceptor.close(ec);
+    removeSocketFile(m_controlPath);
+
+    closeSessions();
+
+    std::vector<std::shared_ptr<ShmSession>> started;
+    {
+        const std::lock_guard<std::mutex> lock(m_startedMutex);
+        started.swap(m_started);
+    }
+    for (const auto& session : started)
+    {
+        session->close(); // also those that never reached the session table
+        session->join();
+    }
+
+    m_ioPool.stop();
+
+    HFT_LOG_INFO("[transport] Stopped.");
+}
+
+// ==========================================================================
+// Attach handshake — accept → region name → map → status byte → session
+// ==========================================================================
+
+void ShmTransport::acceptNextConnection()
+{
+    // The control socket, and so the session's drained handlers, stay on this context.
+    auto attach = std::make_shared<Attach>(m_ioPool.getIoContext());
+
+    m_acceptor.async_accept(*attach->socket,
+                            [this, attach](const boost::system::error_code& ec)
+                            {
+                                if (ec)
+                                {
+                                    if (ec != boost::asio::error::operation_aborted)
+                                        HFT_LOG_ERROR("[transport] accept error: {}", ec.message());
+                                    return; // acceptor was closed — do not re-arm
+                                }
+
+                                if (!m_running)
+                                    return;
+                                acceptNextConnection();
+                                readRegionName(attach);
+                            });
+}
+
+void ShmTransport::readRegionName(const std::shared_ptr<Attach>& attach)
+{
+    boost::asio::async_read(
+        *attach->socket, boost::asio::buffer(attach->prefix),
+        [this, attach](const boost::system::error_code& ec, std::size_t)
+        {
+            if (ec)
+                return; // gone before attaching; dropping the socket closes it
+
+            const uint32_t length = framing::decodeBE32(attach->prefix.data());
+            if (length == 0 || length > shm::kMaxRegionName)
+            {
+                HFT_LOG_WARN("[transport] shared-memory attach refused: region name of {} bytes", length);
+                return;
+            }
+
+            attach->name.resize(length);
+            boost::asio::async_read(*attach->socket, boost::asio::buffer(attach->name),
+                                    [this, attach](const boost::system::error_code& readError, std::size_t)
+                                    {
+                                        if (!readError)
+                                            attachRegion(attach);
+                                    });
+        });
+}
+
+void ShmTransport::attachRegion(const std::shared_ptr<Attach>& attach)
+{
+    std::shared_ptr<ShmSession> session;
+    try
+    {
+        session = std::make_shared<ShmSession>(nextSessionId(), shm::Region::open(attach->name), attach->socket,
+                                               m_facade, closeHandler(), m_mode, m_config, m_counters);
+        attach->status = shm::kAttachAccepted;
+    }
+    catch (const std::exception& e)
+    {
+        HFT_LOG_WARN("[transport] shared-memory attach refused: {}", e.what());
+    }
+
+    boost::asio::async_write(
+        *attach->socket, boost::asio::buffer(&attach->status, 1),
+        [this, attach, session](const boost::system::error_code& ec, std::size_t)
+        {
+            if (ec || !session)
+                return; // an unstarted session just unmaps the region
+
+            {
+                // Under the lock, so stop() either sees the session or we see it stopping.
+                const std::lock_guard<std::mutex> lock(m_startedMutex);
+                if (!m_running)
+                    return;
+                pruneStarted();
+                m_started.push_back(session);
+            }
+
+            HFT_LOG_INFO("[transport] Attached shared-memory region {} — session {}", attach->name, session->id());
+            addSession(session);
+            session->start();
+        });
+}
+
+void ShmTransport::pruneStarted()
+{
+    const auto finished = std::partition(m_started.begin(), m_started.end(),
+                                         [](const std::shared_ptr<ShmSession>& session) { return !session->closed(); });
+    for (auto it = finished; it != m_started.end(); ++it)
+        (*it)->join(); // its reader has been woken and is on its way out
+    m_started.erase(finished, m_started.end());
+}
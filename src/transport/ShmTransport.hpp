@@ -0,0 +1,98 @@
+/**
+ * @file ShmTransport.hpp
+ * @brief ITransport over shared-memory rings, for consumers on the same host.
+ *
+ * @details Each client creates its own region (see ShmRing.hpp), then
+ * attaches it over a Unix domain socket the transport listens on:
+ *
+ *   client → [ BE32 name length ][ region name, e.g. "/hft-shm-4242-1" ]
+ *   server → [ status byte: 0 = attached, 1 = refused ]
+ *
+ * The server maps the region, checks its header, and from then on the
+ * session runs entirely in the region (see ShmSession.hpp): the same
+ * Request/Response frames as the socket transports, written and read with
+ * memcpy, with no syscall on the data path while both sides are busy. The
+ * socket stays open only so that each side notices when the other exits.
+ *
+ * TransportConfig::shmBusySpin makes the readers, and writers waiting for
+ * space, spin instead of sleeping on a futex: the lowest latency, at the
+ * cost of one busy core per client. The client picks its own wait mode.
+ *
+ * Sessions join the shared session table, so broadcasts, targeted pushes
+ * (subscriptions) and GET_STATS see them like any other client. Access
+ * control is the permissions of the socket file's directory and of the
+ * client's region (created 0600, i.e. only the client's user and root).
+ */
+
+#ifndef SHMTRANSPORT_HPP
+#define SHMTRANSPORT_HPP
+
+#include "server/IServerFacade.hpp"
+
+#include "SessionTransport.hpp"
+#include "ShmRing.hpp"
+#include "ShmSession.hpp"
+#include "TransportConfig.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+/**
+ * @class ShmTransport
+ * @brief SessionTransport whose clients attach shared-memory regions.
+ */
+class ShmTransport final : public SessionTransport
+{
+public:
+    /**
+     * @brief Construct the transport; nothing is bound until start().
+     * @param controlPath Path of the Unix socket that clients attach over.
+     * @param facade      Server entry point that executes client requests.
+     * @param config      Threading, wait mode and pipelining options.
+     */
+    ShmTransport(std::string controlPath, std::shared_ptr<IServerFacade> facade, TransportConfig config = {});
+
+    ~ShmTransport() override;
+
+    /// @copydoc ITransport::start
+    void start() override;
+
+    /// @copydoc ITransport::stop
+    void stop() override;
+
+    /// @brief Path of the attach socket.
+    const std::string& controlPath() const { return m_controlPath; }
+
+private:
+    using Unix = boost::asio::local::stream_protocol;
+
+    /// Handshake state of one connecting client.
+    struct Attach;
+
+    /// Begin an async accept cycle; re-invoked after each connection.
+    void acceptNextConnection();
+
+    /// Read the region name sent by a connected client.
+    void readRegionName(const std::shared_ptr<Attach>& attach);
+
+    /// Map the named region and start its session, or refuse it.
+    void attachRegion(const std::shared_ptr<Attach>& attach);
+
+    /// Join and forget the sessions that have shut down; m_startedMutex held.
+    void pruneStarted();
+
+    std::string    m_controlPath;
+    shm::WakeMode  m_mode;
+    Unix::acceptor m_acceptor;
+
+    /// Sessions whose reader thread may still run; joined by stop().
+    std::vector<std::shared_ptr<ShmSession>> m_started;
+    std::mutex                               m_startedMutex;
+};
+
+#endif // SHMTRANSPORT_HPP
@@ -0,0 +1,531 @@
+/**
+ * @file StreamSession.cpp
+ * @brief Implementation of the per-connection async read/dispatch/write loop.
+ *
+ * @details Defined once for every stream type and explicitly instantiated
+ * at the end of the file for the TLS, TCP and Unix domain socket sessions.
+ */
+
+#include "StreamSession.hpp"
+
+#include "FrameCodec.hpp"
+#include "KernelTls.hpp"
+#include "logging/Log.hpp"
+#include "metrics/LatencyRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+    /// Add to a counter that only the session's io_context writes.
+    void bump(std::atomic<uint64_t>& counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /// Completions a session can hold before falling back to direct posts.
+    constexpr std::size_t kCompletionQueueCapacity = 16;
+
+    /// Pause between checks while a streamed part waits for the queue to drain.
+    constexpr auto kStreamBackoff = std::chrono::microseconds(100);
+
+    /// Only a TLS stream can have its outbound records encrypted by the kernel.
+    template <typename Stream>
+    constexpr bool kIsTls = std::is_same_v<Stream, SslStream>;
+} // namespace
+
+template <typename Stream>
+StreamSession<Stream>::StreamSession(uint64_t                           id,
+                                     std::shared_ptr<Stream>            socket,
+                                     std::shared_ptr<IServerFacade>     facade,
+                                     CloseHandler                       onClose,
+                                     const TransportConfig&             config,
+                                     std::shared_ptr<TransportCounters> counters,
+                                     bool                               kernelTls)
+    : m_id(id)
+    , m_socket(std::move(socket))
+    , m_facade(std::move(facade))
+    , m_onClose(std::move(onClose))
+    , m_counters(std::move(counters))
+    , m_kernelTls(kIsTls<Stream> && kernelTls)
+    , m_writeQueue(config.maxCoalescedBytes, config.maxQueuedBytes, config.maxQueuedFrames)
+    , m_completions(kCompletionQueueCapacity)
+    , m_streamHighWater(config.maxQueuedBytes / 2)
+    , m_maxPipelined(std::max<std::size_t>(config.maxPipelinedRequests, 1))
+    , m_compressMinBytes(config.compressMinBytes)
+    , m_compressionCodecs(static_cast<uint8_t>(config.compressionCodecs & compression::availableCodecs()))
+{
+}
+
+template <typename Stream>
+void StreamSession<Stream>::start()
+{
+    doReadHeader();
+}
+
+template <typename Stream>
+SessionStats StreamSession<Stream>::stats() const
+{
+    SessionStats stats;
+    stats.id           = m_id;
+    stats.requests     = m_requests.load(std::memory_order_relaxed);
+    stats.bytesIn      = m_bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut     = m_bytesOut.load(std::memory_order_relaxed);
+    stats.queuedFrames = queuedFrames();
+    stats.queuedBytes  = queuedBytes();
+    return stats;
+}
+
+// ==========================================================================
+// Read path — 4-byte length header, then the payload
+// ==========================================================================
+
+template <typename Stream>
+void StreamSession<Stream>::doReadHeader()
+{
+    auto self = this->shared_from_this();
+    boost::asio::async_read(
+        *m_socket,
+        boost::asio::buffer(m_header),
+        [this, self](const boost::system::error_code& ec, std::size_t)
+        {
+            if (ec || writeKeyStale())
+            {
+                shutdown(ec ? ec : boost::asio::error::connection_aborted);
+                return;
+            }
+
+            const uint32_t payloadLen = framing::decodeBE32(m_header.data());
+            if (payloadLen > framing::kMaxFrameSize)
+            {
+                HFT_LOG_WARN("[session {}] frame of {} bytes exceeds limit — closing",
+                             m_id, payloadLen);
+                shutdown(boost::asio::error::message_size);
+                return;
+            }
+
+            doReadPayload(payloadLen);
+        });
+}
+
+template <typename Stream>
+void StreamSession<Stream>::doReadPayload(uint32_t payloadLen)
+{
+    // A fresh pooled block per frame: the previous one may still be owned
+    // by a request on a worker thread.
+    m_payload = RawBuffer::uninitialized(payloadLen);
+
+    auto self = this->shared_from_this();
+    boost::asio::async_read(
+        *m_socket,
+        boost::asio::buffer(m_payload.data(), m_payload.size()),
+        [this, self](const boost::system::error_code& ec, std::size_t)
+        {
+            if (ec || writeKeyStale())
+            {
+                shutdown(ec ? ec : boost::asio::error::connection_aborted);
+                return;
+            }
+
+            dispatch();
+        });
+}
+
+// ==========================================================================
+// dispatch() — decode and hand off to the facade; the reply arrives later
+// ==========================================================================
+
+template <typename Stream>
+void StreamSession<Stream>::dispatch()
+{
+    const int64_t receivedAt = LatencyRecorder::now();
+    bump(m_requests, 1);
+    bump(m_bytesIn, m_header.size() + m_payload.size());
+
+    Request request;
+    const bool decoded = framing::decodeRequest(m_payload, request);
+    request.sessionId = m_id;
+    m_payload.clear(); // the request now holds the only reference
+    if (!decoded)
+    {
+        enqueueWrite(framing::encodeResponseFrame(
+            Response{false, "Malformed request frame", {}}));
+        doReadHeader();
+        return;
+    }
+
+    request.timing.receivedAt = receivedAt;
+    request.timing.decodedAt  = LatencyRecorder::now();
+    LatencyRecorder::instance().record(request.type, LatencyStage::DECODE,
+                                       static_cast<uint64_t>(request.timing.decodedAt - receivedAt));
+
+    const RequestType type         = request.type;
+    const bool        hasRequestId = request.hasRequestId;
+    const uint64_t    requestId    = request.requestId;
+    const uint8_t     acceptCodecs = request.acceptCodecs;
+    ++m_pendingRequests;
+    m_lockStepPending = !hasRequestId;
+    m_readPaused      = true;
+
+    auto self = this->shared_from_this();
+    m_facade->handleRequestAsync(
+        std::move(request),
+        [this, self, type, receivedAt, hasRequestId, requestId, acceptCodecs](Response response)
+        {
+            response.hasRequestId = hasRequestId;
+            response.requestId    = requestId;
+            compressReply(response, type, acceptCodecs);
+            onResponse(Completion{std::move(response), type, receivedAt});
+        });
+
+    // A pipelined request does not wait for its reply.
+    resumeReading();
+}
+
+template <typename Stream>
+void StreamSession<Stream>::resumeReading()
+{
+    if (!m_readPaused || m_closed || m_lockStepPending || m_pendingRequests >= m_maxPipelined)
+        return;
+    m_readPaused = false;
+    doReadHeader();
+}
+
+// ==========================================================================
+// Completion path — any thread → completion queue → io_context
+// ==========================================================================
+
+template <typename Stream>
+void StreamSession<Stream>::compressReply(Response& response, RequestType type, uint8_t acceptCodecs)
+{
+    const uint8_t offered = acceptCodecs & m_compressionCodecs;
+    if (offered == 0 || m_compressMinBytes == 0 || response.data.size() < m_compressMinBytes)
+        return;
+
+    // Report downloads are the WAN-bound case: spend CPU on the ratio there.
+    const compression::Codec codec =
+        compression::chooseCodec(offered, type == RequestType::GENERATE_REPORT);
+    const PooledBuffer& raw = response.data; // const: reading must not detach a shared block
+    PooledBuffer        packed;
+    {
+        const std::lock_guard<std::mutex> lock(m_compressorMutex);
+        if (!m_compressor.compress(codec, raw.data(), raw.size(), packed))
+            return;
+    }
+    response.data  = std::move(packed);
+    response.codec = static_cast<uint8_t>(codec);
+}
+
+template <typename Stream>
+void StreamSession<Stream>::onResponse(Completion completion)
+{
+    if (completion.response.more && onIoThread())
+    {
+        // An inline facade streams on the io thread itself, which is the one
+        // that drains m_completions and completes writes: waiting for either
+        // would never end. Queue the part for writing straight away; it is
+        // unpaced, but still bounded by maxQueuedBytes like any reply.
+        enqueueWrite(framing::encodeResponseFrame(completion.response));
+        return;
+    }
+    if (completion.response.more)
+    {
+        // Pace the stream: hold the worker while the client is behind, and
+        // never take the direct-post path, which could reorder the parts.
+        while (!m_closed.load(std::memory_order_relaxed)
+               && ((m_streamHighWater > 0 && queuedBytes() > m_streamHighWater)
+                   || !m_completions.tryPush(std::move(completion))))
+            std::this_thread::sleep_for(kStreamBackoff);
+        if (m_closed.load(std::memory_order_relaxed))
+            return;
+    }
+    else if (!m_completions.tryPush(std::move(completion)))
+    {
+        // Queue full: hand this one over through the executor directly.
+        auto self = this->shared_from_this();
+        boost::asio::post(
+            m_socket->get_executor(),
+            [this, self, completion = std::move(completion)]() mutable {
+                if (m_closed)
+                    return;
+                enqueueWrite(framing::encodeResponseFrame(completion.response));
+                finishRequest(completion);
+            });
+        return;
+    }
+
+    if (!m_drainScheduled.exchange(true, std::memory_order_acq_rel))
+    {
+        auto self = this->shared_from_this();
+        boost::asio::post(m_socket->get_executor(), [this, self]() { drainCompletions(); });
+    }
+}
+
+template <typename Stream>
+bool StreamSession<Stream>::onIoThread() const
+{
+    auto& context = boost::asio::query(m_socket->get_executor(), boost::asio::execution::context);
+    return static_cast<boost::asio::io_context&>(context).get_executor().running_in_this_thread();
+}
+
+template <typename Stream>
+void StreamSession<Stream>::drainCompletions()
+{
+    // Clear the flag first so a completion pushed while draining schedules
+    // another drain instead of being stranded.
+    m_drainScheduled.store(false, std::memory_order_release);
+
+    Completion completion;
+    while (m_completions.tryPop(completion))
+    {
+        if (m_closed)
+            continue;
+
+        enqueueWrite(framing::encodeResponseFrame(completion.response));
+
+        // A streamed reply is pending until its last part is queued.
+        if (!completion.response.more)
+            finishRequest(completion);
+    }
+}
+
+template <typename Stream>
+void StreamSession<Stream>::finishRequest(const Completion& completion)
+{
+    timeReply(completion);
+    --m_pendingRequests;
+    if (!completion.response.hasRequestId)
+        m_lockStepPending = false;
+    resumeReading();
+}
+
+template <typename Stream>
+void StreamSession<Stream>::timeReply(const Completion& completion)
+{
+    if (m_closed || completion.receivedAt == 0)
+        return;
+    m_pendingTimings.push_back(
+        PendingTiming{m_writeQueue.repliesPushed(), completion.type, completion.receivedAt, LatencyRecorder::now()});
+}
+
+template <typename Stream>
+void StreamSession<Stream>::onWriteComplete()
+{
+    // Every final reply up to the last one taken into this write is on the wire.
+    LatencyRecorder& recorder = LatencyRecorder::instance();
+    while (!m_pendingTimings.empty() && m_pendingTimings.front().reply <= m_inFlightRepliesTaken)
+    {
+        const PendingTiming& timing = m_pendingTimings.front();
+        recorder.recordSince(timing.type, LatencyStage::SEND, timing.queuedAt);
+        recorder.recordSince(timing.type, LatencyStage::TOTAL, timing.receivedAt);
+        m_pendingTimings.pop_front();
+    }
+}
+
+// ==========================================================================
+// Write path — one async_write in flight, later frames coalesced behind it
+// ==========================================================================
+
+template <typename Stream>
+void StreamSession<Stream>::deliver(RawBuffer frame)
+{
+    auto self = this->shared_from_this();
+    boost::asio::post(
+        m_socket->get_executor(),
+        [this, self, frame = std::move(frame)]() mutable {
+            enqueueWrite(std::move(frame), FrameKind::MARKET_DATA);
+        });
+}
+
+template <typename Stream>
+void StreamSession<Stream>::deliverBatch(std::vector<RawBuffer> frames)
+{
+    auto self = this->shared_from_this();
+    boost::asio::post(
+        m_socket->get_executor(),
+        [this, self, frames = std::move(frames)]() mutable {
+            if (m_closed)
+                return;
+            for (auto& frame : frames)
+            {
+                if (!queueFrame(std::move(frame), FrameKind::MARKET_DATA))
+                    return;
+            }
+            startWrite();
+        });
+}
+
+template <typename Stream>
+void StreamSession<Stream>::publish(std::vector<Response>             messages,
+                                    ISessionPublisher::DrainedHandler onDrained)
+{
+    auto self = this->shared_from_this();
+    boost::asio::post(
+        m_socket->get_executor(),
+        [this, self, messages = std::move(messages), onDrained = std::move(onDrained)]() mutable {
+            if (m_closed)
+                return;
+            for (const auto& message : messages)
+            {
+                if (!queueFrame(framing::encodeResponseFrame(message), FrameKind::MARKET_DATA))
+                    return;
+            }
+            if (onDrained)
+                m_drainedHandlers.push_back(std::move(onDrained));
+            startWrite();
+        });
+}
+
+template <typename Stream>
+void StreamSession<Stream>::enqueueWrite(RawBuffer frame, FrameKind kind)
+{
+    if (m_closed)
+        return;
+
+    if (queueFrame(std::move(frame), kind))
+        startWrite();
+}
+
+template <typename Stream>
+bool StreamSession<Stream>::queueFrame(RawBuffer frame, FrameKind kind)
+{
+    const uint64_t droppedBefore = m_writeQueue.droppedFrames();
+    const bool     accepted      = m_writeQueue.push(std::move(frame), kind);
+
+    const uint64_t dropped = m_writeQueue.droppedFrames() - droppedBefore;
+    if (dropped != 0 && m_counters)
+        m_counters->droppedFrames.fetch_add(dropped, std::memory_order_relaxed);
+
+    if (!accepted)
+    {
+        HFT_LOG_WARN("[session {}] slow consumer: {} frames / {} bytes queued — disconnecting",
+                     m_id, m_writeQueue.pendingFrames(), m_writeQueue.pendingBytes());
+        if (m_counters)
+            m_counters->slowConsumerDisconnects.fetch_add(1, std::memory_order_relaxed);
+        shutdown(boost::asio::error::no_buffer_space);
+        return false;
+    }
+
+    publishDepth();
+    return true;
+}
+
+template <typename Stream>
+void StreamSession<Stream>::publishDepth()
+{
+    m_queuedFrames.store(m_writeQueue.pendingFrames(), std::memory_order_relaxed);
+    m_queuedBytes.store(m_writeQueue.pendingBytes(), std::memory_order_relaxed);
+}
+
+template <typename Stream>
+void StreamSession<Stream>::startWrite()
+{
+    if (!m_writing)
+        doWrite();
+}
+
+template <typename Stream>
+void StreamSession<Stream>::doWrite()
+{
+    if (!m_writeQueue.next(m_inFlight))
+    {
+        m_writing = false;
+
+        // Swap out first: a handler may publish again, which only posts.
+        std::vector<ISessionPublisher::DrainedHandler> drained;
+        drained.swap(m_drainedHandlers);
+        for (auto& handler : drained)
+            handler();
+        return;
+    }
+    m_writing              = true;
+    m_inFlightRepliesTaken = m_writeQueue.repliesTaken();
+    publishDepth();
+
+    auto self    = this->shared_from_this();
+    auto handler = [this, self](const boost::system::error_code& ec, std::size_t written)
+    {
+        bump(m_bytesOut, written);
+        m_inFlight.clear();
+        if (ec || m_closed)
+        {
+            shutdown(ec);
+            return;
+        }
+
+        onWriteComplete();
+        doWrite();
+    };
+    // Const access: the frame may be shared with other sessions.
+    const auto buffer = boost::asio::buffer(std::as_const(m_inFlight).data(), m_inFlight.size());
+    if constexpr (kIsTls<Stream>)
+    {
+        if (m_kernelTls)
+        {
+            boost::asio::async_write(m_socket->next_layer(), buffer, std::move(handler));
+            return;
+        }
+    }
+    boost::asio::async_write(*m_socket, buffer, std::move(handler));
+}
+
+template <typename Stream>
+bool StreamSession<Stream>::writeKeyStale()
+{
+    if constexpr (kIsTls<Stream>)
+    {
+        if (!m_kernelTls || !ktls::keyUpdateReceived(m_socket->native_handle()))
+            return false;
+        HFT_LOG_WARN("[session {}] client rotated its TLS keys; kernel TLS cannot follow", m_id);
+        return true;
+    }
+    return false;
+}
+
+// ==========================================================================
+// Teardown
+// ==========================================================================
+
+template <typename Stream>
+void StreamSession<Stream>::close()
+{
+    auto self = this->shared_from_this();
+    boost::asio::post(m_socket->get_executor(), [this, self]() {
+        shutdown(boost::asio::error::operation_aborted);
+    });
+}
+
+template <typename Stream>
+void StreamSession<Stream>::shutdown(const boost::system::error_code& ec)
+{
+    if (m_closed.exchange(true))
+        return;
+
+    if (ec == boost::asio::error::eof || ec == boost::asio::ssl::error::stream_truncated)
+        HFT_LOG_INFO("[session {}] client disconnected", m_id);
+    else if (ec != boost::asio::error::operation_aborted)
+        HFT_LOG_WARN("[session {}] closing: {}", m_id, ec.message());
+
+    boost::system::error_code ignored;
+    m_socket->lowest_layer().cancel(ignored);
+    m_socket->lowest_layer().close(ignored);
+    m_writeQueue.clear();
+    m_drainedHandlers.clear();
+    m_pendingTimings.clear();
+    publishDepth();
+
+    if (m_onClose)
+        m_onClose(m_id);
+}
+
+// ==========================================================================
+// Instantiations — one per transport
+// ==========================================================================
+
+template class StreamSession<SslStream>;
+template class StreamSession<boost::asio::ip::tcp::socket>;
+template class StreamSession<boost::asio::local::stream_protocol::socket>;
@@ -0,0 +1,290 @@
+/**
+ * @file StreamSession.hpp
+ * @brief One connected client and its async read/write loop.
+ *
+ * @details Each accepted connection owns a StreamSession over its stream
+ * type: SslSession for a handshaked TLS connection, TcpSession and
+ * UnixSession for the plain transports (see PlainStreamTransport.hpp). The
+ * framing, dispatch, queueing and pacing below are the same for all three;
+ * only the TLS session knows about kernel TLS. The session reads
+ * length-prefixed frames with async_read, decodes them into a Request and
+ * hands them to IServerFacade::handleRequestAsync(). The response may be
+ * produced on a worker thread; it is pushed into the session's lock-free
+ * completion queue and drained on the io_context, where it is written back
+ * with async_write. All socket operations for a session run on its
+ * io_context, so no mutex is shared between clients.
+ *
+ * Outbound frames queue in a WriteCoalescer while a write is in flight and
+ * are merged into a single write when it completes. Pushed messages queued
+ * with publish() share that queue; their drained handlers run once it is
+ * empty again.
+ *
+ * The queue is bounded by TransportConfig::maxQueuedBytes/maxQueuedFrames.
+ * Broadcast and pushed frames are market data: when the queue is full the
+ * oldest of them are dropped. Replies are never dropped; if they alone
+ * overflow the queue, the client is too slow and is disconnected.
+ *
+ * A request without an id is answered in lock-step: the next frame is read
+ * once its reply has been queued. A request with an id (see FrameCodec.hpp)
+ * is pipelined: the next frame is read straight away, up to
+ * TransportConfig::maxPipelinedRequests in flight, and each reply is
+ * written, tagged with its id, as soon as its worker finishes. A streamed
+ * reply counts as one response: it leaves the in-flight count with its last
+ * part. Each part waits on the worker thread until less than half of
+ * maxQueuedBytes is queued, so a long stream is paced by the client instead
+ * of piling up in memory. A facade that streams inline, on the io thread,
+ * cannot be paced (the writes it would wait for run on that thread): its
+ * parts are queued as they come, and a stream larger than maxQueuedBytes
+ * disconnects the client as too slow.
+ *
+ * A reply whose data reaches TransportConfig::compressMinBytes is compressed
+ * on its worker thread, with a codec the request accepts (see
+ * PayloadCompression.hpp). The session's compressor, and so its codec
+ * contexts, is reused by all of its replies.
+ *
+ * Each request is timed into LatencyRecorder: DECODE when it is dispatched,
+ * SEND and TOTAL when the write carrying its final reply completes.
+ *
+ * A kernel TLS session writes its frames in plaintext to the TCP socket and
+ * the kernel encrypts them; reads still go through the SSL stream.
+ */
+
+#ifndef STREAMSESSION_HPP
+#define STREAMSESSION_HPP
+
+#include "concurrency/BoundedMpmcQueue.hpp"
+#include "server/IServerFacade.hpp"
+#include "transport/ISessionPublisher.hpp"
+#include "transport/ITransport.hpp"
+#include "TransportConfig.hpp"
+#include "transport/TransportStats.hpp"
+#include "PayloadCompression.hpp"
+#include "TransportSession.hpp"
+#include "WriteCoalescer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+/// Connected TLS stream of an SslSession.
+using SslStream = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
+
+/// A reply handed back by a worker, with the request it answers. Declared
+/// outside StreamSession so BoundedMpmcQueue sees a complete type.
+struct SessionCompletion
+{
+    Response    response;
+    RequestType type{RequestType::GET_MARKET_DATA};
+    int64_t     receivedAt{0};
+};
+
+/**
+ * @class StreamSession
+ * @brief Per-connection read → dispatch → write loop over a connected stream.
+ *
+ * @tparam Stream SslStream, boost::asio::ip::tcp::socket or
+ *                boost::asio::local::stream_protocol::socket; instantiated
+ *                for those three in StreamSession.cpp.
+ *
+ * Sessions are always owned through std::shared_ptr; every pending async
+ * operation holds a reference, so the session lives exactly as long as the
+ * connection has outstanding work.
+ */
+template <typename Stream>
+class StreamSession final : public TransportSession, public std::enable_shared_from_this<StreamSession<Stream>>
+{
+public:
+    /// Invoked once when the session has shut down its socket.
+    using CloseHandler = std::function<void(uint64_t sessionId)>;
+
+    /**
+     * @brief Construct a session around a connected (and handshaked) stream.
+     * @param id      Transport-unique session identifier.
+     * @param socket  The connected stream.
+     * @param facade  Server entry point that executes decoded requests.
+     * @param onClose Called after the socket has been closed.
+     * @param config   Transport options (write coalescing and queue limits).
+     * @param counters Backpressure counters shared with the transport; may be null.
+     * @param kernelTls True if the kernel encrypts this socket's outbound
+     *                  records; frames are then written to the TCP socket.
+     *                  Only meaningful for an SslStream.
+     */
+    StreamSession(uint64_t                           id,
+                  std::shared_ptr<Stream>            socket,
+                  std::shared_ptr<IServerFacade>     facade,
+                  CloseHandler                       onClose,
+                  const TransportConfig&             config   = {},
+                  std::shared_ptr<TransportCounters> counters  = nullptr,
+                  bool                               kernelTls = false);
+
+    /// @brief Begin reading frames from the client.
+    void start() override;
+
+    /**
+     * @brief Queue an already-framed buffer for writing to this client.
+     * @param frame Length prefix and payload in one contiguous buffer.
+     *
+     * Safe to call from any thread: the write is posted to the io_context.
+     */
+    void deliver(RawBuffer frame) override;
+
+    /**
+     * @brief Queue several framed buffers with a single post.
+     * @param frames Frames in send order; merged into as few writes as fit.
+     */
+    void deliverBatch(std::vector<RawBuffer> frames) override;
+
+    /**
+     * @brief Encode and queue pushed responses with a single post.
+     * @param messages  Responses to send, in order.
+     * @param onDrained Run on the io_context once the write queue is empty;
+     *                  dropped if the session closes first.
+     */
+    void publish(std::vector<Response> messages, ISessionPublisher::DrainedHandler onDrained) override;
+
+    /// @brief Close the connection; safe to call from any thread.
+    void close() override;
+
+    /// @brief Transport-unique session identifier.
+    uint64_t id() const override { return m_id; }
+
+    /// @brief Frames waiting behind the in-flight write; safe from any thread.
+    std::size_t queuedFrames() const override { return m_queuedFrames.load(std::memory_order_relaxed); }
+
+    /// @brief Bytes waiting behind the in-flight write; safe from any thread.
+    std::size_t queuedBytes() const override { return m_queuedBytes.load(std::memory_order_relaxed); }
+
+    /// @brief Throughput and queue depth so far; safe from any thread.
+    SessionStats stats() const override;
+
+private:
+    using Completion = SessionCompletion;
+
+    /// Final reply queued but not yet written, timed when its write completes.
+    struct PendingTiming
+    {
+        uint64_t    reply{0}; ///< WriteCoalescer::repliesPushed() once queued.
+        RequestType type{RequestType::GET_MARKET_DATA};
+        int64_t     receivedAt{0};
+        int64_t     queuedAt{0};
+    };
+
+    void doReadHeader();
+    void doReadPayload(uint32_t payloadLen);
+    void dispatch();
+    void resumeReading();
+    void compressReply(Response& response, RequestType type, uint8_t acceptCodecs);
+    void onResponse(Completion completion);
+    /// True on a thread running the session's io_context.
+    bool onIoThread() const;
+    void finishRequest(const Completion& completion);
+    void drainCompletions();
+    void enqueueWrite(RawBuffer frame, FrameKind kind = FrameKind::REPLY);
+    bool queueFrame(RawBuffer frame, FrameKind kind);
+    void publishDepth();
+    void startWrite();
+    void doWrite();
+    void timeReply(const Completion& completion);
+    void onWriteComplete();
+    bool writeKeyStale();
+    void shutdown(const boost::system::error_code& ec);
+
+    uint64_t                       m_id;
+    std::shared_ptr<Stream>        m_socket;
+    std::shared_ptr<IServerFacade> m_facade;
+    CloseHandler                   m_onClose;
+    std::shared_ptr<TransportCounters> m_counters;
+
+    /// Outbound records are encrypted by the kernel (kTLS), not OpenSSL.
+    bool m_kernelTls;
+
+    /// Length prefix of the frame currently being read.
+    std::array<uint8_t, 4> m_header{};
+
+    /// Payload of the frame currently being read.
+    RawBuffer m_payload;
+
+    /// Frames waiting to be written behind the one in flight.
+    WriteCoalescer m_writeQueue;
+
+    /// Buffer currently being written; kept alive until the write completes.
+    RawBuffer m_inFlight;
+
+    bool m_writing{false};
+
+    /// Mirrors of the write queue depth for readers on other threads.
+    std::atomic<std::size_t> m_queuedFrames{0};
+    std::atomic<std::size_t> m_queuedBytes{0};
+
+    /// Throughput; written only on the io_context, read by stats().
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_bytesIn{0};
+    std::atomic<uint64_t> m_bytesOut{0};
+
+    /// publish() handlers waiting for the write queue to empty.
+    std::vector<ISessionPublisher::DrainedHandler> m_drainedHandlers;
+
+    /// Responses handed back by worker threads, drained on the io_context.
+    BoundedMpmcQueue<Completion> m_completions;
+
+    /// Set while a drainCompletions() call is posted but has not yet run.
+    std::atomic<bool> m_drainScheduled{false};
+
+    /// Queued bytes above which a streamed part waits on its worker (0 = never).
+    std::size_t m_streamHighWater;
+
+    /// Requests dispatched whose final reply has not been queued yet.
+    std::size_t m_pendingRequests{0};
+
+    /// Limit on m_pendingRequests before reading stops (at least 1).
+    std::size_t m_maxPipelined;
+
+    /// A request without an id is pending; nothing is read until it is answered.
+    bool m_lockStepPending{false};
+
+    /// No read is outstanding; resumeReading() starts one when allowed.
+    bool m_readPaused{false};
+
+    /// Replies with at least this many data bytes are compressed (0 = never).
+    std::size_t m_compressMinBytes;
+
+    /// Codecs the server may use, limited to those compiled in.
+    uint8_t m_compressionCodecs;
+
+    /// Codec contexts shared by the session's workers, one reply at a time.
+    std::mutex                     m_compressorMutex;
+    compression::PayloadCompressor m_compressor;
+
+    /// Final replies in the write queue, in queue order.
+    std::deque<PendingTiming> m_pendingTimings;
+
+    /// WriteCoalescer::repliesTaken() once the in-flight write was taken.
+    uint64_t m_inFlightRepliesTaken{0};
+
+    /// Set once by shutdown(); also read by workers pacing a stream.
+    std::atomic<bool> m_closed{false};
+};
+
+extern template class StreamSession<SslStream>;
+extern template class StreamSession<boost::asio::ip::tcp::socket>;
+extern template class StreamSession<boost::asio::local::stream_protocol::socket>;
+
+/// Session of a handshaked TLS connection (BoostAsioSslTransport).
+using SslSession = StreamSession<SslStream>;
+
+/// Session of a plain TCP connection (TcpTransport).
+using TcpSession = StreamSession<boost::asio::ip::tcp::socket>;
+
+/// Session of a Unix domain socket connection (UnixSocketTransport).
+using UnixSession = StreamSession<boost::asio::local::stream_protocol::socket>;
+
+#endif // STREAMSESSION_HPP
@@ -0,0 +1,87 @@
+/**
+ * @file TransportConfig.hpp
+ * @brief Tunables shared by the socket-based ITransport implementations.
+ *
+ * @details Grouped into a single aggregate so that new options can be added
+ * without changing every transport constructor. All members have defaults
+ * that reproduce the behaviour of a single-threaded server.
+ */
+
+#ifndef TRANSPORTCONFIG_HPP
+#define TRANSPORTCONFIG_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct TransportConfig
+ * @brief Threading and tuning options for a transport instance.
+ */
+struct TransportConfig
+{
+    /// @brief Number of io_context threads (one io_context per thread).
+    std::size_t ioThreads{1};
+
+    /// @brief Pin io thread i to CPU (i mod hardware_concurrency) when true.
+    bool pinCpus{false};
+
+    /// @brief io threads spin on their context instead of sleeping until a socket is ready.
+    /// @details Each io thread then keeps a core busy; pair with pinCpus.
+    bool busyPoll{false};
+
+    /// @brief Disable Nagle's algorithm on TCP connections (TLS and plain).
+    bool tcpNoDelay{true};
+
+    /// @brief SO_BUSY_POLL of TCP connections in microseconds (0 = kernel default).
+    /// @details The kernel polls the NIC queue on reads instead of waiting
+    ///          for its interrupt; raising it above net.core.busy_read
+    ///          needs CAP_NET_ADMIN.
+    unsigned socketBusyPollMicros{0};
+
+    /// @brief Upper bound in bytes on frames merged into one socket write.
+    std::size_t maxCoalescedBytes{16 * 1024};
+
+    /// @brief Per-session limit on queued outbound bytes (0 = unbounded).
+    /// @details Over the limit, the oldest market data frames are dropped;
+    ///          a session whose replies alone exceed it is disconnected.
+    std::size_t maxQueuedBytes{4 * 1024 * 1024};
+
+    /// @brief Per-session limit on queued outbound frames (0 = unbounded).
+    std::size_t maxQueuedFrames{8192};
+
+    /// @brief Threads that run TLS handshakes (0 = on the connection's io thread).
+    /// @details Connected sessions then never wait behind a handshake.
+    std::size_t handshakeThreads{1};
+
+    /// @brief Lifetime of resumable TLS sessions, cached or ticketed (0 = no resumption).
+    std::chrono::seconds tlsSessionLifetime{3600};
+
+    /// @brief TLS sessions kept in the server-side cache.
+    std::size_t tlsSessionCacheSize{20 * 1024};
+
+    /// @brief Hand TLS 1.3 record encryption of outbound data to the kernel (Linux kTLS).
+    /// @details Connections the kernel cannot take keep encrypting in user space.
+    bool kernelTls{false};
+
+    /// @brief Requests with an id a session may have in flight before it stops reading.
+    /// @details Requests without an id are always answered one at a time.
+    std::size_t maxPipelinedRequests{64};
+
+    /// @brief Replies with at least this many data bytes are compressed (0 = never).
+    /// @details Only with a codec the request lists as accepted.
+    std::size_t compressMinBytes{64 * 1024};
+
+    /// @brief Codecs the server may compress with (a compression::codecBit() set).
+    /// @details Defaults to all of them; codecs this build lacks are ignored.
+    uint8_t compressionCodecs{0x07};
+
+    /// @brief Shared-memory sessions spin on their rings instead of sleeping on a futex.
+    /// @details Lowest latency, at the cost of one busy core per attached client.
+    bool shmBusySpin{false};
+
+    // TODO: EXTEND — Add new transport options here (e.g., buffer sizes,
+    //               queue limits) and read them in the transport constructor.
+};
+
+#endif // TRANSPORTCONFIG_HPP
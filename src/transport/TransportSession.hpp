@@ -0,0 +1,62 @@
+/**
+ * @file TransportSession.hpp
+ * @brief What a transport needs from one of its connected sessions.
+ *
+ * @details StreamSession implements this for every stream type (TLS, plain
+ * TCP, Unix domain socket) and ShmSession for shared-memory rings, so
+ * SessionTransport keeps a single table of live sessions and fans
+ * broadcasts out to them without knowing how each one is connected.
+ */
+
+#ifndef TRANSPORTSESSION_HPP
+#define TRANSPORTSESSION_HPP
+
+#include "transport/ISessionPublisher.hpp"
+#include "transport/ITransport.hpp"
+#include "transport/TransportStats.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class TransportSession
+ * @brief Connected client as seen by its transport.
+ *
+ * Every method is safe to call from any thread; the work is posted to the
+ * session's io_context.
+ */
+class TransportSession
+{
+public:
+    virtual ~TransportSession() = default;
+
+    /// @brief Begin reading frames from the client; call on the session's io_context.
+    virtual void start() = 0;
+
+    /// @brief Queue an already-framed market data buffer.
+    virtual void deliver(RawBuffer frame) = 0;
+
+    /// @brief Queue several framed market data buffers with a single post.
+    virtual void deliverBatch(std::vector<RawBuffer> frames) = 0;
+
+    /// @brief Encode and queue pushed responses; see ISessionPublisher::publish().
+    virtual void publish(std::vector<Response> messages, ISessionPublisher::DrainedHandler onDrained) = 0;
+
+    /// @brief Close the connection.
+    virtual void close() = 0;
+
+    /// @brief Transport-unique session identifier.
+    virtual uint64_t id() const = 0;
+
+    /// @brief Frames waiting behind the in-flight write.
+    virtual std::size_t queuedFrames() const = 0;
+
+    /// @brief Bytes waiting behind the in-flight write.
+    virtual std::size_t queuedBytes() const = 0;
+
+    /// @brief Throughput and queue depth so far.
+    virtual SessionStats stats() const = 0;
+};
+
+#endif // TRANSPORTSESSION_HPP
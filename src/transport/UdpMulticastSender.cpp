@@ -0,0 +1,66 @@
+/**
+ * @file UdpMulticastSender.cpp
+ * @brief Implementation of UdpMulticastSender.
+ */
+
+#include "UdpMulticastSender.hpp"
+
+#include "logging/Log.hpp"
+
+// ==========================================================================
+// Constructor — open, configure
+// ==========================================================================
+
+UdpMulticastSender::UdpMulticastSender(const MulticastConfig& config)
+    : m_socket(m_io)
+    , m_destination(boost::asio::ip::make_address(config.group), config.port)
+{
+    namespace mc = boost::asio::ip::multicast;
+
+    const boost::asio::ip::address& group = m_destination.address();
+    m_socket.open(m_destination.protocol());
+    m_socket.non_blocking(true);
+
+    if (group.is_multicast())
+    {
+        m_socket.set_option(mc::hops(config.ttl));
+        m_socket.set_option(mc::enable_loopback(config.loopback));
+        if (!config.interfaceAddress.empty() && group.is_v4())
+            m_socket.set_option(mc::outbound_interface(boost::asio::ip::make_address_v4(config.interfaceAddress)));
+    }
+
+    HFT_LOG_INFO("[transport] Sending datagrams to udp:{}:{}{}", group.to_string(), m_destination.port(),
+                 group.is_multicast() ? " (multicast)" : "");
+}
+
+// ==========================================================================
+// sendDatagram() — one send_to, never waits
+// ==========================================================================
+
+bool UdpMulticastSender::sendDatagram(const uint8_t* data, std::size_t size)
+{
+    boost::system::error_code ec;
+    {
+        const std::lock_guard<std::mutex> lock(m_sendMutex);
+        m_socket.send_to(boost::asio::buffer(data, size), m_destination, 0, ec);
+    }
+
+    if (ec)
+    {
+        // Logged once: a persistent failure (no route, full buffer) would flood the log.
+        if (m_errors.fetch_add(1, std::memory_order_relaxed) == 0)
+            HFT_LOG_WARN("[transport] datagram to {}:{} dropped: {}", m_destination.address().to_string(),
+                         m_destination.port(), ec.message());
+        return false;
+    }
+
+    m_datagrams.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+DatagramSenderStats UdpMulticastSender::stats() const
+{
+    return DatagramSenderStats{m_datagrams.load(std::memory_order_relaxed), m_bytes.load(std::memory_order_relaxed),
+                               m_errors.load(std::memory_order_relaxed)};
+}
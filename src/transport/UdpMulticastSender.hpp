@@ -0,0 +1,84 @@
+/**
+ * @file UdpMulticastSender.hpp
+ * @brief IDatagramPublisher over a UDP socket, normally sending to a multicast group.
+ *
+ * @details The socket is connectionless and non-blocking: a datagram the
+ * kernel cannot queue right away (a full send buffer) is dropped and
+ * counted, never waited for. Receivers see the loss as a sequence gap.
+ *
+ * For a multicast group (224.0.0.0/4 or ff00::/8) the TTL, loopback and,
+ * for IPv4, the outgoing interface are applied. A unicast destination is
+ * accepted too, e.g. a single receiver on the same host in tests.
+ */
+
+#ifndef UDPMULTICASTSENDER_HPP
+#define UDPMULTICASTSENDER_HPP
+
+#include "transport/IDatagramPublisher.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <boost/asio.hpp>
+
+/**
+ * @struct MulticastConfig
+ * @brief Destination and socket options of a UdpMulticastSender.
+ */
+struct MulticastConfig
+{
+    std::string group{"239.255.0.1"}; ///< Destination address; administratively scoped by default.
+    uint16_t    port{30001};          ///< Destination port.
+    std::string interfaceAddress;     ///< IPv4 address of the outgoing interface (empty = routing table).
+    int         ttl{1};               ///< Multicast hops; 1 keeps datagrams on the local network.
+    bool        loopback{true};       ///< Deliver to receivers on this host as well.
+};
+
+/**
+ * @struct DatagramSenderStats
+ * @brief Counters of a UdpMulticastSender.
+ */
+struct DatagramSenderStats
+{
+    uint64_t datagrams{0}; ///< Datagrams sent.
+    uint64_t bytes{0};     ///< Bytes of those datagrams.
+    uint64_t errors{0};    ///< Datagrams dropped because the send failed.
+};
+
+/**
+ * @class UdpMulticastSender
+ * @brief Non-blocking, thread-safe datagram sender to one UDP destination.
+ */
+class UdpMulticastSender final : public IDatagramPublisher
+{
+public:
+    /**
+     * @brief Open the socket and apply the multicast options.
+     * @throws boost::system::system_error if an address does not parse or an option is refused.
+     */
+    explicit UdpMulticastSender(const MulticastConfig& config);
+
+    /// @copydoc IDatagramPublisher::sendDatagram
+    bool sendDatagram(const uint8_t* data, std::size_t size) override;
+
+    /// @brief Where datagrams are sent.
+    const boost::asio::ip::udp::endpoint& destination() const { return m_destination; }
+
+    /// @brief Snapshot of the counters.
+    DatagramSenderStats stats() const;
+
+private:
+    boost::asio::io_context        m_io;
+    boost::asio::ip::udp::socket   m_socket;
+    boost::asio::ip::udp::endpoint m_destination;
+    std::mutex                     m_sendMutex;
+
+    std::atomic<uint64_t> m_datagrams{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_errors{0};
+};
+
+#endif // UDPMULTICASTSENDER_HPP
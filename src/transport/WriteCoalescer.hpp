@@ -0,0 +1,223 @@
+/**
+ * @file WriteCoalescer.hpp
+ * @brief Per-connection outbound frame queue that merges small frames.
+ *
+ * @details While one write is in flight, frames pile up here. When it
+ * completes, next() merges every queued frame that fits within the
+ * coalescing limit into one contiguous pooled buffer. That buffer goes out
+ * in a single write, which over TLS is a single record and a single
+ * syscall. A merge is needed because an SSL stream encrypts only the first
+ * buffer of a gather list per record, so scatter/gather alone does not
+ * reduce the record count. A lone frame, or one at least as large as the
+ * limit, is passed through as-is without a copy.
+ *
+ * The queue can be bounded in bytes and frames so that a stalled client
+ * cannot grow memory without limit. Frames are tagged with a FrameKind.
+ * When a push exceeds a limit, the oldest MARKET_DATA frames are dropped
+ * first, since a later snapshot supersedes them. If the queue is still over
+ * its limit with only replies left, push() returns false and the owner
+ * disconnects the client: a reply cannot be lost without breaking the
+ * request/response protocol.
+ *
+ * Free of Boost.Asio so that it can be shared by every stream-based
+ * transport and unit-tested directly.
+ */
+
+#ifndef WRITECOALESCER_HPP
+#define WRITECOALESCER_HPP
+
+#include "transport/ITransport.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+
+/// @brief Overflow policy class of a queued frame.
+enum class FrameKind : uint8_t
+{
+    REPLY,       ///< Answer to a request; never dropped.
+    MARKET_DATA, ///< Pushed or broadcast update; the oldest is dropped first.
+};
+
+/**
+ * @class WriteCoalescer
+ * @brief FIFO of encoded frames with batching into write-sized chunks.
+ *
+ * Not thread-safe: owned by one session and used on its io_context only.
+ */
+class WriteCoalescer
+{
+public:
+    /// Largest TLS record plaintext; also a sensible default write size.
+    static constexpr std::size_t kDefaultMaxBytes = 16 * 1024;
+
+    /**
+     * @param maxBytes        Upper bound on a merged write. 0 or 1 disables merging.
+     * @param maxQueuedBytes  Limit on pending bytes; 0 means unbounded.
+     * @param maxQueuedFrames Limit on pending frames; 0 means unbounded.
+     */
+    explicit WriteCoalescer(std::size_t maxBytes        = kDefaultMaxBytes,
+                            std::size_t maxQueuedBytes  = 0,
+                            std::size_t maxQueuedFrames = 0)
+        : m_maxBytes(maxBytes)
+        , m_maxQueuedBytes(maxQueuedBytes)
+        , m_maxQueuedFrames(maxQueuedFrames)
+    {
+    }
+
+    /**
+     * @brief Queue one encoded frame behind any already pending.
+     * @param frame Encoded frame.
+     * @param kind  Overflow policy for this frame.
+     * @return false if the queue is over its limits and no MARKET_DATA frame
+     *         is left to drop; the frame stays queued either way.
+     */
+    bool push(RawBuffer frame, FrameKind kind = FrameKind::REPLY)
+    {
+        m_pendingBytes += frame.size();
+        m_pending.push_back(Entry{std::move(frame), kind});
+        if (kind == FrameKind::MARKET_DATA)
+            ++m_droppable;
+        else
+            ++m_repliesPushed;
+
+        while (overLimit())
+        {
+            if (!dropOldestMarketData())
+                return false;
+        }
+        if (m_pendingBytes > m_highWaterBytes)
+            m_highWaterBytes = m_pendingBytes;
+        return true;
+    }
+
+    /**
+     * @brief Take the next chunk to write, merging small frames.
+     * @param out Receives the frame or the merged frames.
+     * @return false if nothing is pending.
+     */
+    bool next(RawBuffer& out)
+    {
+        if (m_pending.empty())
+            return false;
+
+        // Count the leading frames that fit within the limit together.
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        for (const auto& entry : m_pending)
+        {
+            if (count > 0 && bytes + entry.frame.size() > m_maxBytes)
+                break;
+            bytes += entry.frame.size();
+            ++count;
+            if (bytes >= m_maxBytes)
+                break;
+        }
+
+        if (count == 1)
+        {
+            out = std::move(m_pending.front().frame);
+            popFront();
+        }
+        else
+        {
+            out = RawBuffer::uninitialized(bytes);
+            uint8_t* dst = out.data();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const RawBuffer& frame = m_pending.front().frame;
+                if (!frame.empty())
+                    std::memcpy(dst, frame.data(), frame.size());
+                dst += frame.size();
+                popFront();
+            }
+            ++m_mergedWrites;
+        }
+
+        m_pendingBytes -= out.size();
+        return true;
+    }
+
+    /// @brief Drop everything still queued (used on disconnect).
+    void clear()
+    {
+        m_pending.clear();
+        m_pendingBytes = 0;
+        m_droppable    = 0;
+    }
+
+    bool        empty() const { return m_pending.empty(); }
+    std::size_t pendingFrames() const { return m_pending.size(); }
+    std::size_t pendingBytes() const { return m_pendingBytes; }
+
+    /// @brief Largest pendingBytes() seen after a successful push.
+    std::size_t highWaterBytes() const { return m_highWaterBytes; }
+
+    /// @brief Number of writes produced by merging two or more frames.
+    uint64_t mergedWrites() const { return m_mergedWrites; }
+
+    /// @brief MARKET_DATA frames discarded to stay within the limits.
+    uint64_t droppedFrames() const { return m_droppedFrames; }
+
+    /// @brief REPLY frames ever pushed; the n-th reply is taken once repliesTaken() reaches n.
+    uint64_t repliesPushed() const { return m_repliesPushed; }
+
+    /// @brief REPLY frames handed out by next() so far (clear() does not count).
+    uint64_t repliesTaken() const { return m_repliesTaken; }
+
+private:
+    struct Entry
+    {
+        RawBuffer frame;
+        FrameKind kind;
+    };
+
+    bool overLimit() const
+    {
+        return (m_maxQueuedBytes != 0 && m_pendingBytes > m_maxQueuedBytes)
+            || (m_maxQueuedFrames != 0 && m_pending.size() > m_maxQueuedFrames);
+    }
+
+    bool dropOldestMarketData()
+    {
+        if (m_droppable == 0)
+            return false;
+
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it)
+        {
+            if (it->kind != FrameKind::MARKET_DATA)
+                continue;
+            m_pendingBytes -= it->frame.size();
+            --m_droppable;
+            ++m_droppedFrames;
+            m_pending.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    void popFront()
+    {
+        if (m_pending.front().kind == FrameKind::MARKET_DATA)
+            --m_droppable;
+        else
+            ++m_repliesTaken;
+        m_pending.pop_front();
+    }
+
+    std::deque<Entry> m_pending;
+    std::size_t       m_maxBytes;
+    std::size_t       m_maxQueuedBytes;
+    std::size_t       m_maxQueuedFrames;
+    std::size_t       m_pendingBytes{0};
+    std::size_t       m_highWaterBytes{0};
+    std::size_t       m_droppable{0}; ///< Queued MARKET_DATA frames.
+    uint64_t          m_mergedWrites{0};
+    uint64_t          m_droppedFrames{0};
+    uint64_t          m_repliesPushed{0};
+    uint64_t          m_repliesTaken{0};
+};
+
+#endif // WRITECOALESCER_HPP
@@ -44,7 +44,9 @@ WHEN("^I send a GENERATE_REPORT request for report type \"([^\"]*)\" "
     // TODO: IMPLEMENT — Build a ReportRequest{reportType, dateFrom, dateTo},
     //                   invoke the report service or server facade, and store
     //                   the result in ctx->lastResponse.
-    ctx->lastReportRequest = ReportRequest{reportType, dateFrom, dateTo};
+    ctx->lastReportRequest = ReportRequest{reportType, {}, {}};
+    TradingDate::parseIso(dateFrom, ctx->lastReportRequest.dateFrom);
+    TradingDate::parseIso(dateTo, ctx->lastReportRequest.dateTo);
     (void)ctx;
 }
 
@@ -71,7 +73,9 @@ WHEN("^I send a GENERATE_REPORT request with dateFrom \"([^\"]*)\" "
     ScenarioScope<ReportContext> ctx;
     // TODO: IMPLEMENT — Build a ReportRequest with the provided dates and
     //                   invoke the service, expecting a validation failure.
-    ctx->lastReportRequest = ReportRequest{"EndOfDay", dateFrom, dateTo};
+    ctx->lastReportRequest = ReportRequest{"EndOfDay", {}, {}};
+    TradingDate::parseIso(dateFrom, ctx->lastReportRequest.dateFrom);
+    TradingDate::parseIso(dateTo, ctx->lastReportRequest.dateTo);
     (void)ctx;
 }
 
@@ -89,7 +93,7 @@ WHEN("^I send a GENERATE_REPORT request for report type \"([^\"]*)\"$",
     ScenarioScope<ReportContext> ctx;
     // TODO: IMPLEMENT — Build a ReportRequest with the unknown type and
     //                   invoke the service, expecting a type-not-found error.
-    ctx->lastReportRequest = ReportRequest{reportType, "", ""};
+    ctx->lastReportRequest = ReportRequest{reportType, {}, {}};
     (void)ctx;
 }
 
@@ -0,0 +1,156 @@
+/**
+ * @file test_AsyncRequest.cpp
+ * @brief Unit tests for the asyncHandleRequest() completion-token adaptor.
+ *
+ * Tests: a callback completes on the executor rather than the worker that
+ * ran the request, and keeps the io_context running until then;
+ * use_future completes; streamed parts go to onPart and only the final
+ * part completes; and, in a C++20 build, a coroutine co_awaits the reply.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AsyncRequest.hpp"
+#include "PipelinedServerFacade.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#endif
+
+namespace
+{
+    /// Answers every request; streams GENERATE_REPORT in three parts.
+    class EchoFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request&) override
+        {
+            workerThread = std::this_thread::get_id();
+            return Response{true, "done", {}};
+        }
+
+        Response handleRequestStreaming(const Request& request, const ResponseCallback& onChunk) override
+        {
+            if (request.type == RequestType::GENERATE_REPORT)
+            {
+                for (const char* part : {"part 1", "part 2"})
+                {
+                    Response chunk{true, part, {}};
+                    chunk.more = true;
+                    onChunk(std::move(chunk));
+                }
+                return Response{true, "last part", {}};
+            }
+            return handleRequest(request);
+        }
+
+        std::thread::id workerThread;
+    };
+
+    struct Fixture
+    {
+        Fixture()
+            : echo(std::make_shared<EchoFacade>())
+            , pipeline(echo, PipelineConfig{1, 16, {}})
+        {}
+
+        std::shared_ptr<EchoFacade> echo;
+        PipelinedServerFacade       pipeline;
+        boost::asio::io_context     io;
+    };
+
+    Request request(RequestType type)
+    {
+        Request req;
+        req.type = type;
+        return req;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Completion tokens
+// ---------------------------------------------------------------------------
+
+TEST(AsyncRequestTest, CallbackCompletesOnTheExecutorNotTheWorker)
+{
+    Fixture         f;
+    Response        reply;
+    std::thread::id completedOn;
+    asyncHandleRequest(f.pipeline, request(RequestType::CALCULATE), f.io.get_executor(), [&](Response response) {
+        reply       = std::move(response);
+        completedOn = std::this_thread::get_id();
+    });
+
+    // The pending request is outstanding work: run() returns after the callback, not before.
+    f.io.run();
+    EXPECT_TRUE(reply.success);
+    EXPECT_EQ(reply.message, "done");
+    EXPECT_EQ(completedOn, std::this_thread::get_id());
+    EXPECT_NE(f.echo->workerThread, std::this_thread::get_id());
+}
+
+TEST(AsyncRequestTest, UseFutureCompletes)
+{
+    Fixture     f;
+    auto        guard = boost::asio::make_work_guard(f.io);
+    std::thread runner([&f]() { f.io.run(); });
+
+    std::future<Response> reply = asyncHandleRequest(f.pipeline, request(RequestType::CALCULATE),
+                                                     f.io.get_executor(), boost::asio::use_future);
+    ASSERT_EQ(reply.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(reply.get().message, "done");
+
+    guard.reset();
+    runner.join();
+}
+
+TEST(AsyncRequestTest, StreamedPartsGoToOnPartAndTheLastCompletes)
+{
+    Fixture                  f;
+    std::vector<std::string> parts; // written on the worker, read after run()
+    Response                 reply;
+    asyncHandleRequest(
+        f.pipeline, request(RequestType::GENERATE_REPORT), f.io.get_executor(),
+        [&parts](Response part) { parts.push_back(part.message); },
+        [&reply](Response response) { reply = std::move(response); });
+
+    f.io.run();
+    EXPECT_EQ(parts, (std::vector<std::string>{"part 1", "part 2"}));
+    EXPECT_EQ(reply.message, "last part");
+    EXPECT_FALSE(reply.more);
+}
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+TEST(AsyncRequestTest, CoroutineAwaitsTheReply)
+{
+    Fixture                  f;
+    std::vector<std::string> replies;
+    boost::asio::co_spawn(
+        f.io,
+        [&]() -> boost::asio::awaitable<void> {
+            const auto executor = co_await boost::asio::this_coro::executor;
+            for (RequestType type : {RequestType::CALCULATE, RequestType::GENERATE_REPORT})
+            {
+                Response reply = co_await asyncHandleRequest(f.pipeline, request(type), executor,
+                                                             boost::asio::use_awaitable);
+                replies.push_back(reply.message);
+            }
+        },
+        boost::asio::detached);
+
+    f.io.run();
+    EXPECT_EQ(replies, (std::vector<std::string>{"done", "last part"}));
+}
+#endif
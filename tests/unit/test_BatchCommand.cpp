@@ -0,0 +1,193 @@
+/**
+ * @file test_BatchCommand.cpp
+ * @brief Unit tests for BATCH requests.
+ *
+ * Tests: sub-requests answered in item order with their data packed after
+ * the result section, per-item failures that leave the rest of the batch
+ * intact, malformed batch payloads, nested batches, and routing of BATCH
+ * through TradingServerFacade.
+ */
+
+#include <gtest/gtest.h>
+
+#include "InMemoryMarketDataService.hpp"
+#include "TradingServerFacade.hpp"
+#include "commands/BatchCommand.hpp"
+#include "commands/GetMarketDataCommand.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    SymbolPOD makeSymbol(const char* symbol)
+    {
+        SymbolPOD s{};
+        std::strncpy(s.symbol, symbol, sizeof(s.symbol) - 1);
+        return s;
+    }
+
+    struct SubRequest
+    {
+        RequestType  type;
+        PooledBuffer payload;
+    };
+
+    /// PayloadHeader + BatchItemPOD[] followed by the sub-payloads.
+    Request makeBatch(const std::vector<SubRequest>& subs)
+    {
+        std::vector<BatchItemPOD> items;
+        std::size_t               payloadBytes = 0;
+        for (const SubRequest& sub : subs)
+        {
+            items.push_back(BatchItemPOD{static_cast<uint32_t>(sub.type), static_cast<uint32_t>(sub.payload.size())});
+            payloadBytes += sub.payload.size();
+        }
+
+        Request req;
+        req.type    = RequestType::BATCH;
+        req.payload = PooledBuffer::uninitialized(pod::payloadSize<BatchItemPOD>(items.size()) + payloadBytes);
+        uint8_t* out = req.payload.data();
+        out += pod::writeArray(out, items.data(), items.size());
+        for (const SubRequest& sub : subs)
+        {
+            if (sub.payload.empty())
+                continue;
+            std::memcpy(out, sub.payload.data(), sub.payload.size());
+            out += sub.payload.size();
+        }
+        return req;
+    }
+
+    PooledBuffer symbolsPayload(const std::vector<const char*>& names)
+    {
+        std::vector<SymbolPOD> symbols;
+        for (const char* name : names)
+            symbols.push_back(makeSymbol(name));
+        return makePodPayload(symbols.data(), symbols.size());
+    }
+
+    class BatchCommandTest : public ::testing::Test
+    {
+    protected:
+        BatchCommandTest()
+            : marketData(std::make_shared<InMemoryMarketDataService>(16))
+        {
+            MarketDataPOD md{};
+            std::strcpy(md.symbol, "AAPL");
+            md.last = 190.25;
+            marketData->update(md);
+            std::strcpy(md.symbol, "MSFT");
+            md.last = 410.5;
+            marketData->update(md);
+
+            auto data = marketData;
+            registry.registerHandler(RequestType::GET_MARKET_DATA,
+                                     [data](const Request& r) { return GetMarketDataCommand::run(*data, r); });
+        }
+
+        std::shared_ptr<InMemoryMarketDataService> marketData;
+        CommandRegistry                            registry;
+    };
+
+    /// The result section and the data that follows it.
+    struct Decoded
+    {
+        PodArrayView<BatchResultPOD> results;
+        const uint8_t*               data{nullptr};
+        std::size_t                  dataBytes{0};
+    };
+
+    Decoded decode(const Response& response)
+    {
+        Decoded     d;
+        std::size_t consumed = 0;
+        EXPECT_EQ(pod::bindSection(response.data.data(), response.data.size(), d.results, consumed),
+                  PodDecodeStatus::OK);
+        d.data      = response.data.data() + consumed;
+        d.dataBytes = response.data.size() - consumed;
+        return d;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST_F(BatchCommandTest, AnswersSubRequestsInOrder)
+{
+    const Response response = BatchCommand::run(
+        registry, makeBatch({{RequestType::GET_MARKET_DATA, symbolsPayload({"MSFT"})},
+                             {RequestType::GET_MARKET_DATA, symbolsPayload({"AAPL", "MSFT"})}}));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const Decoded d = decode(response);
+    ASSERT_EQ(d.results.size(), 2u);
+    EXPECT_EQ(d.results[0].requestType, static_cast<uint32_t>(RequestType::GET_MARKET_DATA));
+    EXPECT_EQ(d.results[0].success, 1);
+    EXPECT_STREQ(d.results[0].message, "OK");
+    ASSERT_EQ(d.results[0].dataBytes, pod::payloadSize<MarketDataPOD>(1));
+    ASSERT_EQ(d.results[1].dataBytes, pod::payloadSize<MarketDataPOD>(2));
+    ASSERT_EQ(d.dataBytes, d.results[0].dataBytes + d.results[1].dataBytes);
+
+    PodArrayView<MarketDataPOD> first;
+    ASSERT_EQ(pod::bindArray(d.data, d.results[0].dataBytes, first), PodDecodeStatus::OK);
+    EXPECT_STREQ(first[0].symbol, "MSFT");
+
+    PodArrayView<MarketDataPOD> second;
+    ASSERT_EQ(pod::bindArray(d.data + d.results[0].dataBytes, d.results[1].dataBytes, second), PodDecodeStatus::OK);
+    EXPECT_STREQ(second[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(second[0].last, 190.25);
+    EXPECT_STREQ(second[1].symbol, "MSFT");
+}
+
+TEST_F(BatchCommandTest, FailedSubRequestsOnlyFailTheirOwnResult)
+{
+    const Response response = BatchCommand::run(
+        registry, makeBatch({{RequestType::GET_MARKET_DATA, symbolsPayload({"NOPE"})},
+                             {RequestType::CALCULATE, PooledBuffer{}},
+                             {RequestType::BATCH, PooledBuffer{}},
+                             {RequestType::GET_MARKET_DATA, symbolsPayload({"AAPL"})}}));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const Decoded d = decode(response);
+    ASSERT_EQ(d.results.size(), 4u);
+    EXPECT_EQ(d.results[0].success, 0);
+    EXPECT_STREQ(d.results[0].message, "MarketDataService: unknown symbol NOPE");
+    EXPECT_EQ(d.results[1].success, 0);
+    EXPECT_EQ(std::strncmp(d.results[1].message, "Unknown request type", 20), 0);
+    EXPECT_EQ(d.results[2].success, 0);
+    EXPECT_STREQ(d.results[2].message, "BatchService: BATCH cannot be nested");
+    EXPECT_EQ(d.results[3].success, 1);
+    for (std::size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(d.results[i].dataBytes, 0u);
+    EXPECT_EQ(d.dataBytes, pod::payloadSize<MarketDataPOD>(1));
+}
+
+TEST_F(BatchCommandTest, MalformedBatchFails)
+{
+    Request empty = makeBatch({});
+    EXPECT_FALSE(BatchCommand::run(registry, empty).success);
+
+    Request truncated = makeBatch({{RequestType::GET_MARKET_DATA, symbolsPayload({"AAPL"})}});
+    truncated.payload = truncated.payload.slice(0, truncated.payload.size() - 1);
+    const Response cut = BatchCommand::run(registry, truncated);
+    EXPECT_FALSE(cut.success);
+    EXPECT_EQ(cut.message, "BatchService: sub-request payloads truncated");
+
+    Request notABatch;
+    notABatch.type    = RequestType::BATCH;
+    notABatch.payload = symbolsPayload({"AAPL"});
+    EXPECT_FALSE(BatchCommand::run(registry, notABatch).success);
+}
+
+TEST_F(BatchCommandTest, FacadeServesBatchThroughItsRegistry)
+{
+    TradingServerFacade facade(marketData, nullptr, nullptr, nullptr, std::move(registry));
+    const Response      response =
+        facade.handleRequest(makeBatch({{RequestType::GET_MARKET_DATA, symbolsPayload({"AAPL"})}}));
+    ASSERT_TRUE(response.success) << response.message;
+    EXPECT_EQ(decode(response).results[0].success, 1);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file test_BoundedMpmcQueue.cpp
+ * @brief Unit tests for the lock-free bounded MPMC queue.
+ *
+ * Tests: FIFO order, capacity rounding and the full/empty conditions, and
+ * a multi-producer / multi-consumer run that must neither lose nor duplicate
+ * elements.
+ */
+
+#include <gtest/gtest.h>
+
+#include "concurrency/BoundedMpmcQueue.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(BoundedMpmcQueueTest, PopsInFifoOrder)
+{
+    BoundedMpmcQueue<int> queue(4);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryPush(3));
+
+    int value = 0;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(BoundedMpmcQueueTest, CapacityRoundsUpAndRejectsWhenFull)
+{
+    BoundedMpmcQueue<int> queue(3);
+    ASSERT_EQ(queue.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(99));
+    EXPECT_EQ(queue.sizeApprox(), 4u);
+
+    int value = 0;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(4)); // slot reusable on the next lap
+}
+
+TEST(BoundedMpmcQueueTest, ZeroCapacityThrows)
+{
+    EXPECT_THROW(BoundedMpmcQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedMpmcQueueTest, SingleElementRequestStillDetectsFull)
+{
+    BoundedMpmcQueue<int> queue(1);
+    ASSERT_EQ(queue.capacity(), 2u);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+}
+
+TEST(BoundedMpmcQueueTest, ConcurrentProducersAndConsumersSeeEveryElementOnce)
+{
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 20000;
+
+    BoundedMpmcQueue<int> queue(256);
+    std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                while (!queue.tryPush(p * kPerProducer + i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        threads.emplace_back([&]() {
+            int value = 0;
+            while (consumed.load() < kProducers * kPerProducer)
+            {
+                if (queue.tryPop(value))
+                {
+                    seen[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    for (const auto& count : seen)
+        EXPECT_EQ(count.load(), 1);
+}
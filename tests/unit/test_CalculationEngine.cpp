@@ -0,0 +1,282 @@
+/**
+ * @file test_CalculationEngine.cpp
+ * @brief Unit tests for the vectorised P&L / scenario VaR engine.
+ *
+ * Tests: SIMD kernels agree with the scalar reference, per-position P&L
+ * from cached marks, unmarked positions, historical and parametric VaR
+ * over a known scenario distribution, input validation, resident books
+ * following ticks, and ticks not waiting for a resident book's VaR run.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CalculationEngine.hpp"
+#include "RiskKernels.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    PositionPOD makePosition(const char* symbol, int64_t quantity, double avgPrice)
+    {
+        PositionPOD p{};
+        std::strncpy(p.symbol, symbol, sizeof(p.symbol) - 1);
+        p.quantity = quantity;
+        p.avgPrice = avgPrice;
+        return p;
+    }
+
+    MarketDataPOD makeSnapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+
+    Request makeRequest(const std::vector<PositionPOD>& positions)
+    {
+        Request req;
+        req.type    = RequestType::CALCULATE;
+        req.payload = makePodPayload(positions.data(), positions.size());
+        return req;
+    }
+
+    /// Both response sections; fails the test if either is malformed.
+    struct Result
+    {
+        PodArrayView<PositionPOD> positions;
+        RiskSummaryPOD            summary{};
+    };
+
+    Result decode(const Response& response)
+    {
+        Result      result;
+        std::size_t consumed = 0;
+        EXPECT_EQ(pod::bindSection(response.data.data(), response.data.size(), result.positions, consumed),
+                  PodDecodeStatus::OK);
+
+        PodView<RiskSummaryPOD> summary;
+        EXPECT_EQ(pod::bindOne(response.data.data() + consumed, response.data.size() - consumed, summary),
+                  PodDecodeStatus::OK);
+        if (summary.valid())
+            result.summary = *summary;
+        return result;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Kernels
+// ---------------------------------------------------------------------------
+
+TEST(RiskKernelsTest, DispatchedKernelsMatchScalarReference)
+{
+    // Odd length exercises the vector remainder paths.
+    const std::size_t   n = 1037;
+    std::vector<double> qty(n), avg(n), mark(n), pnl(n), pnlRef(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        qty[i]  = static_cast<double>(static_cast<int>(i % 17) - 8);
+        avg[i]  = 100.0 + 0.01 * static_cast<double>(i);
+        mark[i] = 100.5 - 0.02 * static_cast<double>(i % 29);
+    }
+
+    const double total    = risk::unrealisedPnl(qty.data(), avg.data(), mark.data(), pnl.data(), n);
+    const double totalRef = risk::scalar::unrealisedPnl(qty.data(), avg.data(), mark.data(), pnlRef.data(), n);
+    EXPECT_NEAR(total, totalRef, 1e-9 * std::fabs(totalRef) + 1e-9) << risk::activeIsa();
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_DOUBLE_EQ(pnl[i], pnlRef[i]);
+
+    EXPECT_NEAR(risk::dot(qty.data(), mark.data(), n), risk::scalar::dot(qty.data(), mark.data(), n), 1e-6);
+}
+
+// ---------------------------------------------------------------------------
+// P&L
+// ---------------------------------------------------------------------------
+
+TEST(CalculationEngineTest, MarksPositionsAtLastPrice)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(16);
+    marketData->update(makeSnapshot("AAPL", 110.0));
+    marketData->update(makeSnapshot("MSFT", 290.0));
+    CalculationEngine engine(marketData, CalculationConfig{0.99, 0});
+
+    const auto response = engine.calculate(makeRequest({makePosition("AAPL", 10, 100.0),
+                                                        makePosition("MSFT", -5, 300.0),
+                                                        makePosition("NEW", 3, 50.0)}));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const Result result = decode(response);
+    ASSERT_EQ(result.positions.size(), 3u);
+    EXPECT_STREQ(result.positions[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(result.positions[0].unrealisedPnl, 100.0);
+    EXPECT_DOUBLE_EQ(result.positions[1].unrealisedPnl, 50.0);
+    EXPECT_DOUBLE_EQ(result.positions[2].unrealisedPnl, 0.0); // unmarked → avgPrice
+
+    EXPECT_DOUBLE_EQ(result.summary.totalUnrealisedPnl, 150.0);
+    EXPECT_DOUBLE_EQ(result.summary.grossExposure, 1100.0 + 1450.0 + 150.0);
+    EXPECT_EQ(result.summary.positionCount, 3u);
+    EXPECT_EQ(result.summary.unmarkedCount, 1u);
+    EXPECT_EQ(result.summary.scenarioCount, 0u);
+    EXPECT_DOUBLE_EQ(result.summary.historicalVar, 0.0);
+}
+
+TEST(CalculationEngineTest, EmptyOrMalformedPayloadFails)
+{
+    CalculationEngine engine(std::make_shared<InMemoryMarketDataService>(4), CalculationConfig{0.99, 0});
+
+    auto response = engine.calculate(makeRequest({}));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("no positions"), std::string::npos);
+
+    Request empty;
+    empty.type = RequestType::CALCULATE;
+    response = engine.calculate(empty);
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("truncated"), std::string::npos);
+}
+
+TEST(CalculationEngineTest, RejectsBadConfiguration)
+{
+    EXPECT_THROW(CalculationEngine(nullptr), std::invalid_argument);
+    EXPECT_THROW(CalculationEngine(std::make_shared<InMemoryMarketDataService>(4), CalculationConfig{1.5, 0}),
+                 std::invalid_argument);
+}
+
+// ---------------------------------------------------------------------------
+// VaR
+// ---------------------------------------------------------------------------
+
+TEST(CalculationEngineTest, ScenarioVarMatchesKnownDistribution)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(16);
+    marketData->update(makeSnapshot("A", 100.0));
+    marketData->update(makeSnapshot("B", 50.0));
+    CalculationEngine engine(marketData, CalculationConfig{0.99, 3});
+
+    // 1000 scenarios: A returns -k/1000 for k = 0..999, B never moves.
+    // Exposure of A is 10 × 100 = 1000, so the scenario P&L is -k.
+    const std::size_t   rows = 1000;
+    std::vector<double> returns;
+    for (std::size_t k = 0; k < rows; ++k)
+    {
+        returns.push_back(-static_cast<double>(k) / 1000.0);
+        returns.push_back(0.0);
+    }
+    engine.setScenarios({"A", "B"}, returns);
+    EXPECT_EQ(engine.scenarioCount(), rows);
+
+    const auto response = engine.calculate(makeRequest({makePosition("A", 10, 100.0),
+                                                        makePosition("B", 7, 50.0)}));
+    ASSERT_TRUE(response.success) << response.message;
+    const RiskSummaryPOD summary = decode(response).summary;
+
+    EXPECT_EQ(summary.scenarioCount, rows);
+    // 1% tail of {0, -1, ..., -999}: the 11th worst loss.
+    EXPECT_NEAR(summary.historicalVar, 989.0, 1e-6);
+
+    // Uniform losses 0..999: mean -499.5, sample stdev ≈ 288.82.
+    const double sigma = std::sqrt((static_cast<double>(rows) * rows - 1.0) / 12.0
+                                   * static_cast<double>(rows) / (rows - 1.0));
+    EXPECT_NEAR(summary.parametricVar, 2.326347874 * sigma + 499.5, 1e-3);
+}
+
+TEST(CalculationEngineTest, SetScenariosRejectsRaggedMatrix)
+{
+    CalculationEngine engine(std::make_shared<InMemoryMarketDataService>(4), CalculationConfig{0.99, 0});
+    EXPECT_THROW(engine.setScenarios({"A", "B"}, {0.1, 0.2, 0.3}), std::invalid_argument);
+}
+
+// ---------------------------------------------------------------------------
+// Incremental mode
+// ---------------------------------------------------------------------------
+
+TEST(CalculationEngineTest, ResidentBookFollowsTicksBetweenRequests)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(16);
+    marketData->update(makeSnapshot("AAPL", 110.0));
+    CalculationEngine engine(marketData, CalculationConfig{0.99, 0, 2});
+
+    const auto request = makeRequest({makePosition("AAPL", 10, 100.0)});
+    EXPECT_DOUBLE_EQ(decode(engine.calculate(request)).summary.totalUnrealisedPnl, 100.0);
+    EXPECT_EQ(engine.residentBookCount(), 1u);
+
+    marketData->update(makeSnapshot("AAPL", 125.0));
+    const Result result = decode(engine.calculate(request));
+    EXPECT_DOUBLE_EQ(result.positions[0].unrealisedPnl, 250.0);
+    EXPECT_DOUBLE_EQ(result.summary.totalUnrealisedPnl, 250.0);
+    EXPECT_EQ(engine.residentBookCount(), 1u);
+
+    // Two more distinct books evict the least recently used one.
+    engine.calculate(makeRequest({makePosition("AAPL", 1, 100.0)}));
+    engine.calculate(makeRequest({makePosition("AAPL", 2, 100.0)}));
+    EXPECT_EQ(engine.residentBookCount(), 2u);
+}
+
+TEST(CalculationEngineTest, ResidentVarRecomputedOnlyAfterTicks)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(16);
+    marketData->update(makeSnapshot("A", 100.0));
+    CalculationEngine engine(marketData, CalculationConfig{0.99, 0, 1});
+    engine.setScenarios({"A"}, {-0.10, 0.0, 0.05, 0.02});
+
+    const auto request = makeRequest({makePosition("A", 10, 100.0)});
+    EXPECT_NEAR(decode(engine.calculate(request)).summary.historicalVar, 100.0, 1e-9);
+
+    // Mark doubles, so exposure and the scenario loss double too.
+    marketData->update(makeSnapshot("A", 200.0));
+    EXPECT_NEAR(decode(engine.calculate(request)).summary.historicalVar, 200.0, 1e-9);
+}
+
+TEST(CalculationEngineTest, TicksDoNotWaitForAResidentBooksVarRun)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(16);
+    marketData->update(makeSnapshot("A", 100.0));
+    CalculationEngine engine(marketData, CalculationConfig{0.99, 0, 1});
+
+    // Enough scenarios that one VaR run on the caller's thread takes a while.
+    std::vector<double> returns(1u << 18);
+    for (std::size_t i = 0; i < returns.size(); ++i)
+        returns[i] = static_cast<double>((i * 7919) % 2001) / 10000.0 - 0.1;
+    engine.setScenarios({"A"}, returns);
+    const auto request = makeRequest({makePosition("A", 10, 100.0)});
+
+    using Clock = std::chrono::steady_clock;
+    std::atomic<bool> started{false};
+    auto              calculation = std::async(std::launch::async, [&]() {
+        const auto begin = Clock::now();
+        started          = true;
+        Response response = engine.calculate(request); // first request: loads the book, runs VaR
+        return std::make_pair(std::move(response), Clock::now() - begin);
+    });
+    while (!started)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    const auto tick = Clock::now();
+    marketData->update(makeSnapshot("A", 101.0)); // re-marks the resident book
+    const auto tickTime = Clock::now() - tick;
+
+    auto       result = calculation.get();
+    const auto micros = [](Clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+    EXPECT_LT(micros(tickTime) * 4, micros(result.second)) << "the tick waited for the VaR run";
+
+    const Result first = decode(result.first);
+    EXPECT_GT(first.summary.scenarioCount, 0u);
+
+    // The tick moved the book, so the next request sees it and runs VaR again.
+    const Result second = decode(engine.calculate(request));
+    EXPECT_DOUBLE_EQ(second.summary.totalUnrealisedPnl, 10.0);
+    EXPECT_NEAR(second.summary.historicalVar, first.summary.historicalVar * 1.01, 1e-6);
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_ColumnarTradeStore.cpp
+ * @brief Unit tests for the columnar trade store.
+ *
+ * Tests: dictionary encoding, timestamp ordering of out-of-order appends,
+ * batches merged into a stored tail they overlap (ties after the stored
+ * rows), each predicate on its own and combined, selections spanning several
+ * blocks, and reuse after clear().
+ */
+
+#include <gtest/gtest.h>
+
+#include "ColumnarTradeStore.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    TradePOD makeTrade(uint64_t id, const char* symbol, double price, uint64_t quantity, uint8_t side,
+                       int64_t timestamp)
+    {
+        TradePOD t{};
+        t.tradeId = id;
+        t.orderId = id * 10;
+        std::strncpy(t.symbol, symbol, sizeof(t.symbol) - 1);
+        t.price     = price;
+        t.quantity  = quantity;
+        t.side      = side;
+        t.timestamp = timestamp;
+        return t;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(ColumnarTradeStoreTest, EncodesSymbolsAndSortsByTimestamp)
+{
+    const std::vector<TradePOD> trades{makeTrade(1, "AAPL", 100.0, 10, 0, 300),
+                                       makeTrade(2, "MSFT", 200.0, 5, 1, 100),
+                                       makeTrade(3, "AAPL", 101.0, 7, 1, 200),
+                                       makeTrade(4, "AAPL", 102.0, 1, 0, 200)};
+    ColumnarTradeStore store;
+    store.append(trades.data(), trades.size());
+
+    EXPECT_EQ(store.size(), 4u);
+    EXPECT_EQ(store.symbolCount(), 2u);
+    EXPECT_EQ(store.findSymbol(SymbolKey("AAPL")), 0u);
+    EXPECT_EQ(store.findSymbol(SymbolKey("TSLA")), ColumnarTradeStore::kNoSymbol);
+
+    // Sorted by timestamp; equal timestamps keep arrival order.
+    TradePOD row{};
+    const uint64_t expectedIds[] = {2, 3, 4, 1};
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        store.materialise(i, row);
+        EXPECT_EQ(row.tradeId, expectedIds[i]);
+    }
+    EXPECT_STREQ(row.symbol, "AAPL");
+    EXPECT_EQ(row.orderId, 10u);
+    EXPECT_DOUBLE_EQ(row.price, 100.0);
+}
+
+TEST(ColumnarTradeStoreTest, LateBatchesMergeIntoTheRowsTheyOverlap)
+{
+    // Batches like those of several order shards: each in order, the next
+    // one starting a little before the last.
+    std::vector<TradePOD> all;
+    ColumnarTradeStore    store;
+    uint64_t              id = 1;
+    for (int64_t batch = 0; batch < 50; ++batch)
+    {
+        std::vector<TradePOD> trades;
+        for (int64_t i = 0; i < 7; ++i)
+            trades.push_back(makeTrade(id++, i % 2 ? "AAPL" : "MSFT", 100.0, 1, 0, batch * 10 + i * 3 - 12));
+        if (batch % 5 == 4)
+            std::reverse(trades.begin(), trades.end());
+        store.append(trades.data(), trades.size());
+        all.insert(all.end(), trades.begin(), trades.end());
+    }
+    const TradePOD oldest = makeTrade(id++, "AAPL", 100.0, 1, 0, -1000);
+    store.append(&oldest, 1);
+    all.push_back(oldest);
+
+    // What a stable sort of every trade in arrival order gives.
+    std::stable_sort(all.begin(), all.end(),
+                     [](const TradePOD& a, const TradePOD& b) { return a.timestamp < b.timestamp; });
+    ASSERT_EQ(store.size(), all.size());
+    TradePOD row{};
+    for (std::size_t i = 0; i < all.size(); ++i)
+    {
+        store.materialise(i, row);
+        ASSERT_EQ(row.tradeId, all[i].tradeId) << i;
+        EXPECT_EQ(row.timestamp, all[i].timestamp);
+        EXPECT_STREQ(row.symbol, all[i].symbol);
+    }
+}
+
+TEST(ColumnarTradeStoreTest, PredicatesCombine)
+{
+    std::vector<TradePOD> trades;
+    for (uint64_t i = 0; i < 100; ++i)
+        trades.push_back(makeTrade(i, i % 2 ? "AAPL" : "MSFT", 100.0 + static_cast<double>(i),
+                                   i, static_cast<uint8_t>(i % 4 < 2 ? 0 : 1), static_cast<int64_t>(i)));
+    ColumnarTradeStore store;
+    store.append(trades.data(), trades.size());
+
+    std::vector<uint32_t> rows;
+    TradeFilter           filter;
+    EXPECT_EQ(store.select(filter, rows), 100u);
+
+    filter.symbolCode    = store.findSymbol(SymbolKey("AAPL"));
+    filter.fromTimestamp = 10;
+    filter.toTimestamp   = 50;
+    EXPECT_EQ(store.select(filter, rows), 20u); // odd ids 11..49
+    EXPECT_EQ(rows.front(), 11u);
+    EXPECT_EQ(rows.back(), 49u);
+
+    filter.sideMask    = 2;     // sells: i % 4 in {2, 3} → odd ones are 3 (mod 4)
+    filter.minPrice    = 120.0; // i >= 20
+    filter.maxPrice    = 140.0; // i <= 40
+    filter.minQuantity = 25;    // i >= 25
+    ASSERT_EQ(store.select(filter, rows), 4u);
+    EXPECT_EQ(rows, (std::vector<uint32_t>{27, 31, 35, 39}));
+}
+
+TEST(ColumnarTradeStoreTest, SelectionSpansBlocksAndStoreIsReusable)
+{
+    const std::size_t     n = ColumnarTradeStore::kBlockRows * 3 + 17;
+    std::vector<TradePOD> trades;
+    for (std::size_t i = 0; i < n; ++i)
+        trades.push_back(makeTrade(i, "X", 1.0, i % 3 == 0 ? 100 : 1, 0, static_cast<int64_t>(i)));
+
+    ColumnarTradeStore store;
+    store.append(trades.data(), trades.size());
+
+    std::vector<uint32_t> rows;
+    TradeFilter           filter;
+    filter.minQuantity = 100;
+    EXPECT_EQ(store.select(filter, rows), (n + 2) / 3);
+    for (std::size_t k = 0; k < rows.size(); ++k)
+        ASSERT_EQ(rows[k], 3 * k);
+
+    store.clear();
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_EQ(store.findSymbol(SymbolKey("X")), ColumnarTradeStore::kNoSymbol);
+    EXPECT_EQ(store.select(filter, rows), 0u);
+
+    store.append(trades.data(), 1);
+    EXPECT_EQ(store.findSymbol(SymbolKey("X")), 0u);
+}
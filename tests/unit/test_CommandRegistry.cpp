@@ -2,7 +2,8 @@
  * @file test_CommandRegistry.cpp
  * @brief Unit tests for CommandRegistry.
  *
- * Tests: command registration, command creation, and unknown-type handling.
+ * Tests: command and handler registration, command creation, execution,
+ * streaming and async handlers, and unknown-type handling.
  */
 
 #include <gtest/gtest.h>
@@ -14,6 +15,10 @@
 #include "models/Request.hpp"
 #include "models/Response.hpp"
 
+#include <future>
+#include <string>
+#include <thread>
+
 // ---------------------------------------------------------------------------
 // Minimal stub command used by the tests
 // ---------------------------------------------------------------------------
@@ -98,3 +103,129 @@ TEST(CommandRegistryTest, AllDefaultRequestTypesCanBeRegistered)
         EXPECT_NO_THROW(registry.create(req));
     }
 }
+
+TEST(CommandRegistryTest, HandlerExecutesWithoutCreatingACommand)
+{
+    CommandRegistry registry;
+    int calls = 0;
+    registry.registerHandler(RequestType::MANIPULATE,
+        [&calls](const Request&) {
+            ++calls;
+            return Response{true, "handled", {}};
+        });
+
+    Request req;
+    req.type = RequestType::MANIPULATE;
+
+    const auto response = registry.execute(req);
+    EXPECT_TRUE(response.success);
+    EXPECT_EQ(response.message, "handled");
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(registry.isRegistered(RequestType::MANIPULATE));
+}
+
+TEST(CommandRegistryTest, LatestRegistrationWinsAcrossFactoriesAndHandlers)
+{
+    CommandRegistry registry;
+    registry.registerHandler(RequestType::CALCULATE,
+        [](const Request&) { return Response{false, "handler", {}}; });
+    registry.registerCommand(RequestType::CALCULATE,
+        [](const Request&) { return std::make_unique<StubCommand>(true); });
+
+    Request req;
+    req.type = RequestType::CALCULATE;
+    EXPECT_EQ(registry.execute(req).message, "stub");
+}
+
+TEST(CommandRegistryTest, OutOfRangeRequestTypeThrows)
+{
+    CommandRegistry registry;
+    const auto bogus = static_cast<RequestType>(1000);
+
+    EXPECT_THROW(registry.registerHandler(bogus,
+                     [](const Request&) { return Response{}; }),
+                 std::out_of_range);
+
+    Request req;
+    req.type = bogus;
+    EXPECT_THROW(registry.execute(req), std::out_of_range);
+    EXPECT_FALSE(registry.isRegistered(bogus));
+}
+
+TEST(CommandRegistryTest, StreamingHandlerEmitsChunksBeforeFinalResponse)
+{
+    CommandRegistry registry;
+    registry.registerStreamingHandler(RequestType::GENERATE_REPORT,
+        [](const Request&, const ResponseCallback& onChunk) {
+            if (!onChunk)
+                return Response{true, "whole", {}};
+            for (int i = 0; i < 3; ++i)
+            {
+                Response chunk{true, "part", {}};
+                chunk.more = true;
+                onChunk(std::move(chunk));
+            }
+            return Response{true, "last", {}};
+        });
+    EXPECT_TRUE(registry.isRegistered(RequestType::GENERATE_REPORT));
+
+    Request req;
+    req.type = RequestType::GENERATE_REPORT;
+
+    int chunks = 0;
+    const Response last = registry.execute(req, [&chunks](Response r) {
+        EXPECT_TRUE(r.more);
+        ++chunks;
+    });
+    EXPECT_EQ(chunks, 3);
+    EXPECT_EQ(last.message, "last");
+    EXPECT_FALSE(last.more);
+
+    // Without a chunk callback the handler returns everything at once.
+    EXPECT_EQ(registry.execute(req).message, "whole");
+}
+
+TEST(CommandRegistryTest, NonStreamingCommandIgnoresChunkCallback)
+{
+    CommandRegistry registry;
+    registry.registerCommand(RequestType::CALCULATE,
+        [](const Request&) { return std::make_unique<StubCommand>(true); });
+
+    Request req;
+    req.type = RequestType::CALCULATE;
+
+    bool chunked = false;
+    EXPECT_EQ(registry.execute(req, [&chunked](Response) { chunked = true; }).message, "stub");
+    EXPECT_FALSE(chunked);
+}
+
+TEST(CommandRegistryTest, AsyncHandlerCompletesOnItsOwnThread)
+{
+    CommandRegistry registry;
+    registry.registerAsyncHandler(RequestType::SUBMIT_ORDER,
+        [](const Request&, ResponseCallback onComplete) {
+            std::thread([onComplete = std::move(onComplete)]() { onComplete(Response{true, "async", {}}); })
+                .detach();
+        });
+    registry.registerHandler(RequestType::CALCULATE,
+        [](const Request&) { return Response{true, "inline", {}}; });
+
+    Request req;
+    req.type = RequestType::SUBMIT_ORDER;
+    EXPECT_TRUE(registry.isAsync(RequestType::SUBMIT_ORDER));
+    EXPECT_FALSE(registry.isAsync(RequestType::CALCULATE));
+    EXPECT_TRUE(registry.isRegistered(RequestType::SUBMIT_ORDER));
+
+    // Synchronous execution waits for the handler's thread.
+    EXPECT_EQ(registry.execute(req).message, "async");
+
+    std::promise<std::string> done;
+    registry.executeAsync(req, [&done](Response r) { done.set_value(r.message); });
+    EXPECT_EQ(done.get_future().get(), "async");
+
+    // Other slots complete inline through executeAsync().
+    req.type = RequestType::CALCULATE;
+    std::string message;
+    registry.executeAsync(req, [&message](Response r) { message = r.message; });
+    EXPECT_EQ(message, "inline");
+}
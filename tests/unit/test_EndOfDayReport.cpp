@@ -3,7 +3,10 @@
  * @brief Unit tests for EndOfDayReport and the BaseReport pipeline.
  *
  * Tests each pipeline step independently using a controllable mock subclass,
- * and validates the full pipeline sequence via EndOfDayReport stubs.
+ * validates the full pipeline sequence via EndOfDayReport stubs, and checks
+ * the rows and columnar blocks EndOfDayReport builds from aggregated day
+ * summaries, days a source does not fully hold being not final, and the
+ * summaries of a past day aggregated from its trade journal segment.
  */
 
 #include <gtest/gtest.h>
@@ -14,6 +17,16 @@
 
 // Pull in the concrete report (stubs return empty collections).
 #include "EndOfDayReport.hpp"
+#include "PodJournal.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
 
 using ::testing::Return;
 using ::testing::_;
@@ -47,7 +60,7 @@ TEST(BaseReportTest, PipelineCallsAllThreeStepsInOrder)
     EXPECT_CALL(mock, computeReport(rawData)).WillOnce(Return(computedData));
     EXPECT_CALL(mock, format(computedData)).WillOnce(Return(finalReport));
 
-    ReportRequest req{"EndOfDay", "2024-01-01", "2024-01-31"};
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 31)};
     auto result = mock.generate(req);
 
     EXPECT_EQ(result, finalReport);
@@ -61,7 +74,7 @@ TEST(BaseReportTest, EmptyDataProducesEmptyReport)
     EXPECT_CALL(mock, computeReport(ReportData{})).WillOnce(Return(ReportData{}));
     EXPECT_CALL(mock, format(ReportData{})).WillOnce(Return(Report{}));
 
-    ReportRequest req{"EndOfDay", "2024-01-01", "2024-01-01"};
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 1)};
     auto result = mock.generate(req);
 
     EXPECT_TRUE(result.empty());
@@ -74,7 +87,7 @@ TEST(BaseReportTest, EmptyDataProducesEmptyReport)
 TEST(EndOfDayReportTest, GenerateReturnsEmptyReportFromStubs)
 {
     EndOfDayReport report;
-    ReportRequest req{"EndOfDay", "2024-01-01", "2024-01-31"};
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 31)};
 
     // Stubs return empty collections — no crash expected.
     EXPECT_NO_THROW({
@@ -95,9 +108,211 @@ TEST(EndOfDayReportTest, FetchDataReturnsEmptyFromStub)
     };
 
     TestableEndOfDayReport report;
-    ReportRequest req{"EndOfDay", "2024-01-01", "2024-01-31"};
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 31)};
 
     EXPECT_TRUE(report.fetchData(req).empty());
     EXPECT_TRUE(report.computeReport({}).empty());
     EXPECT_TRUE(report.format({}).empty());
 }
+
+// ---------------------------------------------------------------------------
+// Tests for EndOfDayReport over aggregated day summaries
+// ---------------------------------------------------------------------------
+
+TEST(EndOfDayReportTest, RowsComeFromTheDaySummarySource)
+{
+    std::vector<TradingDate> asked;
+    EndOfDayReport           report([&asked](TradingDate day) {
+        asked.push_back(day);
+        std::vector<SymbolDaySummary> summaries;
+        if (day == TradingDate::fromCivil(2024, 1, 2))
+        {
+            SymbolDaySummary aapl{SymbolKey("AAPL"), {}};
+            aapl.summary.ohlcv.open     = 100.0;
+            aapl.summary.ohlcv.high     = 110.0;
+            aapl.summary.ohlcv.low      = 99.5;
+            aapl.summary.ohlcv.close    = 105.0;
+            aapl.summary.ohlcv.volume   = 40;
+            aapl.summary.ohlcv.notional = 4200.0;
+            aapl.summary.ohlcv.fills    = 3;
+            aapl.summary.sides[0].quantity = 30;
+            aapl.summary.sides[1].quantity = 10;
+            summaries.push_back(aapl);
+        }
+        return summaries;
+    });
+
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 3)};
+    const Report  rows = report.generate(req);
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0], "2024-01-02,AAPL,100,110,99.5,105,40,105,30,10,3");
+    EXPECT_EQ(asked.size(), 3u);
+}
+
+TEST(EndOfDayReportTest, DaysTheSourceDoesNotFullyHoldAreNotFinal)
+{
+    const TradingDate start = TradingDate::fromCivil(2024, 1, 2);
+    EndOfDayReport    report([](TradingDate) { return std::vector<SymbolDaySummary>{}; },
+                             [start](TradingDate day) { return start < day; });
+    EXPECT_FALSE(report.isFinal(TradingDate::fromCivil(2024, 1, 1)));
+    EXPECT_FALSE(report.isFinal(start));
+    EXPECT_TRUE(report.isFinal(TradingDate::fromCivil(2024, 1, 3)));
+
+    EXPECT_TRUE(EndOfDayReport([](TradingDate) { return std::vector<SymbolDaySummary>{}; }).isFinal(start));
+}
+
+// ---------------------------------------------------------------------------
+// Tests for summaries read from the trade journal
+// ---------------------------------------------------------------------------
+
+TEST(EndOfDayReportTest, JournalDaySummariesAggregateThePastDay)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path()
+                                       / ("hft_eod_journal_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(path);
+    JournalConfig config;
+    config.directory      = path.string();
+    config.name           = "trades";
+    config.initialRecords = 64;
+
+    const TradingDate march1   = TradingDate::fromCivil(2024, 3, 1);
+    const int64_t     midnight = int64_t{march1.days} * PodJournal<TradePOD>::kMicrosPerDay;
+    const auto        trade    = [](const char* symbol, double price, uint64_t quantity, uint8_t side,
+                            int64_t timestamp) {
+        TradePOD t{};
+        std::strcpy(t.symbol, symbol);
+        t.price     = price;
+        t.quantity  = quantity;
+        t.side      = side;
+        t.timestamp = timestamp;
+        return t;
+    };
+    {
+        PodJournal<TradePOD> journal(config);
+        const TradePOD       trades[] = {
+            trade("MSFT", 400.0, 5, 1, midnight + 30), trade("AAPL", 101.0, 10, 0, midnight + 20),
+            trade("AAPL", 100.0, 30, 1, midnight + 10), trade("AAPL", 104.0, 2, 0, midnight + 40),
+            trade("AAPL", 99.0, 1, 0, midnight + PodJournal<TradePOD>::kMicrosPerDay + 5), // March 2
+        };
+        journal.append(trades, 5);
+        ASSERT_TRUE(journal.sync());
+    }
+
+    const std::vector<SymbolDaySummary> summaries = journalDaySummaries(config, march1);
+    ASSERT_EQ(summaries.size(), 2u);
+    EXPECT_STREQ(summaries[0].symbol.bytes, "AAPL");
+    EXPECT_STREQ(summaries[1].symbol.bytes, "MSFT");
+
+    const DaySummary& aapl = summaries[0].summary;
+    EXPECT_EQ(aapl.day, march1.days);
+    EXPECT_DOUBLE_EQ(aapl.ohlcv.open, 100.0); // by timestamp, not journal order
+    EXPECT_DOUBLE_EQ(aapl.ohlcv.close, 104.0);
+    EXPECT_DOUBLE_EQ(aapl.ohlcv.high, 104.0);
+    EXPECT_EQ(aapl.ohlcv.volume, 42u);
+    EXPECT_EQ(aapl.ohlcv.fills, 3u);
+    EXPECT_EQ(aapl.sides[0].quantity, 12u);
+    EXPECT_EQ(aapl.sides[1].quantity, 30u);
+    EXPECT_EQ(summaries[1].summary.ohlcv.volume, 5u);
+
+    EXPECT_EQ(journalDaySummaries(config, TradingDate::fromCivil(2024, 3, 2)).size(), 1u);
+    EXPECT_TRUE(journalDaySummaries(config, TradingDate::fromCivil(2024, 2, 29)).empty());
+    std::filesystem::remove_all(path);
+}
+
+// ---------------------------------------------------------------------------
+// Tests for the columnar format
+// ---------------------------------------------------------------------------
+
+namespace
+{
+    template <typename T>
+    T readAt(const PooledBuffer& block, std::size_t offset)
+    {
+        T value;
+        std::memcpy(&value, block.data() + offset, sizeof(T));
+        return value;
+    }
+
+    ReportColumnPOD column(const PooledBuffer& block, std::size_t index)
+    {
+        return readAt<ReportColumnPOD>(block, sizeof(ReportBlockHeaderPOD) + index * sizeof(ReportColumnPOD));
+    }
+
+    SymbolDaySummary summary(const char* symbol, double open, double close, uint64_t buys, uint64_t sells)
+    {
+        SymbolDaySummary entry{SymbolKey(symbol), {}};
+        entry.summary.ohlcv.open        = open;
+        entry.summary.ohlcv.high        = std::max(open, close);
+        entry.summary.ohlcv.low         = std::min(open, close);
+        entry.summary.ohlcv.close       = close;
+        entry.summary.ohlcv.volume      = buys + sells;
+        entry.summary.ohlcv.notional    = close * static_cast<double>(buys + sells);
+        entry.summary.ohlcv.fills       = 2;
+        entry.summary.sides[0].quantity = buys;
+        entry.summary.sides[1].quantity = sells;
+        return entry;
+    }
+} // namespace
+
+TEST(EndOfDayReportTest, ColumnarBlocksCarryTheSummaryFigures)
+{
+    const TradingDate traded = TradingDate::fromCivil(2024, 1, 2);
+    EndOfDayReport    report([traded](TradingDate day) {
+        std::vector<SymbolDaySummary> summaries;
+        if (day == traded)
+        {
+            summaries.push_back(summary("AAPL", 100.0, 105.0, 30, 10));
+            summaries.push_back(summary("MSFT", 400.0, 398.5, 5, 7));
+        }
+        return summaries;
+    });
+    ASSERT_TRUE(report.supportsColumnar());
+
+    ForkJoinPool              pool(2);
+    std::vector<TradingDate>  days;
+    std::vector<PooledBuffer> blocks;
+    ReportRequest             req{"EndOfDay", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 3)};
+    report.generateColumnarStreaming(req, pool, [&](TradingDate day, PooledBuffer&& block) {
+        days.push_back(day);
+        blocks.push_back(std::move(block));
+    });
+
+    ASSERT_EQ(days.size(), 3u);
+    EXPECT_TRUE(blocks[0].empty()); // no trades, no block
+    EXPECT_TRUE(blocks[2].empty());
+
+    const PooledBuffer& block  = blocks[1];
+    const auto          header = readAt<ReportBlockHeaderPOD>(block, 0);
+    EXPECT_EQ(header.magic, kReportBlockMagic);
+    EXPECT_EQ(header.day, traded.days);
+    EXPECT_EQ(header.rowCount, 2u);
+    ASSERT_EQ(header.columnCount, 10u);
+
+    const char* names[] = {"symbol", "open", "high", "low", "close", "volume", "vwap", "buyVolume", "sellVolume", "fills"};
+    for (std::size_t i = 0; i < 10; ++i)
+        EXPECT_STREQ(column(block, i).name, names[i]);
+
+    // symbol: offsets {0, 4, 8} then "AAPLMSFT".
+    const ReportColumnPOD symbols = column(block, 0);
+    EXPECT_EQ(readAt<uint32_t>(block, symbols.offset + 4), 4u);
+    EXPECT_EQ(readAt<uint32_t>(block, symbols.offset + 8), 8u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(block.data()) + symbols.offset + 12, 8), "AAPLMSFT");
+
+    EXPECT_DOUBLE_EQ(readAt<double>(block, column(block, 1).offset + 8), 400.0);  // open
+    EXPECT_DOUBLE_EQ(readAt<double>(block, column(block, 4).offset), 105.0);      // close
+    EXPECT_EQ(readAt<uint64_t>(block, column(block, 5).offset), 40u);             // volume
+    EXPECT_DOUBLE_EQ(readAt<double>(block, column(block, 6).offset + 8), 398.5);  // vwap
+    EXPECT_EQ(readAt<uint64_t>(block, column(block, 8).offset + 8), 7u);          // sellVolume
+    EXPECT_EQ(column(block, 9).type, static_cast<uint8_t>(ReportColumnType::UINT32));
+    EXPECT_EQ(readAt<uint32_t>(block, column(block, 9).offset + 4), 2u);          // fills
+}
+
+TEST(BaseReportTest, ReportsWithoutColumnsRefuseTheColumnarFormat)
+{
+    MockReport   mock;
+    ForkJoinPool pool(0);
+    EXPECT_FALSE(mock.supportsColumnar());
+
+    ReportRequest req{"Mock", TradingDate::fromCivil(2024, 1, 1), TradingDate::fromCivil(2024, 1, 1)};
+    EXPECT_THROW(mock.generateColumnarStreaming(req, pool, [](TradingDate, PooledBuffer&&) {}), std::logic_error);
+}
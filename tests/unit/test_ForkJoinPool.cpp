@@ -0,0 +1,71 @@
+/**
+ * @file test_ForkJoinPool.cpp
+ * @brief Unit tests for the ForkJoinPool parallel loop.
+ *
+ * Tests: every index is visited exactly once, inline execution without
+ * workers, and concurrent callers that fall back to running inline.
+ */
+
+#include <gtest/gtest.h>
+
+#include "concurrency/ForkJoinPool.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(ForkJoinPoolTest, VisitsEveryIndexExactlyOnce)
+{
+    ForkJoinPool pool(3);
+    EXPECT_EQ(pool.concurrency(), 4u);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<std::atomic<int>> hits(1003);
+        pool.parallelFor(hits.size(), 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                hits[i].fetch_add(1);
+        });
+
+        for (const auto& hit : hits)
+            ASSERT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ForkJoinPoolTest, RunsInlineWithoutWorkers)
+{
+    ForkJoinPool pool(0);
+    const auto   caller = std::this_thread::get_id();
+
+    std::size_t visited = 0;
+    pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        visited += end - begin;
+    });
+    EXPECT_EQ(visited, 100u);
+}
+
+TEST(ForkJoinPoolTest, ConcurrentCallersAllComplete)
+{
+    ForkJoinPool pool(2);
+    std::atomic<std::size_t> total{0};
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; ++c)
+    {
+        callers.emplace_back([&]() {
+            for (int round = 0; round < 20; ++round)
+                pool.parallelFor(500, 8, [&](std::size_t begin, std::size_t end) {
+                    total.fetch_add(end - begin);
+                });
+        });
+    }
+    for (auto& t : callers)
+        t.join();
+
+    EXPECT_EQ(total.load(), 4u * 20u * 500u);
+}
@@ -0,0 +1,219 @@
+/**
+ * @file test_FrameCodec.cpp
+ * @brief Unit tests for the wire framing shared by all transports.
+ *
+ * Tests: BE32/BE64 round-trip, request decode/encode with and without a
+ * request id, accepted codecs and the reply codec, response frame layout
+ * and id tagging, and rejection of truncated payloads and unknown request
+ * flags.
+ */
+
+#include <gtest/gtest.h>
+
+#include "FrameCodec.hpp"
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(FrameCodecTest, BE32RoundTrip)
+{
+    const auto bytes = framing::encodeBE32(0x01020304u);
+    EXPECT_EQ(bytes[0], 0x01);
+    EXPECT_EQ(bytes[3], 0x04);
+    EXPECT_EQ(framing::decodeBE32(bytes.data()), 0x01020304u);
+}
+
+namespace
+{
+    /// Request flags of an encoded request header.
+    uint32_t decodeBE32Flags(const RawBuffer& wire)
+    {
+        return framing::decodeBE32(wire.data()) >> 16;
+    }
+} // namespace
+
+TEST(FrameCodecTest, BE64RoundTrip)
+{
+    uint8_t bytes[8];
+    framing::writeBE64(bytes, 0x0102030405060708ull);
+    EXPECT_EQ(bytes[0], 0x01);
+    EXPECT_EQ(bytes[7], 0x08);
+    EXPECT_EQ(framing::decodeBE64(bytes), 0x0102030405060708ull);
+}
+
+TEST(FrameCodecTest, RequestRoundTrip)
+{
+    Request in;
+    in.type    = RequestType::GENERATE_REPORT;
+    in.payload = {0xAA, 0xBB, 0xCC};
+
+    Request out;
+    ASSERT_TRUE(framing::decodeRequest(framing::encodeRequest(in), out));
+    EXPECT_EQ(out.type, RequestType::GENERATE_REPORT);
+    EXPECT_EQ(out.payload, in.payload);
+    EXPECT_FALSE(out.hasRequestId);
+}
+
+TEST(FrameCodecTest, RequestWithoutIdKeepsTheOriginalLayout)
+{
+    // [BE32 type][params], as sent by clients that do not pipeline.
+    const RawBuffer wire{0x00, 0x00, 0x00, 0x03, 0xAA};
+
+    Request out;
+    ASSERT_TRUE(framing::decodeRequest(wire, out));
+    EXPECT_EQ(out.type, RequestType::GENERATE_REPORT);
+    EXPECT_FALSE(out.hasRequestId);
+    ASSERT_EQ(out.payload.size(), 1u);
+
+    Request in;
+    in.type    = RequestType::GENERATE_REPORT;
+    in.payload = {0xAA};
+    EXPECT_EQ(framing::encodeRequest(in), wire);
+}
+
+TEST(FrameCodecTest, RequestIdRoundTrips)
+{
+    Request in;
+    in.type         = RequestType::CALCULATE;
+    in.hasRequestId = true;
+    in.requestId    = 0xDEADBEEF00000042ull;
+    in.payload      = {0x01, 0x02};
+
+    const RawBuffer wire = framing::encodeRequest(in);
+    ASSERT_EQ(wire.size(), framing::kRequestHeaderSize + framing::kRequestIdSize + 2);
+    EXPECT_EQ(framing::decodeBE32(wire.data()),
+              uint32_t{framing::kRequestHasId} << 16 | static_cast<uint32_t>(RequestType::CALCULATE));
+
+    Request out;
+    ASSERT_TRUE(framing::decodeRequest(wire, out));
+    EXPECT_EQ(out.type, RequestType::CALCULATE);
+    EXPECT_TRUE(out.hasRequestId);
+    EXPECT_EQ(out.requestId, in.requestId);
+    EXPECT_EQ(out.payload, in.payload);
+}
+
+TEST(FrameCodecTest, DecodeRequestRejectsTruncatedIdAndUnknownFlags)
+{
+    Request out;
+    EXPECT_FALSE(framing::decodeRequest(RawBuffer{0x00, 0x01, 0x00, 0x00, 0x00, 0x00}, out));
+    EXPECT_FALSE(framing::decodeRequest(RawBuffer{0x80, 0x00, 0x00, 0x00}, out));
+}
+
+TEST(FrameCodecTest, AcceptedCodecsAndReplyCodecRoundTrip)
+{
+    Request in;
+    in.type         = RequestType::GENERATE_REPORT;
+    in.acceptCodecs = 0x05;
+
+    const RawBuffer wire = framing::encodeRequest(in);
+    EXPECT_EQ(decodeBE32Flags(wire), 0x05u << framing::kRequestAcceptShift);
+    Request out;
+    ASSERT_TRUE(framing::decodeRequest(wire, out));
+    EXPECT_EQ(out.acceptCodecs, 0x05);
+    EXPECT_FALSE(out.hasRequestId);
+
+    Response reply{true, "OK", {1, 2, 3}};
+    reply.codec           = 2;
+    const RawBuffer frame = framing::encodeResponseFrame(reply);
+    EXPECT_EQ(frame[framing::kLengthPrefixSize], framing::kResponseSuccess | (2u << framing::kResponseCodecShift));
+
+    Response decoded;
+    ASSERT_TRUE(framing::decodeResponse(frame.slice(framing::kLengthPrefixSize, frame.size() - framing::kLengthPrefixSize),
+                                        decoded));
+    EXPECT_EQ(decoded.codec, 2);
+    EXPECT_EQ(decoded.data, reply.data);
+}
+
+TEST(FrameCodecTest, DecodeRequestRejectsShortPayload)
+{
+    Request out;
+    EXPECT_FALSE(framing::decodeRequest(RawBuffer{0x00, 0x01}, out));
+}
+
+TEST(FrameCodecTest, ResponseFrameCarriesLengthPrefix)
+{
+    const Response in{true, "ok", {1, 2, 3}};
+    const RawBuffer frame = framing::encodeResponseFrame(in);
+
+    ASSERT_GE(frame.size(), framing::kLengthPrefixSize);
+    EXPECT_EQ(framing::decodeBE32(frame.data()),
+              frame.size() - framing::kLengthPrefixSize);
+
+    const RawBuffer payload(frame.begin() + framing::kLengthPrefixSize, frame.end());
+    Response out;
+    ASSERT_TRUE(framing::decodeResponse(payload, out));
+    EXPECT_TRUE(out.success);
+    EXPECT_FALSE(out.push);
+    EXPECT_EQ(out.message, "ok");
+    EXPECT_EQ(out.data, in.data);
+}
+
+TEST(FrameCodecTest, PushFlagRoundTrips)
+{
+    Response in{true, "MarketData", {7}};
+    in.push = true;
+    const RawBuffer frame = framing::encodeResponseFrame(in);
+
+    EXPECT_EQ(frame[framing::kLengthPrefixSize], framing::kResponseSuccess | framing::kResponsePush);
+
+    const RawBuffer payload(frame.begin() + framing::kLengthPrefixSize, frame.end());
+    Response out;
+    ASSERT_TRUE(framing::decodeResponse(payload, out));
+    EXPECT_TRUE(out.success);
+    EXPECT_TRUE(out.push);
+}
+
+TEST(FrameCodecTest, MoreFlagRoundTrips)
+{
+    Response in{true, "", {1, 2}};
+    in.more = true;
+    const RawBuffer frame = framing::encodeResponseFrame(in);
+
+    EXPECT_EQ(frame[framing::kLengthPrefixSize], framing::kResponseSuccess | framing::kResponseMore);
+
+    const RawBuffer payload(frame.begin() + framing::kLengthPrefixSize, frame.end());
+    Response out;
+    ASSERT_TRUE(framing::decodeResponse(payload, out));
+    EXPECT_TRUE(out.more);
+    EXPECT_FALSE(out.push);
+    EXPECT_EQ(out.data.size(), 2u);
+}
+
+TEST(FrameCodecTest, DecodeResponseRejectsTruncatedMessage)
+{
+    RawBuffer payload(framing::kResponseHeaderSize);
+    framing::writeBE32(payload.data() + 1, 10); // claims 10 message bytes
+    Response out;
+    EXPECT_FALSE(framing::decodeResponse(payload, out));
+}
+
+TEST(FrameCodecTest, RequestIdTagsResponse)
+{
+    Response in{true, "OK", {9, 8, 7}};
+    in.more         = true;
+    in.hasRequestId = true;
+    in.requestId    = 77;
+    const RawBuffer frame = framing::encodeResponseFrame(in);
+
+    EXPECT_EQ(frame[framing::kLengthPrefixSize],
+              framing::kResponseSuccess | framing::kResponseMore | framing::kResponseRequestId);
+    EXPECT_EQ(framing::decodeBE64(frame.data() + framing::kLengthPrefixSize + 1), 77u);
+
+    const RawBuffer payload(frame.begin() + framing::kLengthPrefixSize, frame.end());
+    Response        out;
+    ASSERT_TRUE(framing::decodeResponse(payload, out));
+    EXPECT_TRUE(out.hasRequestId);
+    EXPECT_EQ(out.requestId, 77u);
+    EXPECT_TRUE(out.more);
+    EXPECT_EQ(out.message, "OK");
+    EXPECT_EQ(out.data, in.data);
+}
+
+TEST(FrameCodecTest, DecodeResponseRejectsTruncatedRequestId)
+{
+    RawBuffer payload(framing::kResponseHeaderSize + 2);
+    payload[0] = framing::kResponseRequestId;
+    Response out;
+    EXPECT_FALSE(framing::decodeResponse(payload, out));
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_InMemoryMarketDataService.cpp
+ * @brief Unit tests for the in-memory GET_MARKET_DATA implementation.
+ *
+ * Tests: batched snapshot lookup in request order (also across lookup
+ * blocks), symbols without a snapshot yet, unknown symbols, malformed
+ * payloads and subscriber counts.
+ */
+
+#include <gtest/gtest.h>
+
+#include "InMemoryMarketDataService.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    SymbolPOD makeSymbol(const char* symbol)
+    {
+        SymbolPOD s{};
+        std::strncpy(s.symbol, symbol, sizeof(s.symbol) - 1);
+        return s;
+    }
+
+    Request makeRequest(const std::vector<SymbolPOD>& symbols)
+    {
+        Request req;
+        req.type    = RequestType::GET_MARKET_DATA;
+        req.payload = makePodPayload(symbols.data(), symbols.size());
+        return req;
+    }
+
+    MarketDataPOD makeSnapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(InMemoryMarketDataServiceTest, ReturnsSnapshotsInRequestOrder)
+{
+    InMemoryMarketDataService service(16);
+    service.update(makeSnapshot("EURUSD", 1.085));
+    service.update(makeSnapshot("AAPL", 190.25));
+
+    const auto response = service.getData(makeRequest({makeSymbol("AAPL"), makeSymbol("EURUSD")}));
+    ASSERT_TRUE(response.success) << response.message;
+
+    PodArrayView<MarketDataPOD> snapshots;
+    ASSERT_EQ(pod::bindArray(response.data.data(), response.data.size(), snapshots),
+              PodDecodeStatus::OK);
+    ASSERT_EQ(snapshots.size(), 2u);
+    EXPECT_STREQ(snapshots[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(snapshots[0].last, 190.25);
+    EXPECT_STREQ(snapshots[1].symbol, "EURUSD");
+    EXPECT_DOUBLE_EQ(snapshots[1].last, 1.085);
+}
+
+TEST(InMemoryMarketDataServiceTest, ManySymbolsKeepRequestOrderAcrossLookupBlocks)
+{
+    InMemoryMarketDataService service(256);
+    std::vector<SymbolPOD>    symbols;
+    for (int i = 0; i < 200; ++i)
+    {
+        const std::string name = "SYM" + std::to_string(i);
+        if (i % 3 != 0)
+            service.update(makeSnapshot(name.c_str(), i));
+        else
+            service.intern(name);
+        symbols.push_back(makeSymbol(name.c_str()));
+    }
+    std::reverse(symbols.begin(), symbols.end());
+
+    const auto response = service.getData(makeRequest(symbols));
+    ASSERT_TRUE(response.success) << response.message;
+
+    PodArrayView<MarketDataPOD> snapshots;
+    ASSERT_EQ(pod::bindArray(response.data.data(), response.data.size(), snapshots), PodDecodeStatus::OK);
+    ASSERT_EQ(snapshots.size(), symbols.size());
+    for (std::size_t i = 0; i < symbols.size(); ++i)
+    {
+        const int id = 199 - static_cast<int>(i);
+        EXPECT_STREQ(snapshots[i].symbol, symbols[i].symbol);
+        EXPECT_DOUBLE_EQ(snapshots[i].last, id % 3 != 0 ? id : 0.0);
+    }
+
+    symbols[40] = makeSymbol("NOPE");
+    EXPECT_FALSE(service.getData(makeRequest(symbols)).success);
+}
+
+TEST(InMemoryMarketDataServiceTest, SubscribedSymbolWithoutSnapshotReturnsEmptyRecord)
+{
+    InMemoryMarketDataService service(16);
+    service.subscribe("MSFT");
+
+    const auto response = service.getData(makeRequest({makeSymbol("MSFT")}));
+    ASSERT_TRUE(response.success);
+
+    PodArrayView<MarketDataPOD> snapshots;
+    ASSERT_EQ(pod::bindArray(response.data.data(), response.data.size(), snapshots),
+              PodDecodeStatus::OK);
+    EXPECT_STREQ(snapshots[0].symbol, "MSFT");
+    EXPECT_EQ(snapshots[0].timestamp, 0);
+}
+
+TEST(InMemoryMarketDataServiceTest, UnknownSymbolAndBadPayloadFail)
+{
+    InMemoryMarketDataService service(16);
+
+    auto response = service.getData(makeRequest({makeSymbol("NOPE")}));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("unknown symbol NOPE"), std::string::npos);
+
+    Request empty;
+    empty.type = RequestType::GET_MARKET_DATA;
+    response = service.getData(empty);
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("truncated"), std::string::npos);
+}
+
+TEST(InMemoryMarketDataServiceTest, SubscribeAndUnsubscribeTrackCounts)
+{
+    InMemoryMarketDataService service(16);
+    service.subscribe("AAPL");
+    service.subscribe("AAPL");
+    service.unsubscribe("AAPL");
+    EXPECT_EQ(service.subscriberCount("AAPL"), 1u);
+
+    service.unsubscribe("AAPL");
+    service.unsubscribe("AAPL"); // never goes negative
+    EXPECT_EQ(service.subscriberCount("AAPL"), 0u);
+    EXPECT_EQ(service.subscriberCount("UNKNOWN"), 0u);
+}
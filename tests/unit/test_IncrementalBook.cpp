@@ -0,0 +1,124 @@
+/**
+ * @file test_IncrementalBook.cpp
+ * @brief Unit tests for tick-driven incremental P&L.
+ *
+ * Tests: initial marks from the cache, ticks that move only the affected
+ * symbol's positions and the running totals, unmarked positions picking up
+ * their first price, and agreement with a full recompute after many ticks.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IncrementalBook.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    PositionPOD makePosition(const char* symbol, int64_t quantity, double avgPrice)
+    {
+        PositionPOD p{};
+        std::strncpy(p.symbol, symbol, sizeof(p.symbol) - 1);
+        p.quantity = quantity;
+        p.avgPrice = avgPrice;
+        return p;
+    }
+
+    MarketDataPOD makeSnapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+
+    PodArrayView<PositionPOD> view(const std::vector<PositionPOD>& positions)
+    {
+        return PodArrayView<PositionPOD>(positions.data(), positions.size());
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(IncrementalBookTest, TickMovesOnlyAffectedPositions)
+{
+    InMemoryMarketDataService marketData(16);
+    const SymbolId aapl = marketData.update(makeSnapshot("AAPL", 110.0));
+    marketData.update(makeSnapshot("MSFT", 300.0));
+
+    const std::vector<PositionPOD> positions{makePosition("AAPL", 10, 100.0),
+                                             makePosition("MSFT", -2, 310.0),
+                                             makePosition("AAPL", -4, 105.0)};
+    IncrementalBook book;
+    book.load(view(positions), marketData);
+    ASSERT_TRUE(book.loaded());
+    EXPECT_DOUBLE_EQ(book.totalUnrealisedPnl(), 100.0 + 20.0 - 20.0);
+    EXPECT_DOUBLE_EQ(book.grossExposure(), 14 * 110.0 + 2 * 300.0);
+
+    EXPECT_TRUE(book.applyTick(aapl, 120.0));
+    EXPECT_DOUBLE_EQ(book.positions()[0].unrealisedPnl, 200.0);
+    EXPECT_DOUBLE_EQ(book.positions()[1].unrealisedPnl, 20.0); // untouched
+    EXPECT_DOUBLE_EQ(book.positions()[2].unrealisedPnl, -60.0);
+    EXPECT_DOUBLE_EQ(book.totalUnrealisedPnl(), 160.0);
+    EXPECT_EQ(book.version(), 1u);
+
+    // Same price again, or a symbol the book does not hold: no change.
+    EXPECT_FALSE(book.applyTick(aapl, 120.0));
+    EXPECT_FALSE(book.applyTick(marketData.intern("OTHER"), 1.0));
+    EXPECT_EQ(book.version(), 1u);
+}
+
+TEST(IncrementalBookTest, UnmarkedSymbolPicksUpFirstTick)
+{
+    InMemoryMarketDataService marketData(16);
+    const std::vector<PositionPOD> positions{makePosition("NEW", 5, 20.0)};
+
+    IncrementalBook book;
+    book.load(view(positions), marketData);
+    EXPECT_EQ(book.unmarkedCount(), 1u);
+    EXPECT_DOUBLE_EQ(book.grossExposure(), 100.0);
+
+    EXPECT_TRUE(book.applyTick(marketData.intern("NEW"), 22.0));
+    EXPECT_EQ(book.unmarkedCount(), 0u);
+    EXPECT_DOUBLE_EQ(book.totalUnrealisedPnl(), 10.0);
+    EXPECT_DOUBLE_EQ(book.grossExposure(), 110.0);
+
+    double exposure = 0.0;
+    book.forEachExposure([&](SymbolId, double value) { exposure += value; });
+    EXPECT_DOUBLE_EQ(exposure, 110.0);
+}
+
+TEST(IncrementalBookTest, RunningTotalsMatchFullRecomputeAfterManyTicks)
+{
+    InMemoryMarketDataService marketData(64);
+    std::vector<PositionPOD>  positions;
+    std::vector<SymbolId>     ids;
+    for (int s = 0; s < 20; ++s)
+    {
+        const std::string symbol = "SYM" + std::to_string(s);
+        ids.push_back(marketData.update(makeSnapshot(symbol.c_str(), 100.0)));
+        for (int k = 0; k < 5; ++k)
+            positions.push_back(makePosition(symbol.c_str(), (s + 1) * (k - 2), 100.0 + k));
+    }
+
+    IncrementalBook book;
+    book.load(view(positions), marketData);
+
+    std::vector<double> lastOf(ids.size(), 100.0);
+    for (uint32_t t = 0; t < 3 * IncrementalBook::kResyncTicks + 7; ++t)
+    {
+        const std::size_t s = (t * 7u) % ids.size();
+        lastOf[s] = 100.0 + 0.01 * static_cast<double>((t * 13u) % 997u);
+        book.applyTick(ids[s], lastOf[s]);
+    }
+
+    double expected = 0.0;
+    for (std::size_t i = 0; i < positions.size(); ++i)
+        expected += static_cast<double>(positions[i].quantity) * (lastOf[i / 5] - positions[i].avgPrice);
+    EXPECT_NEAR(book.totalUnrealisedPnl(), expected, 1e-6);
+}
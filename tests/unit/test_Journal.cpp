@@ -0,0 +1,233 @@
+/**
+ * @file test_Journal.cpp
+ * @brief Unit tests for the memory-mapped trade and order journal.
+ *
+ * Tests: records read back in place after sync(), one segment per UTC day
+ * (batches split at midnight), growth past the preallocated capacity,
+ * continuing a segment after a restart, group commit without an explicit
+ * sync, concurrent appenders, and rejecting a segment of another schema.
+ */
+
+#include <gtest/gtest.h>
+
+#include "PodJournal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    constexpr int64_t kDay = PodJournal<TradePOD>::kMicrosPerDay;
+
+    /// 2024-03-01 00:00:00 UTC in microseconds.
+    constexpr int64_t kMarch1 = int64_t{TradingDate::fromCivil(2024, 3, 1).days} * kDay;
+
+    TradePOD trade(uint64_t id, int64_t timestamp)
+    {
+        TradePOD t{};
+        t.tradeId = id;
+        t.orderId = id * 10;
+        std::strcpy(t.symbol, "AAPL");
+        t.price     = 100.0 + static_cast<double>(id);
+        t.quantity  = id;
+        t.side      = static_cast<uint8_t>(id % 2);
+        t.timestamp = timestamp;
+        return t;
+    }
+
+    /// A journal config in a fresh directory removed at the end of the test.
+    class JournalDirectory
+    {
+    public:
+        JournalDirectory()
+            : m_path(std::filesystem::temp_directory_path()
+                     / ("hft_journal_" + std::to_string(::getpid()) + "_"
+                        + ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+        {
+            std::filesystem::remove_all(m_path);
+        }
+        ~JournalDirectory() { std::filesystem::remove_all(m_path); }
+
+        JournalConfig config(const std::string& name = "trades", std::size_t initialRecords = 1024) const
+        {
+            JournalConfig config;
+            config.directory      = m_path.string();
+            config.name           = name;
+            config.initialRecords = initialRecords;
+            return config;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Append and read back
+// ---------------------------------------------------------------------------
+
+TEST(JournalTest, SyncedRecordsAreReadBackInPlace)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config();
+
+    PodJournal<TradePOD>  journal(config);
+    std::vector<TradePOD> trades;
+    for (uint64_t i = 1; i <= 100; ++i)
+        trades.push_back(trade(i, kMarch1 + static_cast<int64_t>(i)));
+    journal.append(trades.data(), trades.size());
+    ASSERT_TRUE(journal.sync());
+    EXPECT_EQ(journal.journal().durableRecords(), 100u);
+
+    const auto day = PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1));
+    ASSERT_NE(day.day, nullptr);
+    ASSERT_EQ(day.records.size(), 100u);
+    for (std::size_t i = 0; i < trades.size(); ++i)
+        EXPECT_EQ(std::memcmp(&day.records[i], &trades[i], sizeof(TradePOD)), 0) << "record " << i;
+
+    EXPECT_EQ(PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 2)).day, nullptr);
+}
+
+TEST(JournalTest, BatchesAreSplitIntoOneSegmentPerDay)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config();
+
+    PodJournal<TradePOD> journal(config);
+    const TradePOD       trades[] = {trade(1, kMarch1 - 1), trade(2, kMarch1), trade(3, kMarch1 + kDay - 1),
+                                     trade(4, kMarch1 + kDay)};
+    journal.append(trades, 4);
+    journal.append(trades, 1); // a late record for the first day
+    ASSERT_TRUE(journal.sync());
+
+    const std::vector<TradingDate> days = Journal::days(config);
+    ASSERT_EQ(days.size(), 3u);
+    EXPECT_EQ(days[0].toIso(), "2024-02-29");
+    EXPECT_EQ(days[1].toIso(), "2024-03-01");
+    EXPECT_EQ(days[2].toIso(), "2024-03-02");
+
+    EXPECT_EQ(PodJournal<TradePOD>::openDay(config, days[0]).records.size(), 2u);
+    const auto march1 = PodJournal<TradePOD>::openDay(config, days[1]);
+    ASSERT_EQ(march1.records.size(), 2u);
+    EXPECT_EQ(march1.records[0].tradeId, 2u);
+    EXPECT_EQ(march1.records[1].tradeId, 3u);
+    EXPECT_EQ(PodJournal<TradePOD>::openDay(config, days[2]).records.size(), 1u);
+}
+
+TEST(JournalTest, SegmentGrowsPastItsPreallocation)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config("trades", 16);
+
+    PodJournal<TradePOD> journal(config);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        const TradePOD t = trade(i, kMarch1 + static_cast<int64_t>(i));
+        journal.append(&t, 1);
+    }
+    ASSERT_TRUE(journal.sync());
+
+    const auto day = PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1));
+    ASSERT_EQ(day.records.size(), 1000u);
+    EXPECT_EQ(day.records[999].tradeId, 999u);
+}
+
+TEST(JournalTest, ReopenedSegmentContinuesAfterCommittedRecords)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config();
+
+    {
+        PodJournal<TradePOD> journal(config);
+        const TradePOD       t = trade(1, kMarch1);
+        journal.append(&t, 1);
+    } // the destructor commits
+    {
+        PodJournal<TradePOD> journal(config);
+        const TradePOD       t = trade(2, kMarch1 + 1);
+        journal.append(&t, 1);
+        ASSERT_TRUE(journal.sync());
+    }
+
+    const auto day = PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1));
+    ASSERT_EQ(day.records.size(), 2u);
+    EXPECT_EQ(day.records[0].tradeId, 1u);
+    EXPECT_EQ(day.records[1].tradeId, 2u);
+}
+
+// ---------------------------------------------------------------------------
+// Group commit and concurrency
+// ---------------------------------------------------------------------------
+
+TEST(JournalTest, FlusherCommitsWithoutExplicitSync)
+{
+    JournalDirectory dir;
+    auto             config = dir.config();
+    config.flushInterval   = std::chrono::milliseconds(1);
+
+    PodJournal<TradePOD> journal(config);
+    const TradePOD       t = trade(1, kMarch1);
+    journal.append(&t, 1);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (journal.journal().durableRecords() < 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(journal.journal().durableRecords(), 1u);
+    EXPECT_EQ(PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1)).records.size(), 1u);
+}
+
+TEST(JournalTest, ConcurrentAppendersLoseNoRecords)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config("trades", 64);
+
+    constexpr int        kThreads = 4;
+    constexpr uint64_t   kEach    = 2000;
+    PodJournal<TradePOD> journal(config);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+        threads.emplace_back([&journal, t]() {
+            for (uint64_t i = 0; i < kEach; ++i)
+            {
+                const TradePOD record = trade(static_cast<uint64_t>(t) * kEach + i, kMarch1 + static_cast<int64_t>(i));
+                journal.append(&record, 1);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+    ASSERT_TRUE(journal.sync());
+
+    const auto day = PodJournal<TradePOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1));
+    ASSERT_EQ(day.records.size(), kThreads * kEach);
+    std::vector<bool> seen(kThreads * kEach, false);
+    for (const TradePOD& record : day.records)
+        seen[record.tradeId] = true;
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), false), 0);
+}
+
+TEST(JournalTest, RejectsSegmentOfAnotherSchema)
+{
+    JournalDirectory dir;
+    const auto       config = dir.config("mixed");
+
+    {
+        PodJournal<TradePOD> trades(config);
+        const TradePOD       t = trade(1, kMarch1);
+        trades.append(&t, 1);
+    }
+
+    EXPECT_THROW(PodJournal<OrderPOD>::openDay(config, TradingDate::fromCivil(2024, 3, 1)), std::runtime_error);
+
+    PodJournal<OrderPOD> orders(config);
+    OrderPOD             order{};
+    order.timestamp = kMarch1;
+    EXPECT_THROW(orders.append(&order, 1), std::runtime_error);
+}
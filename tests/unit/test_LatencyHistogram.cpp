@@ -0,0 +1,100 @@
+/**
+ * @file test_LatencyHistogram.cpp
+ * @brief Unit tests for the log-linear latency histogram.
+ *
+ * Tests: bucket boundaries are contiguous and bounded in relative width,
+ * percentiles land within the bucket precision, merging adds distributions,
+ * and out-of-range values are clamped into the last bucket.
+ */
+
+#include <gtest/gtest.h>
+
+#include "metrics/LatencyHistogram.hpp"
+
+#include <cstdint>
+
+// ---------------------------------------------------------------------------
+// Buckets
+// ---------------------------------------------------------------------------
+
+TEST(LatencyHistogramTest, BucketsAreContiguousAndNarrow)
+{
+    for (std::size_t i = 1; i < LatencyHistogram::kBucketCount; ++i)
+    {
+        const uint64_t lower = LatencyHistogram::bucketUpperBound(i - 1) + 1;
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+        ASSERT_EQ(LatencyHistogram::bucketIndex(lower), i) << "bucket " << i;
+        ASSERT_EQ(LatencyHistogram::bucketIndex(upper), i) << "bucket " << i;
+        ASSERT_LE(upper - lower + 1, lower / LatencyHistogram::kSubBucketCount + 1) << "bucket " << i;
+    }
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::kBucketCount - 1),
+              (uint64_t{1} << LatencyHistogram::kMaxValueBits) - 1);
+}
+
+TEST(LatencyHistogramTest, HugeValuesLandInTheLastBucket)
+{
+    LatencyHistogram histogram;
+    histogram.record(uint64_t{1} << 50);
+    EXPECT_EQ(histogram.bucketCount(LatencyHistogram::kBucketCount - 1), 1u);
+    EXPECT_EQ(histogram.max(), uint64_t{1} << 50);
+}
+
+// ---------------------------------------------------------------------------
+// Percentiles
+// ---------------------------------------------------------------------------
+
+TEST(LatencyHistogramTest, PercentilesAreWithinBucketPrecision)
+{
+    LatencyHistogram histogram;
+    for (uint64_t us = 1; us <= 1000; ++us)
+        histogram.record(us * 1000);
+
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), 1000000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500500.0);
+
+    const auto near = [](uint64_t actual, double expected) {
+        return actual >= expected && actual <= expected * (1.0 + 1.0 / LatencyHistogram::kSubBucketCount);
+    };
+    EXPECT_TRUE(near(histogram.percentile(50.0), 500000.0)) << histogram.percentile(50.0);
+    EXPECT_TRUE(near(histogram.percentile(99.0), 990000.0)) << histogram.percentile(99.0);
+    EXPECT_TRUE(near(histogram.percentile(99.9), 999000.0)) << histogram.percentile(99.9);
+    EXPECT_EQ(histogram.percentile(100.0), 1000000u);
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero)
+{
+    const LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(99.0), 0u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    LatencyHistogram histogram;
+    histogram.record(3);
+    histogram.record(40);
+    EXPECT_EQ(histogram.percentile(50.0), 3u);
+    EXPECT_EQ(histogram.percentile(100.0), 40u);
+}
+
+// ---------------------------------------------------------------------------
+// Merging
+// ---------------------------------------------------------------------------
+
+TEST(LatencyHistogramTest, MergeAddsDistributions)
+{
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 90; ++i)
+        fast.record(1000);
+    for (int i = 0; i < 10; ++i)
+        slow.record(1000000);
+
+    fast.merge(slow);
+    EXPECT_EQ(fast.count(), 100u);
+    EXPECT_EQ(fast.max(), 1000000u);
+    EXPECT_LE(fast.percentile(90.0), 1000u * 33 / 32);
+    EXPECT_GE(fast.percentile(91.0), 1000000u);
+}
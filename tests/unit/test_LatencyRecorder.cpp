@@ -0,0 +1,111 @@
+/**
+ * @file test_LatencyRecorder.cpp
+ * @brief Unit tests for the per-thread latency recorder and its hooks.
+ *
+ * The recorder is process-wide, so every test compares counts before and
+ * after. Tests: histograms recorded on several threads merge, unset stamps
+ * are ignored, and the facades and pipeline record SERVICE and QUEUE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "PipelinedServerFacade.hpp"
+#include "TradingServerFacade.hpp"
+#include "metrics/LatencyRecorder.hpp"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    uint64_t countOf(RequestType type, LatencyStage stage)
+    {
+        return LatencyRecorder::instance().histogram(type, stage).count();
+    }
+
+    /// Answers every request immediately, without going through a registry.
+    class EchoFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request&) override { return Response{true, "ok", {}}; }
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+TEST(LatencyRecorderTest, ThreadsRecordSeparatelyAndMergeOnDemand)
+{
+    LatencyRecorder& recorder = LatencyRecorder::instance();
+    const auto       before   = recorder.histogram(RequestType::UNSUBSCRIBE, LatencyStage::DECODE);
+
+    std::vector<std::thread> threads;
+    for (uint64_t t = 1; t <= 4; ++t)
+    {
+        threads.emplace_back([&recorder, t]() {
+            for (int i = 0; i < 1000; ++i)
+                recorder.record(RequestType::UNSUBSCRIBE, LatencyStage::DECODE, t * 1000000);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto after = recorder.histogram(RequestType::UNSUBSCRIBE, LatencyStage::DECODE);
+    EXPECT_EQ(after.count() - before.count(), 4000u);
+    EXPECT_EQ(after.sum() - before.sum(), uint64_t{1000} * (1 + 2 + 3 + 4) * 1000000);
+    EXPECT_GE(after.max(), 4000000u);
+}
+
+TEST(LatencyRecorderTest, UnsetStampIsIgnored)
+{
+    const uint64_t before = countOf(RequestType::SUBSCRIBE, LatencyStage::QUEUE);
+    LatencyRecorder::instance().recordSince(RequestType::SUBSCRIBE, LatencyStage::QUEUE, 0);
+    EXPECT_EQ(countOf(RequestType::SUBSCRIBE, LatencyStage::QUEUE), before);
+
+    LatencyRecorder::instance().recordSince(RequestType::SUBSCRIBE, LatencyStage::QUEUE, LatencyRecorder::now());
+    EXPECT_EQ(countOf(RequestType::SUBSCRIBE, LatencyStage::QUEUE), before + 1);
+}
+
+TEST(LatencyRecorderTest, UnknownTypesShareOneSlot)
+{
+    const auto     unknown = static_cast<RequestType>(99);
+    const uint64_t before  = countOf(unknown, LatencyStage::TOTAL);
+    LatencyRecorder::instance().record(static_cast<RequestType>(42), LatencyStage::TOTAL, 10);
+    EXPECT_EQ(countOf(unknown, LatencyStage::TOTAL), before + 1);
+}
+
+// ---------------------------------------------------------------------------
+// Facade hooks
+// ---------------------------------------------------------------------------
+
+TEST(LatencyRecorderTest, TradingFacadeRecordsServiceTime)
+{
+    TradingServerFacade facade(nullptr, nullptr, nullptr, nullptr, CommandRegistry{});
+    const uint64_t      before = countOf(RequestType::MANIPULATE, LatencyStage::SERVICE);
+
+    Request request;
+    request.type = RequestType::MANIPULATE;
+    facade.handleRequest(request); // unregistered: still timed
+    EXPECT_EQ(countOf(RequestType::MANIPULATE, LatencyStage::SERVICE), before + 1);
+}
+
+TEST(LatencyRecorderTest, PipelineRecordsQueueTimeOfStampedRequests)
+{
+    PipelinedServerFacade pipeline(std::make_shared<EchoFacade>(), PipelineConfig{1, 16, {}});
+    const uint64_t        before = countOf(RequestType::CALCULATE, LatencyStage::QUEUE);
+
+    for (const bool stamped : {true, false})
+    {
+        Request request;
+        request.type = RequestType::CALCULATE;
+        if (stamped)
+            request.timing.decodedAt = LatencyRecorder::now();
+
+        std::promise<void> done;
+        pipeline.handleRequestAsync(std::move(request), [&done](Response) { done.set_value(); });
+        done.get_future().wait();
+    }
+    EXPECT_EQ(countOf(RequestType::CALCULATE, LatencyStage::QUEUE), before + 1);
+}
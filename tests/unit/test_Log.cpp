@@ -0,0 +1,91 @@
+/**
+ * @file test_Log.cpp
+ * @brief Unit tests for the HFT_LOG_* macros.
+ *
+ * Tests: arguments of a disabled line are not evaluated, an enabled line
+ * reaches the default logger's sinks, and levels below SPDLOG_ACTIVE_LEVEL
+ * are compiled out.
+ */
+
+#include <gtest/gtest.h>
+
+#include "logging/Log.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+namespace
+{
+    /// Installs a default logger writing to a string stream; restores the previous one.
+    class CapturedLog
+    {
+    public:
+        explicit CapturedLog(spdlog::level::level_enum level)
+            : m_previous(spdlog::default_logger())
+        {
+            auto sink   = std::make_shared<spdlog::sinks::ostream_sink_st>(m_out);
+            auto logger = std::make_shared<spdlog::logger>("test", sink);
+            logger->set_pattern("%l %v");
+            logger->set_level(level);
+            spdlog::set_default_logger(logger);
+        }
+        ~CapturedLog() { spdlog::set_default_logger(m_previous); }
+
+        std::string text() const { return m_out.str(); }
+
+    private:
+        std::shared_ptr<spdlog::logger> m_previous;
+        std::ostringstream              m_out;
+    };
+
+    int g_evaluations = 0;
+
+    int expensive()
+    {
+        ++g_evaluations;
+        return 42;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Runtime level
+// ---------------------------------------------------------------------------
+
+TEST(LogTest, DisabledLineDoesNotEvaluateArguments)
+{
+    CapturedLog log(spdlog::level::warn);
+    g_evaluations = 0;
+
+    HFT_LOG_INFO("value {}", expensive());
+    EXPECT_EQ(g_evaluations, 0);
+    EXPECT_TRUE(log.text().empty());
+}
+
+TEST(LogTest, EnabledLineIsWritten)
+{
+    CapturedLog log(spdlog::level::info);
+    g_evaluations = 0;
+
+    HFT_LOG_WARN("value {}", expensive());
+    EXPECT_EQ(g_evaluations, 1);
+    EXPECT_NE(log.text().find("warning value 42"), std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// Compile-time level
+// ---------------------------------------------------------------------------
+
+TEST(LogTest, LevelsBelowActiveLevelAreCompiledOut)
+{
+    CapturedLog log(spdlog::level::trace);
+    g_evaluations = 0;
+
+    HFT_LOG_TRACE("value {}", expensive());
+    HFT_LOG_DEBUG("value {}", expensive());
+
+    const int expected = (SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE) + (SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG);
+    EXPECT_EQ(g_evaluations, expected);
+}
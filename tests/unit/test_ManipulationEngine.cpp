@@ -0,0 +1,305 @@
+/**
+ * @file test_ManipulationEngine.cpp
+ * @brief Unit tests for the columnar MANIPULATE implementation.
+ *
+ * Tests: filtering trades carried in the request and in the resident day
+ * store, the daily pivot's grouping and VWAP, the resident pivot read from
+ * the aggregates, OHLCV bars, unsupported operations, malformed payloads,
+ * and ManipulationCommand's routing to transform().
+ */
+
+#include <gtest/gtest.h>
+
+#include "ManipulationEngine.hpp"
+#include "commands/ManipulationCommand.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr int64_t kDay = ManipulationEngine::kMicrosPerDay;
+
+    TradePOD makeTrade(uint64_t id, const char* symbol, double price, uint64_t quantity, uint8_t side,
+                       int64_t timestamp)
+    {
+        TradePOD t{};
+        t.tradeId = id;
+        std::strncpy(t.symbol, symbol, sizeof(t.symbol) - 1);
+        t.price     = price;
+        t.quantity  = quantity;
+        t.side      = side;
+        t.timestamp = timestamp;
+        return t;
+    }
+
+    ManipulationSpecPOD makeSpec(ManipulationOp op, const char* symbol = "")
+    {
+        ManipulationSpecPOD spec{};
+        spec.op = static_cast<uint8_t>(op);
+        std::strncpy(spec.symbol, symbol, sizeof(spec.symbol) - 1);
+        return spec;
+    }
+
+    Request makeRequest(const ManipulationSpecPOD& spec, const std::vector<TradePOD>& trades = {})
+    {
+        const std::size_t specBytes = pod::payloadSize<ManipulationSpecPOD>(1);
+        Request           req;
+        req.type    = RequestType::MANIPULATE;
+        req.payload = PooledBuffer::uninitialized(specBytes
+                                                  + (trades.empty() ? 0 : pod::payloadSize<TradePOD>(trades.size())));
+        pod::writeArray(req.payload.data(), &spec, 1);
+        if (!trades.empty())
+            pod::writeArray(req.payload.data() + specBytes, trades.data(), trades.size());
+        return req;
+    }
+
+    std::vector<TradePOD> decode(const Response& response)
+    {
+        PodArrayView<TradePOD> rows;
+        EXPECT_EQ(pod::bindArray(response.data.data(), response.data.size(), rows), PodDecodeStatus::OK);
+        return std::vector<TradePOD>(rows.begin(), rows.end());
+    }
+
+    std::vector<BarPOD> decodeBars(const Response& response)
+    {
+        PodArrayView<BarPOD> rows;
+        EXPECT_EQ(pod::bindArray(response.data.data(), response.data.size(), rows), PodDecodeStatus::OK);
+        return std::vector<BarPOD>(rows.begin(), rows.end());
+    }
+
+    void expectSameRows(const std::vector<TradePOD>& actual, const std::vector<TradePOD>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+        {
+            EXPECT_STREQ(actual[i].symbol, expected[i].symbol);
+            EXPECT_EQ(actual[i].side, expected[i].side);
+            EXPECT_EQ(actual[i].timestamp, expected[i].timestamp);
+            EXPECT_EQ(actual[i].tradeId, expected[i].tradeId);
+            EXPECT_EQ(actual[i].quantity, expected[i].quantity);
+            EXPECT_DOUBLE_EQ(actual[i].price, expected[i].price);
+        }
+    }
+
+    std::vector<TradePOD> dayOfFills()
+    {
+        return {makeTrade(1, "AAPL", 100.0, 10, 0, 9 * 3600LL * 1000000),
+                makeTrade(2, "MSFT", 300.0, 5, 1, 10 * 3600LL * 1000000),
+                makeTrade(3, "AAPL", 110.0, 30, 0, 11 * 3600LL * 1000000),
+                makeTrade(4, "AAPL", 105.0, 4, 1, 12 * 3600LL * 1000000),
+                makeTrade(5, "AAPL", 120.0, 1, 0, kDay + 1)};
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FILTER
+// ---------------------------------------------------------------------------
+
+TEST(ManipulationEngineTest, FiltersRequestTradesBySymbol)
+{
+    ManipulationEngine engine;
+    const Response     response = engine.manipulate(makeRequest(makeSpec(ManipulationOp::FILTER, "AAPL"), dayOfFills()));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const auto rows = decode(response);
+    ASSERT_EQ(rows.size(), 4u);
+    for (const TradePOD& row : rows)
+        EXPECT_STREQ(row.symbol, "AAPL");
+    EXPECT_EQ(rows[0].tradeId, 1u);
+    EXPECT_EQ(rows[3].tradeId, 5u);
+
+    // Unknown symbols match nothing rather than failing.
+    const auto none = engine.manipulate(makeRequest(makeSpec(ManipulationOp::FILTER, "TSLA"), dayOfFills()));
+    ASSERT_TRUE(none.success);
+    EXPECT_TRUE(decode(none).empty());
+}
+
+TEST(ManipulationEngineTest, FiltersResidentStoreWhenRequestCarriesNoTrades)
+{
+    ManipulationEngine engine;
+    const auto         fills = dayOfFills();
+    engine.recordTrades(fills.data(), fills.size());
+    EXPECT_EQ(engine.tradeCount(), 5u);
+
+    ManipulationSpecPOD spec = makeSpec(ManipulationOp::FILTER);
+    spec.sideMask      = 2;
+    spec.toTimestamp   = kDay;
+    const auto response = engine.manipulate(makeRequest(spec));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const auto rows = decode(response);
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[0].tradeId, 2u);
+    EXPECT_EQ(rows[1].tradeId, 4u);
+
+    engine.clearTrades();
+    EXPECT_TRUE(decode(engine.manipulate(makeRequest(spec))).empty());
+}
+
+// ---------------------------------------------------------------------------
+// DAILY_PIVOT
+// ---------------------------------------------------------------------------
+
+TEST(ManipulationEngineTest, DailyPivotGroupsByDaySymbolAndSide)
+{
+    ManipulationEngine engine;
+    const auto response = engine.transform(makeRequest(makeSpec(ManipulationOp::DAILY_PIVOT), dayOfFills()));
+    ASSERT_TRUE(response.success) << response.message;
+
+    const auto rows = decode(response);
+    ASSERT_EQ(rows.size(), 4u);
+
+    EXPECT_STREQ(rows[0].symbol, "AAPL");
+    EXPECT_EQ(rows[0].side, 0u);
+    EXPECT_EQ(rows[0].timestamp, 0);
+    EXPECT_EQ(rows[0].tradeId, 2u); // fill count
+    EXPECT_EQ(rows[0].quantity, 40u);
+    EXPECT_DOUBLE_EQ(rows[0].price, (100.0 * 10 + 110.0 * 30) / 40.0);
+
+    EXPECT_STREQ(rows[1].symbol, "AAPL");
+    EXPECT_EQ(rows[1].side, 1u);
+    EXPECT_STREQ(rows[2].symbol, "MSFT");
+
+    EXPECT_STREQ(rows[3].symbol, "AAPL");
+    EXPECT_EQ(rows[3].timestamp, kDay);
+    EXPECT_EQ(rows[3].quantity, 1u);
+}
+
+TEST(ManipulationEngineTest, ResidentPivotFromAggregatesMatchesAScan)
+{
+    ManipulationEngine engine;
+    const auto         fills = dayOfFills();
+    engine.recordTrades(fills.data(), fills.size());
+
+    // No price or quantity predicate, bounds on midnights: answered from the daily summaries.
+    ManipulationSpecPOD spec = makeSpec(ManipulationOp::DAILY_PIVOT);
+    expectSameRows(decode(engine.transform(makeRequest(spec))), decode(engine.transform(makeRequest(spec, fills))));
+
+    spec.toTimestamp = kDay;
+    spec.sideMask    = 1;
+    expectSameRows(decode(engine.transform(makeRequest(spec))), decode(engine.transform(makeRequest(spec, fills))));
+    EXPECT_EQ(decode(engine.transform(makeRequest(spec))).size(), 1u);
+
+    // A bound inside a day, or a price band, still scans the trades.
+    ManipulationSpecPOD partial = makeSpec(ManipulationOp::DAILY_PIVOT, "AAPL");
+    partial.fromTimestamp       = 10 * 3600LL * 1000000;
+    partial.minPrice            = 106.0;
+    const auto rows             = decode(engine.transform(makeRequest(partial)));
+    expectSameRows(rows, decode(engine.transform(makeRequest(partial, fills))));
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[0].quantity, 30u);
+
+    EXPECT_TRUE(decode(engine.transform(makeRequest(makeSpec(ManipulationOp::DAILY_PIVOT, "TSLA")))).empty());
+    engine.clearTrades();
+    EXPECT_TRUE(decode(engine.transform(makeRequest(makeSpec(ManipulationOp::DAILY_PIVOT)))).empty());
+}
+
+TEST(ManipulationEngineTest, DaySummariesAreOrderedBySymbol)
+{
+    ManipulationEngine engine;
+    const auto         fills = dayOfFills();
+    engine.recordTrades(fills.data(), fills.size());
+
+    const auto summaries = engine.daySummaries(0);
+    ASSERT_EQ(summaries.size(), 2u);
+    EXPECT_STREQ(summaries[0].symbol.bytes, "AAPL");
+    EXPECT_EQ(summaries[0].summary.ohlcv.volume, 44u);
+    EXPECT_DOUBLE_EQ(summaries[0].summary.ohlcv.open, 100.0);
+    EXPECT_DOUBLE_EQ(summaries[0].summary.ohlcv.close, 105.0);
+    EXPECT_STREQ(summaries[1].symbol.bytes, "MSFT");
+    EXPECT_EQ(engine.daySummaries(1).size(), 1u);
+    EXPECT_TRUE(engine.daySummaries(2).empty());
+}
+
+// ---------------------------------------------------------------------------
+// OHLCV_BARS
+// ---------------------------------------------------------------------------
+
+TEST(ManipulationEngineTest, BarsOfTheResidentStore)
+{
+    ManipulationEngine engine(TradeAggregatesConfig{3600LL * 1000000, 48});
+    const auto         fills = dayOfFills();
+    engine.recordTrades(fills.data(), fills.size());
+
+    const auto response = engine.transform(makeRequest(makeSpec(ManipulationOp::OHLCV_BARS, "AAPL")));
+    ASSERT_TRUE(response.success) << response.message;
+    const auto bars = decodeBars(response);
+    ASSERT_EQ(bars.size(), 4u);
+    EXPECT_STREQ(bars[0].symbol, "AAPL");
+    EXPECT_EQ(bars[0].start, 9 * 3600LL * 1000000);
+    EXPECT_EQ(bars[0].intervalMicros, 3600LL * 1000000);
+    EXPECT_EQ(bars[0].volume, 10u);
+    EXPECT_DOUBLE_EQ(bars[1].vwap, 110.0);
+    EXPECT_EQ(bars[3].start, kDay);
+
+    // All symbols, ordered by symbol then start; the time range selects bars by start.
+    ManipulationSpecPOD spec = makeSpec(ManipulationOp::OHLCV_BARS);
+    spec.toTimestamp         = kDay;
+    const auto all           = decodeBars(engine.transform(makeRequest(spec)));
+    ASSERT_EQ(all.size(), 4u);
+    EXPECT_STREQ(all[2].symbol, "AAPL");
+    EXPECT_STREQ(all[3].symbol, "MSFT");
+}
+
+TEST(ManipulationEngineTest, BarsOfRequestTradesAndUnsupportedPredicates)
+{
+    ManipulationEngine engine(TradeAggregatesConfig{kDay, 8});
+    const auto         bars = decodeBars(engine.transform(makeRequest(makeSpec(ManipulationOp::OHLCV_BARS), dayOfFills())));
+    ASSERT_EQ(bars.size(), 3u);
+    EXPECT_STREQ(bars[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(bars[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(bars[0].high, 110.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 105.0);
+    EXPECT_EQ(bars[0].fills, 3u);
+
+    ManipulationSpecPOD spec = makeSpec(ManipulationOp::OHLCV_BARS);
+    spec.minQuantity         = 5;
+    const auto response      = engine.transform(makeRequest(spec));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("only symbol and time"), std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// Errors and routing
+// ---------------------------------------------------------------------------
+
+TEST(ManipulationEngineTest, RejectsUnsupportedOperationsAndBadPayloads)
+{
+    ManipulationEngine  engine;
+    ManipulationSpecPOD spec = makeSpec(ManipulationOp::FILTER);
+    spec.op                  = 42;
+
+    auto response = engine.manipulate(makeRequest(spec));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("unsupported operation 42"), std::string::npos);
+
+    response = engine.transform(makeRequest(makeSpec(ManipulationOp::FILTER)));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("unsupported operation"), std::string::npos);
+
+    Request empty;
+    empty.type = RequestType::MANIPULATE;
+    response   = engine.manipulate(empty);
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("truncated"), std::string::npos);
+}
+
+TEST(ManipulationEngineTest, CommandRoutesPivotToTransform)
+{
+    ManipulationEngine engine;
+    const auto         fills = dayOfFills();
+
+    const auto pivot = ManipulationCommand::run(engine, makeRequest(makeSpec(ManipulationOp::DAILY_PIVOT), fills));
+    ASSERT_TRUE(pivot.success) << pivot.message;
+    EXPECT_EQ(decode(pivot).size(), 4u);
+
+    const auto filtered = ManipulationCommand::run(engine, makeRequest(makeSpec(ManipulationOp::FILTER), fills));
+    ASSERT_TRUE(filtered.success) << filtered.message;
+    EXPECT_EQ(decode(filtered).size(), 5u);
+
+    const auto bars = ManipulationCommand::run(engine, makeRequest(makeSpec(ManipulationOp::OHLCV_BARS), fills));
+    ASSERT_TRUE(bars.success) << bars.message;
+    EXPECT_FALSE(decodeBars(bars).empty());
+}
@@ -0,0 +1,367 @@
+/**
+ * @file test_MatchingEngine.cpp
+ * @brief Unit tests for MatchingEngine and the order entry path.
+ *
+ * Tests: a crossing order is acknowledged with its fills and both sides of
+ * every match reach the trade sink, accepted orders reach the order sink,
+ * cancels take orders off their book, malformed and unsupported orders
+ * are rejected on the caller's thread, order ids are unique per symbol on
+ * one shard and on two, symbols spread over several shards,
+ * requests after stop() fail, and SUBMIT_ORDER works through the registry
+ * and the facade's async path.
+ */
+
+#include <gtest/gtest.h>
+
+#include "MatchingEngine.hpp"
+#include "TradingServerFacade.hpp"
+#include "commands/OrderCommand.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    OrderPOD makeOrder(uint64_t id, const char* symbol, uint8_t side, uint8_t type, double price, uint64_t quantity)
+    {
+        OrderPOD order{};
+        order.orderId = id;
+        std::strncpy(order.symbol, symbol, sizeof(order.symbol) - 1);
+        order.price     = price;
+        order.quantity  = quantity;
+        order.side      = side;
+        order.type      = type;
+        order.timestamp = 1700000000000000;
+        return order;
+    }
+
+    Request submitRequest(const OrderPOD& order)
+    {
+        Request req;
+        req.type    = RequestType::SUBMIT_ORDER;
+        req.payload = makePodPayload(&order, 1);
+        return req;
+    }
+
+    Request cancelRequest(uint64_t id, const char* symbol)
+    {
+        OrderCancelPOD cancel{};
+        cancel.orderId = id;
+        std::strncpy(cancel.symbol, symbol, sizeof(cancel.symbol) - 1);
+        Request req;
+        req.type    = RequestType::CANCEL_ORDER;
+        req.payload = makePodPayload(&cancel, 1);
+        return req;
+    }
+
+    /// Run @p call and wait for the response it completes.
+    template <typename Call>
+    Response await(Call call)
+    {
+        auto done  = std::make_shared<std::promise<Response>>();
+        auto reply = done->get_future();
+        call([done](Response response) { done->set_value(std::move(response)); });
+        EXPECT_EQ(reply.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        return reply.get();
+    }
+
+    struct Reply
+    {
+        OrderAckPOD           ack{};
+        std::vector<TradePOD> fills;
+    };
+
+    Reply parse(const Response& response)
+    {
+        Reply                     reply;
+        PodArrayView<OrderAckPOD> acks;
+        std::size_t               consumed = 0;
+        EXPECT_EQ(pod::bindSection(response.data.data(), response.data.size(), acks, consumed), PodDecodeStatus::OK);
+        EXPECT_EQ(acks.size(), 1u);
+        reply.ack = acks[0];
+
+        PodArrayView<TradePOD> fills;
+        EXPECT_EQ(pod::bindArray(response.data.data() + consumed, response.data.size() - consumed, fills),
+                  PodDecodeStatus::OK);
+        reply.fills.assign(fills.begin(), fills.end());
+        return reply;
+    }
+
+    /// Trade and order sinks that keep everything they receive.
+    struct Sinks
+    {
+        MatchingEngine::TradeSink trades()
+        {
+            return [this](const TradePOD* records, std::size_t count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                tradeLog.insert(tradeLog.end(), records, records + count);
+            };
+        }
+
+        MatchingEngine::OrderSink orders()
+        {
+            return [this](const OrderPOD* records, std::size_t count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                orderLog.insert(orderLog.end(), records, records + count);
+            };
+        }
+
+        std::size_t tradeCount()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return tradeLog.size();
+        }
+
+        std::mutex            mutex;
+        std::vector<TradePOD> tradeLog;
+        std::vector<OrderPOD> orderLog;
+    };
+
+    /// Poll @p condition for up to a second.
+    template <typename Condition>
+    bool eventually(Condition condition)
+    {
+        for (int i = 0; i < 1000 && !condition(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return condition();
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Matching and publishing
+// ---------------------------------------------------------------------------
+
+TEST(MatchingEngineTest, CrossingOrderIsAcknowledgedWithItsFillsAndBothSidesArePublished)
+{
+    Sinks          sinks;
+    MatchingEngine engine(MatchingEngineConfig{}, sinks.trades(), sinks.orders());
+
+    Response resting = await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(1, "AAPL", 1, 1, 150.25, 10)), std::move(done));
+    });
+    ASSERT_TRUE(resting.success) << resting.message;
+    EXPECT_EQ(resting.message, "Resting");
+    EXPECT_EQ(parse(resting).ack.status, static_cast<uint8_t>(OrderStatus::RESTING));
+
+    // A market buy for 4: filled at the resting price.
+    const Response filled = await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(2, "AAPL", 0, 0, 0.0, 4)), std::move(done));
+    });
+    ASSERT_TRUE(filled.success) << filled.message;
+    const Reply reply = parse(filled);
+    EXPECT_EQ(reply.ack.orderId, 2u);
+    EXPECT_EQ(reply.ack.status, static_cast<uint8_t>(OrderStatus::FILLED));
+    EXPECT_EQ(reply.ack.filledQuantity, 4u);
+    EXPECT_EQ(reply.ack.fillCount, 1u);
+    ASSERT_EQ(reply.fills.size(), 1u);
+    EXPECT_EQ(reply.fills[0].orderId, 2u);
+    EXPECT_DOUBLE_EQ(reply.fills[0].price, 150.25);
+    EXPECT_EQ(reply.fills[0].quantity, 4u);
+    EXPECT_EQ(reply.fills[0].side, 0u);
+    EXPECT_STREQ(reply.fills[0].symbol, "AAPL");
+
+    ASSERT_TRUE(eventually([&sinks]() { return sinks.tradeCount() == 2; }));
+    std::lock_guard<std::mutex> lock(sinks.mutex);
+    EXPECT_EQ(sinks.tradeLog[0].tradeId, reply.fills[0].tradeId);
+    EXPECT_EQ(sinks.tradeLog[1].tradeId, reply.fills[0].tradeId);
+    EXPECT_EQ(sinks.tradeLog[1].orderId, 1u);
+    EXPECT_EQ(sinks.tradeLog[1].side, 1u);
+    ASSERT_EQ(sinks.orderLog.size(), 2u);
+    EXPECT_EQ(sinks.orderLog[0].orderId, 1u);
+    EXPECT_EQ(sinks.orderLog[1].orderId, 2u);
+
+    const MatchingEngineStats stats = engine.stats();
+    EXPECT_EQ(stats.orders, 2u);
+    EXPECT_EQ(stats.executions, 1u);
+    EXPECT_EQ(stats.resting, 1u);
+}
+
+TEST(MatchingEngineTest, CancelTakesAnOrderOffItsBook)
+{
+    MatchingEngine engine;
+    await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(7, "MSFT", 0, 1, 99.5, 3)), std::move(done));
+    });
+
+    const Response cancelled = await([&](ResponseCallback done) {
+        engine.cancel(cancelRequest(7, "MSFT"), std::move(done));
+    });
+    ASSERT_TRUE(cancelled.success) << cancelled.message;
+    const Reply reply = parse(cancelled);
+    EXPECT_EQ(reply.ack.status, static_cast<uint8_t>(OrderStatus::CANCELLED));
+    EXPECT_EQ(reply.ack.remainingQuantity, 3u);
+    EXPECT_TRUE(reply.fills.empty());
+
+    // Nothing left to cancel, or to sell to.
+    EXPECT_FALSE(await([&](ResponseCallback done) { engine.cancel(cancelRequest(7, "MSFT"), std::move(done)); })
+                     .success);
+    EXPECT_FALSE(await([&](ResponseCallback done) { engine.cancel(cancelRequest(7, "IBM"), std::move(done)); })
+                     .success);
+    const Response unmatched = await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(8, "MSFT", 1, 0, 0.0, 1)), std::move(done));
+    });
+    EXPECT_EQ(parse(unmatched).ack.status, static_cast<uint8_t>(OrderStatus::CANCELLED));
+
+    const MatchingEngineStats stats = engine.stats();
+    EXPECT_EQ(stats.cancels, 1u);
+    EXPECT_EQ(stats.rejected, 1u); // the unknown id on a known symbol; IBM never reached a book
+    EXPECT_EQ(stats.resting, 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Validation
+// ---------------------------------------------------------------------------
+
+TEST(MatchingEngineTest, RejectsMalformedAndUnsupportedOrdersOnTheCallersThread)
+{
+    MatchingEngine engine;
+    const auto     rejectedInline = [&engine](const OrderPOD& order) {
+        Response response;
+        bool     called = false;
+        engine.submit(submitRequest(order), [&](Response r) {
+            response = std::move(r);
+            called   = true;
+        });
+        EXPECT_TRUE(called);
+        EXPECT_FALSE(response.success);
+        return response.message;
+    };
+
+    EXPECT_EQ(rejectedInline(makeOrder(0, "AAPL", 0, 1, 1.0, 1)), "MatchingEngine: order id 0 is reserved");
+    EXPECT_EQ(rejectedInline(makeOrder(1, "AAPL", 0, 1, 1.0, 0)), "MatchingEngine: quantity must be positive");
+    EXPECT_EQ(rejectedInline(makeOrder(1, "AAPL", 2, 1, 1.0, 1)), "MatchingEngine: side must be 0 (buy) or 1 (sell)");
+    EXPECT_EQ(rejectedInline(makeOrder(1, "AAPL", 0, 2, 1.0, 1)), "MatchingEngine: stop orders are not supported");
+    EXPECT_EQ(rejectedInline(makeOrder(1, "AAPL", 0, 1, 1.005, 1)),
+              "MatchingEngine: limit price must be a positive multiple of the tick size");
+    EXPECT_EQ(rejectedInline(makeOrder(1, "AAPL", 0, 1, -1.0, 1)),
+              "MatchingEngine: limit price must be a positive multiple of the tick size");
+
+    Request wrongSchema;
+    wrongSchema.type = RequestType::SUBMIT_ORDER;
+    const Response bad = await([&](ResponseCallback done) { engine.submit(wrongSchema, std::move(done)); });
+    EXPECT_FALSE(bad.success);
+
+    EXPECT_THROW(MatchingEngine(MatchingEngineConfig{0}), std::invalid_argument);
+}
+
+TEST(MatchingEngineTest, DuplicateRestingIdIsRejected)
+{
+    MatchingEngine engine;
+    await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(5, "AAPL", 0, 1, 10.0, 1)), std::move(done));
+    });
+    const Response duplicate = await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(5, "AAPL", 0, 1, 10.5, 1)), std::move(done));
+    });
+    EXPECT_FALSE(duplicate.success);
+    EXPECT_EQ(duplicate.message, "MatchingEngine: duplicate order id");
+}
+
+/// AAPL and MSFT are interned as ids 0 and 1: one shard, or one each.
+class MatchingEngineOrderIdTest : public ::testing::TestWithParam<std::size_t>
+{};
+
+TEST_P(MatchingEngineOrderIdTest, IdsAreUniquePerSymbolWhateverTheShards)
+{
+    MatchingEngineConfig config;
+    config.shards = GetParam();
+    MatchingEngine engine(config);
+
+    const auto submit = [&](const OrderPOD& order) {
+        return await([&](ResponseCallback done) { engine.submit(submitRequest(order), std::move(done)); });
+    };
+    EXPECT_EQ(submit(makeOrder(5, "AAPL", 0, 1, 10.0, 1)).message, "Resting");
+    EXPECT_EQ(submit(makeOrder(5, "MSFT", 0, 1, 20.0, 2)).message, "Resting");
+    EXPECT_EQ(submit(makeOrder(5, "MSFT", 1, 1, 30.0, 1)).message, "MatchingEngine: duplicate order id");
+    EXPECT_EQ(engine.stats().resting, 2u);
+
+    // A cancel takes the id off its own symbol only.
+    const Response cancelled = await([&](ResponseCallback done) {
+        engine.cancel(cancelRequest(5, "MSFT"), std::move(done));
+    });
+    ASSERT_TRUE(cancelled.success);
+    EXPECT_EQ(parse(cancelled).ack.remainingQuantity, 2u);
+
+    const Response fill = submit(makeOrder(6, "AAPL", 1, 1, 10.0, 1));
+    ASSERT_EQ(parse(fill).fills.size(), 1u);
+    EXPECT_EQ(engine.stats().resting, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(OneAndTwoShards, MatchingEngineOrderIdTest, ::testing::Values(1u, 2u));
+
+// ---------------------------------------------------------------------------
+// Shards and lifetime
+// ---------------------------------------------------------------------------
+
+TEST(MatchingEngineTest, SymbolsSpreadOverShardsMatchIndependently)
+{
+    MatchingEngineConfig config;
+    config.shards = 3;
+    Sinks          sinks;
+    MatchingEngine engine(config, sinks.trades());
+
+    const char* symbols[] = {"S0", "S1", "S2", "S3", "S4", "S5"};
+    uint64_t    id        = 1;
+    for (const char* symbol : symbols)
+        await([&](ResponseCallback done) {
+            engine.submit(submitRequest(makeOrder(id++, symbol, 1, 1, 5.0, 2)), std::move(done));
+        });
+    for (const char* symbol : symbols)
+    {
+        const Response fill = await([&](ResponseCallback done) {
+            engine.submit(submitRequest(makeOrder(id++, symbol, 0, 1, 5.0, 2)), std::move(done));
+        });
+        ASSERT_EQ(parse(fill).fills.size(), 1u) << symbol;
+        EXPECT_STREQ(parse(fill).fills[0].symbol, symbol);
+    }
+
+    ASSERT_TRUE(eventually([&sinks]() { return sinks.tradeCount() == 12; }));
+    EXPECT_EQ(engine.stats().executions, 6u);
+    EXPECT_EQ(engine.stats().resting, 0u);
+}
+
+TEST(MatchingEngineTest, RequestsAfterStopFail)
+{
+    MatchingEngine engine;
+    engine.stop();
+    const Response late = await([&](ResponseCallback done) {
+        engine.submit(submitRequest(makeOrder(1, "AAPL", 0, 1, 1.0, 1)), std::move(done));
+    });
+    EXPECT_FALSE(late.success);
+    EXPECT_EQ(late.message, "MatchingEngine: shutting down");
+}
+
+TEST(MatchingEngineTest, OrdersCompleteThroughTheRegistryAndTheFacade)
+{
+    auto            engine = std::make_shared<MatchingEngine>();
+    CommandRegistry registry;
+    registry.registerAsyncHandler(RequestType::SUBMIT_ORDER, [engine](const Request& req, ResponseCallback done) {
+        OrderCommand::run(*engine, req, std::move(done));
+    });
+    TradingServerFacade facade(nullptr, nullptr, nullptr, nullptr, std::move(registry));
+
+    std::thread::id completedOn;
+    const Response  viaAsync = await([&](ResponseCallback done) {
+        facade.handleRequestAsync(submitRequest(makeOrder(1, "AAPL", 0, 1, 2.0, 1)),
+                                  [&completedOn, done](Response r) {
+                                      completedOn = std::this_thread::get_id();
+                                      done(std::move(r));
+                                  });
+    });
+    EXPECT_TRUE(viaAsync.success) << viaAsync.message;
+    EXPECT_NE(completedOn, std::this_thread::get_id()); // on the shard's owner thread
+
+    // The synchronous path (and BATCH) waits for the owner thread.
+    const Response viaSync = facade.handleRequest(submitRequest(makeOrder(2, "AAPL", 1, 1, 2.0, 1)));
+    EXPECT_TRUE(viaSync.success) << viaSync.message;
+    EXPECT_EQ(viaSync.message, "Filled");
+    EXPECT_EQ(OrderCommand(engine, submitRequest(makeOrder(3, "AAPL", 1, 0, 0.0, 1))).execute().message,
+              "Cancelled");
+}
@@ -0,0 +1,318 @@
+/**
+ * @file test_MulticastFeed.cpp
+ * @brief Unit tests for the sequenced multicast feed and its UDP sender.
+ *
+ * Tests: ticks are batched into full datagrams with consecutive sequence
+ * numbers, partial batches go out after the flush interval or at once when
+ * it is 0, recovery returns retained ticks and clamps aged-out, future and
+ * oversized ranges, malformed recovery requests are rejected, and the UDP
+ * sender delivers datagrams to a local receiver. A fake IDatagramPublisher
+ * records every datagram.
+ */
+
+#include <gtest/gtest.h>
+
+#include "MulticastFeed.hpp"
+#include "UdpMulticastSender.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class FakeSink : public IDatagramPublisher
+    {
+    public:
+        bool sendDatagram(const uint8_t* data, std::size_t size) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            datagrams.emplace_back(data, data + size);
+            return !failing;
+        }
+
+        std::vector<std::vector<uint8_t>> sent()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return datagrams;
+        }
+
+        std::mutex                        mutex;
+        std::vector<std::vector<uint8_t>> datagrams;
+        bool                              failing{false};
+    };
+
+    struct Packet
+    {
+        MarketDataPacketHeaderPOD  header{};
+        std::vector<MarketDataPOD> ticks;
+    };
+
+    Packet parse(const std::vector<uint8_t>& datagram)
+    {
+        Packet packet;
+        EXPECT_GE(datagram.size(), sizeof(packet.header));
+        std::memcpy(&packet.header, datagram.data(), sizeof(packet.header));
+        EXPECT_EQ(datagram.size(), sizeof(packet.header) + packet.header.count * sizeof(MarketDataPOD));
+        packet.ticks.resize(packet.header.count);
+        std::memcpy(packet.ticks.data(), datagram.data() + sizeof(packet.header),
+                    packet.ticks.size() * sizeof(MarketDataPOD));
+        return packet;
+    }
+
+    MarketDataPOD makeTick(double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, "AAPL", sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+
+    Request recoveryRequest(uint64_t fromSequence, uint32_t count)
+    {
+        const MarketDataRecoveryPOD range{fromSequence, count, 0};
+        Request req;
+        req.type    = RequestType::RECOVER_MARKET_DATA;
+        req.payload = makePodPayload(&range, 1);
+        return req;
+    }
+
+    std::vector<SequencedMarketDataPOD> recovered(const Response& response)
+    {
+        EXPECT_TRUE(response.success) << response.message;
+        PodArrayView<SequencedMarketDataPOD> view;
+        EXPECT_EQ(pod::bindArray(response.data.data(), response.data.size(), view), PodDecodeStatus::OK);
+        return std::vector<SequencedMarketDataPOD>(view.begin(), view.end());
+    }
+
+    /// Three ticks per datagram, no timer flush unless @p flush is given.
+    MulticastFeedConfig smallDatagrams(std::chrono::microseconds flush = std::chrono::seconds(10))
+    {
+        MulticastFeedConfig config;
+        config.maxDatagramBytes = sizeof(MarketDataPacketHeaderPOD) + 3 * sizeof(MarketDataPOD);
+        config.flushInterval    = flush;
+        return config;
+    }
+
+    struct Fixture
+    {
+        explicit Fixture(MulticastFeedConfig config = smallDatagrams())
+            : feed(marketData, sink, config)
+        {
+        }
+
+        void publish(int ticks)
+        {
+            for (int i = 0; i < ticks; ++i)
+                marketData->update(makeTick(100.0 + ++published));
+        }
+
+        // Declared before the feed, which is built from them.
+        std::shared_ptr<InMemoryMarketDataService> marketData = std::make_shared<InMemoryMarketDataService>(16);
+        std::shared_ptr<FakeSink>                  sink       = std::make_shared<FakeSink>();
+        MulticastFeed                              feed;
+        int                                        published{0};
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Publishing
+// ---------------------------------------------------------------------------
+
+TEST(MulticastFeedTest, BatchesTicksIntoFullDatagramsWithConsecutiveSequences)
+{
+    Fixture f;
+    ASSERT_EQ(f.feed.ticksPerDatagram(), 3u);
+
+    f.publish(7);
+    std::vector<std::vector<uint8_t>> sent = f.sink->sent();
+    ASSERT_EQ(sent.size(), 2u); // the seventh tick waits for its datagram to fill
+
+    f.feed.flush();
+    sent = f.sink->sent();
+    ASSERT_EQ(sent.size(), 3u);
+
+    uint64_t expected = 1;
+    for (const auto& datagram : sent)
+    {
+        const Packet packet = parse(datagram);
+        EXPECT_EQ(packet.header.magic, kMarketDataPacketMagic);
+        EXPECT_EQ(packet.header.version, kMarketDataPacketVersion);
+        EXPECT_EQ(packet.header.epoch, f.feed.epoch());
+        EXPECT_EQ(packet.header.sequence, expected);
+        for (const MarketDataPOD& tick : packet.ticks)
+            EXPECT_DOUBLE_EQ(tick.last, 100.0 + static_cast<double>(expected++));
+    }
+    EXPECT_EQ(expected, 8u);
+
+    const MulticastFeedStats stats = f.feed.stats();
+    EXPECT_EQ(stats.ticks, 7u);
+    EXPECT_EQ(stats.datagrams, 3u);
+}
+
+TEST(MulticastFeedTest, FlushesAPartialBatchAfterTheInterval)
+{
+    Fixture f(smallDatagrams(std::chrono::milliseconds(1)));
+    f.publish(2);
+
+    for (int i = 0; i < 1000 && f.sink->sent().empty(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const std::vector<std::vector<uint8_t>> sent = f.sink->sent();
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(parse(sent[0]).header.count, 2u);
+}
+
+TEST(MulticastFeedTest, ZeroIntervalSendsEveryTickAlone)
+{
+    Fixture f(smallDatagrams(std::chrono::microseconds(0)));
+    f.publish(3);
+
+    const std::vector<std::vector<uint8_t>> sent = f.sink->sent();
+    ASSERT_EQ(sent.size(), 3u);
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+        const Packet packet = parse(sent[i]);
+        EXPECT_EQ(packet.header.count, 1u);
+        EXPECT_EQ(packet.header.sequence, i + 1);
+    }
+}
+
+TEST(MulticastFeedTest, StopSendsTheBatchAndCountsFailures)
+{
+    Fixture f;
+    f.sink->failing = true;
+    f.publish(4);
+    f.feed.stop();
+
+    EXPECT_EQ(f.sink->sent().size(), 2u);
+    EXPECT_EQ(f.feed.stats().sendFailures, 2u);
+
+    f.publish(1); // after stop(), nothing waits for a datagram to fill
+    EXPECT_EQ(f.sink->sent().size(), 3u);
+}
+
+// ---------------------------------------------------------------------------
+// Recovery
+// ---------------------------------------------------------------------------
+
+TEST(MulticastFeedTest, RecoversARetainedRange)
+{
+    Fixture f;
+    f.publish(5);
+
+    const Response response = f.feed.recover(recoveryRequest(2, 3));
+    EXPECT_EQ(response.message, "Recovered");
+    const auto ticks = recovered(response);
+    ASSERT_EQ(ticks.size(), 3u);
+    for (std::size_t i = 0; i < ticks.size(); ++i)
+    {
+        EXPECT_EQ(ticks[i].sequence, i + 2);
+        EXPECT_DOUBLE_EQ(ticks[i].data.last, 100.0 + static_cast<double>(i + 2));
+    }
+    EXPECT_EQ(f.feed.stats().recoveredTicks, 3u);
+}
+
+TEST(MulticastFeedTest, ClampsAgedOutFutureAndOversizedRanges)
+{
+    MulticastFeedConfig config = smallDatagrams();
+    config.historySize         = 4;
+    config.maxRecoveryTicks    = 3;
+    Fixture f(config);
+    f.publish(10); // sequences 7..10 are retained
+
+    // 3..6 have aged out: the reply starts later than asked, so the client re-snapshots.
+    const Response agedOut = f.feed.recover(recoveryRequest(3, 6));
+    EXPECT_EQ(agedOut.message, "Recovered (older ticks aged out)");
+    auto ticks = recovered(agedOut);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].sequence, 7u);
+    EXPECT_EQ(ticks[1].sequence, 8u);
+    EXPECT_EQ(f.feed.stats().agedOutTicks, 4u);
+
+    // At most maxRecoveryTicks, and nothing past the last tick published.
+    ticks = recovered(f.feed.recover(recoveryRequest(7, 100)));
+    ASSERT_EQ(ticks.size(), 3u);
+    EXPECT_EQ(ticks[2].sequence, 9u);
+    EXPECT_EQ(recovered(f.feed.recover(recoveryRequest(10, 5))).size(), 1u);
+    EXPECT_TRUE(recovered(f.feed.recover(recoveryRequest(11, 5))).empty());
+}
+
+TEST(MulticastFeedTest, RejectsMalformedRecoveryRequests)
+{
+    Fixture f;
+    f.publish(1);
+
+    EXPECT_FALSE(f.feed.recover(recoveryRequest(1, 0)).success);
+    EXPECT_FALSE(f.feed.recover(recoveryRequest(0, 1)).success);
+
+    const MarketDataRecoveryPOD two[] = {{1, 1, 0}, {2, 1, 0}};
+    Request req;
+    req.type    = RequestType::RECOVER_MARKET_DATA;
+    req.payload = makePodPayload(two, 2);
+    EXPECT_FALSE(f.feed.recover(req).success);
+
+    const SymbolPOD symbol{};
+    req.payload = makePodPayload(&symbol, 1);
+    EXPECT_FALSE(f.feed.recover(req).success);
+}
+
+TEST(MulticastFeedTest, RejectsInvalidConfiguration)
+{
+    auto marketData = std::make_shared<InMemoryMarketDataService>(4);
+    auto sink       = std::make_shared<FakeSink>();
+
+    MulticastFeedConfig tiny;
+    tiny.maxDatagramBytes = sizeof(MarketDataPacketHeaderPOD);
+    EXPECT_THROW(MulticastFeed(marketData, sink, tiny), std::invalid_argument);
+
+    MulticastFeedConfig noHistory;
+    noHistory.historySize = 0;
+    EXPECT_THROW(MulticastFeed(marketData, sink, noHistory), std::invalid_argument);
+    EXPECT_THROW(MulticastFeed(marketData, nullptr), std::invalid_argument);
+}
+
+// ---------------------------------------------------------------------------
+// UDP sender
+// ---------------------------------------------------------------------------
+
+TEST(UdpMulticastSenderTest, DeliversDatagramsToALocalReceiver)
+{
+    using Udp = boost::asio::ip::udp;
+    boost::asio::io_context io;
+    Udp::socket             receiver(io, Udp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+
+    MulticastConfig config;
+    config.group = "127.0.0.1"; // unicast: multicast routing is not needed to test the framing
+    config.port  = receiver.local_endpoint().port();
+    auto sender  = std::make_shared<UdpMulticastSender>(config);
+
+    auto          marketData = std::make_shared<InMemoryMarketDataService>(4);
+    MulticastFeed feed(marketData, sender, smallDatagrams(std::chrono::microseconds(0)));
+    marketData->update(makeTick(1.0));
+    marketData->update(makeTick(2.0));
+
+    std::vector<uint8_t> buffer(2048);
+    for (uint64_t sequence = 1; sequence <= 2; ++sequence)
+    {
+        const std::size_t n = receiver.receive(boost::asio::buffer(buffer));
+        const Packet packet = parse(std::vector<uint8_t>(buffer.begin(), buffer.begin() + n));
+        EXPECT_EQ(packet.header.sequence, sequence);
+        ASSERT_EQ(packet.ticks.size(), 1u);
+        EXPECT_DOUBLE_EQ(packet.ticks[0].last, static_cast<double>(sequence));
+    }
+
+    const DatagramSenderStats stats = sender->stats();
+    EXPECT_EQ(stats.datagrams, 2u);
+    EXPECT_EQ(stats.bytes, 2 * (sizeof(MarketDataPacketHeaderPOD) + sizeof(MarketDataPOD)));
+    EXPECT_EQ(stats.errors, 0u);
+}
+
+TEST(UdpMulticastSenderTest, RejectsABadAddress)
+{
+    MulticastConfig config;
+    config.group = "not-an-address";
+    EXPECT_THROW(UdpMulticastSender{config}, boost::system::system_error);
+}
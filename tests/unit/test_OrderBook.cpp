@@ -0,0 +1,243 @@
+/**
+ * @file test_OrderBook.cpp
+ * @brief Unit tests for OrderBook and its OrderIndex.
+ *
+ * Tests: limit orders rest in price-time priority and an aggressor sweeps
+ * levels best first, market orders cancel what they cannot fill, cancels
+ * unlink orders and empty levels, duplicate ids and full pools are
+ * refused, the fill limit stops matching without resting, books of one
+ * shard are independent and scope their order ids, and the index survives
+ * churn (backward-shift deletion) and keeps one id apart per book.
+ */
+
+#include <gtest/gtest.h>
+
+#include "OrderBook.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    OrderBook::Order limit(uint64_t id, uint8_t side, int64_t ticks, uint64_t quantity)
+    {
+        return OrderBook::Order{id, ticks, quantity, side, false};
+    }
+
+    OrderBook::Order market(uint64_t id, uint8_t side, uint64_t quantity)
+    {
+        return OrderBook::Order{id, 0, quantity, side, true};
+    }
+
+    struct Fixture
+    {
+        explicit Fixture(OrderBookConfig config = {4, 64, 16})
+            : book(config)
+            , executions(16)
+        {}
+
+        OrderBook::Result submit(const OrderBook::Order& order, std::size_t bookIndex = 0)
+        {
+            return book.submit(bookIndex, order, executions.data(), executions.size());
+        }
+
+        OrderBook                         book;
+        std::vector<OrderBook::Execution> executions;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Matching
+// ---------------------------------------------------------------------------
+
+TEST(OrderBookTest, RestsInPriceTimePriorityAndSweepsBestFirst)
+{
+    Fixture f;
+    EXPECT_EQ(f.submit(limit(1, OrderBook::kSell, 101, 5)).status, OrderStatus::RESTING);
+    EXPECT_EQ(f.submit(limit(2, OrderBook::kSell, 100, 5)).status, OrderStatus::RESTING);
+    EXPECT_EQ(f.submit(limit(3, OrderBook::kSell, 100, 5)).status, OrderStatus::RESTING);
+
+    OrderBook::Level ask;
+    ASSERT_TRUE(f.book.best(0, OrderBook::kSell, ask));
+    EXPECT_EQ(ask.priceTicks, 100);
+    EXPECT_EQ(ask.quantity, 10u);
+    EXPECT_EQ(ask.orders, 2u);
+
+    // Crosses two levels; the limit keeps it from the rest of 101.
+    const OrderBook::Result result = f.submit(limit(4, OrderBook::kBuy, 101, 12));
+    EXPECT_EQ(result.status, OrderStatus::FILLED);
+    EXPECT_EQ(result.filled, 12u);
+    ASSERT_EQ(result.executions, 3u);
+    EXPECT_EQ(f.executions[0].restingOrderId, 2u); // the older order at the best price first
+    EXPECT_EQ(f.executions[1].restingOrderId, 3u);
+    EXPECT_EQ(f.executions[2].restingOrderId, 1u);
+    EXPECT_EQ(f.executions[2].priceTicks, 101);
+    EXPECT_EQ(f.executions[2].quantity, 2u);
+
+    ASSERT_TRUE(f.book.best(0, OrderBook::kSell, ask));
+    EXPECT_EQ(ask.priceTicks, 101);
+    EXPECT_EQ(ask.quantity, 3u);
+    EXPECT_EQ(f.book.restingOrders(), 1u);
+    EXPECT_EQ(f.book.levels(), 1u);
+
+    // Does not cross: rests as the new best bid.
+    const OrderBook::Result passive = f.submit(limit(5, OrderBook::kBuy, 99, 4));
+    EXPECT_EQ(passive.status, OrderStatus::RESTING);
+    EXPECT_EQ(passive.executions, 0u);
+    OrderBook::Level bid;
+    ASSERT_TRUE(f.book.best(0, OrderBook::kBuy, bid));
+    EXPECT_EQ(bid.priceTicks, 99);
+}
+
+TEST(OrderBookTest, MarketOrdersCancelWhatTheyCannotFill)
+{
+    Fixture f;
+    f.submit(limit(1, OrderBook::kBuy, 100, 3));
+    f.submit(limit(2, OrderBook::kBuy, 98, 3));
+
+    const OrderBook::Result result = f.submit(market(3, OrderBook::kSell, 10));
+    EXPECT_EQ(result.status, OrderStatus::CANCELLED);
+    EXPECT_EQ(result.filled, 6u);
+    EXPECT_EQ(result.remaining, 4u);
+    ASSERT_EQ(result.executions, 2u);
+    EXPECT_EQ(f.executions[0].priceTicks, 100);
+    EXPECT_EQ(f.executions[1].priceTicks, 98);
+
+    OrderBook::Level level;
+    EXPECT_FALSE(f.book.best(0, OrderBook::kBuy, level));
+    EXPECT_FALSE(f.book.best(0, OrderBook::kSell, level));
+    EXPECT_EQ(f.book.restingOrders(), 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Cancels and refusals
+// ---------------------------------------------------------------------------
+
+TEST(OrderBookTest, CancelUnlinksOrdersAndEmptyLevels)
+{
+    Fixture f;
+    f.submit(limit(1, OrderBook::kBuy, 100, 5));
+    f.submit(limit(2, OrderBook::kBuy, 100, 7));
+    f.submit(limit(3, OrderBook::kBuy, 99, 1));
+
+    OrderBook::Result result = f.book.cancel(0, 1);
+    EXPECT_EQ(result.outcome, OrderBook::Outcome::ACCEPTED);
+    EXPECT_EQ(result.remaining, 5u);
+    OrderBook::Level bid;
+    ASSERT_TRUE(f.book.best(0, OrderBook::kBuy, bid));
+    EXPECT_EQ(bid.quantity, 7u);
+    EXPECT_EQ(bid.orders, 1u);
+
+    f.book.cancel(0, 2);
+    ASSERT_TRUE(f.book.best(0, OrderBook::kBuy, bid));
+    EXPECT_EQ(bid.priceTicks, 99);
+    EXPECT_EQ(f.book.levels(), 1u);
+
+    EXPECT_EQ(f.book.cancel(0, 2).outcome, OrderBook::Outcome::UNKNOWN_ORDER);
+    EXPECT_EQ(f.book.cancel(1, 3).outcome, OrderBook::Outcome::UNKNOWN_ORDER); // another book's order
+    EXPECT_EQ(f.book.cancel(0, 3).outcome, OrderBook::Outcome::ACCEPTED);
+    EXPECT_EQ(f.book.restingOrders(), 0u);
+    EXPECT_EQ(f.book.levels(), 0u);
+}
+
+TEST(OrderBookTest, RefusesDuplicateIdsAndFullPools)
+{
+    Fixture f(OrderBookConfig{1, 2, 2});
+    f.submit(limit(1, OrderBook::kBuy, 100, 1));
+    EXPECT_EQ(f.submit(limit(1, OrderBook::kBuy, 101, 1)).outcome, OrderBook::Outcome::DUPLICATE_ID);
+
+    f.submit(limit(2, OrderBook::kBuy, 99, 1));
+    const OrderBook::Result full = f.submit(limit(3, OrderBook::kBuy, 98, 1));
+    EXPECT_EQ(full.outcome, OrderBook::Outcome::BOOK_FULL);
+    EXPECT_EQ(full.status, OrderStatus::CANCELLED);
+
+    // The order pool is full, but a crossing order still matches.
+    const OrderBook::Result cross = f.submit(limit(4, OrderBook::kSell, 100, 2));
+    EXPECT_EQ(cross.filled, 1u);
+    EXPECT_EQ(cross.status, OrderStatus::RESTING); // the fill freed a node for the rest
+    OrderBook::Level ask;
+    ASSERT_TRUE(f.book.best(0, OrderBook::kSell, ask));
+    EXPECT_EQ(ask.priceTicks, 100);
+
+    EXPECT_THROW(OrderBook(OrderBookConfig{1, 0, 1}), std::invalid_argument);
+}
+
+TEST(OrderBookTest, FillLimitStopsMatchingWithoutResting)
+{
+    Fixture f;
+    for (uint64_t id = 1; id <= 20; ++id)
+        f.submit(limit(id, OrderBook::kSell, 100, 1));
+
+    const OrderBook::Result result = f.submit(limit(99, OrderBook::kBuy, 100, 20));
+    EXPECT_EQ(result.outcome, OrderBook::Outcome::FILL_LIMIT);
+    EXPECT_EQ(result.status, OrderStatus::CANCELLED);
+    EXPECT_EQ(result.executions, f.executions.size());
+    EXPECT_EQ(result.remaining, 20u - f.executions.size());
+
+    // Nothing crossed was left on the bid side.
+    OrderBook::Level bid;
+    EXPECT_FALSE(f.book.best(0, OrderBook::kBuy, bid));
+}
+
+TEST(OrderBookTest, BooksOfOneShardAreIndependent)
+{
+    Fixture f;
+    f.submit(limit(1, OrderBook::kSell, 100, 1), 0);
+    const OrderBook::Result other = f.submit(limit(2, OrderBook::kBuy, 100, 1), 1);
+    EXPECT_EQ(other.status, OrderStatus::RESTING);
+    EXPECT_EQ(other.executions, 0u);
+}
+
+TEST(OrderBookTest, OrderIdsAreScopedToTheirBook)
+{
+    Fixture f;
+    EXPECT_EQ(f.submit(limit(7, OrderBook::kBuy, 100, 1), 0).status, OrderStatus::RESTING);
+    EXPECT_EQ(f.submit(limit(7, OrderBook::kBuy, 100, 2), 1).status, OrderStatus::RESTING);
+    EXPECT_EQ(f.submit(limit(7, OrderBook::kSell, 105, 1), 1).outcome, OrderBook::Outcome::DUPLICATE_ID);
+
+    const OrderBook::Result cancelled = f.book.cancel(1, 7);
+    EXPECT_EQ(cancelled.outcome, OrderBook::Outcome::ACCEPTED);
+    EXPECT_EQ(cancelled.remaining, 2u);
+    EXPECT_EQ(f.book.cancel(1, 7).outcome, OrderBook::Outcome::UNKNOWN_ORDER);
+    EXPECT_EQ(f.book.cancel(2, 7).outcome, OrderBook::Outcome::UNKNOWN_ORDER);
+
+    OrderBook::Level bid;
+    ASSERT_TRUE(f.book.best(0, OrderBook::kBuy, bid)); // book 0 keeps its id 7
+    EXPECT_EQ(bid.quantity, 1u);
+    EXPECT_EQ(f.book.restingOrders(), 1u);
+}
+
+// ---------------------------------------------------------------------------
+// OrderIndex
+// ---------------------------------------------------------------------------
+
+TEST(OrderIndexTest, SurvivesChurn)
+{
+    OrderIndex index(64);
+    for (uint64_t id = 1; id <= 64; ++id)
+        index.insert(0, id * 128, static_cast<uint32_t>(id)); // ids that share buckets
+
+    for (uint64_t id = 1; id <= 64; id += 2)
+        index.erase(0, id * 128);
+    for (uint64_t id = 1; id <= 64; ++id)
+        EXPECT_EQ(index.find(0, id * 128), id % 2 == 0 ? static_cast<uint32_t>(id) : kNilIndex) << id;
+
+    for (uint64_t id = 1; id <= 64; id += 2)
+        index.insert(0, id * 128, static_cast<uint32_t>(id + 1000));
+    EXPECT_EQ(index.find(0, 3 * 128), 1003u);
+    EXPECT_EQ(index.find(0, 4 * 128), 4u);
+    EXPECT_EQ(index.find(0, 7), kNilIndex);
+}
+
+TEST(OrderIndexTest, KeepsOneIdApartPerBook)
+{
+    OrderIndex index(8);
+    for (uint32_t book = 0; book < 8; ++book)
+        index.insert(book, 42, book + 100);
+    EXPECT_EQ(index.find(8, 42), kNilIndex);
+
+    for (uint32_t book = 0; book < 8; book += 2)
+        index.erase(book, 42);
+    for (uint32_t book = 0; book < 8; ++book)
+        EXPECT_EQ(index.find(book, 42), book % 2 == 0 ? kNilIndex : book + 100) << book;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_PayloadCompression.cpp
+ * @brief Unit tests for the optional payload codecs.
+ *
+ * Tests: round trips through every codec this build has, incompressible
+ * data left uncompressed, rejection of corrupt and oversized streams, codec
+ * preference and codec list parsing.
+ */
+
+#include <gtest/gtest.h>
+
+#include "PayloadCompression.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace compression;
+
+namespace
+{
+    /// Report-like text: compresses well.
+    std::vector<uint8_t> reportText(std::size_t lines)
+    {
+        std::string text;
+        for (std::size_t i = 0; i < lines; ++i)
+            text += "2026-10-14,SYM" + std::to_string(i % 64) + ",BUY,100,101.25\n";
+        return std::vector<uint8_t>(text.begin(), text.end());
+    }
+
+    /// xorshift noise: does not compress.
+    std::vector<uint8_t> noise(std::size_t size)
+    {
+        std::vector<uint8_t> bytes(size);
+        uint64_t             state = 0x9E3779B97F4A7C15ull;
+        for (uint8_t& b : bytes)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            b = static_cast<uint8_t>(state);
+        }
+        return bytes;
+    }
+
+    std::vector<Codec> builtCodecs()
+    {
+        std::vector<Codec> codecs;
+        for (Codec codec : {Codec::LZ4, Codec::ZSTD, Codec::DEFLATE})
+            if (availableCodecs() & codecBit(codec))
+                codecs.push_back(codec);
+        return codecs;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(PayloadCompressionTest, EveryBuiltCodecRoundTrips)
+{
+    const std::vector<uint8_t> input = reportText(5000);
+    PayloadCompressor          compressor;
+    for (Codec codec : builtCodecs())
+    {
+        // Twice: the second call reuses the contexts of the first.
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            PooledBuffer packed;
+            ASSERT_TRUE(compressor.compress(codec, input.data(), input.size(), packed)) << codecName(codec);
+            EXPECT_LT(packed.size(), input.size() / 4) << codecName(codec);
+
+            PooledBuffer restored;
+            ASSERT_TRUE(decompress(codec, packed.data(), packed.size(), restored, input.size())) << codecName(codec);
+            ASSERT_EQ(restored.size(), input.size());
+            EXPECT_EQ(std::memcmp(restored.data(), input.data(), input.size()), 0) << codecName(codec);
+        }
+    }
+}
+
+TEST(PayloadCompressionTest, IncompressibleAndMissingCodecsAreNotUsed)
+{
+    const std::vector<uint8_t> input = noise(64 * 1024);
+    PayloadCompressor          compressor;
+    PooledBuffer               packed;
+    for (Codec codec : builtCodecs())
+        EXPECT_FALSE(compressor.compress(codec, input.data(), input.size(), packed)) << codecName(codec);
+
+    const std::vector<uint8_t> text = reportText(100);
+    EXPECT_FALSE(compressor.compress(Codec::NONE, text.data(), text.size(), packed));
+    for (Codec codec : {Codec::LZ4, Codec::ZSTD, Codec::DEFLATE})
+    {
+        if (!(availableCodecs() & codecBit(codec)))
+        {
+            EXPECT_FALSE(compressor.compress(codec, text.data(), text.size(), packed)) << codecName(codec);
+        }
+    }
+}
+
+TEST(PayloadCompressionTest, DecompressRejectsCorruptAndOversizedStreams)
+{
+    const std::vector<uint8_t> input = reportText(1000);
+    PayloadCompressor          compressor;
+    for (Codec codec : builtCodecs())
+    {
+        PooledBuffer packed;
+        ASSERT_TRUE(compressor.compress(codec, input.data(), input.size(), packed));
+
+        PooledBuffer restored;
+        EXPECT_FALSE(decompress(codec, packed.data(), packed.size(), restored, input.size() - 1)) << codecName(codec);
+        EXPECT_FALSE(decompress(codec, packed.data(), packed.size() / 2, restored, input.size())) << codecName(codec);
+        EXPECT_FALSE(decompress(codec, packed.data(), 2, restored, input.size())) << codecName(codec);
+    }
+}
+
+TEST(PayloadCompressionTest, ChoosesByRatioOrSpeed)
+{
+    EXPECT_EQ(chooseCodec(kAllCodecs, true), Codec::ZSTD);
+    EXPECT_EQ(chooseCodec(kAllCodecs, false), Codec::LZ4);
+    EXPECT_EQ(chooseCodec(codecBit(Codec::LZ4) | codecBit(Codec::DEFLATE), true), Codec::DEFLATE);
+    EXPECT_EQ(chooseCodec(codecBit(Codec::ZSTD) | codecBit(Codec::DEFLATE), false), Codec::ZSTD);
+    EXPECT_EQ(chooseCodec(0, false), Codec::NONE);
+}
+
+TEST(PayloadCompressionTest, ParsesCodecLists)
+{
+    EXPECT_EQ(parseCodecs("lz4,deflate"), codecBit(Codec::LZ4) | codecBit(Codec::DEFLATE));
+    EXPECT_EQ(parseCodecs("all"), kAllCodecs);
+    EXPECT_EQ(parseCodecs("none"), 0);
+    EXPECT_THROW(parseCodecs("lz4,brotli"), std::invalid_argument);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file test_PipelinedServerFacade.cpp
+ * @brief Unit tests for the worker-pool request pipeline.
+ *
+ * Uses a controllable inner facade to verify that async requests complete
+ * on worker threads, that GET_MARKET_DATA is served while a slow report
+ * occupies another worker, that full lanes are rejected cheaply, that a
+ * streamed reply reaches the callback in order, that direct types skip
+ * the lanes, and that stop() racing producers still runs every callback
+ * exactly once.
+ */
+
+#include <gtest/gtest.h>
+
+#include "PipelinedServerFacade.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Inner facade whose GENERATE_REPORT requests block until released
+// ---------------------------------------------------------------------------
+
+class GatedFacade : public IServerFacade
+{
+public:
+    Response handleRequest(const Request& request) override
+    {
+        if (request.type == RequestType::GENERATE_REPORT)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_reportsStarted.fetch_add(1);
+            m_cv.wait(lock, [this]() { return m_released; });
+            return Response{true, "report", {}};
+        }
+        return Response{true, "quote", {}};
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_released = true;
+        m_cv.notify_all();
+    }
+
+    std::atomic<int>        m_reportsStarted{0};
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    bool                    m_released{false};
+};
+
+namespace
+{
+    Request makeRequest(RequestType type)
+    {
+        Request req;
+        req.type = type;
+        return req;
+    }
+
+    template <typename Pred>
+    bool waitFor(Pred pred)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(PipelinedServerFacadeTest, AsyncRequestCompletesOnWorkerThread)
+{
+    auto inner = std::make_shared<GatedFacade>();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{1, 16, {}});
+
+    std::promise<std::thread::id> workerId;
+    pipeline.handleRequestAsync(makeRequest(RequestType::GET_MARKET_DATA),
+        [&workerId](Response r) {
+            EXPECT_TRUE(r.success);
+            workerId.set_value(std::this_thread::get_id());
+        });
+
+    auto future = workerId.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+TEST(PipelinedServerFacadeTest, StreamedReplyArrivesInOrderOnOneWorker)
+{
+    class StreamingFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request&) override { return Response{true, "whole", {}}; }
+
+        Response handleRequestStreaming(const Request&, const ResponseCallback& onChunk) override
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                Response chunk{true, std::to_string(i), {}};
+                chunk.more = true;
+                onChunk(std::move(chunk));
+            }
+            return Response{true, "done", {}};
+        }
+    };
+
+    PipelinedServerFacade pipeline(std::make_shared<StreamingFacade>(), PipelineConfig{2, 16, {}});
+
+    std::mutex               mutex;
+    std::vector<std::string> messages;
+    std::set<std::thread::id> threads;
+    std::atomic<bool>        finished{false};
+    pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT), [&](Response r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(r.message);
+        threads.insert(std::this_thread::get_id());
+        if (!r.more)
+            finished = true;
+    });
+
+    ASSERT_TRUE(waitFor([&finished]() { return finished.load(); }));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(messages, (std::vector<std::string>{"0", "1", "2", "3", "done"}));
+    EXPECT_EQ(threads.size(), 1u);
+}
+
+TEST(PipelinedServerFacadeTest, MarketDataIsServedWhileReportsBlockOtherWorkers)
+{
+    auto inner = std::make_shared<GatedFacade>();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{2, 16, {}});
+
+    std::atomic<int> reportsDone{0};
+    for (int i = 0; i < 3; ++i)
+        pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT),
+            [&reportsDone](Response) { reportsDone.fetch_add(1); });
+
+    ASSERT_TRUE(waitFor([&]() { return inner->m_reportsStarted.load() == 1; }));
+
+    std::atomic<bool> quoteDone{false};
+    pipeline.handleRequestAsync(makeRequest(RequestType::GET_MARKET_DATA),
+        [&quoteDone](Response r) {
+            EXPECT_EQ(r.message, "quote");
+            quoteDone.store(true);
+        });
+
+    EXPECT_TRUE(waitFor([&]() { return quoteDone.load(); }));
+    EXPECT_EQ(reportsDone.load(), 0);
+
+    inner->release();
+    EXPECT_TRUE(waitFor([&]() { return reportsDone.load() == 3; }));
+}
+
+TEST(PipelinedServerFacadeTest, FullLaneRejectsWithFailureResponse)
+{
+    auto inner = std::make_shared<GatedFacade>();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{1, 2, {}});
+
+    std::atomic<int> completed{0};
+    pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT),
+        [&completed](Response) { completed.fetch_add(1); });
+    ASSERT_TRUE(waitFor([&]() { return inner->m_reportsStarted.load() == 1; }));
+
+    // The worker is busy; two requests fit in the lane, the next is rejected.
+    for (int i = 0; i < 2; ++i)
+        pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT),
+            [&completed](Response) { completed.fetch_add(1); });
+
+    Response rejected;
+    pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT),
+        [&rejected](Response r) { rejected = std::move(r); });
+    EXPECT_FALSE(rejected.success);
+    EXPECT_NE(rejected.message.find("busy"), std::string::npos);
+
+    inner->release();
+    EXPECT_TRUE(waitFor([&]() { return completed.load() == 3; }));
+}
+
+TEST(PipelinedServerFacadeTest, StopFailsRequestsSubmittedAfterwards)
+{
+    auto inner = std::make_shared<GatedFacade>();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{1, 4, {}});
+    pipeline.stop();
+
+    Response r;
+    pipeline.handleRequestAsync(makeRequest(RequestType::GET_MARKET_DATA),
+        [&r](Response resp) { r = std::move(resp); });
+    EXPECT_FALSE(r.success);
+}
+
+TEST(PipelinedServerFacadeTest, EveryCallbackRunsOnceWhenStopRacesProducers)
+{
+    constexpr int kProducers = 4;
+    constexpr int kRequests  = 2000;
+
+    auto inner = std::make_shared<GatedFacade>();
+    inner->release();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{2, 64, {}});
+
+    std::atomic<int>         completed{0};
+    std::atomic<int>         started{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&]() {
+            started.fetch_add(1);
+            for (int i = 0; i < kRequests; ++i)
+                pipeline.handleRequestAsync(makeRequest(RequestType::GET_MARKET_DATA),
+                    [&completed](Response) { completed.fetch_add(1); });
+        });
+    }
+    while (started.load() < kProducers)
+        std::this_thread::yield();
+
+    pipeline.stop();
+    for (auto& producer : producers)
+        producer.join();
+
+    EXPECT_EQ(completed.load(), kProducers * kRequests);
+}
+
+TEST(PipelinedServerFacadeTest, DirectTypesSkipTheLanes)
+{
+    auto           inner = std::make_shared<GatedFacade>();
+    PipelinedServerFacade pipeline(inner, PipelineConfig{1, 4, {RequestType::SUBMIT_ORDER}});
+
+    // The only worker is stuck in a report; the direct request does not wait for it.
+    pipeline.handleRequestAsync(makeRequest(RequestType::GENERATE_REPORT), [](Response) {});
+    ASSERT_TRUE(waitFor([&]() { return inner->m_reportsStarted.load() == 1; }));
+
+    std::thread::id completedOn;
+    pipeline.handleRequestAsync(makeRequest(RequestType::SUBMIT_ORDER),
+        [&completedOn](Response r) {
+            EXPECT_EQ(r.message, "quote");
+            completedOn = std::this_thread::get_id();
+        });
+    EXPECT_EQ(completedOn, std::this_thread::get_id()); // the inner facade's default runs inline
+    EXPECT_EQ(pipeline.queueDepth(RequestType::SUBMIT_ORDER), 0u);
+
+    inner->release();
+}
@@ -0,0 +1,254 @@
+/**
+ * @file test_PlainStreamTransport.cpp
+ * @brief Unit tests for the plain TCP and Unix domain socket transports.
+ *
+ * Tests: a request framed as for the TLS transport is answered over plain
+ * TCP and over a Unix socket, tagged requests are pipelined on one
+ * connection, a reply streamed inline on the io thread is delivered whole,
+ * broadcasts reach every client, sessions are counted and removed, and the
+ * socket file is replaced on start and removed on stop.
+ */
+
+#include <gtest/gtest.h>
+
+#include "FrameCodec.hpp"
+#include "PlainStreamTransport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    using Tcp  = boost::asio::ip::tcp;
+    using Unix = boost::asio::local::stream_protocol;
+
+    /// Echoes the request payload back, with the request type as the message.
+    class EchoFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request& request) override
+        {
+            ++requests;
+            return Response{true, std::to_string(static_cast<unsigned>(request.type)), request.payload};
+        }
+
+        std::atomic<int> requests{0};
+    };
+
+    /// Streams kParts partial responses from the calling thread, as the default handleRequestAsync() does.
+    class InlineStreamingFacade : public IServerFacade
+    {
+    public:
+        static constexpr int kParts = 40; // more than the session's completion queue holds
+
+        Response handleRequest(const Request& request) override { return handleRequestStreaming(request, {}); }
+
+        Response handleRequestStreaming(const Request&, const ResponseCallback& onChunk) override
+        {
+            for (int part = 0; part < kParts && onChunk; ++part)
+            {
+                Response chunk{true, "", RawBuffer(std::vector<uint8_t>(100, static_cast<uint8_t>(part)))};
+                chunk.more = true;
+                onChunk(std::move(chunk));
+            }
+            return Response{true, "OK", {}};
+        }
+    };
+
+    RawBuffer requestFrame(RequestType type, std::vector<uint8_t> payload, uint64_t id = 0)
+    {
+        Request request;
+        request.type         = type;
+        request.payload      = RawBuffer(payload);
+        request.hasRequestId = id != 0;
+        request.requestId    = id;
+        return framing::makeFrame(framing::encodeRequest(request));
+    }
+
+    template <typename Socket>
+    void writeFrame(Socket& socket, const RawBuffer& frame)
+    {
+        boost::asio::write(socket, boost::asio::buffer(frame.data(), frame.size()));
+    }
+
+    template <typename Socket>
+    Response readResponse(Socket& socket)
+    {
+        uint8_t prefix[framing::kLengthPrefixSize];
+        boost::asio::read(socket, boost::asio::buffer(prefix));
+        RawBuffer payload(framing::decodeBE32(prefix));
+        boost::asio::read(socket, boost::asio::buffer(payload.data(), payload.size()));
+
+        Response response;
+        EXPECT_TRUE(framing::decodeResponse(payload, response));
+        return response;
+    }
+
+    /// Poll @p condition for up to a second.
+    template <typename Condition>
+    bool eventually(Condition condition)
+    {
+        for (int i = 0; i < 1000 && !condition(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return condition();
+    }
+
+    std::string socketPath(const char* name)
+    {
+        return "/tmp/hft_test_" + std::to_string(::getpid()) + "_" + name + ".sock";
+    }
+
+    bool exists(const std::string& path)
+    {
+        struct stat info{};
+        return ::lstat(path.c_str(), &info) == 0;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Request / reply
+// ---------------------------------------------------------------------------
+
+TEST(PlainStreamTransportTest, TcpAnswersFramedRequests)
+{
+    auto         facade = std::make_shared<EchoFacade>();
+    TcpTransport transport(Tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0), facade);
+    transport.start();
+    ASSERT_NE(transport.localEndpoint().port(), 0);
+
+    boost::asio::io_context io;
+    Tcp::socket             client(io);
+    client.connect(transport.localEndpoint());
+    writeFrame(client, requestFrame(RequestType::GET_MARKET_DATA, {1, 2, 3}));
+
+    const Response response = readResponse(client);
+    EXPECT_TRUE(response.success);
+    EXPECT_EQ(response.message, std::to_string(static_cast<unsigned>(RequestType::GET_MARKET_DATA)));
+    EXPECT_EQ(std::vector<uint8_t>(response.data.begin(), response.data.end()), (std::vector<uint8_t>{1, 2, 3}));
+    EXPECT_FALSE(response.hasRequestId);
+
+    transport.stop();
+}
+
+TEST(PlainStreamTransportTest, UnixSocketPipelinesTaggedRequests)
+{
+    const std::string   path   = socketPath("pipeline");
+    auto                facade = std::make_shared<EchoFacade>();
+    UnixSocketTransport transport(Unix::endpoint(path), facade);
+    transport.start();
+
+    boost::asio::io_context io;
+    Unix::socket            client(io);
+    client.connect(Unix::endpoint(path));
+    for (uint64_t id = 1; id <= 3; ++id)
+        writeFrame(client, requestFrame(RequestType::CALCULATE, {static_cast<uint8_t>(id)}, id));
+
+    for (uint64_t id = 1; id <= 3; ++id)
+    {
+        const Response response = readResponse(client);
+        ASSERT_TRUE(response.hasRequestId);
+        ASSERT_EQ(response.data.size(), 1u);
+        EXPECT_EQ(response.data[0], response.requestId); // the echo carries its own id
+    }
+    EXPECT_EQ(facade->requests, 3);
+
+    transport.stop();
+}
+
+// ---------------------------------------------------------------------------
+// Sessions and broadcast
+// ---------------------------------------------------------------------------
+
+TEST(PlainStreamTransportTest, InlineStreamedReplyLongerThanTheCompletionQueueIsDelivered)
+{
+    TcpTransport transport(Tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0),
+                           std::make_shared<InlineStreamingFacade>());
+    transport.start();
+
+    boost::asio::io_context io;
+    Tcp::socket             client(io);
+    client.connect(transport.localEndpoint());
+    for (int round = 0; round < 2; ++round) // the session keeps serving afterwards
+    {
+        writeFrame(client, requestFrame(RequestType::GENERATE_REPORT, {}));
+        for (int part = 0; part < InlineStreamingFacade::kParts; ++part)
+        {
+            const Response chunk = readResponse(client);
+            ASSERT_TRUE(chunk.more) << part;
+            ASSERT_EQ(chunk.data.size(), 100u);
+            EXPECT_EQ(chunk.data[0], part); // in order
+        }
+        const Response last = readResponse(client);
+        EXPECT_FALSE(last.more);
+        EXPECT_EQ(last.message, "OK");
+    }
+
+    transport.stop();
+}
+
+TEST(PlainStreamTransportTest, BroadcastsReachEveryClientAndClosedSessionsAreRemoved)
+{
+    const std::string   path = socketPath("broadcast");
+    UnixSocketTransport transport(Unix::endpoint(path), std::make_shared<EchoFacade>());
+    std::atomic<int>    closed{0};
+    transport.setSessionClosedHandler([&closed](uint64_t) { ++closed; });
+    transport.start();
+
+    boost::asio::io_context io;
+    Unix::socket            first(io);
+    Unix::socket            second(io);
+    first.connect(Unix::endpoint(path));
+    second.connect(Unix::endpoint(path));
+    ASSERT_TRUE(eventually([&transport]() { return transport.stats().sessions == 2; }));
+
+    Response push{true, "tick", RawBuffer({7})};
+    push.push = true;
+    const RawBuffer frame = framing::encodeResponseFrame(push);
+    transport.send(frame.slice(framing::kLengthPrefixSize, frame.size() - framing::kLengthPrefixSize));
+    for (Unix::socket* client : {&first, &second})
+    {
+        const Response received = readResponse(*client);
+        EXPECT_TRUE(received.push);
+        EXPECT_EQ(received.message, "tick");
+    }
+
+    first.close();
+    EXPECT_TRUE(eventually([&transport]() { return transport.stats().sessions == 1; }));
+    EXPECT_TRUE(eventually([&closed]() { return closed == 1; })); // notified after the removal
+    EXPECT_EQ(transport.sessionStats().size(), 1u);
+
+    transport.stop();
+}
+
+// ---------------------------------------------------------------------------
+// Socket file
+// ---------------------------------------------------------------------------
+
+TEST(PlainStreamTransportTest, ReplacesAStaleSocketFileAndRemovesItOnStop)
+{
+    const std::string path = socketPath("stale");
+    {
+        // A socket file left behind, as after a crash.
+        boost::asio::io_context io;
+        Unix::acceptor          stale(io, Unix::endpoint(path));
+    }
+    ASSERT_TRUE(exists(path));
+
+    UnixSocketTransport transport(Unix::endpoint(path), std::make_shared<EchoFacade>());
+    EXPECT_NO_THROW(transport.start());
+    transport.stop();
+    EXPECT_FALSE(exists(path));
+}
+
+TEST(PlainStreamTransportTest, RejectsANullFacade)
+{
+    EXPECT_THROW(TcpTransport(Tcp::endpoint(Tcp::v4(), 0), nullptr), std::invalid_argument);
+}
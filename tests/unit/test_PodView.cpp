@@ -0,0 +1,89 @@
+/**
+ * @file test_PodView.cpp
+ * @brief Unit tests for the zero-copy POD payload views.
+ *
+ * Tests: round trip through makePodPayload / bindRequest without copies,
+ * and rejection of truncated, mismatched and oversized payloads.
+ */
+
+#include <gtest/gtest.h>
+
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    PositionPOD makePosition(const char* symbol, int64_t qty, double avgPrice)
+    {
+        PositionPOD p{};
+        std::strncpy(p.symbol, symbol, sizeof(p.symbol) - 1);
+        p.quantity = qty;
+        p.avgPrice = avgPrice;
+        return p;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(PodViewTest, RequestPayloadRoundTripsInPlace)
+{
+    const std::vector<PositionPOD> positions{
+        makePosition("EURUSD", 100, 1.085), makePosition("AAPL", -5, 190.5)};
+
+    Request request;
+    request.type    = RequestType::CALCULATE;
+    request.payload = makePodPayload(positions.data(), positions.size());
+
+    PodArrayView<PositionPOD> view;
+    ASSERT_EQ(bindRequest<RequestType::CALCULATE>(request, view), PodDecodeStatus::OK);
+    ASSERT_EQ(view.size(), 2u);
+
+    // Records are read directly out of the payload buffer.
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(view.data()),
+              request.payload.data() + sizeof(PayloadHeader));
+    EXPECT_STREQ(view[0].symbol, "EURUSD");
+    EXPECT_EQ(view[1].quantity, -5);
+    EXPECT_DOUBLE_EQ(view[1].avgPrice, 190.5);
+    EXPECT_THROW(view.at(2), std::out_of_range);
+}
+
+TEST(PodViewTest, RejectsWrongSchemaAndVersion)
+{
+    const SymbolPOD symbol{"EURUSD"};
+    Request request;
+    request.payload = makePodPayload(&symbol, 1);
+
+    PodArrayView<PositionPOD> positions;
+    EXPECT_EQ(bindRequest<RequestType::CALCULATE>(request, positions),
+              PodDecodeStatus::SCHEMA_MISMATCH);
+
+    request.payload[2] = 99; // version field
+    PodArrayView<SymbolPOD> symbols;
+    EXPECT_EQ(bindRequest<RequestType::GET_MARKET_DATA>(request, symbols),
+              PodDecodeStatus::VERSION_MISMATCH);
+}
+
+TEST(PodViewTest, RejectsTruncatedAndTrailingBytes)
+{
+    const SymbolPOD symbols[2] = {{"A"}, {"B"}};
+    const PooledBuffer payload = makePodPayload(symbols, 2);
+
+    PodArrayView<SymbolPOD> view;
+    EXPECT_EQ(pod::bindArray(payload.data(), payload.size() - 1, view), PodDecodeStatus::TRUNCATED);
+    EXPECT_EQ(pod::bindArray(payload.data(), 4, view), PodDecodeStatus::TRUNCATED);
+
+    PooledBuffer padded = payload;
+    padded.push_back(0);
+    EXPECT_EQ(pod::bindArray(std::as_const(padded).data(), padded.size(), view),
+              PodDecodeStatus::TRAILING_BYTES);
+    EXPECT_TRUE(view.empty()); // untouched on failure
+
+    PodView<SymbolPOD> one;
+    EXPECT_EQ(pod::bindOne(payload.data(), payload.size(), one), PodDecodeStatus::TRAILING_BYTES);
+    EXPECT_FALSE(one.valid());
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_PooledBuffer.cpp
+ * @brief Unit tests for the pooled, reference-counted frame buffer.
+ *
+ * Tests: vector-compatible construction and comparison, sharing on copy,
+ * copy-on-write, zero-copy slices, block reuse through the pool and
+ * releasing a buffer on a different thread from the one that allocated it.
+ */
+
+#include <gtest/gtest.h>
+
+#include "memory/PooledBuffer.hpp"
+
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(PooledBufferTest, BehavesLikeAByteVector)
+{
+    PooledBuffer buffer{0x01, 0x02, 0x03};
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(buffer, (std::vector<uint8_t>{0x01, 0x02, 0x03}));
+
+    buffer.push_back(0x04);
+    buffer.resize(6);
+    EXPECT_EQ(buffer, (std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04, 0x00, 0x00}));
+
+    PooledBuffer zeroed(4);
+    EXPECT_EQ(zeroed, (std::vector<uint8_t>(4, 0)));
+
+    EXPECT_TRUE(PooledBuffer{}.empty());
+}
+
+TEST(PooledBufferTest, CopiesShareTheBlockUntilWritten)
+{
+    PooledBuffer original{0xAA, 0xBB};
+    PooledBuffer copy = original;
+
+    EXPECT_EQ(original.useCount(), 2u);
+    EXPECT_EQ(static_cast<const PooledBuffer&>(copy).data(),
+              static_cast<const PooledBuffer&>(original).data());
+
+    copy[0] = 0x11; // detaches
+    EXPECT_EQ(original.useCount(), 1u);
+    EXPECT_EQ(original[0], 0xAA);
+    EXPECT_EQ(copy[0], 0x11);
+}
+
+TEST(PooledBufferTest, SliceIsZeroCopyView)
+{
+    const PooledBuffer frame{0x00, 0x00, 0x00, 0x02, 0xDE, 0xAD};
+    const PooledBuffer params = frame.slice(4, 2);
+
+    EXPECT_EQ(params.data(), frame.data() + 4);
+    EXPECT_EQ(params, (std::vector<uint8_t>{0xDE, 0xAD}));
+    EXPECT_THROW(frame.slice(5, 2), std::out_of_range);
+}
+
+TEST(PooledBufferTest, ReleasedBlocksAreReused)
+{
+    const void* first = nullptr;
+    {
+        const PooledBuffer warm = PooledBuffer::uninitialized(512);
+        first = warm.data();
+    }
+
+    const uint64_t before = BufferPool::instance().heapAllocations();
+    for (int i = 0; i < 1000; ++i)
+    {
+        const PooledBuffer buffer = PooledBuffer::uninitialized(512);
+        EXPECT_EQ(buffer.data(), first);
+    }
+    EXPECT_EQ(BufferPool::instance().heapAllocations(), before);
+}
+
+TEST(PooledBufferTest, OversizedBuffersBypassThePool)
+{
+    const PooledBuffer big = PooledBuffer::uninitialized(BufferPool::kMaxBlockSize + 1);
+    EXPECT_EQ(big.size(), BufferPool::kMaxBlockSize + 1);
+    EXPECT_EQ(BufferPool::classFor(big.size()), BufferPool::kUnpooled);
+}
+
+TEST(PooledBufferTest, BufferCanBeReleasedOnAnotherThread)
+{
+    std::vector<PooledBuffer> buffers;
+    for (int i = 0; i < 200; ++i)
+        buffers.push_back(PooledBuffer(100, static_cast<uint8_t>(i)));
+
+    std::thread consumer([moved = std::move(buffers)]() mutable {
+        for (std::size_t i = 0; i < moved.size(); ++i)
+            EXPECT_EQ(moved[i][0], static_cast<uint8_t>(i));
+        moved.clear();
+    });
+    consumer.join();
+
+    // The consumer's cache spilled its blocks back to the shared lists.
+    const PooledBuffer again(100, 0x7F);
+    EXPECT_EQ(again[99], 0x7F);
+}
@@ -0,0 +1,280 @@
+/**
+ * @file test_RateLimiter.cpp
+ * @brief Unit tests for RateLimiter and RateLimitedServerFacade.
+ *
+ * Tests: a session's burst admits that many requests and then refuses
+ * until the bucket refills; reports cost more than quotes; a full bucket
+ * pays for a request above its burst; per-type limits; BATCH charged for
+ * its sub-requests; session 0 and other sessions unaffected; idle
+ * sessions swept; invalid configuration; and the facade decorator
+ * refusing without reaching the inner facade.
+ */
+
+#include <gtest/gtest.h>
+
+#include "RateLimitedServerFacade.hpp"
+#include "RateLimiter.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr int64_t kSecond = 1'000'000'000;
+
+    Request request(RequestType type, uint64_t sessionId = 1)
+    {
+        Request req;
+        req.type      = type;
+        req.sessionId = sessionId;
+        return req;
+    }
+
+    /// BATCH of empty sub-requests of the given types.
+    Request batch(const std::vector<RequestType>& types, uint64_t sessionId = 1)
+    {
+        std::vector<BatchItemPOD> items;
+        for (RequestType type : types)
+            items.push_back(BatchItemPOD{static_cast<uint32_t>(type), 0});
+        Request req   = request(RequestType::BATCH, sessionId);
+        req.payload   = makePodPayload(items.data(), items.size());
+        return req;
+    }
+
+    RateLimitConfig sessionLimit(double rate, double burst = 0.0)
+    {
+        RateLimitConfig config;
+        config.session = TokenBucketLimit{rate, burst};
+        return config;
+    }
+
+    /// Counts the requests that reach it.
+    class CountingFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request&) override
+        {
+            ++calls;
+            return Response{true, "served", {}};
+        }
+
+        int calls{0};
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Session budget
+// ---------------------------------------------------------------------------
+
+TEST(RateLimiterTest, BurstIsAdmittedThenRefusedUntilRefill)
+{
+    RateLimiter limiter(sessionLimit(10.0));
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 0), RateLimiter::Verdict::SESSION_LIMIT);
+    EXPECT_EQ(limiter.rejected(RequestType::GET_MARKET_DATA), 1u);
+
+    // 10 tokens per second: one tenth of a second buys one more request.
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), kSecond / 10), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), kSecond / 10),
+              RateLimiter::Verdict::SESSION_LIMIT);
+}
+
+TEST(RateLimiterTest, ReportsCostMoreThanQuotes)
+{
+    RateLimiter limiter(sessionLimit(100.0, 150.0));
+    EXPECT_EQ(limiter.cost(request(RequestType::GET_MARKET_DATA)), 1.0);
+    EXPECT_EQ(limiter.cost(request(RequestType::GENERATE_REPORT)), 100.0);
+
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::SESSION_LIMIT);
+    // 50 tokens remain: quotes still get through.
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 0), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, FullBucketPaysForARequestAboveItsBurst)
+{
+    RateLimiter limiter(sessionLimit(10.0)); // burst 10, a report costs 100
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::ADMITTED);
+
+    // The bucket is 90 in debt: 9 seconds before it is back at 0, 10 before it is full enough for a quote.
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 9 * kSecond),
+              RateLimiter::Verdict::SESSION_LIMIT);
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 10 * kSecond), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, CustomCostsApply)
+{
+    RateLimitConfig config                                   = sessionLimit(5.0);
+    config.cost[requestTypeIndex(RequestType::SUBMIT_ORDER)] = 5.0;
+    RateLimiter limiter(config);
+
+    EXPECT_EQ(limiter.admit(request(RequestType::SUBMIT_ORDER), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::SUBMIT_ORDER), 0), RateLimiter::Verdict::SESSION_LIMIT);
+}
+
+// ---------------------------------------------------------------------------
+// Per-type limits
+// ---------------------------------------------------------------------------
+
+TEST(RateLimiterTest, PerTypeLimitIsIndependentOfOtherTypes)
+{
+    RateLimitConfig config;
+    config.perType[requestTypeIndex(RequestType::GENERATE_REPORT)] = TokenBucketLimit{1.0, 2.0};
+    RateLimiter limiter(config);
+    ASSERT_TRUE(limiter.enabled());
+
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::TYPE_LIMIT);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), kSecond), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, RefusedRequestIsNotCharged)
+{
+    RateLimitConfig config = sessionLimit(10.0);
+    config.perType[requestTypeIndex(RequestType::CALCULATE)] = TokenBucketLimit{1.0, 1.0};
+    RateLimiter limiter(config);
+
+    EXPECT_EQ(limiter.admit(request(RequestType::CALCULATE), 0), RateLimiter::Verdict::ADMITTED); // session at 0
+    EXPECT_EQ(limiter.admit(request(RequestType::CALCULATE), kSecond / 2), RateLimiter::Verdict::SESSION_LIMIT);
+    // Neither bucket was charged by the refusal: both are full again a second later.
+    EXPECT_EQ(limiter.admit(request(RequestType::CALCULATE), kSecond), RateLimiter::Verdict::ADMITTED);
+}
+
+// ---------------------------------------------------------------------------
+// BATCH
+// ---------------------------------------------------------------------------
+
+TEST(RateLimiterTest, BatchIsChargedForItsSubRequests)
+{
+    RateLimitConfig config;
+    config.session = TokenBucketLimit{1000.0, 1000.0};
+    config.perType[requestTypeIndex(RequestType::GENERATE_REPORT)] = TokenBucketLimit{1.0, 1.0};
+    RateLimiter limiter(config);
+
+    const Request twoReports = batch({RequestType::GENERATE_REPORT, RequestType::GENERATE_REPORT});
+    EXPECT_EQ(limiter.cost(twoReports), 201.0);
+    EXPECT_EQ(limiter.cost(batch({RequestType::GET_MARKET_DATA, RequestType::CALCULATE})), 12.0);
+
+    // A full bucket pays once, so two reports in one batch get through; the next single one does not.
+    EXPECT_EQ(limiter.admit(twoReports, 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), kSecond), RateLimiter::Verdict::TYPE_LIMIT);
+    EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 2 * kSecond), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, MalformedBatchIsChargedAsBatchAlone)
+{
+    RateLimiter limiter(sessionLimit(10.0));
+    Request     req = request(RequestType::BATCH);
+    req.payload     = PooledBuffer::uninitialized(3);
+    EXPECT_EQ(limiter.cost(req), 1.0);
+}
+
+// ---------------------------------------------------------------------------
+// Sessions
+// ---------------------------------------------------------------------------
+
+TEST(RateLimiterTest, SessionZeroIsNeverLimited)
+{
+    RateLimiter limiter(sessionLimit(1.0));
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT, 0), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.trackedSessions(), 0u);
+}
+
+TEST(RateLimiterTest, SessionsHaveTheirOwnBudgets)
+{
+    RateLimiter limiter(sessionLimit(1.0));
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA, 1), 0), RateLimiter::Verdict::ADMITTED);
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA, 1), 0), RateLimiter::Verdict::SESSION_LIMIT);
+    EXPECT_EQ(limiter.admit(request(RequestType::GET_MARKET_DATA, 2), 0), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, SessionsWithFullBucketsAreSwept)
+{
+    RateLimiter limiter(sessionLimit(1.0, 1.0));
+    for (uint64_t session = 1; session <= 64 * 300; ++session)
+        limiter.admit(request(RequestType::GET_MARKET_DATA, session), 0);
+    const std::size_t active = limiter.trackedSessions();
+    EXPECT_EQ(active, 64u * 300u);
+
+    // A second later every bucket has refilled; new sessions push the idle ones out.
+    for (uint64_t session = 100'000; session < 100'000 + 64 * 300; ++session)
+        limiter.admit(request(RequestType::GET_MARKET_DATA, session), kSecond);
+    EXPECT_LT(limiter.trackedSessions(), 2 * active);
+}
+
+TEST(RateLimiterTest, UnconfiguredLimiterIsDisabled)
+{
+    RateLimiter limiter(RateLimitConfig{});
+    EXPECT_FALSE(limiter.enabled());
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(limiter.admit(request(RequestType::GENERATE_REPORT), 0), RateLimiter::Verdict::ADMITTED);
+}
+
+TEST(RateLimiterTest, NegativeConfigurationThrows)
+{
+    EXPECT_THROW(RateLimiter(sessionLimit(-1.0)), std::invalid_argument);
+    EXPECT_THROW(RateLimiter(sessionLimit(1.0, -1.0)), std::invalid_argument);
+
+    RateLimitConfig config = sessionLimit(1.0);
+    config.cost[0]         = -1.0;
+    EXPECT_THROW(RateLimiter{config}, std::invalid_argument);
+}
+
+// ---------------------------------------------------------------------------
+// RateLimitedServerFacade
+// ---------------------------------------------------------------------------
+
+TEST(RateLimitedServerFacadeTest, RefusesWithoutReachingTheInnerFacade)
+{
+    auto inner   = std::make_shared<CountingFacade>();
+    auto limiter = std::make_shared<RateLimiter>(sessionLimit(1.0));
+    RateLimitedServerFacade facade(inner, limiter);
+
+    EXPECT_TRUE(facade.handleRequest(request(RequestType::GET_MARKET_DATA)).success);
+    const Response refused = facade.handleRequest(request(RequestType::GET_MARKET_DATA));
+    EXPECT_FALSE(refused.success);
+    EXPECT_NE(refused.message.find("Rate limited"), std::string::npos);
+    EXPECT_EQ(inner->calls, 1);
+}
+
+TEST(RateLimitedServerFacadeTest, TypeRefusalNamesTheType)
+{
+    RateLimitConfig config;
+    config.perType[requestTypeIndex(RequestType::MANIPULATE)] = TokenBucketLimit{1.0, 1.0};
+    auto                    inner = std::make_shared<CountingFacade>();
+    RateLimitedServerFacade facade(inner, std::make_shared<RateLimiter>(config));
+
+    facade.handleRequest(request(RequestType::MANIPULATE));
+    const Response refused = facade.handleRequest(request(RequestType::MANIPULATE));
+    EXPECT_FALSE(refused.success);
+    EXPECT_NE(refused.message.find("MANIPULATE"), std::string::npos);
+}
+
+TEST(RateLimitedServerFacadeTest, AsyncRefusalCompletesInline)
+{
+    auto                    inner = std::make_shared<CountingFacade>();
+    RateLimitedServerFacade facade(inner, std::make_shared<RateLimiter>(sessionLimit(1.0)));
+
+    std::vector<Response> replies;
+    for (int i = 0; i < 2; ++i)
+        facade.handleRequestAsync(request(RequestType::GET_MARKET_DATA),
+                                  [&replies](Response response) { replies.push_back(std::move(response)); });
+    ASSERT_EQ(replies.size(), 2u);
+    EXPECT_TRUE(replies[0].success);
+    EXPECT_FALSE(replies[1].success);
+    EXPECT_EQ(inner->calls, 1);
+}
+
+TEST(RateLimitedServerFacadeTest, NullArgumentsThrow)
+{
+    auto limiter = std::make_shared<RateLimiter>(sessionLimit(1.0));
+    EXPECT_THROW(RateLimitedServerFacade(nullptr, limiter), std::invalid_argument);
+    EXPECT_THROW(RateLimitedServerFacade(std::make_shared<CountingFacade>(), nullptr), std::invalid_argument);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_Records.cpp
+ * @brief Unit tests for the aligned internal records and their wire conversions.
+ *
+ * Tests: every generated record converts to its packed POD and back without
+ * losing a field, symbols go through the supplied intern / lookup functions,
+ * and MarketDataCache serves the same snapshot as a record and as a POD.
+ */
+
+#include <gtest/gtest.h>
+
+#include "MarketDataCache.hpp"
+#include "Records.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// A toy symbol table: the id is the index in @c keys.
+    struct Symbols
+    {
+        SymbolId intern(const SymbolKey& key)
+        {
+            for (SymbolId id = 0; id < keys.size(); ++id)
+                if (keys[id] == key)
+                    return id;
+            keys.push_back(key);
+            return static_cast<SymbolId>(keys.size() - 1);
+        }
+
+        std::vector<SymbolKey> keys;
+    };
+
+    /// Convert @p in to its record and back; the result must be byte-identical.
+    template <typename Record, typename Pod>
+    void expectRoundTrip(const Pod& in, Symbols& symbols)
+    {
+        Record record;
+        fromWire(in, record, [&symbols](const SymbolKey& key) { return symbols.intern(key); });
+
+        Pod out;
+        std::memset(&out, 0xAB, sizeof(out));
+        toWire(record, out, [&symbols](SymbolId id) -> const SymbolKey& { return symbols.keys.at(id); });
+        EXPECT_EQ(std::memcmp(&in, &out, sizeof(Pod)), 0);
+    }
+
+    template <typename Pod>
+    Pod withSymbol(const char* symbol)
+    {
+        Pod pod{};
+        std::strncpy(pod.symbol, symbol, sizeof(pod.symbol) - 1);
+        return pod;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Conversions
+// ---------------------------------------------------------------------------
+
+TEST(RecordsTest, EveryRecordRoundTripsThroughItsPod)
+{
+    Symbols symbols;
+
+    auto md      = withSymbol<MarketDataPOD>("EURUSD");
+    md.bid       = 1.0841;
+    md.ask       = 1.0843;
+    md.last      = 1.0842;
+    md.volume    = 123456789;
+    md.timestamp = -42;
+    expectRoundTrip<MarketDataRecord>(md, symbols);
+
+    auto order      = withSymbol<OrderPOD>("AAPL");
+    order.orderId   = 7;
+    order.price     = 187.25;
+    order.quantity  = 300;
+    order.side      = 1;
+    order.type      = 2;
+    order.timestamp = 1700000000000000;
+    expectRoundTrip<OrderRecord>(order, symbols);
+
+    auto position          = withSymbol<PositionPOD>("MSFT");
+    position.quantity      = -50;
+    position.avgPrice      = 410.5;
+    position.unrealisedPnl = -12.75;
+    position.timestamp     = 99;
+    expectRoundTrip<PositionRecord>(position, symbols);
+
+    auto trade      = withSymbol<TradePOD>("AAPL");
+    trade.tradeId   = 11;
+    trade.orderId   = 7;
+    trade.price     = 187.2;
+    trade.quantity  = 100;
+    trade.side      = 1;
+    trade.timestamp = 1700000000000001;
+    expectRoundTrip<TradeRecord>(trade, symbols);
+
+    EXPECT_EQ(symbols.keys.size(), 3u); // AAPL was interned once
+}
+
+TEST(RecordsTest, RecordsHoldTheInternedSymbolId)
+{
+    Symbols symbols;
+    symbols.intern(SymbolKey("FIRST"));
+
+    TradeRecord record;
+    fromWire(withSymbol<TradePOD>("SECOND"), record, [&symbols](const SymbolKey& key) { return symbols.intern(key); });
+    EXPECT_EQ(record.symbol, 1u);
+}
+
+// ---------------------------------------------------------------------------
+// MarketDataCache
+// ---------------------------------------------------------------------------
+
+TEST(RecordsTest, CacheServesTheSameSnapshotAsRecordAndPod)
+{
+    MarketDataCache cache(4);
+    const SymbolId  id = cache.intern(SymbolKey("GBPUSD"));
+
+    auto md   = withSymbol<MarketDataPOD>("GBPUSD");
+    md.bid    = 1.27;
+    md.ask    = 1.28;
+    md.last   = 1.275;
+    md.volume = 5;
+    cache.store(id, md);
+
+    MarketDataRecord record{};
+    ASSERT_TRUE(cache.load(id, record));
+    EXPECT_EQ(record.symbol, id);
+    EXPECT_DOUBLE_EQ(record.last, 1.275);
+    EXPECT_EQ(record.volume, 5u);
+
+    MarketDataPOD wire{};
+    ASSERT_TRUE(cache.load(id, wire));
+    EXPECT_EQ(std::memcmp(&wire, &md, sizeof(md)), 0);
+    EXPECT_EQ(std::string(wire.symbol), "GBPUSD");
+}
@@ -0,0 +1,153 @@
+/**
+ * @file test_ReportBlockWriter.cpp
+ * @brief Unit tests for ReportBlockWriter.
+ *
+ * Tests: the header and descriptors of a block, numeric values and text
+ * rows read back at their offsets, 8-byte column alignment and padding, a
+ * block without rows, and the misuse the writer rejects.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ReportBlockWriter.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    template <typename T>
+    T readAt(const PooledBuffer& block, std::size_t offset)
+    {
+        T value;
+        std::memcpy(&value, block.data() + offset, sizeof(T));
+        return value;
+    }
+
+    ReportColumnPOD column(const PooledBuffer& block, std::size_t index)
+    {
+        return readAt<ReportColumnPOD>(block, sizeof(ReportBlockHeaderPOD) + index * sizeof(ReportColumnPOD));
+    }
+
+    /// Row @p row of the UTF8 column @p index.
+    std::string textAt(const PooledBuffer& block, std::size_t index, uint32_t row)
+    {
+        const ReportColumnPOD descriptor = column(block, index);
+        const auto header = readAt<ReportBlockHeaderPOD>(block, 0);
+        const auto begin  = readAt<uint32_t>(block, descriptor.offset + row * sizeof(uint32_t));
+        const auto end    = readAt<uint32_t>(block, descriptor.offset + (row + 1) * sizeof(uint32_t));
+        const std::size_t data = descriptor.offset + (header.rowCount + 1) * sizeof(uint32_t);
+        return std::string(reinterpret_cast<const char*>(block.data()) + data + begin, end - begin);
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Layout
+// ---------------------------------------------------------------------------
+
+TEST(ReportBlockWriterTest, WritesHeaderDescriptorsAndColumns)
+{
+    const TradingDate day = TradingDate::fromCivil(2024, 3, 1);
+    ReportBlockWriter writer(day, 3);
+    const auto        name  = writer.addColumn("name", ReportColumnType::UTF8, 9);
+    const auto        count = writer.addColumn("count", ReportColumnType::UINT32);
+    const auto        total = writer.addColumn("total", ReportColumnType::UINT64);
+    const auto        price = writer.addColumn("price", ReportColumnType::FLOAT64);
+    writer.allocate();
+
+    const char* names[] = {"AAPL", "", "MSFT2"};
+    for (uint32_t row = 0; row < 3; ++row)
+    {
+        writer.appendText(name, names[row], std::strlen(names[row]));
+        writer.set(count, row, row + 1);
+        writer.set(total, row, uint64_t{1} << (40 + row));
+        writer.set(price, row, 100.25 * row);
+    }
+    const PooledBuffer block = writer.finish();
+
+    const auto header = readAt<ReportBlockHeaderPOD>(block, 0);
+    EXPECT_EQ(header.magic, kReportBlockMagic);
+    EXPECT_EQ(header.version, kReportBlockVersion);
+    EXPECT_EQ(header.columnCount, 4u);
+    EXPECT_EQ(header.day, day.days);
+    EXPECT_EQ(header.rowCount, 3u);
+    EXPECT_EQ(header.blockBytes, block.size());
+    EXPECT_EQ(block.size() % 8, 0u);
+
+    EXPECT_STREQ(column(block, 0).name, "name");
+    EXPECT_EQ(column(block, 0).type, static_cast<uint8_t>(ReportColumnType::UTF8));
+    EXPECT_EQ(column(block, 0).bytes, 4u * sizeof(uint32_t) + 9u);
+    EXPECT_EQ(column(block, 1).bytes, 3u * sizeof(uint32_t));
+    EXPECT_EQ(column(block, 3).type, static_cast<uint8_t>(ReportColumnType::FLOAT64));
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(column(block, i).offset % 8, 0u) << i;
+        EXPECT_LE(column(block, i).offset + column(block, i).bytes, block.size());
+    }
+    EXPECT_GE(column(block, 0).offset, sizeof(ReportBlockHeaderPOD) + 4 * sizeof(ReportColumnPOD));
+
+    EXPECT_EQ(textAt(block, name, 0), "AAPL");
+    EXPECT_EQ(textAt(block, name, 1), "");
+    EXPECT_EQ(textAt(block, name, 2), "MSFT2");
+    for (uint32_t row = 0; row < 3; ++row)
+    {
+        EXPECT_EQ(readAt<uint32_t>(block, column(block, count).offset + row * 4), row + 1);
+        EXPECT_EQ(readAt<uint64_t>(block, column(block, total).offset + row * 8), uint64_t{1} << (40 + row));
+        EXPECT_DOUBLE_EQ(readAt<double>(block, column(block, price).offset + row * 8), 100.25 * row);
+    }
+
+    // The uint32 column ends mid-word; its padding reads as zero.
+    const ReportColumnPOD counts = column(block, count);
+    EXPECT_EQ(readAt<uint32_t>(block, counts.offset + counts.bytes), 0u);
+}
+
+TEST(ReportBlockWriterTest, BlockWithoutRowsKeepsItsColumns)
+{
+    ReportBlockWriter writer(TradingDate::fromCivil(2024, 1, 1), 0);
+    writer.addColumn("symbol", ReportColumnType::UTF8);
+    writer.addColumn("vwap", ReportColumnType::FLOAT64);
+    writer.allocate();
+    const PooledBuffer block = writer.finish();
+
+    const auto header = readAt<ReportBlockHeaderPOD>(block, 0);
+    EXPECT_EQ(header.rowCount, 0u);
+    EXPECT_EQ(header.columnCount, 2u);
+    EXPECT_EQ(column(block, 0).bytes, sizeof(uint32_t)); // offsets[0] only
+    EXPECT_EQ(column(block, 1).bytes, 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Misuse
+// ---------------------------------------------------------------------------
+
+TEST(ReportBlockWriterTest, RejectsInvalidColumns)
+{
+    ReportBlockWriter writer(TradingDate{0}, 1);
+    EXPECT_THROW(writer.addColumn("", ReportColumnType::UINT32), std::invalid_argument);
+    EXPECT_THROW(writer.addColumn("a_name_of_twenty_chr", ReportColumnType::UINT32), std::invalid_argument);
+    EXPECT_THROW(writer.addColumn("fills", ReportColumnType::UINT32, 4), std::invalid_argument);
+    EXPECT_THROW(writer.addColumn("x", static_cast<ReportColumnType>(9)), std::invalid_argument);
+    EXPECT_EQ(writer.addColumn("a_name_of_19_chars_", ReportColumnType::UINT32), 0u);
+
+    writer.allocate();
+    EXPECT_THROW(writer.allocate(), std::logic_error);
+    EXPECT_THROW(writer.addColumn("late", ReportColumnType::UINT64), std::logic_error);
+    EXPECT_THROW(writer.appendText(0, "x", 1), std::logic_error); // not a UTF8 column
+}
+
+TEST(ReportBlockWriterTest, TextMustMatchItsDeclaredSize)
+{
+    ReportBlockWriter writer(TradingDate{0}, 2);
+    const auto        text = writer.addColumn("text", ReportColumnType::UTF8, 4);
+    EXPECT_THROW(writer.appendText(text, "ab", 2), std::logic_error); // before allocate()
+    EXPECT_THROW(writer.finish(), std::logic_error);
+    writer.allocate();
+
+    writer.appendText(text, "ab", 2);
+    EXPECT_THROW(writer.appendText(text, "abc", 3), std::logic_error); // over the declared size
+    EXPECT_THROW(writer.finish(), std::logic_error);                   // one row short
+    writer.appendText(text, "cd", 2);
+    EXPECT_THROW(writer.appendText(text, "", 0), std::logic_error);    // a third row
+    EXPECT_EQ(writer.finish().size() % 8, 0u);
+}
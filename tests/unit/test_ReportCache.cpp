@@ -0,0 +1,176 @@
+/**
+ * @file test_ReportCache.cpp
+ * @brief Unit tests for the closed-day report cache.
+ *
+ * Tests: hits and misses per (type, day), LRU eviction under the memory
+ * budget, spilling to mapped files and reading them back, the spill budget,
+ * removal of spill files on destruction, and the disabled cache.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ReportCache.hpp"
+
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+namespace
+{
+    std::string text(const std::shared_ptr<const ReportCache::Blob>& blob)
+    {
+        return blob ? std::string(blob->data(), blob->size()) : std::string("<none>");
+    }
+
+    TradingDate day(int n) { return TradingDate::fromCivil(2024, 1, 1) + n; }
+
+    /// A fresh, empty spill directory removed at the end of the test.
+    class SpillDirectory
+    {
+    public:
+        SpillDirectory()
+            : m_path(std::filesystem::temp_directory_path()
+                     / ("hft_report_cache_" + std::to_string(::getpid()) + "_"
+                        + ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+        {
+            std::filesystem::remove_all(m_path);
+        }
+        ~SpillDirectory() { std::filesystem::remove_all(m_path); }
+
+        std::string path() const { return m_path.string(); }
+
+        std::size_t files() const
+        {
+            if (!std::filesystem::exists(m_path))
+                return 0;
+            std::size_t n = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(m_path))
+                n += entry.is_regular_file() ? 1 : 0;
+            return n;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// In memory
+// ---------------------------------------------------------------------------
+
+TEST(ReportCacheTest, FindsStoredDaysByTypeAndDay)
+{
+    ReportCache cache;
+    cache.store("EndOfDay", day(0), "a,1\n");
+    cache.store("EndOfDay", day(1), "b,2\n");
+    cache.store("Blotter", day(0), "c,3\n");
+
+    EXPECT_EQ(text(cache.find("EndOfDay", day(0))), "a,1\n");
+    EXPECT_EQ(text(cache.find("EndOfDay", day(1))), "b,2\n");
+    EXPECT_EQ(text(cache.find("Blotter", day(0))), "c,3\n");
+    EXPECT_EQ(cache.find("Blotter", day(1)), nullptr);
+
+    cache.store("EndOfDay", day(0), "replaced\n");
+    EXPECT_EQ(text(cache.find("EndOfDay", day(0))), "replaced\n");
+
+    const ReportCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_GT(stats.memoryBytes, 0u);
+}
+
+TEST(ReportCacheTest, EvictsLeastRecentlyUsedOverMemoryBudget)
+{
+    ReportCacheConfig config;
+    config.maxMemoryBytes = 4 * 1024;
+    ReportCache cache(config);
+
+    const std::string day1k(900, 'x');
+    cache.store("R", day(0), day1k);
+    cache.store("R", day(1), day1k);
+    ASSERT_NE(cache.find("R", day(0)), nullptr); // day 1 is now the oldest
+    cache.store("R", day(2), day1k);
+    cache.store("R", day(3), day1k);
+
+    EXPECT_EQ(cache.find("R", day(1)), nullptr);
+    EXPECT_NE(cache.find("R", day(0)), nullptr);
+    EXPECT_NE(cache.find("R", day(3)), nullptr);
+    EXPECT_LE(cache.stats().memoryBytes, config.maxMemoryBytes);
+}
+
+TEST(ReportCacheTest, EvictedTextStaysValidForReaders)
+{
+    ReportCacheConfig config;
+    config.maxMemoryBytes = 1024;
+    ReportCache cache(config);
+
+    cache.store("R", day(0), std::string(800, 'a'));
+    const auto held = cache.find("R", day(0));
+    cache.store("R", day(1), std::string(800, 'b'));
+
+    EXPECT_EQ(cache.find("R", day(0)), nullptr);
+    EXPECT_EQ(text(held), std::string(800, 'a'));
+}
+
+TEST(ReportCacheTest, ZeroBudgetDisablesTheCache)
+{
+    ReportCacheConfig config;
+    config.maxMemoryBytes = 0;
+    ReportCache cache(config);
+
+    EXPECT_FALSE(cache.enabled());
+    cache.store("R", day(0), "row\n");
+    EXPECT_EQ(cache.find("R", day(0)), nullptr);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Spilling
+// ---------------------------------------------------------------------------
+
+TEST(ReportCacheTest, SpillsEvictedDaysToMappedFiles)
+{
+    SpillDirectory    dir;
+    ReportCacheConfig config;
+    config.maxMemoryBytes = 3 * 1024;
+    config.spillDirectory = dir.path();
+
+    {
+        ReportCache cache(config);
+        for (int d = 0; d < 6; ++d)
+            cache.store("End/Of Day", day(d), std::string(900, static_cast<char>('a' + d)));
+
+        const ReportCache::Stats stats = cache.stats();
+        EXPECT_EQ(stats.entries, 6u);
+        EXPECT_LE(stats.memoryBytes, config.maxMemoryBytes);
+        EXPECT_EQ(stats.spilledBytes, 4u * 900u);
+        EXPECT_EQ(stats.spillFailures, 0u);
+        EXPECT_EQ(dir.files(), 4u);
+
+        for (int d = 0; d < 6; ++d)
+            EXPECT_EQ(text(cache.find("End/Of Day", day(d))), std::string(900, static_cast<char>('a' + d)));
+    }
+    EXPECT_EQ(dir.files(), 0u); // removed with the cache
+}
+
+TEST(ReportCacheTest, SpillBudgetDeletesOldestFiles)
+{
+    SpillDirectory    dir;
+    ReportCacheConfig config;
+    config.maxMemoryBytes = 2 * 1024;
+    config.spillDirectory = dir.path();
+    config.maxSpillBytes  = 2000;
+    ReportCache cache(config);
+
+    for (int d = 0; d < 5; ++d)
+        cache.store("R", day(d), std::string(900, 'z'));
+
+    EXPECT_EQ(cache.find("R", day(0)), nullptr);
+    EXPECT_EQ(cache.find("R", day(1)), nullptr);
+    EXPECT_NE(cache.find("R", day(2)), nullptr);
+    EXPECT_NE(cache.find("R", day(4)), nullptr);
+    EXPECT_LE(cache.stats().spilledBytes, config.maxSpillBytes);
+    EXPECT_EQ(dir.files(), 2u);
+}
@@ -0,0 +1,323 @@
+/**
+ * @file test_ReportService.cpp
+ * @brief Unit tests for day-partitioned, streamed report generation.
+ *
+ * Tests: one pipeline run per day delivered in date order (also with a
+ * thread pool), chunking of large reports with the more flag, whole-report
+ * generation, request validation, failures inside a pipeline step,
+ * reuse of cached closed days (but never today, nor days the report's
+ * source does not fully hold), and the columnar format, cached apart from
+ * the text.
+ */
+
+#include <gtest/gtest.h>
+
+#include "EndOfDayReport.hpp"
+#include "ReportService.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Emits @c rowsPerDay rows "<date>,<i>" per day; fails on @c failDate.
+    class DailyRowsReport : public BaseReport
+    {
+    public:
+        DailyRowsReport(std::size_t rowsPerDay, std::size_t rowWidth, std::string failDate,
+                        std::atomic<int>* fetches)
+            : m_rowsPerDay(rowsPerDay)
+            , m_rowWidth(rowWidth)
+            , m_failDate(std::move(failDate))
+            , m_fetches(fetches)
+        {}
+
+    protected:
+        ReportData fetchData(const ReportRequest& request) override
+        {
+            EXPECT_EQ(request.dateFrom, request.dateTo); // one day per partition
+            if (m_fetches)
+                m_fetches->fetch_add(1);
+            const std::string day = request.dateFrom.toIso();
+            if (day == m_failDate)
+                throw std::runtime_error("no data for " + day);
+            return {day};
+        }
+
+        ReportData computeReport(const ReportData& data) override
+        {
+            ReportData rows;
+            for (std::size_t i = 0; i < m_rowsPerDay; ++i)
+            {
+                std::string row = data[0] + "," + std::to_string(i);
+                row.resize(std::max(row.size(), m_rowWidth), ' ');
+                rows.push_back(std::move(row));
+            }
+            return rows;
+        }
+
+        Report format(const ReportData& data) override { return data; }
+
+    private:
+        std::size_t       m_rowsPerDay;
+        std::size_t       m_rowWidth;
+        std::string       m_failDate;
+        std::atomic<int>* m_fetches;
+    };
+
+    void registerDaily(ReportService& service, std::size_t rowsPerDay, std::size_t rowWidth = 0,
+                       std::string failDate = "", std::atomic<int>* fetches = nullptr)
+    {
+        service.registerReport("Daily", [=]() {
+            return std::make_unique<DailyRowsReport>(rowsPerDay, rowWidth, failDate, fetches);
+        });
+    }
+
+    ReportRequest range(const std::string& type, const char* from, const char* to)
+    {
+        ReportRequest request{type, {}, {}};
+        EXPECT_TRUE(TradingDate::parseIso(from, request.dateFrom));
+        EXPECT_TRUE(TradingDate::parseIso(to, request.dateTo));
+        return request;
+    }
+
+    std::string text(const Response& response)
+    {
+        return std::string(reinterpret_cast<const char*>(response.data.data()), response.data.size());
+    }
+
+    struct Stream
+    {
+        std::vector<Response> chunks;
+        Response              last;
+    };
+
+    Stream stream(ReportService& service, const ReportRequest& request)
+    {
+        Stream result;
+        result.last = service.generateReportStreaming(request, [&result](Response chunk) {
+            result.chunks.push_back(std::move(chunk));
+        });
+        return result;
+    }
+
+    TradingDate today()
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        return TradingDate{static_cast<int32_t>(std::chrono::duration_cast<std::chrono::hours>(now).count() / 24)};
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(ReportServiceTest, RunsOnePipelinePerDayInDateOrder)
+{
+    for (const std::size_t threads : {0u, 3u})
+    {
+        ReportService    service(threads);
+        std::atomic<int> fetches{0};
+        registerDaily(service, 1, 0, "", &fetches);
+
+        const Response response = service.generateReport(range("Daily", "2024-02-27", "2024-03-02"));
+        ASSERT_TRUE(response.success) << response.message;
+        EXPECT_EQ(text(response), "2024-02-27,0\n2024-02-28,0\n2024-02-29,0\n2024-03-01,0\n2024-03-02,0\n");
+        EXPECT_EQ(fetches.load(), 5);
+    }
+}
+
+TEST(ReportServiceTest, LargeReportsStreamInChunks)
+{
+    ReportService service(2);
+    registerDaily(service, 100, 1000); // ~100 KB per day
+
+    const Stream result = stream(service, range("Daily", "2024-01-01", "2024-01-10"));
+    ASSERT_TRUE(result.last.success) << result.last.message;
+    EXPECT_FALSE(result.last.more);
+    ASSERT_GE(result.chunks.size(), 10u);
+
+    std::string all;
+    for (const Response& chunk : result.chunks)
+    {
+        EXPECT_TRUE(chunk.success);
+        EXPECT_TRUE(chunk.more);
+        EXPECT_EQ(chunk.data.size(), ReportService::kChunkBytes);
+        all += text(chunk);
+    }
+    all += text(result.last);
+
+    EXPECT_EQ(all.size(), 10u * 100u * 1001u);
+    EXPECT_EQ(all.compare(0, 12, "2024-01-01,0"), 0);
+    EXPECT_NE(all.find("2024-01-10,99"), std::string::npos);
+    EXPECT_LT(all.find("2024-01-09,99"), all.find("2024-01-10,0"));
+}
+
+TEST(ReportServiceTest, EndOfDayIsRegisteredByDefault)
+{
+    ReportService  service(0);
+    const Response response = service.generateReport(range("EndOfDay", "2026-01-01", "2026-01-31"));
+    EXPECT_TRUE(response.success) << response.message;
+    EXPECT_TRUE(response.data.empty()); // the pipeline steps are still stubs
+}
+
+TEST(ReportServiceTest, RejectsInvalidRequests)
+{
+    ReportService service(0);
+    registerDaily(service, 1);
+
+    EXPECT_NE(service.generateReport(range("Blotter", "2024-01-01", "2024-01-01")).message.find("unknown report type Blotter"),
+              std::string::npos);
+    EXPECT_NE(service.generateReport(range("Daily", "2024-02-01", "2024-01-01")).message.find("after"),
+              std::string::npos);
+    EXPECT_FALSE(service.generateReport(range("Daily", "2000-01-01", "2024-01-01")).success);
+
+    // Day numbers past the ISO years are refused before any day is enumerated.
+    const ReportRequest extreme{"Daily", TradingDate{INT32_MAX - 5}, TradingDate{INT32_MAX}};
+    EXPECT_EQ(service.generateReport(extreme).message,
+              "ReportService: dates must be within 0000-01-01 .. 9999-12-31");
+    const ReportRequest negative{"Daily", TradingDate{INT32_MIN}, TradingDate{0}};
+    EXPECT_FALSE(service.generateReport(negative).success);
+}
+
+TEST(ReportServiceTest, FailureMidStreamEndsWithErrorAfterEarlierDays)
+{
+    ReportService service(0);
+    registerDaily(service, 100, 1000, "2024-01-03");
+
+    const Stream result = stream(service, range("Daily", "2024-01-01", "2024-01-05"));
+    EXPECT_FALSE(result.last.success);
+    EXPECT_FALSE(result.last.more);
+    EXPECT_NE(result.last.message.find("no data for 2024-01-03"), std::string::npos);
+    EXPECT_FALSE(result.chunks.empty()); // days 1 and 2 were already streamed
+}
+
+TEST(ReportServiceTest, OverlappingRangesReuseCachedClosedDays)
+{
+    ReportService    service(2);
+    std::atomic<int> fetches{0};
+    registerDaily(service, 50, 100, "", &fetches);
+
+    ReportService    uncached(2, ReportCacheConfig{0, "", 0});
+    std::atomic<int> uncachedFetches{0};
+    registerDaily(uncached, 50, 100, "", &uncachedFetches);
+
+    ASSERT_TRUE(service.generateReport(range("Daily", "2024-01-05", "2024-01-10")).success);
+    EXPECT_EQ(fetches.load(), 6);
+
+    // Days 5-10 come from the cache, the days around them are generated.
+    const Stream   cached   = stream(service, range("Daily", "2024-01-01", "2024-01-15"));
+    const Stream   expected = stream(uncached, range("Daily", "2024-01-01", "2024-01-15"));
+    ASSERT_TRUE(cached.last.success) << cached.last.message;
+    EXPECT_EQ(fetches.load(), 6 + 9);
+    EXPECT_EQ(uncachedFetches.load(), 15);
+
+    ASSERT_EQ(cached.chunks.size(), expected.chunks.size());
+    for (std::size_t i = 0; i < cached.chunks.size(); ++i)
+        EXPECT_EQ(text(cached.chunks[i]), text(expected.chunks[i]));
+    EXPECT_EQ(text(cached.last), text(expected.last));
+
+    ASSERT_TRUE(service.generateReport(range("Daily", "2024-01-01", "2024-01-15")).success);
+    EXPECT_EQ(fetches.load(), 15); // fully cached
+    EXPECT_EQ(service.cacheStats().entries, 15u);
+}
+
+TEST(ReportServiceTest, TodayIsGeneratedOnEveryRequest)
+{
+    ReportService    service(0);
+    std::atomic<int> fetches{0};
+    registerDaily(service, 1, 0, "", &fetches);
+
+    const ReportRequest request{"Daily", today() + -1, today()};
+    const Response      first = service.generateReport(request);
+    const Response      again = service.generateReport(request);
+    ASSERT_TRUE(again.success) << again.message;
+    EXPECT_EQ(text(first), text(again));
+    EXPECT_EQ(fetches.load(), 3); // yesterday once, today twice
+}
+
+TEST(ReportServiceTest, DaysThatAreNotFinalAreNotCached)
+{
+    ReportService     service(0);
+    std::atomic<int>  lookups{0};
+    const TradingDate known = TradingDate::fromCivil(2024, 1, 3);
+    service.registerReport("EndOfDay", [&lookups, known]() {
+        return std::make_unique<EndOfDayReport>(
+            [&lookups](TradingDate) {
+                lookups.fetch_add(1);
+                return std::vector<SymbolDaySummary>{};
+            },
+            [known](TradingDate day) { return day == known; });
+    });
+
+    for (const ReportFormat format : {ReportFormat::TEXT, ReportFormat::COLUMNAR})
+    {
+        ReportRequest request = range("EndOfDay", "2024-01-01", "2024-01-03");
+        request.format        = format;
+        lookups.store(0);
+        ASSERT_TRUE(service.generateReport(request).success);
+        EXPECT_EQ(lookups.load(), 3);
+        ASSERT_TRUE(service.generateReport(request).success);
+        EXPECT_EQ(lookups.load(), 5); // only 2024-01-03 came from the cache
+    }
+}
+
+TEST(ReportServiceTest, ColumnarReportsAreServedAndCachedApartFromText)
+{
+    ReportService    service(2);
+    std::atomic<int> lookups{0};
+    service.registerReport("EndOfDay", [&lookups]() {
+        return std::make_unique<EndOfDayReport>([&lookups](TradingDate) {
+            lookups.fetch_add(1);
+            SymbolDaySummary entry{SymbolKey("AAPL"), {}};
+            entry.summary.ohlcv.close = 101.0;
+            return std::vector<SymbolDaySummary>{entry};
+        });
+    });
+
+    ReportRequest request = range("EndOfDay", "2024-01-01", "2024-01-03");
+    ASSERT_TRUE(service.generateReport(request).success);
+    EXPECT_EQ(lookups.load(), 3);
+
+    request.format          = ReportFormat::COLUMNAR;
+    const Response columnar = service.generateReport(request);
+    ASSERT_TRUE(columnar.success) << columnar.message;
+    EXPECT_EQ(lookups.load(), 6); // the cached text days are not reused
+
+    // Three blocks back to back, in date order.
+    std::size_t offset = 0;
+    for (TradingDate day = request.dateFrom; day <= request.dateTo; day = day + 1)
+    {
+        ASSERT_LE(offset + sizeof(ReportBlockHeaderPOD), columnar.data.size());
+        ReportBlockHeaderPOD header;
+        std::memcpy(&header, columnar.data.data() + offset, sizeof(header));
+        EXPECT_EQ(header.magic, kReportBlockMagic);
+        EXPECT_EQ(header.day, day.days);
+        EXPECT_EQ(header.rowCount, 1u);
+        offset += header.blockBytes;
+    }
+    EXPECT_EQ(offset, columnar.data.size());
+
+    const Response again = service.generateReport(request);
+    EXPECT_EQ(lookups.load(), 6);
+    EXPECT_EQ(again.data, columnar.data);
+}
+
+TEST(ReportServiceTest, RejectsFormatsTheReportDoesNotHave)
+{
+    ReportService service(0);
+    registerDaily(service, 1);
+
+    ReportRequest request = range("Daily", "2024-01-01", "2024-01-01");
+    request.format        = ReportFormat::COLUMNAR;
+    EXPECT_EQ(service.generateReport(request).message, "ReportService: report type Daily has no columnar format");
+
+    request.format = static_cast<ReportFormat>(7);
+    EXPECT_EQ(service.generateReport(request).message, "ReportService: unknown report format 7");
+}
@@ -105,7 +105,7 @@ TEST(StubManipulationServiceTest, TransformReturnsFalseWithMessage)
 TEST(StubReportServiceTest, GenerateReportReturnsFalseAndIncludesReportType)
 {
     StubReportService svc;
-    ReportRequest req{"EndOfDay", "2026-01-01", "2026-01-31"};
+    ReportRequest req{"EndOfDay", TradingDate::fromCivil(2026, 1, 1), TradingDate::fromCivil(2026, 1, 31)};
     Response r = svc.generateReport(req);
     EXPECT_FALSE(r.success);
     EXPECT_NE(r.message.find("EndOfDay"), std::string::npos);
@@ -114,7 +114,7 @@ TEST(StubReportServiceTest, GenerateReportReturnsFalseAndIncludesReportType)
 TEST(StubReportServiceTest, GenerateReportWithDifferentTypeIncludesTypeName)
 {
     StubReportService svc;
-    ReportRequest req{"Blotter", "2026-01-01", "2026-01-31"};
+    ReportRequest req{"Blotter", TradingDate::fromCivil(2026, 1, 1), TradingDate::fromCivil(2026, 1, 31)};
     Response r = svc.generateReport(req);
     EXPECT_FALSE(r.success);
     EXPECT_NE(r.message.find("Blotter"), std::string::npos);
@@ -153,9 +153,7 @@ namespace
 
         registry.registerCommand(RequestType::GENERATE_REPORT,
             [rs](const Request& r) {
-                ReportRequest rr{"EndOfDay", "2026-01-01", "2026-12-31"};
-                (void)r;
-                return std::make_unique<ReportCommand>(rs, rr);
+                return std::make_unique<ReportCommand>(rs, r);
             });
 
         return TradingServerFacade(mds, cs, ms, rs, std::move(registry));
@@ -0,0 +1,234 @@
+/**
+ * @file test_ServiceReadiness.cpp
+ * @brief Unit tests for ServiceReadiness and WarmupServerFacade.
+ *
+ * Tests: a gated type is refused until its service is ready, names the
+ * service it waits for, and stays refused if loading failed; ungated
+ * types are always admitted; a type gated by two services waits for both;
+ * BATCH is admitted by its sub-requests; statuses report state and load
+ * time; invalid registrations throw; and the facade decorator refusing
+ * without reaching the inner facade.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ServiceReadiness.hpp"
+#include "WarmupServerFacade.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    Request request(RequestType type)
+    {
+        Request req;
+        req.type      = type;
+        req.sessionId = 1;
+        return req;
+    }
+
+    /// BATCH of empty sub-requests of the given types.
+    Request batch(const std::vector<RequestType>& types)
+    {
+        std::vector<BatchItemPOD> items;
+        for (RequestType type : types)
+            items.push_back(BatchItemPOD{static_cast<uint32_t>(type), 0});
+        Request req = request(RequestType::BATCH);
+        req.payload = makePodPayload(items.data(), items.size());
+        return req;
+    }
+
+    bool admitted(const ServiceReadiness& readiness, const Request& req)
+    {
+        Response refusal;
+        return readiness.admit(req, refusal);
+    }
+
+    /// Counts the requests that reach it.
+    class CountingFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request&) override
+        {
+            ++calls;
+            return Response{true, "served", {}};
+        }
+
+        int calls{0};
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Admission
+// ---------------------------------------------------------------------------
+
+TEST(ServiceReadinessTest, GatedTypeIsRefusedUntilReady)
+{
+    ServiceReadiness readiness;
+    const auto       reports = readiness.addService("reports", {RequestType::GENERATE_REPORT});
+
+    Response refusal;
+    EXPECT_FALSE(readiness.admit(request(RequestType::GENERATE_REPORT), refusal));
+    EXPECT_FALSE(refusal.success);
+    EXPECT_EQ(refusal.message, "Warming up: reports is still loading");
+    EXPECT_FALSE(readiness.allReady());
+
+    EXPECT_TRUE(readiness.markReady(reports));
+    EXPECT_FALSE(readiness.markReady(reports)); // once only
+    EXPECT_TRUE(admitted(readiness, request(RequestType::GENERATE_REPORT)));
+    EXPECT_TRUE(readiness.allReady());
+}
+
+TEST(ServiceReadinessTest, UngatedTypesAreAlwaysAdmitted)
+{
+    ServiceReadiness readiness;
+    readiness.addService("trades", {RequestType::MANIPULATE});
+
+    EXPECT_TRUE(admitted(readiness, request(RequestType::GET_STATS)));
+    EXPECT_TRUE(admitted(readiness, request(RequestType::GET_MARKET_DATA)));
+    EXPECT_TRUE(admitted(readiness, request(static_cast<RequestType>(999))));
+    EXPECT_FALSE(admitted(readiness, request(RequestType::MANIPULATE)));
+}
+
+TEST(ServiceReadinessTest, FailedServiceStaysRefused)
+{
+    ServiceReadiness readiness;
+    const auto       trades = readiness.addService("trades", {RequestType::MANIPULATE, RequestType::SUBMIT_ORDER});
+
+    EXPECT_TRUE(readiness.markFailed(trades));
+    EXPECT_FALSE(readiness.markReady(trades));
+
+    Response refusal;
+    EXPECT_FALSE(readiness.admit(request(RequestType::SUBMIT_ORDER), refusal));
+    EXPECT_EQ(refusal.message, "Unavailable: trades failed to load");
+    EXPECT_FALSE(readiness.allReady());
+}
+
+TEST(ServiceReadinessTest, TypeGatedByTwoServicesWaitsForBoth)
+{
+    ServiceReadiness readiness;
+    const auto       trades  = readiness.addService("trades", {RequestType::GENERATE_REPORT});
+    const auto       reports = readiness.addService("reports", {RequestType::GENERATE_REPORT});
+
+    readiness.markReady(reports);
+    Response refusal;
+    EXPECT_FALSE(readiness.admit(request(RequestType::GENERATE_REPORT), refusal));
+    EXPECT_EQ(refusal.message, "Warming up: trades is still loading");
+
+    readiness.markReady(trades);
+    EXPECT_TRUE(admitted(readiness, request(RequestType::GENERATE_REPORT)));
+}
+
+TEST(ServiceReadinessTest, BatchIsAdmittedByItsSubRequests)
+{
+    ServiceReadiness readiness;
+    readiness.addService("market data", {RequestType::GET_MARKET_DATA});
+    const auto reports = readiness.addService("reports", {RequestType::GENERATE_REPORT});
+
+    readiness.markReady(0);
+    EXPECT_TRUE(admitted(readiness, batch({RequestType::GET_MARKET_DATA, RequestType::GET_STATS})));
+
+    Response refusal;
+    EXPECT_FALSE(readiness.admit(batch({RequestType::GET_MARKET_DATA, RequestType::GENERATE_REPORT}), refusal));
+    EXPECT_EQ(refusal.message, "Warming up: reports is still loading");
+
+    // A malformed batch is left for BatchCommand to refuse.
+    Request malformed = request(RequestType::BATCH);
+    EXPECT_TRUE(admitted(readiness, malformed));
+
+    readiness.markReady(reports);
+    EXPECT_TRUE(admitted(readiness, batch({RequestType::GENERATE_REPORT})));
+}
+
+// ---------------------------------------------------------------------------
+// Status
+// ---------------------------------------------------------------------------
+
+TEST(ServiceReadinessTest, StatusesReportStateAndLoadTime)
+{
+    ServiceReadiness readiness;
+    const auto       marketData = readiness.addService("market data", {RequestType::GET_MARKET_DATA});
+    readiness.addService("reports", {RequestType::GENERATE_REPORT});
+    const auto trades = readiness.addService("trades", {RequestType::MANIPULATE});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    readiness.markReady(marketData);
+    readiness.markFailed(trades);
+
+    const auto statuses = readiness.statuses();
+    ASSERT_EQ(statuses.size(), 3u);
+    EXPECT_EQ(statuses[0].name, "market data");
+    EXPECT_EQ(statuses[0].state, ServiceState::READY);
+    EXPECT_GE(statuses[0].elapsed.count(), 5);
+    EXPECT_EQ(statuses[1].state, ServiceState::WARMING_UP);
+    EXPECT_EQ(statuses[2].state, ServiceState::FAILED);
+
+    // A settled service keeps its load time; one warming up keeps counting.
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(readiness.status(marketData).elapsed, statuses[0].elapsed);
+    EXPECT_GE(readiness.status(1).elapsed.count(), 10);
+}
+
+TEST(ServiceReadinessTest, InvalidRegistrationsThrow)
+{
+    ServiceReadiness readiness;
+    EXPECT_THROW(readiness.addService("", {RequestType::CALCULATE}), std::invalid_argument);
+    EXPECT_THROW(readiness.addService("batches", {RequestType::BATCH}), std::invalid_argument);
+    EXPECT_THROW(readiness.addService("unknown", {static_cast<RequestType>(999)}), std::invalid_argument);
+    EXPECT_THROW(readiness.markReady(7), std::out_of_range);
+    EXPECT_TRUE(readiness.allReady());
+}
+
+// ---------------------------------------------------------------------------
+// WarmupServerFacade
+// ---------------------------------------------------------------------------
+
+TEST(WarmupServerFacadeTest, RefusesWithoutReachingTheInnerFacade)
+{
+    auto readiness = std::make_shared<ServiceReadiness>();
+    readiness->addService("reports", {RequestType::GENERATE_REPORT});
+    auto               inner = std::make_shared<CountingFacade>();
+    WarmupServerFacade facade(inner, readiness);
+
+    const Response refused = facade.handleRequest(request(RequestType::GENERATE_REPORT));
+    EXPECT_FALSE(refused.success);
+    EXPECT_EQ(refused.message, "Warming up: reports is still loading");
+    EXPECT_EQ(inner->calls, 0);
+
+    // Market data is served while reports are still loading.
+    EXPECT_TRUE(facade.handleRequest(request(RequestType::GET_MARKET_DATA)).success);
+    EXPECT_EQ(inner->calls, 1);
+
+    readiness->markReady(0);
+    EXPECT_TRUE(facade.handleRequestStreaming(request(RequestType::GENERATE_REPORT), nullptr).success);
+    EXPECT_EQ(inner->calls, 2);
+}
+
+TEST(WarmupServerFacadeTest, AsyncRefusalCompletesInline)
+{
+    auto readiness = std::make_shared<ServiceReadiness>();
+    readiness->addService("orders", {RequestType::SUBMIT_ORDER});
+    auto               inner = std::make_shared<CountingFacade>();
+    WarmupServerFacade facade(inner, readiness);
+
+    bool     completed = false;
+    Response reply;
+    facade.handleRequestAsync(request(RequestType::SUBMIT_ORDER), [&](Response r) {
+        completed = true;
+        reply     = std::move(r);
+    });
+    EXPECT_TRUE(completed);
+    EXPECT_FALSE(reply.success);
+    EXPECT_EQ(inner->calls, 0);
+}
+
+TEST(WarmupServerFacadeTest, NullArgumentsThrow)
+{
+    auto readiness = std::make_shared<ServiceReadiness>();
+    EXPECT_THROW(WarmupServerFacade(nullptr, readiness), std::invalid_argument);
+    EXPECT_THROW(WarmupServerFacade(std::make_shared<CountingFacade>(), nullptr), std::invalid_argument);
+}
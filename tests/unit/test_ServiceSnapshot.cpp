@@ -0,0 +1,246 @@
+/**
+ * @file test_ServiceSnapshot.cpp
+ * @brief Unit tests for saving and restoring the services' state.
+ *
+ * Tests: market data, resident books and resident trades survive a
+ * save/restore into fresh services, books keep their recency order and are
+ * re-marked from the restored prices, trades of another day are left to
+ * the journal, parts are reported in order as they are restored, and a
+ * missing snapshot means a cold start.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ServiceSnapshot.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    const TradingDate kDay = TradingDate::fromCivil(2024, 3, 1);
+
+    PositionPOD makePosition(const char* symbol, int64_t quantity, double avgPrice)
+    {
+        PositionPOD p{};
+        std::strncpy(p.symbol, symbol, sizeof(p.symbol) - 1);
+        p.quantity = quantity;
+        p.avgPrice = avgPrice;
+        return p;
+    }
+
+    MarketDataPOD makeSnapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+
+    TradePOD makeTrade(uint64_t id, int64_t timestamp)
+    {
+        TradePOD t{};
+        t.tradeId = id;
+        std::strcpy(t.symbol, "AAPL");
+        t.price     = 100.0;
+        t.quantity  = id;
+        t.timestamp = timestamp;
+        return t;
+    }
+
+    Request makeRequest(const std::vector<PositionPOD>& positions)
+    {
+        Request req;
+        req.type    = RequestType::CALCULATE;
+        req.payload = makePodPayload(positions.data(), positions.size());
+        return req;
+    }
+
+    double totalPnl(const Response& response)
+    {
+        PodArrayView<PositionPOD> positions;
+        std::size_t               consumed = 0;
+        EXPECT_EQ(pod::bindSection(response.data.data(), response.data.size(), positions, consumed),
+                  PodDecodeStatus::OK);
+        PodView<RiskSummaryPOD> summary;
+        EXPECT_EQ(pod::bindOne(response.data.data() + consumed, response.data.size() - consumed, summary),
+                  PodDecodeStatus::OK);
+        return summary.valid() ? summary->totalUnrealisedPnl : 0.0;
+    }
+
+    /// One set of services, as main builds them.
+    struct Services
+    {
+        explicit Services(std::size_t residentBooks = 4)
+            : marketData(std::make_shared<InMemoryMarketDataService>(64))
+            , calculation(std::make_shared<CalculationEngine>(marketData, CalculationConfig{0.99, 0, residentBooks}))
+            , manipulation(std::make_shared<ManipulationEngine>())
+            , snapshot(marketData, calculation, manipulation)
+        {}
+
+        std::shared_ptr<InMemoryMarketDataService> marketData;
+        std::shared_ptr<CalculationEngine>         calculation;
+        std::shared_ptr<ManipulationEngine>        manipulation;
+        ServiceSnapshot                            snapshot;
+    };
+
+    /// A snapshot path in a fresh directory removed at the end of the test.
+    class SnapshotDirectory
+    {
+    public:
+        SnapshotDirectory()
+            : m_path(std::filesystem::temp_directory_path()
+                     / ("hft_service_snapshot_" + std::to_string(::getpid()) + "_"
+                        + ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+        {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+        ~SnapshotDirectory() { std::filesystem::remove_all(m_path); }
+
+        std::string file() const { return (m_path / "state.snap").string(); }
+
+    private:
+        std::filesystem::path m_path;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Save and restore
+// ---------------------------------------------------------------------------
+
+TEST(ServiceSnapshotTest, RestoresMarketDataBooksAndTrades)
+{
+    SnapshotDirectory dir;
+    const auto        book = makeRequest({makePosition("AAPL", 10, 100.0), makePosition("MSFT", -5, 300.0)});
+
+    Services before;
+    before.marketData->update(makeSnapshot("AAPL", 110.0));
+    before.marketData->update(makeSnapshot("MSFT", 290.0));
+    const double pnl = totalPnl(before.calculation->calculate(book));
+    const int64_t midnight = int64_t{kDay.days} * ManipulationEngine::kMicrosPerDay;
+    const std::vector<TradePOD> trades = {makeTrade(1, midnight + 1), makeTrade(2, midnight + 2),
+                                          makeTrade(3, midnight + 3)};
+    before.manipulation->recordTrades(trades.data(), trades.size());
+    EXPECT_GT(before.snapshot.save(dir.file(), kDay), 0u);
+
+    Services   after;
+    const auto restored = after.snapshot.restore(dir.file(), kDay);
+    EXPECT_TRUE(restored.found);
+    EXPECT_GT(restored.createdAt, 0);
+    EXPECT_EQ(restored.symbols, 2u);
+    EXPECT_EQ(restored.books, 1u);
+    EXPECT_EQ(restored.trades, 3u);
+    EXPECT_EQ(restored.tradeReplayFrom, 3u);
+
+    MarketDataPOD md;
+    ASSERT_TRUE(after.marketData->cache().load(after.marketData->intern("MSFT"), md));
+    EXPECT_DOUBLE_EQ(md.last, 290.0);
+    EXPECT_EQ(after.manipulation->tradeCount(), 3u);
+    EXPECT_EQ(after.manipulation->trades()[2].tradeId, 3u);
+
+    // The restored book serves the request; no new book is loaded.
+    EXPECT_DOUBLE_EQ(totalPnl(after.calculation->calculate(book)), pnl);
+    EXPECT_EQ(after.calculation->residentBookCount(), 1u);
+
+    // ...and it is live: ticks after the restore move it.
+    after.marketData->update(makeSnapshot("AAPL", 120.0));
+    EXPECT_DOUBLE_EQ(totalPnl(after.calculation->calculate(book)), pnl + 100.0);
+}
+
+TEST(ServiceSnapshotTest, BooksKeepTheirRecencyOrder)
+{
+    SnapshotDirectory dir;
+
+    Services before;
+    before.marketData->update(makeSnapshot("AAPL", 110.0));
+    before.calculation->calculate(makeRequest({makePosition("AAPL", 1, 100.0)}));
+    before.calculation->calculate(makeRequest({makePosition("AAPL", 2, 100.0)})); // most recent
+    before.snapshot.save(dir.file(), kDay);
+
+    // Room for one book: the most recently used one is kept.
+    Services after(1);
+    EXPECT_EQ(after.snapshot.restore(dir.file(), kDay).books, 1u);
+
+    std::vector<PositionPOD> positions;
+    std::vector<std::size_t> bookSizes;
+    after.calculation->exportResidentBooks(positions, bookSizes);
+    ASSERT_EQ(bookSizes.size(), 1u);
+    ASSERT_EQ(positions.size(), 1u);
+    EXPECT_EQ(positions[0].quantity, 2);
+    EXPECT_DOUBLE_EQ(positions[0].unrealisedPnl, 20.0);
+}
+
+TEST(ServiceSnapshotTest, TradesOfAnotherDayAreLeftToTheJournal)
+{
+    SnapshotDirectory dir;
+
+    Services before;
+    before.marketData->update(makeSnapshot("AAPL", 110.0));
+    const TradePOD trade = makeTrade(1, int64_t{kDay.days} * ManipulationEngine::kMicrosPerDay);
+    before.manipulation->recordTrades(&trade, 1);
+    before.snapshot.save(dir.file(), kDay);
+
+    Services   after;
+    const auto restored = after.snapshot.restore(dir.file(), TradingDate{kDay.days + 1});
+    EXPECT_TRUE(restored.found);
+    EXPECT_EQ(restored.symbols, 1u);
+    EXPECT_EQ(restored.trades, 0u);
+    EXPECT_EQ(restored.tradeReplayFrom, 0u);
+    EXPECT_EQ(after.manipulation->tradeCount(), 0u);
+}
+
+TEST(ServiceSnapshotTest, PartsAreReportedAsTheyAreRestored)
+{
+    SnapshotDirectory dir;
+
+    Services before;
+    before.marketData->update(makeSnapshot("AAPL", 110.0));
+    before.calculation->calculate(makeRequest({makePosition("AAPL", 1, 100.0)}));
+    const TradePOD trade = makeTrade(1, int64_t{kDay.days} * ManipulationEngine::kMicrosPerDay);
+    before.manipulation->recordTrades(&trade, 1);
+    before.snapshot.save(dir.file(), kDay);
+
+    // Each part is visible in its service by the time it is reported.
+    Services                           after;
+    std::vector<ServiceSnapshot::Part> parts;
+    after.snapshot.restore(dir.file(), kDay, [&](ServiceSnapshot::Part part) {
+        parts.push_back(part);
+        if (part == ServiceSnapshot::Part::MARKET_DATA)
+        {
+            EXPECT_EQ(after.marketData->cache().size(), 1u);
+            EXPECT_EQ(after.calculation->residentBookCount(), 0u);
+        }
+        if (part == ServiceSnapshot::Part::RESIDENT_BOOKS)
+        {
+            EXPECT_EQ(after.calculation->residentBookCount(), 1u);
+            EXPECT_EQ(after.manipulation->tradeCount(), 0u);
+        }
+        if (part == ServiceSnapshot::Part::TRADES)
+        {
+            EXPECT_EQ(after.manipulation->tradeCount(), 1u);
+        }
+    });
+    EXPECT_EQ(parts, (std::vector<ServiceSnapshot::Part>{ServiceSnapshot::Part::MARKET_DATA,
+                                                          ServiceSnapshot::Part::RESIDENT_BOOKS,
+                                                          ServiceSnapshot::Part::TRADES}));
+}
+
+TEST(ServiceSnapshotTest, MissingSnapshotMeansColdStart)
+{
+    SnapshotDirectory dir;
+    Services          services;
+
+    bool       reported = false;
+    const auto restored = services.snapshot.restore(dir.file(), kDay, [&](ServiceSnapshot::Part) { reported = true; });
+    EXPECT_FALSE(restored.found);
+    EXPECT_FALSE(reported);
+    EXPECT_EQ(restored.symbols, 0u);
+    EXPECT_EQ(services.marketData->cache().size(), 0u);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_ShardedExecutor.cpp
+ * @brief Unit tests for the ShardedExecutor thread-per-shard executor.
+ *
+ * Tests: the jobs of a shard run in order on one owner thread of their
+ * own, a full queue refuses a job and leaves it intact, stop() hands the
+ * jobs left queued to the drain and refuses new ones, and invalid
+ * configurations are rejected.
+ */
+
+#include <gtest/gtest.h>
+
+#include "concurrency/ShardedExecutor.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Job
+    {
+        uint64_t             key{0};
+        std::unique_ptr<int> payload;
+    };
+
+    /// Blocks the owner of shard 0 in its handler until released.
+    struct Gate
+    {
+        void wait()
+        {
+            entered.set_value();
+            released.get_future().wait();
+        }
+
+        std::promise<void> entered;
+        std::promise<void> released;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Routing
+// ---------------------------------------------------------------------------
+
+TEST(ShardedExecutorTest, JobsOfAShardRunInOrderOnItsOwnerThread)
+{
+    struct Seen
+    {
+        std::vector<uint64_t>      keys;
+        std::set<std::thread::id> threads;
+    };
+    std::vector<Seen> seen(3); // each entry is only written by its shard's owner
+
+    {
+        ShardedExecutor<Job> executor(ShardedExecutorConfig{3, 512, -1}, [&seen](std::size_t shard, Job& job) {
+            seen[shard].keys.push_back(job.key);
+            seen[shard].threads.insert(std::this_thread::get_id());
+        });
+        ASSERT_EQ(executor.shards(), 3u);
+        for (uint64_t key = 0; key < 300; ++key)
+        {
+            while (!executor.post(executor.shardOf(key), Job{key, nullptr}))
+                std::this_thread::yield();
+        }
+        while (executor.queueDepth(0) + executor.queueDepth(1) + executor.queueDepth(2) > 0)
+            std::this_thread::yield();
+        executor.stop([](Job&) { FAIL() << "nothing should be left queued"; });
+    }
+
+    std::set<std::thread::id> owners;
+    for (std::size_t shard = 0; shard < seen.size(); ++shard)
+    {
+        ASSERT_EQ(seen[shard].keys.size(), 100u);
+        for (std::size_t i = 0; i < seen[shard].keys.size(); ++i)
+            EXPECT_EQ(seen[shard].keys[i], i * 3 + shard);
+        ASSERT_EQ(seen[shard].threads.size(), 1u);
+        owners.insert(*seen[shard].threads.begin());
+    }
+    EXPECT_EQ(owners.size(), 3u);
+    EXPECT_EQ(owners.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(ShardedExecutorTest, FullQueueRefusesAndLeavesTheJobIntact)
+{
+    Gate                 gate;
+    ShardedExecutor<Job> executor(ShardedExecutorConfig{1, 2, -1}, [&gate](std::size_t, Job& job) {
+        if (job.key == 0)
+            gate.wait();
+    });
+
+    ASSERT_TRUE(executor.post(0, Job{0, nullptr}));
+    gate.entered.get_future().wait(); // the owner holds job 0; the queue is empty again
+    ASSERT_TRUE(executor.post(0, Job{1, nullptr}));
+    ASSERT_TRUE(executor.post(0, Job{2, nullptr}));
+
+    Job refused{3, std::make_unique<int>(42)};
+    EXPECT_FALSE(executor.post(0, std::move(refused)));
+    ASSERT_NE(refused.payload, nullptr);
+    EXPECT_EQ(*refused.payload, 42);
+    EXPECT_EQ(executor.queueDepth(0), 2u);
+
+    gate.released.set_value();
+}
+
+// ---------------------------------------------------------------------------
+// Lifetime
+// ---------------------------------------------------------------------------
+
+TEST(ShardedExecutorTest, StopDrainsQueuedJobsAndRefusesNewOnes)
+{
+    Gate                 gate;
+    std::vector<uint64_t> handled;
+    ShardedExecutor<Job> executor(ShardedExecutorConfig{1, 8, -1}, [&](std::size_t, Job& job) {
+        handled.push_back(job.key);
+        if (job.key == 0)
+            gate.wait();
+    });
+
+    ASSERT_TRUE(executor.post(0, Job{0, nullptr}));
+    gate.entered.get_future().wait();
+    for (uint64_t key = 1; key <= 3; ++key)
+        ASSERT_TRUE(executor.post(0, Job{key, nullptr}));
+
+    std::vector<uint64_t> drained;
+    std::thread           stopper([&]() { executor.stop([&drained](Job& job) { drained.push_back(job.key); }); });
+    while (!executor.stopping())
+        std::this_thread::yield();
+    EXPECT_FALSE(executor.post(0, Job{99, nullptr}));
+    gate.released.set_value();
+    stopper.join();
+
+    EXPECT_EQ(handled, std::vector<uint64_t>{0});
+    EXPECT_EQ(drained, (std::vector<uint64_t>{1, 2, 3}));
+    EXPECT_FALSE(executor.post(0, Job{4, nullptr}));
+    executor.stop([](Job&) { FAIL() << "a second stop() drains nothing"; });
+}
+
+TEST(ShardedExecutorTest, RejectsInvalidConfigurations)
+{
+    const auto noop = [](std::size_t, Job&) {};
+    EXPECT_THROW(ShardedExecutor<Job>(ShardedExecutorConfig{0, 8, -1}, noop), std::invalid_argument);
+    EXPECT_THROW(ShardedExecutor<Job>(ShardedExecutorConfig{1, 0, -1}, noop), std::invalid_argument);
+    EXPECT_THROW(ShardedExecutor<Job>(ShardedExecutorConfig{1, 8, -1}, {}), std::invalid_argument);
+}
@@ -0,0 +1,378 @@
+/**
+ * @file test_ShmTransport.cpp
+ * @brief Unit tests for the shared-memory rings and ShmTransport.
+ *
+ * Tests: rings wrap around and pass data larger than themselves in parts,
+ * a region of another version is refused, requests are answered with
+ * futex and spin wake-ups, tagged requests are pipelined, broadcasts reach
+ * attached clients, a detached client's session is removed, an unknown
+ * region is refused, stopping the server ends the client's stream, and
+ * corrupted ring positions never overrun a ring and close the session.
+ */
+
+#include <gtest/gtest.h>
+
+#include "FrameCodec.hpp"
+#include "ShmClient.hpp"
+#include "ShmRing.hpp"
+#include "ShmTransport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    using Unix = boost::asio::local::stream_protocol;
+
+    /// Echoes the request payload back, with the request type as the message.
+    class EchoFacade : public IServerFacade
+    {
+    public:
+        Response handleRequest(const Request& request) override
+        {
+            ++requests;
+            return Response{true, std::to_string(static_cast<unsigned>(request.type)), request.payload};
+        }
+
+        std::atomic<int> requests{0};
+    };
+
+    RawBuffer requestFrame(RequestType type, std::vector<uint8_t> payload, uint64_t id = 0)
+    {
+        Request request;
+        request.type         = type;
+        request.payload      = RawBuffer(payload);
+        request.hasRequestId = id != 0;
+        request.requestId    = id;
+        return framing::makeFrame(framing::encodeRequest(request));
+    }
+
+    template <typename Stream>
+    void writeFrame(Stream& stream, const RawBuffer& frame)
+    {
+        boost::asio::write(stream, boost::asio::buffer(frame.data(), frame.size()));
+    }
+
+    template <typename Stream>
+    Response readResponse(Stream& stream)
+    {
+        uint8_t prefix[framing::kLengthPrefixSize];
+        boost::asio::read(stream, boost::asio::buffer(prefix));
+        RawBuffer payload(framing::decodeBE32(prefix));
+        boost::asio::read(stream, boost::asio::buffer(payload.data(), payload.size()));
+
+        Response response;
+        EXPECT_TRUE(framing::decodeResponse(payload, response));
+        return response;
+    }
+
+    /// Poll @p condition for up to a second.
+    template <typename Condition>
+    bool eventually(Condition condition)
+    {
+        for (int i = 0; i < 1000 && !condition(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return condition();
+    }
+
+    std::string controlPath(const char* name)
+    {
+        return "/tmp/hft_test_" + std::to_string(::getpid()) + "_" + name + ".shm";
+    }
+
+    std::string regionName(const char* name)
+    {
+        return "/hft-test-" + std::to_string(::getpid()) + "-" + name;
+    }
+
+    /// Control block of a region's request (0) or response (1) ring; see ShmRing.hpp for the layout.
+    shm::RingControl& ringControl(shm::Region& region, int ring)
+    {
+        auto* controls = reinterpret_cast<shm::RingControl*>(reinterpret_cast<uint8_t*>(&region.header())
+                                                             + sizeof(shm::RegionHeader));
+        return controls[ring];
+    }
+
+    TransportConfig spinConfig(bool spin)
+    {
+        TransportConfig config;
+        config.shmBusySpin = spin;
+        return config;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Rings
+// ---------------------------------------------------------------------------
+
+TEST(ShmRingTest, WrapsAroundAndPassesDataLargerThanTheRing)
+{
+    const std::string name   = regionName("wrap");
+    shm::Region       client = shm::Region::create(name, shm::kMinRingBytes);
+    shm::Region       server = shm::Region::open(name);
+    shm::Region::unlink(name);
+
+    shm::Ring producer = client.requests();
+    shm::Ring consumer = server.requests();
+    ASSERT_EQ(producer.capacity(), shm::kMinRingBytes);
+
+    std::vector<uint8_t> data(3000);
+    std::iota(data.begin(), data.end(), uint8_t{0});
+    std::vector<uint8_t> out(data.size());
+    for (int round = 0; round < 3; ++round) // the second and third rounds wrap
+    {
+        ASSERT_EQ(producer.write(data.data(), data.size(), true), data.size());
+        ASSERT_EQ(consumer.readable(), data.size());
+        ASSERT_EQ(consumer.read(out.data(), out.size(), true), out.size());
+        EXPECT_EQ(out, data);
+    }
+
+    // More than fits: a partial write, then the rest once the reader made room.
+    std::vector<uint8_t> large(3 * shm::kMinRingBytes + 123);
+    std::iota(large.begin(), large.end(), uint8_t{7});
+    EXPECT_EQ(producer.write(large.data(), large.size(), true), shm::kMinRingBytes);
+    EXPECT_EQ(producer.writable(), 0u);
+
+    std::thread writer([&producer, &large]()
+                       { producer.writeAll(large.data() + shm::kMinRingBytes, large.size() - shm::kMinRingBytes,
+                                           []() { return false; }, shm::WakeMode::FUTEX, true); });
+    std::vector<uint8_t> received(large.size());
+    EXPECT_TRUE(consumer.readAll(received.data(), received.size(), []() { return false; }, shm::WakeMode::FUTEX, true));
+    writer.join();
+    EXPECT_EQ(received, large);
+}
+
+TEST(ShmRingTest, RefusesARegionOfAnotherVersion)
+{
+    const std::string name   = regionName("version");
+    shm::Region       client = shm::Region::create(name, shm::kMinRingBytes);
+    client.header().version  = shm::kRegionVersion + 1;
+
+    EXPECT_THROW(shm::Region::open(name), std::runtime_error);
+    EXPECT_THROW(shm::Region::create(regionName("size"), 5000), std::invalid_argument);
+    shm::Region::unlink(name);
+}
+
+TEST(ShmRingTest, CorruptPositionsNeverOverrunTheRing)
+{
+    shm::RingControl     control;
+    std::vector<uint8_t> bytes(shm::kMinRingBytes);
+    shm::Ring            ring(&control, bytes.data(), shm::kMinRingBytes);
+    std::vector<uint8_t> out(1 << 20);
+    const auto           never = []() { return false; };
+
+    // A head far ahead of the tail: nothing is readable, nothing writable.
+    control.head = 1 << 20;
+    EXPECT_TRUE(ring.corrupt());
+    EXPECT_EQ(ring.readable(), 0u);
+    EXPECT_EQ(ring.writable(), 0u);
+    EXPECT_EQ(ring.read(out.data(), out.size(), false), 0u);
+    EXPECT_EQ(ring.peek(out.data(), out.size()), 0u);
+    EXPECT_FALSE(ring.readAll(out.data(), out.size(), never, shm::WakeMode::FUTEX, false));
+
+    // A tail past the head.
+    control.head = 100;
+    control.tail = 200;
+    EXPECT_TRUE(ring.corrupt());
+    EXPECT_EQ(ring.writable(), 0u);
+    EXPECT_EQ(ring.write(out.data(), out.size(), false), 0u);
+    EXPECT_FALSE(ring.writeAll(out.data(), out.size(), never, shm::WakeMode::SPIN, false));
+    EXPECT_EQ(control.head.load(), 100u);
+
+    // Exactly full is valid, and a read copies at most the ring.
+    control.head = 200 + shm::kMinRingBytes;
+    EXPECT_FALSE(ring.corrupt());
+    EXPECT_EQ(ring.read(out.data(), out.size(), false), shm::kMinRingBytes);
+}
+
+// ---------------------------------------------------------------------------
+// Request / reply
+// ---------------------------------------------------------------------------
+
+class ShmTransportWakeTest : public ::testing::TestWithParam<bool>
+{
+};
+
+TEST_P(ShmTransportWakeTest, AnswersFramedRequests)
+{
+    const bool        spin   = GetParam();
+    const std::string path   = controlPath(spin ? "spin" : "futex");
+    auto              facade = std::make_shared<EchoFacade>();
+    ShmTransport      transport(path, facade, spinConfig(spin));
+    transport.start();
+
+    ShmClient client(path, shm::kMinRingBytes, spin ? shm::WakeMode::SPIN : shm::WakeMode::FUTEX);
+    for (uint8_t i = 1; i <= 3; ++i)
+    {
+        writeFrame(client, requestFrame(RequestType::GET_MARKET_DATA, {i, 2, 3}));
+        const Response response = readResponse(client);
+        EXPECT_TRUE(response.success);
+        EXPECT_EQ(response.message, std::to_string(static_cast<unsigned>(RequestType::GET_MARKET_DATA)));
+        EXPECT_EQ(std::vector<uint8_t>(response.data.begin(), response.data.end()), (std::vector<uint8_t>{i, 2, 3}));
+        EXPECT_FALSE(response.hasRequestId);
+    }
+    EXPECT_EQ(facade->requests, 3);
+
+    transport.stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(WakeModes, ShmTransportWakeTest, ::testing::Values(false, true));
+
+TEST(ShmTransportTest, PipelinesTaggedRequestsAndRepliesLargerThanTheRing)
+{
+    const std::string path = controlPath("pipeline");
+    ShmTransport      transport(path, std::make_shared<EchoFacade>());
+    transport.start();
+
+    ShmClient client(path, shm::kMinRingBytes);
+    for (uint64_t id = 1; id <= 3; ++id)
+        writeFrame(client, requestFrame(RequestType::CALCULATE, {static_cast<uint8_t>(id)}, id));
+    for (uint64_t id = 1; id <= 3; ++id)
+    {
+        const Response response = readResponse(client);
+        ASSERT_TRUE(response.hasRequestId);
+        ASSERT_EQ(response.data.size(), 1u);
+        EXPECT_EQ(response.data[0], response.requestId); // the echo carries its own id
+    }
+
+    // Four times the ring each way: both frames pass through in parts.
+    std::vector<uint8_t> large(4 * shm::kMinRingBytes, 0x5a);
+    std::thread writer([&client, &large]() { writeFrame(client, requestFrame(RequestType::CALCULATE, large, 9)); });
+    const Response echoed = readResponse(client);
+    writer.join();
+    EXPECT_EQ(echoed.requestId, 9u);
+    EXPECT_EQ(echoed.data.size(), large.size());
+
+    transport.stop();
+}
+
+// ---------------------------------------------------------------------------
+// Sessions and broadcast
+// ---------------------------------------------------------------------------
+
+TEST(ShmTransportTest, BroadcastsReachClientsAndADetachedClientIsRemoved)
+{
+    const std::string path = controlPath("broadcast");
+    ShmTransport      transport(path, std::make_shared<EchoFacade>());
+    std::atomic<int>  closed{0};
+    transport.setSessionClosedHandler([&closed](uint64_t) { ++closed; });
+    transport.start();
+
+    auto      first = std::make_unique<ShmClient>(path, shm::kMinRingBytes);
+    ShmClient second(path, shm::kMinRingBytes);
+    ASSERT_TRUE(eventually([&transport]() { return transport.stats().sessions == 2; }));
+
+    Response push{true, "tick", RawBuffer({7})};
+    push.push             = true;
+    const RawBuffer frame = framing::encodeResponseFrame(push);
+    transport.send(frame.slice(framing::kLengthPrefixSize, frame.size() - framing::kLengthPrefixSize));
+    for (ShmClient* client : {first.get(), &second})
+    {
+        const Response received = readResponse(*client);
+        EXPECT_TRUE(received.push);
+        EXPECT_EQ(received.message, "tick");
+    }
+
+    first.reset(); // marks the region closed and closes the control socket
+    EXPECT_TRUE(eventually([&transport]() { return transport.stats().sessions == 1; }));
+    EXPECT_TRUE(eventually([&closed]() { return closed == 1; }));
+    EXPECT_EQ(transport.sessionStats().size(), 1u);
+
+    transport.stop();
+}
+
+TEST(ShmTransportTest, RefusesAnUnknownRegion)
+{
+    const std::string path = controlPath("refuse");
+    ShmTransport      transport(path, std::make_shared<EchoFacade>());
+    transport.start();
+
+    const std::string       name = regionName("missing");
+    boost::asio::io_context io;
+    Unix::socket            socket(io);
+    socket.connect(Unix::endpoint(path));
+    const auto prefix = framing::encodeBE32(static_cast<uint32_t>(name.size()));
+    boost::asio::write(socket, boost::asio::buffer(prefix));
+    boost::asio::write(socket, boost::asio::buffer(name));
+
+    uint8_t status = shm::kAttachAccepted;
+    boost::asio::read(socket, boost::asio::buffer(&status, 1));
+    EXPECT_EQ(status, shm::kAttachRefused);
+    EXPECT_EQ(transport.stats().sessions, 0u);
+
+    transport.stop();
+}
+
+TEST(ShmTransportTest, StopEndsTheClientStream)
+{
+    const std::string path = controlPath("stop");
+    ShmTransport      transport(path, std::make_shared<EchoFacade>());
+    transport.start();
+    ShmClient client(path, shm::kMinRingBytes);
+    ASSERT_TRUE(eventually([&transport]() { return transport.stats().sessions == 1; }));
+
+    transport.stop();
+
+    uint8_t                   byte = 0;
+    boost::system::error_code ec;
+    EXPECT_EQ(client.read_some(boost::asio::buffer(&byte, 1), ec), 0u);
+    EXPECT_EQ(ec, boost::asio::error::eof);
+    EXPECT_THROW(writeFrame(client, requestFrame(RequestType::GET_STATS, {})), boost::system::system_error);
+}
+
+TEST(ShmTransportTest, CorruptRingPositionsCloseTheSession)
+{
+    const std::string path = controlPath("corrupt");
+    ShmTransport      transport(path, std::make_shared<EchoFacade>());
+    transport.start();
+
+    for (const int ring : {0, 1})
+    {
+        const std::string name   = regionName(ring == 0 ? "corrupt-head" : "corrupt-tail");
+        shm::Region       region = shm::Region::create(name, shm::kMinRingBytes);
+
+        boost::asio::io_context io;
+        Unix::socket            socket(io);
+        socket.connect(Unix::endpoint(path));
+        const auto prefix = framing::encodeBE32(static_cast<uint32_t>(name.size()));
+        boost::asio::write(socket, boost::asio::buffer(prefix));
+        boost::asio::write(socket, boost::asio::buffer(name));
+        uint8_t status = shm::kAttachRefused;
+        boost::asio::read(socket, boost::asio::buffer(&status, 1));
+        shm::Region::unlink(name);
+        ASSERT_EQ(status, shm::kAttachAccepted);
+        ASSERT_TRUE(eventually([&transport]() { return transport.stats().sessions == 1; }));
+
+        if (ring == 0)
+        {
+            // Claims a megabyte of requests in a 4 KiB ring.
+            ringControl(region, 0).head = 1 << 20;
+            ringControl(region, 0).data.notify(true);
+        }
+        else
+        {
+            // A response tail past its head, then a request whose reply would use it.
+            ringControl(region, 1).tail = 1 << 20;
+            const RawBuffer frame = requestFrame(RequestType::GET_MARKET_DATA, {1, 2, 3});
+            ASSERT_EQ(region.requests().write(frame.data(), frame.size(), true), frame.size());
+        }
+
+        EXPECT_TRUE(eventually([&transport]() { return transport.stats().sessions == 0; })) << "ring " << ring;
+        EXPECT_TRUE(region.closed());
+    }
+
+    transport.stop();
+}
+
+TEST(ShmTransportTest, RejectsANullFacade)
+{
+    EXPECT_THROW(ShmTransport(controlPath("null"), nullptr), std::invalid_argument);
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_Snapshot.cpp
+ * @brief Unit tests for the snapshot file writer and reader.
+ *
+ * Tests: sections read back in place and 64-byte aligned, a missing file,
+ * rewriting replaces the previous snapshot, and rejecting files that are
+ * not snapshots, truncated, or read with the wrong record type.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Snapshot.hpp"
+#include "pod/TradingPOD.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    MarketDataPOD snapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last   = last;
+        md.volume = static_cast<uint64_t>(last * 10);
+        return md;
+    }
+
+    /// A snapshot path in a fresh directory removed at the end of the test.
+    class SnapshotDirectory
+    {
+    public:
+        SnapshotDirectory()
+            : m_path(std::filesystem::temp_directory_path()
+                     / ("hft_snapshot_" + std::to_string(::getpid()) + "_"
+                        + ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+        {
+            std::filesystem::remove_all(m_path);
+            std::filesystem::create_directories(m_path);
+        }
+        ~SnapshotDirectory() { std::filesystem::remove_all(m_path); }
+
+        std::string file() const { return (m_path / "state.snap").string(); }
+
+    private:
+        std::filesystem::path m_path;
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Round trip
+// ---------------------------------------------------------------------------
+
+TEST(SnapshotTest, SectionsAreReadBackInPlaceAndAligned)
+{
+    SnapshotDirectory dir;
+
+    const std::vector<MarketDataPOD> marketData = {snapshot("AAPL", 190.5), snapshot("MSFT", 410.25),
+                                                   snapshot("TSLA", 250.0)};
+    const JournalWatermark           watermark{19783, 0, 42};
+
+    SnapshotWriter writer;
+    writer.add(SnapshotSection::MARKET_DATA, marketData);
+    writer.add(SnapshotSection::RESIDENT_TRADES, std::vector<TradePOD>{});
+    writer.add(SnapshotSection::TRADE_WATERMARK, &watermark, 1);
+    const std::size_t bytes = writer.write(dir.file());
+    EXPECT_EQ(bytes % SnapshotWriter::kAlignment, 0u);
+    EXPECT_EQ(std::filesystem::file_size(dir.file()), bytes);
+    EXPECT_FALSE(std::filesystem::exists(dir.file() + ".tmp"));
+
+    const auto reader = SnapshotReader::open(dir.file());
+    ASSERT_NE(reader, nullptr);
+    EXPECT_GT(reader->createdAt(), 0);
+
+    const auto md = reader->section<MarketDataPOD>(SnapshotSection::MARKET_DATA);
+    ASSERT_EQ(md.size(), marketData.size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(md.data()) % SnapshotWriter::kAlignment, 0u);
+    for (std::size_t i = 0; i < marketData.size(); ++i)
+        EXPECT_EQ(std::memcmp(&md[i], &marketData[i], sizeof(MarketDataPOD)), 0) << "record " << i;
+
+    EXPECT_TRUE(reader->section<TradePOD>(SnapshotSection::RESIDENT_TRADES).empty());
+    const auto mark = reader->section<JournalWatermark>(SnapshotSection::TRADE_WATERMARK);
+    ASSERT_EQ(mark.size(), 1u);
+    EXPECT_EQ(mark[0].day, 19783);
+    EXPECT_EQ(mark[0].records, 42u);
+
+    EXPECT_TRUE(reader->section<PositionPOD>(SnapshotSection::RESIDENT_POSITIONS).empty());
+}
+
+TEST(SnapshotTest, MissingFileIsNotAnError)
+{
+    SnapshotDirectory dir;
+    EXPECT_EQ(SnapshotReader::open(dir.file()), nullptr);
+}
+
+TEST(SnapshotTest, RewriteReplacesPreviousSnapshot)
+{
+    SnapshotDirectory dir;
+
+    {
+        const std::vector<MarketDataPOD> first = {snapshot("AAPL", 1.0), snapshot("MSFT", 2.0)};
+        SnapshotWriter                   writer;
+        writer.add(SnapshotSection::MARKET_DATA, first);
+        writer.write(dir.file());
+    }
+    const auto earlier = SnapshotReader::open(dir.file());
+
+    const std::vector<MarketDataPOD> second = {snapshot("AAPL", 3.0)};
+    SnapshotWriter                   writer;
+    writer.add(SnapshotSection::MARKET_DATA, second);
+    writer.write(dir.file());
+
+    const auto latest = SnapshotReader::open(dir.file());
+    const auto md     = latest->section<MarketDataPOD>(SnapshotSection::MARKET_DATA);
+    ASSERT_EQ(md.size(), 1u);
+    EXPECT_DOUBLE_EQ(md[0].last, 3.0);
+
+    // A reader of the old file keeps its mapping across the rename.
+    ASSERT_EQ(earlier->section<MarketDataPOD>(SnapshotSection::MARKET_DATA).size(), 2u);
+}
+
+// ---------------------------------------------------------------------------
+// Validation
+// ---------------------------------------------------------------------------
+
+TEST(SnapshotTest, RejectsFilesThatAreNotSnapshots)
+{
+    SnapshotDirectory dir;
+
+    std::ofstream(dir.file()) << std::string(256, 'x');
+    EXPECT_THROW(SnapshotReader::open(dir.file()), std::runtime_error);
+
+    std::ofstream(dir.file(), std::ios::trunc) << "HFT";
+    EXPECT_THROW(SnapshotReader::open(dir.file()), std::runtime_error);
+}
+
+TEST(SnapshotTest, RejectsTruncatedSection)
+{
+    SnapshotDirectory dir;
+
+    const std::vector<MarketDataPOD> marketData(100, snapshot("AAPL", 1.0));
+    SnapshotWriter                   writer;
+    writer.add(SnapshotSection::MARKET_DATA, marketData);
+    const std::size_t bytes = writer.write(dir.file());
+
+    std::filesystem::resize_file(dir.file(), bytes / 2);
+    EXPECT_THROW(SnapshotReader::open(dir.file()), std::runtime_error);
+}
+
+TEST(SnapshotTest, RejectsSectionReadAsAnotherRecordType)
+{
+    SnapshotDirectory dir;
+
+    const std::vector<MarketDataPOD> marketData = {snapshot("AAPL", 1.0)};
+    SnapshotWriter                   writer;
+    writer.add(SnapshotSection::MARKET_DATA, marketData);
+    writer.write(dir.file());
+
+    const auto reader = SnapshotReader::open(dir.file());
+    EXPECT_THROW(reader->section<TradePOD>(SnapshotSection::MARKET_DATA), std::runtime_error);
+}
@@ -0,0 +1,239 @@
+/**
+ * @file test_StatsService.cpp
+ * @brief Unit tests for the GET_STATS snapshot.
+ *
+ * Tests: the five sections decode in order, attached transport, session,
+ * lane and readiness sources fill their records, resident book hits and
+ * misses are reported, and an unattached service answers with zeros, no
+ * sessions and no services.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StatsService.hpp"
+#include "memory/BufferPool.hpp"
+#include "metrics/LatencyRecorder.hpp"
+#include "pod/PodView.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// The sections of one GET_STATS reply.
+    struct Snapshot
+    {
+        PodArrayView<ServerStatsPOD>      server;
+        PodArrayView<LatencyStatsPOD>     latencies;
+        PodArrayView<BufferPoolStatsPOD>  pools;
+        PodArrayView<SessionStatsPOD>     sessions;
+        PodArrayView<ServiceReadinessPOD> services;
+    };
+
+    Snapshot decode(const Response& response)
+    {
+        Snapshot       s;
+        const uint8_t* data = response.data.data();
+        std::size_t    left = response.data.size();
+        std::size_t    used = 0;
+
+        EXPECT_EQ(pod::bindSection(data, left, s.server, used), PodDecodeStatus::OK);
+        data += used;
+        left -= used;
+        EXPECT_EQ(pod::bindSection(data, left, s.latencies, used), PodDecodeStatus::OK);
+        data += used;
+        left -= used;
+        EXPECT_EQ(pod::bindSection(data, left, s.pools, used), PodDecodeStatus::OK);
+        data += used;
+        left -= used;
+        EXPECT_EQ(pod::bindSection(data, left, s.sessions, used), PodDecodeStatus::OK);
+        data += used;
+        left -= used;
+        EXPECT_EQ(pod::bindSection(data, left, s.services, used), PodDecodeStatus::OK);
+        EXPECT_EQ(left, used);
+        return s;
+    }
+
+    Request statsRequest()
+    {
+        Request req;
+        req.type = RequestType::GET_STATS;
+        return req;
+    }
+
+    const LatencyStatsPOD* find(const PodArrayView<LatencyStatsPOD>& latencies, RequestType type, LatencyStage stage)
+    {
+        for (const LatencyStatsPOD& record : latencies)
+            if (record.requestType == static_cast<uint32_t>(type) && record.stage == static_cast<uint8_t>(stage))
+                return &record;
+        return nullptr;
+    }
+
+    PositionPOD makePosition(const char* symbol, int64_t quantity, double avgPrice)
+    {
+        PositionPOD p{};
+        std::strncpy(p.symbol, symbol, sizeof(p.symbol) - 1);
+        p.quantity = quantity;
+        p.avgPrice = avgPrice;
+        return p;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Layout
+// ---------------------------------------------------------------------------
+
+TEST(StatsServiceTest, UnattachedServiceReportsZerosAndNoSessions)
+{
+    StatsService service(nullptr, nullptr);
+
+    const Response response = service.getStats(statsRequest());
+    ASSERT_TRUE(response.success);
+
+    const Snapshot s = decode(response);
+    ASSERT_EQ(s.server.size(), 1u);
+    EXPECT_GT(s.server[0].timestamp, 0);
+    EXPECT_EQ(s.server[0].sessions, 0u);
+    EXPECT_EQ(s.server[0].handshakes, 0u);
+    EXPECT_EQ(s.server[0].residentBookHits, 0u);
+    EXPECT_EQ(s.latencies.size(), kRequestTypeCount * kLatencyStageCount);
+    EXPECT_EQ(s.pools.size(), BufferPool::kClassCount);
+    EXPECT_TRUE(s.sessions.empty());
+    EXPECT_TRUE(s.services.empty());
+}
+
+TEST(StatsServiceTest, LatencyRecordsCarryRecorderPercentiles)
+{
+    StatsService service(nullptr, nullptr);
+    const auto   before = decode(service.getStats(statsRequest()));
+    const auto*  prior  = find(before.latencies, RequestType::GET_STATS, LatencyStage::SEND);
+    ASSERT_NE(prior, nullptr);
+    const uint64_t count = prior->count;
+
+    for (int i = 0; i < 10; ++i)
+        LatencyRecorder::instance().record(RequestType::GET_STATS, LatencyStage::SEND, 5000);
+
+    const Response response = service.getStats(statsRequest());
+    const auto     s        = decode(response);
+    const auto*    record   = find(s.latencies, RequestType::GET_STATS, LatencyStage::SEND);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->count, count + 10);
+    EXPECT_GE(record->max, 5000u);
+    EXPECT_GT(record->p99, 0u);
+}
+
+TEST(StatsServiceTest, PoolClassesAreOrderedBySize)
+{
+    StatsService service(nullptr, nullptr);
+    const auto   response = service.getStats(statsRequest());
+    const auto   s        = decode(response);
+    ASSERT_EQ(s.pools.size(), BufferPool::kClassCount);
+    for (std::size_t i = 1; i < s.pools.size(); ++i)
+        EXPECT_GT(s.pools[i].blockSize, s.pools[i - 1].blockSize);
+}
+
+// ---------------------------------------------------------------------------
+// Sources
+// ---------------------------------------------------------------------------
+
+TEST(StatsServiceTest, AttachedSourcesFillServerSessionAndLaneRecords)
+{
+    StatsService service(nullptr, nullptr);
+
+    TransportStats transport;
+    transport.sessions          = 2;
+    transport.queuedFrames      = 3;
+    transport.queuedBytes       = 4096;
+    transport.handshakes        = 7;
+    transport.resumedHandshakes = 5;
+
+    SessionStats first;
+    first.id           = 11;
+    first.requests     = 100;
+    first.bytesIn      = 2000;
+    first.bytesOut     = 9000;
+    first.queuedFrames = 3;
+    first.queuedBytes  = 4096;
+    SessionStats second;
+    second.id = 12;
+
+    service.attach(StatsSources{
+        [&transport]() { return transport; },
+        [&first, &second]() { return std::vector<SessionStats>{first, second}; },
+        [](RequestType type) { return type == RequestType::CALCULATE ? std::size_t{9} : std::size_t{0}; },
+        {}});
+
+    const Response response = service.getStats(statsRequest());
+    const auto     s        = decode(response);
+
+    EXPECT_EQ(s.server[0].sessions, 2u);
+    EXPECT_EQ(s.server[0].queuedFrames, 3u);
+    EXPECT_EQ(s.server[0].queuedBytes, 4096u);
+    EXPECT_EQ(s.server[0].handshakes, 7u);
+    EXPECT_EQ(s.server[0].resumedHandshakes, 5u);
+
+    ASSERT_EQ(s.sessions.size(), 2u);
+    EXPECT_EQ(s.sessions[0].sessionId, 11u);
+    EXPECT_EQ(s.sessions[0].requests, 100u);
+    EXPECT_EQ(s.sessions[0].bytesIn, 2000u);
+    EXPECT_EQ(s.sessions[0].bytesOut, 9000u);
+    EXPECT_EQ(s.sessions[0].queuedBytes, 4096u);
+    EXPECT_EQ(s.sessions[1].sessionId, 12u);
+
+    for (std::size_t stage = 0; stage < kLatencyStageCount; ++stage)
+    {
+        const auto* calc = find(s.latencies, RequestType::CALCULATE, static_cast<LatencyStage>(stage));
+        const auto* md   = find(s.latencies, RequestType::GET_MARKET_DATA, static_cast<LatencyStage>(stage));
+        ASSERT_NE(calc, nullptr);
+        ASSERT_NE(md, nullptr);
+        EXPECT_EQ(calc->queued, 9u);
+        EXPECT_EQ(md->queued, 0u);
+    }
+}
+
+TEST(StatsServiceTest, ServiceSourceFillsReadinessRecords)
+{
+    StatsService service(nullptr, nullptr);
+
+    StatsSources sources;
+    sources.services = []() {
+        return std::vector<ServiceStatus>{
+            ServiceStatus{"market data", ServiceState::READY, std::chrono::milliseconds(12)},
+            ServiceStatus{"a service name longer than the record holds", ServiceState::WARMING_UP,
+                          std::chrono::milliseconds(340)}};
+    };
+    service.attach(std::move(sources));
+
+    const Response response = service.getStats(statsRequest());
+    const auto     s        = decode(response);
+    ASSERT_EQ(s.services.size(), 2u);
+    EXPECT_STREQ(s.services[0].name, "market data");
+    EXPECT_EQ(s.services[0].state, static_cast<uint8_t>(ServiceState::READY));
+    EXPECT_EQ(s.services[0].loadMillis, 12u);
+    EXPECT_EQ(std::string(s.services[1].name), "a service name longer t");
+    EXPECT_EQ(s.services[1].state, static_cast<uint8_t>(ServiceState::WARMING_UP));
+    EXPECT_EQ(s.services[1].loadMillis, 340u);
+}
+
+TEST(StatsServiceTest, ReportsResidentBookHitsAndMisses)
+{
+    auto marketData  = std::make_shared<InMemoryMarketDataService>(16);
+    auto calculation = std::make_shared<CalculationEngine>(marketData, CalculationConfig{0.99, 0, 4});
+    StatsService service(calculation, nullptr);
+
+    const std::vector<PositionPOD> book = {makePosition("AAPL", 10, 100.0)};
+    Request                        req;
+    req.type    = RequestType::CALCULATE;
+    req.payload = makePodPayload(book.data(), book.size());
+    calculation->calculate(req);
+    calculation->calculate(req);
+    calculation->calculate(req);
+
+    const Response response = service.getStats(statsRequest());
+    const auto     s        = decode(response);
+    EXPECT_EQ(s.server[0].residentBookMisses, 1u);
+    EXPECT_EQ(s.server[0].residentBookHits, 2u);
+}
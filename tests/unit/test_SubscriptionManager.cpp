@@ -0,0 +1,219 @@
+/**
+ * @file test_SubscriptionManager.cpp
+ * @brief Unit tests for session-scoped subscriptions and push fan-out.
+ *
+ * Tests: subscribe replies with current snapshots, immediate pushes to idle
+ * sessions, conflation while a session is still writing, unsubscribe, and
+ * cleanup of closed or vanished sessions. A fake ISessionPublisher records
+ * every publish and holds the drained handlers so tests control pacing.
+ */
+
+#include <gtest/gtest.h>
+
+#include "SubscriptionManager.hpp"
+#include "server/RequestSchema.hpp"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace
+{
+    class FakePublisher : public ISessionPublisher
+    {
+    public:
+        struct Published
+        {
+            uint64_t              sessionId;
+            std::vector<Response> messages;
+        };
+
+        bool publish(uint64_t sessionId, std::vector<Response> messages, DrainedHandler onDrained) override
+        {
+            if (disconnected.count(sessionId) != 0)
+                return false;
+            published.push_back({sessionId, std::move(messages)});
+            drained[sessionId] = std::move(onDrained);
+            return true;
+        }
+
+        void setSessionClosedHandler(SessionClosedHandler handler) override
+        {
+            closed = std::move(handler);
+        }
+
+        /// Simulate the session's write queue emptying.
+        void drain(uint64_t sessionId)
+        {
+            auto handler = std::move(drained[sessionId]);
+            drained.erase(sessionId);
+            if (handler)
+                handler();
+        }
+
+        std::vector<Published>             published;
+        std::map<uint64_t, DrainedHandler> drained;
+        std::map<uint64_t, bool>           disconnected;
+        SessionClosedHandler               closed;
+    };
+
+    Request makeRequest(RequestType type, uint64_t sessionId, const std::vector<const char*>& symbols)
+    {
+        std::vector<SymbolPOD> records(symbols.size());
+        for (std::size_t i = 0; i < symbols.size(); ++i)
+            std::strncpy(records[i].symbol, symbols[i], sizeof(records[i].symbol) - 1);
+
+        Request req;
+        req.type      = type;
+        req.sessionId = sessionId;
+        req.payload   = makePodPayload(records.data(), records.size());
+        return req;
+    }
+
+    MarketDataPOD makeSnapshot(const char* symbol, double last)
+    {
+        MarketDataPOD md{};
+        std::strncpy(md.symbol, symbol, sizeof(md.symbol) - 1);
+        md.last = last;
+        return md;
+    }
+
+    PodArrayView<MarketDataPOD> records(const Response& response)
+    {
+        PodArrayView<MarketDataPOD> view;
+        EXPECT_EQ(pod::bindArray(response.data.data(), response.data.size(), view), PodDecodeStatus::OK);
+        return view;
+    }
+
+    struct Fixture
+    {
+        std::shared_ptr<InMemoryMarketDataService> marketData =
+            std::make_shared<InMemoryMarketDataService>(16);
+        SubscriptionManager manager{marketData};
+        FakePublisher       publisher;
+
+        Fixture() { manager.attach(publisher); }
+    };
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Subscribe / unsubscribe
+// ---------------------------------------------------------------------------
+
+TEST(SubscriptionManagerTest, SubscribeRepliesWithCurrentSnapshots)
+{
+    Fixture f;
+    f.marketData->update(makeSnapshot("AAPL", 190.0));
+
+    const auto response = f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL", "MSFT"}));
+    ASSERT_TRUE(response.success) << response.message;
+    EXPECT_FALSE(response.push);
+
+    const auto snapshots = records(response);
+    ASSERT_EQ(snapshots.size(), 2u);
+    EXPECT_DOUBLE_EQ(snapshots[0].last, 190.0);
+    EXPECT_STREQ(snapshots[1].symbol, "MSFT");
+
+    EXPECT_EQ(f.manager.subscriptionCount(1), 2u);
+    EXPECT_EQ(f.marketData->subscriberCount("AAPL"), 1u);
+
+    // Subscribing again is idempotent.
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL"}));
+    EXPECT_EQ(f.manager.subscriptionCount(1), 2u);
+    EXPECT_EQ(f.marketData->subscriberCount("AAPL"), 1u);
+}
+
+TEST(SubscriptionManagerTest, RequestWithoutSessionFails)
+{
+    Fixture f;
+    const auto response = f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 0, {"AAPL"}));
+    EXPECT_FALSE(response.success);
+    EXPECT_NE(response.message.find("no session"), std::string::npos);
+}
+
+TEST(SubscriptionManagerTest, UnsubscribeStopsPushes)
+{
+    Fixture f;
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL"}));
+    const auto response = f.manager.unsubscribe(makeRequest(RequestType::UNSUBSCRIBE, 1, {"AAPL"}));
+    EXPECT_TRUE(response.success);
+
+    f.marketData->update(makeSnapshot("AAPL", 1.0));
+    EXPECT_TRUE(f.publisher.published.empty());
+    EXPECT_EQ(f.marketData->subscriberCount("AAPL"), 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Fan-out and conflation
+// ---------------------------------------------------------------------------
+
+TEST(SubscriptionManagerTest, UpdateIsPushedToEverySubscriber)
+{
+    Fixture f;
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL"}));
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 2, {"AAPL"}));
+
+    f.marketData->update(makeSnapshot("AAPL", 191.5));
+
+    ASSERT_EQ(f.publisher.published.size(), 2u);
+    for (const auto& published : f.publisher.published)
+    {
+        ASSERT_EQ(published.messages.size(), 1u);
+        const Response& push = published.messages[0];
+        EXPECT_TRUE(push.push);
+        EXPECT_DOUBLE_EQ(records(push)[0].last, 191.5);
+    }
+}
+
+TEST(SubscriptionManagerTest, BusySessionReceivesOnlyLatestSnapshots)
+{
+    Fixture f;
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL", "MSFT"}));
+
+    f.marketData->update(makeSnapshot("AAPL", 1.0)); // sent straight away
+    f.marketData->update(makeSnapshot("AAPL", 2.0)); // session busy: marked dirty
+    f.marketData->update(makeSnapshot("MSFT", 3.0));
+    f.marketData->update(makeSnapshot("AAPL", 4.0)); // conflated
+    f.marketData->update(makeSnapshot("AAPL", 5.0)); // conflated
+    ASSERT_EQ(f.publisher.published.size(), 1u);
+    EXPECT_EQ(f.manager.conflatedUpdates(), 2u);
+
+    f.publisher.drain(1);
+    ASSERT_EQ(f.publisher.published.size(), 2u);
+    const auto batch = records(f.publisher.published[1].messages[0]);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_STREQ(batch[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(batch[0].last, 5.0);
+    EXPECT_STREQ(batch[1].symbol, "MSFT");
+
+    // Nothing dirty any more: the session goes idle and the next update is immediate.
+    f.publisher.drain(1);
+    f.marketData->update(makeSnapshot("MSFT", 6.0));
+    EXPECT_EQ(f.publisher.published.size(), 3u);
+}
+
+// ---------------------------------------------------------------------------
+// Session cleanup
+// ---------------------------------------------------------------------------
+
+TEST(SubscriptionManagerTest, ClosedSessionIsRemoved)
+{
+    Fixture f;
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL", "MSFT"}));
+    ASSERT_TRUE(f.publisher.closed);
+
+    f.publisher.closed(1);
+    EXPECT_EQ(f.manager.subscriptionCount(1), 0u);
+    EXPECT_EQ(f.marketData->subscriberCount("AAPL"), 0u);
+    EXPECT_EQ(f.marketData->subscriberCount("MSFT"), 0u);
+}
+
+TEST(SubscriptionManagerTest, VanishedSessionIsDroppedOnPublish)
+{
+    Fixture f;
+    f.manager.subscribe(makeRequest(RequestType::SUBSCRIBE, 1, {"AAPL"}));
+    f.publisher.disconnected[1] = true;
+
+    f.marketData->update(makeSnapshot("AAPL", 1.0));
+    EXPECT_EQ(f.manager.subscriptionCount(1), 0u);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file test_TradeAggregates.cpp
+ * @brief Unit tests for TradeAggregates.
+ *
+ * Tests: OHLCV and VWAP of a bar, open and close by timestamp for trades
+ * recorded out of order, the bar ring dropping intervals older than its
+ * depth, time-range selection of bars, daily summaries per side, days
+ * before 1970, and invalid configuration.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TradeAggregates.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr int64_t kMinute = 60LL * 1000 * 1000;
+    constexpr int64_t kDay    = 1440 * kMinute;
+
+    TradePOD makeTrade(double price, uint64_t quantity, uint8_t side, int64_t timestamp)
+    {
+        TradePOD t{};
+        std::strncpy(t.symbol, "AAPL", sizeof(t.symbol) - 1);
+        t.price     = price;
+        t.quantity  = quantity;
+        t.side      = side;
+        t.timestamp = timestamp;
+        return t;
+    }
+
+    std::vector<OhlcvBar> allBars(const TradeAggregates& aggregates, uint32_t code = 0)
+    {
+        std::vector<OhlcvBar> bars;
+        aggregates.bars(code, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), bars);
+        return bars;
+    }
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Bars
+// ---------------------------------------------------------------------------
+
+TEST(TradeAggregatesTest, BarHoldsOhlcvAndVwap)
+{
+    TradeAggregates aggregates;
+    aggregates.record(makeTrade(100.0, 10, 0, 5), 0);
+    aggregates.record(makeTrade(104.0, 10, 1, 10), 0);
+    aggregates.record(makeTrade(98.0, 20, 0, 20), 0);
+    aggregates.record(makeTrade(101.0, 10, 1, kMinute - 1), 0);
+    aggregates.record(makeTrade(200.0, 1, 0, kMinute), 0); // next bar
+
+    const auto bars = allBars(aggregates);
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars[0].start, 0);
+    EXPECT_DOUBLE_EQ(bars[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(bars[0].high, 104.0);
+    EXPECT_DOUBLE_EQ(bars[0].low, 98.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 101.0);
+    EXPECT_EQ(bars[0].volume, 50u);
+    EXPECT_EQ(bars[0].fills, 4u);
+    EXPECT_DOUBLE_EQ(bars[0].vwap(), (1000.0 + 1040.0 + 1960.0 + 1010.0) / 50.0);
+    EXPECT_EQ(bars[1].start, kMinute);
+    EXPECT_DOUBLE_EQ(bars[1].open, 200.0);
+}
+
+TEST(TradeAggregatesTest, OpenAndCloseFollowTimestampsNotArrival)
+{
+    TradeAggregates aggregates;
+    aggregates.record(makeTrade(101.0, 1, 0, 30), 0);
+    aggregates.record(makeTrade(100.0, 1, 0, 10), 0); // earlier: opens
+    aggregates.record(makeTrade(102.0, 1, 0, 20), 0);
+
+    const auto bars = allBars(aggregates);
+    ASSERT_EQ(bars.size(), 1u);
+    EXPECT_DOUBLE_EQ(bars[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 101.0);
+
+    std::vector<DaySummary> days;
+    aggregates.days(0, 0, 1, days);
+    ASSERT_EQ(days.size(), 1u);
+    EXPECT_DOUBLE_EQ(days[0].ohlcv.open, 100.0);
+    EXPECT_DOUBLE_EQ(days[0].ohlcv.close, 101.0);
+}
+
+TEST(TradeAggregatesTest, RingKeepsOnlyTheNewestIntervals)
+{
+    TradeAggregates aggregates(TradeAggregatesConfig{kMinute, 4});
+    for (int64_t minute = 0; minute < 10; ++minute)
+        aggregates.record(makeTrade(100.0 + minute, 1, 0, minute * kMinute), 0);
+
+    auto bars = allBars(aggregates);
+    ASSERT_EQ(bars.size(), 4u);
+    EXPECT_EQ(bars.front().start, 6 * kMinute);
+    EXPECT_EQ(bars.back().start, 9 * kMinute);
+
+    // Too old for the ring: left out of the bars, still in the day.
+    aggregates.record(makeTrade(50.0, 7, 0, 2 * kMinute), 0);
+    EXPECT_EQ(aggregates.lateTrades(), 1u);
+    EXPECT_EQ(allBars(aggregates).size(), 4u);
+    std::vector<DaySummary> days;
+    aggregates.days(0, 0, 1, days);
+    ASSERT_EQ(days.size(), 1u);
+    EXPECT_EQ(days[0].ohlcv.volume, 17u);
+    EXPECT_DOUBLE_EQ(days[0].ohlcv.low, 50.0);
+
+    // Still inside the ring: joins its bar.
+    aggregates.record(makeTrade(120.0, 1, 0, 7 * kMinute + 5), 0);
+    bars = allBars(aggregates);
+    EXPECT_EQ(bars[1].fills, 2u);
+    EXPECT_DOUBLE_EQ(bars[1].high, 120.0);
+}
+
+TEST(TradeAggregatesTest, BarsAreSelectedByStart)
+{
+    TradeAggregates aggregates;
+    for (int64_t minute = 0; minute < 5; ++minute)
+        aggregates.record(makeTrade(100.0, 1, 0, minute * kMinute + 1), 0);
+
+    std::vector<OhlcvBar> bars;
+    aggregates.bars(0, kMinute, 3 * kMinute, bars);
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars[0].start, kMinute);
+    EXPECT_EQ(bars[1].start, 2 * kMinute);
+
+    bars.clear();
+    aggregates.bars(7, 0, kDay, bars); // never recorded
+    EXPECT_TRUE(bars.empty());
+}
+
+// ---------------------------------------------------------------------------
+// Daily summaries
+// ---------------------------------------------------------------------------
+
+TEST(TradeAggregatesTest, DaysSplitBuysAndSells)
+{
+    TradeAggregates aggregates;
+    aggregates.record(makeTrade(100.0, 10, 0, 1), 3);
+    aggregates.record(makeTrade(110.0, 5, 1, 2), 3);
+    aggregates.record(makeTrade(120.0, 1, 0, kDay + 1), 3);
+    EXPECT_EQ(aggregates.symbolCount(), 4u);
+
+    std::vector<DaySummary> days;
+    aggregates.days(3, 0, 2, days);
+    ASSERT_EQ(days.size(), 2u);
+    EXPECT_EQ(days[0].day, 0);
+    EXPECT_EQ(days[0].symbolCode, 3u);
+    EXPECT_EQ(days[0].sides[0].quantity, 10u);
+    EXPECT_EQ(days[0].sides[1].quantity, 5u);
+    EXPECT_DOUBLE_EQ(days[0].sides[1].notional, 550.0);
+    EXPECT_EQ(days[0].ohlcv.volume, 15u);
+    EXPECT_EQ(days[1].day, 1);
+    EXPECT_EQ(days[1].ohlcv.start, kDay);
+
+    aggregates.clear();
+    days.clear();
+    aggregates.days(3, 0, 2, days);
+    EXPECT_TRUE(days.empty());
+}
+
+TEST(TradeAggregatesTest, TimestampsBefore1970FloorToTheirDay)
+{
+    EXPECT_EQ(TradeAggregates::dayOf(-1), -1);
+    EXPECT_EQ(TradeAggregates::dayOf(-kDay), -1);
+    EXPECT_EQ(TradeAggregates::dayOf(kDay - 1), 0);
+
+    TradeAggregates aggregates;
+    aggregates.record(makeTrade(100.0, 1, 0, -1), 0);
+    const auto bars = allBars(aggregates);
+    ASSERT_EQ(bars.size(), 1u);
+    EXPECT_EQ(bars[0].start, -kMinute);
+}
+
+TEST(TradeAggregatesTest, InvalidConfigurationThrows)
+{
+    EXPECT_THROW(TradeAggregates(TradeAggregatesConfig{0, 10}), std::invalid_argument);
+    EXPECT_THROW(TradeAggregates(TradeAggregatesConfig{kMinute, 0}), std::invalid_argument);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_TradingDate.cpp
+ * @brief Unit tests for the day-number date type.
+ *
+ * Tests: known epoch offsets, ISO parsing and formatting, rejection of
+ * malformed or impossible dates, a civil round trip across centuries, and
+ * the bounds of the ISO range.
+ */
+
+#include <gtest/gtest.h>
+
+#include "models/TradingDate.hpp"
+
+#include <cstdint>
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(TradingDateTest, KnownDayNumbers)
+{
+    EXPECT_EQ(TradingDate::fromCivil(1970, 1, 1).days, 0);
+    EXPECT_EQ(TradingDate::fromCivil(2000, 3, 1).days, 11017);
+    EXPECT_EQ(TradingDate::fromCivil(1969, 12, 31).days, -1);
+    EXPECT_EQ(TradingDate::fromCivil(2026, 1, 1).days, 20454);
+}
+
+TEST(TradingDateTest, ParsesAndFormatsIso)
+{
+    TradingDate date;
+    ASSERT_TRUE(TradingDate::parseIso("2024-02-29", date));
+    EXPECT_EQ(date, TradingDate::fromCivil(2024, 2, 29));
+    EXPECT_EQ(date.toIso(), "2024-02-29");
+    EXPECT_EQ((date + 1).toIso(), "2024-03-01");
+}
+
+TEST(TradingDateTest, RejectsMalformedAndImpossibleDates)
+{
+    TradingDate date{42};
+    EXPECT_FALSE(TradingDate::parseIso("2023-02-29", date)); // not a leap year
+    EXPECT_FALSE(TradingDate::parseIso("2024-13-01", date));
+    EXPECT_FALSE(TradingDate::parseIso("2024-04-31", date));
+    EXPECT_FALSE(TradingDate::parseIso("2024-1-01", date));
+    EXPECT_FALSE(TradingDate::parseIso("2024/01/01", date));
+    EXPECT_FALSE(TradingDate::parseIso("2024-01-0x", date));
+    EXPECT_FALSE(TradingDate::parseIso("", date));
+    EXPECT_EQ(date.days, 42); // untouched on failure
+}
+
+TEST(TradingDateTest, CivilRoundTripAcrossCenturies)
+{
+    int32_t  year;
+    uint32_t month, day;
+    TradingDate::fromCivil(1899, 12, 31).toCivil(year, month, day);
+    EXPECT_EQ(year, 1899);
+
+    // Stepping one day at a time must agree with the civil calendar.
+    TradingDate date = TradingDate::fromCivil(1896, 1, 1);
+    int32_t  expectYear  = 1896;
+    uint32_t expectMonth = 1;
+    uint32_t expectDay   = 1;
+    for (int i = 0; i < 365 * 210; ++i, date = date + 1)
+    {
+        date.toCivil(year, month, day);
+        ASSERT_EQ(year, expectYear);
+        ASSERT_EQ(month, expectMonth);
+        ASSERT_EQ(day, expectDay);
+
+        if (++expectDay > TradingDate::daysInMonth(expectYear, expectMonth))
+        {
+            expectDay = 1;
+            if (++expectMonth > 12)
+            {
+                expectMonth = 1;
+                ++expectYear;
+            }
+        }
+    }
+}
+
+TEST(TradingDateTest, IsoRangeIsTheYearsParseIsoAccepts)
+{
+    TradingDate first;
+    TradingDate last;
+    ASSERT_TRUE(TradingDate::parseIso("0000-01-01", first));
+    ASSERT_TRUE(TradingDate::parseIso("9999-12-31", last));
+    EXPECT_TRUE(first.inIsoRange());
+    EXPECT_TRUE(last.inIsoRange());
+    EXPECT_FALSE((first + -1).inIsoRange());
+    EXPECT_FALSE((last + 1).inIsoRange());
+    EXPECT_FALSE(TradingDate{INT32_MAX}.inIsoRange());
+    EXPECT_FALSE(TradingDate{INT32_MIN}.inIsoRange());
+}
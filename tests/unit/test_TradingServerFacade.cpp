@@ -9,6 +9,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstdint>
+#include <cstring>
+
 #include "services/IMarketDataService.hpp"
 #include "services/ICalculationService.hpp"
 #include "services/IManipulationService.hpp"
@@ -18,6 +21,7 @@
 #include "models/Request.hpp"
 #include "models/Response.hpp"
 #include "models/ReportRequest.hpp"
+#include "server/RequestSchema.hpp"
 
 // Pull in the concrete facade and commands.
 #include "TradingServerFacade.hpp"
@@ -82,10 +86,7 @@ static TradingServerFacade buildFacade(
         [ms](const Request& r) { return std::make_unique<ManipulationCommand>(ms, r); });
 
     registry.registerCommand(RequestType::GENERATE_REPORT,
-        [rs](const Request& r) {
-            ReportRequest rr{"EndOfDay", "2024-01-01", "2024-01-31"};
-            return std::make_unique<ReportCommand>(rs, rr);
-        });
+        [rs](const Request& r) { return std::make_unique<ReportCommand>(rs, r); });
 
     return TradingServerFacade(mds, cs, ms, rs, std::move(registry));
 }
@@ -155,17 +156,129 @@ TEST(TradingServerFacadeTest, DispatchesGenerateReportRequest)
     auto ms  = std::make_shared<MockManipulationService>();
     auto rs  = std::make_shared<MockReportService>();
 
-    EXPECT_CALL(*rs, generateReport(_)).WillOnce(Return(Response{true, "report", {}}));
+    const TradingDate from = TradingDate::fromCivil(2024, 1, 1);
+    const TradingDate to   = TradingDate::fromCivil(2024, 1, 31);
+    EXPECT_CALL(*rs, generateReport(::testing::AllOf(
+                         ::testing::Field(&ReportRequest::reportType, "EndOfDay"),
+                         ::testing::Field(&ReportRequest::dateFrom, from),
+                         ::testing::Field(&ReportRequest::dateTo, to))))
+        .WillOnce(Return(Response{true, "report", {}}));
 
     auto facade = buildFacade(mds, cs, ms, rs);
     Request req;
     req.type = RequestType::GENERATE_REPORT;
+    ReportRequestPOD params{};
+    std::strcpy(params.reportType, "EndOfDay");
+    params.dateFrom = from.days;
+    params.dateTo   = to.days;
+    req.payload     = makePodPayload(&params, 1);
 
     auto response = facade.handleRequest(req);
     EXPECT_TRUE(response.success);
     EXPECT_EQ(response.message, "report");
 }
 
+TEST(TradingServerFacadeTest, RejectsGenerateReportWithoutParameters)
+{
+    auto mds = std::make_shared<MockMarketDataService>();
+    auto cs  = std::make_shared<MockCalculationService>();
+    auto ms  = std::make_shared<MockManipulationService>();
+    auto rs  = std::make_shared<MockReportService>();
+
+    EXPECT_CALL(*rs, generateReport(_)).Times(0);
+
+    auto facade = buildFacade(mds, cs, ms, rs);
+    Request req;
+    req.type = RequestType::GENERATE_REPORT;
+
+    auto response = facade.handleRequest(req);
+    EXPECT_FALSE(response.success);
+    EXPECT_EQ(response.message, "ReportService: payload truncated");
+}
+
+TEST(TradingServerFacadeTest, ReportCommandDecodesParametersInPlace)
+{
+    ReportRequestPOD params[2]{};
+    std::memset(params[0].reportType, 'x', sizeof(params[0].reportType)); // no terminator
+    params[0].dateFrom = 19000;
+    params[0].dateTo   = 19030;
+
+    Request req;
+    req.type    = RequestType::GENERATE_REPORT;
+    req.payload = makePodPayload(params, 1);
+
+    ReportRequest decoded;
+    ASSERT_EQ(ReportCommand::decode(req, decoded), PodDecodeStatus::OK);
+    EXPECT_EQ(decoded.reportType, std::string(32, 'x'));
+    EXPECT_EQ(decoded.dateFrom.days, 19000);
+    EXPECT_EQ(decoded.dateTo.days, 19030);
+
+    req.payload = makePodPayload(params, 2);
+    EXPECT_EQ(ReportCommand::decode(req, decoded), PodDecodeStatus::TRAILING_BYTES);
+}
+
+TEST(TradingServerFacadeTest, ReportCommandRejectsDaysOutsideTheIsoRange)
+{
+    const int32_t first = TradingDate::fromCivil(0, 1, 1).days;
+    const int32_t last  = TradingDate::fromCivil(9999, 12, 31).days;
+    const struct
+    {
+        int32_t         from;
+        int32_t         to;
+        PodDecodeStatus expected;
+    } cases[] = {
+        {first, last, PodDecodeStatus::OK},
+        {INT32_MAX - 5, INT32_MAX, PodDecodeStatus::OUT_OF_RANGE},
+        {INT32_MIN, 0, PodDecodeStatus::OUT_OF_RANGE},
+        {first - 1, first, PodDecodeStatus::OUT_OF_RANGE},
+        {last, last + 1, PodDecodeStatus::OUT_OF_RANGE},
+    };
+
+    for (const auto& c : cases)
+    {
+        ReportRequestPOD params{};
+        std::strcpy(params.reportType, "EndOfDay");
+        params.dateFrom = c.from;
+        params.dateTo   = c.to;
+
+        Request req;
+        req.type    = RequestType::GENERATE_REPORT;
+        req.payload = makePodPayload(&params, 1);
+
+        ReportRequest decoded;
+        EXPECT_EQ(ReportCommand::decode(req, decoded), c.expected) << c.from << ".." << c.to;
+    }
+}
+
+TEST(TradingServerFacadeTest, ReportCommandDecodesTheOptionalFormatSection)
+{
+    ReportRequestPOD params{};
+    std::strcpy(params.reportType, "EndOfDay");
+    const ReportOptionsPOD options{static_cast<uint8_t>(ReportFormat::COLUMNAR), {}};
+
+    const PooledBuffer first  = makePodPayload(&params, 1);
+    const PooledBuffer second = makePodPayload(&options, 1);
+    Request            req;
+    req.type    = RequestType::GENERATE_REPORT;
+    req.payload = PooledBuffer(first.begin(), first.end());
+    req.payload.append(second.data(), second.size());
+
+    ReportRequest decoded;
+    ASSERT_EQ(ReportCommand::decode(req, decoded), PodDecodeStatus::OK);
+    EXPECT_EQ(decoded.reportType, "EndOfDay");
+    EXPECT_EQ(decoded.format, ReportFormat::COLUMNAR);
+
+    // Without the section the reply is text.
+    req.payload = first;
+    ASSERT_EQ(ReportCommand::decode(req, decoded), PodDecodeStatus::OK);
+    EXPECT_EQ(decoded.format, ReportFormat::TEXT);
+
+    // Anything else after the parameters is refused.
+    req.payload = PooledBuffer(first.begin(), first.end());
+    req.payload.append(first.data(), first.size());
+    EXPECT_EQ(ReportCommand::decode(req, decoded), PodDecodeStatus::SCHEMA_MISMATCH);
+}
+
 TEST(TradingServerFacadeTest, ReturnsErrorResponseForUnknownRequestType)
 {
     auto mds = std::make_shared<MockMarketDataService>();
@@ -0,0 +1,123 @@
+/**
+ * @file test_WriteCoalescer.cpp
+ * @brief Unit tests for outbound frame coalescing.
+ *
+ * Tests: a lone frame passes through without a copy, small frames merge in
+ * order up to the byte limit, oversized frames are never merged, and the
+ * queue limits drop the oldest market data before refusing replies, and
+ * replies are counted as they are queued and taken.
+ */
+
+#include <gtest/gtest.h>
+
+#include "WriteCoalescer.hpp"
+
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST(WriteCoalescerTest, SingleFramePassesThroughWithoutCopy)
+{
+    WriteCoalescer queue(64);
+    const RawBuffer frame{0x01, 0x02, 0x03};
+    queue.push(frame);
+
+    RawBuffer out;
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(std::as_const(out).data(), frame.data());
+    EXPECT_FALSE(queue.next(out));
+    EXPECT_EQ(queue.mergedWrites(), 0u);
+}
+
+TEST(WriteCoalescerTest, MergesQueuedFramesInOrderUpToLimit)
+{
+    WriteCoalescer queue(8);
+    queue.push(RawBuffer{1, 2, 3});
+    queue.push(RawBuffer{4, 5, 6});
+    queue.push(RawBuffer{7, 8, 9});
+    EXPECT_EQ(queue.pendingBytes(), 9u);
+
+    RawBuffer out;
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(out, (std::vector<uint8_t>{1, 2, 3, 4, 5, 6}));
+
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(out, (std::vector<uint8_t>{7, 8, 9}));
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.pendingBytes(), 0u);
+    EXPECT_EQ(queue.mergedWrites(), 1u);
+}
+
+TEST(WriteCoalescerTest, OversizedFrameIsWrittenAlone)
+{
+    WriteCoalescer queue(4);
+    queue.push(RawBuffer{1});
+    queue.push(RawBuffer(10, 0xAB));
+    queue.push(RawBuffer{2});
+
+    RawBuffer out;
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(out.size(), 1u);
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(out.size(), 10u);
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(out, (std::vector<uint8_t>{2}));
+}
+
+TEST(WriteCoalescerTest, FrameLimitDropsOldestMarketDataFirst)
+{
+    WriteCoalescer queue(1, 0, 3);
+    EXPECT_TRUE(queue.push(RawBuffer{1}, FrameKind::MARKET_DATA));
+    EXPECT_TRUE(queue.push(RawBuffer{2}));
+    EXPECT_TRUE(queue.push(RawBuffer{3}, FrameKind::MARKET_DATA));
+    EXPECT_TRUE(queue.push(RawBuffer{4}, FrameKind::MARKET_DATA)); // drops {1}
+
+    EXPECT_EQ(queue.pendingFrames(), 3u);
+    EXPECT_EQ(queue.droppedFrames(), 1u);
+
+    RawBuffer out;
+    std::vector<uint8_t> order;
+    while (queue.next(out))
+        order.push_back(out[0]);
+    EXPECT_EQ(order, (std::vector<uint8_t>{2, 3, 4}));
+}
+
+TEST(WriteCoalescerTest, ByteLimitRefusesWhenOnlyRepliesRemain)
+{
+    WriteCoalescer queue(1, 8);
+    EXPECT_TRUE(queue.push(RawBuffer(4, 0), FrameKind::MARKET_DATA));
+    EXPECT_TRUE(queue.push(RawBuffer(4, 0)));
+    EXPECT_EQ(queue.highWaterBytes(), 8u);
+
+    // Dropping the market data frame makes room for the first extra reply...
+    EXPECT_TRUE(queue.push(RawBuffer(4, 0)));
+    EXPECT_EQ(queue.droppedFrames(), 1u);
+    EXPECT_EQ(queue.pendingBytes(), 8u);
+
+    // ...but nothing is left to drop for the second.
+    EXPECT_FALSE(queue.push(RawBuffer(4, 0)));
+    EXPECT_EQ(queue.pendingFrames(), 3u);
+}
+
+TEST(WriteCoalescerTest, CountsRepliesPushedAndTaken)
+{
+    WriteCoalescer queue(64);
+    queue.push(RawBuffer{1}, FrameKind::MARKET_DATA);
+    queue.push(RawBuffer{2});
+    queue.push(RawBuffer{3}, FrameKind::MARKET_DATA);
+    EXPECT_EQ(queue.repliesPushed(), 1u);
+    EXPECT_EQ(queue.repliesTaken(), 0u);
+
+    RawBuffer out;
+    ASSERT_TRUE(queue.next(out));
+    EXPECT_EQ(queue.repliesTaken(), 1u);
+
+    queue.push(RawBuffer{4});
+    queue.clear();
+    EXPECT_EQ(queue.repliesPushed(), 2u);
+    EXPECT_EQ(queue.repliesTaken(), 1u);
+}